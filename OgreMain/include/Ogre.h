@@ -121,6 +121,7 @@ Torus Knot Software Ltd.
 #include "OgreCompositionPass.h"
 #include "OgreCompositionTargetPass.h"
 #include "OgreWindowEventUtilities.h"
+#include "OgreWorkerThreadPool.h"
 #include "OgreShadowCameraSetup.h"
 #include "OgreShadowCameraSetupFocused.h"
 #include "OgreShadowCameraSetupLiSPSM.h"
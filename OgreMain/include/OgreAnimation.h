@@ -232,6 +232,26 @@ namespace Ogre {
 		void apply(Entity* entity, Real timePos, Real weight, bool software, 
 			bool hardware);
 
+        /** Applies all tracks at a time index obtained from _getTimeIndex.
+        @remarks
+            This and the following overloads behave as those taking a time 
+            position, but let the caller look up the time index itself, 
+            normally from the keyframe cursor of an AnimationState.
+        */
+        void apply(const TimeIndex& timeIndex, Real weight = 1.0, Real scale = 1.0f);
+        /** Applies all node tracks to a given skeleton at a time index obtained 
+            from _getTimeIndex. */
+        void apply(Skeleton* skeleton, const TimeIndex& timeIndex, Real weight = 1.0, 
+            Real scale = 1.0f);
+        /** Applies all node tracks to a given skeleton with per bone weights, 
+            at a time index obtained from _getTimeIndex. */
+        void apply(Skeleton* skeleton, const TimeIndex& timeIndex, float weight,
+            const AnimationState::BoneBlendMask* blendMask, Real scale);
+        /** Applies all vertex tracks to a given entity at a time index obtained 
+            from _getTimeIndex. */
+        void apply(Entity* entity, const TimeIndex& timeIndex, Real weight, 
+            bool software, bool hardware);
+
         /** Tells the animation how to interpolate between keyframes.
         @remarks
             By default, animations normally interpolate linearly between keyframes. This is
@@ -383,6 +403,20 @@ namespace Ogre {
         */
         TimeIndex _getTimeIndex(Real timePos) const;
 
+        /** Internal method used to convert time position to time index object,
+            starting the keyframe search from a cursor.
+        @remarks
+            The cursor holds the global keyframe index found by the previous 
+            call. Playback mostly moves forward by less than a keyframe at a 
+            time, so the index is normally the same or the next one, and the
+            search is only needed when the time jumps or loops.
+        @param timePos The time position.
+        @param keyFrameCursor The cursor, which is updated to the index found;
+            any value is safe, as it is checked before use.
+        @see AnimationState::_getKeyFrameCursor
+        */
+        TimeIndex _getTimeIndex(Real timePos, uint& keyFrameCursor) const;
+
     protected:
         /// Node tracks, indexed by handle
         NodeTrackList mNodeTrackList;
@@ -411,6 +445,8 @@ namespace Ogre {
 
         /// Internal method to build global keyframe time list
         void buildKeyFrameTimeList(void) const;
+        /// Internal method to wrap a time position into the length of the animation
+        Real wrapTimePos(Real timePos) const;
     };
 
 
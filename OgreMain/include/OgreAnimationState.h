@@ -109,6 +109,20 @@ namespace Ogre {
 		/// Get the parent animation state set
 		AnimationStateSet* getParent(void) const { return mParent; }
 
+		/** Gets the keyframe cursor of this state for the given animation, 
+			for Animation::_getTimeIndex.
+		@remarks
+			Applying the animation through the cursor means each update only 
+			has to step on from the keyframe found by the last one. One state
+			can drive several animations (e.g. the skeletal and the vertex
+			animation of an entity), whose keyframes differ, so each of them 
+			gets its own cursor. The cursor is only a search hint which does 
+			not change the result, so it can be updated through a const state.
+		@param anim The animation the cursor is used with; it is only used
+			as a key and never dereferenced.
+		*/
+		uint& _getKeyFrameCursor(const Animation* anim) const;
+
       /** @brief create a new blend mask with the given number of entries
        *
        * In addition to assigning a single weight value to a skeletal animation,
@@ -161,6 +175,9 @@ namespace Ogre {
         Real mWeight;
         bool mEnabled;
         bool mLoop;
+        /// Global keyframe index found when the state was last applied, per animation
+        typedef std::vector<std::pair<const Animation*, uint> > KeyFrameCursorList;
+        mutable KeyFrameCursorList mKeyFrameCursors;
 
     };
 
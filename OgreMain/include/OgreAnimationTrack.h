@@ -229,6 +229,9 @@ namespace Ogre
     protected:
         typedef std::vector<KeyFrame*> KeyFrameList;
         KeyFrameList mKeyFrames;
+        /// Times of mKeyFrames, kept in a contiguous list for searching
+        typedef std::vector<Real> KeyFrameTimeList;
+        KeyFrameTimeList mKeyFrameTimes;
         Animation* mParent;
 		unsigned short mHandle;
 		Listener* mListener;
@@ -240,6 +243,13 @@ namespace Ogre
 		/// Create a keyframe implementation - must be overridden
 		virtual KeyFrame* createKeyFrameImpl(Real time) = 0;
 
+        /** Finds the indexes of the 2 keyframes which are active at the time 
+            given, as getKeyFramesAtTime, without touching the KeyFrame objects.
+        @returns The parametric value between the 2 keyframes
+        */
+        Real getKeyFrameIndicesAtTime(const TimeIndex& timeIndex, 
+            ushort* firstKeyIndex, ushort* secondKeyIndex) const;
+
 		/// Internal method for clone implementation
 		virtual void populateClone(AnimationTrack* clone) const;
 		
@@ -374,6 +384,8 @@ namespace Ogre
 		KeyFrame* createKeyFrameImpl(Real time);
 		// Flag indicating we need to rebuild the splines next time
 		virtual void buildInterpolationSplines(void) const;
+		/// Copies the transforms of the keyframes into mKeyFrameTransforms
+		void buildKeyFrameTransforms(void) const;
 
         // Struct for store splines, allocate on demand for better memory footprint
         struct Splines
@@ -389,6 +401,20 @@ namespace Ogre
 		mutable bool mSplineBuildNeeded;
 		/// Defines if rotation is done using shortest path
 		mutable bool mUseShortestRotationPath ;
+
+        /// Transform of a keyframe
+        struct KeyFrameTransform
+        {
+            Quaternion rotate;
+            Vector3 translate;
+            Vector3 scale;
+        };
+        typedef std::vector<KeyFrameTransform> KeyFrameTransformList;
+        /** Copy of the keyframe transforms in one contiguous list, so that 
+            sampling does not have to visit each KeyFrame; rebuilt lazily like
+            the splines. */
+        mutable KeyFrameTransformList mKeyFrameTransforms;
+        mutable bool mKeyFrameTransformsBuildNeeded;
 	};
 
 	/** Type of vertex animation.
@@ -169,6 +169,16 @@ namespace Ogre {
         /** Find out if the named file exists (note: fully qualified filename required) */
         virtual bool exists(const String& filename) = 0; 
 
+        /** Retrieve the modification time of a given file, or 0 if the
+            archive cannot tell.
+        @remarks
+            This is used to detect changes to files, e.g. to invalidate
+            caches built from them, so archives may return a time which
+            changes more often than the file itself (such as that of the
+            whole archive).
+        */
+        virtual time_t getModifiedTime(const String& filename) { return 0; }
+
         /** Find all files or directories matching a given pattern in this
             archive and get some detailed information about them.
         @param pattern The pattern to search for; wildcards (*) are allowed
@@ -196,6 +196,9 @@ namespace Ogre {
         /// @copydoc ParticleSystemRenderer::_updateRenderQueue
         void _updateRenderQueue(RenderQueue* queue, 
             std::list<Particle*>& currentParticles, bool cullIndividually);
+        /// @copydoc ParticleSystemRenderer::_updateRenderQueue
+        void _updateRenderQueue(RenderQueue* queue, 
+            std::vector<Particle*>& currentParticles, bool cullIndividually);
 		/// @copydoc ParticleSystemRenderer::visitRenderables
 		void visitRenderables(Renderable::Visitor* visitor, 
 			bool debugRenderables = false);
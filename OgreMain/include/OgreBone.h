@@ -112,6 +112,16 @@ namespace Ogre
 		/// @see Node::needUpdate
 		void needUpdate(bool forceParentUpdate = false);
 
+		/** Internal method called by the Skeleton once it has calculated the
+			derived transform of this bone.
+		@remarks
+			Takes the place of Node::_update; children of this bone which are
+			not bones of the same skeleton, such as TagPoints, are updated 
+			from here, whereas bones are left to the skeleton.
+		*/
+		void _updateFromSkeleton(const Quaternion& derivedOrientation,
+			const Vector3& derivedPosition, const Vector3& derivedScale);
+
 
     protected:
         /// The numeric handle of this bone
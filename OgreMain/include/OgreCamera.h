@@ -546,6 +546,10 @@ namespace Ogre {
 		bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const;
 		/// @copydoc Frustum::isVisible
 		bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
+		/// @copydoc Frustum::isVisible(const AxisAlignedBox*, size_t, uint32*)
+		void isVisible(const AxisAlignedBox* bounds, size_t count, uint32* visibility) const;
+		/// @copydoc Frustum::isVisible(const Sphere*, size_t, uint32*)
+		void isVisible(const Sphere* spheres, size_t count, uint32* visibility) const;
 		/// @copydoc Frustum::getWorldSpaceCorners
 		const Vector3* getWorldSpaceCorners(void) const;
 		/// @copydoc Frustum::getFrustumPlane
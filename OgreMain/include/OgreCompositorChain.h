@@ -168,6 +168,36 @@ namespace Ogre {
 		/// destroy internal resources
 		void destroyResources(void);
 
+		/// When in the compiled frame a local texture of an instance is used
+		struct TextureUse
+		{
+			/// Index of the first and last target operation using the texture
+			size_t firstUse;
+			size_t lastUse;
+			/// Whether the contents are only needed from the first use on
+			bool poolable;
+		};
+		typedef std::pair<CompositorInstance*, String> InstanceTexture;
+		typedef std::map<InstanceTexture, TextureUse> TextureUseMap;
+
+		/** Give the local textures of the enabled instances either a texture
+			from the CompositorManager's pool or one of their own, by the
+			lifetime of each within the compiled frame.
+		*/
+		void assignPooledTextures(CompositorInstance *lastComposition);
+		/** Record the texture uses of the target passes of an instance, and those
+			before it, in the order CompositorInstance::_compileTargetOperations
+			compiles them.
+		*/
+		void collectTargetTextureUses(CompositorInstance *inst, size_t &step, TextureUseMap &uses);
+		/** Record the texture uses of the output pass of an instance, in the
+			order CompositorInstance::_compileOutputOperation compiles them.
+		*/
+		void collectOutputTextureUses(CompositorInstance *inst, size_t step, TextureUseMap &uses);
+		/// Record the textures read by the passes of a target pass
+		void collectTextureReads(CompositorInstance *inst, CompositionTargetPass *target,
+			size_t step, TextureUseMap &uses);
+
 		/** Render queue listener used to set up rendering events. */
 		class _OgreExport RQListener: public RenderQueueListener
 		{
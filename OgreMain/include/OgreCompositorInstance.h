@@ -33,6 +33,7 @@ Torus Knot Software Ltd.
 #include "OgreMaterial.h"
 #include "OgreTexture.h"
 #include "OgreRenderQueue.h"
+#include "OgreCompositionTechnique.h"
 namespace Ogre {
     const size_t RENDER_QUEUE_COUNT = RENDER_QUEUE_MAX+1;       
             
@@ -227,6 +228,9 @@ namespace Ogre {
         /// Map from name->local texture
         typedef std::map<String,TexturePtr> LocalTextureMap;
         LocalTextureMap mLocalTextures;
+		/// Local names of the textures in mLocalTextures taken from the CompositorManager's pool
+		typedef std::set<String> PooledTextureSet;
+		PooledTextureSet mPooledTextures;
 		/// Store a list of MRTs we've created
 		typedef std::map<String,MultiRenderTarget*> LocalMRTMap;
 		LocalMRTMap mLocalMRTs;
@@ -257,6 +261,30 @@ namespace Ogre {
         */
         void freeResources();
 
+		/** Create a texture of our own for a local texture definition, unless we
+			already have one.
+		*/
+		void createLocalTexture(CompositionTechnique::TextureDefinition *def);
+
+		/** Use a texture from the CompositorManager's pool for a local texture,
+			in place of any texture of our own.
+		*/
+		void setPooledTexture(const String &name, const TexturePtr &tex);
+
+		/** Destroy the local texture with the given name, or let go of it if pooled.
+		*/
+		void freeLocalTexture(const String &name);
+
+		/** Add the viewport used to render to a local render target.
+		*/
+		void setupRenderTarget(RenderTarget *rendTarget);
+
+		/** Work out the size and options of the texture to create for a local
+			texture definition.
+		*/
+		void getTextureParams(const CompositionTechnique::TextureDefinition *def,
+			size_t &width, size_t &height, uint &fsaa, bool &hwGammaWrite);
+
         /** Get RenderTarget for a named local texture.
         */
         RenderTarget *getTargetForTex(const String &name);
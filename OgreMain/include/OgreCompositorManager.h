@@ -35,6 +35,7 @@ Torus Knot Software Ltd.
 #include "OgreRectangle2D.h"
 #include "OgreCompositorSerializer.h"
 #include "OgreRenderSystem.h"
+#include "OgreTexture.h"
 
 #if OGRE_THREAD_SUPPORT
 // boost::thread_specific_ptr has 'new' in header but delete in lib
@@ -122,6 +123,46 @@ namespace Ogre {
 		/** Internal method for forcing all active compositors to recreate their resources. */
 		void _reconstructAllCompositorResources();
 
+		/** Sets whether render textures are shared between compositor instances.
+		@remarks
+			By default every enabled CompositorInstance creates its own texture for
+			each texture it defines. With pooling enabled, textures whose contents
+			are only needed for part of the frame are instead taken from a pool
+			of render textures shared between all compositor chains. Each chain
+			works out when in the frame every texture is first written and last
+			read, and textures with the same size, format, FSAA and gamma settings
+			whose lifetimes don't overlap use the same pooled render texture.
+		@par
+			Textures which are read before they are written in a frame (so they
+			carry data from frame to frame), are rendered with 'only initial' set,
+			are not fully overwritten by their first render, are read by the final
+			output of a chain, or are multiple render targets are never pooled. 
+			Because pooled textures are shared, the names returned by 
+			CompositorInstance::getTextureInstanceName for them should not be used 
+			outside the compositor chain.
+		*/
+		void setRenderTargetPoolingEnabled(bool enabled);
+		/** Returns whether render textures are shared between compositor instances. */
+		bool getRenderTargetPoolingEnabled(void) const { return mRenderTargetPoolingEnabled; }
+
+		/** Gets a render texture from the pool shared by all compositor chains.
+		@remarks
+			For internal use by CompositorChain. A chain numbers the textures of
+			each kind which are in use at the same time from 0, and gets the same
+			texture for the same number as all other chains; this is safe since
+			no pooled texture holds data once the chain which wrote it has finished
+			rendering its targets.
+		@param index The number of the texture among those of this kind
+		*/
+		TexturePtr _getPooledTexture(size_t width, size_t height, PixelFormat format,
+			uint fsaa, bool hwGammaWrite, size_t index);
+
+		/** Destroys pooled render textures.
+		@param onlyIfUnreferenced If true, only the textures no compositor instance 
+			currently uses are destroyed
+		*/
+		void freePooledTextures(bool onlyIfUnreferenced = true);
+
 		/** Override standard Singleton retrieval.
 		@remarks
 		Why do we do this? Well, it's because the Singleton
@@ -168,6 +209,24 @@ namespace Ogre {
         void freeChains();
 
 		Rectangle2D *mRectangle;
+
+		/// The kind of a pooled render texture
+		struct PooledTextureKey
+		{
+			size_t width;
+			size_t height;
+			PixelFormat format;
+			uint fsaa;
+			bool hwGammaWrite;
+
+			bool operator<(const PooledTextureKey& rhs) const;
+		};
+		typedef std::vector<TexturePtr> PooledTextureList;
+		typedef std::map<PooledTextureKey, PooledTextureList> TexturePool;
+		TexturePool mTexturePool;
+		/// Number of pooled textures created, to give each a unique name
+		size_t mPooledTextureCount;
+		bool mRenderTargetPoolingEnabled;
     };
 }
 
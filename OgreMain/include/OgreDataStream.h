@@ -148,6 +148,16 @@ namespace Ogre {
 		*/
         size_t size(void) const { return mSize; }
 
+		/** Returns a pointer to the next count bytes of the stream, if the
+			stream already holds them in memory, or 0 otherwise.
+		@remarks
+			This lets callers copy data straight out of the stream without
+			reading it into an intermediate buffer first. The data is
+			read-only, the read position is not moved (use skip afterwards)
+			and the pointer is only valid until the stream is closed.
+		*/
+		virtual const uchar* getReadPtr(size_t count) const { return 0; }
+
         /** Close the stream; this makes further operations invalid. */
         virtual void close(void) = 0;
 		
@@ -275,6 +285,11 @@ namespace Ogre {
 		
 		/** Get a pointer to the current position in the memory block this stream holds. */
 		uchar* getCurrentPtr(void) { return mPos; }
+
+		/** @copydoc DataStream::getReadPtr
+		*/
+		const uchar* getReadPtr(size_t count) const
+		{ return (mData && count <= size_t(mEnd - mPos)) ? mPos : 0; }
 		
 		/** @copydoc DataStream::read
 		*/
@@ -316,6 +331,34 @@ namespace Ogre {
     */
     typedef SharedPtr<MemoryDataStream> MemoryDataStreamPtr;
 
+	/** Subclass of MemoryDataStream which maps a whole file into memory.
+	@remarks
+		The file contents are paged in by the operating system on demand
+		rather than being read through a stream buffer, and getReadPtr
+		exposes them directly, so loaders can copy large blocks of data
+		(e.g. vertex and index buffers) from the file straight to their
+		destination. The mapping is read-only; writing through getPtr is
+		not permitted.
+	@note
+		The file should not be modified or truncated while the stream is
+		open.
+	*/
+	class _OgreExport MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/** Map a file into memory.
+		@param name The name to give the stream
+		@param fileName The full path of the file to map
+		@note An exception is thrown if the file cannot be mapped.
+		*/
+		MappedFileDataStream(const String& name, const String& fileName);
+		~MappedFileDataStream();
+
+        /** @copydoc DataStream::close
+        */
+        void close(void);
+	};
+
     /** Common subclass of DataStream for handling data from 
 		std::basic_istream.
 	*/
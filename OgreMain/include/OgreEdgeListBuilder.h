@@ -182,9 +182,18 @@ namespace Ogre {
         /** Builds the edge information based on the information built up so far.
         @remarks
             The caller takes responsibility for deleting the returned structure.
+        @par
+            If a parallel WorkerThreadPool exists and there are at least
+            PARALLEL_BUILD_MIN_TRIANGLES triangles, the triangles are read from
+            the buffers (and their face normals calculated) across the pool.
+            Vertices are always welded and edges connected in order on the
+            calling thread, so the result is the same either way.
         */
         EdgeData* build(void);
 
+        /// Minimum number of triangles for build to read them in parallel
+        static const size_t PARALLEL_BUILD_MIN_TRIANGLES = 16384;
+
         /// Debugging method
         void log(Log* l);
     protected:
@@ -217,17 +226,6 @@ namespace Ogre {
                 return a.indexSet < b.indexSet;
             }
         };
-        /** Comparator for unique vertex list */
-        struct vectorLess {
-            bool operator()(const Vector3& a, const Vector3& b) const
-            {
-                if (a.x < b.x) return true;
-                if (a.x > b.x) return false;
-                if (a.y < b.y) return true;
-                if (a.y > b.y) return false;
-                return a.z < b.z;
-            }
-        };
 
         typedef std::vector<const VertexData*> VertexDataList;
         typedef std::vector<Geometry> GeometryList;
@@ -237,20 +235,70 @@ namespace Ogre {
         VertexDataList mVertexDataList;
         CommonVertexList mVertices;
         EdgeData* mEdgeData;
-		/// Map for identifying common vertices
-		typedef std::map<Vector3, size_t, vectorLess> CommonVertexMap;
-		CommonVertexMap mCommonVertexMap;
-        /** Edge map, used to connect edges. Note we allow many triangles on an edge,
-        after connected an existing edge, we will remove it and never used again.
+		/** Hash table for identifying common vertices, holding indexes into 
+            mVertices (or ~0 for empty buckets) in buckets picked by hashing the
+            exact position. Its size is always a power of 2.
+        */
+		typedef std::vector<size_t> CommonVertexHash;
+		CommonVertexHash mCommonVertexHash;
+        /** An edge waiting for its second triangle. Note we allow many triangles
+        on an edge; edges on the same pair of common vertices are connected in 
+        the order they were created, and each only once.
+        */
+        struct PendingEdge {
+            size_t vertexSet;   // The edge group the edge is in
+            size_t edgeIndex;   // The index of the edge in its group
+            size_t next;        // Next pending edge on the same vertices, or ~0
+        };
+        /** Edge hash table bucket, used to connect edges, holding the queue of
+        edges created on a pair of common vertices which are waiting for their 
+        second triangle.
+        */
+        struct EdgeBucket {
+            size_t sharedVertIndex[2];  // The common vertices, ~0 if the bucket is unused
+            size_t head;                // First pending edge, or ~0
+            size_t tail;                // Last pending edge, or ~0
+        };
+        typedef std::vector<EdgeBucket> EdgeHash;
+        typedef std::vector<PendingEdge> PendingEdgeList;
+        /// Edge hash table, its size is always a power of 2
+        EdgeHash mEdgeHash;
+        size_t mEdgeBucketsUsed;
+        PendingEdgeList mPendingEdges;
+        size_t mNumPendingEdges;
+
+        /// A triangle as read from the buffers of a Geometry, before welding
+        struct TriangleSource {
+            unsigned int vertIndex[3];  // The original vertex indexes
+            Vector3 position[3];        // The vertex positions
+            uint32 positionHash[3];     // Hashes of the positions, see mCommonVertexHash
+            Vector4 faceNormal;         // Unnormalised face normal
+        };
+        typedef std::vector<TriangleSource> TriangleSourceList;
+        /// Task reading a range of the triangles of a Geometry
+        class ReadTrianglesTask;
+        friend class ReadTrianglesTask;
+
+        /// Returns the number of triangles in a geometry
+        static size_t getTriangleCount(const Geometry &geometry);
+        /** Reads the triangles [first, first + count) of a geometry from its 
+            locked buffers. Strips and fans can only be read from the start.
         */
-        typedef std::multimap< std::pair<size_t, size_t>, std::pair<size_t, size_t> > EdgeMap;
-        EdgeMap mEdgeMap;
+        static void readTriangles(const Geometry &geometry, const VertexElement* posElem,
+            size_t vertexSize, const unsigned char* pBaseVertex, const void* pIndex,
+            size_t first, size_t count, TriangleSource* dest);
 
-        void buildTrianglesEdges(const Geometry &geometry);
+        void buildTrianglesEdges(const Geometry &geometry, const TriangleSourceList &triangles);
 
         /// Finds an existing common vertex, or inserts a new one
-        size_t findOrCreateCommonVertex(const Vector3& vec, size_t vertexSet, 
+        size_t findOrCreateCommonVertex(const Vector3& vec, uint32 hash, size_t vertexSet, 
             size_t indexSet, size_t originalIndex);
+        /// Doubles the size of the common vertex hash table
+        void growCommonVertexHash(void);
+        /// Finds the bucket of an edge, or the empty bucket it would go in
+        EdgeBucket& findEdgeBucket(size_t sharedVertIndex0, size_t sharedVertIndex1);
+        /// Doubles the size of the edge hash table
+        void growEdgeHash(void);
         /// Connect existing edge or create a new edge - utility method during building
         void connectOrCreateEdge(size_t vertexSet, size_t triangleIndex, size_t vertIndex0, size_t vertIndex1, 
             size_t sharedVertIndex0, size_t sharedVertIndex1);
@@ -509,6 +509,21 @@ namespace Ogre {
 		/** @copy MovableObject::getWorldBoundingSphere */
 		const Sphere& getWorldBoundingSphere(bool derive = false) const;
 
+		/** Intersects a world space ray with the triangles of this entity.
+		@remarks
+			The full detail mesh is tested using its MeshTriangleBVH, which is
+			built on demand. If vertex data of this entity has been animated in
+			software and its blended buffers are still valid, the animated 
+			positions are tested instead; those are read back and tested one
+			triangle at a time, so are a good deal slower. The blended 
+			buffers are released at the end of each frame, see 
+			RaySceneQuery::setTriangleAccurate.
+		@param worldRay The ray, in world space
+		@param hit Receives the closest hit; the distance is along worldRay
+		@returns true if the ray hits a triangle in front of its origin
+		*/
+		bool rayIntersectsTriangles(const Ray& worldRay, MeshTriangleHit& hit);
+
         /** Overridden member from ShadowCaster. */
         EdgeData* getEdgeList(void);
 		/** Overridden member from ShadowCaster. */
@@ -87,6 +87,9 @@ namespace Ogre {
         /// @copydoc Archive::exists
         bool exists(const String& filename);
 
+        /// @copydoc Archive::getModifiedTime
+        time_t getModifiedTime(const String& filename);
+
 		/// Set whether filesystem enumeration will include hidden files or not.
 		/// This should be called prior to declaring and/or initializing filesystem
 		/// resource locations. The default is true (ignore hidden files).
@@ -101,7 +104,27 @@ namespace Ogre {
 			return ms_IgnoreHidden;
 		}
 
+		/** Set the size at which files are memory mapped rather than read
+			through a file stream.
+		@remarks
+			Files of at least this many bytes are opened as a
+			MappedFileDataStream, which lets loaders such as the
+			MeshSerializer copy data straight from the file into their
+			buffers. The default of 0 disables mapping.
+		*/
+		static void setMemoryMapThreshold(size_t bytes)
+		{
+			ms_MemoryMapThreshold = bytes;
+		}
+
+		/// Get the size at which files are memory mapped, or 0 if disabled
+		static size_t getMemoryMapThreshold()
+		{
+			return ms_MemoryMapThreshold;
+		}
+
 		static bool ms_IgnoreHidden;
+		static size_t ms_MemoryMapThreshold;
     };
 
     /** Specialisation of ArchiveFactory for FileSystem files. */
@@ -127,6 +127,11 @@ namespace Ogre
         virtual void updateFrustumPlanes(void) const;
 		/// Implementation of updateFrustumPlanes (called if out of date)
 		virtual void updateFrustumPlanesImpl(void) const;
+		/** Gets the planes used for culling as normal and distance, skipping
+			the far plane if the view frustum is infinite.
+		@returns The number of planes written, at most 6
+		*/
+		size_t getCullingPlanes(Vector4* planes) const;
         virtual void updateWorldSpaceCorners(void) const;
 		/// Implementation of updateWorldSpaceCorners (called if out of date)
 		virtual void updateWorldSpaceCornersImpl(void) const;
@@ -431,6 +436,28 @@ namespace Ogre
         */
         virtual bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
 
+        /** Tests whether each of a set of boxes is visible in the Frustum.
+        @remarks
+            Gives the same results as calling the single box version for each
+            box, but tests several boxes at once using SIMD instructions where
+            available. Subclasses which override the single box version should
+            override this too.
+        @param
+            bounds Array of bounding boxes to be checked (world space)
+        @param
+            count Number of boxes in the array
+        @param
+            visibility Bit array receiving the results, with room for
+            (count + 31) / 32 words; bit i%32 of word i/32 is set if box i is
+            visible. Unused bits of the last word are cleared.
+        */
+        virtual void isVisible(const AxisAlignedBox* bounds, size_t count, uint32* visibility) const;
+
+        /** Tests whether each of a set of spheres is visible in the Frustum.
+        @see Frustum::isVisible(const AxisAlignedBox*, size_t, uint32*)
+        */
+        virtual void isVisible(const Sphere* spheres, size_t count, uint32* visibility) const;
+
 		/// Overridden from MovableObject::getTypeFlags
 		uint32 getTypeFlags(void) const;
 
@@ -798,6 +798,33 @@ namespace Ogre {
 		bool mIgnoreMissingParams;
         /// physical index for active pass iteration parameter real constant entry;
         size_t mActivePassIterationIndex;
+		/// Start of the physical float constants changed since the dirty ranges were cleared
+		size_t mFloatDirtyStart;
+		/// End (one past the last) of the physical float constants changed
+		size_t mFloatDirtyEnd;
+		/// Start of the physical int constants changed since the dirty ranges were cleared
+		size_t mIntDirtyStart;
+		/// End (one past the last) of the physical int constants changed
+		size_t mIntDirtyEnd;
+		/// The binding the dirty ranges were last cleared for, or null
+		const void* mDirtyRangeOwner;
+
+		/// Widen the float dirty range to include the given physical constants
+		void markFloatDirty(size_t physicalIndex, size_t count)
+		{
+			if (physicalIndex < mFloatDirtyStart)
+				mFloatDirtyStart = physicalIndex;
+			if (physicalIndex + count > mFloatDirtyEnd)
+				mFloatDirtyEnd = physicalIndex + count;
+		}
+		/// Widen the int dirty range to include the given physical constants
+		void markIntDirty(size_t physicalIndex, size_t count)
+		{
+			if (physicalIndex < mIntDirtyStart)
+				mIntDirtyStart = physicalIndex;
+			if (physicalIndex + count > mIntDirtyEnd)
+				mIntDirtyEnd = physicalIndex + count;
+		}
 
     public:
 		GpuProgramParameters();
@@ -998,6 +1025,42 @@ namespace Ogre {
 		*/
         void _writeRawConstant(size_t physicalIndex, const ColourValue& colour, 
 			size_t count = 4);
+
+		/** Gets the range of the physical float buffer which has to be uploaded
+			to bring a binding of these parameters up to date.
+		@remarks
+			Every write through _writeRawConstants (and so through setConstant,
+			setNamedConstant and the automatic parameter updates) which actually 
+			changes a value widens a dirty range. A render system which keeps 
+			the constants of a program between binds, and which has not bound 
+			any other parameters to that program since, only needs to upload 
+			this range. It identifies the program state with the binding 
+			pointer, which may be anything unique to it; if the dirty ranges 
+			were last cleared for a different binding, the whole buffer is 
+			returned.
+		@param binding Identifies the render system state being updated
+		@param start Set to the first physical index to upload
+		@param end Set to one past the last physical index to upload
+		@returns false if nothing needs uploading
+		*/
+		bool _getFloatDirtyRange(const void* binding, size_t& start, size_t& end) const;
+		/** Gets the range of the physical int buffer which has to be uploaded
+			to bring a binding of these parameters up to date.
+		@see _getFloatDirtyRange
+		*/
+		bool _getIntDirtyRange(const void* binding, size_t& start, size_t& end) const;
+		/** Clears the dirty ranges after the parameters have been uploaded to
+			the given binding.
+		@see _getFloatDirtyRange
+		*/
+		void _clearDirtyRanges(const void* binding);
+		/** Marks every constant as changed, so that the next bind uploads all
+			of them.
+		@note
+			Call this after writing constants through getFloatPointer or 
+			getIntPointer, which are not tracked.
+		*/
+		void _markAllDirty(void);
 		
 
         /** Gets an iterator over the named GpuConstantDefinition instances as defined
@@ -0,0 +1,115 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __LightSpatialIndex_H__
+#define __LightSpatialIndex_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreCommon.h"
+#include "OgreVector3.h"
+
+namespace Ogre {
+
+	/** Spatial index over a list of lights, used to find the lights which may 
+		reach a bounding sphere without testing every light.
+	@remarks
+		Point and spot lights are treated as spheres of their attenuation range
+		and hashed into a uniform grid whose cell size is derived from the 
+		typical light range. Directional lights, and lights whose range covers
+		too many cells, are kept in a separate list which every query returns.
+		Queries return a conservative set of candidates; it is up to the caller
+		to test them exactly.
+	@par
+		The index is a snapshot: it has to be built again whenever the list of
+		lights, or the position or range of any light in it, changes. For a 
+		small number of lights no grid is built and queries simply return every
+		light, since testing them directly is cheaper.
+	*/
+	class _OgreExport LightSpatialIndex
+	{
+	public:
+		/// List of indexes into the light list the index was built from
+		typedef std::vector<size_t> IndexList;
+
+	protected:
+		/// Number of lights in the list the index was built from
+		size_t mNumLights;
+		/// Size of one grid cell, or 0 if no grid was built
+		Real mCellSize;
+		/// Lights which every query returns, in light list order
+		IndexList mAlwaysIncluded;
+		/// Start of each bucket in mBucketEntries, plus one past the end
+		std::vector<size_t> mBucketStarts;
+		/// Lights overlapping the cells hashed to each bucket
+		IndexList mBucketEntries;
+
+		/// Calculate the bucket a cell hashes to
+		size_t getBucket(int x, int y, int z) const
+		{
+			// Large primes, as suggested by Teschner et al, 'Optimized Spatial 
+			// Hashing for Collision Detection of Deformable Objects'
+			return (size_t)(((uint32)x * 73856093U) ^ ((uint32)y * 19349663U) ^ 
+				((uint32)z * 83492791U)) & (mBucketStarts.size() - 2);
+		}
+		/// Calculate the range of cells overlapped by a sphere
+		void getCellRange(const Vector3& centre, Real radius, 
+			int* minCell, int* maxCell) const;
+
+	public:
+		LightSpatialIndex();
+
+		/// Below this number of lights no grid is built
+		static const size_t MIN_LIGHTS_FOR_GRID;
+		/// Lights overlapping more cells than this are always included
+		static const size_t MAX_CELLS_PER_LIGHT;
+		/// Queries overlapping more cells than this return every light
+		static const size_t MAX_CELLS_PER_QUERY;
+
+		/** Builds the index over the given lights, discarding any previous content. */
+		void build(const LightList& lights);
+		/** Empties the index. */
+		void clear(void);
+
+		/** Gets the number of lights in the list the index was built from. */
+		size_t getNumLights(void) const { return mNumLights; }
+		/** Returns whether a grid was built, as opposed to queries returning every light. */
+		bool hasGrid(void) const { return mCellSize > 0; }
+
+		/** Finds the lights which may reach a sphere.
+		@param position The centre of the sphere
+		@param radius The radius of the sphere
+		@param result List to which the indexes (in the list the index was built
+			from) of the candidate lights are appended. Each light appears at
+			most once, and the indexes appended are in ascending order.
+		*/
+		void findLights(const Vector3& position, Real radius, IndexList& result) const;
+	};
+
+}
+
+#endif
@@ -41,6 +41,7 @@ Torus Knot Software Ltd.
 #include "OgreSkeleton.h"
 #include "OgreAnimationTrack.h"
 #include "OgrePose.h"
+#include "OgreDataStream.h"
 
 
 namespace Ogre {
@@ -159,6 +160,8 @@ namespace Ogre {
         bool mPreparedForShadowVolumes;
         bool mEdgeListsBuilt;
         bool mAutoBuildEdgeLists;
+        /// Triangle hierarchy for exact ray intersections, if built
+        MeshTriangleBVH* mTriangleBVH;
 
 		/// Storage of morph animations, lookup by name
 		typedef std::map<String, Animation*> AnimationList;
@@ -172,8 +175,22 @@ namespace Ogre {
 		PoseList mPoseList;
 
 
+        /** Reads and parses the mesh file.
+		@remarks
+			Vertex and index data is kept in system memory buffers, so
+			nothing here talks to the render system; loadImpl only has to
+			create the hardware buffers.
+		*/
+        void prepareImpl(void);
+        /** Discards the data parsed by prepareImpl if it was never loaded.
+		*/
+        void unprepareImpl(void);
         /// @copydoc Resource::loadImpl
         void loadImpl(void);
+		/** Replaces the system memory buffers filled by prepareImpl with
+			hardware buffers holding the same data.
+		*/
+		void createHardwareBuffers(void);
 		/// @copydoc Resource::postLoadImpl
 		void postLoadImpl(void);
         /// @copydoc Resource::unloadImpl
@@ -655,6 +672,25 @@ namespace Ogre {
 		/** Returns whether this mesh has an attached edge list. */
 		bool isEdgeListBuilt(void) const { return mEdgeListsBuilt; }
 
+        /** Builds a MeshTriangleBVH for this mesh, which is used to intersect
+            rays with its triangles exactly.
+        @remarks
+            The vertex and index buffers must be readable, i.e. shadowed (the
+            default). This is done on demand by getTriangleBVH, or when the mesh
+            is loaded if MeshManager::setBuildTriangleBVHs is enabled. The 
+            hierarchy holds a copy of the geometry, so call this again if the 
+            geometry is changed afterwards.
+        */
+        void buildTriangleBVH(void);
+        /** Destroys the triangle hierarchy this mesh has built. */
+        void freeTriangleBVH(void);
+        /** Returns the triangle hierarchy of this mesh, building it if required.
+        @see Entity::rayIntersectsTriangles
+        */
+        const MeshTriangleBVH* getTriangleBVH(void);
+        /** Returns whether this mesh has built its triangle hierarchy. */
+        bool isTriangleBVHBuilt(void) const { return mTriangleBVH != 0; }
+
         /** Prepare matrices for software indexed vertex blend.
             @remarks
                 This function organise bone indexed matrices to blend indexed matrices,
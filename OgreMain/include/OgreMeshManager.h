@@ -319,6 +319,29 @@ namespace Ogre {
         /** Retrieves whether all Meshes should prepare themselves for shadow volumes. */
         bool getPrepareAllMeshesForShadowVolumes(void);
 
+        /** Sets whether meshes build their MeshTriangleBVH as they are loaded.
+        @remarks
+            Otherwise each mesh builds it the first time it is needed, for 
+            instance by a triangle accurate RaySceneQuery (see 
+            RaySceneQuery::setTriangleAccurate). Building at load time moves 
+            that cost out of the frame, and into background loading threads 
+            if meshes are loaded in the background. The default is false.
+        */
+        void setBuildTriangleBVHs(bool enable) { mBuildTriangleBVHs = enable; }
+        /** Gets whether meshes build their MeshTriangleBVH as they are loaded. */
+        bool getBuildTriangleBVHs(void) const { return mBuildTriangleBVHs; }
+
+        /** Sets whether Mesh::generateLodLevels reduces the submeshes of a mesh
+            concurrently on the WorkerThreadPool.
+        @remarks
+            This only makes a difference to meshes with more than one submesh,
+            and only when the pool has worker threads. The result is the same 
+            as reducing the submeshes one after another. The default is false.
+        */
+        void setParallelLodGeneration(bool enable) { mParallelLodGeneration = enable; }
+        /** Gets whether submeshes are reduced concurrently by Mesh::generateLodLevels. */
+        bool getParallelLodGeneration(void) const { return mParallelLodGeneration; }
+
         /** Override standard Singleton retrieval.
         @remarks
         Why do we do this? Well, it's because the Singleton
@@ -430,6 +453,8 @@ namespace Ogre {
         void loadManualCurvedIllusionPlane(Mesh* pMesh, MeshBuildParams& params);
 
         bool mPrepAllMeshesForShadowVolumes;
+        bool mParallelLodGeneration;
+        bool mBuildTriangleBVHs;
 	
 		//the factor by which the bounding box of an entity is padded	
 		Real mBoundsPaddingFactor;
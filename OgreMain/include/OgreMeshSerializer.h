@@ -92,6 +92,17 @@ namespace Ogre {
 		void setListener(MeshSerializerListener *listener);
 		/// Returns the current listener
 		MeshSerializerListener *getListener();
+
+		/** Sets whether importMesh puts geometry in system memory.
+		@remarks
+			When set, vertex and index data is read into plain memory buffers
+			which the render system knows nothing about, so a mesh can be
+			imported outside the rendering thread. Mesh::prepareImpl uses
+			this; Mesh::loadImpl then creates the hardware buffers.
+		*/
+		void setDeferHardwareBuffers(bool defer);
+		/// Gets whether importMesh puts geometry in system memory
+		bool getDeferHardwareBuffers(void) const;
     protected:
         static String msCurrentVersion;
 
@@ -99,6 +110,7 @@ namespace Ogre {
         MeshSerializerImplMap mImplementations;
 
 		MeshSerializerListener *mListener;
+		bool mDeferHardwareBuffers;
 
     };
 
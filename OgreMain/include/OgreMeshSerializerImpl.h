@@ -73,7 +73,12 @@ namespace Ogre {
         */
         void importMesh(DataStreamPtr& stream, Mesh* pDest, MeshSerializerListener *listener);
 
+        /// @copydoc MeshSerializer::setDeferHardwareBuffers
+        void setDeferHardwareBuffers(bool defer) { mDeferHardwareBuffers = defer; }
+
     protected:
+        /// Whether imported geometry goes into system memory buffers
+        bool mDeferHardwareBuffers;
 
         // Internal methods
         virtual void writeSubMeshNameTable(const Mesh* pMesh);
@@ -157,6 +162,21 @@ namespace Ogre {
 		virtual void readPoseKeyFrame(DataStreamPtr& stream, VertexAnimationTrack* track);
 		virtual void readExtremes(DataStreamPtr& stream, Mesh *pMesh);
 
+        /** Fill a whole hardware buffer straight from the stream if the stream
+            already holds the data in memory and it needs no endian conversion.
+        @returns true if the buffer was filled and the data skipped, false if
+            the caller has to read the data itself
+        */
+        bool readBufferDirect(DataStreamPtr& stream, HardwareBuffer* buf);
+
+        /// Create a vertex buffer for imported geometry
+        HardwareVertexBufferSharedPtr createVertexBuffer(size_t vertexSize,
+            size_t numVerts, HardwareBuffer::Usage usage, bool useShadowBuffer);
+        /// Create an index buffer for imported geometry
+        HardwareIndexBufferSharedPtr createIndexBuffer(
+            HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+            HardwareBuffer::Usage usage, bool useShadowBuffer);
+
 
         /// Flip an entire vertex buffer from little endian
         virtual void flipFromLittleEndian(void* pData, size_t vertexCount, size_t vertexSize, const VertexDeclaration::VertexElementList& elems);
@@ -0,0 +1,163 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __MeshTriangleBVH_H__
+#define __MeshTriangleBVH_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreVector3.h"
+#include "OgreRay.h"
+#include "OgreRenderOperation.h"
+
+namespace Ogre {
+
+	/** The closest intersection of a ray with the triangles of a mesh. */
+	struct _OgreExport MeshTriangleHit
+	{
+		/// Distance along the ray, in units of the ray's direction
+		Real distance;
+		/// Index of the sub mesh which was hit
+		ushort subMeshIndex;
+		/** Index of the triangle which was hit, counting the triangles of the
+			sub mesh's (full detail) index data in order, as they are rendered */
+		size_t triangleIndex;
+		/// Weights of the triangle's three vertices at the hit point
+		Vector3 barycentric;
+	};
+
+	/** Bounding volume hierarchy over the triangles of a Mesh, for exact ray
+		intersections.
+	@remarks
+		The hierarchy copies the object space positions of the mesh's 
+		vertices and the triangles of the full detail index data of every sub
+		mesh rendered as triangles, and sorts the triangles into a tree of 
+		boxes by splitting along the longest axis of their centres. Only 
+		branches whose boxes are hit before the closest hit found so far are 
+		visited, so a ray is tested against a handful of triangles rather than
+		all of them.
+	@par
+		Positions other than those of the mesh, such as the software animated
+		positions of an Entity, can also be intersected; they must be laid 
+		out as getPositions() is, and since the tree does not bound them every
+		triangle is tested.
+	@see Mesh::getTriangleBVH, Entity::rayIntersectsTriangles
+	*/
+	class _OgreExport MeshTriangleBVH
+	{
+	protected:
+		/// A triangle, with indexes into mPositions
+		struct Triangle
+		{
+			uint32 vertex[3];
+			ushort subMeshIndex;
+			uint32 triangleIndex;
+		};
+		typedef std::vector<Triangle> TriangleList;
+		TriangleList mTriangles;
+
+		/** A node of the tree; leaves hold a range of mTriangles, and the 
+			children of other nodes are the next node and secondChild. */
+		struct TreeNode
+		{
+			Vector3 minimum;
+			Vector3 maximum;
+			/// First triangle for leaves, second child for other nodes
+			uint32 start;
+			/// Number of triangles, 0 for nodes which are not leaves
+			uint32 count;
+		};
+		typedef std::vector<TreeNode> TreeNodeList;
+		TreeNodeList mNodes;
+
+		std::vector<Vector3> mPositions;
+		/// Index of the first position of each sub mesh's vertex data
+		std::vector<size_t> mSubMeshFirstVertex;
+		/// Number of positions of the shared vertex data, which come first
+		size_t mNumSharedVertices;
+
+		/// Adds the triangles of an index data set, offsetting indexes by firstVertex
+		void addTriangles(const IndexData* indexData, 
+			RenderOperation::OperationType opType, size_t firstVertex, 
+			ushort subMeshIndex);
+		/** Builds the node for a range of triangles and those below it.
+		@param order Indexes of the triangles in mTriangles, which are 
+			reordered so that each node's triangles are a contiguous range
+		*/
+		void buildNode(size_t nodeIndex, size_t begin, size_t end, 
+			const std::vector<Vector3>& centres, std::vector<size_t>& order);
+		/// Tests a triangle against the ray, updating distance and barycentric if it is closer
+		static bool intersectTriangle(const Ray& ray, const Vector3& a, 
+			const Vector3& b, const Vector3& c, Real& distance, Vector3& barycentric);
+
+	public:
+		/// Maximum number of triangles in a leaf of the tree
+		static const size_t MAX_LEAF_TRIANGLES = 4;
+		/// Maximum depth of the tree, which bounds the stack used by intersect
+		static const size_t MAX_TREE_DEPTH = 64;
+
+		/** Builds the hierarchy for a mesh, which must be loaded and must 
+			have readable (i.e. shadowed) vertex and index buffers. */
+		MeshTriangleBVH(const Mesh* mesh);
+		~MeshTriangleBVH();
+
+		/** Intersects a ray in the mesh's object space with its triangles.
+		@param ray The ray; its direction need not be normalised
+		@param hit Receives the closest hit, if there is one
+		@returns true if any triangle is hit in front of the ray's origin
+		*/
+		bool intersect(const Ray& ray, MeshTriangleHit& hit) const;
+		/** Intersects a ray with the triangles of the mesh placed at other 
+			positions.
+		@param positions Positions laid out as getPositions()
+		*/
+		bool intersect(const Ray& ray, const std::vector<Vector3>& positions,
+			MeshTriangleHit& hit) const;
+
+		/** Gets the vertex positions of the mesh: those of the shared vertex
+			data, followed by those of the vertex data of each sub mesh which
+			has its own, in sub mesh order. */
+		const std::vector<Vector3>& getPositions(void) const { return mPositions; }
+		/** Gets the index into getPositions of the first vertex of a sub mesh's
+			vertex data (which is 0 for sub meshes using shared vertices). */
+		size_t getSubMeshFirstVertex(ushort subMeshIndex) const
+		{ return mSubMeshFirstVertex[subMeshIndex]; }
+		/** Gets the number of triangles in the hierarchy. */
+		size_t getNumTriangles(void) const { return mTriangles.size(); }
+		/** Gets the number of nodes of the tree. */
+		size_t getNumNodes(void) const { return mNodes.size(); }
+
+		/** Reads the positions of a vertex data set into an array.
+		@param vertexData The vertex data, which must have readable buffers
+		@param dest Array receiving vertexData->vertexCount positions
+		*/
+		static void readPositions(const VertexData* vertexData, Vector3* dest);
+	};
+
+}
+
+#endif
@@ -201,8 +201,23 @@ namespace Ogre {
 		/** Node listener - only one allowed (no list) for size & performance reasons. */
 		Listener* mListener;
 
+		/// Transform store this node is laid out in, if any
+		NodeTransformStore* mTransformStore;
+		/// Index of this node in mTransformStore
+		size_t mTransformStoreIndex;
+
+		/** Class-specific implementation of _updateFromTransformStore.
+		@remarks
+			Equivalent of updateFromParentImpl, for when the derived transform 
+			has already been calculated by a NodeTransformStore.
+		*/
+		virtual void updateFromTransformStoreImpl(const Quaternion& derivedOrientation,
+			const Vector3& derivedPosition, const Vector3& derivedScale) const;
+
 		typedef std::vector<Node*> QueuedUpdates;
 		static QueuedUpdates msQueuedUpdates;
+		/// Mutex protecting msQueuedUpdates, since listeners may be called in parallel
+		OGRE_STATIC_MUTEX(msQueuedUpdatesMutex)
 
 
     public:
@@ -610,6 +625,63 @@ namespace Ogre {
         */
         virtual void _update(bool updateChildren, bool parentHasChanged);
 
+		/** A child node which is due to be updated, along with the parentHasChanged
+			flag it should be passed.
+		*/
+		struct PendingUpdate
+		{
+			Node* node;
+			bool parentHasChanged;
+			PendingUpdate(Node* n, bool changed) : node(n), parentHasChanged(changed) {}
+		};
+		typedef std::vector<PendingUpdate> PendingUpdateList;
+
+        /** Internal method to update this Node without cascading to its children.
+            @remarks
+                Does the same work on this node as _update(true, parentHasChanged),
+                except that rather than recursing into the children which need
+                updating, they are appended to the list supplied, so the caller
+                can update them itself (for example in parallel).
+            @note
+                Any post-update work a subclass does in its own _update override
+                (e.g. updating bounds in SceneNode) is not performed; the caller 
+                must do it once the collected children have been updated.
+            @param
+                parentHasChanged As for _update.
+            @param
+                children List to which the children requiring an update are appended.
+        */
+        void _updateCollectChildren(bool parentHasChanged, PendingUpdateList& children);
+
+        /** Internal method called by a NodeTransformStore when it has calculated
+			the derived transform of this node.
+            @remarks
+                Takes the place of _updateFromParent when the node is laid out in
+                a NodeTransformStore, raising the same events.
+        */
+        void _updateFromTransformStore(const Quaternion& derivedOrientation,
+			const Vector3& derivedPosition, const Vector3& derivedScale) const;
+
+        /** Internal method called by a NodeTransformStore once this node and all
+			its descendants have been updated.
+            @remarks
+                Takes the place of the end of _update when the node is laid out
+                in a NodeTransformStore; subclasses which do extra work in their
+                _update override should do the same work here.
+            @param
+                moved Whether the derived transform of this node itself changed.
+        */
+        virtual void _transformStoreUpdateComplete(bool moved);
+
+        /** Internal method called by a NodeTransformStore when it lays this 
+			node out, or with a null store when it no longer holds it. */
+        void _notifyTransformStore(NodeTransformStore* store, size_t index)
+		{ mTransformStore = store; mTransformStoreIndex = index; }
+        /** Gets the NodeTransformStore this node is laid out in, if any. */
+        NodeTransformStore* _getTransformStore(void) const { return mTransformStore; }
+        /** Gets the index of this node in its NodeTransformStore. */
+        size_t _getTransformStoreIndex(void) const { return mTransformStoreIndex; }
+
         /** Sets a listener for this Node.
 		@remarks
 			Note for size and performance reasons only one listener per node is
@@ -0,0 +1,199 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NodeTransformStore_H__
+#define __NodeTransformStore_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreVector3.h"
+#include "OgreQuaternion.h"
+
+namespace Ogre {
+
+	/** Keeps the local and derived transforms of a hierarchy of nodes in
+		contiguous arrays, so the parts of the hierarchy which changed can be 
+		updated in tight sweeps.
+	@remarks
+		The normal Node::_update recurses through the hierarchy, following 
+		pointers from parent to child and reading the parent's derived 
+		transform out of a different heap allocation for every node. This 
+		class instead lays the hierarchy out depth first, so every node comes
+		after its parent and every subtree is a contiguous range, and stores
+		each component of the local and derived transforms in its own array 
+		(structure of arrays). Nodes which changed are recorded as they change,
+		and an update sweeps forward over just the ranges of their subtrees,
+		only touching the nodes themselves to fetch the local transforms of 
+		nodes which changed and to hand back the results.
+	@par
+		Nodes in the hierarchy keep their own copies of the local and derived 
+		transforms, so the Node API works exactly as before; the store is only
+		told which nodes were changed (through Node::needUpdate) and which 
+		nodes were attached, detached or destroyed. On the next update only 
+		the subtrees of those nodes are laid out again, and the rest of the 
+		layout is shifted into place with array copies.
+	@note
+		Nodes whose class overrides updateFromParentImpl to calculate their 
+		derived transform differently are not supported.
+	*/
+	class _OgreExport NodeTransformStore
+	{
+	public:
+		/// Index of nodes attached to the store but not laid out yet
+		static const size_t PENDING_INDEX = ~static_cast<size_t>(0);
+
+	protected:
+		/// Root of the hierarchy kept in this store
+		Node* mRoot;
+		/// Nodes in depth first order; entries of nodes which left are null
+		std::vector<Node*> mNodes;
+		/// Index of the parent of each node (the root is its own parent)
+		std::vector<size_t> mParents;
+		/// One past the index of the last node in the subtree of each node
+		std::vector<size_t> mSubtreeEnds;
+
+		/// Local orientation
+		std::vector<Real> mOrientationW, mOrientationX, mOrientationY, mOrientationZ;
+		/// Local position
+		std::vector<Real> mPositionX, mPositionY, mPositionZ;
+		/// Local scale
+		std::vector<Real> mScaleX, mScaleY, mScaleZ;
+		/// Derived orientation
+		std::vector<Real> mDerivedOrientationW, mDerivedOrientationX, 
+			mDerivedOrientationY, mDerivedOrientationZ;
+		/// Derived position
+		std::vector<Real> mDerivedPositionX, mDerivedPositionY, mDerivedPositionZ;
+		/// Derived scale
+		std::vector<Real> mDerivedScaleX, mDerivedScaleY, mDerivedScaleZ;
+		/// Number of the Real arrays above
+		enum { NUM_REAL_ARRAYS = 20 };
+
+		enum NodeFlags
+		{
+			/// The node itself has changed since the last update
+			NF_DIRTY = 0x1,
+			/// The node inherits orientation from its parent
+			NF_INHERIT_ORIENTATION = 0x2,
+			/// The node inherits scale from its parent
+			NF_INHERIT_SCALE = 0x4,
+			/// The node or one of its descendants was updated during this update
+			NF_UPDATED = 0x8
+		};
+		/// Combination of NodeFlags for each node
+		std::vector<uint8> mFlags;
+
+		/// Range of the layout, [first, second)
+		typedef std::pair<size_t, size_t> Range;
+		typedef std::vector<Range> RangeList;
+		typedef std::vector<size_t> IndexList;
+		typedef std::vector<Node*> NodeList;
+
+		/// Indices of the nodes marked dirty since the last update
+		IndexList mDirtyNodes;
+		/// Indices of nodes whose subtrees have left their place in the layout
+		IndexList mRemovedNodes;
+		/// Indices of nodes which lost children, so need their update completed
+		IndexList mTouchedNodes;
+		/// Nodes attached to the hierarchy which have not been laid out yet
+		NodeList mPendingNodes;
+		/// Subtrees being recalculated during an update, in layout order
+		RangeList mUpdateRanges;
+		/// Nodes completed during an update besides those in mUpdateRanges
+		IndexList mUpdateAncestors;
+
+		/// Has the whole hierarchy to be laid out again?
+		bool mHierarchyChanged;
+
+		/// Gets pointers to all the Real arrays
+		void getRealArrays(std::vector<Real>** arrays);
+		/// Detach all nodes from the store and clear the arrays
+		void clear(void);
+		/// Lay out the whole hierarchy again, marking all nodes as dirty
+		void rebuild(void);
+		/// Lay out the subtrees of pending nodes and drop removed subtrees
+		void relayout(void);
+		/** Appends a node and all its descendants to a list in depth first 
+			order, along with the index of the parent of each within the list.
+			The first node is given as its own parent, i.e. 0. */
+		void layOutSubtree(Node* node, NodeList& nodes, IndexList& parents);
+		/// Calculate the subtree ends of all nodes from mParents
+		void calculateSubtreeEnds(void);
+		/// Copy the local transform of a node into the arrays
+		void fetchLocalTransform(size_t index);
+		/// Calculate the derived transforms of all nodes in mUpdateRanges
+		void calculateDerivedTransforms(void);
+		/** Marks a node and its ancestors as updated, up to the first which
+			already is, adding them to mUpdateAncestors. */
+		void markUpdated(size_t index);
+		/// Notify a node that its update is complete and reset its flags
+		void completeUpdate(size_t index, bool moved);
+
+	public:
+		/** Constructor.
+		@param root The root of the hierarchy, which must not have a parent;
+			all its descendants are added to the store, and any added to it 
+			later are picked up automatically.
+		*/
+		NodeTransformStore(Node* root);
+		/** Destructor, detaches all nodes from the store. */
+		~NodeTransformStore();
+
+		/** Updates the derived transforms of all nodes which need it.
+		@remarks
+			This has the same effect as calling _update(true, false) on the 
+			root node; nodes which moved are notified through 
+			Node::_updateFromTransformStore, then every node which was updated 
+			(or has a descendant which was, or lost a child) is notified through 
+			Node::_transformStoreUpdateComplete, children before their parents.
+		*/
+		void update(void);
+
+		/** Gets the root of the hierarchy kept in this store. */
+		Node* getRoot(void) const { return mRoot; }
+		/** Gets the number of nodes currently laid out in the store. */
+		size_t getNumNodes(void) const { return mNodes.size(); }
+
+		/** Internal method called by a node in the store when it needs an update. */
+		void _notifyNodeDirty(size_t index)
+		{
+			if (index < mFlags.size() && !(mFlags[index] & NF_DIRTY))
+			{
+				mFlags[index] |= NF_DIRTY;
+				mDirtyNodes.push_back(index);
+			}
+		}
+		/** Internal method called when a node is attached to a node in the store. */
+		void _notifyNodeAdded(Node* node);
+		/** Internal method called when a node in the store is detached from its parent. */
+		void _notifyNodeRemoved(Node* node);
+		/** Internal method called by a node in the store when it is destroyed. */
+		void _notifyNodeDestroyed(size_t index, Node* node);
+	};
+
+}
+
+#endif
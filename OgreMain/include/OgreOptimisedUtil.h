@@ -194,6 +194,94 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Tests a set of axis-aligned boxes against a set of planes.
+        @remarks
+            A box is culled if it lies entirely on the negative side of any
+            of the planes, as decided by Plane::getSide. This is the test
+            Frustum::isVisible performs for a single box.
+        @param planes Array of planes, the normal in x, y, z and the
+            distance in w. No alignment requirement.
+        @param numPlanes Number of planes.
+        @param centres Array of box centres. No alignment requirement.
+        @param halfSizes Array of box half sizes, which must not be
+            negative. No alignment requirement.
+        @param visibility Array of (numBoxes + 31) / 32 words to receive a
+            bit per box; bit (i % 32) of word (i / 32) is set if box i is not
+            culled. The bits after the last box are cleared.
+        @param numBoxes Number of boxes to test.
+        */
+        virtual void cullBoxes(
+            const Vector4* planes,
+            size_t numPlanes,
+            const Vector3* centres,
+            const Vector3* halfSizes,
+            uint32* visibility,
+            size_t numBoxes) = 0;
+
+        /** Tests a set of spheres against a set of planes.
+        @remarks
+            A sphere is culled if its centre is further than its radius
+            from any of the planes, on the negative side. This is the test
+            Frustum::isVisible performs for a single sphere.
+        @param planes Array of planes, the normal in x, y, z and the
+            distance in w. No alignment requirement.
+        @param numPlanes Number of planes.
+        @param spheres Array of spheres, the centre in x, y, z and the
+            radius in w. No alignment requirement.
+        @param visibility Array of (numSpheres + 31) / 32 words to receive
+            a bit per sphere, as for cullBoxes.
+        @param numSpheres Number of spheres to test.
+        */
+        virtual void cullSpheres(
+            const Vector4* planes,
+            size_t numPlanes,
+            const Vector4* spheres,
+            uint32* visibility,
+            size_t numSpheres) = 0;
+
+        /** Calculates the matrices which take a set of bones from their
+            binding pose to their current pose.
+        @remarks
+            For each bone this is the matrix Bone::_getOffsetTransform
+            calculates from the derived transform of the bone and the inverse
+            of its derived transform in the binding pose.
+        @param orientations Array of derived orientations. No alignment
+            requirement.
+        @param positions Array of derived positions. No alignment requirement.
+        @param scales Array of derived scales. No alignment requirement.
+        @param bindInverseOrientations Array of inverse derived orientations
+            in the binding pose. No alignment requirement.
+        @param bindInversePositions Array of inverse derived positions in the
+            binding pose. No alignment requirement.
+        @param bindInverseScales Array of inverse derived scales in the binding
+            pose. No alignment requirement.
+        @param dstMatrices Array of matrices to receive the results. No
+            alignment requirement.
+        @param numBones Number of bones.
+        */
+        virtual void calculateBoneOffsetMatrices(
+            const Quaternion* orientations,
+            const Vector3* positions,
+            const Vector3* scales,
+            const Quaternion* bindInverseOrientations,
+            const Vector3* bindInversePositions,
+            const Vector3* bindInverseScales,
+            Matrix4* dstMatrices,
+            size_t numBones) = 0;
+
+        /** Moves a set of particles along their direction.
+        @remarks
+            This is the motion ParticleSystem applies to the active particles
+            every frame, i.e. position += direction * timeElapsed.
+        @param particles Array of pointers to the particles to move.
+        @param count Number of particles.
+        @param timeElapsed The number of seconds to move the particles for.
+        */
+        virtual void applyParticleMotion(
+            Particle* const* particles,
+            size_t count,
+            Real timeElapsed) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
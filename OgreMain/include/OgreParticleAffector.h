@@ -100,6 +100,23 @@ namespace Ogre {
         */
         virtual void _affectParticles(ParticleSystem* pSystem, Real timeElapsed) = 0;
 
+        /** Method called to apply the affector to an array of particles.
+        @remarks
+            Affectors which apply the same change to every particle should override 
+            this method and process the array in one tight loop, hoisting everything 
+            which does not depend on the particle out of the loop, then implement
+            _affectParticles by passing it ParticleSystem::_getActiveParticles.
+            The default implementation does nothing.
+        @param
+            particles Array of pointers to the particles to affect.
+        @param
+            count The number of particles in the array.
+        @param
+            timeElapsed The number of seconds which have elapsed since the last call.
+        */
+        virtual void _affectParticleBatch(Particle* const* particles, size_t count, 
+            Real timeElapsed) { /* by default do nothing */ }
+
         /** Returns the name of the type of affector. 
         @remarks
             This property is useful for determining the type of affector procedurally so another
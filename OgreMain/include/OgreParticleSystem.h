@@ -342,6 +342,17 @@ namespace Ogre {
         */
         ParticleIterator _getIterator(void);
 
+        /** Returns the active particles as a contiguous array.
+        @remarks
+            The array holds getNumParticles() entries and is only valid until
+            particles are next created, expired or sorted. It is intended for
+            ParticleAffector subclasses which process all particles in one
+            tight loop; see ParticleAffector::_affectParticleBatch.
+        @returns A pointer to the first active particle, or null if there are none.
+        */
+        Particle* const* _getActiveParticles(void) const 
+        { return mActiveParticles.empty() ? 0 : &mActiveParticles[0]; }
+
         /** Sets the name of the material to be used for this billboard set.
             @param
                 name The new name of the material to use for this set.
@@ -674,9 +685,10 @@ namespace Ogre {
         /// Indication whether the emitted emitter pool (= pool with particle emitters that are emitted) is initialised
 		bool mEmittedEmitterPoolInitialised;
 
-        typedef std::list<Particle*> ActiveParticleList;
-        typedef std::list<Particle*> FreeParticleList;
+        typedef std::vector<Particle*> ActiveParticleList;
+        typedef std::vector<Particle*> FreeParticleList;
         typedef std::vector<Particle*> ParticlePool;
+        typedef std::vector<Particle*> ParticleBlockList;
 
         /** Sort by direction functor */
         struct SortByDirectionFunctor
@@ -702,23 +714,24 @@ namespace Ogre {
 
 		/** Active particle list.
             @remarks
-                This is a linked list of pointers to particles in the particle pool.
+                This is a contiguous array of pointers to particles in the particle pool.
             @par
-                This allows very fast insertions and deletions from anywhere in 
-                the list to activate / deactivate particles as well as reuse of 
-                Particle instances in the pool without construction & destruction 
-                which avoids memory thrashing.
+                New particles are appended, and expired particles are removed by
+                compacting the survivors in place, so the particles stay in the order
+                they were emitted in and the per-frame passes over them walk an array
+                rather than list nodes. Particle instances are reused from the pool
+                without construction & destruction which avoids memory thrashing.
         */
         ActiveParticleList mActiveParticles;
 
-        /** Free particle queue.
+        /** Free particle stack.
             @remarks
-                This contains a list of the particles free for use as new instances
+                This contains the particles free for use as new instances
                 as required by the set. Particle instances are preconstructed up 
                 to the estimated size in the mParticlePool vector and are 
-                referenced on this deque at startup. As they get used this list
-                reduces, as they get released back to to the set they get added
-				back to the list.
+                referenced on this stack at startup. As they get used this stack
+                reduces, as they get released back to to the set they get pushed
+				back on to it.
         */
         FreeParticleList mFreeParticles;
 
@@ -728,6 +741,14 @@ namespace Ogre {
         */
         ParticlePool mParticlePool;
 
+        /** Arrays the particles in mParticlePool were allocated in.
+            @remarks
+                Each increase of the pool constructs its new particles in a single
+                array, so that particles which are next to each other in the pool
+                are also next to each other in memory.
+        */
+        ParticleBlockList mParticleBlocks;
+
 		typedef std::list<ParticleEmitter*> FreeEmittedEmitterList;
 		typedef std::list<ParticleEmitter*> ActiveEmittedEmitterList;
 		typedef std::vector<ParticleEmitter*> EmittedEmitterList;
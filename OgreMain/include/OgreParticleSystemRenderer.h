@@ -45,7 +45,8 @@ namespace Ogre {
     {
     public:
         /// Constructor
-        ParticleSystemRenderer() {}
+        ParticleSystemRenderer() 
+			: mForwardParticleMoved(true), mForwardParticleCleared(true) {}
         /// Destructor
         virtual ~ParticleSystemRenderer() {}
 
@@ -59,6 +60,18 @@ namespace Ogre {
         */
         virtual void _updateRenderQueue(RenderQueue* queue, 
             std::list<Particle*>& currentParticles, bool cullIndividually) = 0;
+		/** Delegated to by ParticleSystem::_updateRenderQueue, with the active 
+			particles as ParticleSystem keeps them.
+		@remarks
+			The default copies the particles into a list for the version above;
+			renderers should override this too to avoid the copy.
+		*/
+        virtual void _updateRenderQueue(RenderQueue* queue, 
+            std::vector<Particle*>& currentParticles, bool cullIndividually)
+		{
+			std::list<Particle*> particles(currentParticles.begin(), currentParticles.end());
+			_updateRenderQueue(queue, particles, cullIndividually);
+		}
 
         /** Sets the material this renderer must use; called by ParticleSystem. */
         virtual void _setMaterial(MaterialPtr& mat) = 0;
@@ -79,9 +92,43 @@ namespace Ogre {
         /** Optional callback notified when particle expired */
         virtual void _notifyParticleExpired(Particle* particle) {}
         /** Optional callback notified when particles moved */
-        virtual void _notifyParticleMoved(std::list<Particle*>& currentParticles) {}
+        virtual void _notifyParticleMoved(std::list<Particle*>& currentParticles) 
+		{
+			// Not overridden, so no need to build the list for it again
+			mForwardParticleMoved = false;
+		}
+        /** Optional callback notified when particles moved, with the active 
+			particles as ParticleSystem keeps them.
+		@remarks
+			The default copies the particles into a list for the version above,
+			unless that turned out not to be overridden.
+		*/
+        virtual void _notifyParticleMoved(std::vector<Particle*>& currentParticles) 
+		{
+			if (mForwardParticleMoved)
+			{
+				std::list<Particle*> particles(currentParticles.begin(), currentParticles.end());
+				_notifyParticleMoved(particles);
+			}
+		}
         /** Optional callback notified when particles cleared */
-        virtual void _notifyParticleCleared(std::list<Particle*>& currentParticles) {}
+        virtual void _notifyParticleCleared(std::list<Particle*>& currentParticles) 
+		{
+			// Not overridden, so no need to build the list for it again
+			mForwardParticleCleared = false;
+		}
+        /** Optional callback notified when particles cleared, with the active 
+			particles as ParticleSystem keeps them; forwarded to the version 
+			above by default, as for _notifyParticleMoved.
+		*/
+        virtual void _notifyParticleCleared(std::vector<Particle*>& currentParticles) 
+		{
+			if (mForwardParticleCleared)
+			{
+				std::list<Particle*> particles(currentParticles.begin(), currentParticles.end());
+				_notifyParticleCleared(particles);
+			}
+		}
 		/** Create a new ParticleVisualData instance for attachment to a particle.
 		@remarks
 			If this renderer needs additional data in each particle, then this should
@@ -118,6 +165,12 @@ namespace Ogre {
 		virtual void visitRenderables(Renderable::Visitor* visitor, 
 			bool debugRenderables = false) = 0;
 
+	protected:
+		/// Do std::list overrides of _notifyParticleMoved need to be called?
+		bool mForwardParticleMoved;
+		/// Do std::list overrides of _notifyParticleCleared need to be called?
+		bool mForwardParticleCleared;
+
     };
 
     /** Abstract class definition of a factory object for ParticleSystemRenderer. */
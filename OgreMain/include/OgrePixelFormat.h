@@ -465,8 +465,20 @@ namespace Ogre {
 		 	@param	dst			PixelBox containing the destination pixels, pitches and format
 		 	@remarks The source and destination boxes must have the same
          	dimensions. In case the source and destination format match, a plain copy is done.
+			@par
+				Boxes of at least PARALLEL_CONVERSION_MIN_PIXELS pixels are split into
+				bands which are converted across the WorkerThreadPool, if it has worker
+				threads.
         */
         static void bulkPixelConversion(const PixelBox &src, const PixelBox &dst);
+
+		/** Convert pixels from one format to another in the calling thread only.
+			@see PixelUtil::bulkPixelConversion
+		*/
+		static void _bulkPixelConversionSerial(const PixelBox &src, const PixelBox &dst);
+
+		/// Smallest number of pixels which bulkPixelConversion converts in parallel
+		static const size_t PARALLEL_CONVERSION_MIN_PIXELS = 256 * 256;
     };
 
 }
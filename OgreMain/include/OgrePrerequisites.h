@@ -268,11 +268,14 @@ namespace Ogre {
     class MeshPtr;
     class MeshSerializer;
     class MeshSerializerImpl;
+    class MeshTriangleBVH;
+    struct MeshTriangleHit;
     class MeshManager;
     class MovableObject;
     class MovablePlane;
     class Node;
 	class NodeAnimationTrack;
+	class NodeTransformStore;
 	class NodeKeyFrame;
 	class NumericAnimationTrack;
 	class NumericKeyFrame;
@@ -333,6 +336,7 @@ namespace Ogre {
     class SceneManagerEnumerator;
     class SceneNode;
     class SceneQuery;
+    class SceneQueryBVH;
     class SceneQueryListener;
 	class ScriptCompiler;
 	class ScriptCompilerManager;
@@ -347,6 +351,7 @@ namespace Ogre {
     class SkeletonPtr;
     class SkeletonInstance;
     class SkeletonManager;
+	class SoftwareSkinningBatch;
     class Sphere;
     class SphereSceneQuery;
 	class StaticGeometry;
@@ -376,6 +381,7 @@ namespace Ogre {
     class VertexDeclaration;
 	class VertexMorphKeyFrame;
     class WireBoundingBox;
+	class WorkerThreadPool;
     class Compositor;
     class CompositorManager;
     class CompositorChain;
@@ -46,25 +46,44 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #include "OgreSingleton.h"
 #include "OgreString.h"
 #include "OgreOverlay.h"
+#if OGRE_THREAD_SUPPORT
+// boost::thread_specific_ptr has 'new' in header but delete in lib
+// so if we use our memory manager it reports leaks incorrectly
+#	include "OgreNoMemoryMacros.h"
+#	include <boost/thread/tss.hpp>
+#	include "OgreMemoryMacros.h"
+#endif
 
 #if OGRE_PROFILING == 1
 #   if OGRE_COMPILER != OGRE_COMPILER_BORL
 #       define OgreProfile( a ) Ogre::Profile _OgreProfileInstance( (a) )
 #       define OgreProfileBegin( a ) Ogre::Profiler::getSingleton().beginProfile( (a) )
 #       define OgreProfileEnd( a ) Ogre::Profiler::getSingleton().endProfile( (a) )
+#       define OgreProfileCapture( a ) \
+            static const Ogre::ProfileId _OgreProfileCaptureId = \
+                Ogre::Profiler::getSingleton().registerCaptureProfile( (a) ); \
+            Ogre::ProfileCaptureScope _OgreProfileCaptureInstance( _OgreProfileCaptureId )
 #   else
 #	    define OgreProfile( a ) Ogre::Profile _OgreProfileInstance( __FUNC__ )
 #	    define OgreProfileBegin( a ) Ogre::Profiler::getSingleton().beginProfile( __FUNC__ )
 #	    define OgreProfileEnd( a ) Ogre::Profiler::getSingleton().endProfile( __FUNC__ )
+#       define OgreProfileCapture( a ) \
+            static const Ogre::ProfileId _OgreProfileCaptureId = \
+                Ogre::Profiler::getSingleton().registerCaptureProfile( __FUNC__ ); \
+            Ogre::ProfileCaptureScope _OgreProfileCaptureInstance( _OgreProfileCaptureId )
 #   endif
 #else
 #   define OgreProfile( a )
 #   define OgreProfileBegin( a )
 #   define OgreProfileEnd( a )
+#   define OgreProfileCapture( a )
 #endif
 
 namespace Ogre {
 
+    /// Identifier of a profile registered for capture, see Profiler::registerCaptureProfile
+    typedef uint32 ProfileId;
+
     /** An individual profile that will be processed by the Profiler
         @remarks
             Use the macro OgreProfile(name) instead of instantiating this profile directly
@@ -199,6 +218,57 @@ namespace Ogre {
             /** Gets the frequency that the Profiler display is updated */
             uint getUpdateDisplayFrequency() const;
 
+            /** Registers a profile for capture and returns its identifier
+            @remarks
+                Use the macro OgreProfileCapture(name) instead of calling this
+                directly; it registers the name once per call site and keeps
+                the identifier in a static. Registering a name twice returns
+                the same identifier. This is safe to call from any thread.
+            */
+            ProfileId registerCaptureProfile(const String& profileName);
+
+            /** Gets the name a capture profile was registered with */
+            const String& getCaptureProfileName(ProfileId id) const;
+
+            /** Starts recording every OgreProfileCapture scope 
+            @remarks
+                Capture is separate from the profile display; it records one 
+                event per scope with its start time and duration, and works on 
+                any thread. Each thread records into its own ring buffer, so 
+                when a buffer fills up its oldest events are overwritten. 
+                Start and end captures from the main thread between frames, 
+                while no other thread is running profiled code. When no capture is running each
+                scope costs a single test of a flag.
+            @param eventsPerThread The size of each thread's ring buffer
+            */
+            void beginCapture(size_t eventsPerThread = 65536);
+
+            /** Stops recording capture events, keeping the events recorded */
+            void endCapture(void);
+
+            /** Returns true while a capture is running 
+            @note
+                Safe to call from worker threads only while the main thread 
+                is not in beginCapture or endCapture, see beginCapture.
+            */
+            static bool isCapturing(void) { return msCapturing; }
+
+            /** Writes the events of the last capture in the Chrome trace event 
+                JSON format, which chrome://tracing and compatible tools load.
+            */
+            void writeCapture(std::ostream& os) const;
+
+            /** Writes the events of the last capture to a file in the Chrome 
+                trace event JSON format.
+            */
+            void saveCapture(const String& filename) const;
+
+            /** Gets the current time for a capture event, internal method */
+            ulong _getCaptureTime(void);
+
+            /** Records a capture event which ends now, internal method */
+            void _recordCaptureEvent(ProfileId id, ulong start);
+
             /** Override standard Singleton retrieval.
             @remarks
             Why do we do this? Well, it's because the Singleton
@@ -408,8 +478,91 @@ namespace Ogre {
             /// which will be applied after the frame ends
             bool mNewEnableState;
 
+            /// An event recorded by a capture
+            struct CaptureEvent
+            {
+                ProfileId id;
+                ulong start;
+                ulong end;
+            };
+
+            /// Ring buffer of the capture events recorded by one thread
+            struct CaptureBuffer
+            {
+                std::vector<CaptureEvent> events;
+                /// Where the next event will be written
+                size_t next;
+                /// Whether next has wrapped around, so all events are valid
+                bool wrapped;
+                /// Index of the thread in the written capture
+                size_t threadIndex;
+            };
+
+            /// Per-thread link to a buffer; the buffers themselves are owned 
+            /// by the profiler so they outlive the threads which wrote them
+            struct CaptureBufferHandle
+            {
+                CaptureBuffer* buffer;
+            };
+
+            typedef std::vector<CaptureBuffer*> CaptureBufferList;
+            typedef std::map<String, ProfileId> CaptureProfileMap;
+
+            /// Get the capture buffer of the calling thread, creating it if necessary
+            CaptureBuffer* getThreadCaptureBuffer(void);
+
+            /// Names of the capture profiles, indexed by ProfileId
+            std::vector<String> mCaptureProfileNames;
+            /// Capture profile identifiers by name
+            CaptureProfileMap mCaptureProfileIds;
+            /// All capture buffers
+            CaptureBufferList mCaptureBuffers;
+            OGRE_THREAD_POINTER(CaptureBufferHandle, mThreadCaptureBuffer);
+            /// Size of each capture buffer
+            size_t mCaptureBufferSize;
+            /// The time the last capture started
+            ulong mCaptureStart;
+            OGRE_MUTEX(mCaptureMutex)
+
+            /** Whether a capture is running
+            @remarks
+                Not atomic: it is only written by beginCapture and endCapture 
+                on the main thread, between frames. Worker threads read it 
+                only while running tasks the main thread has handed out and 
+                waits on, and handing tasks out and waiting on them goes 
+                through the work queue mutex, which orders the accesses.
+            */
+            static bool msCapturing;
+
     }; // end class
 
+    /** Records a capture event for the scope it is declared in
+        @remarks
+            Use the macro OgreProfileCapture(name) rather than declaring this
+            directly, so that capture points compile away when OGRE_PROFILING 
+            is 0.
+    */
+    class _OgreExport ProfileCaptureScope
+    {
+        public:
+            ProfileCaptureScope(ProfileId id)
+                : mId(id), mActive(Profiler::isCapturing()), mStart(0)
+            {
+                if (mActive)
+                    mStart = Profiler::getSingleton()._getCaptureTime();
+            }
+            ~ProfileCaptureScope()
+            {
+                if (mActive)
+                    Profiler::getSingleton()._recordCaptureEvent(mId, mStart);
+            }
+
+        protected:
+            ProfileId mId;
+            bool mActive;
+            ulong mStart;
+    };
+
 } // end namespace
 
 #endif
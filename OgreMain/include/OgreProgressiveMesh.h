@@ -52,6 +52,12 @@ namespace Ogre {
         used by any geometry provider. The only limitation at the moment is that the 
         provider uses a common vertex buffer for all LODs and one index buffer per LOD.
         Therefore at the moment this class can only handle indexed geometry.
+    @par
+        Building is split into computeLODs, which performs the edge collapses on data
+        owned by this object only, and createLODs, which creates the index buffers. 
+        Different ProgressiveMesh instances can therefore run computeLODs concurrently
+        in different threads, as Mesh::generateLodLevels does when 
+        MeshManager::setParallelLodGeneration is enabled.
     @par
         NB the interface of this class will certainly change when compiled vertex buffers are
         supported.
@@ -109,6 +115,22 @@ namespace Ogre {
         virtual void build(ushort numLevels, LODFaceList* outList, 
 			VertexReductionQuota quota = VRQ_PROPORTIONAL, Real reductionValue = 0.5f );
 
+        /** Performs the reduction for the specified number of levels, keeping the 
+            resulting index lists in system memory until createLODs is called.
+        @remarks
+            This reads no hardware buffers and calls no managers, so it is safe to 
+            call concurrently on different ProgressiveMesh instances.
+        @see ProgressiveMesh::build
+        */
+        virtual void computeLODs(ushort numLevels, 
+			VertexReductionQuota quota = VRQ_PROPORTIONAL, Real reductionValue = 0.5f );
+
+        /** Creates index data for each level found by the last computeLODs call.
+        @param outList Pointer to a list of LOD geometry data which will be completed by the application.
+			Each entry is a reduced form of the mesh, in decreasing order of detail.
+        */
+        virtual void createLODs(LODFaceList* outList);
+
     protected:
         const VertexData *mpVertexData;
         const IndexData *mpIndexData;
@@ -186,6 +208,9 @@ namespace Ogre {
         typedef std::vector<PMFaceVertex> FaceVertexList;
         typedef std::vector<PMVertex> CommonVertexList;
         typedef std::vector<Real> WorstCostList;
+        typedef std::vector<size_t> CollapseHeap;
+        typedef std::vector<uint32> LODIndexList;
+        typedef std::vector<LODIndexList> LODIndexListList;
 
         /// Data used to calculate the collapse costs
         struct PMWorkingData
@@ -195,13 +220,24 @@ namespace Ogre {
 			CommonVertexList mVertList; // The master list of common vertices
         };
 
-        typedef std::vector<PMWorkingData> WorkingDataList;
+        /** A list rather than a vector, since the vertices and triangles point
+            at each other, and so must not move when another buffer is added */
+        typedef std::list<PMWorkingData> WorkingDataList;
         /// Multiple copies, 1 per vertex buffer
         WorkingDataList mWorkingData;
 
         /// The worst collapse cost from all vertex buffers for each vertex
         WorstCostList mWorstCosts;
 
+        /** Binary min-heap of common vertex indexes, ordered by mWorstCosts and 
+            then by index, so the top is the vertex a linear scan would pick. */
+        CollapseHeap mCollapseHeap;
+        /// The position of each common vertex in mCollapseHeap
+        CollapseHeap mCollapseHeapPos;
+
+        /// Index lists of the levels found by computeLODs
+        LODIndexListList mLODIndexLists;
+
         /// Internal method for building PMWorkingData from geometry data
         void addWorkingData(const VertexData* vertexData, const IndexData* indexData);
 
@@ -218,7 +254,22 @@ namespace Ogre {
         /// Internal method for getting the index of next best vertex to collapse
         size_t getNextCollapser(void);
         /// Internal method builds an new LOD based on the current state
-        void bakeNewLOD(IndexData* pData);
+        void bakeNewLOD(LODIndexList& indexes);
+
+        /// Internal method to build mCollapseHeap from mWorstCosts
+        void initialiseCollapseHeap(void);
+        /// Internal method to restore heap order after the cost of a vertex changed
+        void updateCollapseHeap(size_t vertIndex);
+        /// Does vertex a come before vertex b in the collapse order?
+        bool collapsesBefore(size_t a, size_t b) const
+        {
+            return mWorstCosts[a] < mWorstCosts[b] || 
+                (mWorstCosts[a] == mWorstCosts[b] && a < b);
+        }
+        /// Internal method moving a heap entry up to its place
+        void collapseHeapSiftUp(size_t pos);
+        /// Internal method moving a heap entry down to its place
+        void collapseHeapSiftDown(size_t pos);
 
         /** Internal method, collapses vertex onto it's saved collapse target. 
         @remarks
@@ -784,6 +784,51 @@ namespace Ogre
 		virtual unsigned int _getBatchCount(void) const;
 		/** Reports the number of vertices passed to the renderer since the last _beginGeometryCount call. */
 		virtual unsigned int _getVertexCount(void) const;
+		/** Reports the number of 4-component GPU program constants uploaded 
+			since the last _beginGeometryCount call.
+		@remarks
+			Render systems upload only the constants which changed since the
+			parameters were last bound to a program, where the API allows it;
+			this count shows how much that saves.
+		*/
+		virtual unsigned int _getConstantUploadCount(void) const;
+		/** Reports the number of render state changes passed on to the device
+			since the last _beginGeometryCount call.
+		@see RenderSystem::setStateCacheEnabled
+		*/
+		virtual unsigned int _getStateChangeCount(void) const;
+		/** Reports the number of redundant render state changes filtered out
+			by the state cache since the last _beginGeometryCount call.
+		@see RenderSystem::setStateCacheEnabled
+		*/
+		virtual unsigned int _getFilteredStateChangeCount(void) const;
+
+		/** Sets whether redundant render state changes are filtered out.
+		@remarks
+			The render system remembers the last value it set on the device for
+			each piece of fixed render state (culling, blending, depth, alpha 
+			rejection, colour writes, polygon and shading modes, lighting, fog,
+			stencil checking, point sprites and the texture bound to each unit).
+			While the state cache is enabled, calls which would set the value 
+			the device already holds return without touching the device. It is
+			enabled by default; disabling it is only useful to compare the 
+			cost of redundant state changes or to track down state problems.
+		@note
+			Render systems which do not use the cache pass every call on to 
+			the device, and count none of them.
+		*/
+		virtual void setStateCacheEnabled(bool enabled);
+		/** Gets whether redundant render state changes are filtered out. */
+		virtual bool getStateCacheEnabled(void) const { return mStateCacheEnabled; }
+		/** Forgets all cached render state, so that the next call setting each
+			piece of state reaches the device.
+		@remarks
+			Render systems do this themselves whenever the device state is lost, 
+			for example on a context switch. Call it if the device state may have 
+			been changed behind the render system's back, e.g. by rendering code 
+			which talks to the underlying API directly.
+		*/
+		virtual void _invalidateStateCache(void);
 
 		/** Generates a packed data version of the passed in ColourValue suitable for
 		use as with this RenderSystem.
@@ -1216,6 +1261,9 @@ namespace Ogre
 		size_t mBatchCount;
 		size_t mFaceCount;
 		size_t mVertexCount;
+		size_t mConstantUploadCount;
+		size_t mStateChangeCount;
+		size_t mFilteredStateChangeCount;
 
 		/// Saved manual colour blends
 		ColourValue mManualBlendColours[OGRE_MAX_TEXTURE_LAYERS][2];
@@ -1268,6 +1316,115 @@ namespace Ogre
 		/// Internal method used to set the underlying clip planes when needed
 		virtual void setClipPlanesImpl(const PlaneList& clipPlanes) = 0;
 
+		/// A piece of render state, and whether the device is known to hold it
+		template <typename T> struct CachedState
+		{
+			T value;
+			bool valid;
+			CachedState() : valid(false) {}
+		};
+		/// Blend factors as set by _setSceneBlending or _setSeparateSceneBlending
+		struct SceneBlendState
+		{
+			SceneBlendFactor source, dest, sourceAlpha, destAlpha;
+			bool operator==(const SceneBlendState& rhs) const
+			{
+				return source == rhs.source && dest == rhs.dest &&
+					sourceAlpha == rhs.sourceAlpha && destAlpha == rhs.destAlpha;
+			}
+		};
+		/// Settings passed to _setAlphaRejectSettings
+		struct AlphaRejectState
+		{
+			CompareFunction func;
+			unsigned char value;
+			bool operator==(const AlphaRejectState& rhs) const
+			{ return func == rhs.func && value == rhs.value; }
+		};
+		/// Settings passed to _setDepthBias
+		struct DepthBiasState
+		{
+			float constantBias, slopeScaleBias;
+			bool operator==(const DepthBiasState& rhs) const
+			{ return constantBias == rhs.constantBias && slopeScaleBias == rhs.slopeScaleBias; }
+		};
+		/// Settings passed to _setFog
+		struct FogState
+		{
+			FogMode mode;
+			ColourValue colour;
+			Real density, start, end;
+			bool operator==(const FogState& rhs) const
+			{
+				return mode == rhs.mode && colour == rhs.colour && density == rhs.density &&
+					start == rhs.start && end == rhs.end;
+			}
+		};
+		/** The texture bound to a unit. 
+		@remarks
+			The texture's state count is included so that a texture which was 
+			reloaded since it was bound, and may now be a different device 
+			object, is bound again.
+		*/
+		struct TextureState
+		{
+			bool enabled;
+			const Texture* texture;
+			size_t stateCount;
+			bool operator==(const TextureState& rhs) const
+			{
+				return enabled == rhs.enabled && texture == rhs.texture &&
+					stateCount == rhs.stateCount;
+			}
+		};
+		/// The last value of each piece of render state set on the device
+		struct RenderStateCache
+		{
+			CachedState<CullingMode> cullingMode;
+			CachedState<SceneBlendState> sceneBlending;
+			CachedState<AlphaRejectState> alphaReject;
+			CachedState<bool> depthCheck;
+			CachedState<bool> depthWrite;
+			CachedState<CompareFunction> depthFunction;
+			CachedState<DepthBiasState> depthBias;
+			/// Red, green, blue and alpha write enables in bits 0 to 3
+			CachedState<uint8> colourWrite;
+			CachedState<PolygonMode> polygonMode;
+			CachedState<ShadeOptions> shading;
+			CachedState<bool> lighting;
+			CachedState<FogState> fog;
+			CachedState<bool> stencilCheck;
+			CachedState<bool> pointSprites;
+			CachedState<TextureState> textures[OGRE_MAX_TEXTURE_LAYERS];
+		};
+		RenderStateCache mStateCache;
+		bool mStateCacheEnabled;
+
+		/** Checks a state setting call against the state cache.
+		@remarks
+			Render systems call this at the start of each state setting method
+			they want filtered, and return straight away if it returns false.
+		@param state The cached piece of state
+		@param value The value the call wants to set
+		@returns True if the device must be changed, in which case the cache 
+			now holds the new value
+		*/
+		template <typename T>
+		bool filterStateChange(CachedState<T>& state, const T& value)
+		{
+			if (mStateCacheEnabled && state.valid && state.value == value)
+			{
+				++mFilteredStateChangeCount;
+				return false;
+			}
+			state.value = value;
+			state.valid = true;
+			++mStateChangeCount;
+			return true;
+		}
+		/// Forgets the textures cached for all units
+		void invalidateTextureStateCache(void);
+
 		/** Initialize the render system from the capabilities*/
 		virtual void initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps, RenderTarget* primary) = 0;
 
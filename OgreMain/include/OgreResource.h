@@ -117,6 +117,8 @@ namespace Ogre {
         volatile LoadingState mLoadingState;
 		/// Is this resource going to be background loaded? Only applicable for multithreaded
 		volatile bool mIsBackgroundLoaded;
+		/// Has prepare() been done without the resource being loaded yet?
+		volatile bool mIsPrepared;
 		/// Mutex to cover the status of loading
 		OGRE_MUTEX(mLoadingStatusMutex)
 		/// The size of the resource in bytes
@@ -138,7 +140,7 @@ namespace Ogre {
 		*/
 		Resource() 
 			: mCreator(0), mHandle(0), mLoadingState(LOADSTATE_UNLOADED), 
-			mIsBackgroundLoaded(false),	mSize(0), mIsManual(0), mLoader(0)
+			mIsBackgroundLoaded(false), mIsPrepared(false), mSize(0), mIsManual(0), mLoader(0)
 		{ 
 		}
 
@@ -167,8 +169,28 @@ namespace Ogre {
 		*/
 		virtual void postUnloadImpl(void) {}
 
+		/** Internal implementation of the 'prepare' action, only called if this
+			resource is not being loaded from a ManualResourceLoader.
+		@remarks
+			This should read and decode the source data of the resource into
+			system memory, ready for loadImpl to use, without touching the
+			render system. It may be called from any thread. The default
+			does nothing, in which case loadImpl does all the work.
+		@note Mutex will have already been acquired by the preparing thread.
+		*/
+		virtual void prepareImpl(void) {}
+		/** Internal implementation of discarding the data kept by prepareImpl.
+		@remarks
+			Called once loadImpl has consumed the prepared data, or when the
+			resource is unloaded before it was ever loaded.
+		@note Mutex will have already been acquired by the calling thread.
+		*/
+		virtual void unprepareImpl(void) {}
 		/** Internal implementation of the meat of the 'load' action, only called if this 
 			resource is not being loaded from a ManualResourceLoader. 
+		@remarks
+			If isPrepared() is true the data read by prepareImpl is available
+			and should be used rather than reading the source again.
 		*/
 		virtual void loadImpl(void) = 0;
 		/** Internal implementation of the 'unload' action; called regardless of
@@ -218,6 +240,24 @@ namespace Ogre {
         */
         virtual void load(bool backgroundThread = false);
 
+		/** Prepares the resource for loading, if it is not already loaded or
+			prepared.
+		@remarks
+			Preparing performs the part of loading which does not need the
+			render system, such as reading the source file and decoding it
+			into system memory. It is safe to call from a background thread
+			while the render system is in use by the main thread; a later
+			call to load() then only has to create the render system objects
+			from the prepared data. Resources whose subclass does not support
+			preparing, and manually loaded resources, do all their work in
+			load().
+		*/
+		virtual void prepare(void);
+
+		/** Returns whether the resource has been prepared but not yet loaded.
+		*/
+		virtual bool isPrepared(void) const { return mIsPrepared; }
+
 		/** Reloads the resource, if it is already loaded.
 		@remarks
 			Calls unload() and then load() again, if the resource is already
@@ -241,6 +281,9 @@ namespace Ogre {
 
 		/** Unloads the resource; this is not permanent, the resource can be
 			reloaded later if required.
+		@remarks
+			If the resource was prepared but never loaded, the prepared data
+			is discarded.
         */
 		virtual void unload(void);
 
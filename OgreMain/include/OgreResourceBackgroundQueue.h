@@ -45,13 +45,28 @@ namespace Ogre {
 	/// Identifier of a background process
 	typedef unsigned long BackgroundProcessTicket;
 	
-	/** This class is used to perform Resource operations in a
-		background thread. 
+	/** This class is used to perform Resource operations in 
+		background threads. 
 	@remarks
-		If threading is enabled, Ogre will create a single background thread
-		which can be used to load / unload resources in parallel. Only one
-		resource will be processed at once in this background thread, but it
-		will be in parallel with the main thread. 
+		If threading is enabled, Ogre will create a pool of background threads
+		(one by default, see setNumWorkerThreads) which are used to load / 
+		unload resources in parallel with the main thread. 
+	@par
+		Loading a single resource is split into stages. A background thread
+		performs Resource::prepare, which reads the source file through the
+		resource's Archive and decodes it into system memory (e.g. image 
+		decoding for textures); several resources can be prepared at once,
+		one per background thread. Creating the render system objects from
+		the prepared data, Resource::load, is then done by the main thread
+		from _fireBackgroundLoadingComplete, so the render system is never
+		used by more than one thread for these requests. Group operations
+		and unloads are performed entirely in a background thread, as before,
+		and run on their own: they wait for earlier requests to finish and 
+		no other request starts until they are done.
+	@par
+		Requests are processed in order of priority, highest first, and in
+		the order they were queued within a priority. A request can be 
+		cancelled with cancel() until its main thread stage has run.
 	@par
 		The general approach here is that on requesting a background resource
 		process, your request is placed on a queue ready for the background
@@ -62,15 +77,15 @@ namespace Ogre {
 		performed, and once finished the ticket will be marked as complete. 
 		You can check the status of tickets by calling isProcessComplete() 
 		from your queueing thread. It is also possible to get immediate 
-		callbacks on completion, but these callbacks happen in the background 
-		loading thread (not your calling thread), so should only be used if you
-		really understand multithreading. 
+		callbacks on completion, but these callbacks happen in the thread
+		which completed the request (not necessarily your calling thread), so
+		should only be used if you really understand multithreading. 
 	@par
 		By default, when threading is enabled this class will start its own 
 		separate thread to perform the actual loading. However, if you would 
-		prefer to use your own existing thread to perform the background load,
+		prefer to use your own existing threads to perform the background load,
 		then be sure to call setStartBackgroundThread(false) before initialise() is
-		called by Root::initialise. Your own thread should call _initThread
+		called by Root::initialise. Your own threads should call _initThread
 		immediately on startup, before any resources are loaded at all, and
 		_doNextQueuedBackgroundProcess to process background requests.
 	@note
@@ -106,6 +121,8 @@ namespace Ogre {
 				your callback is executed in the <b>background thread</b>. Therefore if 
 				you use this version, you have to be aware of thread safety issues
 				and what you can and cannot do in your callback implementation.
+				Single resource loads complete in the main thread, so for those
+				this is called from the main thread just before operationCompleted.
 			*/
 			virtual void operationCompletedInThread(BackgroundProcessTicket ticket) {}
 			/// Need virtual destructor in case subclasses use it
@@ -126,14 +143,27 @@ namespace Ogre {
 			RT_LOAD_GROUP,
 			RT_LOAD_RESOURCE,
 			RT_UNLOAD_GROUP,
-			RT_UNLOAD_RESOURCE,
-			RT_SHUTDOWN
+			RT_UNLOAD_RESOURCE
+		};
+		/** Enumerates the stages a request goes through */
+		enum RequestStage
+		{
+			/// Waiting for a background thread
+			RS_QUEUED,
+			/// Being processed by a background thread
+			RS_ACTIVE,
+			/// Prepared, waiting for the main thread to load it
+			RS_UPLOAD
 		};
 		/** Encapsulates a queued request for the background queue */
 		struct Request
 		{
 			BackgroundProcessTicket ticketID;
 			RequestType type;
+			RequestStage stage;
+			ushort priority;
+			/// Set by cancel() once the request has started
+			bool cancelled;
 			String resourceName;
 			ResourceHandle resourceHandle;
 			String resourceType;
@@ -142,12 +172,20 @@ namespace Ogre {
 			ManualResourceLoader* loader;
 			const NameValuePairList* loadParams;
 			Listener* listener;
+			/// The resource being loaded, once it has been prepared
+			ResourcePtr resource;
 		};
 		typedef std::list<Request> RequestQueue;
 		typedef std::map<BackgroundProcessTicket, Request*> RequestTicketMap;
 		
-		/// Queue of requests, used to store and order requests
+		/// Queue of requests waiting for a background thread, in priority order
 		RequestQueue mRequestQueue;
+		/// Requests being processed by background threads
+		RequestQueue mActiveRequests;
+		/// Prepared resource loads waiting for the main thread, in completion order
+		RequestQueue mUploadQueue;
+		/// Is a request which must run on its own being processed?
+		bool mExclusiveActive;
 		
 		/// Request lookup by ticket
 		RequestTicketMap mRequestTicketMap;
@@ -178,28 +216,65 @@ namespace Ogre {
 		/// Mutex to protect the background event queue]
 		OGRE_MUTEX(mNotificationQueueMutex)
 
-		/// Whether this class should start it's own thread or not
+		/// Whether this class should start it's own threads or not
 		bool mStartThread;
+		/// Number of background threads to start
+		size_t mNumWorkerThreads;
+		/// Maximum number of resources loaded by the main thread per frame
+		size_t mMaxUploadsPerFrame;
 
 #if OGRE_THREAD_SUPPORT
-		/// The single background thread which will process loading requests
-		boost::thread* mThread;
+		typedef std::vector<boost::thread*> ThreadList;
+		/// The background threads which process requests
+		ThreadList mThreads;
 		/// Synchroniser token to wait / notify on queue
 		boost::condition mCondition;
-		/// Thread function
-		static void threadFunc(void);
+		/// Functor used as the entry point of background threads
+		struct WorkerFunc
+		{
+			ResourceBackgroundQueue* queue;
+			WorkerFunc(ResourceBackgroundQueue* q) : queue(q) {}
+			void operator()() { queue->workerThreadMain(); }
+		};
+		/// Main loop of each background thread
+		void workerThreadMain(void);
 		/// Internal method for adding a request; also assigns a ticketID
 		BackgroundProcessTicket addRequest(Request& req);
 		/// Thread shutdown?
 		bool mShuttingDown;
-#else
-		/// Dummy
-		void* mThread;
 #endif
 
 		/// Private mutex, not allowed to lock from outside
 		OGRE_AUTO_MUTEX
 
+		/// Does a request of the given type have to run on its own?
+		static bool isExclusive(RequestType type) { return type != RT_LOAD_RESOURCE; }
+		/** Can the request at the front of the queue be started now?
+		@note Must be called with the auto mutex locked.
+		*/
+		bool canStartNextRequest(void) const;
+		/** Moves the request at the front of the queue to the active list.
+		@note Must be called with the auto mutex locked.
+		*/
+		Request* startNextRequest(void);
+		/** Performs the background thread stage of a started request.
+		@note Must be called with the auto mutex unlocked.
+		*/
+		void processRequest(Request* req);
+		/** Loads the resources prepared by background threads.
+		@note Called from the main thread by _fireBackgroundLoadingComplete.
+		*/
+		void processUploads(void);
+		/** Notifies the listener of an uploaded request, unless it was 
+			cancelled, and removes it from the upload queue.
+		@note Called from the main thread, with the auto mutex unlocked.
+		*/
+		void finishUpload(Request* req);
+		/** Calls the listener of a completed request, if it has one.
+		@note Must be called with the auto mutex unlocked.
+		*/
+		void notifyRequestComplete(const Request& req);
+
 		/** Queue the firing of the 'background loading complete' event to
 			a Resource::Listener event.
 		@remarks
@@ -244,6 +319,30 @@ namespace Ogre {
 			appropriate hooks.
 		*/
 		bool getStartBackgroundThread(void) { return mStartThread; }
+
+		/** Sets the number of background threads to start.
+		@remarks
+			Several threads let the file reading and decoding of different
+			resources overlap, which helps when loading is bound by I/O
+			latency or by decoding. The default is 1.
+		@note
+			You <b>must</b> call this method prior to initialisation. Has no
+			effect unless OGRE_THREAD_SUPPORT is 1 and the background threads
+			are started by this class.
+		*/
+		void setNumWorkerThreads(size_t numThreads);
+		/** Gets the number of background threads to start. */
+		size_t getNumWorkerThreads(void) const { return mNumWorkerThreads; }
+
+		/** Sets the maximum number of prepared resources which the main thread
+			loads in each frame.
+		@remarks
+			Limiting this spreads the cost of creating render system objects 
+			over several frames. 0, the default, means there is no limit.
+		*/
+		void setMaxUploadsPerFrame(size_t maxUploads) { mMaxUploadsPerFrame = maxUploads; }
+		/** Gets the maximum number of prepared resources loaded per frame. */
+		size_t getMaxUploadsPerFrame(void) const { return mMaxUploadsPerFrame; }
 		/** Initialise the background queue system. 
 		@note Called automatically by Root::initialise.
 		*/
@@ -259,32 +358,35 @@ namespace Ogre {
 		@param name The name of the resource group to initialise
 		@param listener Optional callback interface, take note of warnings in 
 			the header and only use if you understand them.
+		@param priority Requests with a higher priority are processed first
 		@returns Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket initialiseResourceGroup(
-			const String& name, Listener* listener = 0);
+			const String& name, Listener* listener = 0, ushort priority = 0);
 
 		/** Initialise all resource groups which are yet to be initialised in 
 			the background.
 		@see ResourceGroupManager::intialiseResourceGroup
 		@param listener Optional callback interface, take note of warnings in 
 			the header and only use if you understand them.
+		@param priority Requests with a higher priority are processed first
 		@returns Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket initialiseAllResourceGroups( 
-			Listener* listener = 0);
+			Listener* listener = 0, ushort priority = 0);
 		/** Loads a resource group in the background.
 		@see ResourceGroupManager::loadResourceGroup
 		@param name The name of the resource group to load
 		@param listener Optional callback interface, take note of warnings in 
 			the header and only use if you understand them.
+		@param priority Requests with a higher priority are processed first
 		@returns Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket loadResourceGroup(const String& name, 
-			Listener* listener = 0);
+			Listener* listener = 0, ushort priority = 0);
 
 
 		/** Unload a single resource in the background. 
@@ -292,29 +394,32 @@ namespace Ogre {
 		@param resType The type of the resource 
 			(from ResourceManager::getResourceType())
 		@param name The name of the Resource
+		@param priority Requests with a higher priority are processed first
 		*/
 		virtual BackgroundProcessTicket unload(
 			const String& resType, const String& name, 
-			Listener* listener = 0);
+			Listener* listener = 0, ushort priority = 0);
 
 		/** Unload a single resource in the background. 
 		@see ResourceManager::unload
 		@param resType The type of the resource 
 			(from ResourceManager::getResourceType())
 		@param handle Handle to the resource 
+		@param priority Requests with a higher priority are processed first
 		*/
 		virtual BackgroundProcessTicket unload(
 			const String& resType, ResourceHandle handle, 
-			Listener* listener = 0);
+			Listener* listener = 0, ushort priority = 0);
 
 		/** Unloads a resource group in the background.
 		@see ResourceGroupManager::unloadResourceGroup
 		@param name The name of the resource group to load
+		@param priority Requests with a higher priority are processed first
 		@returns Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket unloadResourceGroup(const String& name, 
-			Listener* listener = 0);
+			Listener* listener = 0, ushort priority = 0);
 
 
 		/** Load a single resource in the background. 
@@ -331,13 +436,17 @@ namespace Ogre {
         @param loadParams Optional pointer to a list of name/value pairs 
             containing loading parameters for this type of resource. Remember 
 			that this must have a lifespan longer than the return of this call!
+		@param priority Requests with a higher priority are processed first
+		@remarks
+			The resource is prepared in a background thread and then loaded
+			by the main thread, when it next calls _fireBackgroundLoadingComplete.
 		*/
 		virtual BackgroundProcessTicket load(
 			const String& resType, const String& name, 
             const String& group, bool isManual = false, 
 			ManualResourceLoader* loader = 0, 
 			const NameValuePairList* loadParams = 0, 
-			Listener* listener = 0);
+			Listener* listener = 0, ushort priority = 0);
 		/** Returns whether a previously queued process has completed or not. 
 		@remarks
 			This method of checking that a background process has completed is
@@ -350,22 +459,45 @@ namespace Ogre {
 		@note Tickets are not stored once complete so do not accumulate over 
 			time.
 		This is why a non-existent ticket will return 'true'.
+		@note
+			The ticket of a resource load (see load()) only completes once the
+			main thread has finished loading the prepared resource, which it 
+			does when Root calls _fireBackgroundLoadingComplete each frame. An 
+			application which polls from the main thread without rendering
+			frames must call _fireBackgroundLoadingComplete itself, or the 
+			ticket never completes.
 		*/
 		virtual bool isProcessComplete(BackgroundProcessTicket ticket);
 
+		/** Cancels a previously queued process.
+		@remarks
+			A request which has not been started yet is removed from the queue.
+			A single resource load which is being prepared, or waiting for the
+			main thread, is abandoned and any data prepared for it discarded.
+			Group operations and unloads cannot be cancelled once started.
+			The listener of a cancelled request is not called, and the
+			ticket is treated as complete from then on.
+		@param ticket The ticket which was returned when the process was queued
+		@returns true if the request was cancelled, false if it had already
+			completed or could no longer be cancelled
+		*/
+		virtual bool cancel(BackgroundProcessTicket ticket);
+
 		/** Process a single queued background operation. 
 		@remarks
 			If you are using your own thread to perform background loading, calling
 			this method from that thread triggers the processing of a single
 			background loading request from the queue. This method will not 
-			return until the request has been fully processed. It also returns
-			whether it did in fact process anything - if it returned false, there
-			was nothing more in the queue.
+			return until the background part of the request has been processed;
+			single resource loads are finished by the main thread afterwards.
+			It also returns whether it did in fact process anything - if it 
+			returned false, there was nothing more in the queue that could be
+			started yet.
 		@note
-			<b>Do not</b> call this method unless you are using your own thread
+			<b>Do not</b> call this method unless you are using your own threads
 			to perform the background loading and called setStartBackgroundThread(false).
-			You must only have one background loading thread.
-		@returns true if a request was processed, false if the queue was empty.
+		@returns true if a request was processed, false if the queue was empty
+			or the next request has to wait for others to finish.
 		*/
 		bool _doNextQueuedBackgroundProcess();
 
@@ -405,6 +537,8 @@ namespace Ogre {
 		@remarks
 			You should call this from the thread that runs the main frame loop 
 			to avoid having to make the receivers of this event thread-safe.
+			This also loads resources which have been prepared by the 
+			background threads, up to getMaxUploadsPerFrame of them.
 			If you use Ogre's built in frame loop you don't need to call this
 			yourself.
 		*/
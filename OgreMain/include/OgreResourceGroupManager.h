@@ -81,6 +81,12 @@ namespace Ogre {
 		*/
 		virtual void resourceGroupScriptingStarted(const String& groupName, size_t scriptCount) = 0;
 		/** This event is fired when a script is about to be parsed.
+		@remarks
+			Scripts are opened in batches of up to 64 so that they can be 
+			prepared together (see ScriptLoader::prepareScripts), so by the
+			time this is fired ResourceLoadingListener::resourceStreamOpened
+			may already have been fired for this and the following scripts
+			of the batch.
 		@param scriptName Name of the to be parsed
 		*/
 		virtual void scriptParseStarted(const String& scriptName) = 0;
@@ -135,6 +141,9 @@ namespace Ogre {
 		@remarks
 			You may alter the stream if you wish or alter the incoming pointer to point at
 			another stream if you wish.
+		@par
+			For scripts this is fired for a whole batch of scripts before the
+			first of them is parsed, see ResourceGroupListener::scriptParseStarted.
 		*/
 		virtual void resourceStreamOpened(const String &name, const String &group, Resource *resource, DataStreamPtr& dataStream) = 0;
 
@@ -684,6 +693,15 @@ namespace Ogre {
         @param filename Fully qualified name of the file to test for
         */
         bool resourceExists(ResourceGroup* group, const String& filename);
+
+        /** Retrieve the modification time of a given file in a group.
+        @param group The name of the resource group
+        @param filename Fully qualified name of the file
+        @returns The time reported by the archive holding the file, or 0 if
+            the file was not found or its archive cannot tell
+        @see Archive::getModifiedTime
+        */
+        time_t resourceModifiedTime(const String& group, const String& filename);
 		/** Find the group in which a resource exists.
 		@param filename Fully qualified name of the file the resource should be
 			found as
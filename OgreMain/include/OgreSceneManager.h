@@ -51,6 +51,7 @@ Torus Knot Software Ltd.
 #include "OgreShadowTextureManager.h"
 #include "OgreCamera.h"
 #include "OgreInstancedGeometry.h"
+#include "OgreLightSpatialIndex.h"
 
 namespace Ogre {
 
@@ -459,7 +460,16 @@ namespace Ogre {
         LightList mLightsAffectingFrustum;
         LightInfoList mCachedLightInfos;
 		LightInfoList mTestLightInfos; // potentially new list
+		/// Scratch space for culling the ranges of non-directional lights at once
+		std::vector<Sphere> mTestLightSpheres;
+		std::vector<uint32> mTestLightVisibility;
         ulong mLightsDirtyCounter;
+		/// Spatial index over mLightsAffectingFrustum used by _populateLightList
+		LightSpatialIndex mLightSpatialIndex;
+		/// Value of mLightsDirtyCounter when mLightSpatialIndex was last built
+		ulong mLightSpatialIndexCounter;
+		/// Maximum number of lights in a populated light list, 0 for no limit
+		size_t mMaxLightsPerObject;
 
 		typedef std::map<String, MovableObject*> MovableObjectMap;
 		/// Simple structure to hold MovableObject map and a mutex to go with it.
@@ -750,6 +760,38 @@ namespace Ogre {
 		/// Suppress shadows?
 		bool mSuppressShadows;
 
+		/// Split the scene graph update across the WorkerThreadPool?
+		bool mParallelSceneGraphUpdate;
+		/// Maximum depth to which the scene graph is split for a parallel update
+		size_t mParallelSceneGraphUpdateMaxSplitDepth;
+		/// Are nodes being updated by several threads right now?
+		bool mUpdatingSceneGraphInParallel;
+		/// Transform store used to update the scene graph, if enabled
+		NodeTransformStore* mNodeTransformStore;
+		/// Split the search for visible objects across the WorkerThreadPool?
+		bool mParallelFindVisibleObjects;
+		/// Collect software skinning while finding visible objects, and split it across the WorkerThreadPool?
+		bool mParallelSoftwareSkinning;
+		/// Batch of software blends collected while finding visible objects
+		SoftwareSkinningBatch* mSoftwareSkinningBatch;
+		/// Is mSoftwareSkinningBatch currently collecting blends?
+		bool mSoftwareSkinningBatchOpen;
+		/// Hierarchy accelerating scene queries, if enabled
+		SceneQueryBVH* mSceneQueryBVH;
+
+		/** Internal method which finds the visible objects from the root, culling
+			independent subtrees of the scene graph in parallel.
+		@remarks
+			Parameters as for _findVisibleObjects.
+		*/
+		virtual void findVisibleObjectsParallel(Camera* cam, 
+			VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
+
+		/** Internal method which updates the scene graph from the root, splitting 
+			the work into independent subtrees which are updated in parallel.
+		*/
+		virtual void updateSceneGraphParallel(void);
+
 
         GpuProgramParametersSharedPtr mInfiniteExtrusionParams;
         GpuProgramParametersSharedPtr mFiniteExtrusionParams;
@@ -1072,6 +1114,10 @@ namespace Ogre {
             The number of items in the list max exceed the maximum number of lights supported
             by the renderer, but the extraneous ones will never be used. In fact the limit will
             be imposed by Pass::getMaxSimultaneousLights.
+        @par
+            Rather than testing every light affecting the frustum, this looks 
+            up the candidates in a spatial index over those lights, which is 
+            built again whenever the lights dirty counter changes.
         @param position The position at which to evaluate the list of lights
         @param radius The bounding radius to test
         @param destList List to be populated with ordered set of lights; will be cleared by 
@@ -1531,6 +1577,7 @@ namespace Ogre {
                 updates all nodes from the root. This ensures the scene is up to date but requires all the nodes
                 to be updated even if they are not visible. Subclasses could trim this such that only potentially visible
                 nodes are updated.
+            @see setParallelSceneGraphUpdate
         */
         virtual void _updateSceneGraph(Camera* cam);
 
@@ -2883,6 +2930,186 @@ namespace Ogre {
  		*/
 		virtual bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+		/** Sets whether the scene graph update should be split across the 
+			WorkerThreadPool.
+		@remarks
+			When enabled, _updateSceneGraph updates the top levels of the scene
+			graph serially until it has found enough independent subtrees to 
+			keep the worker threads busy, updates those subtrees in parallel, 
+			then finishes the bounds of the top levels once they are all done.
+			The derived transforms and world bounds are identical to those of
+			the serial update. This only pays off if the WorkerThreadPool has 
+			worker threads and the scene graph is reasonably large.
+		@note
+			Any Node::Listener or MovableObject::Listener attached to nodes in
+			the scene will be called from worker threads while this is enabled,
+			so they must be thread safe. Scene managers whose nodes touch 
+			shared structures during their update must make that thread safe
+			too; nodes which are updated serially at the top of the tree are
+			updated through _updateFromParent and _updateBounds rather than
+			through their own _update override. Defaults to false.
+		*/
+		virtual void setParallelSceneGraphUpdate(bool enabled) 
+		{ mParallelSceneGraphUpdate = enabled; }
+		/** Gets whether the scene graph update is split across the WorkerThreadPool. */
+		virtual bool getParallelSceneGraphUpdate(void) const 
+		{ return mParallelSceneGraphUpdate; }
+
+		/** Sets the maximum depth to which the scene graph is split up when 
+			updating it in parallel.
+		@remarks
+			The parallel update descends through the scene graph breadth first 
+			until it has several independent subtrees per thread, or until it 
+			reaches this depth, whichever comes first. The nodes above the split
+			are updated serially. Defaults to 8.
+		*/
+		virtual void setParallelSceneGraphUpdateMaxSplitDepth(size_t depth)
+		{ mParallelSceneGraphUpdateMaxSplitDepth = depth; }
+		/** Gets the maximum depth to which the scene graph is split up when 
+			updating it in parallel. */
+		virtual size_t getParallelSceneGraphUpdateMaxSplitDepth(void) const
+		{ return mParallelSceneGraphUpdateMaxSplitDepth; }
+		/** Are nodes being updated by several threads at the moment?
+		@remarks
+			True only while the worker threads of a parallel scene graph update
+			run, so shared structures touched from node updates need only be 
+			locked while this is set.
+		*/
+		bool _isUpdatingSceneGraphInParallel(void) const
+		{ return mUpdatingSceneGraphInParallel; }
+
+		/** Sets whether the search for visible objects is split across the 
+			WorkerThreadPool.
+		@remarks
+			When enabled, _findVisibleObjects tests the top levels of the scene 
+			graph against the camera serially until it has found enough 
+			independent subtrees to keep the worker threads busy, then culls 
+			those subtrees in parallel, each thread recording the visible nodes
+			it finds in its own list. The calling thread then adds the objects 
+			attached to the visible nodes to the render queue, in exactly the 
+			order the serial search would have, so the contents of the render 
+			queue are identical. This pays off for large scene graphs where a 
+			good proportion of the nodes are culled.
+		@note
+			Only the frustum tests are done in the worker threads, since 
+			MovableObject::_notifyCurrentCamera and _updateRenderQueue are 
+			generally not thread safe. Nodes are visited through 
+			_queueAttachedObjects and _queueDebugRenderables rather than 
+			through their own _findVisibleObjects override. Defaults to false.
+		@par
+			Scene managers which override _findVisibleObjects with their own
+			search, such as the octree, BSP and portal connected zone scene 
+			managers, ignore this option.
+		*/
+		virtual void setParallelFindVisibleObjects(bool enabled)
+		{ mParallelFindVisibleObjects = enabled; }
+		/** Gets whether the search for visible objects is split across the 
+			WorkerThreadPool. */
+		virtual bool getParallelFindVisibleObjects(void) const
+		{ return mParallelFindVisibleObjects; }
+
+		/** Sets whether software skinning of visible entities is split across 
+			the WorkerThreadPool.
+		@remarks
+			Entities which are skinned in software (because hardware skinning
+			is not available, stencil shadows are in use, or 
+			Entity::addSoftwareAnimationRequest was called) normally blend 
+			their vertices one after another as they are found to be visible.
+			When this is enabled, the blends are instead collected into a 
+			SoftwareSkinningBatch while _findVisibleObjects runs and are then 
+			performed together, divided up between the worker threads, before 
+			anything is rendered. Hardware buffers are still locked and unlocked
+			(and so uploaded) by the rendering thread. This pays off for scenes 
+			with many software skinned entities, or a few with large meshes; it 
+			has no effect unless the WorkerThreadPool has worker threads.
+		@note
+			Code which reads the blended vertex data of an entity from a 
+			listener called during the search for visible objects (e.g. 
+			MovableObject::Listener::objectRendering) will see the previous 
+			results while this is enabled. Defaults to false.
+		*/
+		virtual void setParallelSoftwareSkinning(bool enabled)
+		{ mParallelSoftwareSkinning = enabled; }
+		/** Gets whether software skinning of visible entities is split across 
+			the WorkerThreadPool. */
+		virtual bool getParallelSoftwareSkinning(void) const
+		{ return mParallelSoftwareSkinning; }
+		/** Internal method to get the batch that software skinning should be 
+			added to, or null if it should be performed immediately. */
+		SoftwareSkinningBatch* _getSoftwareSkinningBatch(void) const
+		{ return mSoftwareSkinningBatchOpen ? mSoftwareSkinningBatch : 0; }
+
+		/** Sets whether the scene graph is updated through a NodeTransformStore.
+		@remarks
+			When enabled, the transforms of all scene nodes attached to the root
+			are also kept in a NodeTransformStore, which lays them out in 
+			contiguous arrays in depth first order, and _updateSceneGraph 
+			updates them with linear sweeps over the subtrees of the nodes 
+			which changed instead of recursing through the nodes. The results 
+			and the events raised are the same as for the normal update. When 
+			nodes are attached or detached, only their subtrees are laid out 
+			again on the next update.
+		@note
+			Takes precedence over setParallelSceneGraphUpdate. Scene node 
+			classes which do extra work in their _update override must do it
+			in _transformStoreUpdateComplete too. Defaults to false.
+		*/
+		virtual void setUseNodeTransformStore(bool enabled);
+		/** Gets whether the scene graph is updated through a NodeTransformStore. */
+		virtual bool getUseNodeTransformStore(void) const 
+		{ return mNodeTransformStore != 0; }
+
+		/** Sets whether scene queries are accelerated by a SceneQueryBVH.
+		@remarks
+			When enabled, the movable objects created by this manager are kept
+			in a bounding volume hierarchy which is brought up to date at the 
+			end of every _updateSceneGraph, only reinserting objects which have
+			moved some way. The ray, sphere and axis aligned box queries of 
+			this class (and of scene managers which support it) then only test
+			the objects near the query rather than every object in the scene, 
+			which pays off for scenes with many objects and applications 
+			issuing many queries per frame. It also lets 
+			RaySceneQuery::executeBatch split its rays across the 
+			WorkerThreadPool.
+		@note
+			Queries see objects where they were at the last scene graph update
+			(or the last call to _updateSceneQueryBVH), like those of scene 
+			managers which partition space; an object which has been moved 
+			since may be missed. Objects added with injectMovableObject must be
+			extracted before they are destroyed. Defaults to false.
+		*/
+		virtual void setUseSceneQueryBVH(bool enabled);
+		/** Gets whether scene queries are accelerated by a SceneQueryBVH. */
+		virtual bool getUseSceneQueryBVH(void) const 
+		{ return mSceneQueryBVH != 0; }
+		/** Gets the hierarchy accelerating scene queries, or null if 
+			setUseSceneQueryBVH is not enabled. */
+		SceneQueryBVH* _getSceneQueryBVH(void) const { return mSceneQueryBVH; }
+		/** Brings the scene query hierarchy up to date with the current bounds
+			of all objects, if it is enabled.
+		@remarks
+			This is done by _updateSceneGraph; call it after updating nodes 
+			yourself if queries must see the new positions straight away.
+		*/
+		virtual void _updateSceneQueryBVH(void);
+
+		/** Sets the maximum number of lights _populateLightList returns for each 
+			object.
+		@remarks
+			Only the closest lights are kept, which are picked with a partial 
+			sort rather than sorting all the lights in range. This is useful in 
+			scenes with many overlapping lights when no pass needs more than a 
+			known number of them, but note that passes which iterate once per 
+			light will also be limited to this many. When texture shadows are in 
+			use the lights casting them are always kept. Defaults to 0, meaning 
+			no limit.
+		*/
+		virtual void setMaxLightsPerObject(size_t maxLights) 
+		{ mMaxLightsPerObject = maxLights; _notifyLightsDirty(); }
+		/** Gets the maximum number of lights _populateLightList returns for each 
+			object, 0 meaning no limit. */
+		virtual size_t getMaxLightsPerObject(void) const { return mMaxLightsPerObject; }
+
 		/** Set whether to automatically normalise normals on objects whenever they
 			are scaled.
 		@remarks
@@ -3023,11 +3250,30 @@ namespace Ogre {
 	class _OgreExport DefaultRaySceneQuery : public RaySceneQuery
     {
     public:
+        /** Minimum number of rays in a batch to split it across the 
+            WorkerThreadPool; also the minimum number of rays given to each 
+            task. Smaller batches are executed in the calling thread.
+        */
+        static const size_t PARALLEL_RAY_BATCH_MIN_RAYS = 64;
+
         DefaultRaySceneQuery(SceneManager* creator);
         ~DefaultRaySceneQuery();
 
         /** See RayScenQuery. */
         void execute(RaySceneQueryListener* listener);
+        /** See RaySceneQuery.
+        @remarks
+            When the creator's SceneQueryBVH is enabled and no world fragments
+            are requested, the rays are traced through the hierarchy, split 
+            across the WorkerThreadPool if there are enough of them.
+        @note
+            This does not call execute(), so subclasses which override 
+            execute() must override this too, either with their own batched 
+            version or by calling RaySceneQuery::executeBatch, which executes
+            the query for each ray in turn. The terrain, BSP and PCZ ray 
+            queries do the latter.
+        */
+        void executeBatch(const RayList& rays, RaySceneQueryResultList& results);
     };
     /** Default implementation of SphereSceneQuery. */
 	class _OgreExport DefaultSphereSceneQuery : public SphereSceneQuery
@@ -72,6 +72,9 @@ namespace Ogre {
 
         /** @copydoc Node::updateFromParentImpl. */
         void updateFromParentImpl(void) const;
+        /** @copydoc Node::updateFromTransformStoreImpl. */
+        void updateFromTransformStoreImpl(const Quaternion& derivedOrientation,
+			const Vector3& derivedPosition, const Vector3& derivedScale) const;
 
         /** See Node. */
         Node* createChildImpl(void);
@@ -177,6 +180,9 @@ namespace Ogre {
         */
         virtual void _update(bool updateChildren, bool parentHasChanged);
 
+        /** @copydoc Node::_transformStoreUpdateComplete */
+        virtual void _transformStoreUpdateComplete(bool moved);
+
 		/** Tells the SceneNode to update the world bound info it stores.
 		*/
 		virtual void _updateBounds(void);
@@ -203,6 +209,23 @@ namespace Ogre {
 			VisibleObjectsBoundsInfo* visibleBounds, 
             bool includeChildren = true, bool displayNodes = false, bool onlyShadowCasters = false);
 
+        /** Internal method which adds the visible objects attached to this node
+            to the passed in queue, without any visibility test of the node itself.
+        @remarks
+            This is the part of _findVisibleObjects done before the children 
+            are visited; parameters are as for _findVisibleObjects.
+        */
+        virtual void _queueAttachedObjects(Camera* cam, RenderQueue* queue, 
+            VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters = false);
+
+        /** Internal method which adds the debug renderables of this node (its
+            axes and bounding box, if enabled) to the passed in queue.
+        @remarks
+            This is the part of _findVisibleObjects done after the children 
+            have been visited; parameters are as for _findVisibleObjects.
+        */
+        virtual void _queueDebugRenderables(RenderQueue* queue, bool displayNodes = false);
+
         /** Gets the axis-aligned bounding box of this node (and hence all subnodes).
         @remarks
             Recommended only if you are extending a SceneManager, because the bounding box returned
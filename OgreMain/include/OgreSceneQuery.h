@@ -357,6 +357,19 @@ namespace Ogre {
         MovableObject* movable;
         /// The world fragment, or NULL if this is not a fragment result
         SceneQuery::WorldFragment* worldFragment;
+        /** True if distance and the fields below come from the triangles of
+            an Entity rather than its bounds, see RaySceneQuery::setTriangleAccurate */
+        bool hitTriangle;
+        /// Index of the SubMesh which was hit
+        ushort subMeshIndex;
+        /// Index of the triangle which was hit within that SubMesh's index data
+        size_t triangleIndex;
+        /// Barycentric coordinates of the hit point relative to the triangle's vertices
+        Vector3 barycentric;
+
+        RaySceneQueryResultEntry()
+            : distance(0), movable(0), worldFragment(0), hitTriangle(false),
+            subMeshIndex(0), triangleIndex(0), barycentric(Vector3::ZERO) {}
         /// Comparison operator for sorting
         bool operator < (const RaySceneQueryResultEntry& rhs) const
         {
@@ -365,6 +378,8 @@ namespace Ogre {
 
     };
     typedef std::vector<RaySceneQueryResultEntry> RaySceneQueryResult;
+    typedef std::vector<RaySceneQueryResult> RaySceneQueryResultList;
+    typedef std::vector<Ray> RayList;
 
     /** Specialises the SceneQuery class for querying along a ray. */
     class _OgreExport RaySceneQuery : public SceneQuery, public RaySceneQueryListener
@@ -373,8 +388,20 @@ namespace Ogre {
         Ray mRay;
         bool mSortByDistance;
         ushort mMaxResults;
+        bool mTriangleAccurate;
         RaySceneQueryResult mResult;
 
+        /// Sorts and truncates results as requested by setSortByDistance
+        void sortResults(RaySceneQueryResult& result) const;
+        /** Replaces the bounds hits of entities with their triangle hits,
+            removing entities the ray does not actually touch, if 
+            setTriangleAccurate is enabled.
+        @note
+            Meshes may build their MeshTriangleBVH here, so this must not be
+            called from several threads at once.
+        */
+        void refineResults(const Ray& ray, RaySceneQueryResult& result) const;
+
     public:
         RaySceneQuery(SceneManager* mgr);
         virtual ~RaySceneQuery();
@@ -406,6 +433,34 @@ namespace Ogre {
         /** Gets the maximum number of results returned from the query (only relevant if 
         results are being sorted) */
         virtual ushort getMaxResults(void) const;
+        /** Sets whether entities are intersected at triangle level.
+        @remarks
+            When enabled, each Entity found by the bounds test is tested 
+            against its triangles with Entity::rayIntersectsTriangles. Entities
+            the ray misses are dropped, and the results for those it hits hold
+            the exact distance, the submesh and triangle index and the 
+            barycentric coordinates of the hit (see RaySceneQueryResultEntry). 
+            Other movables and world fragments are returned as before. This 
+            applies to the collection-returning versions of execute and to
+            executeBatch; results passed to a listener are never refined.
+        @par
+            Each mesh builds a MeshTriangleBVH the first time it is tested 
+            unless MeshManager::setBuildTriangleBVHs is enabled. Software 
+            animated entities are tested against their animated positions.
+        @note
+            Those animated positions live in temporary blend buffers, which
+            an Entity only holds from the time it is rendered until the end
+            of that frame, when Root releases them. Queries executed at any
+            other time, such as from FrameListener::frameStarted or after
+            Root::renderOneFrame has returned, test the binding pose of a 
+            software animated Entity instead. Execute the query from
+            FrameListener::frameRenderingQueued, which runs after rendering
+            but before the buffers are released, if the animated shape 
+            matters.
+        */
+        virtual void setTriangleAccurate(bool accurate);
+        /** Gets whether entities are intersected at triangle level. */
+        virtual bool getTriangleAccurate(void) const;
         /** Executes the query, returning the results back in one list.
         @remarks
             This method executes the scene query as configured, gathers the results
@@ -425,6 +480,22 @@ namespace Ogre {
         */
         virtual void execute(RaySceneQueryListener* listener) = 0;
 
+        /** Executes the query once for each of a list of rays.
+        @remarks
+            The masks, world fragment type and sorting of this query apply to
+            every ray, and the results for each ray are returned in the 
+            corresponding entry of the results list, exactly as execute() 
+            would have returned them. The ray set on this query is left 
+            unchanged but the last results are cleared. The default 
+            implementation simply executes the query for each ray in turn; 
+            subclasses may be able to do better, for instance 
+            DefaultRaySceneQuery splits the rays across the WorkerThreadPool 
+            when SceneManager::setUseSceneQueryBVH is enabled.
+        @param rays The rays to query with
+        @param results List which is resized to hold the results for each ray
+        */
+        virtual void executeBatch(const RayList& rays, RaySceneQueryResultList& results);
+
         /** Gets the results of the last query that was run using this object, provided
             the query was executed using the collection-returning version of execute. 
         */
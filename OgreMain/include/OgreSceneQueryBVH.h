@@ -0,0 +1,182 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SceneQueryBVH_H__
+#define __SceneQueryBVH_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreSceneQuery.h"
+
+namespace Ogre {
+
+	/** Bounding volume hierarchy over the movable objects of a SceneManager,
+		used to accelerate ray, sphere and box scene queries.
+	@remarks
+		The hierarchy is a dynamic AABB tree: every object which is attached 
+		to the scene has a leaf whose box encloses both its world bounding box
+		and its bounding sphere, enlarged on every side by a margin relative 
+		to its size. update() compares the current bounds of every object 
+		with its leaf and only removes and reinserts the leaves of objects 
+		which have moved out of them, so objects moving a little each frame
+		are usually not touched at all. Insertions pick the sibling which 
+		least increases the surface area of the tree, and tree rotations keep
+		it balanced.
+	@par
+		The queries cull with the leaf boxes but test each candidate with 
+		exactly the same test as the default scene queries, so the results 
+		are the same as a complete scan of the scene (other than their order)
+		as long as the hierarchy is up to date. Objects with infinite bounds 
+		are kept out of the tree and tested by every query.
+	@par
+		SceneManager owns one of these if setUseSceneQueryBVH is enabled, 
+		adds and removes objects as they are created and destroyed, and calls 
+		update() at the end of every _updateSceneGraph.
+	@note
+		Objects must be removed before they are destroyed. The queries only 
+		read the hierarchy and the objects and so may run in several threads 
+		at once, but not at the same time as any of the modifying methods.
+	*/
+	class _OgreExport SceneQueryBVH
+	{
+	protected:
+		/// Index used for 'no node'
+		static const int NULL_NODE = -1;
+
+		/// A node of the tree; leaves have no children and refer to an object
+		struct TreeNode
+		{
+			Vector3 minimum;
+			Vector3 maximum;
+			int parent;
+			int child1;
+			int child2;
+			/// Height of the subtree below this node, 0 for leaves
+			int height;
+			MovableObject* object;
+
+			bool isLeaf(void) const { return child1 == NULL_NODE; }
+		};
+		typedef std::vector<TreeNode> TreeNodeList;
+		TreeNodeList mNodes;
+		int mRoot;
+		/// Head of the list of unused entries in mNodes, linked through parent
+		int mFreeList;
+
+		/// An object known to the hierarchy
+		struct Proxy
+		{
+			MovableObject* object;
+			/// Leaf of the object, or NULL_NODE if not in the tree
+			int leaf;
+			/// Does the object have infinite bounds?
+			bool infinite;
+		};
+		typedef std::vector<Proxy> ProxyList;
+		ProxyList mProxies;
+		/// Index of each object's entry in mProxies
+		typedef std::map<MovableObject*, size_t> ProxyIndexMap;
+		ProxyIndexMap mProxyIndices;
+		/// Objects with infinite bounds, which are tested by every query
+		typedef std::set<MovableObject*> MovableObjectSet;
+		MovableObjectSet mInfiniteObjects;
+
+		Real mMargin;
+		size_t mNumReinsertions;
+
+		int allocateNode(void);
+		void freeNode(int index);
+		void insertLeaf(int leaf);
+		void removeLeaf(int leaf);
+		int balance(int index);
+		/// Recomputes the box and height of a node from its children
+		void refitNode(int index);
+		/** Brings the tree up to date with the current bounds of a proxy's object.
+		@returns true if the object's leaf had to be (re)inserted
+		*/
+		bool updateProxy(Proxy& proxy);
+
+	public:
+		/** Maximum height the tree may reach; the queries use a stack of 
+			this depth. Balancing keeps the tree far below this.
+		*/
+		static const int MAX_TREE_HEIGHT = 64;
+
+		SceneQueryBVH();
+		~SceneQueryBVH();
+
+		/** Adds an object to the hierarchy. */
+		void addObject(MovableObject* obj);
+		/** Removes an object from the hierarchy; does nothing if it wasn't in it. */
+		void removeObject(MovableObject* obj);
+		/** Removes all objects from the hierarchy. */
+		void clear(void);
+		/** Brings the leaves of all objects up to date with their current 
+			world bounds, reinserting those which have moved out of them. */
+		void update(void);
+
+		/** Sets the amount by which leaf boxes are enlarged on every side, as
+			a proportion of the largest dimension of the object's bounds.
+		@remarks
+			Larger margins mean fewer reinsertions of moving objects but looser
+			culling. Applies to leaves as they are next (re)inserted. Defaults 
+			to 0.1.
+		*/
+		void setMargin(Real margin) { mMargin = margin; }
+		/** Gets the amount by which leaf boxes are enlarged. */
+		Real getMargin(void) const { return mMargin; }
+
+		/** Gets the number of objects in the hierarchy. */
+		size_t getNumObjects(void) const { return mProxies.size(); }
+		/** Gets the number of leaves (re)inserted by the last update. */
+		size_t getNumReinsertions(void) const { return mNumReinsertions; }
+		/** Gets the height of the tree, 0 if it has at most one leaf. */
+		int getHeight(void) const 
+		{ return mRoot == NULL_NODE ? 0 : mNodes[mRoot].height; }
+
+		/** Reports every object passing the masks whose world bounding box 
+			is hit by the ray, with the distance along the ray, as 
+			DefaultRaySceneQuery does. */
+		void rayQuery(const Ray& ray, uint32 queryMask, uint32 typeMask, 
+			RaySceneQueryListener* listener) const;
+		/** Reports every object passing the masks whose world bounding box 
+			intersects the box, as DefaultAxisAlignedBoxSceneQuery does. */
+		void boxQuery(const AxisAlignedBox& box, uint32 queryMask, uint32 typeMask, 
+			SceneQueryListener* listener) const;
+		/** Reports every object passing the masks which intersects the sphere.
+		@param testBoundingSpheres If true, objects are tested with their 
+			bounding radius around their parent node's position, as 
+			DefaultSphereSceneQuery does; otherwise with their world bounding
+			box.
+		*/
+		void sphereQuery(const Sphere& sphere, uint32 queryMask, uint32 typeMask, 
+			SceneQueryListener* listener, bool testBoundingSpheres) const;
+	};
+
+}
+
+#endif
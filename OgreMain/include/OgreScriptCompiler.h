@@ -100,6 +100,7 @@ namespace Ogre
 		Any context; // A holder for translation context data
 	public:
 		AbstractNode(AbstractNode *ptr);
+		virtual ~AbstractNode(){}
 		/// Returns a new AbstractNode which is a replica of this one.
 		virtual AbstractNode *clone() const = 0;
 		/// Returns a string value depending on the type of the AbstractNode.
@@ -225,6 +226,21 @@ namespace Ogre
 		bool compile(const String &str, const String &source, const String &group);
 		/// Compiles resources from the given concrete node list
 		bool compile(const ConcreteNodeListPtr &nodes, const String &group);
+		/// Compiles resources from a script, reusing its AST from a cache file
+		/**
+		 * The cache file is used instead of lexing and parsing the script if it
+		 * was written for the script's current modification time, and is
+		 * rewritten otherwise. Scripts whose archive cannot report a modification
+		 * time, or which fail to convert cleanly, are never cached, and nothing
+		 * is cached while a listener is set since it may alter the tree.
+		 * @param stream The script
+		 * @param group The resource group to place the compiled resources into
+		 * @param cacheFile The file holding the cached AST of the script
+		 * @param parsed The script's concrete nodes if it was already parsed, 
+		 * used instead of parsing it again when the cache is out of date
+		 */
+		bool compile(DataStreamPtr &stream, const String &group, const String &cacheFile,
+			const ConcreteNodeListPtr &parsed = ConcreteNodeListPtr());
 		/// Adds the given error to the compiler's list of errors
 		void addError(uint32 code, const String &file, int line, const String &msg = "");
 		/// Sets the listener used by the compiler
@@ -248,6 +264,8 @@ namespace Ogre
 		Any _fireCreateObject(const String &type, const std::vector<Any> &args);
 	private: // Tree processing
 		AbstractNodeListPtr convertToAST(const ConcreteNodeListPtr &nodes);
+		/// Processes and translates an AST which has just been converted or loaded
+		bool compileAST(AbstractNodeListPtr &ast);
 		/// This built-in function processes import nodes
 		void processImports(AbstractNodeListPtr &nodes);
 		/// Loads the requested script and converts it to an AST
@@ -426,6 +444,21 @@ namespace Ogre
 
 		// A pointer to the specific compiler instance used
 		OGRE_THREAD_POINTER(ScriptCompiler, mScriptCompiler);
+
+		// The directory compiled scripts are cached in, empty if disabled
+		String mCacheDirectory;
+
+		/// Returns the cache file used for the given script
+		String getCacheFileName(const String &source, const String &group) const;
+
+		// Scripts parsed in advance by prepareScripts, waiting to be compiled
+		struct PreparedScript
+		{
+			DataStreamPtr stream; // Keeps the stream, and so its address, alive
+			ConcreteNodeListPtr nodes;
+		};
+		typedef std::map<DataStream*, PreparedScript> PreparedScriptMap;
+		PreparedScriptMap mPreparedScripts;
 	public:
 		ScriptCompilerManager();
 		virtual ~ScriptCompilerManager();
@@ -435,6 +468,19 @@ namespace Ogre
 		/// Returns the currently set listener used for compiler instances
 		ScriptCompilerListener *getListener();
 
+		/// Sets the directory the ASTs of parsed scripts are cached in
+		/**
+		 * When set, every script parsed by this manager has its AST written to
+		 * a file in this (existing) directory, and later runs read it back
+		 * instead of lexing and parsing the script again for as long as the
+		 * script's modification time is unchanged. An empty string, the
+		 * default, disables the cache.
+		 * @see ScriptCompiler::compile
+		 */
+		void setCacheDirectory(const String &dir);
+		/// Returns the directory the ASTs of parsed scripts are cached in
+		const String &getCacheDirectory() const;
+
 		/// Adds the given translator manager to the list of managers
 		void addTranslatorManager(ScriptTranslatorManager *man);
 		/// Removes the given translator manager from the list of managers
@@ -448,6 +494,20 @@ namespace Ogre
         const StringVector& getScriptPatterns(void) const;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, const String& groupName);
+		/** Lexes and parses a batch of scripts across the WorkerThreadPool.
+		@remarks
+			Nothing is done unless a parallel WorkerThreadPool exists. Only the
+			lexing and parsing, which depend on nothing but the script text, 
+			are done up front; the resulting trees are translated into resources
+			by parseScript, in order, on the calling thread, so the resources 
+			created are the same as when parsing serially. Scripts which fail
+			to parse here, or whose cached AST is current, are parsed by 
+			parseScript as usual.
+		@see ScriptLoader::prepareScripts
+		*/
+		void prepareScripts(DataStreamList& streams, const String& groupName);
+		/// @copydoc ScriptLoader::unprepareScripts
+		void unprepareScripts(DataStreamList& streams);
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const;
 
@@ -71,6 +71,33 @@ namespace Ogre {
 		*/
 		virtual void parseScript(DataStreamPtr& stream, const String& groupName) = 0;
 
+		/** Prepares a batch of script files before they are parsed.
+		@remarks
+			ResourceGroupManager calls this with consecutive batches of the files
+			matching the patterns returned from getScriptPatterns, and then calls
+			parseScript with each stream of the batch in the same order. Loaders
+			can use it to do the work which does not depend on other scripts,
+			such as parsing the files in parallel, up front. The streams must be
+			left positioned at their start. The default implementation does nothing.
+		@par
+			ResourceLoadingListener::resourceStreamOpened has been fired for
+			every stream of the batch before this is called, and so before 
+			ResourceGroupListener::scriptParseStarted is fired for the first.
+		@param streams The streams of the scripts, null for files which could 
+			not be opened
+		@param groupName The name of the resource group the scripts belong to
+		*/
+		virtual void prepareScripts(DataStreamList& streams, const String& groupName) {}
+
+		/** Discards what prepareScripts kept for scripts which will not be parsed.
+		@remarks
+			ResourceGroupManager calls this if parsing a batch fails part way,
+			with the streams of the batch which were not parsed yet; the others
+			are null. The default implementation does nothing.
+		@param streams The streams of the batch, as passed to prepareScripts
+		*/
+		virtual void unprepareScripts(DataStreamList& streams) {}
+
 		/** Gets the relative loading order of scripts of this type.
 		@remarks
 			There are dependencies between some kinds of scripts, and to enforce
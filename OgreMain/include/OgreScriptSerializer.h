@@ -0,0 +1,113 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __ScriptSerializer_H__
+#define __ScriptSerializer_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreSerializer.h"
+#include "OgreScriptCompiler.h"
+
+namespace Ogre {
+
+    /** Class for caching the abstract syntax tree of a script in a binary file.
+    @remarks
+        Lexing and parsing are the most expensive steps of compiling the
+        material, program, particle and compositor scripts. This class writes
+        the AST which the ScriptCompiler converts a script into (before any
+        imports, inheritance or variables are processed) together with the
+        top-level variables the script sets, so that it can be read back
+        on a later run instead of parsing the script again.
+    @par
+        Every cache file records the name and the modification time of the
+        script it was built from, and is ignored as soon as either differs.
+    */
+    class _OgreExport ScriptSerializer : public Serializer
+    {
+    public:
+        typedef std::map<String, String> VariableMap;
+
+        ScriptSerializer();
+        virtual ~ScriptSerializer();
+
+        /** Writes the AST of a script to the file specified.
+        @param nodes The AST as converted from the script
+        @param variables The top-level variables set by the script
+        @param source The name of the script
+        @param modifiedTime The modification time of the script
+        @param filename The destination filename
+        */
+        void exportAST(const AbstractNodeListPtr& nodes, const VariableMap& variables,
+            const String& source, time_t modifiedTime, const String& filename);
+
+        /** Reads the header of a cache file DataStream and checks that it was
+            built from the given version of a script.
+        @remarks
+            This leaves the stream positioned at the start of the AST, and does
+            not need a ScriptCompiler, so it can be used from any thread.
+        @param stream The DataStream holding the cache file
+        @param source The name of the script
+        @param modifiedTime The current modification time of the script
+        */
+        bool isCurrent(DataStreamPtr& stream, const String& source, time_t modifiedTime);
+
+        /** Reads the AST of a script from a cache file DataStream.
+        @param stream The DataStream holding the cache file
+        @param source The name of the script
+        @param modifiedTime The current modification time of the script
+        @param ids The word to id map used to fill in node ids
+        @param variables Receives the top-level variables set by the script
+        @returns The AST, or a null pointer if the file was not built from 
+            this version of the script or is not a valid cache file
+        */
+        AbstractNodeListPtr importAST(DataStreamPtr& stream, const String& source,
+            time_t modifiedTime, const ScriptCompiler::IdMap& ids, VariableMap& variables);
+
+    protected:
+        void writeNodes(const AbstractNodeList& nodes);
+        void writeNode(const AbstractNode* node);
+        void writeVariables(const VariableMap& variables);
+        void writeTime(time_t t);
+        void writeToken(const String& token);
+
+        /// Returns false if the data ran out or was invalid
+        bool readNodes(DataStreamPtr& stream, AbstractNode* parent, 
+            AbstractNodeList& nodes, const ScriptCompiler::IdMap& ids);
+        AbstractNode* readNode(DataStreamPtr& stream, AbstractNode* parent, 
+            const ScriptCompiler::IdMap& ids);
+        bool readVariables(DataStreamPtr& stream, VariableMap& variables);
+        time_t readTime(DataStreamPtr& stream);
+        bool readToken(DataStreamPtr& stream, String& token);
+        /// Returns the id of the given word, or 0 if it is not a keyword
+        uint32 findId(const ScriptCompiler::IdMap& ids, const String& word) const;
+    };
+
+}
+
+#endif
@@ -259,6 +259,10 @@ namespace Ogre {
             Internal use only. The array pointed to by the passed in pointer must
             be at least as large as the number of bones.
             Assumes animation has already been updated.
+        @par
+            The derived transforms of the bones are updated in the same pass 
+            (@see _updateTransforms), and the matrices are then calculated 
+            for all bones at once.
         */
         virtual void _getBoneMatrices(Matrix4* pMatrices);
 
@@ -278,7 +282,14 @@ namespace Ogre {
         /** Sets the animation blending mode this skeleton will use. */
 		virtual void setBlendMode(SkeletonAnimationBlendMode state);
 
-        /// Updates all the derived transforms in the skeleton
+        /** Updates all the derived transforms in the skeleton.
+        @remarks
+            Rather than recursing through the bone hierarchy with Node::_update,
+            this makes a single pass over the bones in an order where every 
+            bone comes after its parent, then hands the results back to the 
+            Bone objects. The order is laid out again whenever bones are added
+            or moved to a different parent.
+        */
         virtual void _updateTransforms(void);
 
 		/** Optimise all of this skeleton's animations.
@@ -417,6 +428,20 @@ namespace Ogre {
 		/// Manual bones dirty?
 		bool mManualBonesDirty;
 
+        typedef std::vector<ushort> BoneHandleList;
+        /// Handles of all bones, every bone after its parent
+        BoneHandleList mBoneUpdateOrder;
+        /// Handle of the parent of each bone, by handle; roots are their own parent
+        BoneHandleList mBoneParents;
+        /// Derived transform of each bone from the last update, by handle
+        std::vector<Quaternion> mBoneDerivedOrientations;
+        std::vector<Vector3> mBoneDerivedPositions;
+        std::vector<Vector3> mBoneDerivedScales;
+        /// Inverse binding pose of each bone, by handle
+        std::vector<Quaternion> mBoneBindInverseOrientations;
+        std::vector<Vector3> mBoneBindInversePositions;
+        std::vector<Vector3> mBoneBindInverseScales;
+
 
         /// Storage of animations, lookup by name
         typedef std::map<String, Animation*> AnimationList;
@@ -432,6 +457,14 @@ namespace Ogre {
         */
         void deriveRootBone(void) const;
 
+        /// Lays out mBoneUpdateOrder and mBoneParents from the bone hierarchy
+        void deriveBoneUpdateOrder(void);
+        /// Does mBoneUpdateOrder still match the bones and their hierarchy?
+        bool isBoneUpdateOrderValid(void) const;
+        /** Updates the derived transforms of all bones, and calculates the
+            bone matrices into pMatrices unless it is null. */
+        void updateBoneTransforms(Matrix4* pMatrices);
+
         /// Debugging method
         void _dumpContents(const String& filename);
 
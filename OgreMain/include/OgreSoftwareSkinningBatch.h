@@ -0,0 +1,139 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SoftwareSkinningBatch_H__
+#define __SoftwareSkinningBatch_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreHardwareVertexBuffer.h"
+
+namespace Ogre {
+
+	/** Collects software vertex blends so that they can be performed together,
+		split across the WorkerThreadPool.
+	@remarks
+		Each blend added to the batch takes the same parameters as 
+		Mesh::softwareVertexBlend, but nothing is done until execute() is 
+		called. The batch then locks every buffer involved once, divides the 
+		vertices of all the blends into chunks which are skinned by 
+		OptimisedUtil::softwareVertexSkinning in the worker threads, and 
+		finally unlocks the buffers again. Locking and unlocking (and therefore
+		any upload of the results to the hardware) are always done by the 
+		thread calling execute(), the worker threads only ever touch the 
+		locked memory.
+	@par
+		SceneManager keeps one of these open while it searches for visible 
+		objects if setParallelSoftwareSkinning is enabled, which is how the
+		Entity instances found by the search get their software skinning done
+		in parallel.
+	@note
+		The vertex data and buffers of pending blends must stay alive, and 
+		must not be locked elsewhere, until the batch is executed or cleared.
+	*/
+	class _OgreExport SoftwareSkinningBatch
+	{
+	protected:
+		/// A blend waiting to be executed
+		struct Blend
+		{
+			HardwareVertexBufferSharedPtr srcPosBuf, srcNormBuf, srcIdxBuf, srcWeightBuf;
+			HardwareVertexBufferSharedPtr destPosBuf, destNormBuf;
+			/// Offset of each element within a vertex of its buffer
+			size_t srcPosOffset, srcNormOffset, blendIdxOffset, blendWeightOffset;
+			size_t destPosOffset, destNormOffset;
+			size_t numWeightsPerVertex;
+			size_t numVertices;
+			/// Index of the first of this blend's matrices in mBlendMatrices
+			size_t firstBlendMatrix;
+			bool includeNormals;
+		};
+		typedef std::vector<Blend> BlendList;
+		BlendList mBlends;
+		/// Blend matrices of all the pending blends, one range per blend
+		std::vector<const Matrix4*> mBlendMatrices;
+		/// Total number of vertices of the pending blends
+		size_t mNumVertices;
+
+		/// A buffer which will be locked while the batch executes
+		struct LockedBuffer
+		{
+			HardwareVertexBufferSharedPtr buffer;
+			HardwareBuffer::LockOptions options;
+			char* data;
+		};
+		typedef std::map<HardwareVertexBuffer*, LockedBuffer> LockedBufferMap;
+		LockedBufferMap mLockedBuffers;
+
+		/// Register a buffer to be locked with the given options
+		void addBuffer(const HardwareVertexBufferSharedPtr& buf, 
+			HardwareBuffer::LockOptions options);
+		/// Get the locked contents of a buffer registered with addBuffer
+		char* getLockedData(const HardwareVertexBufferSharedPtr& buf) const;
+		/// Unlock all the buffers which are currently locked
+		void unlockBuffers(void);
+
+	public:
+		/** Minimum number of vertices in the batch to split it across the 
+			WorkerThreadPool; also the minimum number of vertices given to each 
+			task. Smaller batches are skinned serially in the calling thread.
+		*/
+		static const size_t PARALLEL_SKINNING_MIN_VERTICES = 2048;
+
+		SoftwareSkinningBatch();
+		~SoftwareSkinningBatch();
+
+		/** Adds a software vertex blend to the batch.
+		@remarks
+			Parameters as for Mesh::softwareVertexBlend. The blend matrix 
+			pointers are copied, but the matrices they point to must remain 
+			valid until the batch is executed.
+		*/
+		void addBlend(const VertexData* sourceVertexData, 
+			const VertexData* targetVertexData,
+			const Matrix4* const* blendMatrices, size_t numMatrices,
+			bool blendNormals);
+
+		/** Performs all the pending blends, then empties the batch.
+		@remarks
+			Must be called from the thread which owns the hardware buffers,
+			usually the render thread.
+		*/
+		void execute(void);
+
+		/** Discards all the pending blends without performing them. */
+		void clear(void);
+
+		/** Gets the number of pending blends. */
+		size_t getNumBlends(void) const { return mBlends.size(); }
+		/** Gets the total number of vertices of the pending blends. */
+		size_t getNumVertices(void) const { return mNumVertices; }
+	};
+
+}
+
+#endif
@@ -381,6 +381,9 @@ namespace Ogre {
 
 		bool mInternalResourcesCreated;
 
+		/// Source images decoded by prepareSourceImages, waiting to be loaded
+		std::vector<Image> mPreparedImages;
+
 		/// @copydoc Resource::calculateSize
 		size_t calculateSize(void) const;
 		
@@ -396,6 +399,27 @@ namespace Ogre {
 		/** Default implementation of unload which calls freeInternalResources */
 		void unloadImpl(void);
 
+		/** Reads and decodes the source images of the texture into
+			mPreparedImages.
+		@remarks
+			Texture subclasses which load their data through _loadImages can
+			call this from prepareImpl, so that file reading and image
+			decoding are done by the preparing thread. Cube maps which are not
+			in DDS format are read from six files with the suffixes _rt, _lf,
+			_up, _dn, _fr and _bk.
+		*/
+		void prepareSourceImages(void);
+
+		/** Loads the texture from mPreparedImages, preparing them first if
+			that has not been done already.
+		@remarks
+			For use by loadImpl of subclasses which call prepareSourceImages.
+		*/
+		void loadPreparedImages(void);
+
+		/// Discards mPreparedImages
+		void unprepareImpl(void);
+
 		/** Identify the source file type as a string, either from the extension
 			or from a magic number.
 		*/
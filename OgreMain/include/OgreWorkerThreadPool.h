@@ -0,0 +1,210 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __WorkerThreadPool_H__
+#define __WorkerThreadPool_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreSingleton.h"
+
+#if OGRE_THREAD_SUPPORT
+#	include <boost/thread/thread.hpp>
+#	include <boost/thread/condition.hpp>
+#endif
+
+namespace Ogre {
+
+	class Exception;
+
+	/** A pool of worker threads used to split CPU-bound engine work.
+	@remarks
+		The pool works in a 'fork and join' fashion: a caller hands over a
+		batch of independent tasks with executeTasks(), the worker threads
+		and the calling thread process them together, and the call only
+		returns once every task in the batch has been executed. This makes
+		it suitable for splitting up work which happens at a fixed point
+		in the frame (e.g. scene graph update, culling) where the results
+		are needed before the caller can proceed.
+	@par
+		The pool starts with no worker threads, in which case every batch is
+		executed serially in the calling thread. Call setNumWorkerThreads to
+		enable parallel execution; the parts of the engine which can use the
+		pool have their own switches to opt in to it, since it is up to the
+		application to ensure that any listeners called from them are
+		thread safe.
+	@note
+		Tasks will only be executed in parallel if OGRE_THREAD_SUPPORT is
+		defined to be 1. Otherwise all tasks are executed serially in the
+		calling thread. Batches submitted while another batch is in progress
+		(e.g. from inside a task) are also executed serially.
+	*/
+	class _OgreExport WorkerThreadPool : public Singleton<WorkerThreadPool>
+	{
+	public:
+		/** Interface for a unit of work to be executed by the pool.
+		@remarks
+			Tasks in the same batch may be executed concurrently, so they
+			must not modify any state which is shared with other tasks of the
+			batch without synchronisation.
+		*/
+		class _OgreExport Task
+		{
+		public:
+			virtual ~Task() {}
+			/// Perform the work
+			virtual void execute(void) = 0;
+		};
+		typedef std::vector<Task*> TaskList;
+
+	protected:
+		/// Number of worker threads requested
+		size_t mNumWorkerThreads;
+		/// The tasks of the batch currently being processed
+		const TaskList* mCurrentBatch;
+		/// Index of the next task to be picked up from the current batch
+		size_t mNextTask;
+		/// Number of tasks of the current batch not yet completed
+		size_t mTasksRemaining;
+		/// Copy of the first exception thrown by a task in the current batch
+		Exception* mTaskException;
+		/// Was the first exception thrown by a task in the current batch a std::bad_alloc?
+		bool mTaskOutOfMemory;
+		/// Thread shutdown?
+		bool mShuttingDown;
+
+#if OGRE_THREAD_SUPPORT
+		typedef std::vector<boost::thread*> ThreadList;
+		/// The worker threads
+		ThreadList mThreads;
+		/// Synchroniser token to wake up workers when a batch is available
+		boost::condition mWorkCondition;
+		/// Synchroniser token to wake up the caller when a batch is complete
+		boost::condition mDoneCondition;
+		/// Functor used as the entry point of worker threads
+		struct WorkerFunc
+		{
+			WorkerThreadPool* pool;
+			WorkerFunc(WorkerThreadPool* p) : pool(p) {}
+			void operator()() { pool->workerThreadMain(); }
+		};
+		/// Main loop of each worker thread
+		void workerThreadMain(void);
+#endif
+		/// Is a batch in progress?
+		bool mBatchInProgress;
+
+		/// Private mutex, not allowed to lock from outside
+		OGRE_AUTO_MUTEX
+
+		/// Start the requested number of threads
+		void startThreads(void);
+		/// Stop and join all threads
+		void stopThreads(void);
+		/** Pick up and execute tasks from the current batch until none are left.
+		@note Must be called with the auto mutex unlocked.
+		*/
+		void processTasks(void);
+		/// Execute a single task, capturing any exception it throws
+		void executeTask(Task* task);
+
+	public:
+		WorkerThreadPool();
+		~WorkerThreadPool();
+
+		/** Sets the number of worker threads in the pool.
+		@remarks
+			The calling thread of executeTasks always takes part in the
+			work, so on a machine with N hardware threads you would normally
+			use N-1 worker threads. Setting this to 0 (the default) means
+			that all tasks are executed serially in the calling thread.
+		@note
+			Must not be called while a batch is in progress. Has no effect
+			on parallelism if OGRE_THREAD_SUPPORT is 0.
+		*/
+		void setNumWorkerThreads(size_t numThreads);
+		/** Gets the number of worker threads in the pool. */
+		size_t getNumWorkerThreads(void) const { return mNumWorkerThreads; }
+
+		/** Returns whether batches are executed by more than one thread.
+		@remarks
+			Callers can use this to skip the overhead of splitting their
+			work up when it would be executed serially anyway.
+		*/
+		bool isParallel(void) const;
+
+		/** Executes a batch of tasks, returning when all are complete.
+		@remarks
+			The calling thread also executes tasks from the batch. The order
+			in which tasks are executed is undefined. If any task throws,
+			the remaining tasks are still executed and the first exception 
+			is then rethrown to the caller: an Ogre Exception as a copy, a 
+			std::bad_alloc as a std::bad_alloc, and anything else as an Ogre 
+			Exception with ERR_INTERNAL_ERROR.
+		@param tasks The tasks to execute; ownership is not transferred.
+		*/
+		void executeTasks(const TaskList& tasks);
+
+		/** Override standard Singleton retrieval.
+		@remarks
+		Why do we do this? Well, it's because the Singleton
+		implementation is in a .h file, which means it gets compiled
+		into anybody who includes it. This is needed for the
+		Singleton template to work, but we actually only want it
+		compiled into the implementation of the class based on the
+		Singleton, not all of them. If we don't change this, we get
+		link errors when trying to use the Singleton-based class from
+		an outside dll.
+		@par
+		This method just delegates to the template version anyway,
+		but the implementation stays in this single compilation unit,
+		preventing link errors.
+		*/
+		static WorkerThreadPool& getSingleton(void);
+		/** Override standard Singleton retrieval.
+		@remarks
+		Why do we do this? Well, it's because the Singleton
+		implementation is in a .h file, which means it gets compiled
+		into anybody who includes it. This is needed for the
+		Singleton template to work, but we actually only want it
+		compiled into the implementation of the class based on the
+		Singleton, not all of them. If we don't change this, we get
+		link errors when trying to use the Singleton-based class from
+		an outside dll.
+		@par
+		This method just delegates to the template version anyway,
+		but the implementation stays in this single compilation unit,
+		preventing link errors.
+		*/
+		static WorkerThreadPool* getSingletonPtr(void);
+
+	};
+
+}
+
+#endif
+
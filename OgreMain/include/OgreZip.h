@@ -85,6 +85,12 @@ namespace Ogre {
 
         /// @copydoc Archive::exists
         bool exists(const String& filename);
+
+        /** @copydoc Archive::getModifiedTime
+        @remarks
+            Returns the time the zip file itself was last modified.
+        */
+        time_t getModifiedTime(const String& filename);
     };
 
     /** Specialisation of ArchiveFactory for Zip files. */
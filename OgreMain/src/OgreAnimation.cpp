@@ -304,8 +304,11 @@ namespace Ogre {
 	void Animation::apply(Real timePos, Real weight, Real scale)
     {
         // Calculate time index for fast keyframe search
-        TimeIndex timeIndex = _getTimeIndex(timePos);
-
+        apply(_getTimeIndex(timePos), weight, scale);
+    }
+    //---------------------------------------------------------------------
+	void Animation::apply(const TimeIndex& timeIndex, Real weight, Real scale)
+    {
         NodeTrackList::iterator i;
         for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
         {
@@ -328,8 +331,12 @@ namespace Ogre {
 		Real scale)
     {
         // Calculate time index for fast keyframe search
-        TimeIndex timeIndex = _getTimeIndex(timePos);
-
+        apply(skel, _getTimeIndex(timePos), weight, scale);
+    }
+    //---------------------------------------------------------------------
+    void Animation::apply(Skeleton* skel, const TimeIndex& timeIndex, Real weight, 
+		Real scale)
+    {
         NodeTrackList::iterator i;
         for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
         {
@@ -345,8 +352,12 @@ namespace Ogre {
       const AnimationState::BoneBlendMask* blendMask, Real scale)
     {
       // Calculate time index for fast keyframe search
-      TimeIndex timeIndex = _getTimeIndex(timePos);
-
+      apply(skel, _getTimeIndex(timePos), weight, blendMask, scale);
+    }
+    //---------------------------------------------------------------------
+    void Animation::apply(Skeleton* skel, const TimeIndex& timeIndex, float weight,
+      const AnimationState::BoneBlendMask* blendMask, Real scale)
+    {
       NodeTrackList::iterator i;
       for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
       {
@@ -360,8 +371,12 @@ namespace Ogre {
 		bool software, bool hardware)
 	{
         // Calculate time index for fast keyframe search
-        TimeIndex timeIndex = _getTimeIndex(timePos);
-
+        apply(entity, _getTimeIndex(timePos), weight, software, hardware);
+	}
+	//---------------------------------------------------------------------
+	void Animation::apply(Entity* entity, const TimeIndex& timeIndex, Real weight, 
+		bool software, bool hardware)
+	{
 		VertexTrackList::iterator i;
 		for (i = mVertexTrackList.begin(); i != mVertexTrackList.end(); ++i)
 		{
@@ -608,19 +623,58 @@ namespace Ogre {
             buildKeyFrameTimeList();
         }
 
-        // Wrap time
-        Real totalAnimationLength = mLength;
+        timePos = wrapTimePos(timePos);
+
+        // Search for global index
+        KeyFrameTimeList::iterator it =
+            std::lower_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), timePos);
+
+        return TimeIndex(timePos, std::distance(mKeyFrameTimes.begin(), it));
+    }
+    //-----------------------------------------------------------------------
+    TimeIndex Animation::_getTimeIndex(Real timePos, uint& keyFrameCursor) const
+    {
+        // Build keyframe time list on demand
+        if (mKeyFrameTimesDirty)
+        {
+            buildKeyFrameTimeList();
+        }
+
+        timePos = wrapTimePos(timePos);
 
-        while (timePos > totalAnimationLength && totalAnimationLength > 0.0f)
+        // The index wanted is the lower bound, i.e. the first keyframe time 
+        // which is not before timePos; try the cursor and the one after it
+        uint numTimes = static_cast<uint>(mKeyFrameTimes.size());
+        uint index = keyFrameCursor;
+        for (uint attempt = 0; attempt < 2; ++attempt, ++index)
         {
-            timePos -= totalAnimationLength;
+            if (index <= numTimes &&
+                (index == numTimes || mKeyFrameTimes[index] >= timePos) &&
+                (index == 0 || mKeyFrameTimes[index - 1] < timePos))
+            {
+                keyFrameCursor = index;
+                return TimeIndex(timePos, index);
+            }
         }
 
-        // Search for global index
+        // Jumped or looped, search for global index
         KeyFrameTimeList::iterator it =
             std::lower_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), timePos);
+        keyFrameCursor = static_cast<uint>(std::distance(mKeyFrameTimes.begin(), it));
 
-        return TimeIndex(timePos, std::distance(mKeyFrameTimes.begin(), it));
+        return TimeIndex(timePos, keyFrameCursor);
+    }
+    //-----------------------------------------------------------------------
+    Real Animation::wrapTimePos(Real timePos) const
+    {
+        if (timePos > mLength && mLength > 0.0f)
+        {
+            // Whole loops land on the end of the animation, not the start
+            timePos = std::fmod(timePos, mLength);
+            if (timePos == 0.0f)
+                timePos = mLength;
+        }
+        return timePos;
     }
     //-----------------------------------------------------------------------
     void Animation::buildKeyFrameTimeList(void) const
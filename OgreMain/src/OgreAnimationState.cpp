@@ -36,14 +36,15 @@ namespace Ogre
 
 	//---------------------------------------------------------------------
 	AnimationState::AnimationState(AnimationStateSet* parent, const AnimationState &rhs)
-        : mAnimationName(rhs.mAnimationName)
+        : mBlendMask(0)
+        , mAnimationName(rhs.mAnimationName)
         , mParent(parent)
         , mTimePos(rhs.mTimePos)
         , mLength(rhs.mLength)
         , mWeight(rhs.mWeight)
         , mEnabled(rhs.mEnabled)
         , mLoop(rhs.mLoop)
-        , mBlendMask(0)
+        , mKeyFrameCursors(rhs.mKeyFrameCursors)
   {
 		mParent->_notifyDirty();
 	}
@@ -55,14 +56,14 @@ namespace Ogre
     AnimationState::AnimationState(const String& animName, 
 		AnimationStateSet *parent, Real timePos, Real length, Real weight, 
 		bool enabled)
-        : mAnimationName(animName)
+        : mBlendMask(0)
+        , mAnimationName(animName)
         , mParent(parent)
         , mTimePos(timePos)
         , mLength(length)
         , mWeight(weight)
         , mEnabled(enabled)
         , mLoop(true)
-        , mBlendMask(0)
     {
 		mParent->_notifyDirty();
     }
@@ -170,6 +171,20 @@ namespace Ogre
         return !(*this == rhs);
     }
     //---------------------------------------------------------------------
+    uint& AnimationState::_getKeyFrameCursor(const Animation* anim) const
+    {
+        // Only a handful of animations share a state, so a linear search is
+        // cheaper than a map
+        KeyFrameCursorList::iterator i, iend = mKeyFrameCursors.end();
+        for (i = mKeyFrameCursors.begin(); i != iend; ++i)
+        {
+            if (i->first == anim)
+                return i->second;
+        }
+        mKeyFrameCursors.push_back(KeyFrameCursorList::value_type(anim, 0));
+        return mKeyFrameCursors.back().second;
+    }
+    //---------------------------------------------------------------------
     void AnimationState::copyStateFrom(const AnimationState& animState)
     {
         mTimePos = animState.mTimePos;
@@ -75,6 +75,24 @@ namespace Ogre {
     //---------------------------------------------------------------------
     Real AnimationTrack::getKeyFramesAtTime(const TimeIndex& timeIndex, KeyFrame** keyFrame1, KeyFrame** keyFrame2,
         unsigned short* firstKeyIndex) const
+    {
+        ushort index1, index2;
+        Real t = getKeyFrameIndicesAtTime(timeIndex, &index1, &index2);
+
+        *keyFrame1 = mKeyFrames[index1];
+        *keyFrame2 = mKeyFrames[index2];
+
+        // Fill index of the first key
+        if (firstKeyIndex)
+        {
+            *firstKeyIndex = index1;
+        }
+
+        return t;
+    }
+    //---------------------------------------------------------------------
+    Real AnimationTrack::getKeyFrameIndicesAtTime(const TimeIndex& timeIndex, 
+        ushort* firstKeyIndex, ushort* secondKeyIndex) const
     {
         // Parametric time
         // t1 = time of previous keyframe
@@ -84,19 +102,19 @@ namespace Ogre {
         Real timePos = timeIndex.getTimePos();
 
         // Find first keyframe after or on current time
-        KeyFrameList::const_iterator i;
+        size_t i;
         if (timeIndex.hasKeyIndex())
         {
             // Global keyframe index available, map to local keyframe index directly.
             assert(timeIndex.getKeyIndex() < mKeyFrameIndexMap.size());
-            i = mKeyFrames.begin() + mKeyFrameIndexMap[timeIndex.getKeyIndex()];
+            i = mKeyFrameIndexMap[timeIndex.getKeyIndex()];
 #ifdef _DEBUG
-            KeyFrame timeKey(0, timePos);
-            if (i != std::lower_bound(mKeyFrames.begin(), mKeyFrames.end(), &timeKey, KeyFrameTimeLess()))
+            if (i != (size_t)std::distance(mKeyFrameTimes.begin(), 
+                std::lower_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), timePos)))
             {
                 OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
                     "Optimised key frame search failed",
-                    "AnimationTrack::getKeyFramesAtTime");
+                    "AnimationTrack::getKeyFrameIndicesAtTime");
             }
 #endif
         }
@@ -106,46 +124,43 @@ namespace Ogre {
             Real totalAnimationLength = mParent->getLength();
             assert(totalAnimationLength > 0.0f && "Invalid animation length!");
 
-            while (timePos > totalAnimationLength && totalAnimationLength > 0.0f)
+            if (timePos > totalAnimationLength && totalAnimationLength > 0.0f)
             {
-                timePos -= totalAnimationLength;
+                // Whole loops land on the end of the animation, not the start
+                timePos = std::fmod(timePos, totalAnimationLength);
+                if (timePos == 0.0f)
+                    timePos = totalAnimationLength;
             }
 
             // No global keyframe index, need to search with local keyframes.
-            KeyFrame timeKey(0, timePos);
-            i = std::lower_bound(mKeyFrames.begin(), mKeyFrames.end(), &timeKey, KeyFrameTimeLess());
+            i = std::distance(mKeyFrameTimes.begin(), 
+                std::lower_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), timePos));
         }
 
-        if (i == mKeyFrames.end())
+        if (i == mKeyFrameTimes.size())
         {
             // There is no keyframe after this time, wrap back to first
-            *keyFrame2 = mKeyFrames.front();
-            t2 = mParent->getLength() + (*keyFrame2)->getTime();
+            *secondKeyIndex = 0;
+            t2 = mParent->getLength() + mKeyFrameTimes.front();
 
             // Use last keyframe as previous keyframe
             --i;
         }
         else
         {
-            *keyFrame2 = *i;
-            t2 = (*keyFrame2)->getTime();
+            *secondKeyIndex = static_cast<ushort>(i);
+            t2 = mKeyFrameTimes[i];
 
             // Find last keyframe before or on current time
-            if (i != mKeyFrames.begin() && timePos < (*i)->getTime())
+            if (i != 0 && timePos < mKeyFrameTimes[i])
             {
                 --i;
             }
         }
 
-        // Fill index of the first key
-        if (firstKeyIndex)
-        {
-            *firstKeyIndex = std::distance(mKeyFrames.begin(), i);
-        }
-
-        *keyFrame1 = *i;
+        *firstKeyIndex = static_cast<ushort>(i);
 
-        t1 = (*keyFrame1)->getTime();
+        t1 = mKeyFrameTimes[i];
 
         if (t1 == t2)
         {
@@ -165,6 +180,8 @@ namespace Ogre {
         // Insert just before upper bound
         KeyFrameList::iterator i =
             std::upper_bound(mKeyFrames.begin(), mKeyFrames.end(), kf, KeyFrameTimeLess());
+        mKeyFrameTimes.insert(mKeyFrameTimes.begin() + std::distance(mKeyFrames.begin(), i), 
+            timePos);
         mKeyFrames.insert(i, kf);
 
         _keyFrameDataChanged();
@@ -186,6 +203,7 @@ namespace Ogre {
         delete *i;
 
         mKeyFrames.erase(i);
+        mKeyFrameTimes.erase(mKeyFrameTimes.begin() + index);
 
         _keyFrameDataChanged();
         mParent->_keyFrameListChanged();
@@ -206,14 +224,15 @@ namespace Ogre {
         mParent->_keyFrameListChanged();
 
         mKeyFrames.clear();
+        mKeyFrameTimes.clear();
 
     }
     //---------------------------------------------------------------------
     void AnimationTrack::_collectKeyFrameTimes(std::vector<Real>& keyFrameTimes)
     {
-        for (KeyFrameList::const_iterator i = mKeyFrames.begin(); i != mKeyFrames.end(); ++i)
+        for (KeyFrameTimeList::const_iterator i = mKeyFrameTimes.begin(); i != mKeyFrameTimes.end(); ++i)
         {
-            Real timePos = (*i)->getTime();
+            Real timePos = *i;
 
             std::vector<Real>::iterator it =
                 std::lower_bound(keyFrameTimes.begin(), keyFrameTimes.end(), timePos);
@@ -233,7 +252,7 @@ namespace Ogre {
         while (j <= keyFrameTimes.size())
         {
             mKeyFrameIndexMap[j] = static_cast<ushort>(i);
-            while (i < mKeyFrames.size() && mKeyFrames[i]->getTime() <= keyFrameTimes[j])
+            while (i < mKeyFrameTimes.size() && mKeyFrameTimes[i] <= keyFrameTimes[j])
                 ++i;
             ++j;
         }
@@ -246,6 +265,7 @@ namespace Ogre {
 		{
 			KeyFrame* clonekf = (*i)->_clone(clone);
 			clone->mKeyFrames.push_back(clonekf);
+			clone->mKeyFrameTimes.push_back(clonekf->getTime());
 		}
 	}
 	//---------------------------------------------------------------------
@@ -360,6 +380,7 @@ namespace Ogre {
 		: AnimationTrack(parent, handle), mTargetNode(0)
         , mSplines(0), mSplineBuildNeeded(false)
         , mUseShortestRotationPath(true)
+        , mKeyFrameTransformsBuildNeeded(true)
 	{
 	}
 	//---------------------------------------------------------------------
@@ -368,6 +389,7 @@ namespace Ogre {
 		: AnimationTrack(parent, handle), mTargetNode(targetNode)
         , mSplines(0), mSplineBuildNeeded(false)
         , mUseShortestRotationPath(true)
+        , mKeyFrameTransformsBuildNeeded(true)
 	{
 	}
     //---------------------------------------------------------------------
@@ -386,21 +408,22 @@ namespace Ogre {
 
 		TransformKeyFrame* kret = static_cast<TransformKeyFrame*>(kf);
 
-        // Keyframe pointers
-		KeyFrame *kBase1, *kBase2;
-        TransformKeyFrame *k1, *k2;
-        unsigned short firstKeyIndex;
-
-        Real t = this->getKeyFramesAtTime(timeIndex, &kBase1, &kBase2, &firstKeyIndex);
-		k1 = static_cast<TransformKeyFrame*>(kBase1);
-		k2 = static_cast<TransformKeyFrame*>(kBase2);
+        // Read the transforms from the packed copy rather than the keyframes
+        if (mKeyFrameTransformsBuildNeeded)
+        {
+            buildKeyFrameTransforms();
+        }
+        unsigned short firstKeyIndex, secondKeyIndex;
+        Real t = getKeyFrameIndicesAtTime(timeIndex, &firstKeyIndex, &secondKeyIndex);
+        const KeyFrameTransform* k1 = &mKeyFrameTransforms[firstKeyIndex];
+        const KeyFrameTransform* k2 = &mKeyFrameTransforms[secondKeyIndex];
 
         if (t == 0.0)
         {
             // Just use k1
-            kret->setRotation(k1->getRotation());
-            kret->setTranslate(k1->getTranslate());
-            kret->setScale(k1->getScale());
+            kret->setRotation(k1->rotate);
+            kret->setTranslate(k1->translate);
+            kret->setScale(k1->scale);
         }
         else
         {
@@ -417,22 +440,22 @@ namespace Ogre {
                 // Interpolate to nearest rotation if mUseShortestRotationPath set
                 if (rim == Animation::RIM_LINEAR)
                 {
-                    kret->setRotation( Quaternion::nlerp(t, k1->getRotation(),
-                        k2->getRotation(), mUseShortestRotationPath) );
+                    kret->setRotation( Quaternion::nlerp(t, k1->rotate,
+                        k2->rotate, mUseShortestRotationPath) );
                 }
                 else //if (rim == Animation::RIM_SPHERICAL)
                 {
-                    kret->setRotation( Quaternion::Slerp(t, k1->getRotation(),
-					    k2->getRotation(), mUseShortestRotationPath) );
+                    kret->setRotation( Quaternion::Slerp(t, k1->rotate,
+					    k2->rotate, mUseShortestRotationPath) );
                 }
 
                 // Translation
-                base = k1->getTranslate();
-                kret->setTranslate( base + ((k2->getTranslate() - base) * t) );
+                base = k1->translate;
+                kret->setTranslate( base + ((k2->translate - base) * t) );
 
                 // Scale
-                base = k1->getScale();
-                kret->setScale( base + ((k2->getScale() - base) * t) );
+                base = k1->scale;
+                kret->setScale( base + ((k2->scale - base) * t) );
                 break;
 
             case Animation::IM_SPLINE:
@@ -552,6 +575,23 @@ namespace Ogre {
 
         mSplineBuildNeeded = false;
     }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::buildKeyFrameTransforms(void) const
+    {
+        mKeyFrameTransforms.resize(mKeyFrames.size());
+        KeyFrameTransformList::iterator dest = mKeyFrameTransforms.begin();
+        KeyFrameList::const_iterator i, iend;
+        iend = mKeyFrames.end();
+        for (i = mKeyFrames.begin(); i != iend; ++i, ++dest)
+        {
+			TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(*i);
+            dest->rotate = kf->getRotation();
+            dest->translate = kf->getTranslate();
+            dest->scale = kf->getScale();
+        }
+
+        mKeyFrameTransformsBuildNeeded = false;
+    }
 
     //---------------------------------------------------------------------
 	void NodeAnimationTrack::setUseShortestRotationPath(bool useShortestPath)
@@ -568,6 +608,7 @@ namespace Ogre {
     void NodeAnimationTrack::_keyFrameDataChanged(void) const
     {
         mSplineBuildNeeded = true;
+        mKeyFrameTransformsBuildNeeded = true;
     }
     //---------------------------------------------------------------------
 	bool NodeAnimationTrack::hasNonZeroKeyFrames(void) const
@@ -122,13 +122,20 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void BillboardParticleRenderer::_updateRenderQueue(RenderQueue* queue, 
         std::list<Particle*>& currentParticles, bool cullIndividually)
+    {
+        std::vector<Particle*> particles(currentParticles.begin(), currentParticles.end());
+        _updateRenderQueue(queue, particles, cullIndividually);
+    }
+    //-----------------------------------------------------------------------
+    void BillboardParticleRenderer::_updateRenderQueue(RenderQueue* queue, 
+        std::vector<Particle*>& currentParticles, bool cullIndividually)
     {
         mBillboardSet->setCullIndividually(cullIndividually);
 
         // Update billboard set geometry
         mBillboardSet->beginBillboards(currentParticles.size());
         Billboard bb;
-        for (std::list<Particle*>::iterator i = currentParticles.begin();
+        for (std::vector<Particle*>::iterator i = currentParticles.begin();
             i != currentParticles.end(); ++i)
         {
             Particle* p = *i;
@@ -128,6 +128,26 @@ namespace Ogre {
 		}
 
 	}
+	//---------------------------------------------------------------------
+	void Bone::_updateFromSkeleton(const Quaternion& derivedOrientation,
+		const Vector3& derivedPosition, const Vector3& derivedScale)
+	{
+		_updateFromTransformStore(derivedOrientation, derivedPosition, derivedScale);
+
+		ChildNodeMap::iterator it, itend;
+		itend = mChildren.end();
+		for (it = mChildren.begin(); it != itend; ++it)
+		{
+			Bone* child = static_cast<Bone*>(it->second);
+			unsigned short handle = child->getHandle();
+			if (handle >= mCreator->getNumBones() || mCreator->getBone(handle) != child)
+			{
+				child->_update(true, true);
+			}
+		}
+
+		_transformStoreUpdateComplete(true);
+	}
 
 
 
@@ -819,6 +819,30 @@ namespace Ogre {
 		}
 	}
 	//-----------------------------------------------------------------------
+	void Camera::isVisible(const AxisAlignedBox* bounds, size_t count, uint32* visibility) const
+	{
+		if (mCullFrustum)
+		{
+			mCullFrustum->isVisible(bounds, count, visibility);
+		}
+		else
+		{
+			Frustum::isVisible(bounds, count, visibility);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void Camera::isVisible(const Sphere* spheres, size_t count, uint32* visibility) const
+	{
+		if (mCullFrustum)
+		{
+			mCullFrustum->isVisible(spheres, count, visibility);
+		}
+		else
+		{
+			Frustum::isVisible(spheres, count, visibility);
+		}
+	}
+	//-----------------------------------------------------------------------
 	const Vector3* Camera::getWorldSpaceCorners(void) const
 	{
 		if (mCullFrustum)
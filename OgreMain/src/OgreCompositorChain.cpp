@@ -194,10 +194,18 @@ void CompositorChain::preRenderTargetUpdate(const RenderTargetEvent& evt)
 		if(i->onlyInitial && i->hasBeenRendered)
 			continue;
 		i->hasBeenRendered = true;
+		Viewport* vp = i->target->getViewport(0);
+		/// Pooled targets may have last been rendered for another viewport
+		if (vp->getCamera() != cam)
+		{
+			Viewport* oldViewport = cam->getViewport();
+			vp->setCamera(cam);
+			cam->_notifyViewport(oldViewport);
+		}
 		/// Setup and render
-        preTargetOperation(*i, i->target->getViewport(0), cam);
+        preTargetOperation(*i, vp, cam);
         i->target->update();
-        postTargetOperation(*i, i->target->getViewport(0), cam);
+        postTargetOperation(*i, vp, cam);
     }
 }
 //-----------------------------------------------------------------------
@@ -329,6 +337,10 @@ void CompositorChain::_compile()
     }
     
 
+    /// Assign shared textures before their names are compiled into materials
+    if (CompositorManager::getSingleton().getRenderTargetPoolingEnabled())
+        assignPooledTextures(lastComposition);
+
     /// Compile misc targets
     lastComposition->_compileTargetOperations(mCompiledState);
     
@@ -416,4 +428,220 @@ void CompositorChain::RQListener::flushUpTo(uint8 id)
 	}
 }
 //-----------------------------------------------------------------------
+//-----------------------------------------------------------------------
+namespace
+{
+	/// A local texture which can use a pooled texture
+	struct PoolCandidate
+	{
+		CompositorInstance* instance;
+		CompositionTechnique::TextureDefinition* def;
+		size_t firstUse;
+		size_t lastUse;
+
+		bool operator<(const PoolCandidate& rhs) const
+		{
+			return firstUse < rhs.firstUse;
+		}
+	};
+
+	/// A pooled texture as used by this chain, free again after lastUse
+	struct PoolSlot
+	{
+		size_t width, height;
+		PixelFormat format;
+		uint fsaa;
+		bool hwGammaWrite;
+		size_t index;
+		size_t lastUse;
+	};
+
+	/// Whether a pass replaces all of the contents of its target, so they
+	/// need not be kept from before it; anything else reads them
+	bool overwritesTarget(CompositionPass* pass)
+	{
+		switch (pass->getType())
+		{
+		case CompositionPass::PT_CLEAR:
+			return (pass->getClearBuffers() & FBT_COLOUR) != 0;
+		case CompositionPass::PT_RENDERQUAD:
+			{
+				/// A blended quad mixes in the previous contents
+				Real left, top, right, bottom;
+				const MaterialPtr& mat = pass->getMaterial();
+				return !pass->getQuadCorners(left, top, right, bottom) &&
+					!pass->getStencilCheck() && !mat.isNull() && !mat->isTransparent();
+			}
+		default:
+			return false;
+		}
+	}
+}
+//-----------------------------------------------------------------------
+void CompositorChain::assignPooledTextures(CompositorInstance *lastComposition)
+{
+	/// Work out when each local texture is used, as the compiled state will
+	TextureUseMap uses;
+	size_t step = 0;
+	collectTargetTextureUses(lastComposition, step, uses);
+	/// Textures read by the final output are still in use when other chains
+	/// render their targets
+	const size_t outputStep = step;
+	collectOutputTextureUses(lastComposition, outputStep, uses);
+
+	std::vector<PoolCandidate> candidates;
+	for (CompositorInstance* inst = lastComposition; inst; inst = inst->mPreviousInstance)
+	{
+		CompositionTechnique::TextureDefinitionIterator it = 
+			inst->getTechnique()->getTextureDefinitionIterator();
+		while (it.hasMoreElements())
+		{
+			CompositionTechnique::TextureDefinition* def = it.getNext();
+			if (def->formatList.size() > 1)
+				continue;
+
+			TextureUseMap::iterator u = uses.find(InstanceTexture(inst, def->name));
+			if (u != uses.end() && u->second.poolable && u->second.lastUse < outputStep)
+			{
+				PoolCandidate candidate;
+				candidate.instance = inst;
+				candidate.def = def;
+				candidate.firstUse = u->second.firstUse;
+				candidate.lastUse = u->second.lastUse;
+				candidates.push_back(candidate);
+			}
+			else
+			{
+				inst->createLocalTexture(def);
+			}
+		}
+	}
+
+	/// Give each candidate the first pooled texture of its kind which is
+	/// free by the time it is first used
+	std::stable_sort(candidates.begin(), candidates.end());
+	std::vector<PoolSlot> slots;
+	for (std::vector<PoolCandidate>::iterator c = candidates.begin(); c != candidates.end(); ++c)
+	{
+		PoolSlot key;
+		c->instance->getTextureParams(c->def, key.width, key.height, key.fsaa, key.hwGammaWrite);
+		key.format = c->def->formatList[0];
+
+		PoolSlot* slot = 0;
+		size_t sameKind = 0;
+		for (std::vector<PoolSlot>::iterator s = slots.begin(); s != slots.end(); ++s)
+		{
+			if (s->width == key.width && s->height == key.height && s->format == key.format &&
+				s->fsaa == key.fsaa && s->hwGammaWrite == key.hwGammaWrite)
+			{
+				++sameKind;
+				if (s->lastUse < c->firstUse)
+				{
+					slot = &(*s);
+					break;
+				}
+			}
+		}
+		if (!slot)
+		{
+			key.index = sameKind;
+			slots.push_back(key);
+			slot = &slots.back();
+		}
+		slot->lastUse = c->lastUse;
+
+		c->instance->setPooledTexture(c->def->name, 
+			CompositorManager::getSingleton()._getPooledTexture(slot->width, slot->height,
+				slot->format, slot->fsaa, slot->hwGammaWrite, slot->index));
+	}
+}
+//-----------------------------------------------------------------------
+void CompositorChain::collectTargetTextureUses(CompositorInstance *inst, size_t &step, 
+	TextureUseMap &uses)
+{
+	if (inst->mPreviousInstance)
+		collectTargetTextureUses(inst->mPreviousInstance, step, uses);
+
+	CompositionTechnique::TargetPassIterator it = inst->getTechnique()->getTargetPassIterator();
+	while (it.hasMoreElements())
+	{
+		CompositionTargetPass* target = it.getNext();
+
+		/// Reads come before the write of the same operation, so a texture
+		/// read while rendering to itself is never pooled
+		bool overwrites = false;
+		if (target->getInputMode() == CompositionTargetPass::IM_PREVIOUS)
+		{
+			collectOutputTextureUses(inst->mPreviousInstance, step, uses);
+			overwrites = true;
+		}
+		else if (target->getNumPasses() > 0)
+		{
+			overwrites = overwritesTarget(target->getPass(0));
+		}
+		collectTextureReads(inst, target, step, uses);
+
+		InstanceTexture key(inst, target->getOutputName());
+		TextureUseMap::iterator u = uses.find(key);
+		if (u == uses.end())
+		{
+			/// Only the contents of a texture fully rendered on first use, and
+			/// rendered every frame, need not be kept from frame to frame
+			TextureUse use;
+			use.firstUse = use.lastUse = step;
+			use.poolable = overwrites && !target->getOnlyInitial();
+			uses[key] = use;
+		}
+		else
+		{
+			u->second.lastUse = step;
+			if (target->getOnlyInitial())
+				u->second.poolable = false;
+		}
+		++step;
+	}
+}
+//-----------------------------------------------------------------------
+void CompositorChain::collectOutputTextureUses(CompositorInstance *inst, size_t step, 
+	TextureUseMap &uses)
+{
+	CompositionTargetPass* target = inst->getTechnique()->getOutputTargetPass();
+	if (target->getInputMode() == CompositionTargetPass::IM_PREVIOUS)
+		collectOutputTextureUses(inst->mPreviousInstance, step, uses);
+	collectTextureReads(inst, target, step, uses);
+}
+//-----------------------------------------------------------------------
+void CompositorChain::collectTextureReads(CompositorInstance *inst, CompositionTargetPass *target,
+	size_t step, TextureUseMap &uses)
+{
+	CompositionTargetPass::PassIterator pit = target->getPassIterator();
+	while (pit.hasMoreElements())
+	{
+		CompositionPass* pass = pit.getNext();
+		if (pass->getType() != CompositionPass::PT_RENDERQUAD)
+			continue;
+		for (size_t x = 0; x < pass->getNumInputs(); ++x)
+		{
+			const String& name = pass->getInput(x).name;
+			if (name.empty())
+				continue;
+
+			InstanceTexture key(inst, name);
+			TextureUseMap::iterator u = uses.find(key);
+			if (u == uses.end())
+			{
+				/// Read before it is written, so it holds the last frame's contents
+				TextureUse use;
+				use.firstUse = use.lastUse = step;
+				use.poolable = false;
+				uses[key] = use;
+			}
+			else
+			{
+				u->second.lastUse = step;
+			}
+		}
+	}
+}
+
 }
@@ -407,37 +407,30 @@ static size_t dummyCounter = 0;
     return mat;
 }
 //-----------------------------------------------------------------------
+/// Counter used to make the names of local textures and MRTs unique
+static size_t localTextureCounter = 0;
+//-----------------------------------------------------------------------
 void CompositorInstance::createResources()
 {
-static size_t dummyCounter = 0;
     freeResources();
     /// Create temporary textures
-    /// In principle, temporary textures could be shared between multiple viewports
-    /// (CompositorChains). This will save a lot of memory in case more viewports
-    /// are composited.
+    /// With render target pooling enabled, the chain assigns single textures
+    /// when it compiles, sharing them between instances and viewports where
+    /// their lifetimes allow (see CompositorManager::setRenderTargetPoolingEnabled).
+    const bool pooling = CompositorManager::getSingleton().getRenderTargetPoolingEnabled();
     CompositionTechnique::TextureDefinitionIterator it = mTechnique->getTextureDefinitionIterator();
     while(it.hasMoreElements())
     {
         CompositionTechnique::TextureDefinition *def = it.getNext();
-        /// Determine width and height
-        size_t width = def->width;
-        size_t height = def->height;
-		uint fsaa = 0;
-		bool hwGammaWrite = false;
-
-		deriveTextureRenderTargetOptions(def->name, &hwGammaWrite, &fsaa);
-
-        if(width == 0)
-            width = static_cast<size_t>(
-				static_cast<float>(mChain->getViewport()->getActualWidth()) * def->widthFactor);
-        if(height == 0)
-			height = static_cast<size_t>(
-				static_cast<float>(mChain->getViewport()->getActualHeight()) * def->heightFactor);
-        /// Make the tetxure
-		RenderTarget* rendTarget;
 		if (def->formatList.size() > 1)
 		{
-			String MRTbaseName = "c" + StringConverter::toString(dummyCounter++) + 
+			/// Determine width and height
+			size_t width, height;
+			uint fsaa;
+			bool hwGammaWrite;
+			getTextureParams(def, width, height, fsaa, hwGammaWrite);
+
+			String MRTbaseName = "c" + StringConverter::toString(localTextureCounter++) + 
 				"/" + def->name + "/" + mChain->getViewport()->getTarget()->getName();
 			MultiRenderTarget* mrt = 
 				Root::getSingleton().getRenderSystem()->createMultiRenderTarget(MRTbaseName);
@@ -464,47 +457,112 @@ static size_t dummyCounter = 0;
 				
 			}
 
-			rendTarget = mrt;
+			setupRenderTarget(mrt);
 		}
-		else
+		else if (!pooling)
 		{
-			String texName =  "c" + StringConverter::toString(dummyCounter++) + 
-				"/" + def->name + "/" + mChain->getViewport()->getTarget()->getName();
-			TexturePtr tex = TextureManager::getSingleton().createManual(
-				texName, 
-				ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME, TEX_TYPE_2D, 
-				(uint)width, (uint)height, 0, def->formatList[0], TU_RENDERTARGET, 0,
-				hwGammaWrite, fsaa); 
-
-			rendTarget = tex->getBuffer()->getRenderTarget();
-			mLocalTextures[def->name] = tex;
+			createLocalTexture(def);
 		}
-        
-        
-        /// Set up viewport over entire texture
-        rendTarget->setAutoUpdated( false );
-
-        Camera* camera = mChain->getViewport()->getCamera();
-
-        // Save last viewport and current aspect ratio
-        Viewport* oldViewport = camera->getViewport();
-        Real aspectRatio = camera->getAspectRatio();
-
-        Viewport* v = rendTarget->addViewport( camera );
-        v->setClearEveryFrame( false );
-        v->setOverlaysEnabled( false );
-        v->setBackgroundColour( ColourValue( 0, 0, 0, 0 ) );
-
-        // Should restore aspect ratio, in case of auto aspect ratio
-        // enabled, it'll changed when add new viewport.
-        camera->setAspectRatio(aspectRatio);
-        // Should restore last viewport, i.e. never disturb user code
-        // which might based on that.
-        camera->_notifyViewport(oldViewport);
     }
     
 }
 //---------------------------------------------------------------------
+void CompositorInstance::createLocalTexture(CompositionTechnique::TextureDefinition *def)
+{
+	LocalTextureMap::iterator i = mLocalTextures.find(def->name);
+	if (i != mLocalTextures.end())
+	{
+		if (mPooledTextures.find(def->name) == mPooledTextures.end())
+			return;
+		freeLocalTexture(def->name);
+	}
+
+	size_t width, height;
+	uint fsaa;
+	bool hwGammaWrite;
+	getTextureParams(def, width, height, fsaa, hwGammaWrite);
+
+	String texName =  "c" + StringConverter::toString(localTextureCounter++) + 
+		"/" + def->name + "/" + mChain->getViewport()->getTarget()->getName();
+	TexturePtr tex = TextureManager::getSingleton().createManual(
+		texName, 
+		ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME, TEX_TYPE_2D, 
+		(uint)width, (uint)height, 0, def->formatList[0], TU_RENDERTARGET, 0,
+		hwGammaWrite, fsaa); 
+	mLocalTextures[def->name] = tex;
+
+	setupRenderTarget(tex->getBuffer()->getRenderTarget());
+}
+//---------------------------------------------------------------------
+void CompositorInstance::setPooledTexture(const String &name, const TexturePtr &tex)
+{
+	freeLocalTexture(name);
+	mLocalTextures[name] = tex;
+	mPooledTextures.insert(name);
+
+	/// The first instance to use a pooled texture sets up its viewport; the
+	/// chain switches the camera whenever another viewport renders to it
+	RenderTarget* rendTarget = tex->getBuffer()->getRenderTarget();
+	if (rendTarget->getNumViewports() == 0)
+		setupRenderTarget(rendTarget);
+}
+//---------------------------------------------------------------------
+void CompositorInstance::freeLocalTexture(const String &name)
+{
+	LocalTextureMap::iterator i = mLocalTextures.find(name);
+	if (i == mLocalTextures.end())
+		return;
+
+	PooledTextureSet::iterator p = mPooledTextures.find(name);
+	if (p != mPooledTextures.end())
+		mPooledTextures.erase(p);
+	else
+		TextureManager::getSingleton().remove(i->second->getName());
+	mLocalTextures.erase(i);
+}
+//---------------------------------------------------------------------
+void CompositorInstance::setupRenderTarget(RenderTarget *rendTarget)
+{
+    /// Set up viewport over entire texture
+    rendTarget->setAutoUpdated( false );
+
+    Camera* camera = mChain->getViewport()->getCamera();
+
+    // Save last viewport and current aspect ratio
+    Viewport* oldViewport = camera->getViewport();
+    Real aspectRatio = camera->getAspectRatio();
+
+    Viewport* v = rendTarget->addViewport( camera );
+    v->setClearEveryFrame( false );
+    v->setOverlaysEnabled( false );
+    v->setBackgroundColour( ColourValue( 0, 0, 0, 0 ) );
+
+    // Should restore aspect ratio, in case of auto aspect ratio
+    // enabled, it'll changed when add new viewport.
+    camera->setAspectRatio(aspectRatio);
+    // Should restore last viewport, i.e. never disturb user code
+    // which might based on that.
+    camera->_notifyViewport(oldViewport);
+}
+//---------------------------------------------------------------------
+void CompositorInstance::getTextureParams(const CompositionTechnique::TextureDefinition *def,
+	size_t &width, size_t &height, uint &fsaa, bool &hwGammaWrite)
+{
+    width = def->width;
+    height = def->height;
+	fsaa = 0;
+	hwGammaWrite = false;
+
+	deriveTextureRenderTargetOptions(def->name, &hwGammaWrite, &fsaa);
+
+    if(width == 0)
+        width = static_cast<size_t>(
+			static_cast<float>(mChain->getViewport()->getActualWidth()) * def->widthFactor);
+    if(height == 0)
+		height = static_cast<size_t>(
+			static_cast<float>(mChain->getViewport()->getActualHeight()) * def->heightFactor);
+}
+//---------------------------------------------------------------------
 void CompositorInstance::deriveTextureRenderTargetOptions(
 	const String& texname, bool *hwGammaWrite, uint *fsaa)
 {
@@ -585,9 +643,12 @@ void CompositorInstance::freeResources()
     LocalTextureMap::iterator i, iend=mLocalTextures.end();
     for(i=mLocalTextures.begin(); i!=iend; ++i)
     {
-        TextureManager::getSingleton().remove(i->second->getName());
+        /// Pooled textures belong to the CompositorManager
+        if(mPooledTextures.find(i->first) == mPooledTextures.end())
+            TextureManager::getSingleton().remove(i->second->getName());
     }
     mLocalTextures.clear();
+    mPooledTextures.clear();
 
 	// Remove MRTs
 	LocalMRTMap::iterator mrti, mrtend = mLocalMRTs.end();
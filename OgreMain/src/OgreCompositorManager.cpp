@@ -34,6 +34,9 @@ Torus Knot Software Ltd.
 #include "OgreCompositionTargetPass.h"
 #include "OgreCompositionTechnique.h"
 #include "OgreRoot.h"
+#include "OgreTextureManager.h"
+#include "OgreHardwarePixelBuffer.h"
+#include "OgreStringConverter.h"
 
 namespace Ogre {
 
@@ -47,7 +50,7 @@ CompositorManager& CompositorManager::getSingleton(void)
 	assert( ms_Singleton );  return ( *ms_Singleton );  
 }//-----------------------------------------------------------------------
 CompositorManager::CompositorManager():
-	mRectangle(0)
+	mRectangle(0), mPooledTextureCount(0), mRenderTargetPoolingEnabled(false)
 {
 	initialise();
 
@@ -73,6 +76,7 @@ CompositorManager::CompositorManager():
 CompositorManager::~CompositorManager()
 {
     freeChains();
+	freePooledTextures(false);
 	delete mRectangle;
 
 	OGRE_THREAD_POINTER_DELETE(mSerializer);
@@ -183,6 +187,7 @@ void CompositorManager::removeCompositorChain(Viewport *vp)
 void CompositorManager::removeAll(void)
 {
 	freeChains();
+	freePooledTextures(false);
 	ResourceManager::removeAll();
 }
 //-----------------------------------------------------------------------
@@ -252,6 +257,9 @@ void CompositorManager::setCompositorEnabled(Viewport *vp, const String &composi
 //---------------------------------------------------------------------
 void CompositorManager::_reconstructAllCompositorResources()
 {
+	// Free the resources of all instances first, so that the pool can be 
+	// recreated too
+	std::vector<CompositorInstance*> instances;
 	for (Chains::iterator i = mChains.begin(); i != mChains.end(); ++i)
 	{
 		CompositorChain* chain = i->second;
@@ -262,10 +270,91 @@ void CompositorManager::_reconstructAllCompositorResources()
 			if (inst->getEnabled())
 			{
 				inst->setEnabled(false);
-				inst->setEnabled(true);
+				instances.push_back(inst);
 			}
 		}
 	}
+
+	freePooledTextures(true);
+
+	for (std::vector<CompositorInstance*>::iterator i = instances.begin(); 
+		i != instances.end(); ++i)
+	{
+		(*i)->setEnabled(true);
+	}
+}
+//---------------------------------------------------------------------
+void CompositorManager::setRenderTargetPoolingEnabled(bool enabled)
+{
+	if (mRenderTargetPoolingEnabled != enabled)
+	{
+		mRenderTargetPoolingEnabled = enabled;
+		// Instances create different resources with pooling enabled
+		_reconstructAllCompositorResources();
+	}
+}
+//---------------------------------------------------------------------
+bool CompositorManager::PooledTextureKey::operator<(const PooledTextureKey& rhs) const
+{
+	if (width != rhs.width)
+		return width < rhs.width;
+	if (height != rhs.height)
+		return height < rhs.height;
+	if (format != rhs.format)
+		return format < rhs.format;
+	if (fsaa != rhs.fsaa)
+		return fsaa < rhs.fsaa;
+	return hwGammaWrite < rhs.hwGammaWrite;
+}
+//---------------------------------------------------------------------
+TexturePtr CompositorManager::_getPooledTexture(size_t width, size_t height, 
+	PixelFormat format, uint fsaa, bool hwGammaWrite, size_t index)
+{
+	PooledTextureKey key;
+	key.width = width;
+	key.height = height;
+	key.format = format;
+	key.fsaa = fsaa;
+	key.hwGammaWrite = hwGammaWrite;
+
+	PooledTextureList& textures = mTexturePool[key];
+	if (textures.size() <= index)
+		textures.resize(index + 1);
+
+	TexturePtr& tex = textures[index];
+	if (tex.isNull())
+	{
+		tex = TextureManager::getSingleton().createManual(
+			"CompositorPool/" + StringConverter::toString(mPooledTextureCount++),
+			ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME, TEX_TYPE_2D, 
+			(uint)width, (uint)height, 0, format, TU_RENDERTARGET, 0,
+			hwGammaWrite, fsaa);
+		tex->getBuffer()->getRenderTarget()->setAutoUpdated(false);
+	}
+	return tex;
+}
+//---------------------------------------------------------------------
+void CompositorManager::freePooledTextures(bool onlyIfUnreferenced)
+{
+	TextureManager* texMgr = TextureManager::getSingletonPtr();
+	for (TexturePool::iterator i = mTexturePool.begin(); i != mTexturePool.end(); ++i)
+	{
+		PooledTextureList& textures = i->second;
+		for (PooledTextureList::iterator t = textures.begin(); t != textures.end(); ++t)
+		{
+			// Referenced by the resource system and the pool only?
+			if (!t->isNull() && (!onlyIfUnreferenced || 
+				t->useCount() == ResourceGroupManager::RESOURCE_SYSTEM_NUM_REFERENCE_COUNTS + 1))
+			{
+				if (texMgr)
+					texMgr->remove((*t)->getName());
+				t->setNull();
+			}
+		}
+		// Drop the unused textures at the end of the list
+		while (!textures.empty() && textures.back().isNull())
+			textures.pop_back();
+	}
 }
 
 }
@@ -31,6 +31,16 @@ Torus Knot Software Ltd.
 #include "OgreLogManager.h"
 #include "OgreException.h"
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#   include <windows.h>
+#else
+#   include <sys/types.h>
+#   include <sys/stat.h>
+#   include <sys/mman.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -385,6 +395,86 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
+    MappedFileDataStream::MappedFileDataStream(const String& name, 
+        const String& fileName)
+        : MemoryDataStream(name, 0, 0, false)
+    {
+        void* pMem = 0;
+        size_t size = 0;
+        bool mapped = false;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        HANDLE hFile = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+            0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+        if (hFile != INVALID_HANDLE_VALUE)
+        {
+            size = static_cast<size_t>(GetFileSize(hFile, 0));
+            // Empty files cannot be mapped, but are still valid streams
+            mapped = (size == 0);
+            if (size)
+            {
+                HANDLE hMapping = CreateFileMapping(hFile, 0, PAGE_READONLY, 0, 0, 0);
+                if (hMapping)
+                {
+                    // The view keeps the mapping alive, so the handles can go
+                    pMem = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+                    mapped = (pMem != 0);
+                    CloseHandle(hMapping);
+                }
+            }
+            CloseHandle(hFile);
+        }
+#else
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd != -1)
+        {
+            struct stat tagStat;
+            if (fstat(fd, &tagStat) == 0)
+            {
+                size = static_cast<size_t>(tagStat.st_size);
+                mapped = (size == 0);
+                if (size)
+                {
+                    // The mapping outlives the descriptor
+                    pMem = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    mapped = (pMem != MAP_FAILED);
+                    if (!mapped)
+                        pMem = 0;
+                }
+            }
+            ::close(fd);
+        }
+#endif
+        if (!mapped)
+        {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot map file: " + fileName,
+                "MappedFileDataStream::MappedFileDataStream");
+        }
+
+        mData = mPos = static_cast<uchar*>(pMem);
+        mSize = size;
+        mEnd = mData + mSize;
+    }
+    //-----------------------------------------------------------------------
+    MappedFileDataStream::~MappedFileDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    void MappedFileDataStream::close(void)
+    {
+        if (mData)
+        {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+            UnmapViewOfFile(mData);
+#else
+            munmap(mData, mSize);
+#endif
+            mData = mPos = mEnd = 0;
+        }
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
     FileStreamDataStream::FileStreamDataStream(std::ifstream* s, bool freeOnClose)
         : DataStream(), mpStream(s), mFreeOnClose(freeOnClose)
     {
@@ -30,8 +30,62 @@ Torus Knot Software Ltd.
 #include "OgreSceneManager.h"
 #include "OgreEntity.h"
 #include "OgreRoot.h"
+#include "OgreSceneQueryBVH.h"
+#include "OgreWorkerThreadPool.h"
 
 namespace Ogre {
+
+	namespace
+	{
+		/// Listener gathering the results for one ray of a batch
+		class RayResultCollector : public RaySceneQueryListener
+		{
+		protected:
+			RaySceneQueryResult& mResult;
+		public:
+			RayResultCollector(RaySceneQueryResult& result) : mResult(result) {}
+			bool queryResult(MovableObject* obj, Real distance)
+			{
+				RaySceneQueryResultEntry dets;
+				dets.distance = distance;
+				dets.movable = obj;
+				dets.worldFragment = NULL;
+				mResult.push_back(dets);
+				return true;
+			}
+			bool queryResult(SceneQuery::WorldFragment* fragment, Real distance)
+			{
+				return true;
+			}
+		};
+
+		/// Task which traces a range of the rays of a batch through the hierarchy
+		class RayBatchTask : public WorkerThreadPool::Task
+		{
+		protected:
+			const SceneQueryBVH* mBVH;
+			const RayList* mRays;
+			RaySceneQueryResultList* mResults;
+			size_t mBegin, mEnd;
+			uint32 mQueryMask, mTypeMask;
+		public:
+			RayBatchTask(const SceneQueryBVH* bvh, const RayList* rays, 
+				RaySceneQueryResultList* results, size_t begin, size_t end, 
+				uint32 queryMask, uint32 typeMask)
+				: mBVH(bvh), mRays(rays), mResults(results), mBegin(begin), mEnd(end),
+				mQueryMask(queryMask), mTypeMask(typeMask) {}
+			void execute(void)
+			{
+				for (size_t i = mBegin; i != mEnd; ++i)
+				{
+					RaySceneQueryResult& result = (*mResults)[i];
+					result.clear();
+					RayResultCollector collector(result);
+					mBVH->rayQuery((*mRays)[i], mQueryMask, mTypeMask, &collector);
+				}
+			}
+		};
+	}
 	//---------------------------------------------------------------------
 	DefaultIntersectionSceneQuery::DefaultIntersectionSceneQuery(SceneManager* creator)
 	: IntersectionSceneQuery(creator)
@@ -136,6 +190,13 @@ namespace Ogre {
 	//---------------------------------------------------------------------
 	void DefaultAxisAlignedBoxSceneQuery::execute(SceneQueryListener* listener)
 	{
+		SceneQueryBVH* bvh = mParentSceneMgr->_getSceneQueryBVH();
+		if (bvh)
+		{
+			bvh->boxQuery(mAABB, mQueryMask, mQueryTypeMask, listener);
+			return;
+		}
+
 		// Iterate over all movable types
 		Root::MovableObjectFactoryIterator factIt = 
 			Root::getSingleton().getMovableObjectFactoryIterator();
@@ -179,6 +240,12 @@ namespace Ogre {
 		// requested; smarter scene manager queries can utilise the paritioning 
 		// of the scene in order to reduce the number of intersection tests 
 		// required to fulfil the query
+		SceneQueryBVH* bvh = mParentSceneMgr->_getSceneQueryBVH();
+		if (bvh)
+		{
+			bvh->rayQuery(mRay, mQueryMask, mQueryTypeMask, listener);
+			return;
+		}
 
 		// Iterate over all movable types
 		Root::MovableObjectFactoryIterator factIt = 
@@ -212,6 +279,57 @@ namespace Ogre {
 
 	}
 	//---------------------------------------------------------------------
+	void DefaultRaySceneQuery::executeBatch(const RayList& rays, 
+		RaySceneQueryResultList& results)
+	{
+		SceneQueryBVH* bvh = mParentSceneMgr->_getSceneQueryBVH();
+		if (!bvh || mWorldFragmentType != SceneQuery::WFT_NONE)
+		{
+			// Subclasses may add world geometry, so go through execute
+			RaySceneQuery::executeBatch(rays, results);
+			return;
+		}
+
+		results.resize(rays.size());
+		mResult.clear();
+
+		WorkerThreadPool* pool = WorkerThreadPool::getSingletonPtr();
+		if (pool && pool->isParallel() && rays.size() >= PARALLEL_RAY_BATCH_MIN_RAYS)
+		{
+			// Aim for a few tasks per thread so that uneven ones balance out
+			const size_t targetTasks = (pool->getNumWorkerThreads() + 1) * 4;
+			size_t taskRays = (rays.size() + targetTasks - 1) / targetTasks;
+			if (taskRays < PARALLEL_RAY_BATCH_MIN_RAYS)
+				taskRays = PARALLEL_RAY_BATCH_MIN_RAYS;
+			const size_t numTasks = (rays.size() + taskRays - 1) / taskRays;
+
+			std::vector<RayBatchTask> tasks;
+			tasks.reserve(numTasks);
+			WorkerThreadPool::TaskList taskList;
+			taskList.reserve(numTasks);
+			for (size_t begin = 0; begin < rays.size(); begin += taskRays)
+			{
+				size_t end = std::min(begin + taskRays, rays.size());
+				tasks.push_back(RayBatchTask(bvh, &rays, &results, begin, end,
+					mQueryMask, mQueryTypeMask));
+				taskList.push_back(&tasks.back());
+			}
+			pool->executeTasks(taskList);
+		}
+		else
+		{
+			RayBatchTask(bvh, &rays, &results, 0, rays.size(), 
+				mQueryMask, mQueryTypeMask).execute();
+		}
+
+		// Triangle tests may build mesh hierarchies, so are done serially
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			refineResults(rays[i], results[i]);
+			sortResults(results[i]);
+		}
+	}
+	//---------------------------------------------------------------------
 	DefaultSphereSceneQuery::
 	DefaultSphereSceneQuery(SceneManager* creator) : SphereSceneQuery(creator)
 	{
@@ -225,6 +343,13 @@ namespace Ogre {
 	//---------------------------------------------------------------------
 	void DefaultSphereSceneQuery::execute(SceneQueryListener* listener)
 	{
+		SceneQueryBVH* bvh = mParentSceneMgr->_getSceneQueryBVH();
+		if (bvh)
+		{
+			bvh->sphereQuery(mSphere, mQueryMask, mQueryTypeMask, listener, true);
+			return;
+		}
+
 		Sphere testSphere;
 
 		// Iterate over all movable types
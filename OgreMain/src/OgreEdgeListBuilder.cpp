@@ -33,6 +33,7 @@ Torus Knot Software Ltd.
 #include "OgreVertexIndexData.h"
 #include "OgreException.h"
 #include "OgreOptimisedUtil.h"
+#include "OgreWorkerThreadPool.h"
 
 namespace Ogre {
 
@@ -77,7 +78,7 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     EdgeListBuilder::EdgeListBuilder()
-        : mEdgeData(0)
+        : mEdgeData(0), mEdgeBucketsUsed(0), mNumPendingEdges(0)
     {
     }
     //---------------------------------------------------------------------
@@ -117,6 +118,58 @@ namespace Ogre {
         mGeometryList.push_back(geometry);
     }
     //---------------------------------------------------------------------
+    namespace
+    {
+        /** Hashes a position for the common vertex hash table, so that the
+            positions which compare equal hash alike.
+        */
+        uint32 hashPosition(const Vector3& vec)
+        {
+            // -0 compares equal to 0, so hash both as 0
+            Real coords[3] = { vec.x == 0 ? 0 : vec.x, vec.y == 0 ? 0 : vec.y, 
+                vec.z == 0 ? 0 : vec.z };
+            // FNV-1a
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(coords);
+            uint32 hash = 2166136261U;
+            for (size_t i = 0; i < sizeof(coords); ++i)
+            {
+                hash = (hash ^ bytes[i]) * 16777619U;
+            }
+            return hash;
+        }
+        //---------------------------------------------------------------------
+        /// Hashes the pair of common vertices of an edge for the edge hash table
+        size_t hashEdge(size_t sharedVertIndex0, size_t sharedVertIndex1)
+        {
+            return (sharedVertIndex0 * 73856093U) ^ (sharedVertIndex1 * 19349663U);
+        }
+
+        const size_t NO_INDEX = static_cast<size_t>(~0);
+    }
+    //---------------------------------------------------------------------
+    class EdgeListBuilder::ReadTrianglesTask : public WorkerThreadPool::Task
+    {
+    protected:
+        const Geometry* mGeometry;
+        const VertexElement* mPosElem;
+        size_t mVertexSize;
+        const unsigned char* mBaseVertex;
+        const void* mIndex;
+        size_t mFirst, mCount;
+        TriangleSource* mDest;
+    public:
+        ReadTrianglesTask(const Geometry& geometry, const VertexElement* posElem,
+            size_t vertexSize, const unsigned char* pBaseVertex, const void* pIndex,
+            size_t first, size_t count, TriangleSource* dest)
+            : mGeometry(&geometry), mPosElem(posElem), mVertexSize(vertexSize),
+            mBaseVertex(pBaseVertex), mIndex(pIndex), mFirst(first), mCount(count), mDest(dest) {}
+        void execute(void)
+        {
+            EdgeListBuilder::readTriangles(*mGeometry, mPosElem, mVertexSize, 
+                mBaseVertex, mIndex, mFirst, mCount, mDest);
+        }
+    };
+    //---------------------------------------------------------------------
     EdgeData* EdgeListBuilder::build(void)
     {
         /* Ok, here's the algorithm:
@@ -187,98 +240,140 @@ namespace Ogre {
             mEdgeData->edgeGroups[vSet].triCount = 0;
         }
 
-        // Build triangles and edge list
-        GeometryList::const_iterator i, iend;
-        iend = mGeometryList.end();
-        for (i = mGeometryList.begin(); i != iend; ++i)
+        // Lock the position and index buffers of all geometries for reading
+        // up front, so that the triangles can be read in parallel. Buffers used
+        // by several geometries are only locked once.
+        typedef std::map<HardwareBuffer*, unsigned char*> LockedBufferMap;
+        LockedBufferMap lockedBuffers;
+        size_t numGeometries = mGeometryList.size();
+        std::vector<const VertexElement*> posElems(numGeometries);
+        std::vector<size_t> vertexSizes(numGeometries);
+        std::vector<const unsigned char*> baseVertices(numGeometries);
+        std::vector<const unsigned char*> indexes(numGeometries);
+        size_t totalTriangles = 0;
+        for (size_t g = 0; g < numGeometries; ++g)
         {
-            buildTrianglesEdges(*i);
+            const Geometry& geometry = mGeometryList[g];
+
+		    // locate position element & the buffer to go with it
+            const VertexData* vertexData = mVertexDataList[geometry.vertexSet];
+		    posElems[g] = vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+		    HardwareVertexBuffer* vbuf = 
+			    vertexData->vertexBufferBinding->getBuffer(posElems[g]->getSource()).get();
+            vertexSizes[g] = vbuf->getVertexSize();
+
+            HardwareIndexBuffer* ibuf = geometry.indexData->indexBuffer.get();
+            HardwareBuffer* buffers[2] = { vbuf, ibuf };
+            unsigned char* locked[2];
+            for (size_t b = 0; b < 2; ++b)
+            {
+                LockedBufferMap::iterator l = lockedBuffers.find(buffers[b]);
+                if (l == lockedBuffers.end())
+                {
+                    l = lockedBuffers.insert(LockedBufferMap::value_type(buffers[b], 
+                        static_cast<unsigned char*>(buffers[b]->lock(HardwareBuffer::HBL_READ_ONLY)))).first;
+                }
+                locked[b] = l->second;
+            }
+            baseVertices[g] = locked[0];
+            indexes[g] = locked[1] + geometry.indexData->indexStart * ibuf->getIndexSize();
+
+            totalTriangles += getTriangleCount(geometry);
+        }
+
+        // Read the triangles across the worker threads if it's worth it; only
+        // triangle lists can be split up, strips and fans are read whole
+        std::vector<TriangleSourceList> triangles(numGeometries);
+        WorkerThreadPool* pool = WorkerThreadPool::getSingletonPtr();
+        bool parallel = pool && pool->isParallel() && 
+            totalTriangles >= PARALLEL_BUILD_MIN_TRIANGLES;
+        if (parallel)
+        {
+            const size_t chunkSize = std::max(totalTriangles / ((pool->getNumWorkerThreads() + 1) * 4),
+                static_cast<size_t>(1024));
+            std::vector<ReadTrianglesTask> tasks;
+            tasks.reserve(totalTriangles / chunkSize + numGeometries);
+            WorkerThreadPool::TaskList taskList;
+            taskList.reserve(totalTriangles / chunkSize + numGeometries);
+            for (size_t g = 0; g < numGeometries; ++g)
+            {
+                const Geometry& geometry = mGeometryList[g];
+                size_t count = getTriangleCount(geometry);
+                triangles[g].resize(count);
+                size_t step = geometry.opType == RenderOperation::OT_TRIANGLE_LIST ? chunkSize : count;
+                for (size_t first = 0; first < count; first += step)
+                {
+                    tasks.push_back(ReadTrianglesTask(geometry, posElems[g], vertexSizes[g],
+                        baseVertices[g], indexes[g], first, std::min(step, count - first),
+                        &triangles[g][first]));
+                    taskList.push_back(&tasks.back());
+                }
+            }
+            pool->executeTasks(taskList);
+        }
+
+        // Build triangles and edge list, in order
+        for (size_t g = 0; g < numGeometries; ++g)
+        {
+            const Geometry& geometry = mGeometryList[g];
+            if (!parallel)
+            {
+                size_t count = getTriangleCount(geometry);
+                triangles[g].resize(count);
+                if (count)
+                    readTriangles(geometry, posElems[g], vertexSizes[g], 
+                        baseVertices[g], indexes[g], 0, count, &triangles[g][0]);
+            }
+            buildTrianglesEdges(geometry, triangles[g]);
+            // Done with these
+            TriangleSourceList().swap(triangles[g]);
+        }
+
+        for (LockedBufferMap::iterator l = lockedBuffers.begin(); l != lockedBuffers.end(); ++l)
+        {
+            l->first->unlock();
         }
 
         // Allocate memory for light facing calculate
         mEdgeData->triangleLightFacings.resize(mEdgeData->triangles.size());
 
         // Record closed, ie the mesh is manifold
-        mEdgeData->isClosed = mEdgeMap.empty();
+        mEdgeData->isClosed = mNumPendingEdges == 0;
 
         return mEdgeData;
     }
     //---------------------------------------------------------------------
-    void EdgeListBuilder::buildTrianglesEdges(const Geometry &geometry)
+    size_t EdgeListBuilder::getTriangleCount(const Geometry &geometry)
     {
-        size_t indexSet = geometry.indexSet;
-        size_t vertexSet = geometry.vertexSet;
-        const IndexData* indexData = geometry.indexData;
-        RenderOperation::OperationType opType = geometry.opType;
-
-        size_t iterations;
-        
-        switch (opType)
+        switch (geometry.opType)
         {
         case RenderOperation::OT_TRIANGLE_LIST:
-            iterations = indexData->indexCount / 3;
-            break;
+            return geometry.indexData->indexCount / 3;
         case RenderOperation::OT_TRIANGLE_FAN:
         case RenderOperation::OT_TRIANGLE_STRIP:
-            iterations = indexData->indexCount - 2;
-            break;
+            return geometry.indexData->indexCount >= 3 ? geometry.indexData->indexCount - 2 : 0;
         default:
-            return; // Just in case
+            return 0; // Just in case
         };
-
-        // The edge group now we are dealing with.
-        EdgeData::EdgeGroup& eg = mEdgeData->edgeGroups[vertexSet];
-
-		// locate position element & the buffer to go with it
-        const VertexData* vertexData = mVertexDataList[vertexSet];
-		const VertexElement* posElem = vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
-		HardwareVertexBufferSharedPtr vbuf = 
-			vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
-		// lock the buffer for reading
-		unsigned char* pBaseVertex = static_cast<unsigned char*>(
-			vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    }
+    //---------------------------------------------------------------------
+    void EdgeListBuilder::readTriangles(const Geometry &geometry, const VertexElement* posElem,
+        size_t vertexSize, const unsigned char* pBaseVertex, const void* pIndex,
+        size_t first, size_t count, TriangleSource* dest)
+    {
+        RenderOperation::OperationType opType = geometry.opType;
+        assert((opType == RenderOperation::OT_TRIANGLE_LIST || first == 0) &&
+            "Strips and fans can only be read from the start");
 
         // Get the indexes ready for reading
-		bool idx32bit = (indexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT);
-		size_t indexSize = idx32bit ? sizeof(uint32) : sizeof(uint16);
-#if defined(_MSC_VER) && _MSC_VER <= 1300
-        // NB: Can't use un-named union with VS.NET 2002 when /RTC1 compile flag enabled.
-        void* pIndex = indexData->indexBuffer->lock(HardwareBuffer::HBL_READ_ONLY);
-		pIndex = static_cast<void*>(
-			static_cast<char*>(pIndex) + indexData->indexStart * indexSize);
-        unsigned short* p16Idx = static_cast<unsigned short*>(pIndex);
-        unsigned int* p32Idx = static_cast<unsigned int*>(pIndex);
-#else
-        union {
-            void* pIndex;
-            unsigned short* p16Idx;
-            unsigned int* p32Idx;
-        };
-        pIndex = indexData->indexBuffer->lock(HardwareBuffer::HBL_READ_ONLY);
-		pIndex = static_cast<void*>(
-			static_cast<char*>(pIndex) + indexData->indexStart * indexSize);
-#endif
+		bool idx32bit = (geometry.indexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT);
+        const unsigned short* p16Idx = static_cast<const unsigned short*>(pIndex) + first * 3;
+        const unsigned int* p32Idx = static_cast<const unsigned int*>(pIndex) + first * 3;
 
         // Iterate over all the groups of 3 indexes
         unsigned int index[3];
-        // Get the triangle start, if we have more than one index set then this
-        // will not be zero
-        size_t triangleIndex = mEdgeData->triangles.size();
-        // If it's first time dealing with the edge group, setup triStart for it.
-        // Note that we are assume geometries sorted by vertex set.
-        if (!eg.triCount)
-        {
-            eg.triStart = triangleIndex;
-        }
-        // Pre-reserve memory for less thrashing
-        mEdgeData->triangles.reserve(triangleIndex + iterations);
-        mEdgeData->triangleFaceNormals.reserve(triangleIndex + iterations);
-        for (size_t t = 0; t < iterations; ++t)
+        for (size_t t = first; t < first + count; ++t, ++dest)
         {
-            EdgeData::Triangle tri;
-            tri.indexSet = indexSet;
-            tri.vertexSet = vertexSet;
-
             if (opType == RenderOperation::OT_TRIANGLE_LIST || t == 0)
             {
                 // Standard 3-index read for tri list or first tri in strip / fan
@@ -313,22 +408,61 @@ namespace Ogre {
                     index[2] = *p16Idx++;
             }
 
-            Vector3 v[3];
             for (size_t i = 0; i < 3; ++i)
             {
-                // Populate tri original vertex index
-                tri.vertIndex[i] = index[i];
+                dest->vertIndex[i] = index[i];
 
                 // Retrieve the vertex position
-                unsigned char* pVertex = pBaseVertex + (index[i] * vbuf->getVertexSize());
+                unsigned char* pVertex = const_cast<unsigned char*>(pBaseVertex) + (index[i] * vertexSize);
                 float* pFloat;
                 posElem->baseVertexPointerToElement(pVertex, &pFloat);
-                v[i].x = *pFloat++;
-                v[i].y = *pFloat++;
-                v[i].z = *pFloat++;
+                dest->position[i].x = *pFloat++;
+                dest->position[i].y = *pFloat++;
+                dest->position[i].z = *pFloat++;
+                dest->positionHash[i] = hashPosition(dest->position[i]);
+            }
+
+            // Calculate triangle normal (NB will require recalculation for 
+            // skeletally animated meshes)
+            dest->faceNormal = Math::calculateFaceNormalWithoutNormalize(
+                dest->position[0], dest->position[1], dest->position[2]);
+        }
+    }
+    //---------------------------------------------------------------------
+    void EdgeListBuilder::buildTrianglesEdges(const Geometry &geometry, 
+        const TriangleSourceList &triangles)
+    {
+        size_t indexSet = geometry.indexSet;
+        size_t vertexSet = geometry.vertexSet;
+
+        // The edge group now we are dealing with.
+        EdgeData::EdgeGroup& eg = mEdgeData->edgeGroups[vertexSet];
+
+        // Get the triangle start, if we have more than one index set then this
+        // will not be zero
+        size_t triangleIndex = mEdgeData->triangles.size();
+        // If it's first time dealing with the edge group, setup triStart for it.
+        // Note that we are assume geometries sorted by vertex set.
+        if (!eg.triCount)
+        {
+            eg.triStart = triangleIndex;
+        }
+        // Pre-reserve memory for less thrashing
+        mEdgeData->triangles.reserve(triangleIndex + triangles.size());
+        mEdgeData->triangleFaceNormals.reserve(triangleIndex + triangles.size());
+        for (TriangleSourceList::const_iterator src = triangles.begin(); src != triangles.end(); ++src)
+        {
+            EdgeData::Triangle tri;
+            tri.indexSet = indexSet;
+            tri.vertexSet = vertexSet;
+
+            for (size_t i = 0; i < 3; ++i)
+            {
+                // Populate tri original vertex index
+                tri.vertIndex[i] = src->vertIndex[i];
                 // find this vertex in the existing vertex map, or create it
-                tri.sharedVertIndex[i] = 
-                    findOrCreateCommonVertex(v[i], vertexSet, indexSet, index[i]);
+                tri.sharedVertIndex[i] = findOrCreateCommonVertex(src->position[i], 
+                    src->positionHash[i], vertexSet, indexSet, src->vertIndex[i]);
             }
 
             // Ignore degenerate triangle
@@ -336,10 +470,7 @@ namespace Ogre {
                 tri.sharedVertIndex[1] != tri.sharedVertIndex[2] &&
                 tri.sharedVertIndex[2] != tri.sharedVertIndex[0])
             {
-                // Calculate triangle normal (NB will require recalculation for 
-                // skeletally animated meshes)
-                mEdgeData->triangleFaceNormals.push_back(
-                    Math::calculateFaceNormalWithoutNormalize(v[0], v[1], v[2]));
+                mEdgeData->triangleFaceNormals.push_back(src->faceNormal);
                 // Add triangle to list
                 mEdgeData->triangles.push_back(tri);
                 // Connect or create edges from common list
@@ -359,9 +490,6 @@ namespace Ogre {
         // Update triCount for the edge group. Note that we are assume
         // geometries sorted by vertex set.
         eg.triCount = triangleIndex - eg.triStart;
-
-        indexData->indexBuffer->unlock();
-        vbuf->unlock();
     }
     //---------------------------------------------------------------------
     void EdgeListBuilder::connectOrCreateEdge(size_t vertexSet, size_t triangleIndex, 
@@ -369,24 +497,47 @@ namespace Ogre {
         size_t sharedVertIndex1)
     {
         // Find the existing edge (should be reversed order) on shared vertices
-        EdgeMap::iterator emi = mEdgeMap.find(std::pair<size_t, size_t>(sharedVertIndex1, sharedVertIndex0));
-        if (emi != mEdgeMap.end())
+        EdgeBucket& reverse = findEdgeBucket(sharedVertIndex1, sharedVertIndex0);
+        if (reverse.head != NO_INDEX)
         {
-            // The edge already exist, connect it
-            EdgeData::Edge& e = mEdgeData->edgeGroups[emi->second.first].edges[emi->second.second];
+            // The edge already exist, connect the oldest one
+            PendingEdge& pending = mPendingEdges[reverse.head];
+            EdgeData::Edge& e = mEdgeData->edgeGroups[pending.vertexSet].edges[pending.edgeIndex];
             // update with second side
             e.triIndex[1] = triangleIndex;
             e.degenerate = false;
 
-            // Remove from the edge map, so we never supplied to connect edge again
-            mEdgeMap.erase(emi);
+            // Remove from the queue, so we never supplied to connect edge again
+            reverse.head = pending.next;
+            if (reverse.head == NO_INDEX)
+                reverse.tail = NO_INDEX;
+            --mNumPendingEdges;
         }
         else
         {
             // Not found, create new edge
-            mEdgeMap.insert(EdgeMap::value_type(
-                std::pair<size_t, size_t>(sharedVertIndex0, sharedVertIndex1),
-                std::pair<size_t, size_t>(vertexSet, mEdgeData->edgeGroups[vertexSet].edges.size())));
+            if ((mEdgeBucketsUsed + 1) * 2 > mEdgeHash.size())
+                growEdgeHash();
+            EdgeBucket& bucket = findEdgeBucket(sharedVertIndex0, sharedVertIndex1);
+            if (bucket.sharedVertIndex[0] == NO_INDEX)
+            {
+                bucket.sharedVertIndex[0] = sharedVertIndex0;
+                bucket.sharedVertIndex[1] = sharedVertIndex1;
+                ++mEdgeBucketsUsed;
+            }
+            PendingEdge pending;
+            pending.vertexSet = vertexSet;
+            pending.edgeIndex = mEdgeData->edgeGroups[vertexSet].edges.size();
+            pending.next = NO_INDEX;
+            size_t pendingIndex = mPendingEdges.size();
+            mPendingEdges.push_back(pending);
+            if (bucket.tail != NO_INDEX)
+                mPendingEdges[bucket.tail].next = pendingIndex;
+            else
+                bucket.head = pendingIndex;
+            bucket.tail = pendingIndex;
+            ++mNumPendingEdges;
+
             EdgeData::Edge e;
             e.degenerate = true; // initialise as degenerate
 
@@ -401,19 +552,61 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
-    size_t EdgeListBuilder::findOrCreateCommonVertex(const Vector3& vec, 
+    EdgeListBuilder::EdgeBucket& EdgeListBuilder::findEdgeBucket(
+        size_t sharedVertIndex0, size_t sharedVertIndex1)
+    {
+        if (mEdgeHash.empty())
+            growEdgeHash();
+
+        // Linear probing; buckets are never removed, so the first empty
+        // bucket ends the search
+        size_t mask = mEdgeHash.size() - 1;
+        size_t b = hashEdge(sharedVertIndex0, sharedVertIndex1) & mask;
+        while (mEdgeHash[b].sharedVertIndex[0] != NO_INDEX &&
+            (mEdgeHash[b].sharedVertIndex[0] != sharedVertIndex0 ||
+            mEdgeHash[b].sharedVertIndex[1] != sharedVertIndex1))
+        {
+            b = (b + 1) & mask;
+        }
+        return mEdgeHash[b];
+    }
+    //---------------------------------------------------------------------
+    void EdgeListBuilder::growEdgeHash(void)
+    {
+        EdgeBucket empty;
+        empty.sharedVertIndex[0] = empty.sharedVertIndex[1] = NO_INDEX;
+        empty.head = empty.tail = NO_INDEX;
+
+        EdgeHash old(std::max(mEdgeHash.size() * 2, static_cast<size_t>(1024)), empty);
+        old.swap(mEdgeHash);
+        for (EdgeHash::iterator i = old.begin(); i != old.end(); ++i)
+        {
+            if (i->sharedVertIndex[0] != NO_INDEX)
+                findEdgeBucket(i->sharedVertIndex[0], i->sharedVertIndex[1]) = *i;
+        }
+    }
+    //---------------------------------------------------------------------
+    size_t EdgeListBuilder::findOrCreateCommonVertex(const Vector3& vec, uint32 hash,
         size_t vertexSet, size_t indexSet, size_t originalIndex)
     {
         // Because the algorithm doesn't care about manifold or not, we just identifying
         // the common vertex by EXACT same position.
         // Hint: We can use quantize method for welding almost same position vertex fastest.
-        std::pair<CommonVertexMap::iterator, bool> inserted =
-            mCommonVertexMap.insert(CommonVertexMap::value_type(vec, mVertices.size()));
-        if (!inserted.second)
+        if ((mVertices.size() + 1) * 2 > mCommonVertexHash.size())
+            growCommonVertexHash();
+
+        size_t mask = mCommonVertexHash.size() - 1;
+        size_t b = hash & mask;
+        while (mCommonVertexHash[b] != NO_INDEX)
         {
-            // Already existing, return old one
-            return inserted.first->second;
+            if (mVertices[mCommonVertexHash[b]].position == vec)
+            {
+                // Already existing, return old one
+                return mCommonVertexHash[b];
+            }
+            b = (b + 1) & mask;
         }
+
         // Not found, insert
         CommonVertex newCommon;
         newCommon.index = mVertices.size();
@@ -422,9 +615,24 @@ namespace Ogre {
         newCommon.indexSet = indexSet;
         newCommon.originalIndex = originalIndex;
         mVertices.push_back(newCommon);
+        mCommonVertexHash[b] = newCommon.index;
         return newCommon.index;
     }
     //---------------------------------------------------------------------
+    void EdgeListBuilder::growCommonVertexHash(void)
+    {
+        mCommonVertexHash.assign(std::max(mCommonVertexHash.size() * 2, 
+            static_cast<size_t>(1024)), NO_INDEX);
+        size_t mask = mCommonVertexHash.size() - 1;
+        for (CommonVertexList::iterator i = mVertices.begin(); i != mVertices.end(); ++i)
+        {
+            size_t b = hashPosition(i->position) & mask;
+            while (mCommonVertexHash[b] != NO_INDEX)
+                b = (b + 1) & mask;
+            mCommonVertexHash[b] = i->index;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     void EdgeData::updateTriangleLightFacing(const Vector4& lightPos)
     {
@@ -52,6 +52,9 @@ Torus Knot Software Ltd.
 #include "OgreAlignedAllocator.h"
 #include "OgreOptimisedUtil.h"
 #include "OgreSceneNode.h"
+#include "OgreProfiler.h"
+#include "OgreSoftwareSkinningBatch.h"
+#include "OgreMeshTriangleBVH.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -630,6 +633,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void Entity::updateAnimation(void)
     {
+		OgreProfileCapture("Entity::updateAnimation");
+
 		// Do nothing if not initialised yet
 		if (!mInitialised)
 			return;
@@ -639,8 +644,9 @@ namespace Ogre {
 		bool forcedSwAnimation = getSoftwareAnimationRequests()>0;
 		bool forcedNormals = getSoftwareAnimationNormalsRequests()>0;
 		bool stencilShadows = false;
-		if (getCastShadows() && hasEdgeList() && root._getCurrentSceneManager())
-			stencilShadows =  root._getCurrentSceneManager()->isShadowTechniqueStencilBased();
+		SceneManager* sceneMgr = root._getCurrentSceneManager();
+		if (getCastShadows() && hasEdgeList() && sceneMgr)
+			stencilShadows =  sceneMgr->isShadowTechniqueStencilBased();
 		bool softwareAnimation = !hwAnimation || stencilShadows || forcedSwAnimation;
 		// Blend normals in s/w only if we're not using h/w animation,
 		// since shadows only require positions
@@ -699,6 +705,9 @@ namespace Ogre {
 				if (softwareAnimation)
 				{
                     const Matrix4* blendMatrices[256];
+					// Leave the blends to the scene manager's batch if it's collecting them
+					SoftwareSkinningBatch* skinningBatch = 
+						sceneMgr ? sceneMgr->_getSoftwareSkinningBatch() : 0;
 
 					// Ok, we need to do a software blend
 					// Firstly, check out working vertex buffers
@@ -715,12 +724,21 @@ namespace Ogre {
                         Mesh::prepareMatricesForVertexBlend(blendMatrices,
                             mBoneMatrices, mMesh->sharedBlendIndexToBoneIndexMap);
 						// Blend, taking source from either mesh data or morph data
-						Mesh::softwareVertexBlend(
+						const VertexData* srcVertexData =
 							(mMesh->getSharedVertexDataAnimationType() != VAT_NONE) ?
-								mSoftwareVertexAnimVertexData :	mMesh->sharedVertexData,
-							mSkelAnimVertexData,
-							blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
-							blendNormals);
+								mSoftwareVertexAnimVertexData :	mMesh->sharedVertexData;
+						if (skinningBatch)
+						{
+							skinningBatch->addBlend(srcVertexData, mSkelAnimVertexData,
+								blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
+								blendNormals);
+						}
+						else
+						{
+							Mesh::softwareVertexBlend(srcVertexData, mSkelAnimVertexData,
+								blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
+								blendNormals);
+						}
 					}
 					SubEntityList::iterator i, iend;
 					iend = mSubEntityList.end();
@@ -737,12 +755,21 @@ namespace Ogre {
                             Mesh::prepareMatricesForVertexBlend(blendMatrices,
                                 mBoneMatrices, se->mSubMesh->blendIndexToBoneIndexMap);
 							// Blend, taking source from either mesh data or morph data
-							Mesh::softwareVertexBlend(
+							const VertexData* srcVertexData =
 								(se->getSubMesh()->getVertexAnimationType() != VAT_NONE)?
-									se->mSoftwareVertexAnimVertexData : se->mSubMesh->vertexData,
-								se->mSkelAnimVertexData,
-								blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
-								blendNormals);
+									se->mSoftwareVertexAnimVertexData : se->mSubMesh->vertexData;
+							if (skinningBatch)
+							{
+								skinningBatch->addBlend(srcVertexData, se->mSkelAnimVertexData,
+									blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
+									blendNormals);
+							}
+							else
+							{
+								Mesh::softwareVertexBlend(srcVertexData, se->mSkelAnimVertexData,
+									blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
+									blendNormals);
+							}
 						}
 
 					}
@@ -883,8 +910,8 @@ namespace Ogre {
             Animation* anim = msh->_getAnimationImpl(state->getAnimationName());
             if (anim)
             {
-                anim->apply(this, state->getTimePosition(), state->getWeight(),
-                    swAnim, hardwareAnimation);
+                anim->apply(this, anim->_getTimeIndex(state->getTimePosition(), 
+                    state->_getKeyFrameCursor(anim)), state->getWeight(), swAnim, hardwareAnimation);
             }
 		}
 		// Deal with cases where no animation applied
@@ -1274,6 +1301,63 @@ namespace Ogre {
         return rad;
     }
     //-----------------------------------------------------------------------
+    bool Entity::rayIntersectsTriangles(const Ray& worldRay, MeshTriangleHit& hit)
+    {
+        const MeshTriangleBVH* bvh = mMesh->getTriangleBVH();
+
+        // Bring the ray into object space; the direction is not normalised
+        // again so that distances along both rays are the same
+        Matrix4 invWorld = _getParentNodeFullTransform().inverseAffine();
+        Matrix3 invRotScale;
+        invWorld.extract3x3Matrix(invRotScale);
+        Ray ray(invWorld.transformAffine(worldRay.getOrigin()),
+            invRotScale * worldRay.getDirection());
+
+        // Find vertex data whose positions have been animated in software,
+        // indexed by the first of their vertices in the hierarchy's positions
+        typedef std::vector<std::pair<size_t, const VertexData*> > AnimatedDataList;
+        AnimatedDataList animated;
+        if (mMesh->sharedVertexData)
+        {
+            Entity::VertexDataBindChoice c = chooseVertexDataForBinding(
+                mMesh->getSharedVertexDataAnimationType() != VAT_NONE);
+            if ((c == BIND_SOFTWARE_SKELETAL && mTempSkelAnimInfo.buffersCheckedOut(true, false)) ||
+                (c == BIND_SOFTWARE_MORPH && mTempVertexAnimInfo.buffersCheckedOut(true, false)))
+            {
+                animated.push_back(AnimatedDataList::value_type(0, getVertexDataForBinding()));
+            }
+        }
+        for (ushort i = 0; i < mSubEntityList.size(); ++i)
+        {
+            SubEntity* sub = mSubEntityList[i];
+            if (sub->getSubMesh()->useSharedVertices)
+                continue;
+
+            Entity::VertexDataBindChoice c = chooseVertexDataForBinding(
+                sub->getSubMesh()->getVertexAnimationType() != VAT_NONE);
+            if ((c == BIND_SOFTWARE_SKELETAL && 
+                    sub->_getSkelAnimTempBufferInfo()->buffersCheckedOut(true, false)) ||
+                (c == BIND_SOFTWARE_MORPH && 
+                    sub->_getVertexAnimTempBufferInfo()->buffersCheckedOut(true, false)))
+            {
+                animated.push_back(AnimatedDataList::value_type(
+                    bvh->getSubMeshFirstVertex(i), sub->getVertexDataForBinding()));
+            }
+        }
+
+        if (animated.empty())
+        {
+            return bvh->intersect(ray, hit);
+        }
+
+        std::vector<Vector3> positions(bvh->getPositions());
+        for (AnimatedDataList::iterator i = animated.begin(); i != animated.end(); ++i)
+        {
+            MeshTriangleBVH::readPositions(i->second, &positions[i->first]);
+        }
+        return bvh->intersect(ray, positions, hit);
+    }
+    //-----------------------------------------------------------------------
     void Entity::prepareTempBlendBuffers(void)
     {
         if (mSkelAnimVertexData)
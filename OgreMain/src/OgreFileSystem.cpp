@@ -51,6 +51,7 @@ Torus Knot Software Ltd.
 namespace Ogre {
 
 	bool FileSystemArchive::ms_IgnoreHidden = true;
+	size_t FileSystemArchive::ms_MemoryMapThreshold = 0;
 
     //-----------------------------------------------------------------------
     FileSystemArchive::FileSystemArchive(const String& name, const String& archType )
@@ -202,6 +203,19 @@ namespace Ogre {
 	int ret = stat(full_path.c_str(), &tagStat);
         assert(ret == 0 && "Problem getting file size" );
 
+        if (ms_MemoryMapThreshold &&
+            static_cast<size_t>(tagStat.st_size) >= ms_MemoryMapThreshold)
+        {
+            try
+            {
+                return DataStreamPtr(new MappedFileDataStream(filename, full_path));
+            }
+            catch (Exception&)
+            {
+                // Not mappable (e.g. special file system), use a file stream
+            }
+        }
+
         // Always open in binary mode
         std::ifstream *origStream = new std::ifstream();
         origStream->open(full_path.c_str(), std::ios::in | std::ios::binary);
@@ -278,6 +292,17 @@ namespace Ogre {
 
 		return ret;
 	}
+    //-----------------------------------------------------------------------
+	time_t FileSystemArchive::getModifiedTime(const String& filename)
+	{
+        String full_path = concatenate_path(mName, filename);
+
+        struct stat tagStat;
+        if (stat(full_path.c_str(), &tagStat) != 0)
+            return 0;
+
+        return tagStat.st_mtime;
+	}
     //-----------------------------------------------------------------------
     const String& FileSystemArchiveFactory::getType(void) const
     {
@@ -42,6 +42,7 @@ Torus Knot Software Ltd.
 #include "OgreHardwareIndexBuffer.h"
 #include "OgreMaterialManager.h"
 #include "OgreRenderSystem.h"
+#include "OgreOptimisedUtil.h"
 
 namespace Ogre {
 
@@ -313,6 +314,89 @@ namespace Ogre {
         }
 
         return true;
+    }
+    //-----------------------------------------------------------------------
+    size_t Frustum::getCullingPlanes(Vector4* planes) const
+    {
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        size_t numPlanes = 0;
+        for (int plane = 0; plane < 6; ++plane)
+        {
+            // Skip far plane if infinite view frustum
+            if (plane == FRUSTUM_PLANE_FAR && mFarDist == 0)
+                continue;
+
+            const Plane& p = mFrustumPlanes[plane];
+            planes[numPlanes++] = Vector4(p.normal.x, p.normal.y, p.normal.z, p.d);
+        }
+        return numPlanes;
+    }
+    //-----------------------------------------------------------------------
+    // Bounds are converted to the OptimisedUtil layout this many at a time,
+    // must be a multiple of 32 so that each batch starts a new visibility word
+#define OGRE_FRUSTUM_CULL_BATCH 64
+
+    void Frustum::isVisible(const AxisAlignedBox* bounds, size_t count, uint32* visibility) const
+    {
+        Vector4 planes[6];
+        size_t numPlanes = getCullingPlanes(planes);
+
+        Vector3 centres[OGRE_FRUSTUM_CULL_BATCH];
+        Vector3 halfSizes[OGRE_FRUSTUM_CULL_BATCH];
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+        for (size_t base = 0; base < count; base += OGRE_FRUSTUM_CULL_BATCH)
+        {
+            size_t n = std::min(count - base, (size_t)OGRE_FRUSTUM_CULL_BATCH);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const AxisAlignedBox& bound = bounds[base + i];
+                if (bound.isFinite())
+                {
+                    centres[i] = bound.getCenter();
+                    halfSizes[i] = bound.getHalfSize();
+                }
+                else
+                {
+                    // Fixed up below
+                    centres[i] = Vector3::ZERO;
+                    halfSizes[i] = Vector3::ZERO;
+                }
+            }
+            util->cullBoxes(planes, numPlanes, centres, halfSizes, visibility + base / 32, n);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const AxisAlignedBox& bound = bounds[base + i];
+                size_t index = base + i;
+                // Null boxes always invisible, infinite boxes always visible
+                if (bound.isNull())
+                    visibility[index >> 5] &= ~(1u << (index & 31));
+                else if (bound.isInfinite())
+                    visibility[index >> 5] |= 1u << (index & 31);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void Frustum::isVisible(const Sphere* spheres, size_t count, uint32* visibility) const
+    {
+        Vector4 planes[6];
+        size_t numPlanes = getCullingPlanes(planes);
+
+        Vector4 packed[OGRE_FRUSTUM_CULL_BATCH];
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+        for (size_t base = 0; base < count; base += OGRE_FRUSTUM_CULL_BATCH)
+        {
+            size_t n = std::min(count - base, (size_t)OGRE_FRUSTUM_CULL_BATCH);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const Sphere& sphere = spheres[base + i];
+                const Vector3& centre = sphere.getCenter();
+                packed[i] = Vector4(centre.x, centre.y, centre.z, sphere.getRadius());
+            }
+            util->cullSpheres(planes, numPlanes, packed, visibility + base / 32, n);
+        }
     }
 	//---------------------------------------------------------------------
 	uint32 Frustum::getTypeFlags(void) const
@@ -575,6 +575,11 @@ namespace Ogre
 		, mTransposeMatrices(false)
 		, mIgnoreMissingParams(false)
 		, mActivePassIterationIndex(std::numeric_limits<size_t>::max())	
+		, mFloatDirtyStart(std::numeric_limits<size_t>::max())
+		, mFloatDirtyEnd(0)
+		, mIntDirtyStart(std::numeric_limits<size_t>::max())
+		, mIntDirtyEnd(0)
+		, mDirtyRangeOwner(0)
     {
     }
     //-----------------------------------------------------------------------------
@@ -600,6 +605,9 @@ namespace Ogre
         mIgnoreMissingParams  = oth.mIgnoreMissingParams;
 		mActivePassIterationIndex = oth.mActivePassIterationIndex;
 
+		// Nothing has been uploaded from this copy yet
+		_markAllDirty();
+
 		return *this;
     }
 	//---------------------------------------------------------------------
@@ -613,11 +621,15 @@ namespace Ogre
 		// Size and reset buffer (fill with zero to make comparison later ok)
 		if (namedConstants->floatBufferSize > mFloatConstants.size())
 		{
+			markFloatDirty(mFloatConstants.size(), 
+				namedConstants->floatBufferSize - mFloatConstants.size());
 			mFloatConstants.insert(mFloatConstants.end(), 
 				namedConstants->floatBufferSize - mFloatConstants.size(), 0.0f);
 		}
 		if (namedConstants->intBufferSize > mIntConstants.size())
 		{
+			markIntDirty(mIntConstants.size(), 
+				namedConstants->intBufferSize - mIntConstants.size());
 			mIntConstants.insert(mIntConstants.end(), 
 				namedConstants->intBufferSize - mIntConstants.size(), 0);
 		}
@@ -637,11 +649,15 @@ namespace Ogre
 		// Size and reset buffer (fill with zero to make comparison later ok)
 		if (floatIndexMap->bufferSize > mFloatConstants.size())
 		{
+			markFloatDirty(mFloatConstants.size(), 
+				floatIndexMap->bufferSize - mFloatConstants.size());
 			mFloatConstants.insert(mFloatConstants.end(), 
 				floatIndexMap->bufferSize - mFloatConstants.size(), 0.0f);
 		}
 		if (intIndexMap->bufferSize > mIntConstants.size())
 		{
+			markIntDirty(mIntConstants.size(), 
+				intIndexMap->bufferSize - mIntConstants.size());
 			mIntConstants.insert(mIntConstants.end(), 
 				intIndexMap->bufferSize - mIntConstants.size(), 0);
 		}
@@ -724,13 +740,8 @@ namespace Ogre
 		assert(mFloatLogicalToPhysical && "GpuProgram hasn't set up the logical -> physical map!");
 
 		size_t physicalIndex = _getFloatConstantPhysicalIndex(index, rawCount);
-		assert(physicalIndex + rawCount <= mFloatConstants.size());
-		// Copy manually since cast required
-		for (size_t i = 0; i < rawCount; ++i)
-		{
-			mFloatConstants[physicalIndex + i] = 
-				static_cast<float>(val[i]);
-		}
+		// Copy (converts)
+		_writeRawConstants(physicalIndex, val, rawCount);
 
     }
     //-----------------------------------------------------------------------------
@@ -815,22 +826,87 @@ namespace Ogre
 	void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const double* val, size_t count)
 	{
 		assert(physicalIndex + count <= mFloatConstants.size());
+		bool changed = false;
 		for (size_t i = 0; i < count; ++i)
 		{
-			mFloatConstants[physicalIndex+i] = static_cast<float>(val[i]);
+			float f = static_cast<float>(val[i]);
+			if (mFloatConstants[physicalIndex+i] != f)
+			{
+				mFloatConstants[physicalIndex+i] = f;
+				changed = true;
+			}
 		}
+		if (changed)
+			markFloatDirty(physicalIndex, count);
 	}
 	//-----------------------------------------------------------------------------
 	void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const float* val, size_t count)
 	{
 		assert(physicalIndex + count <= mFloatConstants.size());
-		memcpy(&mFloatConstants[physicalIndex], val, sizeof(float) * count);
+		// Automatic parameters are rewritten for every renderable; only the
+		// values which really change need to reach the render system
+		if (count && memcmp(&mFloatConstants[physicalIndex], val, sizeof(float) * count) != 0)
+		{
+			memcpy(&mFloatConstants[physicalIndex], val, sizeof(float) * count);
+			markFloatDirty(physicalIndex, count);
+		}
 	}
 	//-----------------------------------------------------------------------------
 	void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const int* val, size_t count)
 	{
 		assert(physicalIndex + count <= mIntConstants.size());
-		memcpy(&mIntConstants[physicalIndex], val, sizeof(int) * count);
+		if (count && memcmp(&mIntConstants[physicalIndex], val, sizeof(int) * count) != 0)
+		{
+			memcpy(&mIntConstants[physicalIndex], val, sizeof(int) * count);
+			markIntDirty(physicalIndex, count);
+		}
+	}
+	//-----------------------------------------------------------------------------
+	bool GpuProgramParameters::_getFloatDirtyRange(const void* binding, 
+		size_t& start, size_t& end) const
+	{
+		if (binding != mDirtyRangeOwner || !binding)
+		{
+			start = 0;
+			end = mFloatConstants.size();
+		}
+		else
+		{
+			start = mFloatDirtyStart;
+			end = std::min(mFloatDirtyEnd, mFloatConstants.size());
+		}
+		return start < end;
+	}
+	//-----------------------------------------------------------------------------
+	bool GpuProgramParameters::_getIntDirtyRange(const void* binding, 
+		size_t& start, size_t& end) const
+	{
+		if (binding != mDirtyRangeOwner || !binding)
+		{
+			start = 0;
+			end = mIntConstants.size();
+		}
+		else
+		{
+			start = mIntDirtyStart;
+			end = std::min(mIntDirtyEnd, mIntConstants.size());
+		}
+		return start < end;
+	}
+	//-----------------------------------------------------------------------------
+	void GpuProgramParameters::_clearDirtyRanges(const void* binding)
+	{
+		mFloatDirtyStart = mIntDirtyStart = std::numeric_limits<size_t>::max();
+		mFloatDirtyEnd = mIntDirtyEnd = 0;
+		mDirtyRangeOwner = binding;
+	}
+	//-----------------------------------------------------------------------------
+	void GpuProgramParameters::_markAllDirty(void)
+	{
+		mFloatDirtyStart = mIntDirtyStart = 0;
+		mFloatDirtyEnd = mFloatConstants.size();
+		mIntDirtyEnd = mIntConstants.size();
+		mDirtyRangeOwner = 0;
 	}
 	//-----------------------------------------------------------------------------
 	void GpuProgramParameters::_readRawConstants(size_t physicalIndex, size_t count, float* dest)
@@ -865,6 +941,7 @@ namespace Ogre
 
                 // Expand at buffer end
                 mFloatConstants.insert(mFloatConstants.end(), requestedSize, 0.0f);
+				markFloatDirty(physicalIndex, requestedSize);
 
 				// Record extended size for future GPU params re-using this information
 				mFloatLogicalToPhysical->bufferSize = mFloatConstants.size();
@@ -905,6 +982,8 @@ namespace Ogre
 				FloatConstantList::iterator insertPos = mFloatConstants.begin();
 				std::advance(insertPos, physicalIndex);
 				mFloatConstants.insert(insertPos, insertCount, 0.0f);
+				// everything after the insert has moved
+				markFloatDirty(physicalIndex, mFloatConstants.size() - physicalIndex);
 				// shift all physical positions after this one
 				for (GpuLogicalIndexUseMap::iterator i = mFloatLogicalToPhysical->map.begin();
 					i != mFloatLogicalToPhysical->map.end(); ++i)
@@ -944,6 +1023,7 @@ namespace Ogre
 
                 // Expand at buffer end
                 mIntConstants.insert(mIntConstants.end(), requestedSize, 0);
+				markIntDirty(physicalIndex, requestedSize);
 
 				// Record extended size for future GPU params re-using this information
 				mIntLogicalToPhysical->bufferSize = mIntConstants.size();
@@ -984,6 +1064,8 @@ namespace Ogre
 				IntConstantList::iterator insertPos = mIntConstants.begin();
 				std::advance(insertPos, physicalIndex);
 				mIntConstants.insert(insertPos, insertCount, 0);
+				// everything after the insert has moved
+				markIntDirty(physicalIndex, mIntConstants.size() - physicalIndex);
 				// shift all physical positions after this one
 				for (GpuLogicalIndexUseMap::iterator i = mIntLogicalToPhysical->map.begin();
 					i != mIntLogicalToPhysical->map.end(); ++i)
@@ -2005,6 +2087,7 @@ namespace Ogre
 		mFloatConstants = source.getFloatConstantList();
 		mIntConstants = source.getIntConstantList();
 		mAutoConstants = source.getAutoConstantList();
+		_markAllDirty();
     }
     //-----------------------------------------------------------------------
     const GpuProgramParameters::AutoConstantDefinition* 
@@ -2057,6 +2140,7 @@ namespace Ogre
         {
 			// This is a physical index
 			++mFloatConstants[mActivePassIterationIndex];
+			markFloatDirty(mActivePassIterationIndex, 1);
         }
     }
 
@@ -32,6 +32,7 @@ Torus Knot Software Ltd.
 #include "OgreException.h"
 #include "OgreImageCodec.h"
 #include "OgreColourValue.h"
+#include "OgreWorkerThreadPool.h"
 
 #include "OgreImageResampler.h"
 
@@ -621,14 +622,14 @@ namespace Ogre {
 			// super-optimized: no conversion
 			switch (PixelUtil::getNumElemBytes(src.format)) 
 			{
-			case 1: NearestResampler<1>::scale(src, temp); break;
-			case 2: NearestResampler<2>::scale(src, temp); break;
-			case 3: NearestResampler<3>::scale(src, temp); break;
-			case 4: NearestResampler<4>::scale(src, temp); break;
-			case 6: NearestResampler<6>::scale(src, temp); break;
-			case 8: NearestResampler<8>::scale(src, temp); break;
-			case 12: NearestResampler<12>::scale(src, temp); break;
-			case 16: NearestResampler<16>::scale(src, temp); break;
+			case 1: parallelScale<NearestResampler<1> >(src, temp); break;
+			case 2: parallelScale<NearestResampler<2> >(src, temp); break;
+			case 3: parallelScale<NearestResampler<3> >(src, temp); break;
+			case 4: parallelScale<NearestResampler<4> >(src, temp); break;
+			case 6: parallelScale<NearestResampler<6> >(src, temp); break;
+			case 8: parallelScale<NearestResampler<8> >(src, temp); break;
+			case 12: parallelScale<NearestResampler<12> >(src, temp); break;
+			case 16: parallelScale<NearestResampler<16> >(src, temp); break;
 			default:
 				// never reached
 				assert(false);
@@ -664,10 +665,10 @@ namespace Ogre {
 				// super-optimized: byte-oriented math, no conversion
 				switch (PixelUtil::getNumElemBytes(src.format)) 
 				{
-				case 1: LinearResampler_Byte<1>::scale(src, temp); break;
-				case 2: LinearResampler_Byte<2>::scale(src, temp); break;
-				case 3: LinearResampler_Byte<3>::scale(src, temp); break;
-				case 4: LinearResampler_Byte<4>::scale(src, temp); break;
+				case 1: parallelScale<LinearResampler_Byte<1> >(src, temp); break;
+				case 2: parallelScale<LinearResampler_Byte<2> >(src, temp); break;
+				case 3: parallelScale<LinearResampler_Byte<3> >(src, temp); break;
+				case 4: parallelScale<LinearResampler_Byte<4> >(src, temp); break;
 				default:
 					// never reached
 					assert(false);
@@ -683,13 +684,13 @@ namespace Ogre {
 				if (scaled.format == PF_FLOAT32_RGB || scaled.format == PF_FLOAT32_RGBA)
 				{
 					// float32 to float32, avoid unpack/repack overhead
-					LinearResampler_Float32::scale(src, scaled);
+					parallelScale<LinearResampler_Float32>(src, scaled);
 					break;
 				}
 				// else, fall through
 			default:
 				// non-optimized: floating-point math, performs conversion but always works
-				LinearResampler::scale(src, scaled);
+				parallelScale<LinearResampler>(src, scaled);
 			}
 			break;
 		}
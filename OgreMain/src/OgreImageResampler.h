@@ -55,11 +55,17 @@ typedef unsigned long long uint64;
 // as simplifying memcpy() and replacing multiplies with bitshifts
 template<unsigned int elemsize> struct NearestResampler {
 	static void scale(const PixelBox& src, const PixelBox& dst) {
+		scale(src, dst, 0, dst.getHeight());
+	}
+
+	// scales rows [rowBegin, rowEnd) of each destination slice
+	static void scale(const PixelBox& src, const PixelBox& dst,
+		size_t rowBegin, size_t rowEnd) {
 		// assert(src.format == dst.format);
 
 		// srcdata stays at beginning, pdst is a moving pointer
 		uchar* srcdata = (uchar*)src.data;
-		uchar* pdst = (uchar*)dst.data;
+		uchar* dstdata = (uchar*)dst.data;
 
 		// sx_48,sy_48,sz_48 represent current position in source
 		// using 16/48-bit fixed precision, incremented by steps
@@ -72,9 +78,11 @@ template<unsigned int elemsize> struct NearestResampler {
 		uint64 sz_48 = (stepz >> 1) - 1;
 		for (size_t z = dst.front; z < dst.back; z++, sz_48 += stepz) {
 			size_t srczoff = (size_t)(sz_48 >> 48) * src.slicePitch;
+			uchar* pdst = dstdata +
+				elemsize*((z - dst.front)*dst.slicePitch + rowBegin*dst.rowPitch);
 			
-			uint64 sy_48 = (stepy >> 1) - 1;
-			for (size_t y = dst.top; y < dst.bottom; y++, sy_48 += stepy) {
+			uint64 sy_48 = (stepy >> 1) - 1 + stepy*rowBegin;
+			for (size_t y = rowBegin; y < rowEnd; y++, sy_48 += stepy) {
 				size_t srcyoff = (size_t)(sy_48 >> 48) * src.rowPitch;
 			
 				uint64 sx_48 = (stepx >> 1) - 1;
@@ -86,7 +94,6 @@ template<unsigned int elemsize> struct NearestResampler {
 				}
 				pdst += elemsize*dst.getRowSkip();
 			}
-			pdst += elemsize*dst.getSliceSkip();
 		}
 	}
 };
@@ -95,12 +102,18 @@ template<unsigned int elemsize> struct NearestResampler {
 // default floating-point linear resampler, does format conversion
 struct LinearResampler {
 	static void scale(const PixelBox& src, const PixelBox& dst) {
+		scale(src, dst, 0, dst.getHeight());
+	}
+
+	// scales rows [rowBegin, rowEnd) of each destination slice
+	static void scale(const PixelBox& src, const PixelBox& dst,
+		size_t rowBegin, size_t rowEnd) {
 		size_t srcelemsize = PixelUtil::getNumElemBytes(src.format);
 		size_t dstelemsize = PixelUtil::getNumElemBytes(dst.format);
 
 		// srcdata stays at beginning, pdst is a moving pointer
 		uchar* srcdata = (uchar*)src.data;
-		uchar* pdst = (uchar*)dst.data;
+		uchar* dstdata = (uchar*)dst.data;
 		
 		// sx_48,sy_48,sz_48 represent current position in source
 		// using 16/48-bit fixed precision, incremented by steps
@@ -123,9 +136,11 @@ struct LinearResampler {
 			size_t sz1 = temp >> 16;				 // src z, sample #1
 			size_t sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
 			float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
+			uchar* pdst = dstdata +
+				dstelemsize*((z - dst.front)*dst.slicePitch + rowBegin*dst.rowPitch);
 
-			uint64 sy_48 = (stepy >> 1) - 1;
-			for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+			uint64 sy_48 = (stepy >> 1) - 1 + stepy*rowBegin;
+			for (size_t y = rowBegin; y < rowEnd; y++, sy_48+=stepy) {
 				temp = sy_48 >> 32;
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
 				size_t sy1 = temp >> 16;					// src y #1
@@ -168,7 +183,6 @@ struct LinearResampler {
 				}
 				pdst += dstelemsize*dst.getRowSkip();
 			}
-			pdst += dstelemsize*dst.getSliceSkip();
 		}
 	}
 };
@@ -178,6 +192,12 @@ struct LinearResampler {
 // avoids overhead of pixel unpack/repack function calls
 struct LinearResampler_Float32 {
 	static void scale(const PixelBox& src, const PixelBox& dst) {
+		scale(src, dst, 0, dst.getHeight());
+	}
+
+	// scales rows [rowBegin, rowEnd) of each destination slice
+	static void scale(const PixelBox& src, const PixelBox& dst,
+		size_t rowBegin, size_t rowEnd) {
 		size_t srcchannels = PixelUtil::getNumElemBytes(src.format) / sizeof(float);
 		size_t dstchannels = PixelUtil::getNumElemBytes(dst.format) / sizeof(float);
 		// assert(srcchannels == 3 || srcchannels == 4);
@@ -185,7 +205,7 @@ struct LinearResampler_Float32 {
 
 		// srcdata stays at beginning, pdst is a moving pointer
 		float* srcdata = (float*)src.data;
-		float* pdst = (float*)dst.data;
+		float* dstdata = (float*)dst.data;
 		
 		// sx_48,sy_48,sz_48 represent current position in source
 		// using 16/48-bit fixed precision, incremented by steps
@@ -208,9 +228,11 @@ struct LinearResampler_Float32 {
 			size_t sz1 = temp >> 16;				 // src z, sample #1
 			size_t sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
 			float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
+			float* pdst = dstdata +
+				dstchannels*((z - dst.front)*dst.slicePitch + rowBegin*dst.rowPitch);
 
-			uint64 sy_48 = (stepy >> 1) - 1;
-			for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+			uint64 sy_48 = (stepy >> 1) - 1 + stepy*rowBegin;
+			for (size_t y = rowBegin; y < rowEnd; y++, sy_48+=stepy) {
 				temp = sy_48 >> 32;
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
 				size_t sy1 = temp >> 16;					// src y #1
@@ -272,7 +294,6 @@ struct LinearResampler_Float32 {
 				}
 				pdst += dstchannels*dst.getRowSkip();
 			}
-			pdst += dstchannels*dst.getSliceSkip();
 		}
 	}
 };
@@ -286,17 +307,23 @@ struct LinearResampler_Float32 {
 // as unrolling loops and replacing multiplies with bitshifts
 template<unsigned int channels> struct LinearResampler_Byte {
 	static void scale(const PixelBox& src, const PixelBox& dst) {
+		scale(src, dst, 0, dst.getHeight());
+	}
+
+	// scales rows [rowBegin, rowEnd) of the destination
+	static void scale(const PixelBox& src, const PixelBox& dst,
+		size_t rowBegin, size_t rowEnd) {
 		// assert(src.format == dst.format);
 
 		// only optimized for 2D
 		if (src.getDepth() > 1 || dst.getDepth() > 1) {
-			LinearResampler::scale(src, dst);
+			LinearResampler::scale(src, dst, rowBegin, rowEnd);
 			return;
 		}
 
 		// srcdata stays at beginning of slice, pdst is a moving pointer
 		uchar* srcdata = (uchar*)src.data;
-		uchar* pdst = (uchar*)dst.data;
+		uchar* pdst = (uchar*)dst.data + channels*rowBegin*dst.rowPitch;
 
 		// sx_48,sy_48 represent current position in source
 		// using 16/48-bit fixed precision, incremented by steps
@@ -309,8 +336,8 @@ template<unsigned int channels> struct LinearResampler_Byte {
 		// fractional bits are the blend weight of the second sample
 		unsigned int temp;
 		
-		uint64 sy_48 = (stepy >> 1) - 1;
-		for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+		uint64 sy_48 = (stepy >> 1) - 1 + stepy*rowBegin;
+		for (size_t y = rowBegin; y < rowEnd; y++, sy_48+=stepy) {
 			temp = sy_48 >> 36;
 			temp = (temp > 0x800)? temp - 0x800: 0;
 			unsigned int syf = temp & 0xFFF;
@@ -344,6 +371,46 @@ template<unsigned int channels> struct LinearResampler_Byte {
 	}
 };
 
+
+// task which scales a band of destination rows with one of the resamplers
+template<class Resampler> class ResampleTask : public WorkerThreadPool::Task {
+protected:
+	const PixelBox* mSrc;
+	const PixelBox* mDst;
+	size_t mRowBegin, mRowEnd;
+public:
+	ResampleTask(const PixelBox* src, const PixelBox* dst, size_t rowBegin, size_t rowEnd)
+		: mSrc(src), mDst(dst), mRowBegin(rowBegin), mRowEnd(rowEnd) {}
+	void execute(void) {
+		Resampler::scale(*mSrc, *mDst, mRowBegin, mRowEnd);
+	}
+};
+
+// scales with one of the resamplers, splitting large destinations into
+// bands of rows which are scaled across the WorkerThreadPool
+template<class Resampler> void parallelScale(const PixelBox& src, const PixelBox& dst) {
+	WorkerThreadPool* pool = WorkerThreadPool::getSingletonPtr();
+	size_t height = dst.getHeight();
+	if (!pool || !pool->isParallel() || height < 2 ||
+		dst.getWidth() * height * dst.getDepth() < PixelUtil::PARALLEL_CONVERSION_MIN_PIXELS) {
+		Resampler::scale(src, dst);
+		return;
+	}
+
+	// a couple of bands per thread
+	size_t numTasks = std::min(height, (pool->getNumWorkerThreads() + 1) * 2);
+	std::vector<ResampleTask<Resampler> > tasks;
+	tasks.reserve(numTasks);
+	WorkerThreadPool::TaskList taskList;
+	taskList.reserve(numTasks);
+	for (size_t t = 0; t < numTasks; ++t) {
+		tasks.push_back(ResampleTask<Resampler>(&src, &dst,
+			(height * t) / numTasks, (height * (t + 1)) / numTasks));
+		taskList.push_back(&tasks.back());
+	}
+	pool->executeTasks(taskList);
+}
+
 }
 
 #endif
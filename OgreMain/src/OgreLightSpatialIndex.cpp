@@ -0,0 +1,193 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreLightSpatialIndex.h"
+#include "OgreLight.h"
+#include "OgreBitwise.h"
+
+namespace Ogre {
+
+	const size_t LightSpatialIndex::MIN_LIGHTS_FOR_GRID = 16;
+	const size_t LightSpatialIndex::MAX_CELLS_PER_LIGHT = 64;
+	const size_t LightSpatialIndex::MAX_CELLS_PER_QUERY = 64;
+	//-----------------------------------------------------------------------
+	LightSpatialIndex::LightSpatialIndex()
+		: mNumLights(0)
+		, mCellSize(0)
+	{
+	}
+	//-----------------------------------------------------------------------
+	void LightSpatialIndex::clear(void)
+	{
+		mNumLights = 0;
+		mCellSize = 0;
+		mAlwaysIncluded.clear();
+		mBucketStarts.clear();
+		mBucketEntries.clear();
+	}
+	//-----------------------------------------------------------------------
+	void LightSpatialIndex::getCellRange(const Vector3& centre, Real radius, 
+		int* minCell, int* maxCell) const
+	{
+		// Keep well inside the range of int so the cell counts can't overflow
+		const Real limit = (Real)(1 << 28);
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			Real lo = (centre[axis] - radius) / mCellSize;
+			Real hi = (centre[axis] + radius) / mCellSize;
+			lo = std::max(-limit, std::min(limit, lo));
+			hi = std::max(-limit, std::min(limit, hi));
+			minCell[axis] = (int)Math::Floor(lo);
+			maxCell[axis] = (int)Math::Floor(hi);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void LightSpatialIndex::build(const LightList& lights)
+	{
+		clear();
+		mNumLights = lights.size();
+		if (mNumLights < MIN_LIGHTS_FOR_GRID)
+			return;
+
+		// Size the cells so that a typical light overlaps 2 cells on each axis
+		std::vector<Real> ranges;
+		ranges.reserve(mNumLights);
+		LightList::const_iterator i, iend;
+		iend = lights.end();
+		for (i = lights.begin(); i != iend; ++i)
+		{
+			if ((*i)->getType() != Light::LT_DIRECTIONAL)
+				ranges.push_back((*i)->getAttenuationRange());
+		}
+		if (ranges.empty())
+		{
+			// Nothing to put in a grid
+			return;
+		}
+		std::vector<Real>::iterator median = ranges.begin() + ranges.size() / 2;
+		std::nth_element(ranges.begin(), median, ranges.end());
+		mCellSize = std::max(*median * 2, (Real)1e-3);
+
+		// Work out which cells every light overlaps
+		typedef std::pair<size_t, size_t> BucketEntry;
+		std::vector<BucketEntry> entries;
+		size_t numBuckets = Bitwise::firstPO2From((uint32)mNumLights * 4);
+		mBucketStarts.resize(numBuckets + 1, 0);
+		int minCell[3], maxCell[3];
+		for (size_t l = 0; l < mNumLights; ++l)
+		{
+			const Light* light = lights[l];
+			if (light->getType() == Light::LT_DIRECTIONAL)
+			{
+				mAlwaysIncluded.push_back(l);
+				continue;
+			}
+			getCellRange(light->getDerivedPosition(), light->getAttenuationRange(),
+				minCell, maxCell);
+			size_t numCells = (size_t)(maxCell[0] - minCell[0] + 1) * 
+				(size_t)(maxCell[1] - minCell[1] + 1) * 
+				(size_t)(maxCell[2] - minCell[2] + 1);
+			if (numCells > MAX_CELLS_PER_LIGHT)
+			{
+				mAlwaysIncluded.push_back(l);
+				continue;
+			}
+			for (int x = minCell[0]; x <= maxCell[0]; ++x)
+			{
+				for (int y = minCell[1]; y <= maxCell[1]; ++y)
+				{
+					for (int z = minCell[2]; z <= maxCell[2]; ++z)
+					{
+						entries.push_back(BucketEntry(getBucket(x, y, z), l));
+					}
+				}
+			}
+		}
+
+		// Lay out the buckets contiguously; sorting also groups the entries of 
+		// each bucket in light order, so duplicates are adjacent
+		std::sort(entries.begin(), entries.end());
+		entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+		mBucketEntries.reserve(entries.size());
+		std::vector<BucketEntry>::const_iterator e, eend;
+		eend = entries.end();
+		for (e = entries.begin(); e != eend; ++e)
+		{
+			++mBucketStarts[e->first + 1];
+			mBucketEntries.push_back(e->second);
+		}
+		for (size_t b = 1; b <= numBuckets; ++b)
+		{
+			mBucketStarts[b] += mBucketStarts[b - 1];
+		}
+	}
+	//-----------------------------------------------------------------------
+	void LightSpatialIndex::findLights(const Vector3& position, Real radius, 
+		IndexList& result) const
+	{
+		size_t first = result.size();
+		int minCell[3], maxCell[3];
+		size_t numCells = 0;
+		if (hasGrid())
+		{
+			getCellRange(position, radius, minCell, maxCell);
+			numCells = (size_t)(maxCell[0] - minCell[0] + 1) * 
+				(size_t)(maxCell[1] - minCell[1] + 1) * 
+				(size_t)(maxCell[2] - minCell[2] + 1);
+		}
+		if (!hasGrid() || numCells > MAX_CELLS_PER_QUERY)
+		{
+			// Few lights or a large sphere, not worth visiting the cells
+			for (size_t l = 0; l < mNumLights; ++l)
+				result.push_back(l);
+			return;
+		}
+
+		result.insert(result.end(), mAlwaysIncluded.begin(), mAlwaysIncluded.end());
+		for (int x = minCell[0]; x <= maxCell[0]; ++x)
+		{
+			for (int y = minCell[1]; y <= maxCell[1]; ++y)
+			{
+				for (int z = minCell[2]; z <= maxCell[2]; ++z)
+				{
+					size_t bucket = getBucket(x, y, z);
+					result.insert(result.end(), 
+						mBucketEntries.begin() + mBucketStarts[bucket], 
+						mBucketEntries.begin() + mBucketStarts[bucket + 1]);
+				}
+			}
+		}
+
+		// Lights can overlap several of the cells visited
+		IndexList::iterator start = result.begin() + first;
+		std::sort(start, result.end());
+		result.erase(std::unique(start, result.end()), result.end());
+	}
+
+}
@@ -38,11 +38,13 @@ Torus Knot Software Ltd.
 #include "OgreException.h"
 #include "OgreMeshManager.h"
 #include "OgreEdgeListBuilder.h"
+#include "OgreMeshTriangleBVH.h"
 #include "OgreAnimation.h"
 #include "OgreAnimationState.h"
 #include "OgreAnimationTrack.h"
 #include "OgreOptimisedUtil.h"
 #include "OgreTangentSpaceCalc.h"
+#include "OgreWorkerThreadPool.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -110,6 +112,7 @@ namespace Ogre {
         mPreparedForShadowVolumes(false),
         mEdgeListsBuilt(false),
         mAutoBuildEdgeLists(true), // will be set to false by serializers of 1.30 and above
+        mTriangleBVH(0),
 		mSharedVertexDataAnimationType(VAT_NONE),
 		mAnimationTypesDirty(true),
 		sharedVertexData(0)
@@ -196,19 +199,68 @@ namespace Ogre {
 				buildEdgeList();
 			}
 		}
+
+		if (MeshManager::getSingleton().getBuildTriangleBVHs())
+		{
+			buildTriangleBVH();
+		}
 	}
 	//-----------------------------------------------------------------------
-    void Mesh::loadImpl()
+    void Mesh::prepareImpl()
     {
-        // Load from specified 'name'
-        MeshSerializer serializer;
-		serializer.setListener(MeshManager::getSingleton().getListener());
-        LogManager::getSingleton().logMessage("Mesh: Loading " + mName + ".");
-
         DataStreamPtr stream =
             ResourceGroupManager::getSingleton().openResource(
 				mName, mGroup, true, this);
-        serializer.importMesh(stream, this);
+        // Parse from memory so vertex data can be copied out in one go;
+        // streams already held in memory (e.g. mapped files) need no copy
+        if (!stream->getReadPtr(stream->size()) || stream->tell() != 0)
+            stream = DataStreamPtr(new MemoryDataStream(mName, stream));
+
+        MeshSerializer serializer;
+		serializer.setListener(MeshManager::getSingleton().getListener());
+		// No hardware buffers yet, loadImpl creates them
+		serializer.setDeferHardwareBuffers(true);
+        LogManager::getSingleton().logMessage("Mesh: Preparing " + mName + ".");
+
+		try
+		{
+			serializer.importMesh(stream, this);
+		}
+		catch (...)
+		{
+			// Don't leave a half parsed mesh for the next attempt
+			unloadImpl();
+			throw;
+		}
+    }
+    //-----------------------------------------------------------------------
+    void Mesh::unprepareImpl()
+    {
+		// After a load the parsed data belongs to the loaded mesh; otherwise
+		// the load never happened (or failed) and the data is thrown away
+		if (mLoadingState == LOADSTATE_UNLOADED)
+			unloadImpl();
+    }
+    //-----------------------------------------------------------------------
+    void Mesh::loadImpl()
+    {
+		if (mIsPrepared)
+		{
+			// Already parsed, only the hardware buffers are missing
+			createHardwareBuffers();
+		}
+		else
+		{
+			// Load from specified 'name'
+			MeshSerializer serializer;
+			serializer.setListener(MeshManager::getSingleton().getListener());
+			LogManager::getSingleton().logMessage("Mesh: Loading " + mName + ".");
+
+			DataStreamPtr stream =
+				ResourceGroupManager::getSingleton().openResource(
+					mName, mGroup, true, this);
+			serializer.importMesh(stream, this);
+		}
 
         /* check all submeshes to see if their materials should be
            updated.  If the submesh has texture aliases that match those
@@ -218,9 +270,92 @@ namespace Ogre {
         updateMaterialForAllSubMeshes();
     }
 
+	//-----------------------------------------------------------------------
+	static HardwareVertexBufferSharedPtr createHardwareCopy(
+		const HardwareVertexBufferSharedPtr& src, bool useShadowBuffer)
+	{
+		HardwareVertexBufferSharedPtr dst =
+			HardwareBufferManager::getSingleton().createVertexBuffer(
+				src->getVertexSize(), src->getNumVertices(),
+				src->getUsage(), useShadowBuffer);
+		dst->copyData(*src, 0, 0, src->getSizeInBytes(), true);
+		return dst;
+	}
+	//-----------------------------------------------------------------------
+	static void createHardwareCopies(VertexData* vertexData, bool useShadowBuffer)
+	{
+		// Copy the bindings first, replacing them changes the map
+		VertexBufferBinding::VertexBufferBindingMap bindings =
+			vertexData->vertexBufferBinding->getBindings();
+		VertexBufferBinding::VertexBufferBindingMap::iterator i, iend;
+		iend = bindings.end();
+		for (i = bindings.begin(); i != iend; ++i)
+		{
+			vertexData->vertexBufferBinding->setBinding(i->first,
+				createHardwareCopy(i->second, useShadowBuffer));
+		}
+	}
+	//-----------------------------------------------------------------------
+	static void createHardwareCopies(IndexData* indexData, bool useShadowBuffer)
+	{
+		HardwareIndexBufferSharedPtr src = indexData->indexBuffer;
+		if (src.isNull())
+			return;
+		indexData->indexBuffer =
+			HardwareBufferManager::getSingleton().createIndexBuffer(
+				src->getType(), src->getNumIndexes(),
+				src->getUsage(), useShadowBuffer);
+		indexData->indexBuffer->copyData(*src, 0, 0, src->getSizeInBytes(), true);
+	}
+	//-----------------------------------------------------------------------
+	void Mesh::createHardwareBuffers(void)
+	{
+		LogManager::getSingleton().logMessage(
+			"Mesh: Creating hardware buffers for " + mName + ".");
+
+		if (sharedVertexData)
+			createHardwareCopies(sharedVertexData, mVertexBufferShadowBuffer);
+
+		for (SubMeshList::iterator i = mSubMeshList.begin();
+			i != mSubMeshList.end(); ++i)
+		{
+			SubMesh* sm = *i;
+			if (!sm->useSharedVertices)
+				createHardwareCopies(sm->vertexData, mVertexBufferShadowBuffer);
+			createHardwareCopies(sm->indexData, mIndexBufferShadowBuffer);
+
+			ProgressiveMesh::LODFaceList::iterator l, lend;
+			lend = sm->mLodFaceList.end();
+			for (l = sm->mLodFaceList.begin(); l != lend; ++l)
+				createHardwareCopies(*l, mIndexBufferShadowBuffer);
+		}
+
+		// Morph keyframes are read back on the CPU, MeshSerializer always
+		// gives them a shadow buffer
+		for (AnimationList::iterator a = mAnimationsList.begin();
+			a != mAnimationsList.end(); ++a)
+		{
+			Animation::VertexTrackIterator ti =
+				a->second->getVertexTrackIterator();
+			while (ti.hasMoreElements())
+			{
+				VertexAnimationTrack* track = ti.getNext();
+				if (track->getAnimationType() != VAT_MORPH)
+					continue;
+				for (unsigned short k = 0; k < track->getNumKeyFrames(); ++k)
+				{
+					VertexMorphKeyFrame* kf = track->getVertexMorphKeyFrame(k);
+					kf->setVertexBuffer(
+						createHardwareCopy(kf->getVertexBuffer(), true));
+				}
+			}
+		}
+	}
     //-----------------------------------------------------------------------
     void Mesh::unloadImpl()
     {
+        freeTriangleBVH();
+
         // Teardown submeshes
         for (SubMeshList::iterator i = mSubMeshList.begin();
             i != mSubMeshList.end(); ++i)
@@ -829,6 +964,28 @@ namespace Ogre {
     {
         return mSkeletonName;
     }
+    //---------------------------------------------------------------------
+	namespace
+	{
+		/// Task which performs the reduction of one submesh
+		class LodReductionTask : public WorkerThreadPool::Task
+		{
+		protected:
+			ProgressiveMesh* mProgressiveMesh;
+			ushort mNumLevels;
+			ProgressiveMesh::VertexReductionQuota mQuota;
+			Real mReductionValue;
+		public:
+			LodReductionTask(ProgressiveMesh* pm, ushort numLevels, 
+				ProgressiveMesh::VertexReductionQuota quota, Real reductionValue)
+				: mProgressiveMesh(pm), mNumLevels(numLevels), mQuota(quota), 
+				mReductionValue(reductionValue) {}
+			void execute(void)
+			{
+				mProgressiveMesh->computeLODs(mNumLevels, mQuota, mReductionValue);
+			}
+		};
+	}
     //---------------------------------------------------------------------
     void Mesh::generateLodLevels(const LodDistanceList& lodDistances,
         ProgressiveMesh::VertexReductionQuota reductionMethod, Real reductionValue)
@@ -850,19 +1007,67 @@ namespace Ogre {
 			<< "Generating " << lodDistances.size()
 			<< " lower LODs for mesh " << mName;
 
+        bool parallel = MeshManager::getSingleton().getParallelLodGeneration() &&
+            mSubMeshList.size() > 1 && WorkerThreadPool::getSingletonPtr() &&
+            WorkerThreadPool::getSingleton().isParallel();
+#if OGRE_DEBUG_MODE
+        // ProgressiveMesh writes its debug logs to the same files every time
+        parallel = false;
+#endif
+
         SubMeshList::iterator isub, isubend;
         isubend = mSubMeshList.end();
-        for (isub = mSubMeshList.begin(); isub != isubend; ++isub)
+        if (parallel)
+        {
+            // Read the geometry here, since buffers can't be locked by
+            // several threads at once, then only reduce in parallel
+            std::vector<ProgressiveMesh*> pms;
+            std::vector<LodReductionTask> tasks;
+            WorkerThreadPool::TaskList taskList;
+            pms.reserve(mSubMeshList.size());
+            tasks.reserve(mSubMeshList.size());
+            try
+            {
+                for (isub = mSubMeshList.begin(); isub != isubend; ++isub)
+                {
+                    VertexData* pVertexData = (*isub)->useSharedVertices ? sharedVertexData : (*isub)->vertexData;
+                    pms.push_back(new ProgressiveMesh(pVertexData, (*isub)->indexData));
+                    tasks.push_back(LodReductionTask(pms.back(), 
+                        static_cast<ushort>(lodDistances.size()), 
+                        reductionMethod, reductionValue));
+                }
+                for (size_t i = 0; i < tasks.size(); ++i)
+                    taskList.push_back(&tasks[i]);
+
+                WorkerThreadPool::getSingleton().executeTasks(taskList);
+
+                // Index buffers are created by this thread
+                for (size_t i = 0; i < pms.size(); ++i)
+                    pms[i]->createLODs(&(mSubMeshList[i]->mLodFaceList));
+            }
+            catch (...)
+            {
+                for (size_t i = 0; i < pms.size(); ++i)
+                    delete pms[i];
+                throw;
+            }
+            for (size_t i = 0; i < pms.size(); ++i)
+                delete pms[i];
+        }
+        else
         {
-            // Set up data for reduction
-            VertexData* pVertexData = (*isub)->useSharedVertices ? sharedVertexData : (*isub)->vertexData;
+            for (isub = mSubMeshList.begin(); isub != isubend; ++isub)
+            {
+                // Set up data for reduction
+                VertexData* pVertexData = (*isub)->useSharedVertices ? sharedVertexData : (*isub)->vertexData;
 
-            ProgressiveMesh pm(pVertexData, (*isub)->indexData);
-            pm.build(
-            static_cast<ushort>(lodDistances.size()),
-                &((*isub)->mLodFaceList),
-                reductionMethod, reductionValue);
+                ProgressiveMesh pm(pVertexData, (*isub)->indexData);
+                pm.build(
+                static_cast<ushort>(lodDistances.size()),
+                    &((*isub)->mLodFaceList),
+                    reductionMethod, reductionValue);
 
+            }
         }
 
         // Iterate over the lods and record usage
@@ -1503,6 +1708,28 @@ namespace Ogre {
         mEdgeListsBuilt = false;
     }
     //---------------------------------------------------------------------
+    void Mesh::buildTriangleBVH(void)
+    {
+        freeTriangleBVH();
+        mTriangleBVH = new MeshTriangleBVH(this);
+    }
+    //---------------------------------------------------------------------
+    void Mesh::freeTriangleBVH(void)
+    {
+        delete mTriangleBVH;
+        mTriangleBVH = 0;
+    }
+    //---------------------------------------------------------------------
+    const MeshTriangleBVH* Mesh::getTriangleBVH(void)
+    {
+        // Build on demand
+        if (!mTriangleBVH)
+        {
+            buildTriangleBVH();
+        }
+        return mTriangleBVH;
+    }
+    //---------------------------------------------------------------------
     void Mesh::prepareForShadowVolume(void)
     {
         if (mPreparedForShadowVolumes)
@@ -61,6 +61,8 @@ namespace Ogre
     mBoundsPaddingFactor(0.01), mListener(0)
     {
         mPrepAllMeshesForShadowVolumes = false;
+        mParallelLodGeneration = false;
+        mBuildTriangleBVHs = false;
 
         mLoadOrder = 350.0f;
         mResourceType = "Mesh";
@@ -42,7 +42,7 @@ namespace Ogre {
     const unsigned short HEADER_CHUNK_ID = 0x1000;
     //---------------------------------------------------------------------
     MeshSerializer::MeshSerializer()
-		:mListener(0)
+		:mListener(0), mDeferHardwareBuffers(false)
     {
         // Set up map
         mImplementations.insert(
@@ -116,6 +116,7 @@ namespace Ogre {
         }
 
         // Call implementation
+        impl->second->setDeferHardwareBuffers(mDeferHardwareBuffers);
         impl->second->importMesh(stream, pDest, mListener);
         // Warn on old version of mesh
         if (ver != msCurrentVersion)
@@ -136,5 +137,15 @@ namespace Ogre {
 	{
 		return mListener;
 	}
+	//-------------------------------------------------------------------------
+	void MeshSerializer::setDeferHardwareBuffers(bool defer)
+	{
+		mDeferHardwareBuffers = defer;
+	}
+	//-------------------------------------------------------------------------
+	bool MeshSerializer::getDeferHardwareBuffers(void) const
+	{
+		return mDeferHardwareBuffers;
+	}
 }
 
@@ -37,6 +37,7 @@ Torus Knot Software Ltd.
 #include "OgreLogManager.h"
 #include "OgreSkeleton.h"
 #include "OgreHardwareBufferManager.h"
+#include "OgreDefaultHardwareBufferManager.h"
 #include "OgreMaterial.h"
 #include "OgreTechnique.h"
 #include "OgrePass.h"
@@ -57,6 +58,7 @@ namespace Ogre {
     const long STREAM_OVERHEAD_SIZE = sizeof(uint16) + sizeof(uint32);
     //---------------------------------------------------------------------
     MeshSerializerImpl::MeshSerializerImpl()
+		: mDeferHardwareBuffers(false)
     {
 
         // Version number
@@ -750,21 +752,24 @@ namespace Ogre {
 
 		// Create / populate vertex buffer
 		HardwareVertexBufferSharedPtr vbuf;
-        vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        vbuf = createVertexBuffer(
             vertexSize,
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
 			pMesh->mVertexBufferShadowBuffer);
-        void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
-        stream->read(pBuf, dest->vertexCount * vertexSize);
-
-		// endian conversion for OSX
-		flipFromLittleEndian(
-			pBuf,
-			dest->vertexCount,
-			vertexSize,
-			dest->vertexDeclaration->findElementsBySource(bindIndex));
-        vbuf->unlock();
+        if (!readBufferDirect(stream, vbuf.get()))
+        {
+            void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
+            stream->read(pBuf, dest->vertexCount * vertexSize);
+
+		    // endian conversion for OSX
+		    flipFromLittleEndian(
+			    pBuf,
+			    dest->vertexCount,
+			    vertexSize,
+			    dest->vertexDeclaration->findElementsBySource(bindIndex));
+            vbuf->unlock();
+        }
 
 		// Set binding
         dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
@@ -947,34 +952,38 @@ namespace Ogre {
         readBools(stream, &idx32bit, 1);
         if (idx32bit)
         {
-            ibuf = HardwareBufferManager::getSingleton().
-                createIndexBuffer(
-                    HardwareIndexBuffer::IT_32BIT,
-                    sm->indexData->indexCount,
-                    pMesh->mIndexBufferUsage,
-					pMesh->mIndexBufferShadowBuffer);
+            ibuf = createIndexBuffer(
+                HardwareIndexBuffer::IT_32BIT,
+                sm->indexData->indexCount,
+                pMesh->mIndexBufferUsage,
+				pMesh->mIndexBufferShadowBuffer);
             // unsigned int* faceVertexIndices
-            unsigned int* pIdx = static_cast<unsigned int*>(
-                ibuf->lock(HardwareBuffer::HBL_DISCARD)
-                );
-            readInts(stream, pIdx, sm->indexData->indexCount);
-            ibuf->unlock();
+            if (!readBufferDirect(stream, ibuf.get()))
+            {
+                unsigned int* pIdx = static_cast<unsigned int*>(
+                    ibuf->lock(HardwareBuffer::HBL_DISCARD)
+                    );
+                readInts(stream, pIdx, sm->indexData->indexCount);
+                ibuf->unlock();
+            }
 
         }
         else // 16-bit
         {
-            ibuf = HardwareBufferManager::getSingleton().
-                createIndexBuffer(
-                    HardwareIndexBuffer::IT_16BIT,
-                    sm->indexData->indexCount,
-                    pMesh->mIndexBufferUsage,
-					pMesh->mIndexBufferShadowBuffer);
+            ibuf = createIndexBuffer(
+                HardwareIndexBuffer::IT_16BIT,
+                sm->indexData->indexCount,
+                pMesh->mIndexBufferUsage,
+				pMesh->mIndexBufferShadowBuffer);
             // unsigned short* faceVertexIndices
-            unsigned short* pIdx = static_cast<unsigned short*>(
-                ibuf->lock(HardwareBuffer::HBL_DISCARD)
-                );
-            readShorts(stream, pIdx, sm->indexData->indexCount);
-            ibuf->unlock();
+            if (!readBufferDirect(stream, ibuf.get()))
+            {
+                unsigned short* pIdx = static_cast<unsigned short*>(
+                    ibuf->lock(HardwareBuffer::HBL_DISCARD)
+                    );
+                readShorts(stream, pIdx, sm->indexData->indexCount);
+                ibuf->unlock();
+            }
         }
         sm->indexData->indexBuffer = ibuf;
 
@@ -1451,37 +1460,87 @@ namespace Ogre {
             // unsigned short*/int* faceIndexes;  ((v1, v2, v3) * numFaces)
             if (idx32Bit)
             {
-                indexData->indexBuffer = HardwareBufferManager::getSingleton().
-                    createIndexBuffer(HardwareIndexBuffer::IT_32BIT, indexData->indexCount,
+                indexData->indexBuffer = createIndexBuffer(
+                    HardwareIndexBuffer::IT_32BIT, indexData->indexCount,
                     pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                unsigned int* pIdx = static_cast<unsigned int*>(
-                    indexData->indexBuffer->lock(
-                        0,
-                        indexData->indexBuffer->getSizeInBytes(),
-                        HardwareBuffer::HBL_DISCARD) );
-
-			    readInts(stream, pIdx, indexData->indexCount);
-                indexData->indexBuffer->unlock();
+                if (!readBufferDirect(stream, indexData->indexBuffer.get()))
+                {
+                    unsigned int* pIdx = static_cast<unsigned int*>(
+                        indexData->indexBuffer->lock(
+                            0,
+                            indexData->indexBuffer->getSizeInBytes(),
+                            HardwareBuffer::HBL_DISCARD) );
+
+			        readInts(stream, pIdx, indexData->indexCount);
+                    indexData->indexBuffer->unlock();
+                }
 
             }
             else
             {
-                indexData->indexBuffer = HardwareBufferManager::getSingleton().
-                    createIndexBuffer(HardwareIndexBuffer::IT_16BIT, indexData->indexCount,
+                indexData->indexBuffer = createIndexBuffer(
+                    HardwareIndexBuffer::IT_16BIT, indexData->indexCount,
                     pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                unsigned short* pIdx = static_cast<unsigned short*>(
-                    indexData->indexBuffer->lock(
-                        0,
-                        indexData->indexBuffer->getSizeInBytes(),
-                        HardwareBuffer::HBL_DISCARD) );
-			    readShorts(stream, pIdx, indexData->indexCount);
-                indexData->indexBuffer->unlock();
+                if (!readBufferDirect(stream, indexData->indexBuffer.get()))
+                {
+                    unsigned short* pIdx = static_cast<unsigned short*>(
+                        indexData->indexBuffer->lock(
+                            0,
+                            indexData->indexBuffer->getSizeInBytes(),
+                            HardwareBuffer::HBL_DISCARD) );
+			        readShorts(stream, pIdx, indexData->indexCount);
+                    indexData->indexBuffer->unlock();
+                }
 
             }
 
 		}
 	}
     //---------------------------------------------------------------------
+    HardwareVertexBufferSharedPtr MeshSerializerImpl::createVertexBuffer(
+        size_t vertexSize, size_t numVerts, HardwareBuffer::Usage usage,
+        bool useShadowBuffer)
+    {
+        if (mDeferHardwareBuffers)
+        {
+            // Plain memory, not known to the render system; Mesh::loadImpl
+            // swaps it for a real buffer with the same usage and shadowing
+            return HardwareVertexBufferSharedPtr(
+                new DefaultHardwareVertexBuffer(vertexSize, numVerts, usage));
+        }
+        return HardwareBufferManager::getSingleton().createVertexBuffer(
+            vertexSize, numVerts, usage, useShadowBuffer);
+    }
+    //---------------------------------------------------------------------
+    HardwareIndexBufferSharedPtr MeshSerializerImpl::createIndexBuffer(
+        HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+        HardwareBuffer::Usage usage, bool useShadowBuffer)
+    {
+        if (mDeferHardwareBuffers)
+        {
+            return HardwareIndexBufferSharedPtr(
+                new DefaultHardwareIndexBuffer(itype, numIndexes, usage));
+        }
+        return HardwareBufferManager::getSingleton().createIndexBuffer(
+            itype, numIndexes, usage, useShadowBuffer);
+    }
+    //---------------------------------------------------------------------
+    bool MeshSerializerImpl::readBufferDirect(DataStreamPtr& stream, HardwareBuffer* buf)
+    {
+        if (mFlipEndian)
+            return false;
+
+        size_t bytes = buf->getSizeInBytes();
+        const uchar* pSrc = stream->getReadPtr(bytes);
+        if (!pSrc)
+            return false;
+
+        // Copy from the stream's memory (e.g. a mapped file) without staging
+        buf->writeData(0, bytes, pSrc, true);
+        stream->skip(static_cast<long>(bytes));
+        return true;
+    }
+    //---------------------------------------------------------------------
     void MeshSerializerImpl::flipFromLittleEndian(void* pData, size_t vertexCount,
         size_t vertexSize, const VertexDeclaration::VertexElementList& elems)
 	{
@@ -2387,10 +2446,9 @@ namespace Ogre {
 
 		// Create buffer, allow read and use shadow buffer
 		size_t vertexCount = track->getAssociatedVertexData()->vertexCount;
-		HardwareVertexBufferSharedPtr vbuf =
-			HardwareBufferManager::getSingleton().createVertexBuffer(
-				VertexElement::getTypeSize(VET_FLOAT3), vertexCount,
-				HardwareBuffer::HBU_STATIC, true);
+		HardwareVertexBufferSharedPtr vbuf = createVertexBuffer(
+			VertexElement::getTypeSize(VET_FLOAT3), vertexCount,
+			HardwareBuffer::HBU_STATIC, true);
 		// float x,y,z			// repeat by number of vertices in original geometry
 		float* pDst = static_cast<float*>(
 			vbuf->lock(HardwareBuffer::HBL_DISCARD));
@@ -2780,7 +2838,7 @@ namespace Ogre {
         HardwareVertexBufferSharedPtr vbuf;
         // float* pVertices (x, y, z order x numVertices)
         dest->vertexDeclaration->addElement(bindIdx, 0, VET_FLOAT3, VES_POSITION);
-        vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        vbuf = createVertexBuffer(
             dest->vertexDeclaration->getVertexSize(bindIdx),
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
@@ -2799,7 +2857,7 @@ namespace Ogre {
         HardwareVertexBufferSharedPtr vbuf;
         // float* pNormals (x, y, z order x numVertices)
         dest->vertexDeclaration->addElement(bindIdx, 0, VET_FLOAT3, VES_NORMAL);
-        vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        vbuf = createVertexBuffer(
             dest->vertexDeclaration->getVertexSize(bindIdx),
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
@@ -2818,7 +2876,7 @@ namespace Ogre {
         HardwareVertexBufferSharedPtr vbuf;
         // unsigned long* pColours (RGBA 8888 format x numVertices)
         dest->vertexDeclaration->addElement(bindIdx, 0, VET_COLOUR, VES_DIFFUSE);
-        vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        vbuf = createVertexBuffer(
             dest->vertexDeclaration->getVertexSize(bindIdx),
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
@@ -2845,7 +2903,7 @@ namespace Ogre {
             VertexElement::multiplyTypeCount(VET_FLOAT1, dim),
             VES_TEXTURE_COORDINATES,
             texCoordSet);
-        vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        vbuf = createVertexBuffer(
             dest->vertexDeclaration->getVertexSize(bindIdx),
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
@@ -2884,7 +2942,7 @@ namespace Ogre {
             VertexElement::multiplyTypeCount(VET_FLOAT1, dim),
             VES_TEXTURE_COORDINATES,
             texCoordSet);
-        vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        vbuf = createVertexBuffer(
             dest->vertexDeclaration->getVertexSize(bindIdx),
             dest->vertexCount,
             pMesh->getVertexBufferUsage(),
@@ -0,0 +1,419 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreMeshTriangleBVH.h"
+#include "OgreMesh.h"
+#include "OgreSubMesh.h"
+#include "OgreHardwareBufferManager.h"
+
+namespace Ogre {
+
+	namespace
+	{
+		/// Orders triangle indexes by the centre of their triangles along an axis
+		struct CentreLess
+		{
+			const std::vector<Vector3>* centres;
+			int axis;
+			CentreLess(const std::vector<Vector3>* c, int a) : centres(c), axis(a) {}
+			bool operator()(size_t a, size_t b) const
+			{
+				return (*centres)[a][axis] < (*centres)[b][axis];
+			}
+		};
+
+		/// Distance along the ray to the box, if it is hit within maxDistance
+		inline bool rayHitsBox(const Vector3& origin, const Vector3& direction, 
+			const Vector3& invDirection, const Vector3& minimum, const Vector3& maximum,
+			Real maxDistance, Real& distance)
+		{
+			Real tmin = 0;
+			Real tmax = maxDistance;
+			for (int i = 0; i < 3; ++i)
+			{
+				if (direction[i] == 0)
+				{
+					if (origin[i] < minimum[i] || origin[i] > maximum[i])
+						return false;
+				}
+				else
+				{
+					Real t1 = (minimum[i] - origin[i]) * invDirection[i];
+					Real t2 = (maximum[i] - origin[i]) * invDirection[i];
+					if (t1 > t2)
+						std::swap(t1, t2);
+					if (t1 > tmin)
+						tmin = t1;
+					if (t2 < tmax)
+						tmax = t2;
+					if (tmin > tmax)
+						return false;
+				}
+			}
+			distance = tmin;
+			return true;
+		}
+	}
+	//-----------------------------------------------------------------------
+	MeshTriangleBVH::MeshTriangleBVH(const Mesh* mesh)
+		: mNumSharedVertices(0)
+	{
+		// Gather positions, shared vertex data first
+		if (mesh->sharedVertexData)
+		{
+			mNumSharedVertices = mesh->sharedVertexData->vertexCount;
+			mPositions.resize(mNumSharedVertices);
+			if (mNumSharedVertices)
+				readPositions(mesh->sharedVertexData, &mPositions[0]);
+		}
+		ushort numSubMeshes = mesh->getNumSubMeshes();
+		mSubMeshFirstVertex.resize(numSubMeshes, 0);
+		for (ushort s = 0; s < numSubMeshes; ++s)
+		{
+			SubMesh* sub = mesh->getSubMesh(s);
+			if (sub->useSharedVertices || !sub->vertexData)
+				continue;
+			size_t first = mPositions.size();
+			mSubMeshFirstVertex[s] = first;
+			mPositions.resize(first + sub->vertexData->vertexCount);
+			if (sub->vertexData->vertexCount)
+				readPositions(sub->vertexData, &mPositions[first]);
+		}
+
+		// Then the triangles of every sub mesh
+		for (ushort s = 0; s < numSubMeshes; ++s)
+		{
+			SubMesh* sub = mesh->getSubMesh(s);
+			addTriangles(sub->indexData, sub->operationType, 
+				mSubMeshFirstVertex[s], s);
+		}
+
+		if (mTriangles.empty())
+			return;
+
+		std::vector<Vector3> centres;
+		centres.reserve(mTriangles.size());
+		for (TriangleList::iterator t = mTriangles.begin(); t != mTriangles.end(); ++t)
+		{
+			centres.push_back((mPositions[t->vertex[0]] + mPositions[t->vertex[1]] +
+				mPositions[t->vertex[2]]) / 3);
+		}
+		// A binary tree with leaves of up to MAX_LEAF_TRIANGLES triangles
+		mNodes.reserve(2 * (mTriangles.size() / MAX_LEAF_TRIANGLES + 1));
+		std::vector<size_t> order(mTriangles.size());
+		for (size_t t = 0; t < order.size(); ++t)
+			order[t] = t;
+		mNodes.push_back(TreeNode());
+		buildNode(0, 0, mTriangles.size(), centres, order);
+
+		// Store the triangles in tree order, so that leaves refer to ranges
+		TriangleList sorted(mTriangles.size());
+		for (size_t t = 0; t < order.size(); ++t)
+			sorted[t] = mTriangles[order[t]];
+		mTriangles.swap(sorted);
+	}
+	//-----------------------------------------------------------------------
+	MeshTriangleBVH::~MeshTriangleBVH()
+	{
+	}
+	//-----------------------------------------------------------------------
+	void MeshTriangleBVH::readPositions(const VertexData* vertexData, Vector3* dest)
+	{
+		const VertexElement* posElem = 
+			vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+		HardwareVertexBufferSharedPtr vbuf = 
+			vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+		unsigned char* vertex = static_cast<unsigned char*>(
+			vbuf->lock(HardwareBuffer::HBL_READ_ONLY)) + 
+			vertexData->vertexStart * vbuf->getVertexSize();
+		float* pFloat;
+		for (size_t v = 0; v < vertexData->vertexCount; ++v)
+		{
+			posElem->baseVertexPointerToElement(vertex, &pFloat);
+			dest[v].x = pFloat[0];
+			dest[v].y = pFloat[1];
+			dest[v].z = pFloat[2];
+			vertex += vbuf->getVertexSize();
+		}
+		vbuf->unlock();
+	}
+	//-----------------------------------------------------------------------
+	void MeshTriangleBVH::addTriangles(const IndexData* indexData, 
+		RenderOperation::OperationType opType, size_t firstVertex, ushort subMeshIndex)
+	{
+		if (opType != RenderOperation::OT_TRIANGLE_LIST &&
+			opType != RenderOperation::OT_TRIANGLE_STRIP &&
+			opType != RenderOperation::OT_TRIANGLE_FAN)
+			return;
+		if (!indexData || indexData->indexCount < 3)
+			return;
+
+		// Read the indexes first, whatever their size
+		std::vector<uint32> indexes(indexData->indexCount);
+		HardwareIndexBufferSharedPtr ibuf = indexData->indexBuffer;
+		if (ibuf->getType() == HardwareIndexBuffer::IT_32BIT)
+		{
+			const uint32* pIdx = static_cast<const uint32*>(
+				ibuf->lock(HardwareBuffer::HBL_READ_ONLY)) + indexData->indexStart;
+			std::copy(pIdx, pIdx + indexData->indexCount, indexes.begin());
+		}
+		else
+		{
+			const uint16* pIdx = static_cast<const uint16*>(
+				ibuf->lock(HardwareBuffer::HBL_READ_ONLY)) + indexData->indexStart;
+			std::copy(pIdx, pIdx + indexData->indexCount, indexes.begin());
+		}
+		ibuf->unlock();
+
+		size_t numTriangles = opType == RenderOperation::OT_TRIANGLE_LIST ?
+			indexes.size() / 3 : indexes.size() - 2;
+		mTriangles.reserve(mTriangles.size() + numTriangles);
+		Triangle tri;
+		tri.subMeshIndex = subMeshIndex;
+		for (size_t t = 0; t < numTriangles; ++t)
+		{
+			size_t i0, i1, i2;
+			switch (opType)
+			{
+			case RenderOperation::OT_TRIANGLE_LIST:
+				i0 = t * 3;
+				i1 = i0 + 1;
+				i2 = i0 + 2;
+				break;
+			case RenderOperation::OT_TRIANGLE_STRIP:
+				i0 = t;
+				i1 = t + 1;
+				i2 = t + 2;
+				break;
+			default:
+				i0 = 0;
+				i1 = t + 1;
+				i2 = t + 2;
+				break;
+			}
+			// Skip the degenerate triangles joining strips
+			if (indexes[i0] == indexes[i1] || indexes[i1] == indexes[i2] || 
+				indexes[i0] == indexes[i2])
+				continue;
+			tri.vertex[0] = static_cast<uint32>(firstVertex + indexes[i0]);
+			tri.vertex[1] = static_cast<uint32>(firstVertex + indexes[i1]);
+			tri.vertex[2] = static_cast<uint32>(firstVertex + indexes[i2]);
+			tri.triangleIndex = static_cast<uint32>(t);
+			mTriangles.push_back(tri);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void MeshTriangleBVH::buildNode(size_t nodeIndex, size_t begin, size_t end, 
+		const std::vector<Vector3>& centres, std::vector<size_t>& order)
+	{
+		// Bound the triangles
+		Vector3 minimum = mPositions[mTriangles[order[begin]].vertex[0]];
+		Vector3 maximum = minimum;
+		Vector3 centreMin = centres[order[begin]];
+		Vector3 centreMax = centreMin;
+		for (size_t t = begin; t < end; ++t)
+		{
+			const Triangle& tri = mTriangles[order[t]];
+			for (int v = 0; v < 3; ++v)
+			{
+				minimum.makeFloor(mPositions[tri.vertex[v]]);
+				maximum.makeCeil(mPositions[tri.vertex[v]]);
+			}
+			centreMin.makeFloor(centres[order[t]]);
+			centreMax.makeCeil(centres[order[t]]);
+		}
+		mNodes[nodeIndex].minimum = minimum;
+		mNodes[nodeIndex].maximum = maximum;
+
+		Vector3 extent = centreMax - centreMin;
+		if (end - begin <= MAX_LEAF_TRIANGLES || extent == Vector3::ZERO)
+		{
+			mNodes[nodeIndex].start = static_cast<uint32>(begin);
+			mNodes[nodeIndex].count = static_cast<uint32>(end - begin);
+			return;
+		}
+
+		// Split at the median centre along the longest axis
+		int axis = 0;
+		if (extent.y > extent[axis])
+			axis = 1;
+		if (extent.z > extent[axis])
+			axis = 2;
+		size_t middle = begin + (end - begin) / 2;
+		std::nth_element(order.begin() + begin, order.begin() + middle, 
+			order.begin() + end, CentreLess(&centres, axis));
+
+		// First child follows this node, the second follows the first's subtree
+		mNodes[nodeIndex].count = 0;
+		mNodes.push_back(TreeNode());
+		buildNode(nodeIndex + 1, begin, middle, centres, order);
+		size_t second = mNodes.size();
+		mNodes[nodeIndex].start = static_cast<uint32>(second);
+		mNodes.push_back(TreeNode());
+		buildNode(second, middle, end, centres, order);
+	}
+	//-----------------------------------------------------------------------
+	bool MeshTriangleBVH::intersectTriangle(const Ray& ray, const Vector3& a, 
+		const Vector3& b, const Vector3& c, Real& distance, Vector3& barycentric)
+	{
+		// Moller-Trumbore, accepting either side of the triangle
+		const Vector3& direction = ray.getDirection();
+		Vector3 edge1 = b - a;
+		Vector3 edge2 = c - a;
+		Vector3 p = direction.crossProduct(edge2);
+		Real det = edge1.dotProduct(p);
+		if (det == 0)
+			return false;
+		Real invDet = 1 / det;
+
+		Vector3 s = ray.getOrigin() - a;
+		Real u = s.dotProduct(p) * invDet;
+		if (u < 0 || u > 1)
+			return false;
+		Vector3 q = s.crossProduct(edge1);
+		Real v = direction.dotProduct(q) * invDet;
+		if (v < 0 || u + v > 1)
+			return false;
+		Real t = edge2.dotProduct(q) * invDet;
+		if (t < 0 || t >= distance)
+			return false;
+
+		distance = t;
+		barycentric.x = 1 - u - v;
+		barycentric.y = u;
+		barycentric.z = v;
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	bool MeshTriangleBVH::intersect(const Ray& ray, MeshTriangleHit& hit) const
+	{
+		if (mNodes.empty())
+			return false;
+
+		const Vector3& origin = ray.getOrigin();
+		const Vector3& direction = ray.getDirection();
+		Vector3 invDirection;
+		for (int i = 0; i < 3; ++i)
+			invDirection[i] = direction[i] != 0 ? 1 / direction[i] : 0;
+
+		Real closest = std::numeric_limits<Real>::max();
+		const Triangle* closestTriangle = 0;
+		Vector3 barycentric;
+
+		// Visit the nearer child first, so that the further one can often be
+		// skipped altogether
+		size_t stack[MAX_TREE_DEPTH + 1];
+		size_t top = 0;
+		stack[top++] = 0;
+		while (top)
+		{
+			const TreeNode& node = mNodes[stack[--top]];
+			Real entry;
+			if (!rayHitsBox(origin, direction, invDirection, 
+				node.minimum, node.maximum, closest, entry))
+				continue;
+
+			if (node.count)
+			{
+				for (uint32 t = node.start; t < node.start + node.count; ++t)
+				{
+					const Triangle& tri = mTriangles[t];
+					if (intersectTriangle(ray, mPositions[tri.vertex[0]], 
+						mPositions[tri.vertex[1]], mPositions[tri.vertex[2]], 
+						closest, barycentric))
+					{
+						closestTriangle = &tri;
+						hit.barycentric = barycentric;
+					}
+				}
+			}
+			else
+			{
+				size_t first = &node - &mNodes[0] + 1;
+				size_t second = node.start;
+				Real firstEntry, secondEntry;
+				bool hitFirst = rayHitsBox(origin, direction, invDirection, 
+					mNodes[first].minimum, mNodes[first].maximum, closest, firstEntry);
+				bool hitSecond = rayHitsBox(origin, direction, invDirection, 
+					mNodes[second].minimum, mNodes[second].maximum, closest, secondEntry);
+				if (hitFirst && hitSecond)
+				{
+					// Push the further one first so the nearer is popped first
+					if (firstEntry < secondEntry)
+						std::swap(first, second);
+					stack[top++] = first;
+					stack[top++] = second;
+				}
+				else if (hitFirst)
+				{
+					stack[top++] = first;
+				}
+				else if (hitSecond)
+				{
+					stack[top++] = second;
+				}
+			}
+		}
+
+		if (!closestTriangle)
+			return false;
+		hit.distance = closest;
+		hit.subMeshIndex = closestTriangle->subMeshIndex;
+		hit.triangleIndex = closestTriangle->triangleIndex;
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	bool MeshTriangleBVH::intersect(const Ray& ray, const std::vector<Vector3>& positions,
+		MeshTriangleHit& hit) const
+	{
+		assert(positions.size() == mPositions.size() && 
+			"Positions must be laid out as getPositions()");
+
+		Real closest = std::numeric_limits<Real>::max();
+		const Triangle* closestTriangle = 0;
+		Vector3 barycentric;
+		for (TriangleList::const_iterator t = mTriangles.begin(); t != mTriangles.end(); ++t)
+		{
+			if (intersectTriangle(ray, positions[t->vertex[0]], 
+				positions[t->vertex[1]], positions[t->vertex[2]], closest, barycentric))
+			{
+				closestTriangle = &*t;
+				hit.barycentric = barycentric;
+			}
+		}
+
+		if (!closestTriangle)
+			return false;
+		hit.distance = closest;
+		hit.subMeshIndex = closestTriangle->subMeshIndex;
+		hit.triangleIndex = closestTriangle->triangleIndex;
+		return true;
+	}
+
+}
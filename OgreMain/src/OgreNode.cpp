@@ -38,11 +38,13 @@ Torus Knot Software Ltd.
 #include "OgreMesh.h"
 #include "OgreSubMesh.h"
 #include "OgreCamera.h"
+#include "OgreNodeTransformStore.h"
 
 namespace Ogre {
 
     unsigned long Node::msNextGeneratedNameExt = 1;
 	Node::QueuedUpdates Node::msQueuedUpdates;
+	OGRE_STATIC_MUTEX_INSTANCE(Node::msQueuedUpdatesMutex)
     //-----------------------------------------------------------------------
     Node::Node()
 		:mParent(0),
@@ -62,7 +64,9 @@ namespace Ogre {
 		mInitialOrientation(Quaternion::IDENTITY),
 		mInitialScale(Vector3::UNIT_SCALE),
 		mCachedTransformOutOfDate(true),
-		mListener(0)
+		mListener(0),
+		mTransformStore(0),
+		mTransformStoreIndex(0)
     {
         // Generate a name
 		StringUtil::StrStreamType str;
@@ -92,7 +96,9 @@ namespace Ogre {
 		mInitialOrientation(Quaternion::IDENTITY),
 		mInitialScale(Vector3::UNIT_SCALE),
 		mCachedTransformOutOfDate(true),
-		mListener(0)
+		mListener(0),
+		mTransformStore(0),
+		mTransformStoreIndex(0)
 
     {
 
@@ -109,12 +115,19 @@ namespace Ogre {
 			mListener->nodeDestroyed(this);
 		}
 
+		if (mTransformStore)
+		{
+			mTransformStore->_notifyNodeDestroyed(mTransformStoreIndex, this);
+			mTransformStore = 0;
+		}
+
 		removeAllChildren();
 		if(mParent)
 			mParent->removeChild(this);
 
         if (mQueuedForUpdate)
         {
+			OGRE_LOCK_MUTEX(msQueuedUpdatesMutex)
             // Erase from queued updates
             QueuedUpdates::iterator it =
                 std::find(msQueuedUpdates.begin(), msQueuedUpdates.end(), this);
@@ -138,6 +151,15 @@ namespace Ogre {
     {
 		bool different = (parent != mParent);
 
+		// Move this node's subtree between transform stores, or within one
+		if (different)
+		{
+			if (mTransformStore)
+				mTransformStore->_notifyNodeRemoved(this);
+			if (parent && parent->mTransformStore)
+				parent->mTransformStore->_notifyNodeAdded(this);
+		}
+
         mParent = parent;
         // Request update from parent
 		mParentNotified = false ;
@@ -218,6 +240,39 @@ namespace Ogre {
         mNeedChildUpdate = false;
 
     }
+	//-----------------------------------------------------------------------
+	void Node::_updateCollectChildren(bool parentHasChanged, PendingUpdateList& children)
+	{
+		// Mirrors _update(true, parentHasChanged), except for the recursion
+		mParentNotified = false;
+
+		if (mNeedParentUpdate || parentHasChanged)
+		{
+			_updateFromParent();
+		}
+
+		if (mNeedChildUpdate || parentHasChanged)
+		{
+			ChildNodeMap::iterator it, itend;
+			itend = mChildren.end();
+			for (it = mChildren.begin(); it != itend; ++it)
+			{
+				children.push_back(PendingUpdate(it->second, true));
+			}
+		}
+		else
+		{
+			ChildUpdateSet::iterator it, itend;
+			itend = mChildrenToUpdate.end();
+			for(it = mChildrenToUpdate.begin(); it != itend; ++it)
+			{
+				children.push_back(PendingUpdate(*it, false));
+			}
+		}
+
+		mChildrenToUpdate.clear();
+		mNeedChildUpdate = false;
+	}
 	//-----------------------------------------------------------------------
 	void Node::_updateFromParent(void) const
 	{
@@ -279,6 +334,36 @@ namespace Ogre {
 		mNeedParentUpdate = false;
 
     }
+	//-----------------------------------------------------------------------
+	void Node::_updateFromTransformStore(const Quaternion& derivedOrientation,
+		const Vector3& derivedPosition, const Vector3& derivedScale) const
+	{
+		updateFromTransformStoreImpl(derivedOrientation, derivedPosition, derivedScale);
+
+		// Call listener (note, this method only called if there's something to do)
+		if (mListener)
+		{
+			mListener->nodeUpdated(this);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void Node::updateFromTransformStoreImpl(const Quaternion& derivedOrientation,
+		const Vector3& derivedPosition, const Vector3& derivedScale) const
+	{
+		mDerivedOrientation = derivedOrientation;
+		mDerivedPosition = derivedPosition;
+		mDerivedScale = derivedScale;
+
+		mCachedTransformOutOfDate = true;
+		mNeedParentUpdate = false;
+	}
+	//-----------------------------------------------------------------------
+	void Node::_transformStoreUpdateComplete(bool moved)
+	{
+		mParentNotified = false;
+		mChildrenToUpdate.clear();
+		mNeedChildUpdate = false;
+	}
     //-----------------------------------------------------------------------
     Node* Node::createChild(const Vector3& translate, const Quaternion& rotate)
     {
@@ -756,8 +841,13 @@ namespace Ogre {
 		mNeedChildUpdate = true;
         mCachedTransformOutOfDate = true;
 
+		if (mTransformStore)
+		{
+			// The store tracks what needs updating, no need to involve parents
+			mTransformStore->_notifyNodeDirty(mTransformStoreIndex);
+		}
         // Make sure we're not root and parent hasn't been notified before
-        if (mParent && (!mParentNotified || forceParentUpdate))
+        else if (mParent && (!mParentNotified || forceParentUpdate))
         {
             mParent->requestUpdate(this, forceParentUpdate);
 			mParentNotified = true ;
@@ -799,6 +889,7 @@ namespace Ogre {
 	//-----------------------------------------------------------------------
 	void Node::queueNeedUpdate(Node* n)
 	{
+		OGRE_LOCK_MUTEX(msQueuedUpdatesMutex)
         // Don't queue the node more than once
         if (!n->mQueuedForUpdate)
         {
@@ -809,6 +900,7 @@ namespace Ogre {
 	//-----------------------------------------------------------------------
 	void Node::processQueuedUpdates(void)
 	{
+		OGRE_LOCK_MUTEX(msQueuedUpdatesMutex)
 		for (QueuedUpdates::iterator i = msQueuedUpdates.begin();
 			i != msQueuedUpdates.end(); ++i)
 		{
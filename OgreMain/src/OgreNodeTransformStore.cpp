@@ -0,0 +1,655 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreNodeTransformStore.h"
+#include "OgreNode.h"
+
+namespace Ogre {
+
+	namespace
+	{
+		/// Subtree laid out during NodeTransformStore::relayout
+		struct SubtreeInsertion
+		{
+			/// Index in the old layout the subtree goes in front of
+			size_t position;
+			/// Index of the parent of the subtree in the old layout
+			size_t parent;
+			/// First node and number of nodes of the subtree in the list of laid out nodes
+			size_t first, count;
+
+			bool operator<(const SubtreeInsertion& rhs) const
+			{
+				// Subtrees of nested parents can go in at the same position;
+				// those of the innermost parent must come first to keep the 
+				// subtree of every node contiguous
+				if (position != rhs.position)
+					return position < rhs.position;
+				return parent > rhs.parent;
+			}
+		};
+
+		/// Run of nodes kept in order from the old layout to the new one
+		struct LayoutRun
+		{
+			size_t source, dest, count;
+			LayoutRun(size_t s, size_t d, size_t c) : source(s), dest(d), count(c) {}
+		};
+	}
+	//-----------------------------------------------------------------------
+	NodeTransformStore::NodeTransformStore(Node* root)
+		: mRoot(root)
+		, mHierarchyChanged(true)
+	{
+	}
+	//-----------------------------------------------------------------------
+	NodeTransformStore::~NodeTransformStore()
+	{
+		clear();
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::getRealArrays(std::vector<Real>** arrays)
+	{
+		*arrays++ = &mOrientationW;
+		*arrays++ = &mOrientationX;
+		*arrays++ = &mOrientationY;
+		*arrays++ = &mOrientationZ;
+		*arrays++ = &mPositionX;
+		*arrays++ = &mPositionY;
+		*arrays++ = &mPositionZ;
+		*arrays++ = &mScaleX;
+		*arrays++ = &mScaleY;
+		*arrays++ = &mScaleZ;
+		*arrays++ = &mDerivedOrientationW;
+		*arrays++ = &mDerivedOrientationX;
+		*arrays++ = &mDerivedOrientationY;
+		*arrays++ = &mDerivedOrientationZ;
+		*arrays++ = &mDerivedPositionX;
+		*arrays++ = &mDerivedPositionY;
+		*arrays++ = &mDerivedPositionZ;
+		*arrays++ = &mDerivedScaleX;
+		*arrays++ = &mDerivedScaleY;
+		*arrays++ = &mDerivedScaleZ;
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::clear(void)
+	{
+		NodeList::iterator i, iend;
+		iend = mNodes.end();
+		for (i = mNodes.begin(); i != iend; ++i)
+		{
+			if (*i)
+				(*i)->_notifyTransformStore(0, 0);
+		}
+		iend = mPendingNodes.end();
+		for (i = mPendingNodes.begin(); i != iend; ++i)
+		{
+			(*i)->_notifyTransformStore(0, 0);
+		}
+		mNodes.clear();
+		mParents.clear();
+		mSubtreeEnds.clear();
+		mFlags.clear();
+		mDirtyNodes.clear();
+		mRemovedNodes.clear();
+		mTouchedNodes.clear();
+		mPendingNodes.clear();
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::layOutSubtree(Node* node, NodeList& nodes, IndexList& parents)
+	{
+		// Depth first traversal, with an explicit stack of nodes and the
+		// indices of their parents
+		std::vector<std::pair<Node*, size_t> > stack;
+		const size_t base = nodes.size();
+		stack.push_back(std::pair<Node*, size_t>(node, 0));
+		while (!stack.empty())
+		{
+			Node* current = stack.back().first;
+			parents.push_back(stack.back().second);
+			stack.pop_back();
+
+			const size_t index = nodes.size() - base;
+			nodes.push_back(current);
+			Node::ChildNodeIterator it = current->getChildIterator();
+			while (it.hasMoreElements())
+			{
+				stack.push_back(std::pair<Node*, size_t>(it.getNext(), index));
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::calculateSubtreeEnds(void)
+	{
+		const size_t count = mNodes.size();
+		mSubtreeEnds.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			mSubtreeEnds[i] = i + 1;
+		}
+		// Going backwards, the end of each node is final before it is 
+		// passed up to the parent
+		for (size_t i = count; i-- > 1; )
+		{
+			size_t& parentEnd = mSubtreeEnds[mParents[i]];
+			if (mSubtreeEnds[i] > parentEnd)
+				parentEnd = mSubtreeEnds[i];
+		}
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::rebuild(void)
+	{
+		clear();
+		mHierarchyChanged = false;
+		if (!mRoot)
+			return;
+
+		// The root comes out as its own parent
+		layOutSubtree(mRoot, mNodes, mParents);
+
+		size_t count = mNodes.size();
+		std::vector<Real>* arrays[NUM_REAL_ARRAYS];
+		getRealArrays(arrays);
+		for (size_t a = 0; a < NUM_REAL_ARRAYS; ++a)
+		{
+			arrays[a]->resize(count);
+		}
+
+		// Everything needs recalculating once laid out again
+		mFlags.assign(count, NF_DIRTY);
+		mDirtyNodes.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			mDirtyNodes[i] = i;
+			mNodes[i]->_notifyTransformStore(this, i);
+		}
+		calculateSubtreeEnds();
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::relayout(void)
+	{
+		const size_t oldCount = mNodes.size();
+		const size_t removed = PENDING_INDEX;
+		// Index of each node in the new layout, or removed
+		IndexList newIndices(oldCount, 0);
+
+		// Drop the subtrees which left their place in the hierarchy; any of 
+		// their nodes which are still attached are laid out again below
+		std::sort(mRemovedNodes.begin(), mRemovedNodes.end());
+		size_t numRemoved = 0;
+		size_t removedEnd = 0;
+		IndexList::iterator i, iend;
+		iend = mRemovedNodes.end();
+		for (i = mRemovedNodes.begin(); i != iend; ++i)
+		{
+			if (*i < removedEnd)
+				continue;
+			removedEnd = mSubtreeEnds[*i];
+			numRemoved += removedEnd - *i;
+			for (size_t n = *i; n < removedEnd; ++n)
+			{
+				if (mNodes[n])
+					mNodes[n]->_notifyTransformStore(0, 0);
+				newIndices[n] = removed;
+			}
+		}
+		mRemovedNodes.clear();
+
+		// Lay out the subtrees attached since the last update, each to go
+		// where the subtree of its parent ends
+		std::vector<SubtreeInsertion> insertions;
+		NodeList insertedNodes;
+		IndexList insertedParents;
+		NodeList::iterator p, pend;
+		pend = mPendingNodes.end();
+		for (p = mPendingNodes.begin(); p != pend; ++p)
+		{
+			Node* node = *p;
+			// Already laid out along with a pending ancestor?
+			if (node->_getTransformStore() != this || 
+				node->_getTransformStoreIndex() != PENDING_INDEX)
+				continue;
+
+			Node* parent = node->getParent();
+			while (parent && parent->_getTransformStore() == this && 
+				parent->_getTransformStoreIndex() == PENDING_INDEX)
+			{
+				node = parent;
+				parent = node->getParent();
+			}
+
+			if (parent && parent->_getTransformStore() == this)
+			{
+				SubtreeInsertion insertion;
+				insertion.parent = parent->_getTransformStoreIndex();
+				insertion.position = mSubtreeEnds[insertion.parent];
+				insertion.first = insertedNodes.size();
+				layOutSubtree(node, insertedNodes, insertedParents);
+				insertion.count = insertedNodes.size() - insertion.first;
+				insertions.push_back(insertion);
+				// No longer pending, the real index is handed out below
+				for (size_t n = insertion.first; n < insertedNodes.size(); ++n)
+				{
+					insertedNodes[n]->_notifyTransformStore(this, 0);
+				}
+			}
+			else
+			{
+				// The parent has left the hierarchy since
+				NodeList detached;
+				IndexList unused;
+				layOutSubtree(node, detached, unused);
+				for (NodeList::iterator d = detached.begin(); d != detached.end(); ++d)
+				{
+					if ((*d)->_getTransformStore() == this)
+						(*d)->_notifyTransformStore(0, 0);
+				}
+			}
+		}
+		mPendingNodes.clear();
+		std::sort(insertions.begin(), insertions.end());
+
+		// Merge the kept nodes of the old layout with the new subtrees
+		const size_t newCount = oldCount - numRemoved + insertedNodes.size();
+		NodeList nodes;
+		IndexList parents;
+		std::vector<uint8> flags;
+		IndexList dirtyNodes;
+		std::vector<LayoutRun> runs;
+		nodes.reserve(newCount);
+		parents.reserve(newCount);
+		flags.reserve(newCount);
+		dirtyNodes.reserve(mDirtyNodes.size() + insertedNodes.size());
+
+		std::vector<SubtreeInsertion>::const_iterator ins = insertions.begin();
+		for (size_t o = 0; ; ++o)
+		{
+			for (; ins != insertions.end() && ins->position == o; ++ins)
+			{
+				const size_t base = nodes.size();
+				for (size_t k = 0; k < ins->count; ++k)
+				{
+					Node* node = insertedNodes[ins->first + k];
+					const size_t index = nodes.size();
+					nodes.push_back(node);
+					parents.push_back(k ? 
+						base + insertedParents[ins->first + k] : newIndices[ins->parent]);
+					flags.push_back(NF_DIRTY);
+					dirtyNodes.push_back(index);
+					node->_notifyTransformStore(this, index);
+				}
+			}
+			if (o == oldCount)
+				break;
+			if (newIndices[o] == removed)
+				continue;
+
+			const size_t index = nodes.size();
+			newIndices[o] = index;
+			nodes.push_back(mNodes[o]);
+			parents.push_back(newIndices[mParents[o]]);
+			flags.push_back(mFlags[o]);
+			if (index != o)
+				mNodes[o]->_notifyTransformStore(this, index);
+
+			if (!runs.empty() && runs.back().source + runs.back().count == o && 
+				runs.back().dest + runs.back().count == index)
+				++runs.back().count;
+			else
+				runs.push_back(LayoutRun(o, index, 1));
+		}
+
+		// Move the transforms of the kept nodes with them; the new nodes 
+		// are dirty, so theirs are filled in by the update
+		std::vector<Real>* arrays[NUM_REAL_ARRAYS];
+		getRealArrays(arrays);
+		std::vector<Real> values;
+		for (size_t a = 0; a < NUM_REAL_ARRAYS; ++a)
+		{
+			values.resize(newCount);
+			std::vector<LayoutRun>::const_iterator r, rend;
+			rend = runs.end();
+			for (r = runs.begin(); r != rend; ++r)
+			{
+				std::copy(arrays[a]->begin() + r->source, 
+					arrays[a]->begin() + r->source + r->count, values.begin() + r->dest);
+			}
+			arrays[a]->swap(values);
+		}
+
+		// Carry over the records of kept nodes
+		iend = mDirtyNodes.end();
+		for (i = mDirtyNodes.begin(); i != iend; ++i)
+		{
+			if (newIndices[*i] != removed)
+				dirtyNodes.push_back(newIndices[*i]);
+		}
+		size_t numTouched = 0;
+		iend = mTouchedNodes.end();
+		for (i = mTouchedNodes.begin(); i != iend; ++i)
+		{
+			if (newIndices[*i] != removed)
+				mTouchedNodes[numTouched++] = newIndices[*i];
+		}
+		mTouchedNodes.resize(numTouched);
+
+		mNodes.swap(nodes);
+		mParents.swap(parents);
+		mFlags.swap(flags);
+		mDirtyNodes.swap(dirtyNodes);
+		calculateSubtreeEnds();
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::fetchLocalTransform(size_t index)
+	{
+		const Node* node = mNodes[index];
+		if (!node)
+			return;
+
+		const Quaternion& orientation = node->getOrientation();
+		mOrientationW[index] = orientation.w;
+		mOrientationX[index] = orientation.x;
+		mOrientationY[index] = orientation.y;
+		mOrientationZ[index] = orientation.z;
+		const Vector3& position = node->getPosition();
+		mPositionX[index] = position.x;
+		mPositionY[index] = position.y;
+		mPositionZ[index] = position.z;
+		const Vector3& scale = node->getScale();
+		mScaleX[index] = scale.x;
+		mScaleY[index] = scale.y;
+		mScaleZ[index] = scale.z;
+
+		uint8 flags = mFlags[index] & ~(NF_INHERIT_ORIENTATION | NF_INHERIT_SCALE);
+		if (node->getInheritOrientation())
+			flags |= NF_INHERIT_ORIENTATION;
+		if (node->getInheritScale())
+			flags |= NF_INHERIT_SCALE;
+		mFlags[index] = flags;
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::calculateDerivedTransforms(void)
+	{
+		const size_t count = mNodes.size();
+		if (!count)
+			return;
+
+		uint8* flags = &mFlags[0];
+		const size_t* parents = &mParents[0];
+		const Real* ow = &mOrientationW[0];
+		const Real* ox = &mOrientationX[0];
+		const Real* oy = &mOrientationY[0];
+		const Real* oz = &mOrientationZ[0];
+		const Real* px = &mPositionX[0];
+		const Real* py = &mPositionY[0];
+		const Real* pz = &mPositionZ[0];
+		const Real* sx = &mScaleX[0];
+		const Real* sy = &mScaleY[0];
+		const Real* sz = &mScaleZ[0];
+		Real* dow = &mDerivedOrientationW[0];
+		Real* dox = &mDerivedOrientationX[0];
+		Real* doy = &mDerivedOrientationY[0];
+		Real* doz = &mDerivedOrientationZ[0];
+		Real* dpx = &mDerivedPositionX[0];
+		Real* dpy = &mDerivedPositionY[0];
+		Real* dpz = &mDerivedPositionZ[0];
+		Real* dsx = &mDerivedScaleX[0];
+		Real* dsy = &mDerivedScaleY[0];
+		Real* dsz = &mDerivedScaleZ[0];
+
+		RangeList::const_iterator r, rend;
+		rend = mUpdateRanges.end();
+		for (r = mUpdateRanges.begin(); r != rend; ++r)
+		{
+			size_t i = r->first;
+			if (i == 0)
+			{
+				// Root node, no parent
+				dow[0] = ow[0]; dox[0] = ox[0]; doy[0] = oy[0]; doz[0] = oz[0];
+				dpx[0] = px[0]; dpy[0] = py[0]; dpz[0] = pz[0];
+				dsx[0] = sx[0]; dsy[0] = sy[0]; dsz[0] = sz[0];
+				flags[0] |= NF_UPDATED;
+				++i;
+			}
+
+			// Every parent is laid out before its children, so one forward pass
+			// sees the final derived transform of each parent. The parent of the
+			// first node of the range is outside it and up to date already. The
+			// maths is the same as Node::updateFromParentImpl, written out per 
+			// component.
+			for (; i < r->second; ++i)
+			{
+				const size_t p = parents[i];
+				flags[i] |= NF_UPDATED;
+
+				const Real pw = dow[p], pqx = dox[p], pqy = doy[p], pqz = doz[p];
+				const Real psx = dsx[p], psy = dsy[p], psz = dsz[p];
+
+				// Update orientation
+				if (flags[i] & NF_INHERIT_ORIENTATION)
+				{
+					// Combine orientation with that of parent
+					dow[i] = pw * ow[i] - pqx * ox[i] - pqy * oy[i] - pqz * oz[i];
+					dox[i] = pw * ox[i] + pqx * ow[i] + pqy * oz[i] - pqz * oy[i];
+					doy[i] = pw * oy[i] + pqy * ow[i] + pqz * ox[i] - pqx * oz[i];
+					doz[i] = pw * oz[i] + pqz * ow[i] + pqx * oy[i] - pqy * ox[i];
+				}
+				else
+				{
+					dow[i] = ow[i]; dox[i] = ox[i]; doy[i] = oy[i]; doz[i] = oz[i];
+				}
+
+				// Update scale
+				if (flags[i] & NF_INHERIT_SCALE)
+				{
+					dsx[i] = psx * sx[i];
+					dsy[i] = psy * sy[i];
+					dsz[i] = psz * sz[i];
+				}
+				else
+				{
+					dsx[i] = sx[i]; dsy[i] = sy[i]; dsz[i] = sz[i];
+				}
+
+				// Change position vector based on parent's orientation & scale
+				const Real vx = psx * px[i], vy = psy * py[i], vz = psz * pz[i];
+				Real uvx = pqy * vz - pqz * vy;
+				Real uvy = pqz * vx - pqx * vz;
+				Real uvz = pqx * vy - pqy * vx;
+				Real uuvx = pqy * uvz - pqz * uvy;
+				Real uuvy = pqz * uvx - pqx * uvz;
+				Real uuvz = pqx * uvy - pqy * uvx;
+				const Real w2 = 2.0f * pw;
+				uvx *= w2; uvy *= w2; uvz *= w2;
+				uuvx *= 2.0f; uuvy *= 2.0f; uuvz *= 2.0f;
+
+				// Add altered position vector to parents
+				dpx[i] = (vx + uvx + uuvx) + dpx[p];
+				dpy[i] = (vy + uvy + uuvy) + dpy[p];
+				dpz[i] = (vz + uvz + uuvz) + dpz[p];
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::update(void)
+	{
+		if (mHierarchyChanged)
+			rebuild();
+		else if (!mRemovedNodes.empty() || !mPendingNodes.empty())
+			relayout();
+
+		if (mDirtyNodes.empty() && mTouchedNodes.empty())
+			return;
+
+		// Only the nodes which changed need their local transforms
+		IndexList::iterator i, iend;
+		iend = mDirtyNodes.end();
+		for (i = mDirtyNodes.begin(); i != iend; ++i)
+		{
+			fetchLocalTransform(*i);
+		}
+
+		// The subtree of each dirty node is a contiguous range of the layout,
+		// merge them into the outermost ones in layout order
+		std::sort(mDirtyNodes.begin(), mDirtyNodes.end());
+		mUpdateRanges.clear();
+		size_t rangeEnd = 0;
+		for (i = mDirtyNodes.begin(); i != iend; ++i)
+		{
+			if (*i < rangeEnd)
+				continue;
+			rangeEnd = mSubtreeEnds[*i];
+			mUpdateRanges.push_back(Range(*i, rangeEnd));
+		}
+		mDirtyNodes.clear();
+
+		calculateDerivedTransforms();
+
+		// Hand the results back, parents first
+		RangeList::const_iterator r, rend;
+		rend = mUpdateRanges.end();
+		for (r = mUpdateRanges.begin(); r != rend; ++r)
+		{
+			for (size_t n = r->first; n < r->second; ++n)
+			{
+				Node* node = mNodes[n];
+				if (!node)
+					continue;
+				node->_updateFromTransformStore(
+					Quaternion(mDerivedOrientationW[n], mDerivedOrientationX[n],
+						mDerivedOrientationY[n], mDerivedOrientationZ[n]),
+					Vector3(mDerivedPositionX[n], mDerivedPositionY[n], 
+						mDerivedPositionZ[n]),
+					Vector3(mDerivedScaleX[n], mDerivedScaleY[n], mDerivedScaleZ[n]));
+			}
+		}
+
+		// The ancestors of the ranges, and the nodes which lost children, 
+		// have their updates completed without having moved
+		mUpdateAncestors.clear();
+		for (r = mUpdateRanges.begin(); r != rend; ++r)
+		{
+			if (r->first)
+				markUpdated(mParents[r->first]);
+		}
+		iend = mTouchedNodes.end();
+		for (i = mTouchedNodes.begin(); i != iend; ++i)
+		{
+			markUpdated(*i);
+		}
+		mTouchedNodes.clear();
+		std::sort(mUpdateAncestors.begin(), mUpdateAncestors.end(), std::greater<size_t>());
+
+		// Complete the update children first, i.e. backwards through the 
+		// layout, so e.g. bounds can be merged upwards
+		IndexList::const_iterator a = mUpdateAncestors.begin();
+		IndexList::const_iterator aend = mUpdateAncestors.end();
+		RangeList::reverse_iterator rr, rrend;
+		rrend = mUpdateRanges.rend();
+		for (rr = mUpdateRanges.rbegin(); rr != rrend; ++rr)
+		{
+			for (size_t n = rr->second; n-- > rr->first; )
+			{
+				for (; a != aend && *a > n; ++a)
+				{
+					completeUpdate(*a, false);
+				}
+				completeUpdate(n, true);
+			}
+		}
+		for (; a != aend; ++a)
+		{
+			completeUpdate(*a, false);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::markUpdated(size_t index)
+	{
+		// Stop at the first node marked already, its ancestors are too
+		while (!(mFlags[index] & NF_UPDATED))
+		{
+			mFlags[index] |= NF_UPDATED;
+			mUpdateAncestors.push_back(index);
+			if (!index)
+				break;
+			index = mParents[index];
+		}
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::completeUpdate(size_t index, bool moved)
+	{
+		if (mNodes[index])
+			mNodes[index]->_transformStoreUpdateComplete(moved);
+		mFlags[index] &= NF_INHERIT_ORIENTATION | NF_INHERIT_SCALE;
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::_notifyNodeAdded(Node* node)
+	{
+		node->_notifyTransformStore(this, PENDING_INDEX);
+		mPendingNodes.push_back(node);
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::_notifyNodeRemoved(Node* node)
+	{
+		const size_t index = node->_getTransformStoreIndex();
+		if (index == PENDING_INDEX)
+		{
+			NodeList::iterator i = 
+				std::find(mPendingNodes.begin(), mPendingNodes.end(), node);
+			if (i != mPendingNodes.end())
+			{
+				*i = mPendingNodes.back();
+				mPendingNodes.pop_back();
+			}
+		}
+		else if (index < mNodes.size() && mNodes[index] == node)
+		{
+			mNodes[index] = 0;
+			if (index)
+			{
+				// The subtree leaves the layout at the next update
+				mRemovedNodes.push_back(index);
+				mTouchedNodes.push_back(mParents[index]);
+			}
+			else
+			{
+				mHierarchyChanged = true;
+			}
+		}
+		node->_notifyTransformStore(0, 0);
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformStore::_notifyNodeDestroyed(size_t index, Node* node)
+	{
+		if (node == mRoot)
+			mRoot = 0;
+		_notifyNodeRemoved(node);
+	}
+
+}
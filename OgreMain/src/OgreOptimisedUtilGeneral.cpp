@@ -32,6 +32,8 @@ Torus Knot Software Ltd.
 
 #include "OgreVector3.h"
 #include "OgreMatrix4.h"
+#include "OgreQuaternion.h"
+#include "OgreParticle.h"
 
 namespace Ogre {
 
@@ -93,6 +95,40 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullBoxes
+        virtual void cullBoxes(
+            const Vector4* planes,
+            size_t numPlanes,
+            const Vector3* centres,
+            const Vector3* halfSizes,
+            uint32* visibility,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual void cullSpheres(
+            const Vector4* planes,
+            size_t numPlanes,
+            const Vector4* spheres,
+            uint32* visibility,
+            size_t numSpheres);
+
+        /// @copydoc OptimisedUtil::calculateBoneOffsetMatrices
+        virtual void calculateBoneOffsetMatrices(
+            const Quaternion* orientations,
+            const Vector3* positions,
+            const Vector3* scales,
+            const Quaternion* bindInverseOrientations,
+            const Vector3* bindInversePositions,
+            const Vector3* bindInverseScales,
+            Matrix4* dstMatrices,
+            size_t numBones);
+
+        /// @copydoc OptimisedUtil::applyParticleMotion
+        virtual void applyParticleMotion(
+            Particle* const* particles,
+            size_t count,
+            Real timeElapsed);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -362,6 +398,101 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::cullBoxes(
+        const Vector4* planes,
+        size_t numPlanes,
+        const Vector3* centres,
+        const Vector3* halfSizes,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        memset(visibility, 0, ((numBoxes + 31) / 32) * sizeof(uint32));
+
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            const Vector3& c = centres[i];
+            const Vector3& h = halfSizes[i];
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes; ++p)
+            {
+                const Vector4& plane = planes[p];
+                // Same sums as Plane::getSide
+                Real dist = plane.x * c.x + plane.y * c.y + plane.z * c.z + plane.w;
+                Real maxAbsDist = Math::Abs(plane.x * h.x) + Math::Abs(plane.y * h.y) +
+                    Math::Abs(plane.z * h.z);
+                if (dist < -maxAbsDist)
+                {
+                    visible = false;
+                    break;
+                }
+            }
+            if (visible)
+                visibility[i >> 5] |= 1u << (i & 31);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::cullSpheres(
+        const Vector4* planes,
+        size_t numPlanes,
+        const Vector4* spheres,
+        uint32* visibility,
+        size_t numSpheres)
+    {
+        memset(visibility, 0, ((numSpheres + 31) / 32) * sizeof(uint32));
+
+        for (size_t i = 0; i < numSpheres; ++i)
+        {
+            const Vector4& sphere = spheres[i];
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes; ++p)
+            {
+                const Vector4& plane = planes[p];
+                // Same sums as Plane::getDistance
+                Real dist = plane.x * sphere.x + plane.y * sphere.y + plane.z * sphere.z + plane.w;
+                if (dist < -sphere.w)
+                {
+                    visible = false;
+                    break;
+                }
+            }
+            if (visible)
+                visibility[i >> 5] |= 1u << (i & 31);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::calculateBoneOffsetMatrices(
+        const Quaternion* orientations,
+        const Vector3* positions,
+        const Vector3* scales,
+        const Quaternion* bindInverseOrientations,
+        const Vector3* bindInversePositions,
+        const Vector3* bindInverseScales,
+        Matrix4* dstMatrices,
+        size_t numBones)
+    {
+        for (size_t i = 0; i < numBones; ++i)
+        {
+            // Same as Bone::_getOffsetTransform
+            Vector3 scale = scales[i] * bindInverseScales[i];
+            Quaternion rotate = orientations[i] * bindInverseOrientations[i];
+            Vector3 translate = positions[i] + rotate * (scale * bindInversePositions[i]);
+
+            dstMatrices[i].makeTransform(translate, scale, rotate);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::applyParticleMotion(
+        Particle* const* particles,
+        size_t count,
+        Real timeElapsed)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Particle* pParticle = particles[i];
+            pParticle->position += pParticle->direction * timeElapsed;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void)
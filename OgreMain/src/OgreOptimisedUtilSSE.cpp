@@ -34,6 +34,8 @@ Torus Knot Software Ltd.
 #if __OGRE_HAVE_SSE
 
 #include "OgreMatrix4.h"
+#include "OgreQuaternion.h"
+#include "OgreParticle.h"
 
 // Should keep this includes at latest to avoid potential "xmmintrin.h" included by
 // other header file on some platform for some reason.
@@ -131,6 +133,40 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullBoxes
+        virtual void cullBoxes(
+            const Vector4* planes,
+            size_t numPlanes,
+            const Vector3* centres,
+            const Vector3* halfSizes,
+            uint32* visibility,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual void cullSpheres(
+            const Vector4* planes,
+            size_t numPlanes,
+            const Vector4* spheres,
+            uint32* visibility,
+            size_t numSpheres);
+
+        /// @copydoc OptimisedUtil::calculateBoneOffsetMatrices
+        virtual void calculateBoneOffsetMatrices(
+            const Quaternion* orientations,
+            const Vector3* positions,
+            const Vector3* scales,
+            const Quaternion* bindInverseOrientations,
+            const Vector3* bindInversePositions,
+            const Vector3* bindInverseScales,
+            Matrix4* dstMatrices,
+            size_t numBones);
+
+        /// @copydoc OptimisedUtil::applyParticleMotion
+        virtual void applyParticleMotion(
+            Particle* const* particles,
+            size_t count,
+            Real timeElapsed);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -266,6 +302,82 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::cullBoxes
+        virtual void cullBoxes(
+            const Vector4* planes,
+            size_t numPlanes,
+            const Vector3* centres,
+            const Vector3* halfSizes,
+            uint32* visibility,
+            size_t numBoxes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->cullBoxes(
+                planes,
+                numPlanes,
+                centres,
+                halfSizes,
+                visibility,
+                numBoxes);
+        }
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual void cullSpheres(
+            const Vector4* planes,
+            size_t numPlanes,
+            const Vector4* spheres,
+            uint32* visibility,
+            size_t numSpheres)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->cullSpheres(
+                planes,
+                numPlanes,
+                spheres,
+                visibility,
+                numSpheres);
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoneOffsetMatrices
+        virtual void calculateBoneOffsetMatrices(
+            const Quaternion* orientations,
+            const Vector3* positions,
+            const Vector3* scales,
+            const Quaternion* bindInverseOrientations,
+            const Vector3* bindInversePositions,
+            const Vector3* bindInverseScales,
+            Matrix4* dstMatrices,
+            size_t numBones)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->calculateBoneOffsetMatrices(
+                orientations,
+                positions,
+                scales,
+                bindInverseOrientations,
+                bindInversePositions,
+                bindInverseScales,
+                dstMatrices,
+                numBones);
+        }
+
+        /// @copydoc OptimisedUtil::applyParticleMotion
+        virtual void applyParticleMotion(
+            Particle* const* particles,
+            size_t count,
+            Real timeElapsed)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->applyParticleMotion(
+                particles,
+                count,
+                timeElapsed);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -2062,6 +2174,448 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    // Planes are splatted to registers this many at a time when culling
+#define OGRE_SSE_CULL_PLANES_PER_PASS   8
+
+    /// A plane with each component splatted, to test four bounds at once
+    struct SplattedPlane
+    {
+        __m128 nx, ny, nz, d;
+        /// Absolute values of the normal components
+        __m128 ax, ay, az;
+    };
+    //---------------------------------------------------------------------
+    static FORCEINLINE void splatPlanes(
+        SplattedPlane* dst, const Vector4* planes, size_t numPlanes)
+    {
+        // Mask used to clear sign of single precision floating point values.
+        OGRE_SIMD_ALIGNED_DECL(static const uint32, msAbsMask[4]) =
+        {
+            0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF,
+        };
+        __m128 absMask = __MM_LOAD_PS(msAbsMask);
+
+        for (size_t p = 0; p < numPlanes; ++p)
+        {
+            dst[p].nx = _mm_load_ps1(&planes[p].x);
+            dst[p].ny = _mm_load_ps1(&planes[p].y);
+            dst[p].nz = _mm_load_ps1(&planes[p].z);
+            dst[p].d = _mm_load_ps1(&planes[p].w);
+            dst[p].ax = _mm_and_ps(dst[p].nx, absMask);
+            dst[p].ay = _mm_and_ps(dst[p].ny, absMask);
+            dst[p].az = _mm_and_ps(dst[p].nz, absMask);
+        }
+    }
+    //---------------------------------------------------------------------
+    /// Sets the visibility bits of the given number of bounds, and clears the rest
+    static FORCEINLINE void initVisibility(uint32* visibility, size_t count)
+    {
+        size_t numWords = count / 32;
+        memset(visibility, 0xFF, numWords * sizeof(uint32));
+        if (count & 31)
+            visibility[numWords] = (1u << (count & 31)) - 1;
+    }
+    //---------------------------------------------------------------------
+    /// Returns a 4-bits mask of which of four boxes are culled by any plane
+    static FORCEINLINE int cullFourBoxes(
+        const SplattedPlane* planes, size_t numPlanes,
+        const __m128& cx, const __m128& cy, const __m128& cz,
+        const __m128& hx, const __m128& hy, const __m128& hz)
+    {
+        __m128 zero = _mm_setzero_ps();
+        __m128 culled = zero;
+        for (size_t p = 0; p < numPlanes; ++p)
+        {
+            const SplattedPlane& plane = planes[p];
+            // Same sums as Plane::getSide
+            __m128 dist = _mm_add_ps(
+                __MM_DOT3x3_PS(plane.nx, plane.ny, plane.nz, cx, cy, cz), plane.d);
+            __m128 maxAbsDist = __MM_DOT3x3_PS(plane.ax, plane.ay, plane.az, hx, hy, hz);
+            culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, _mm_sub_ps(zero, maxAbsDist)));
+        }
+        return _mm_movemask_ps(culled);
+    }
+    //---------------------------------------------------------------------
+    /// Returns a 4-bits mask of which of four spheres are culled by any plane
+    static FORCEINLINE int cullFourSpheres(
+        const SplattedPlane* planes, size_t numPlanes,
+        const __m128& x, const __m128& y, const __m128& z, const __m128& radius)
+    {
+        __m128 zero = _mm_setzero_ps();
+        __m128 negRadius = _mm_sub_ps(zero, radius);
+        __m128 culled = zero;
+        for (size_t p = 0; p < numPlanes; ++p)
+        {
+            const SplattedPlane& plane = planes[p];
+            // Same sums as Plane::getDistance
+            __m128 dist = _mm_add_ps(
+                __MM_DOT3x3_PS(plane.nx, plane.ny, plane.nz, x, y, z), plane.d);
+            culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, negRadius));
+        }
+        return _mm_movemask_ps(culled);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::cullBoxes(
+        const Vector4* planes,
+        size_t numPlanes,
+        const Vector3* centres,
+        const Vector3* halfSizes,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        // Start with every box visible, and clear the bits of culled boxes
+        initVisibility(visibility, numBoxes);
+
+        size_t numIterations = numBoxes / 4;
+        size_t numRemaining = numBoxes & 3;
+
+        SplattedPlane splatted[OGRE_SSE_CULL_PLANES_PER_PASS];
+        for (size_t firstPlane = 0; firstPlane < numPlanes;
+            firstPlane += OGRE_SSE_CULL_PLANES_PER_PASS)
+        {
+            size_t passPlanes = std::min(numPlanes - firstPlane,
+                (size_t)OGRE_SSE_CULL_PLANES_PER_PASS);
+            splatPlanes(splatted, planes + firstPlane, passPlanes);
+
+            const float* pCentre = &centres[0].x;
+            const float* pHalfSize = &halfSizes[0].x;
+            __m128 cx, cy, cz, hx, hy, hz;
+            int culled;
+
+            // Four boxes per-iteration
+            for (size_t i = 0; i < numIterations; ++i)
+            {
+                // Four continuous Vector3 fill three registers, unaligned
+                cx = _mm_loadu_ps(pCentre + 0);
+                cy = _mm_loadu_ps(pCentre + 4);
+                cz = _mm_loadu_ps(pCentre + 8);
+                __MM_TRANSPOSE4x3_PS(cx, cy, cz);
+                hx = _mm_loadu_ps(pHalfSize + 0);
+                hy = _mm_loadu_ps(pHalfSize + 4);
+                hz = _mm_loadu_ps(pHalfSize + 8);
+                __MM_TRANSPOSE4x3_PS(hx, hy, hz);
+                pCentre += 12;
+                pHalfSize += 12;
+
+                culled = cullFourBoxes(splatted, passPlanes, cx, cy, cz, hx, hy, hz);
+                if (culled)
+                    visibility[i >> 3] &= ~((uint32)culled << ((i & 7) * 4));
+            }
+
+            // Dealing with remaining boxes, padded with empty boxes
+            if (numRemaining)
+            {
+                float lastCentres[12] = { 0 };
+                float lastHalfSizes[12] = { 0 };
+                memcpy(lastCentres, pCentre, numRemaining * 3 * sizeof(float));
+                memcpy(lastHalfSizes, pHalfSize, numRemaining * 3 * sizeof(float));
+
+                cx = _mm_loadu_ps(lastCentres + 0);
+                cy = _mm_loadu_ps(lastCentres + 4);
+                cz = _mm_loadu_ps(lastCentres + 8);
+                __MM_TRANSPOSE4x3_PS(cx, cy, cz);
+                hx = _mm_loadu_ps(lastHalfSizes + 0);
+                hy = _mm_loadu_ps(lastHalfSizes + 4);
+                hz = _mm_loadu_ps(lastHalfSizes + 8);
+                __MM_TRANSPOSE4x3_PS(hx, hy, hz);
+
+                culled = cullFourBoxes(splatted, passPlanes, cx, cy, cz, hx, hy, hz);
+                culled &= (1 << numRemaining) - 1;
+                if (culled)
+                {
+                    size_t i = numIterations;
+                    visibility[i >> 3] &= ~((uint32)culled << ((i & 7) * 4));
+                }
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::cullSpheres(
+        const Vector4* planes,
+        size_t numPlanes,
+        const Vector4* spheres,
+        uint32* visibility,
+        size_t numSpheres)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        // Start with every sphere visible, and clear the bits of culled spheres
+        initVisibility(visibility, numSpheres);
+
+        size_t numIterations = numSpheres / 4;
+        size_t numRemaining = numSpheres & 3;
+
+        SplattedPlane splatted[OGRE_SSE_CULL_PLANES_PER_PASS];
+        for (size_t firstPlane = 0; firstPlane < numPlanes;
+            firstPlane += OGRE_SSE_CULL_PLANES_PER_PASS)
+        {
+            size_t passPlanes = std::min(numPlanes - firstPlane,
+                (size_t)OGRE_SSE_CULL_PLANES_PER_PASS);
+            splatPlanes(splatted, planes + firstPlane, passPlanes);
+
+            const float* pSphere = &spheres[0].x;
+            __m128 x, y, z, r;
+            int culled;
+
+            // Four spheres per-iteration
+            for (size_t i = 0; i < numIterations; ++i)
+            {
+                x = _mm_loadu_ps(pSphere + 0);
+                y = _mm_loadu_ps(pSphere + 4);
+                z = _mm_loadu_ps(pSphere + 8);
+                r = _mm_loadu_ps(pSphere + 12);
+                __MM_TRANSPOSE4x4_PS(x, y, z, r);
+                pSphere += 16;
+
+                culled = cullFourSpheres(splatted, passPlanes, x, y, z, r);
+                if (culled)
+                    visibility[i >> 3] &= ~((uint32)culled << ((i & 7) * 4));
+            }
+
+            // Dealing with remaining spheres, padded with empty spheres
+            if (numRemaining)
+            {
+                float last[16] = { 0 };
+                memcpy(last, pSphere, numRemaining * 4 * sizeof(float));
+
+                x = _mm_loadu_ps(last + 0);
+                y = _mm_loadu_ps(last + 4);
+                z = _mm_loadu_ps(last + 8);
+                r = _mm_loadu_ps(last + 12);
+                __MM_TRANSPOSE4x4_PS(x, y, z, r);
+
+                culled = cullFourSpheres(splatted, passPlanes, x, y, z, r);
+                culled &= (1 << numRemaining) - 1;
+                if (culled)
+                {
+                    size_t i = numIterations;
+                    visibility[i >> 3] &= ~((uint32)culled << ((i & 7) * 4));
+                }
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    /// Bottom row of an affine matrix
+    static const float msLastRow[4] = { 0, 0, 0, 1 };
+    //---------------------------------------------------------------------
+    /// Calculates the offset matrices of four bones, as Bone::_getOffsetTransform
+    static FORCEINLINE void calculateFourBoneOffsetMatrices(
+        const float* pOrientation, const float* pPosition, const float* pScale,
+        const float* pBindOrientation, const float* pBindPosition, const float* pBindScale,
+        Matrix4* dstMatrices)
+    {
+        __m128 qw, qx, qy, qz, bw, bx, by, bz;
+        __m128 px, py, pz, sx, sy, sz, vx, vy, vz;
+
+        // Four continuous Quaternion fill four registers, w, x, y, z
+        qw = _mm_loadu_ps(pOrientation + 0);
+        qx = _mm_loadu_ps(pOrientation + 4);
+        qy = _mm_loadu_ps(pOrientation + 8);
+        qz = _mm_loadu_ps(pOrientation + 12);
+        __MM_TRANSPOSE4x4_PS(qw, qx, qy, qz);
+        bw = _mm_loadu_ps(pBindOrientation + 0);
+        bx = _mm_loadu_ps(pBindOrientation + 4);
+        by = _mm_loadu_ps(pBindOrientation + 8);
+        bz = _mm_loadu_ps(pBindOrientation + 12);
+        __MM_TRANSPOSE4x4_PS(bw, bx, by, bz);
+
+        // Four continuous Vector3 fill three registers
+        px = _mm_loadu_ps(pPosition + 0);
+        py = _mm_loadu_ps(pPosition + 4);
+        pz = _mm_loadu_ps(pPosition + 8);
+        __MM_TRANSPOSE4x3_PS(px, py, pz);
+        sx = _mm_loadu_ps(pScale + 0);
+        sy = _mm_loadu_ps(pScale + 4);
+        sz = _mm_loadu_ps(pScale + 8);
+        __MM_TRANSPOSE4x3_PS(sx, sy, sz);
+        vx = _mm_loadu_ps(pBindPosition + 0);
+        vy = _mm_loadu_ps(pBindPosition + 4);
+        vz = _mm_loadu_ps(pBindPosition + 8);
+        __MM_TRANSPOSE4x3_PS(vx, vy, vz);
+
+        // Combine scale with binding pose inverse scale
+        {
+            __m128 bsx, bsy, bsz;
+            bsx = _mm_loadu_ps(pBindScale + 0);
+            bsy = _mm_loadu_ps(pBindScale + 4);
+            bsz = _mm_loadu_ps(pBindScale + 8);
+            __MM_TRANSPOSE4x3_PS(bsx, bsy, bsz);
+            sx = _mm_mul_ps(sx, bsx);
+            sy = _mm_mul_ps(sy, bsy);
+            sz = _mm_mul_ps(sz, bsz);
+        }
+
+        // Combine orientation with binding pose inverse orientation,
+        // same as Quaternion::operator*
+        __m128 rw = _mm_sub_ps(_mm_mul_ps(qw, bw), __MM_DOT3x3_PS(qx, qy, qz, bx, by, bz));
+        __m128 rx = _mm_sub_ps(__MM_DOT3x3_PS(qw, qx, qy, bx, bw, bz), _mm_mul_ps(qz, by));
+        __m128 ry = _mm_sub_ps(__MM_DOT3x3_PS(qw, qy, qz, by, bw, bx), _mm_mul_ps(qx, bz));
+        __m128 rz = _mm_sub_ps(__MM_DOT3x3_PS(qw, qz, qx, bz, bw, by), _mm_mul_ps(qy, bx));
+
+        // Rotation matrix, same as Quaternion::ToRotationMatrix
+        __m128 tx = _mm_add_ps(rx, rx);
+        __m128 ty = _mm_add_ps(ry, ry);
+        __m128 tz = _mm_add_ps(rz, rz);
+        __m128 twx = _mm_mul_ps(tx, rw);
+        __m128 twy = _mm_mul_ps(ty, rw);
+        __m128 twz = _mm_mul_ps(tz, rw);
+        __m128 txx = _mm_mul_ps(tx, rx);
+        __m128 txy = _mm_mul_ps(ty, rx);
+        __m128 txz = _mm_mul_ps(tz, rx);
+        __m128 tyy = _mm_mul_ps(ty, ry);
+        __m128 tyz = _mm_mul_ps(tz, ry);
+        __m128 tzz = _mm_mul_ps(tz, rz);
+        __m128 lastRow = _mm_loadu_ps(msLastRow);
+        __m128 one = _mm_load_ps1(msLastRow + 3);
+
+        __m128 m00 = _mm_sub_ps(one, _mm_add_ps(tyy, tzz));
+        __m128 m01 = _mm_sub_ps(txy, twz);
+        __m128 m02 = _mm_add_ps(txz, twy);
+        __m128 m10 = _mm_add_ps(txy, twz);
+        __m128 m11 = _mm_sub_ps(one, _mm_add_ps(txx, tzz));
+        __m128 m12 = _mm_sub_ps(tyz, twx);
+        __m128 m20 = _mm_sub_ps(txz, twy);
+        __m128 m21 = _mm_add_ps(tyz, twx);
+        __m128 m22 = _mm_sub_ps(one, _mm_add_ps(txx, tyy));
+
+        // Reverse transform binding pose position to bone space, then
+        // transform to current derived bone space
+        vx = _mm_mul_ps(vx, sx);
+        vy = _mm_mul_ps(vy, sy);
+        vz = _mm_mul_ps(vz, sz);
+        __m128 m03 = _mm_add_ps(px, __MM_DOT3x3_PS(m00, m01, m02, vx, vy, vz));
+        __m128 m13 = _mm_add_ps(py, __MM_DOT3x3_PS(m10, m11, m12, vx, vy, vz));
+        __m128 m23 = _mm_add_ps(pz, __MM_DOT3x3_PS(m20, m21, m22, vx, vy, vz));
+
+        // Scale the columns, NB just combine as equivalent axes, no shearing
+        m00 = _mm_mul_ps(m00, sx);
+        m10 = _mm_mul_ps(m10, sx);
+        m20 = _mm_mul_ps(m20, sx);
+        m01 = _mm_mul_ps(m01, sy);
+        m11 = _mm_mul_ps(m11, sy);
+        m21 = _mm_mul_ps(m21, sy);
+        m02 = _mm_mul_ps(m02, sz);
+        m12 = _mm_mul_ps(m12, sz);
+        m22 = _mm_mul_ps(m22, sz);
+
+        // Each register holds one element of four matrices, transpose them
+        // into rows of each matrix
+        __MM_TRANSPOSE4x4_PS(m00, m01, m02, m03);
+        __MM_TRANSPOSE4x4_PS(m10, m11, m12, m13);
+        __MM_TRANSPOSE4x4_PS(m20, m21, m22, m23);
+
+        _mm_storeu_ps(dstMatrices[0][0], m00);
+        _mm_storeu_ps(dstMatrices[0][1], m10);
+        _mm_storeu_ps(dstMatrices[0][2], m20);
+        _mm_storeu_ps(dstMatrices[0][3], lastRow);
+        _mm_storeu_ps(dstMatrices[1][0], m01);
+        _mm_storeu_ps(dstMatrices[1][1], m11);
+        _mm_storeu_ps(dstMatrices[1][2], m21);
+        _mm_storeu_ps(dstMatrices[1][3], lastRow);
+        _mm_storeu_ps(dstMatrices[2][0], m02);
+        _mm_storeu_ps(dstMatrices[2][1], m12);
+        _mm_storeu_ps(dstMatrices[2][2], m22);
+        _mm_storeu_ps(dstMatrices[2][3], lastRow);
+        _mm_storeu_ps(dstMatrices[3][0], m03);
+        _mm_storeu_ps(dstMatrices[3][1], m13);
+        _mm_storeu_ps(dstMatrices[3][2], m23);
+        _mm_storeu_ps(dstMatrices[3][3], lastRow);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::calculateBoneOffsetMatrices(
+        const Quaternion* orientations,
+        const Vector3* positions,
+        const Vector3* scales,
+        const Quaternion* bindInverseOrientations,
+        const Vector3* bindInversePositions,
+        const Vector3* bindInverseScales,
+        Matrix4* dstMatrices,
+        size_t numBones)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        size_t numIterations = numBones / 4;
+        size_t numRemaining = numBones & 3;
+
+        const float* pOrientation = &orientations[0].w;
+        const float* pPosition = &positions[0].x;
+        const float* pScale = &scales[0].x;
+        const float* pBindOrientation = &bindInverseOrientations[0].w;
+        const float* pBindPosition = &bindInversePositions[0].x;
+        const float* pBindScale = &bindInverseScales[0].x;
+
+        // Four bones per-iteration
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            calculateFourBoneOffsetMatrices(
+                pOrientation, pPosition, pScale,
+                pBindOrientation, pBindPosition, pBindScale,
+                dstMatrices);
+            pOrientation += 16;
+            pPosition += 12;
+            pScale += 12;
+            pBindOrientation += 16;
+            pBindPosition += 12;
+            pBindScale += 12;
+            dstMatrices += 4;
+        }
+
+        // Dealing with remaining bones, padded with zeroes
+        if (numRemaining)
+        {
+            float lastOrientations[16] = { 0 };
+            float lastPositions[12] = { 0 };
+            float lastScales[12] = { 0 };
+            float lastBindOrientations[16] = { 0 };
+            float lastBindPositions[12] = { 0 };
+            float lastBindScales[12] = { 0 };
+            memcpy(lastOrientations, pOrientation, numRemaining * 4 * sizeof(float));
+            memcpy(lastPositions, pPosition, numRemaining * 3 * sizeof(float));
+            memcpy(lastScales, pScale, numRemaining * 3 * sizeof(float));
+            memcpy(lastBindOrientations, pBindOrientation, numRemaining * 4 * sizeof(float));
+            memcpy(lastBindPositions, pBindPosition, numRemaining * 3 * sizeof(float));
+            memcpy(lastBindScales, pBindScale, numRemaining * 3 * sizeof(float));
+
+            Matrix4 lastMatrices[4];
+            calculateFourBoneOffsetMatrices(
+                lastOrientations, lastPositions, lastScales,
+                lastBindOrientations, lastBindPositions, lastBindScales,
+                lastMatrices);
+            for (size_t i = 0; i < numRemaining; ++i)
+            {
+                dstMatrices[i] = lastMatrices[i];
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::applyParticleMotion(
+        Particle* const* particles,
+        size_t count,
+        Real timeElapsed)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        __m128 t = _mm_load_ps1(&timeElapsed);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Particle* pParticle = particles[i];
+            float* pPosition = &pParticle->position.x;
+
+            // Position is followed by direction, and direction by colour, in
+            // Particle, so the fourth lane of both loads stays in the object;
+            // it's never stored back.
+            __m128 position = _mm_loadu_ps(pPosition);
+            __m128 direction = _mm_loadu_ps(&pParticle->direction.x);
+            position = __MM_MADD_PS(direction, t, position);
+
+            _mm_storel_pi((__m64*)pPosition, position);
+            _mm_store_ss(pPosition + 2, _mm_movehl_ps(position, position));
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilSSE(void)
@@ -46,6 +46,8 @@ Torus Knot Software Ltd.
 #include "OgreSceneManager.h"
 #include "OgreControllerManager.h"
 #include "OgreRoot.h"
+#include "OgreProfiler.h"
+#include "OgreOptimisedUtil.h"
 
 namespace Ogre {
     // Init statics
@@ -167,10 +169,10 @@ namespace Ogre {
 		// Deallocate all particles
 		destroyVisualParticles(0, mParticlePool.size());
         // Free pool items
-        ParticlePool::iterator i;
-        for (i = mParticlePool.begin(); i != mParticlePool.end(); ++i)
+        ParticleBlockList::iterator i;
+        for (i = mParticleBlocks.begin(); i != mParticleBlocks.end(); ++i)
         {
-            delete *i;
+            delete [] *i;
         }
 
         if (mRenderer)
@@ -362,6 +364,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ParticleSystem::_update(Real timeElapsed)
     {
+		OgreProfileCapture("ParticleSystem::_update");
+
         // Only update if attached to a node
         if (!mParentNode)
             return;
@@ -430,15 +434,17 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ParticleSystem::_expire(Real timeElapsed)
     {
-        ActiveParticleList::iterator i, itEnd;
         Particle* pParticle;
 		ParticleEmitter* pParticleEmitter;
 
+        // Compact the survivors towards the front in place, so that the
+        // particles stay in the order they were emitted in
+        ActiveParticleList::iterator i, itWrite, itEnd;
+        itWrite = mActiveParticles.begin();
         itEnd = mActiveParticles.end();
-
-        for (i = mActiveParticles.begin(); i != itEnd; )
+        for (i = mActiveParticles.begin(); i != itEnd; ++i)
         {
-            pParticle = static_cast<Particle*>(*i);
+            pParticle = *i;
             if (pParticle->timeToLive < timeElapsed)
             {
                 // Notify renderer
@@ -448,30 +454,29 @@ namespace Ogre {
 				if (pParticle->particleType == Particle::Visual)
 				{
 	                // Destroy this one
-		            mFreeParticles.splice(mFreeParticles.end(), mActiveParticles, i++);
+		            mFreeParticles.push_back(pParticle);
 				}
 				else
 				{
 					// For now, it can only be an emitted emitter
-					pParticleEmitter = static_cast<ParticleEmitter*>(*i);
+					pParticleEmitter = static_cast<ParticleEmitter*>(pParticle);
 					std::list<ParticleEmitter*>* fee = findFreeEmittedEmitter(pParticleEmitter->getName());
 					fee->push_back(pParticleEmitter);
 
 					// Also erase from mActiveEmittedEmitters
 					removeFromActiveEmittedEmitters (pParticleEmitter);
-
-					// And erase from mActiveParticles
-					i = mActiveParticles.erase( i );
 				}
             }
             else
             {
                 // Decrement TTL
                 pParticle->timeToLive -= timeElapsed;
-				++i;
+				*itWrite++ = pParticle;
             }
 
         }
+
+        mActiveParticles.erase(itWrite, itEnd);
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_triggerEmitters(Real timeElapsed)
@@ -596,25 +601,18 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ParticleSystem::_applyMotion(Real timeElapsed)
     {
-        ActiveParticleList::iterator i, itEnd;
-        Particle* pParticle;
-		ParticleEmitter* pParticleEmitter;
-
-        itEnd = mActiveParticles.end();
-        for (i = mActiveParticles.begin(); i != itEnd; ++i)
-        {
-            pParticle = static_cast<Particle*>(*i);
-            pParticle->position += (pParticle->direction * timeElapsed);
+        OptimisedUtil::getImplementation()->applyParticleMotion(
+            _getActiveParticles(), mActiveParticles.size(), timeElapsed);
 
-			if (pParticle->particleType == Particle::Emitter)
-			{
-				// If it is an emitter, the emitter position must also be updated
-				// Note, that position of the emitter becomes a position in worldspace if mLocalSpace is set 
-				// to false (will this become a problem?)
-				pParticleEmitter = static_cast<ParticleEmitter*>(*i);
-				pParticleEmitter->setPosition(pParticle->position);
-			}
-        }
+		// Emitted emitters are active particles too; their emitter position must
+		// also be updated. Note, that position of the emitter becomes a position 
+		// in worldspace if mLocalSpace is set to false (will this become a problem?)
+		ActiveEmittedEmitterList::iterator itEmit, itEmitEnd;
+		itEmitEnd = mActiveEmittedEmitters.end();
+		for (itEmit = mActiveEmittedEmitters.begin(); itEmit != itEmitEnd; ++itEmit)
+		{
+			(*itEmit)->setPosition((*itEmit)->position);
+		}
 
         // Notify renderer
         mRenderer->_notifyParticleMoved(mActiveParticles);
@@ -635,15 +633,19 @@ namespace Ogre {
     void ParticleSystem::increasePool(size_t size)
     {
         size_t oldSize = mParticlePool.size();
+        if (size <= oldSize)
+            return;
 
         // Increase size
         mParticlePool.reserve(size);
         mParticlePool.resize(size);
 
-        // Create new particles
+        // Create new particles in one block
+        Particle* block = new Particle[size - oldSize];
+        mParticleBlocks.push_back(block);
         for( size_t i = oldSize; i < size; i++ )
 		{
-            mParticlePool[i] = new Particle();
+            mParticlePool[i] = block++;
 		}
 
 		if (mIsRendererConfigured)
@@ -662,9 +664,7 @@ namespace Ogre {
 	Particle* ParticleSystem::getParticle(size_t index) 
 	{
 		assert (index < mActiveParticles.size() && "Index out of bounds!");
-		ActiveParticleList::iterator i = mActiveParticles.begin();
-		std::advance(i, index);
-		return *i;
+		return mActiveParticles[index];
 	}
     //-----------------------------------------------------------------------
     Particle* ParticleSystem::createParticle(void)
@@ -673,8 +673,9 @@ namespace Ogre {
 		if (!mFreeParticles.empty())
 		{
 	        // Fast creation (don't use superclass since emitter will init)
-	        p = mFreeParticles.front();
-	        mActiveParticles.splice(mActiveParticles.end(), mFreeParticles, mFreeParticles.begin());
+	        p = mFreeParticles.back();
+	        mFreeParticles.pop_back();
+	        mActiveParticles.push_back(p);
 
 			p->_notifyOwner(this);
 		}
@@ -1004,8 +1005,14 @@ namespace Ogre {
             mRenderer->_notifyParticleCleared(mActiveParticles);
         }
 
-        // Move actives to free list
-        mFreeParticles.splice(mFreeParticles.end(), mActiveParticles);
+        // Move visual actives to free list; emitted emitters are returned below
+        ActiveParticleList::iterator i;
+        for (i = mActiveParticles.begin(); i != mActiveParticles.end(); ++i)
+        {
+            if ((*i)->particleType == Particle::Visual)
+                mFreeParticles.push_back(*i);
+        }
+        mActiveParticles.clear();
 
         // Add active emitted emitters to free list
 		addActiveEmittedEmittersToFreeList();
@@ -1043,10 +1050,11 @@ namespace Ogre {
         {
             this->increasePool(size);
 
-            for( size_t i = currSize; i < size; ++i )
+            // Add new items to the stack, last first so that particles are
+            // handed out in the order they lie in memory
+            for( size_t i = size; i > currSize; --i )
             {
-                // Add new items to the queue
-                mFreeParticles.push_back( mParticlePool[i] );
+                mFreeParticles.push_back( mParticlePool[i - 1] );
             }
 
             // Tell the renderer, if already configured
@@ -373,6 +373,103 @@ struct X8B8G8R8toR8G8B8A8: public PixelConverter <Ogre::uint32, Ogre::uint32, FM
 };
 
 
+/** Type for the PF_FLOAT16_* and PF_FLOAT32_* formats, which store their
+    channels in the same order whatever the size */
+template <typename T, int channels> struct ColN {
+    T c[channels];
+};
+
+/** Table driven float to half conversion, one lookup per channel instead of
+    the branches of Bitwise::floatToHalfI, with exactly the same results.
+    Indexed by the sign and exponent bits of the float.
+ */
+struct FloatToHalfTable {
+    Ogre::uint16 base[512];
+    unsigned char shift[512];
+
+    FloatToHalfTable()
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            int e = i - (127 - 15);
+            Ogre::uint16 b;
+            unsigned char sh;
+            if (e < -10)
+            {
+                // Too small, becomes zero without sign
+                base[i] = base[i | 0x100] = 0;
+                shift[i] = shift[i | 0x100] = 24;
+                continue;
+            }
+            else if (e <= 0)
+            {
+                // Denormalised half, implicit bit shifted into the mantissa
+                b = (Ogre::uint16)((0x00800000 >> (14 - e)) & 0xFFFF);
+                sh = (unsigned char)(14 - e);
+            }
+            else if (e > 30)
+            {
+                // Overflow, infinity; NaNs are dealt with separately
+                b = 0x7c00;
+                sh = 24;
+            }
+            else
+            {
+                b = (Ogre::uint16)(e << 10);
+                sh = 13;
+            }
+            base[i] = b;
+            base[i | 0x100] = b | 0x8000;
+            shift[i] = shift[i | 0x100] = sh;
+        }
+    }
+
+    inline Ogre::uint16 convert(Ogre::uint32 i) const
+    {
+        Ogre::uint32 m = i & 0x007fffff;
+        Ogre::uint32 se = i >> 23;
+        // NaN must keep a non-zero mantissa
+        if ((se & 0xff) == 0xff && m != 0)
+            return Bitwise::floatToHalfI(i);
+        return (Ogre::uint16)(base[se] + (m >> shift[se]));
+    }
+};
+static const FloatToHalfTable floatToHalfTable;
+
+template <int id, int channels> struct Float32toFloat16:
+    public PixelConverter <ColN<Ogre::uint32, channels>, ColN<Ogre::uint16, channels>, id>
+{
+    inline static ColN<Ogre::uint16, channels> pixelConvert(const ColN<Ogre::uint32, channels> &inp)
+    {
+        ColN<Ogre::uint16, channels> outp;
+        for (int i = 0; i < channels; ++i)
+            outp.c[i] = floatToHalfTable.convert(inp.c[i]);
+        return outp;
+    }
+};
+
+template <int id, int channels> struct Float16toFloat32:
+    public PixelConverter <ColN<Ogre::uint16, channels>, ColN<Ogre::uint32, channels>, id>
+{
+    inline static ColN<Ogre::uint32, channels> pixelConvert(const ColN<Ogre::uint16, channels> &inp)
+    {
+        ColN<Ogre::uint32, channels> outp;
+        for (int i = 0; i < channels; ++i)
+            outp.c[i] = Bitwise::halfToFloatI(inp.c[i]);
+        return outp;
+    }
+};
+
+struct FLOAT32_RtoFLOAT16_R: public Float32toFloat16<FMTCONVERTERID(PF_FLOAT32_R, PF_FLOAT16_R), 1> { };
+struct FLOAT32_GRtoFLOAT16_GR: public Float32toFloat16<FMTCONVERTERID(PF_FLOAT32_GR, PF_FLOAT16_GR), 2> { };
+struct FLOAT32_RGBtoFLOAT16_RGB: public Float32toFloat16<FMTCONVERTERID(PF_FLOAT32_RGB, PF_FLOAT16_RGB), 3> { };
+struct FLOAT32_RGBAtoFLOAT16_RGBA: public Float32toFloat16<FMTCONVERTERID(PF_FLOAT32_RGBA, PF_FLOAT16_RGBA), 4> { };
+struct FLOAT16_RtoFLOAT32_R: public Float16toFloat32<FMTCONVERTERID(PF_FLOAT16_R, PF_FLOAT32_R), 1> { };
+struct FLOAT16_GRtoFLOAT32_GR: public Float16toFloat32<FMTCONVERTERID(PF_FLOAT16_GR, PF_FLOAT32_GR), 2> { };
+struct FLOAT16_RGBtoFLOAT32_RGB: public Float16toFloat32<FMTCONVERTERID(PF_FLOAT16_RGB, PF_FLOAT32_RGB), 3> { };
+struct FLOAT16_RGBAtoFLOAT32_RGBA: public Float16toFloat32<FMTCONVERTERID(PF_FLOAT16_RGBA, PF_FLOAT32_RGBA), 4> { };
+
+
 #define CASECONVERTER(type) case type::ID : PixelBoxConverter<type>::conversion(src, dst); return 1;
 
 inline int doOptimizedConversion(const PixelBox &src, const PixelBox &dst)
@@ -418,6 +515,14 @@ inline int doOptimizedConversion(const PixelBox &src, const PixelBox &dst)
 		CASECONVERTER(X8B8G8R8toA8B8G8R8);
 		CASECONVERTER(X8B8G8R8toB8G8R8A8);
 		CASECONVERTER(X8B8G8R8toR8G8B8A8);
+		CASECONVERTER(FLOAT32_RtoFLOAT16_R);
+		CASECONVERTER(FLOAT32_GRtoFLOAT16_GR);
+		CASECONVERTER(FLOAT32_RGBtoFLOAT16_RGB);
+		CASECONVERTER(FLOAT32_RGBAtoFLOAT16_RGBA);
+		CASECONVERTER(FLOAT16_RtoFLOAT32_R);
+		CASECONVERTER(FLOAT16_GRtoFLOAT32_GR);
+		CASECONVERTER(FLOAT16_RGBtoFLOAT32_RGB);
+		CASECONVERTER(FLOAT16_RGBAtoFLOAT32_RGBA);
 
         default:
             return 0;
@@ -31,6 +31,7 @@ Torus Knot Software Ltd.
 #include "OgreBitwise.h"
 #include "OgreColourValue.h"
 #include "OgreException.h"
+#include "OgreWorkerThreadPool.h"
 
 
 namespace {
@@ -1171,6 +1172,23 @@ namespace Ogre {
         bulkPixelConversion(src, dst);
     }
     //-----------------------------------------------------------------------
+	namespace
+	{
+		/// Task which converts one band of a pixel box
+		class PixelConversionTask : public WorkerThreadPool::Task
+		{
+		protected:
+			PixelBox mSrc, mDst;
+		public:
+			PixelConversionTask(const PixelBox& src, const PixelBox& dst)
+				: mSrc(src), mDst(dst) {}
+			void execute(void)
+			{
+				PixelUtil::_bulkPixelConversionSerial(mSrc, mDst);
+			}
+		};
+	}
+	//-----------------------------------------------------------------------
     void PixelUtil::bulkPixelConversion(const PixelBox &src, const PixelBox &dst)
     {
         assert(src.getWidth() == dst.getWidth() &&
@@ -1193,6 +1211,55 @@ namespace Ogre {
 			}
 		}
 
+		WorkerThreadPool* pool = WorkerThreadPool::getSingletonPtr();
+		if (!pool || !pool->isParallel() ||
+			src.getWidth() * src.getHeight() * src.getDepth() < PARALLEL_CONVERSION_MIN_PIXELS)
+		{
+			_bulkPixelConversionSerial(src, dst);
+			return;
+		}
+
+		// Split the box into bands of slices, rows or columns, whichever
+		// is the outermost dimension, with a couple of bands per thread
+		Box band(0, 0, 0, src.getWidth(), src.getHeight(), src.getDepth());
+		size_t* bandBegin;
+		size_t* bandEnd;
+		if (band.back > 1)
+		{
+			bandBegin = &band.front; bandEnd = &band.back;
+		}
+		else if (band.bottom > 1)
+		{
+			bandBegin = &band.top; bandEnd = &band.bottom;
+		}
+		else
+		{
+			bandBegin = &band.left; bandEnd = &band.right;
+		}
+		const size_t extent = *bandEnd;
+		const size_t numTasks = std::min(extent, (pool->getNumWorkerThreads() + 1) * 2);
+
+		std::vector<PixelConversionTask> tasks;
+		tasks.reserve(numTasks);
+		WorkerThreadPool::TaskList taskList;
+		taskList.reserve(numTasks);
+		for (size_t t = 0; t < numTasks; ++t)
+		{
+			*bandBegin = (extent * t) / numTasks;
+			*bandEnd = (extent * (t + 1)) / numTasks;
+			Box srcBand(band.left + src.left, band.top + src.top, band.front + src.front,
+				band.right + src.left, band.bottom + src.top, band.back + src.front);
+			Box dstBand(band.left + dst.left, band.top + dst.top, band.front + dst.front,
+				band.right + dst.left, band.bottom + dst.top, band.back + dst.front);
+			tasks.push_back(PixelConversionTask(
+				src.getSubVolume(srcBand), dst.getSubVolume(dstBand)));
+			taskList.push_back(&tasks.back());
+		}
+		pool->executeTasks(taskList);
+	}
+    //-----------------------------------------------------------------------
+    void PixelUtil::_bulkPixelConversionSerial(const PixelBox &src, const PixelBox &dst)
+    {
         // The easy case
         if(src.format == dst.format) {
             // Everything consecutive?
@@ -1239,7 +1306,7 @@ namespace Ogre {
 			// optimized conversions
 			PixelBox tempdst = dst;
 			tempdst.format = dst.format==PF_X8R8G8B8?PF_A8R8G8B8:PF_A8B8G8R8;
-			bulkPixelConversion(src, tempdst);
+			_bulkPixelConversionSerial(src, tempdst);
 			return;
 		}
 		// Converting from PF_X8R8G8B8 is exactly the same as converting from
@@ -1250,7 +1317,7 @@ namespace Ogre {
 			// optimized conversions
 			PixelBox tempsrc = src;
 			tempsrc.format = src.format==PF_X8R8G8B8?PF_A8R8G8B8:PF_A8B8G8R8;
-			bulkPixelConversion(tempsrc, dst);
+			_bulkPixelConversionSerial(tempsrc, dst);
 			return;
 		}
 
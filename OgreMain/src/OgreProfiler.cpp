@@ -47,6 +47,8 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #include "OgreOverlayManager.h"
 #include "OgreOverlayElement.h"
 #include "OgreOverlayContainer.h"
+#include "OgreException.h"
+#include <fstream>
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -81,6 +83,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     // PROFILER DEFINITIONS
     //-----------------------------------------------------------------------
+    bool Profiler::msCapturing = false;
+    //-----------------------------------------------------------------------
     Profiler::Profiler() {
 
         // init some variables
@@ -96,6 +100,10 @@ namespace Ogre {
         // by default the display will be updated every 10 frames
         mUpdateDisplayFrequency = 10;
 
+        mCaptureBufferSize = 0;
+        mCaptureStart = 0;
+        OGRE_THREAD_POINTER_SET(mThreadCaptureBuffer, 0);
+
     }
     //-----------------------------------------------------------------------
     Profiler::~Profiler() {
@@ -113,6 +121,14 @@ namespace Ogre {
         mDisabledProfiles.clear();
         mProfileBars.clear();
 
+        msCapturing = false;
+        OGRE_THREAD_POINTER_DELETE(mThreadCaptureBuffer);
+        for (CaptureBufferList::iterator i = mCaptureBuffers.begin(); 
+            i != mCaptureBuffers.end(); ++i) {
+            delete *i;
+        }
+        mCaptureBuffers.clear();
+
     }
     //-----------------------------------------------------------------------
     void Profiler::initialize() {
@@ -846,4 +862,142 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
 
+    //-----------------------------------------------------------------------
+    ProfileId Profiler::registerCaptureProfile(const String& profileName) {
+
+        OGRE_LOCK_MUTEX(mCaptureMutex)
+        CaptureProfileMap::iterator i = mCaptureProfileIds.find(profileName);
+        if (i != mCaptureProfileIds.end())
+            return i->second;
+
+        ProfileId id = static_cast<ProfileId>(mCaptureProfileNames.size());
+        mCaptureProfileNames.push_back(profileName);
+        mCaptureProfileIds[profileName] = id;
+        return id;
+
+    }
+    //-----------------------------------------------------------------------
+    const String& Profiler::getCaptureProfileName(ProfileId id) const {
+
+        OGRE_LOCK_MUTEX(mCaptureMutex)
+        return mCaptureProfileNames[id];
+
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::beginCapture(size_t eventsPerThread) {
+
+        OGRE_LOCK_MUTEX(mCaptureMutex)
+        mCaptureBufferSize = std::max(eventsPerThread, (size_t)1);
+        for (CaptureBufferList::iterator i = mCaptureBuffers.begin(); 
+            i != mCaptureBuffers.end(); ++i) {
+            (*i)->events.resize(mCaptureBufferSize);
+            (*i)->next = 0;
+            (*i)->wrapped = false;
+        }
+        mCaptureStart = mTimer->getMicroseconds();
+        msCapturing = true;
+
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::endCapture(void) {
+
+        msCapturing = false;
+
+    }
+    //-----------------------------------------------------------------------
+    ulong Profiler::_getCaptureTime(void) {
+
+        return mTimer->getMicroseconds();
+
+    }
+    //-----------------------------------------------------------------------
+    Profiler::CaptureBuffer* Profiler::getThreadCaptureBuffer(void) {
+
+        CaptureBufferHandle* handle = OGRE_THREAD_POINTER_GET(mThreadCaptureBuffer);
+        if (handle)
+            return handle->buffer;
+
+        // first event from this thread
+        OGRE_LOCK_MUTEX(mCaptureMutex)
+        CaptureBuffer* buffer = new CaptureBuffer();
+        buffer->events.resize(mCaptureBufferSize);
+        buffer->next = 0;
+        buffer->wrapped = false;
+        buffer->threadIndex = mCaptureBuffers.size();
+        mCaptureBuffers.push_back(buffer);
+
+        handle = new CaptureBufferHandle();
+        handle->buffer = buffer;
+        OGRE_THREAD_POINTER_SET(mThreadCaptureBuffer, handle);
+        return buffer;
+
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::_recordCaptureEvent(ProfileId id, ulong start) {
+
+        // the capture may have ended inside the scope
+        if (!msCapturing)
+            return;
+
+        CaptureBuffer* buffer = getThreadCaptureBuffer();
+        CaptureEvent& e = buffer->events[buffer->next];
+        e.id = id;
+        e.start = start;
+        e.end = mTimer->getMicroseconds();
+        if (++buffer->next == buffer->events.size()) {
+            buffer->next = 0;
+            buffer->wrapped = true;
+        }
+
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::writeCapture(std::ostream& os) const {
+
+        OGRE_LOCK_MUTEX(mCaptureMutex)
+        os << "{\"traceEvents\":[";
+        bool first = true;
+        for (CaptureBufferList::const_iterator b = mCaptureBuffers.begin(); 
+            b != mCaptureBuffers.end(); ++b) {
+
+            const CaptureBuffer* buffer = *b;
+            // oldest event first
+            size_t count = buffer->wrapped ? buffer->events.size() : buffer->next;
+            size_t index = buffer->wrapped ? buffer->next : 0;
+            for (size_t n = 0; n < count; ++n, ++index) {
+
+                if (index == buffer->events.size())
+                    index = 0;
+                const CaptureEvent& e = buffer->events[index];
+
+                if (!first)
+                    os << ",";
+                first = false;
+                os << "\n{\"name\":\"";
+                const String& name = mCaptureProfileNames[e.id];
+                for (String::const_iterator c = name.begin(); c != name.end(); ++c) {
+                    if (*c == '"' || *c == '\\')
+                        os << '\\';
+                    os << *c;
+                }
+                os << "\",\"ph\":\"X\",\"ts\":" 
+                    << (e.start - mCaptureStart) << ",\"dur\":" << (e.end - e.start)
+                    << ",\"pid\":0,\"tid\":" << buffer->threadIndex << "}";
+            }
+        }
+        os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::saveCapture(const String& filename) const {
+
+        std::ofstream ofs(filename.c_str());
+        if (!ofs) {
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+                "Unable to open " + filename + " for writing.",
+                "Profiler::saveCapture");
+        }
+        writeCapture(ofs);
+
+    }
+
 }
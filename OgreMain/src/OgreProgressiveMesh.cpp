@@ -87,9 +87,20 @@ namespace Ogre {
     void ProgressiveMesh::build(ushort numLevels, LODFaceList* outList, 
 			VertexReductionQuota quota, Real reductionValue)
     {
-        IndexData* newLod;
+        computeLODs(numLevels, quota, reductionValue);
+        createLODs(outList);
+    }
+    //---------------------------------------------------------------------
+    void ProgressiveMesh::computeLODs(ushort numLevels, 
+			VertexReductionQuota quota, Real reductionValue)
+    {
+        mLODIndexLists.clear();
+        // Costs are set up before the heap is built from them
+        mCollapseHeap.clear();
+        mCollapseHeapPos.clear();
 
         computeAllCosts();
+        initialiseCollapseHeap();
 
 #if OGRE_DEBUG_MODE
 		dumpContents("pm_before.log");
@@ -163,14 +174,57 @@ namespace Ogre {
 #endif
 
             // Bake a new LOD and add it to the list
-            newLod = new IndexData();
-            bakeNewLOD(newLod);
-            outList->push_back(newLod);
+            mLODIndexLists.push_back(LODIndexList());
+            bakeNewLOD(mLODIndexLists.back());
 			
         }
 
 
 
+    }
+    //---------------------------------------------------------------------
+    void ProgressiveMesh::createLODs(LODFaceList* outList)
+    {
+		// Base size of indexes on original 
+		bool use32bitindexes = 
+			(mpIndexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT);
+
+        LODIndexListList::iterator i, iend;
+        iend = mLODIndexLists.end();
+        for (i = mLODIndexLists.begin(); i != iend; ++i)
+        {
+            IndexData* pData = new IndexData();
+            pData->indexCount = i->size();
+            pData->indexStart = 0;
+
+            // Create index buffer, we don't need to read it back or modify it a lot
+            pData->indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+                use32bitindexes? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
+                pData->indexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY, false);
+
+            if (use32bitindexes)
+            {
+                pData->indexBuffer->writeData(0, pData->indexBuffer->getSizeInBytes(),
+                    &((*i)[0]), true);
+            }
+            else
+            {
+                unsigned short* pShort = static_cast<unsigned short*>(
+                    pData->indexBuffer->lock( 0,
+                        pData->indexBuffer->getSizeInBytes(),
+                        HardwareBuffer::HBL_DISCARD));
+                LODIndexList::iterator idx, idxend;
+                idxend = i->end();
+                for (idx = i->begin(); idx != idxend; ++idx)
+                {
+                    *pShort++ = static_cast<unsigned short>(*idx);
+                }
+                pData->indexBuffer->unlock();
+            }
+
+            outList->push_back(pData);
+        }
+        mLODIndexLists.clear();
     }
     //---------------------------------------------------------------------
     void ProgressiveMesh::addWorkingData(const VertexData * vertexData, 
@@ -519,6 +573,7 @@ namespace Ogre {
 		src->collapseTo = NULL;
 		src->collapseCost = NEVER_COLLAPSE_COST;
 		mWorstCosts[src->index] = NEVER_COLLAPSE_COST;
+		updateCollapseHeap(src->index);
 
 		// Collapse the edge uv by moving vertex u onto v
 	    // Actually remove tris on uv, then update tris that
@@ -635,57 +690,94 @@ namespace Ogre {
         }
         // Save the worst cost
         mWorstCosts[vertIndex] = worstCost;
+        updateCollapseHeap(vertIndex);
     }
     //---------------------------------------------------------------------
     size_t ProgressiveMesh::getNextCollapser(void)
     {
-        // Scan
-        // Not done as a sort because want to keep the lookup simple for now
-        Real bestVal = NEVER_COLLAPSE_COST;
-        size_t i, bestIndex;
-		bestIndex = 0; // NB this is ok since if nothing is better than this, nothing will collapse
+        // The top of the heap is the lowest cost vertex, the lowest index one
+        // if several share that cost
+        // NB returning 0 is ok if nothing can collapse, since nothing will
+        if (mCollapseHeap.empty() || 
+            !(mWorstCosts[mCollapseHeap[0]] < NEVER_COLLAPSE_COST))
+        {
+            return 0;
+        }
+        return mCollapseHeap[0];
+    }
+    //---------------------------------------------------------------------
+    void ProgressiveMesh::initialiseCollapseHeap(void)
+    {
+        mCollapseHeap.resize(mNumCommonVertices);
+        mCollapseHeapPos.resize(mNumCommonVertices);
+        size_t i;
         for (i = 0; i < mNumCommonVertices; ++i)
         {
-            if (mWorstCosts[i] < bestVal)
+            mCollapseHeap[i] = i;
+            mCollapseHeapPos[i] = i;
+        }
+        // Heapify bottom up
+        for (i = mNumCommonVertices / 2; i > 0; --i)
+        {
+            collapseHeapSiftDown(i - 1);
+        }
+    }
+    //---------------------------------------------------------------------
+    void ProgressiveMesh::updateCollapseHeap(size_t vertIndex)
+    {
+        // Costs of vertices which are not common vertices are never looked at
+        if (vertIndex >= mCollapseHeapPos.size())
+            return;
+
+        collapseHeapSiftUp(mCollapseHeapPos[vertIndex]);
+        collapseHeapSiftDown(mCollapseHeapPos[vertIndex]);
+    }
+    //---------------------------------------------------------------------
+    void ProgressiveMesh::collapseHeapSiftUp(size_t pos)
+    {
+        size_t vert = mCollapseHeap[pos];
+        while (pos > 0)
+        {
+            size_t parent = (pos - 1) / 2;
+            if (!collapsesBefore(vert, mCollapseHeap[parent]))
+                break;
+            mCollapseHeap[pos] = mCollapseHeap[parent];
+            mCollapseHeapPos[mCollapseHeap[pos]] = pos;
+            pos = parent;
+        }
+        mCollapseHeap[pos] = vert;
+        mCollapseHeapPos[vert] = pos;
+    }
+    //---------------------------------------------------------------------
+    void ProgressiveMesh::collapseHeapSiftDown(size_t pos)
+    {
+        size_t vert = mCollapseHeap[pos];
+        size_t size = mCollapseHeap.size();
+        while (true)
+        {
+            size_t child = pos * 2 + 1;
+            if (child >= size)
+                break;
+            if (child + 1 < size && 
+                collapsesBefore(mCollapseHeap[child + 1], mCollapseHeap[child]))
             {
-                bestVal = mWorstCosts[i];
-                bestIndex = i;
+                ++child;
             }
+            if (!collapsesBefore(mCollapseHeap[child], vert))
+                break;
+            mCollapseHeap[pos] = mCollapseHeap[child];
+            mCollapseHeapPos[mCollapseHeap[pos]] = pos;
+            pos = child;
         }
-        return bestIndex;
+        mCollapseHeap[pos] = vert;
+        mCollapseHeapPos[vert] = pos;
     }
     //---------------------------------------------------------------------
-    void ProgressiveMesh::bakeNewLOD(IndexData* pData)
+    void ProgressiveMesh::bakeNewLOD(LODIndexList& indexes)
     {
         assert(mCurrNumIndexes > 0 && "No triangles to bake!");
         // Zip through the tri list of any working data copy and bake
-        pData->indexCount = mCurrNumIndexes;
-		pData->indexStart = 0;
-		// Base size of indexes on original 
-		bool use32bitindexes = 
-			(mpIndexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT);
-
-		// Create index buffer, we don't need to read it back or modify it a lot
-		pData->indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
-			use32bitindexes? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
-			pData->indexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY, false);
-
-        unsigned short* pShort;
-		unsigned int* pInt;
-		if (use32bitindexes)
-		{
-			pInt = static_cast<unsigned int*>(
-				pData->indexBuffer->lock( 0,
-					pData->indexBuffer->getSizeInBytes(),
-					HardwareBuffer::HBL_DISCARD));
-		}
-		else
-		{
-			pShort = static_cast<unsigned short*>(
-				pData->indexBuffer->lock( 0,
-					pData->indexBuffer->getSizeInBytes(),
-					HardwareBuffer::HBL_DISCARD));
-		}
+        indexes.reserve(mCurrNumIndexes);
         TriangleList::iterator tri, triend;
         // Use the first working data buffer, they are all the same index-wise
         WorkingDataList::iterator pWork = mWorkingData.begin();
@@ -694,21 +786,11 @@ namespace Ogre {
         {
             if (!tri->removed)
             {
-				if (use32bitindexes)
-				{
-					*pInt++ = static_cast<unsigned int>(tri->vertex[0]->realIndex);
-					*pInt++ = static_cast<unsigned int>(tri->vertex[1]->realIndex);
-					*pInt++ = static_cast<unsigned int>(tri->vertex[2]->realIndex);
-				}
-				else
-				{
-					*pShort++ = static_cast<unsigned short>(tri->vertex[0]->realIndex);
-					*pShort++ = static_cast<unsigned short>(tri->vertex[1]->realIndex);
-					*pShort++ = static_cast<unsigned short>(tri->vertex[2]->realIndex);
-				}
+                indexes.push_back(static_cast<uint32>(tri->vertex[0]->realIndex));
+                indexes.push_back(static_cast<uint32>(tri->vertex[1]->realIndex));
+                indexes.push_back(static_cast<uint32>(tri->vertex[2]->realIndex));
             }
         }
-		pData->indexBuffer->unlock();
 
     }
     //---------------------------------------------------------------------
@@ -60,6 +60,12 @@ namespace Ogre {
         , mCullingMode(CULL_CLOCKWISE)
         , mVSync(true)
 		, mWBuffer(false)
+		, mBatchCount(0)
+		, mFaceCount(0)
+		, mVertexCount(0)
+		, mConstantUploadCount(0)
+		, mStateChangeCount(0)
+		, mFilteredStateChangeCount(0)
         , mInvertVertexWinding(false)
         , mDisabledTexUnitsFrom(0)
         , mCurrentPassIterationCount(0)
@@ -70,6 +76,7 @@ namespace Ogre {
 		, mRealCapabilities(0)
 		, mCurrentCapabilities(0)
 		, mUseCustomCapabilities(false)
+		, mStateCacheEnabled(true)
     {
     }
 
@@ -140,6 +147,7 @@ namespace Ogre {
         
         mVertexProgramBound = false;
         mFragmentProgramBound = false;
+        _invalidateStateCache();
 
         return 0;
     }
@@ -435,7 +443,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderSystem::_beginGeometryCount(void)
     {
-        mBatchCount = mFaceCount = mVertexCount = 0;
+        mBatchCount = mFaceCount = mVertexCount = mConstantUploadCount = 0;
+        mStateChangeCount = mFilteredStateChangeCount = 0;
 
     }
     //-----------------------------------------------------------------------
@@ -453,6 +462,37 @@ namespace Ogre {
     {
         return static_cast< unsigned int >( mVertexCount );
     }
+    //-----------------------------------------------------------------------
+    unsigned int RenderSystem::_getConstantUploadCount(void) const
+    {
+        return static_cast< unsigned int >( mConstantUploadCount );
+    }
+    //-----------------------------------------------------------------------
+    unsigned int RenderSystem::_getStateChangeCount(void) const
+    {
+        return static_cast< unsigned int >( mStateChangeCount );
+    }
+    //-----------------------------------------------------------------------
+    unsigned int RenderSystem::_getFilteredStateChangeCount(void) const
+    {
+        return static_cast< unsigned int >( mFilteredStateChangeCount );
+    }
+    //-----------------------------------------------------------------------
+    void RenderSystem::setStateCacheEnabled(bool enabled)
+    {
+        mStateCacheEnabled = enabled;
+    }
+    //-----------------------------------------------------------------------
+    void RenderSystem::_invalidateStateCache(void)
+    {
+        mStateCache = RenderStateCache();
+    }
+    //-----------------------------------------------------------------------
+    void RenderSystem::invalidateTextureStateCache(void)
+    {
+        for (size_t i = 0; i < OGRE_MAX_TEXTURE_LAYERS; ++i)
+            mStateCache.textures[i].valid = false;
+    }
     //-----------------------------------------------------------------------
 	void RenderSystem::convertColourValue(const ColourValue& colour, uint32* pDest)
 	{
@@ -513,6 +553,11 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderSystem::setInvertVertexWinding(bool invert)
     {
+        if (invert != mInvertVertexWinding)
+        {
+            // Culling mode is applied relative to the winding
+            mStateCache.cullingMode.valid = false;
+        }
         mInvertVertexWinding = invert;
     }
 	//---------------------------------------------------------------------
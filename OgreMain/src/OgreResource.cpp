@@ -42,7 +42,7 @@ namespace Ogre
 		const String& group, bool isManual, ManualResourceLoader* loader)
 		: mCreator(creator), mName(name), mGroup(group), mHandle(handle), 
 		mLoadingState(LOADSTATE_UNLOADED), mIsBackgroundLoaded(false),
-		mSize(0), mIsManual(isManual), mLoader(loader), mStateCount(0)
+		mIsPrepared(false), mSize(0), mIsManual(isManual), mLoader(loader), mStateCount(0)
 	{
 	}
 	//-----------------------------------------------------------------------
@@ -57,6 +57,30 @@ namespace Ogre
 		load(true);
 	}
 	//-----------------------------------------------------------------------
+	void Resource::prepare(void)
+	{
+		// Early-out without lock, manual resources have nothing to prepare
+		if (mLoadingState != LOADSTATE_UNLOADED || mIsPrepared || mIsManual)
+			return;
+
+		// Scope lock for actual preparing; a concurrent load() waits for it
+		// and then uses the prepared data
+		OGRE_LOCK_AUTO_MUTEX
+		// Check again in case another thread got here first
+		if (mLoadingState != LOADSTATE_UNLOADED || mIsPrepared)
+			return;
+
+		if (mGroup == ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME)
+		{
+			// Derive resource group
+			changeGroupOwnership(
+				ResourceGroupManager::getSingleton()
+				.findGroupContainingResource(mName));
+		}
+		prepareImpl();
+		mIsPrepared = true;
+	}
+	//-----------------------------------------------------------------------
 	void Resource::load(bool background)
 	{
 		// Early-out without lock (mitigate perf cost of ensuring loaded)
@@ -115,6 +139,12 @@ namespace Ogre
 				}
 				loadImpl();
 			}
+			if (mIsPrepared)
+			{
+				// Prepared data has been consumed
+				unprepareImpl();
+				mIsPrepared = false;
+			}
 			// Calculate resource size
 			mSize = calculateSize();
 
@@ -171,7 +201,19 @@ namespace Ogre
 	{ 
 		// Early-out without lock (mitigate perf cost of ensuring unloaded)
 		if (mLoadingState != LOADSTATE_LOADED)
+		{
+			if (mIsPrepared)
+			{
+				// Discard data prepared for a load which never happened
+				OGRE_LOCK_AUTO_MUTEX
+				if (mIsPrepared && mLoadingState == LOADSTATE_UNLOADED)
+				{
+					unprepareImpl();
+					mIsPrepared = false;
+				}
+			}
 			return;
+		}
 
 		// Scope lock for loading status
 		{
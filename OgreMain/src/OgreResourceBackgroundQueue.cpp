@@ -34,6 +34,7 @@ Torus Knot Software Ltd.
 #include "OgreResourceManager.h"
 #include "OgreRoot.h"
 #include "OgreRenderSystem.h"
+#include "OgreStringConverter.h"
 
 namespace Ogre {
 
@@ -51,7 +52,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------	
 	//------------------------------------------------------------------------
 	ResourceBackgroundQueue::ResourceBackgroundQueue()
-		:mNextTicketID(0), mStartThread(true), mThread(0)
+		:mExclusiveActive(false), mNextTicketID(0), mStartThread(true), 
+		mNumWorkerThreads(1), mMaxUploadsPerFrame(0)
 #if OGRE_THREAD_SUPPORT
         , mShuttingDown(false)
 #endif
@@ -63,6 +65,17 @@ namespace Ogre {
 		shutdown();
 	}
 	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::setNumWorkerThreads(size_t numThreads)
+	{
+		if (numThreads == 0)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, 
+				"At least one background thread is required",
+				"ResourceBackgroundQueue::setNumWorkerThreads");
+		}
+		mNumWorkerThreads = numThreads;
+	}
+	//------------------------------------------------------------------------
 	void ResourceBackgroundQueue::initialise(void)
 	{
 #if OGRE_THREAD_SUPPORT
@@ -76,18 +89,21 @@ namespace Ogre {
 			RenderSystem* rs = Root::getSingleton().getRenderSystem();
 
 			LogManager::getSingleton().logMessage(
-				"ResourceBackgroundQueue - threading enabled, starting own thread");
+				"ResourceBackgroundQueue - threading enabled, starting " +
+				StringConverter::toString(mNumWorkerThreads) + " thread(s)");
 			{
 				OGRE_LOCK_MUTEX_NAMED(initMutex, initLock)
 
 				// Call thread creation pre-hook
 				rs->preExtraThreadsStarted();
 
-				mThread = new boost::thread(
-					boost::function0<void>(&ResourceBackgroundQueue::threadFunc));
-				// Wait for init to finish before allowing main thread to continue
-				// this releases the initMutex until notified
-				OGRE_THREAD_WAIT(initSync, initLock)
+				for (size_t i = 0; i < mNumWorkerThreads; ++i)
+				{
+					mThreads.push_back(new boost::thread(WorkerFunc(this)));
+					// Wait for init to finish before starting the next thread
+					// this releases the initMutex until notified
+					OGRE_THREAD_WAIT(initSync, initLock)
+				}
 
 				// Call thread creation post-hook
 				rs->postExtraThreadsStarted();
@@ -108,27 +124,38 @@ namespace Ogre {
 	void ResourceBackgroundQueue::shutdown(void)
 	{
 #if OGRE_THREAD_SUPPORT
-		if (mThread)
+		if (!mThreads.empty())
 		{
-			// Put a shutdown request on the queue
-			Request req;
-			req.type = RT_SHUTDOWN;
-			addRequest(req);
-			// Wait for thread to finish
-			mThread->join();
-			delete mThread;
-			mThread = 0;
-			mRequestQueue.clear();
-			mRequestTicketMap.clear();
+			{
+				OGRE_LOCK_AUTO_MUTEX
+				mShuttingDown = true;
+				// Wake up all threads so they see the shutdown
+				OGRE_THREAD_NOTIFY_ALL(mCondition)
+			}
+			// Wait for threads to finish the requests they are processing
+			for (ThreadList::iterator i = mThreads.begin(); i != mThreads.end(); ++i)
+			{
+				(*i)->join();
+				delete *i;
+			}
+			mThreads.clear();
 		}
+		// Anything left over is abandoned
+		OGRE_LOCK_AUTO_MUTEX
+		mRequestQueue.clear();
+		mActiveRequests.clear();
+		mUploadQueue.clear();
+		mRequestTicketMap.clear();
+		mExclusiveActive = false;
 #endif
 	}
 	//------------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::initialiseResourceGroup(
-		const String& name, ResourceBackgroundQueue::Listener* listener)
+		const String& name, ResourceBackgroundQueue::Listener* listener,
+		ushort priority)
 	{
 #if OGRE_THREAD_SUPPORT
-		if (!mThread && mStartThread)
+		if (mThreads.empty() && mStartThread)
 		{
 			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 				"Thread not initialised",
@@ -139,6 +166,7 @@ namespace Ogre {
 		req.type = RT_INITIALISE_GROUP;
 		req.groupName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -149,10 +177,10 @@ namespace Ogre {
 	//------------------------------------------------------------------------
 	BackgroundProcessTicket 
 	ResourceBackgroundQueue::initialiseAllResourceGroups( 
-		ResourceBackgroundQueue::Listener* listener)
+		ResourceBackgroundQueue::Listener* listener, ushort priority)
 	{
 #if OGRE_THREAD_SUPPORT
-		if (!mThread && mStartThread)
+		if (mThreads.empty() && mStartThread)
 		{
 			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 				"Thread not initialised",
@@ -162,6 +190,7 @@ namespace Ogre {
 		Request req;
 		req.type = RT_INITIALISE_ALL_GROUPS;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -171,10 +200,11 @@ namespace Ogre {
 	}
 	//------------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::loadResourceGroup(
-		const String& name, ResourceBackgroundQueue::Listener* listener)
+		const String& name, ResourceBackgroundQueue::Listener* listener,
+		ushort priority)
 	{
 #if OGRE_THREAD_SUPPORT
-		if (!mThread && mStartThread)
+		if (mThreads.empty() && mStartThread)
 		{
 			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 				"Thread not initialised",
@@ -185,6 +215,7 @@ namespace Ogre {
 		req.type = RT_LOAD_GROUP;
 		req.groupName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -198,10 +229,10 @@ namespace Ogre {
 		const String& group, bool isManual, 
 		ManualResourceLoader* loader, 
 		const NameValuePairList* loadParams, 
-		ResourceBackgroundQueue::Listener* listener)
+		ResourceBackgroundQueue::Listener* listener, ushort priority)
 	{
 #if OGRE_THREAD_SUPPORT
-		if (!mThread && mStartThread)
+		if (mThreads.empty() && mStartThread)
 		{
 			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 				"Thread not initialised",
@@ -217,6 +248,7 @@ namespace Ogre {
 		req.loader = loader;
 		req.loadParams = loadParams;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -228,10 +260,11 @@ namespace Ogre {
 	}
 	//---------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::unload(
-		const String& resType, const String& name, Listener* listener)
+		const String& resType, const String& name, Listener* listener,
+		ushort priority)
 	{
 #if OGRE_THREAD_SUPPORT
-		if (!mThread && mStartThread)
+		if (mThreads.empty() && mStartThread)
 		{
 			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 				"Thread not initialised",
@@ -243,6 +276,7 @@ namespace Ogre {
 		req.resourceType = resType;
 		req.resourceName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -255,10 +289,11 @@ namespace Ogre {
 	}
 	//---------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::unload(
-		const String& resType, ResourceHandle handle, Listener* listener)
+		const String& resType, ResourceHandle handle, Listener* listener,
+		ushort priority)
 	{
 #if OGRE_THREAD_SUPPORT
-		if (!mThread && mStartThread)
+		if (mThreads.empty() && mStartThread)
 		{
 			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 				"Thread not initialised",
@@ -270,6 +305,7 @@ namespace Ogre {
 		req.resourceType = resType;
 		req.resourceHandle = handle;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -282,10 +318,10 @@ namespace Ogre {
 	}
 	//---------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::unloadResourceGroup(
-		const String& name, Listener* listener)
+		const String& name, Listener* listener, ushort priority)
 	{
 #if OGRE_THREAD_SUPPORT
-		if (!mThread && mStartThread)
+		if (mThreads.empty() && mStartThread)
 		{
 			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 				"Thread not initialised",
@@ -296,6 +332,7 @@ namespace Ogre {
 		req.type = RT_UNLOAD_GROUP;
 		req.groupName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -314,6 +351,67 @@ namespace Ogre {
 		return mRequestTicketMap.find(ticket) == mRequestTicketMap.end();
 	}
 	//------------------------------------------------------------------------
+	bool ResourceBackgroundQueue::cancel(BackgroundProcessTicket ticket)
+	{
+		// Lock
+		OGRE_LOCK_AUTO_MUTEX
+
+		RequestTicketMap::iterator i = mRequestTicketMap.find(ticket);
+		if (i == mRequestTicketMap.end())
+			return false;
+
+		Request* req = i->second;
+		if (req->stage == RS_QUEUED)
+		{
+			// Not started, just forget about it
+			mRequestTicketMap.erase(i);
+			for (RequestQueue::iterator q = mRequestQueue.begin(); 
+				q != mRequestQueue.end(); ++q)
+			{
+				if (q->ticketID == ticket)
+				{
+					mRequestQueue.erase(q);
+					break;
+				}
+			}
+			return true;
+		}
+		else if (req->type == RT_LOAD_RESOURCE)
+		{
+			// Whichever thread finishes the current stage discards it
+			req->cancelled = true;
+			mRequestTicketMap.erase(i);
+			return true;
+		}
+		return false;
+	}
+	//------------------------------------------------------------------------
+	bool ResourceBackgroundQueue::canStartNextRequest(void) const
+	{
+		if (mRequestQueue.empty() || mExclusiveActive)
+			return false;
+
+		if (isExclusive(mRequestQueue.front().type))
+		{
+			// Wait until everything queued before it has completed, so
+			// that e.g. an unload can't overtake the load before it
+			return mActiveRequests.empty() && mUploadQueue.empty();
+		}
+		return true;
+	}
+	//------------------------------------------------------------------------
+	ResourceBackgroundQueue::Request* ResourceBackgroundQueue::startNextRequest(void)
+	{
+		// std::list::splice keeps the element, so the ticket map stays valid
+		mActiveRequests.splice(mActiveRequests.end(), mRequestQueue, 
+			mRequestQueue.begin());
+		Request* req = &(mActiveRequests.back());
+		req->stage = RS_ACTIVE;
+		if (isExclusive(req->type))
+			mExclusiveActive = true;
+		return req;
+	}
+	//------------------------------------------------------------------------
 #if OGRE_THREAD_SUPPORT
 	BackgroundProcessTicket ResourceBackgroundQueue::addRequest(Request& req)
 	{
@@ -321,66 +419,64 @@ namespace Ogre {
 		OGRE_LOCK_AUTO_MUTEX
 
 		req.ticketID = ++mNextTicketID;
-		mRequestQueue.push_back(req);
-		Request* requestInList = &(mRequestQueue.back());
+		req.stage = RS_QUEUED;
+		req.cancelled = false;
+
+		// Insert after the last request of the same or higher priority
+		RequestQueue::iterator pos = mRequestQueue.end();
+		while (pos != mRequestQueue.begin())
+		{
+			RequestQueue::iterator prev = pos;
+			--prev;
+			if (prev->priority >= req.priority)
+				break;
+			pos = prev;
+		}
+		Request* requestInList = &(*mRequestQueue.insert(pos, req));
 		mRequestTicketMap[req.ticketID] = requestInList;
 
-		// Notify to wake up loading thread
-		OGRE_THREAD_NOTIFY_ONE(mCondition)
+		// Notify to wake up loading threads
+		OGRE_THREAD_NOTIFY_ALL(mCondition)
 
 		return req.ticketID;
 	}
 	//------------------------------------------------------------------------
-	void ResourceBackgroundQueue::threadFunc(void)
+	void ResourceBackgroundQueue::workerThreadMain(void)
 	{
-		// Background thread implementation 
-		// Static (since no params allowed), so get instance
-		ResourceBackgroundQueue& queueInstance = 
-			ResourceBackgroundQueue::getSingleton();
-
 		LogManager::getSingleton().logMessage("ResourceBackgroundQueue - thread starting.");
 
 		// Initialise the thread
-		queueInstance._initThread();
+		_initThread();
 
-		// Spin forever until we're told to shut down
-		while (!queueInstance.mShuttingDown)
+		while (true)
 		{
-			// Our thread will just wait when there is nothing on the queue
-			// _doNextQueuedBackgroundProcess won't do this since the thread
-			// may be shared
-
-            // Manual scope block just to define scope of lock
-            {
-                // Lock; note that 'mCondition.wait()' will free the lock
-                boost::recursive_mutex::scoped_lock queueLock(
-                    queueInstance.OGRE_AUTO_MUTEX_NAME);
-                if (queueInstance.mRequestQueue.empty())
-                {
-                    // frees lock and suspends the thread
-                    queueInstance.mCondition.wait(queueLock);
-                }
-                // When we get back here, it's because we've been notified 
-                // and thus the thread as been woken up. Lock has also been
-                // re-acquired.
-            } // release lock so queueing can be done while we process one request
-
-			queueInstance._doNextQueuedBackgroundProcess();
-
-
+			Request* req;
+			// Manual scope block just to define scope of lock
+			{
+				// Lock; note that 'mCondition.wait()' will free the lock
+				boost::recursive_mutex::scoped_lock queueLock(OGRE_AUTO_MUTEX_NAME);
+				while (!mShuttingDown && !canStartNextRequest())
+				{
+					// frees lock and suspends the thread
+					mCondition.wait(queueLock);
+				}
+				if (mShuttingDown)
+					break;
+				req = startNextRequest();
+			} // release lock so queueing can be done while we process one request
+
+			processRequest(req);
 		}
 
+		Root::getSingleton().getRenderSystem()->unregisterThread();
 		LogManager::getSingleton().logMessage("ResourceBackgroundQueue - thread stopped.");
-
-	
-		
 	}
 #endif
 	//-----------------------------------------------------------------------
 	void ResourceBackgroundQueue::_initThread()
 	{
 		// Register the calling thread with RenderSystem
-		// Note how we assume only one thread is processing the queue
+		// Group requests still create render system objects in this thread
 		Root::getSingleton().getRenderSystem()->registerThread();
 		{
 			// notify waiting thread(s)
@@ -392,72 +488,104 @@ namespace Ogre {
 	//-----------------------------------------------------------------------
 	bool ResourceBackgroundQueue::_doNextQueuedBackgroundProcess()
 	{
-
 		Request* req;
 		// Manual scope block just to define scope of lock
 		{
 			OGRE_LOCK_AUTO_MUTEX
-			// return false if nothing in the queue
-			if (mRequestQueue.empty())
+			// return false if nothing can be started
+			if (!canStartNextRequest())
 				return false;
 
-			// Process one request
-			req = &(mRequestQueue.front());
+			req = startNextRequest();
 		} // release lock so queueing can be done while we process one request
-		// use of std::list means that references guarateed to remain valid
-		// we only allow one background thread
 
-		ResourceManager* rm = 0;
-		switch (req->type)
+		processRequest(req);
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	void ResourceBackgroundQueue::processRequest(Request* req)
+	{
+		// use of std::list means that the request stays where it is while
+		// we work on it, and only this thread moves it on
+		bool prepared = false;
+		try
 		{
-		case RT_INITIALISE_GROUP:
-			ResourceGroupManager::getSingleton().initialiseResourceGroup(
-				req->groupName);
-			break;
-		case RT_INITIALISE_ALL_GROUPS:
-			ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
-			break;
-		case RT_LOAD_GROUP:
-			ResourceGroupManager::getSingleton().loadResourceGroup(
-				req->groupName);
-			break;
-		case RT_UNLOAD_GROUP:
-			ResourceGroupManager::getSingleton().unloadResourceGroup(
-				req->groupName);
-			break;
-		case RT_LOAD_RESOURCE:
-			rm = ResourceGroupManager::getSingleton()._getResourceManager(
-				req->resourceType);
-			rm->load(req->resourceName, req->groupName, req->isManual, 
-				req->loader, req->loadParams);
-			break;
-		case RT_UNLOAD_RESOURCE:
-			rm = ResourceGroupManager::getSingleton()._getResourceManager(
-				req->resourceType);
-			if (req->resourceName.empty())
-				rm->unload(req->resourceHandle);
-			else
-				rm->unload(req->resourceName);
-			break;
-		case RT_SHUTDOWN:
-			// That's all folks
-#if OGRE_THREAD_SUPPORT
-			mShuttingDown = true;
-			Root::getSingleton().getRenderSystem()->unregisterThread();
-#endif
-			break;
-		};
+			ResourceManager* rm = 0;
+			switch (req->type)
+			{
+			case RT_INITIALISE_GROUP:
+				ResourceGroupManager::getSingleton().initialiseResourceGroup(
+					req->groupName);
+				break;
+			case RT_INITIALISE_ALL_GROUPS:
+				ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
+				break;
+			case RT_LOAD_GROUP:
+				ResourceGroupManager::getSingleton().loadResourceGroup(
+					req->groupName);
+				break;
+			case RT_UNLOAD_GROUP:
+				ResourceGroupManager::getSingleton().unloadResourceGroup(
+					req->groupName);
+				break;
+			case RT_LOAD_RESOURCE:
+				{
+					// Read and decode here, the main thread does the rest
+					rm = ResourceGroupManager::getSingleton()._getResourceManager(
+						req->resourceType);
+					ResourcePtr res = rm->createOrRetrieve(req->resourceName, 
+						req->groupName, req->isManual, req->loader, 
+						req->loadParams).first;
+					res->prepare();
+					req->resource = res;
+					prepared = true;
+				}
+				break;
+			case RT_UNLOAD_RESOURCE:
+				rm = ResourceGroupManager::getSingleton()._getResourceManager(
+					req->resourceType);
+				if (req->resourceName.empty())
+					rm->unload(req->resourceHandle);
+				else
+					rm->unload(req->resourceName);
+				break;
+			};
+		}
+		catch (Exception& e)
+		{
+			// Nobody to throw to in a background thread; a later synchronous
+			// load of the resource will report the problem again
+			LogManager::getSingleton().logMessage(
+				"ResourceBackgroundQueue - request failed: " + e.getFullDescription());
+		}
 
-		// Queue notification (don't do shutdown since not needed & listeners 
-		// might be being destroyed too
-		if (req->listener && req->type != RT_SHUTDOWN)
+		// cancel() writes the flag from other threads under the lock
+		bool cancelled;
 		{
-			// Fire in-thread notification first
-			req->listener->operationCompletedInThread(req->ticketID);
-			// Then queue main thread notification
-			queueFireBackgroundOperationComplete(req->listener, req->ticketID);
+			OGRE_LOCK_AUTO_MUTEX
+			cancelled = req->cancelled;
+			if (prepared && !cancelled)
+			{
+				// Hand over to the main thread
+				req->stage = RS_UPLOAD;
+				RequestQueue::iterator i = mActiveRequests.begin();
+				while (&(*i) != req)
+					++i;
+				mUploadQueue.splice(mUploadQueue.end(), mActiveRequests, i);
+				return;
+			}
 		}
 
+		if (cancelled)
+		{
+			// Only resource loads can be cancelled while active
+			if (!req->resource.isNull() && !req->resource->isLoaded())
+				req->resource->unload();
+		}
+		else
+		{
+			notifyRequestComplete(*req);
+		}
 
 		{
 			// re-lock to consume completed request
@@ -465,11 +593,90 @@ namespace Ogre {
 
 			// Consume the ticket
 			mRequestTicketMap.erase(req->ticketID);
-			mRequestQueue.pop_front();
+			if (isExclusive(req->type))
+				mExclusiveActive = false;
+			RequestQueue::iterator i = mActiveRequests.begin();
+			while (&(*i) != req)
+				++i;
+			mActiveRequests.erase(i);
+
+			// Something may have been waiting for this request
+			OGRE_THREAD_NOTIFY_ALL(mCondition)
 		}
+	}
+	//-----------------------------------------------------------------------
+	void ResourceBackgroundQueue::processUploads(void)
+	{
+		size_t uploads = 0;
+		while (mMaxUploadsPerFrame == 0 || uploads < mMaxUploadsPerFrame)
+		{
+			Request* req;
+			bool cancelled;
+			{
+				OGRE_LOCK_AUTO_MUTEX
+				if (mUploadQueue.empty())
+					break;
+				req = &(mUploadQueue.front());
+				cancelled = req->cancelled;
+			}
+			// Only this thread removes requests from the upload queue, so
+			// req is valid until we do
 
-		return true;
+			try
+			{
+				if (cancelled)
+				{
+					if (!req->resource->isLoaded())
+						req->resource->unload();
+				}
+				else
+				{
+					// We are the thread which finishes background loads
+					req->resource->load(true);
+					++uploads;
+				}
+			}
+			catch (...)
+			{
+				// Answer the ticket and move on to the next request before 
+				// passing the error on, so neither is left hanging
+				finishUpload(req);
+				throw;
+			}
 
+			finishUpload(req);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void ResourceBackgroundQueue::finishUpload(Request* req)
+	{
+		bool cancelled;
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			cancelled = req->cancelled;
+		}
+
+		if (!cancelled)
+			notifyRequestComplete(*req);
+
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			mRequestTicketMap.erase(req->ticketID);
+			mUploadQueue.pop_front();
+			// Exclusive requests wait for the upload queue to drain
+			OGRE_THREAD_NOTIFY_ALL(mCondition)
+		}
+	}
+	//-----------------------------------------------------------------------
+	void ResourceBackgroundQueue::notifyRequestComplete(const Request& req)
+	{
+		if (req.listener)
+		{
+			// Fire in-thread notification first
+			req.listener->operationCompletedInThread(req.ticketID);
+			// Then queue main thread notification
+			queueFireBackgroundOperationComplete(req.listener, req.ticketID);
+		}
 	}
 	//-----------------------------------------------------------------------
 	void ResourceBackgroundQueue::_queueFireBackgroundLoadingComplete(Resource* res)
@@ -488,6 +695,12 @@ namespace Ogre {
 	//-----------------------------------------------------------------------
 	void ResourceBackgroundQueue::_fireBackgroundLoadingComplete()
 	{
+#if OGRE_THREAD_SUPPORT
+		// Finish loading what the background threads have prepared; this
+		// queues more notifications
+		processUploads();
+#endif
+
 		OGRE_LOCK_MUTEX(mNotificationQueueMutex);
 		for (NotificationQueue::iterator i = mNotificationQueue.begin();
 			i != mNotificationQueue.end(); ++i)
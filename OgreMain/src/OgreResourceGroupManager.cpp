@@ -745,6 +745,8 @@ namespace Ogre {
 		}
 	}
 	//-----------------------------------------------------------------------
+	/// Maximum number of scripts open at once while a group's scripts are parsed
+#define OGRE_SCRIPT_PREPARE_BATCH 64
 	void ResourceGroupManager::parseResourceGroupScripts(ResourceGroup* grp)
 	{
 
@@ -789,22 +791,46 @@ namespace Ogre {
             // Iterate over each list
             for (FileListList::iterator flli = slfli->second->begin(); flli != slfli->second->end(); ++flli)
             {
-			    // Iterate over each item in the list
-			    for (FileInfoList::iterator fii = (*flli)->begin(); fii != (*flli)->end(); ++fii)
+			    // Iterate over the items in the list a batch at a time, so that the
+			    // loader can prepare the scripts of a batch together
+			    FileInfoList::iterator fii = (*flli)->begin();
+			    while (fii != (*flli)->end())
 			    {
-                    LogManager::getSingleton().logMessage(
-                        "Parsing script " + fii->filename);
-                    fireScriptStarted(fii->filename);
-                    {
-                        DataStreamPtr stream = fii->archive->open(fii->filename);
-                        if (!stream.isNull())
-                        {
-							if (mLoadingListener)
-								mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
-                            su->parseScript(stream, grp->name);
-                        }
-                    }
-				    fireScriptEnded(fii->filename);
+				    FileInfoList::iterator batchBegin = fii;
+				    DataStreamList streams;
+				    for (size_t n = 0; n < OGRE_SCRIPT_PREPARE_BATCH && fii != (*flli)->end(); ++n, ++fii)
+				    {
+					    DataStreamPtr stream = fii->archive->open(fii->filename);
+					    if (!stream.isNull() && mLoadingListener)
+						    mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
+					    streams.push_back(stream);
+				    }
+				    try
+				    {
+					    su->prepareScripts(streams, grp->name);
+
+					    // Parse in the original order
+					    DataStreamList::iterator si = streams.begin();
+					    for (FileInfoList::iterator bi = batchBegin; bi != fii; ++bi, ++si)
+					    {
+						    LogManager::getSingleton().logMessage(
+							    "Parsing script " + bi->filename);
+						    fireScriptStarted(bi->filename);
+						    if (!si->isNull())
+						    {
+							    su->parseScript(*si, grp->name);
+							    // Close the stream as soon as it's done with
+							    si->setNull();
+						    }
+						    fireScriptEnded(bi->filename);
+					    }
+				    }
+				    catch (...)
+				    {
+					    // Let the loader drop its hold on the streams not parsed
+					    su->unprepareScripts(streams);
+					    throw;
+				    }
 			    }
             }
 		}
@@ -1352,6 +1378,43 @@ namespace Ogre {
 		return false;
 
 	}
+    //-----------------------------------------------------------------------
+	time_t ResourceGroupManager::resourceModifiedTime(const String& groupName, const String& resourceName)
+	{
+        OGRE_LOCK_AUTO_MUTEX
+
+        ResourceGroup* grp = getResourceGroup(groupName);
+        if (!grp)
+        {
+            OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
+                "Cannot locate a resource group called '" + groupName + "'", 
+                "ResourceGroupManager::resourceModifiedTime");
+        }
+
+		OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME) // lock group mutex
+
+		// Try indexes first
+		ResourceLocationIndex::iterator rit = grp->resourceIndexCaseSensitive.find(resourceName);
+		if (rit != grp->resourceIndexCaseSensitive.end())
+			return rit->second->getModifiedTime(resourceName);
+
+		String lcResourceName = resourceName;
+		StringUtil::toLowerCase(lcResourceName);
+		rit = grp->resourceIndexCaseInsensitive.find(lcResourceName);
+		if (rit != grp->resourceIndexCaseInsensitive.end())
+			return rit->second->getModifiedTime(resourceName);
+
+		// Search the hard way
+		for (LocationList::iterator li = grp->locationList.begin(); 
+			li != grp->locationList.end(); ++li)
+		{
+			Archive* arch = (*li)->archive;
+			if (arch->exists(resourceName))
+				return arch->getModifiedTime(resourceName);
+		}
+
+		return 0;
+	}
     //-----------------------------------------------------------------------
 	ResourceGroupManager::ResourceGroup* 
 	ResourceGroupManager::findGroupContainingResourceImpl(const String& filename)
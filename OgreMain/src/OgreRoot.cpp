@@ -58,6 +58,7 @@ Torus Knot Software Ltd.
 #include "OgreFileSystem.h"
 #include "OgreShadowVolumeExtrudeProgram.h"
 #include "OgreResourceBackgroundQueue.h"
+#include "OgreWorkerThreadPool.h"
 #include "OgreEntity.h"
 #include "OgreBillboardSet.h"
 #include "OgreBillboardChain.h"
@@ -147,6 +148,9 @@ namespace Ogre {
 		// ResourceBackgroundQueue
 		mResourceBackgroundQueue = new ResourceBackgroundQueue();
 
+		// WorkerThreadPool
+		mWorkerThreadPool = new WorkerThreadPool();
+
 		// Create SceneManager enumerator (note - will be managed by singleton)
         mSceneManagerEnum = new SceneManagerEnumerator();
         mCurrentSceneManager = NULL;
@@ -293,6 +297,7 @@ namespace Ogre {
         delete mMaterialManager;
         Pass::processPendingPassUpdates(); // make sure passes are cleaned
 		delete mResourceBackgroundQueue;
+		delete mWorkerThreadPool;
         delete mResourceGroupManager;
 
 		delete mEntityFactory;
@@ -833,6 +838,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     bool Root::renderOneFrame(void)
     {
+        OgreProfileCapture("Root::renderOneFrame");
+
         if(!_fireFrameStarted())
             return false;
 
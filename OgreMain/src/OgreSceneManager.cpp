@@ -68,6 +68,11 @@ Torus Knot Software Ltd.
 #include "OgreBillboardChain.h"
 #include "OgreRibbonTrail.h"
 #include "OgreParticleSystemManager.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreSoftwareSkinningBatch.h"
+#include "OgreNodeTransformStore.h"
+#include "OgreSceneQueryBVH.h"
+#include "OgreProfiler.h"
 // This class implements the most basic scene manager
 
 #include <cstdio>
@@ -108,6 +113,8 @@ mResetIdentityView(false),
 mResetIdentityProj(false),
 mNormaliseNormalsOnScale(true),
 mLightsDirtyCounter(0),
+mLightSpatialIndexCounter(0),
+mMaxLightsPerObject(0),
 mShadowCasterPlainBlackPass(0),
 mShadowReceiverPass(0),
 mDisplayNodes(false),
@@ -141,7 +148,16 @@ mShadowTextureCustomReceiverPass(0),
 mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
 mSuppressRenderStateChanges(false),
-mSuppressShadows(false)
+mSuppressShadows(false),
+mParallelSceneGraphUpdate(false),
+mParallelSceneGraphUpdateMaxSplitDepth(8),
+mUpdatingSceneGraphInParallel(false),
+mNodeTransformStore(0),
+mParallelFindVisibleObjects(false),
+mParallelSoftwareSkinning(false),
+mSoftwareSkinningBatch(0),
+mSoftwareSkinningBatchOpen(false),
+mSceneQueryBVH(0)
 {
 
     // init sky
@@ -172,6 +188,13 @@ mSuppressShadows(false)
 //-----------------------------------------------------------------------
 SceneManager::~SceneManager()
 {
+	delete mNodeTransformStore;
+	mNodeTransformStore = 0;
+	delete mSoftwareSkinningBatch;
+	mSoftwareSkinningBatch = 0;
+	delete mSceneQueryBVH;
+	mSceneQueryBVH = 0;
+
     clearScene();
     destroyAllCameras();
 
@@ -387,31 +410,58 @@ bool SceneManager::lightLess::operator()(const Light* a, const Light* b) const
     return a->tempSquareDist < b->tempSquareDist;
 }
 //-----------------------------------------------------------------------
+namespace
+{
+	/// A light in range of the position passed to _populateLightList
+	struct LightInRange
+	{
+		Light* light;
+		/// Index in the lights affecting the frustum, to keep sorting stable
+		size_t index;
+
+		LightInRange(Light* l, size_t i) : light(l), index(i) {}
+		bool operator<(const LightInRange& rhs) const
+		{
+			if (light->tempSquareDist != rhs.light->tempSquareDist)
+				return light->tempSquareDist < rhs.light->tempSquareDist;
+			return index < rhs.index;
+		}
+	};
+}
+//-----------------------------------------------------------------------
 void SceneManager::_populateLightList(const Vector3& position, Real radius, 
 									  LightList& destList)
 {
-    // Really basic trawl of the lights, then sort
-    // Subclasses could do something smarter
-
     // Pick up the lights that affecting frustum only, which should has been
     // cached, so better than take all lights in the scene into account.
     const LightList& candidateLights = _getLightsAffectingFrustum();
 
-    // Pre-allocate memory
-    destList.clear();
-    destList.reserve(candidateLights.size());
-
-    LightList::const_iterator it;
-    for (it = candidateLights.begin(); it != candidateLights.end(); ++it)
+	// Look up the lights near the position rather than testing them all;
+	// the index only changes when the lights do
+	if (mLightSpatialIndexCounter != mLightsDirtyCounter ||
+		mLightSpatialIndex.getNumLights() != candidateLights.size())
+	{
+		mLightSpatialIndex.build(candidateLights);
+		mLightSpatialIndexCounter = mLightsDirtyCounter;
+	}
+	LightSpatialIndex::IndexList nearLights;
+	mLightSpatialIndex.findLights(position, radius, nearLights);
+
+	// Indexes come back in order, so this keeps the frustum list ordering
+	std::vector<LightInRange> inRange;
+	inRange.reserve(nearLights.size());
+	LightSpatialIndex::IndexList::const_iterator it, itend;
+	itend = nearLights.end();
+	for (it = nearLights.begin(); it != itend; ++it)
     {
-        Light* lt = *it;
+        Light* lt = candidateLights[*it];
 		// Calc squared distance
 		lt->_calcTempSquareDist(position);
 
         if (lt->getType() == Light::LT_DIRECTIONAL)
         {
             // Always included
-            destList.push_back(lt);
+            inRange.push_back(LightInRange(lt, *it));
         }
         else
         {
@@ -420,35 +470,43 @@ void SceneManager::_populateLightList(const Vector3& position, Real radius,
             Real maxDist = range + radius;
             if (lt->tempSquareDist <= Math::Sqr(maxDist))
             {
-                destList.push_back(lt);
+                inRange.push_back(LightInRange(lt, *it));
             }
         }
     }
 
-    // Sort (stable to guarantee ordering on directional lights)
+	// Sort, keeping directional lights in their original order
+	size_t unsortedCount = 0;
 	if (isShadowTechniqueTextureBased())
 	{
 		// Note that if we're using texture shadows, we actually want to use
 		// the first few lights unchanged from the frustum list, matching the
 		// texture shadows that were generated
 		// Thus we only allow object-relative sorting on the remainder of the list
-		if (destList.size() > getShadowTextureCount())
-		{
-			LightList::iterator start = destList.begin();
-			std::advance(start, getShadowTextureCount());
-			std::stable_sort(start, destList.end(), lightLess());
-		}
+		unsortedCount = std::min(inRange.size(), getShadowTextureCount());
+	}
+	size_t count = inRange.size();
+	if (mMaxLightsPerObject)
+	{
+		count = std::min(count, std::max(mMaxLightsPerObject, unsortedCount));
+	}
+	std::vector<LightInRange>::iterator sortStart = inRange.begin() + unsortedCount;
+	if (count < inRange.size())
+	{
+		// Only the closest few are needed
+		std::partial_sort(sortStart, inRange.begin() + count, inRange.end());
 	}
 	else
 	{
-		std::stable_sort(destList.begin(), destList.end(), lightLess());
+		std::sort(sortStart, inRange.end());
 	}
 
 	// Now assign indexes in the list so they can be examined if needed
-	size_t lightIndex = 0;
-	for (LightList::iterator li = destList.begin(); li != destList.end(); ++li, ++lightIndex)
+	destList.resize(count);
+	for (size_t lightIndex = 0; lightIndex < count; ++lightIndex)
 	{
-		(*li)->_notifyIndexInFrame(lightIndex);
+		destList[lightIndex] = inRange[lightIndex].light;
+		destList[lightIndex]->_notifyIndexInFrame(lightIndex);
 	}
 
 
@@ -1122,6 +1180,8 @@ void SceneManager::prepareRenderQueue(void)
 //-----------------------------------------------------------------------
 void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverlays)
 {
+	OgreProfileCapture("SceneManager::_renderScene");
+
     Root::getSingleton()._setCurrentSceneManager(this);
 	mActiveQueuedRenderableVisitor->targetSceneMgr = this;
 	mAutoParamDataSource->setCurrentSceneManager(this);
@@ -1266,8 +1326,38 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
 			// Parse the scene and tag visibles
 			firePreFindVisibleObjects(vp);
-			_findVisibleObjects(camera, &(camVisObjIt->second),
-				mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+			// Collect the software skinning of the objects found, unless an
+			// outer search is already collecting it
+			bool batchSkinning = mParallelSoftwareSkinning && !mSoftwareSkinningBatchOpen &&
+				WorkerThreadPool::getSingleton().isParallel();
+			if (batchSkinning)
+			{
+				if (!mSoftwareSkinningBatch)
+					mSoftwareSkinningBatch = new SoftwareSkinningBatch();
+				mSoftwareSkinningBatchOpen = true;
+			}
+			try
+			{
+				_findVisibleObjects(camera, &(camVisObjIt->second),
+					mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+			}
+			catch (...)
+			{
+				if (batchSkinning)
+				{
+					// Stop collecting, or every later search would leave its
+					// skinning in a batch nobody executes; the blends found so
+					// far may refer to objects being torn down, so drop them
+					mSoftwareSkinningBatchOpen = false;
+					mSoftwareSkinningBatch->clear();
+				}
+				throw;
+			}
+			if (batchSkinning)
+			{
+				mSoftwareSkinningBatchOpen = false;
+				mSoftwareSkinningBatch->execute();
+			}
 			firePostFindVisibleObjects(vp);
 
 			mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
@@ -1927,6 +2017,8 @@ MeshPtr SceneManager::createSkydomePlane(
 //-----------------------------------------------------------------------
 void SceneManager::_updateSceneGraph(Camera* cam)
 {
+	OgreProfileCapture("SceneManager::_updateSceneGraph");
+
 	// Process queued needUpdate calls 
 	Node::processQueuedUpdates();
 
@@ -1934,22 +2026,350 @@ void SceneManager::_updateSceneGraph(Camera* cam)
     // In this implementation, just update from the root
     // Smarter SceneManager subclasses may choose to update only
     //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+	if (mNodeTransformStore)
+	{
+		mNodeTransformStore->update();
+	}
+	else if (mParallelSceneGraphUpdate)
+	{
+		updateSceneGraphParallel();
+	}
+	else
+	{
+		getRootSceneNode()->_update(true, false);
+	}
 
+	_updateSceneQueryBVH();
+
+}
+//-----------------------------------------------------------------------
+void SceneManager::setUseNodeTransformStore(bool enabled)
+{
+	if (enabled == (mNodeTransformStore != 0))
+		return;
+
+	if (enabled)
+	{
+		mNodeTransformStore = new NodeTransformStore(getRootSceneNode());
+	}
+	else
+	{
+		delete mNodeTransformStore;
+		mNodeTransformStore = 0;
+		// Nodes in the store haven't been notifying their parents of changes
+		getRootSceneNode()->needUpdate();
+	}
+}
+//-----------------------------------------------------------------------
+void SceneManager::setUseSceneQueryBVH(bool enabled)
+{
+	if (enabled == (mSceneQueryBVH != 0))
+		return;
+
+	if (enabled)
+	{
+		mSceneQueryBVH = new SceneQueryBVH();
+
+		// Add the objects which already exist
+		OGRE_LOCK_MUTEX(mMovableObjectCollectionMapMutex)
+		MovableObjectCollectionMap::iterator ci, ciend = mMovableObjectCollectionMap.end();
+		for (ci = mMovableObjectCollectionMap.begin(); ci != ciend; ++ci)
+		{
+			OGRE_LOCK_MUTEX(ci->second->mutex)
+			MovableObjectMap::iterator i, iend = ci->second->map.end();
+			for (i = ci->second->map.begin(); i != iend; ++i)
+			{
+				mSceneQueryBVH->addObject(i->second);
+			}
+		}
+	}
+	else
+	{
+		delete mSceneQueryBVH;
+		mSceneQueryBVH = 0;
+	}
+}
+//-----------------------------------------------------------------------
+void SceneManager::_updateSceneQueryBVH(void)
+{
+	if (mSceneQueryBVH)
+	{
+		OgreProfileCapture("SceneManager::_updateSceneQueryBVH");
+		mSceneQueryBVH->update();
+	}
+}
+//-----------------------------------------------------------------------
+namespace
+{
+	/// Task which updates a range of independent subtrees of the scene graph
+	class SubtreeUpdateTask : public WorkerThreadPool::Task
+	{
+	protected:
+		Node::PendingUpdateList::const_iterator mBegin, mEnd;
+	public:
+		SubtreeUpdateTask(Node::PendingUpdateList::const_iterator begin,
+			Node::PendingUpdateList::const_iterator end) 
+			: mBegin(begin), mEnd(end) {}
+		void execute(void)
+		{
+			for (Node::PendingUpdateList::const_iterator i = mBegin; i != mEnd; ++i)
+			{
+				i->node->_update(true, i->parentHasChanged);
+			}
+		}
+	};
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateSceneGraphParallel(void)
+{
+	WorkerThreadPool& pool = WorkerThreadPool::getSingleton();
+	// Aim for a few subtrees per thread so that uneven subtrees balance out
+	const size_t targetSubtrees = (pool.getNumWorkerThreads() + 1) * 4;
+
+	// Nodes updated above the split, in breadth first order
+	std::vector<SceneNode*> splitNodes;
+	Node::PendingUpdateList frontier, nextFrontier;
+	frontier.push_back(Node::PendingUpdate(getRootSceneNode(), false));
+
+	for (size_t depth = 0; depth < mParallelSceneGraphUpdateMaxSplitDepth && 
+		!frontier.empty() && frontier.size() < targetSubtrees; ++depth)
+	{
+		nextFrontier.clear();
+		for (Node::PendingUpdateList::iterator i = frontier.begin(); 
+			i != frontier.end(); ++i)
+		{
+			i->node->_updateCollectChildren(i->parentHasChanged, nextFrontier);
+			splitNodes.push_back(static_cast<SceneNode*>(i->node));
+		}
+		frontier.swap(nextFrontier);
+	}
+
+	// Update the independent subtrees, in no more tasks than we aimed for
+	size_t numTasks = std::min(frontier.size(), targetSubtrees);
+	std::vector<SubtreeUpdateTask> tasks;
+	tasks.reserve(numTasks);
+	WorkerThreadPool::TaskList taskList;
+	taskList.reserve(numTasks);
+	for (size_t t = 0; t < numTasks; ++t)
+	{
+		tasks.push_back(SubtreeUpdateTask(
+			frontier.begin() + (frontier.size() * t) / numTasks,
+			frontier.begin() + (frontier.size() * (t + 1)) / numTasks));
+		taskList.push_back(&tasks.back());
+	}
+	mUpdatingSceneGraphInParallel = true;
+	try
+	{
+		pool.executeTasks(taskList);
+	}
+	catch (...)
+	{
+		mUpdatingSceneGraphInParallel = false;
+		throw;
+	}
+	mUpdatingSceneGraphInParallel = false;
+
+	// Finish the bounds of the split nodes, children before parents
+	for (std::vector<SceneNode*>::reverse_iterator i = splitNodes.rbegin(); 
+		i != splitNodes.rend(); ++i)
+	{
+		(*i)->_updateBounds();
+	}
 
 }
 //-----------------------------------------------------------------------
 void SceneManager::_findVisibleObjects(
 	Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+	OgreProfileCapture("SceneManager::_findVisibleObjects");
+
+	if (mParallelFindVisibleObjects && WorkerThreadPool::getSingleton().isParallel())
+	{
+		findVisibleObjectsParallel(cam, visibleBounds, onlyShadowCasters);
+		return;
+	}
+
     // Tell nodes to find, cascade down all nodes
     getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
         mDisplayNodes, onlyShadowCasters);
 
+}
+//-----------------------------------------------------------------------
+namespace
+{
+	/** Step of a search for visible objects, in the order the serial 
+		SceneNode::_findVisibleObjects would perform it. */
+	struct VisibleNodeStep
+	{
+		enum Type
+		{
+			/// Queue the objects attached to a visible node
+			VNS_ATTACHED_OBJECTS,
+			/// Queue the debug renderables of a visible node
+			VNS_DEBUG_RENDERABLES,
+			/// Perform the steps found by culling a subtree in parallel
+			VNS_SUBTREE
+		};
+		Type type;
+		SceneNode* node;
+		/// Index of the subtree, for VNS_SUBTREE
+		size_t subtree;
+
+		VisibleNodeStep(Type t, SceneNode* n, size_t s = 0) 
+			: type(t), node(n), subtree(s) {}
+	};
+	typedef std::vector<VisibleNodeStep> VisibleNodeStepList;
+
+	/** Culls a subtree against the camera, recording the steps needed to 
+		queue its visible objects. Nodes deeper than splitDepth are not 
+		visited, a VNS_SUBTREE step being recorded for them instead.
+	*/
+	void findVisibleNodeSteps(const Camera* cam, SceneNode* node, size_t depth,
+		size_t splitDepth, VisibleNodeStepList& steps, std::vector<SceneNode*>& subtrees)
+	{
+		if (depth == splitDepth)
+		{
+			steps.push_back(VisibleNodeStep(
+				VisibleNodeStep::VNS_SUBTREE, node, subtrees.size()));
+			subtrees.push_back(node);
+			return;
+		}
+
+		if (!cam->isVisible(node->_getWorldAABB()))
+			return;
+
+		steps.push_back(VisibleNodeStep(VisibleNodeStep::VNS_ATTACHED_OBJECTS, node));
+		Node::ChildNodeIterator it = node->getChildIterator();
+		while (it.hasMoreElements())
+		{
+			findVisibleNodeSteps(cam, static_cast<SceneNode*>(it.getNext()), 
+				depth + 1, splitDepth, steps, subtrees);
+		}
+		steps.push_back(VisibleNodeStep(VisibleNodeStep::VNS_DEBUG_RENDERABLES, node));
+	}
+
+	/// Where the steps for one subtree ended up
+	struct SubtreeSteps
+	{
+		const VisibleNodeStepList* steps;
+		size_t begin, end;
+	};
+
+	/// Task which culls a range of independent subtrees of the scene graph
+	class SubtreeCullTask : public WorkerThreadPool::Task
+	{
+	protected:
+		const Camera* mCamera;
+		const std::vector<SceneNode*>* mSubtrees;
+		size_t mBegin, mEnd;
+		std::vector<SubtreeSteps>* mResults;
+		VisibleNodeStepList mSteps;
+	public:
+		SubtreeCullTask(const Camera* cam, const std::vector<SceneNode*>* subtrees,
+			size_t begin, size_t end, std::vector<SubtreeSteps>* results)
+			: mCamera(cam), mSubtrees(subtrees), mBegin(begin), mEnd(end), 
+			mResults(results) {}
+		void execute(void)
+		{
+			std::vector<SceneNode*> noSubtrees;
+			for (size_t i = mBegin; i != mEnd; ++i)
+			{
+				SubtreeSteps& result = (*mResults)[i];
+				result.steps = &mSteps;
+				result.begin = mSteps.size();
+				findVisibleNodeSteps(mCamera, (*mSubtrees)[i], 0, 
+					std::numeric_limits<size_t>::max(), mSteps, noSubtrees);
+				result.end = mSteps.size();
+			}
+		}
+	};
+}
+//-----------------------------------------------------------------------
+void SceneManager::findVisibleObjectsParallel(Camera* cam, 
+	VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+{
+	WorkerThreadPool& pool = WorkerThreadPool::getSingleton();
+	// Aim for a few subtrees per thread so that uneven subtrees balance out
+	const size_t targetSubtrees = (pool.getNumWorkerThreads() + 1) * 4;
+
+	// Find the shallowest depth with enough nodes to split the work up
+	size_t splitDepth = 0;
+	std::vector<Node*> level, nextLevel;
+	level.push_back(getRootSceneNode());
+	while (!level.empty() && level.size() < targetSubtrees)
+	{
+		nextLevel.clear();
+		for (std::vector<Node*>::iterator i = level.begin(); i != level.end(); ++i)
+		{
+			Node::ChildNodeIterator it = (*i)->getChildIterator();
+			while (it.hasMoreElements())
+				nextLevel.push_back(it.getNext());
+		}
+		level.swap(nextLevel);
+		++splitDepth;
+	}
+
+	// Make any pending updates to the culling frustum now, so the workers
+	// only ever read from it
+	cam->isVisible(Vector3::ZERO);
+
+	// Cull the levels above the split serially
+	VisibleNodeStepList steps;
+	std::vector<SceneNode*> subtrees;
+	findVisibleNodeSteps(cam, getRootSceneNode(), 0, splitDepth, steps, subtrees);
+
+	// Cull the subtrees below the split, in no more tasks than we aimed for
+	std::vector<SubtreeSteps> subtreeSteps(subtrees.size());
+	size_t numTasks = std::min(subtrees.size(), targetSubtrees);
+	std::vector<SubtreeCullTask> tasks;
+	tasks.reserve(numTasks);
+	WorkerThreadPool::TaskList taskList;
+	taskList.reserve(numTasks);
+	for (size_t t = 0; t < numTasks; ++t)
+	{
+		tasks.push_back(SubtreeCullTask(cam, &subtrees, 
+			(subtrees.size() * t) / numTasks, (subtrees.size() * (t + 1)) / numTasks,
+			&subtreeSteps));
+		taskList.push_back(&tasks.back());
+	}
+	pool.executeTasks(taskList);
+
+	// Queue everything that was found, in the same order as the serial search
+	RenderQueue* queue = getRenderQueue();
+	for (VisibleNodeStepList::iterator i = steps.begin(); i != steps.end(); ++i)
+	{
+		VisibleNodeStepList::const_iterator sub, subend;
+		if (i->type == VisibleNodeStep::VNS_SUBTREE)
+		{
+			const SubtreeSteps& result = subtreeSteps[i->subtree];
+			sub = result.steps->begin() + result.begin;
+			subend = result.steps->begin() + result.end;
+		}
+		else
+		{
+			sub = i;
+			subend = i + 1;
+		}
+
+		for (; sub != subend; ++sub)
+		{
+			if (sub->type == VisibleNodeStep::VNS_ATTACHED_OBJECTS)
+			{
+				sub->node->_queueAttachedObjects(cam, queue, visibleBounds, onlyShadowCasters);
+			}
+			else
+			{
+				sub->node->_queueDebugRenderables(queue, mDisplayNodes);
+			}
+		}
+	}
+
 }
 //-----------------------------------------------------------------------
 void SceneManager::_renderVisibleObjects(void)
 {
+	OgreProfileCapture("SceneManager::_renderVisibleObjects");
+
 	RenderQueueInvocationSequence* invocationSequence = 
 		mCurrentViewport->_getRenderQueueInvocationSequence();
 	// Use custom sequence only if we're not doing the texture shadow render
@@ -3386,6 +3806,8 @@ void SceneManager::destroyAllAnimationStates(void)
 //-----------------------------------------------------------------------
 void SceneManager::_applySceneAnimations(void)
 {
+	OgreProfileCapture("SceneManager::_applySceneAnimations");
+
 	// manual lock over states (extended duration required)
 	OGRE_LOCK_MUTEX(mAnimationStates.OGRE_AUTO_MUTEX_NAME)
 
@@ -3415,7 +3837,8 @@ void SceneManager::_applySceneAnimations(void)
         }
 
         // Apply the animation
-        anim->apply(state->getTimePosition(), state->getWeight());
+        anim->apply(anim->_getTimeIndex(state->getTimePosition(), 
+            state->_getKeyFrameCursor(anim)), state->getWeight());
     }
 
 
@@ -3873,6 +4296,7 @@ void SceneManager::findLightsAffectingFrustum(const Camera* camera)
 		// Pre-allocate memory
 		mTestLightInfos.clear();
 		mTestLightInfos.reserve(lights->map.size());
+		mTestLightSpheres.clear();
 
 		MovableObjectIterator it(lights->map.begin(), lights->map.end());
 
@@ -3894,19 +4318,39 @@ void SceneManager::findLightsAffectingFrustum(const Camera* camera)
 				else
 				{
 					// NB treating spotlight as point for simplicity
-					// Just see if the lights attenuation range is within the frustum
+					// Just see if the lights attenuation range is within the frustum,
+					// all of the ranges are culled at once below
 					lightInfo.range = l->getAttenuationRange();
 					lightInfo.position = l->getDerivedPosition();
-					Sphere sphere(lightInfo.position, lightInfo.range);
-					if (camera->isVisible(sphere))
-					{
-						mTestLightInfos.push_back(lightInfo);
-					}
+					mTestLightSpheres.push_back(Sphere(lightInfo.position, lightInfo.range));
+					mTestLightInfos.push_back(lightInfo);
 				}
 			}
 		}
 	} // release lock on lights collection
 
+	// Remove the lights whose range is outside the frustum, keeping the order
+	if (!mTestLightSpheres.empty())
+	{
+		mTestLightVisibility.resize((mTestLightSpheres.size() + 31) / 32);
+		camera->isVisible(&mTestLightSpheres[0], mTestLightSpheres.size(), &mTestLightVisibility[0]);
+
+		LightInfoList::iterator dst = mTestLightInfos.begin();
+		size_t sphereIndex = 0;
+		for (LightInfoList::iterator src = mTestLightInfos.begin(); src != mTestLightInfos.end(); ++src)
+		{
+			if (src->type != Light::LT_DIRECTIONAL)
+			{
+				bool visible = (mTestLightVisibility[sphereIndex >> 5] & (1u << (sphereIndex & 31))) != 0;
+				++sphereIndex;
+				if (!visible)
+					continue;
+			}
+			*dst++ = *src;
+		}
+		mTestLightInfos.erase(dst, mTestLightInfos.end());
+	}
+
     // Update lights affecting frustum if changed
     if (mCachedLightInfos != mTestLightInfos)
     {
@@ -5587,6 +6031,8 @@ void SceneManager::destroyShadowTextures(void)
 //---------------------------------------------------------------------
 void SceneManager::prepareShadowTextures(Camera* cam, Viewport* vp)
 {
+	OgreProfileCapture("SceneManager::prepareShadowTextures");
+
 	// create shadow textures if needed
 	ensureShadowTexturesCreated();
 
@@ -5909,6 +6355,8 @@ MovableObject* SceneManager::createMovableObject(const String& name,
 
 		MovableObject* newObj = factory->createInstance(name, this, params);
 		objectMap->map[name] = newObj;
+		if (mSceneQueryBVH)
+			mSceneQueryBVH->addObject(newObj);
 		return newObj;
 	}
 
@@ -5932,6 +6380,8 @@ void SceneManager::destroyMovableObject(const String& name, const String& typeNa
 		MovableObjectMap::iterator mi = objectMap->map.find(name);
 		if (mi != objectMap->map.end())
 		{
+			if (mSceneQueryBVH)
+				mSceneQueryBVH->removeObject(mi->second);
 			factory->destroyInstance(mi->second);
 			objectMap->map.erase(mi);
 		}
@@ -5955,6 +6405,8 @@ void SceneManager::destroyAllMovableObjectsByType(const String& typeName)
 		MovableObjectMap::iterator i = objectMap->map.begin();
 		for (; i != objectMap->map.end(); ++i)
 		{
+			if (mSceneQueryBVH)
+				mSceneQueryBVH->removeObject(i->second);
 			// Only destroy our own
 			if (i->second->_getManager() == this)
 			{
@@ -5970,6 +6422,10 @@ void SceneManager::destroyAllMovableObjects(void)
 	// Lock collection mutex
 	OGRE_LOCK_MUTEX(mMovableObjectCollectionMapMutex)
 
+	// Every collection is emptied
+	if (mSceneQueryBVH)
+		mSceneQueryBVH->clear();
+
 	MovableObjectCollectionMap::iterator ci = mMovableObjectCollectionMap.begin();
 
 	for(;ci != mMovableObjectCollectionMap.end(); ++ci)
@@ -6063,6 +6519,8 @@ void SceneManager::injectMovableObject(MovableObject* m)
 		OGRE_LOCK_MUTEX(objectMap->mutex)
 
 		objectMap->map[m->getName()] = m;
+		if (mSceneQueryBVH)
+			mSceneQueryBVH->addObject(m);
 	}
 }
 //---------------------------------------------------------------------
@@ -6075,6 +6533,8 @@ void SceneManager::extractMovableObject(const String& name, const String& typeNa
 		if (mi != objectMap->map.end())
 		{
 			// no delete
+			if (mSceneQueryBVH)
+				mSceneQueryBVH->removeObject(mi->second);
 			objectMap->map.erase(mi);
 		}
 	}
@@ -6091,6 +6551,12 @@ void SceneManager::extractAllMovableObjectsByType(const String& typeName)
 	MovableObjectCollection* objectMap = getMovableObjectCollection(typeName);
 	{
 		OGRE_LOCK_MUTEX(objectMap->mutex)
+		if (mSceneQueryBVH)
+		{
+			MovableObjectMap::iterator i, iend = objectMap->map.end();
+			for (i = objectMap->map.begin(); i != iend; ++i)
+				mSceneQueryBVH->removeObject(i->second);
+		}
 		// no deletion
 		objectMap->map.clear();
 	}
@@ -87,6 +87,12 @@ namespace Ogre {
         Node::_update(updateChildren, parentHasChanged);
         _updateBounds();
     }
+    //-----------------------------------------------------------------------
+    void SceneNode::_transformStoreUpdateComplete(bool moved)
+    {
+        Node::_transformStoreUpdateComplete(moved);
+        _updateBounds();
+    }
     //-----------------------------------------------------------------------
 	void SceneNode::setParent(Node* parent)
 	{
@@ -287,6 +293,27 @@ namespace Ogre {
             return;
 
         // Add all entities
+        _queueAttachedObjects(cam, queue, visibleBounds, onlyShadowCasters);
+
+        if (includeChildren)
+        {
+            ChildNodeMap::iterator child, childend;
+            childend = mChildren.end();
+            for (child = mChildren.begin(); child != childend; ++child)
+            {
+                SceneNode* sceneChild = static_cast<SceneNode*>(child->second);
+                sceneChild->_findVisibleObjects(cam, queue, visibleBounds, includeChildren, 
+					displayNodes, onlyShadowCasters);
+            }
+        }
+
+        _queueDebugRenderables(queue, displayNodes);
+
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_queueAttachedObjects(Camera* cam, RenderQueue* queue, 
+        VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+    {
         ObjectMap::iterator iobj;
         ObjectMap::iterator iobjend = mObjectsByName.end();
         for (iobj = mObjectsByName.begin(); iobj != iobjend; ++iobj)
@@ -307,19 +334,10 @@ namespace Ogre {
 				}
             }
         }
-
-        if (includeChildren)
-        {
-            ChildNodeMap::iterator child, childend;
-            childend = mChildren.end();
-            for (child = mChildren.begin(); child != childend; ++child)
-            {
-                SceneNode* sceneChild = static_cast<SceneNode*>(child->second);
-                sceneChild->_findVisibleObjects(cam, queue, visibleBounds, includeChildren, 
-					displayNodes, onlyShadowCasters);
-            }
-        }
-
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_queueDebugRenderables(RenderQueue* queue, bool displayNodes)
+    {
         if (displayNodes)
         {
             // Include self in the render queue
@@ -332,8 +350,6 @@ namespace Ogre {
 		{ 
 			_addBoundingBoxToQueue(queue);
 		}
-
-
     }
 
 
@@ -369,6 +385,20 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void SceneNode::updateFromTransformStoreImpl(const Quaternion& derivedOrientation,
+        const Vector3& derivedPosition, const Vector3& derivedScale) const
+    {
+        Node::updateFromTransformStoreImpl(derivedOrientation, derivedPosition, derivedScale);
+
+        // Notify objects that it has been moved
+        ObjectMap::const_iterator i;
+        for (i = mObjectsByName.begin(); i != mObjectsByName.end(); ++i)
+        {
+            MovableObject* object = i->second;
+            object->_notifyMoved();
+        }
+    }
+    //-----------------------------------------------------------------------
     Node* SceneNode::createChildImpl(void)
     {
         assert(mCreator);
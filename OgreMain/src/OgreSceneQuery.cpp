@@ -30,6 +30,8 @@ Torus Knot Software Ltd.
 #include "OgreSceneQuery.h"
 #include "OgreException.h"
 #include "OgreSceneManager.h"
+#include "OgreEntity.h"
+#include "OgreMeshTriangleBVH.h"
 
 namespace Ogre {
 
@@ -200,6 +202,7 @@ namespace Ogre {
     {
         mSortByDistance = false;
         mMaxResults = 0;
+        mTriangleAccurate = false;
     }
     //-----------------------------------------------------------------------
     RaySceneQuery::~RaySceneQuery()
@@ -232,6 +235,16 @@ namespace Ogre {
         return mMaxResults;
     }
     //-----------------------------------------------------------------------
+    void RaySceneQuery::setTriangleAccurate(bool accurate)
+    {
+        mTriangleAccurate = accurate;
+    }
+    //-----------------------------------------------------------------------
+    bool RaySceneQuery::getTriangleAccurate(void) const
+    {
+        return mTriangleAccurate;
+    }
+    //-----------------------------------------------------------------------
     RaySceneQueryResult& RaySceneQuery::execute(void)
     {
         // Clear without freeing the vector buffer
@@ -240,22 +253,71 @@ namespace Ogre {
         // Call callback version with self as listener
         this->execute(this);
 
+        refineResults(mRay, mResult);
+        sortResults(mResult);
+
+        return mResult;
+    }
+    //-----------------------------------------------------------------------
+    void RaySceneQuery::sortResults(RaySceneQueryResult& result) const
+    {
         if (mSortByDistance)
         {
-            if (mMaxResults != 0 && mMaxResults < mResult.size())
+            if (mMaxResults != 0 && mMaxResults < result.size())
             {
                 // Partially sort the N smallest elements, discard others
-                std::partial_sort(mResult.begin(), mResult.begin()+mMaxResults, mResult.end());
-                mResult.resize(mMaxResults);
+                std::partial_sort(result.begin(), result.begin()+mMaxResults, result.end());
+                result.resize(mMaxResults);
             }
             else
             {
                 // Sort entire result array
-                std::sort(mResult.begin(), mResult.end());
+                std::sort(result.begin(), result.end());
             }
         }
+    }
+    //-----------------------------------------------------------------------
+    void RaySceneQuery::refineResults(const Ray& ray, RaySceneQueryResult& result) const
+    {
+        if (!mTriangleAccurate)
+            return;
 
-        return mResult;
+        RaySceneQueryResult::iterator dest = result.begin();
+        for (RaySceneQueryResult::iterator i = result.begin(); i != result.end(); ++i)
+        {
+            if (i->movable && 
+                i->movable->getMovableType() == EntityFactory::FACTORY_TYPE_NAME)
+            {
+                MeshTriangleHit hit;
+                if (!static_cast<Entity*>(i->movable)->rayIntersectsTriangles(ray, hit))
+                {
+                    // Bounds were hit but no triangle was, drop it
+                    continue;
+                }
+                i->distance = hit.distance;
+                i->hitTriangle = true;
+                i->subMeshIndex = hit.subMeshIndex;
+                i->triangleIndex = hit.triangleIndex;
+                i->barycentric = hit.barycentric;
+            }
+            *dest++ = *i;
+        }
+        result.erase(dest, result.end());
+    }
+    //-----------------------------------------------------------------------
+    void RaySceneQuery::executeBatch(const RayList& rays, RaySceneQueryResultList& results)
+    {
+        results.resize(rays.size());
+        Ray savedRay = mRay;
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            setRay(rays[i]);
+            execute();
+            // Hand over the results; execute clears what we get back
+            results[i].swap(mResult);
+        }
+        setRay(savedRay);
+        mResult.clear();
     }
     //-----------------------------------------------------------------------
     RaySceneQueryResult& RaySceneQuery::getLastResults(void)
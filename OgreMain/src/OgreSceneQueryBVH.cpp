@@ -0,0 +1,651 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreSceneQueryBVH.h"
+#include "OgreMovableObject.h"
+#include "OgreNode.h"
+
+namespace Ogre {
+
+	namespace
+	{
+		/// Surface area of a box, the cost measure used when inserting leaves
+		inline Real boxArea(const Vector3& minimum, const Vector3& maximum)
+		{
+			Vector3 d = maximum - minimum;
+			return 2 * (d.x * d.y + d.y * d.z + d.z * d.x);
+		}
+		/// Surface area of the union of two boxes
+		inline Real mergedArea(const Vector3& min1, const Vector3& max1,
+			const Vector3& min2, const Vector3& max2)
+		{
+			Vector3 minimum = min1, maximum = max1;
+			minimum.makeFloor(min2);
+			maximum.makeCeil(max2);
+			return boxArea(minimum, maximum);
+		}
+		/// Does the ray (with precomputed reciprocal direction) hit the box?
+		inline bool rayHitsBox(const Vector3& origin, const Vector3& direction,
+			const Vector3& invDirection, const Vector3& minimum, const Vector3& maximum)
+		{
+			Real tmin = 0;
+			Real tmax = std::numeric_limits<Real>::max();
+			for (int i = 0; i < 3; ++i)
+			{
+				if (direction[i] == 0)
+				{
+					// Parallel to this slab, so must start within it
+					if (origin[i] < minimum[i] || origin[i] > maximum[i])
+						return false;
+				}
+				else
+				{
+					Real t1 = (minimum[i] - origin[i]) * invDirection[i];
+					Real t2 = (maximum[i] - origin[i]) * invDirection[i];
+					if (t1 > t2)
+						std::swap(t1, t2);
+					if (t1 > tmin)
+						tmin = t1;
+					if (t2 < tmax)
+						tmax = t2;
+					if (tmin > tmax)
+						return false;
+				}
+			}
+			return true;
+		}
+		/// Does the sphere intersect the box?
+		inline bool sphereHitsBox(const Vector3& centre, Real radius, 
+			const Vector3& minimum, const Vector3& maximum)
+		{
+			Real s, d = 0;
+			for (int i = 0; i < 3; ++i)
+			{
+				if (centre[i] < minimum[i])
+				{
+					s = centre[i] - minimum[i];
+					d += s * s;
+				}
+				else if (centre[i] > maximum[i])
+				{
+					s = centre[i] - maximum[i];
+					d += s * s;
+				}
+			}
+			return d <= radius * radius;
+		}
+		/// Does the object pass the masks, and is it in the scene?
+		inline bool passesMasks(const MovableObject* obj, uint32 queryMask, uint32 typeMask)
+		{
+			return (obj->getQueryFlags() & queryMask) && 
+				(obj->getTypeFlags() & typeMask) &&
+				obj->isInScene();
+		}
+	}
+	//-----------------------------------------------------------------------
+	SceneQueryBVH::SceneQueryBVH()
+		: mRoot(NULL_NODE)
+		, mFreeList(NULL_NODE)
+		, mMargin(0.1)
+		, mNumReinsertions(0)
+	{
+	}
+	//-----------------------------------------------------------------------
+	SceneQueryBVH::~SceneQueryBVH()
+	{
+	}
+	//-----------------------------------------------------------------------
+	int SceneQueryBVH::allocateNode(void)
+	{
+		int index;
+		if (mFreeList != NULL_NODE)
+		{
+			index = mFreeList;
+			mFreeList = mNodes[index].parent;
+		}
+		else
+		{
+			index = static_cast<int>(mNodes.size());
+			mNodes.push_back(TreeNode());
+		}
+		TreeNode& node = mNodes[index];
+		node.parent = NULL_NODE;
+		node.child1 = NULL_NODE;
+		node.child2 = NULL_NODE;
+		node.height = 0;
+		node.object = 0;
+		return index;
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::freeNode(int index)
+	{
+		mNodes[index].parent = mFreeList;
+		mNodes[index].height = -1;
+		mFreeList = index;
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::refitNode(int index)
+	{
+		TreeNode& node = mNodes[index];
+		const TreeNode& child1 = mNodes[node.child1];
+		const TreeNode& child2 = mNodes[node.child2];
+		node.minimum = child1.minimum;
+		node.minimum.makeFloor(child2.minimum);
+		node.maximum = child1.maximum;
+		node.maximum.makeCeil(child2.maximum);
+		node.height = 1 + std::max(child1.height, child2.height);
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::insertLeaf(int leaf)
+	{
+		if (mRoot == NULL_NODE)
+		{
+			mRoot = leaf;
+			mNodes[leaf].parent = NULL_NODE;
+			return;
+		}
+
+		// Find the best sibling for the leaf by descending the tree, going
+		// where the increase in surface area is least
+		const Vector3 leafMin = mNodes[leaf].minimum;
+		const Vector3 leafMax = mNodes[leaf].maximum;
+		int index = mRoot;
+		while (!mNodes[index].isLeaf())
+		{
+			const TreeNode& node = mNodes[index];
+			Real area = boxArea(node.minimum, node.maximum);
+			Real combinedArea = mergedArea(node.minimum, node.maximum, leafMin, leafMax);
+
+			// Cost of making a new parent for this node and the leaf
+			Real cost = 2 * combinedArea;
+			// Minimum cost of pushing the leaf further down the tree
+			Real inheritanceCost = 2 * (combinedArea - area);
+
+			Real childCost[2];
+			int children[2] = { node.child1, node.child2 };
+			for (int c = 0; c < 2; ++c)
+			{
+				const TreeNode& child = mNodes[children[c]];
+				Real merged = mergedArea(child.minimum, child.maximum, leafMin, leafMax);
+				if (child.isLeaf())
+					childCost[c] = merged + inheritanceCost;
+				else
+					childCost[c] = merged - boxArea(child.minimum, child.maximum) + inheritanceCost;
+			}
+
+			if (cost < childCost[0] && cost < childCost[1])
+				break;
+
+			index = childCost[0] < childCost[1] ? children[0] : children[1];
+		}
+		int sibling = index;
+
+		// Create a new parent for the sibling and the leaf
+		int newParent = allocateNode();
+		int oldParent = mNodes[sibling].parent;
+		mNodes[newParent].parent = oldParent;
+		mNodes[newParent].child1 = sibling;
+		mNodes[newParent].child2 = leaf;
+		mNodes[sibling].parent = newParent;
+		mNodes[leaf].parent = newParent;
+		if (oldParent != NULL_NODE)
+		{
+			if (mNodes[oldParent].child1 == sibling)
+				mNodes[oldParent].child1 = newParent;
+			else
+				mNodes[oldParent].child2 = newParent;
+		}
+		else
+		{
+			mRoot = newParent;
+		}
+
+		// Walk back up, refitting and rebalancing
+		index = newParent;
+		while (index != NULL_NODE)
+		{
+			index = balance(index);
+			refitNode(index);
+			index = mNodes[index].parent;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::removeLeaf(int leaf)
+	{
+		if (leaf == mRoot)
+		{
+			mRoot = NULL_NODE;
+			return;
+		}
+
+		int parent = mNodes[leaf].parent;
+		int grandParent = mNodes[parent].parent;
+		int sibling = mNodes[parent].child1 == leaf ? 
+			mNodes[parent].child2 : mNodes[parent].child1;
+
+		// Replace the parent with the sibling
+		mNodes[sibling].parent = grandParent;
+		freeNode(parent);
+		if (grandParent != NULL_NODE)
+		{
+			if (mNodes[grandParent].child1 == parent)
+				mNodes[grandParent].child1 = sibling;
+			else
+				mNodes[grandParent].child2 = sibling;
+
+			int index = grandParent;
+			while (index != NULL_NODE)
+			{
+				index = balance(index);
+				refitNode(index);
+				index = mNodes[index].parent;
+			}
+		}
+		else
+		{
+			mRoot = sibling;
+		}
+		mNodes[leaf].parent = NULL_NODE;
+	}
+	//-----------------------------------------------------------------------
+	int SceneQueryBVH::balance(int iA)
+	{
+		TreeNode& a = mNodes[iA];
+		if (a.isLeaf() || a.height < 2)
+			return iA;
+
+		int iB = a.child1;
+		int iC = a.child2;
+		TreeNode& b = mNodes[iB];
+		TreeNode& c = mNodes[iC];
+		int diff = c.height - b.height;
+
+		// Rotate whichever child is too tall up to take a's place; a keeps 
+		// its other child and the shorter grandchild
+		int iUp, iKeep;
+		if (diff > 1)
+		{
+			iUp = iC;
+			iKeep = iB;
+		}
+		else if (diff < -1)
+		{
+			iUp = iB;
+			iKeep = iC;
+		}
+		else
+		{
+			return iA;
+		}
+		TreeNode& up = mNodes[iUp];
+		int iF = up.child1;
+		int iG = up.child2;
+		int iTall = iF, iShort = iG;
+		if (mNodes[iG].height > mNodes[iF].height)
+		{
+			iTall = iG;
+			iShort = iF;
+		}
+
+		// up replaces a in a's parent
+		up.parent = a.parent;
+		if (up.parent != NULL_NODE)
+		{
+			if (mNodes[up.parent].child1 == iA)
+				mNodes[up.parent].child1 = iUp;
+			else
+				mNodes[up.parent].child2 = iUp;
+		}
+		else
+		{
+			mRoot = iUp;
+		}
+
+		// a becomes a child of up, alongside up's taller child
+		up.child1 = iA;
+		up.child2 = iTall;
+		a.parent = iUp;
+		a.child1 = iKeep;
+		a.child2 = iShort;
+		mNodes[iShort].parent = iA;
+
+		refitNode(iA);
+		refitNode(iUp);
+		return iUp;
+	}
+	//-----------------------------------------------------------------------
+	bool SceneQueryBVH::updateProxy(Proxy& proxy)
+	{
+		MovableObject* obj = proxy.object;
+
+		// Unattached objects can't be found by queries, so needn't be in the tree
+		bool bounded = obj->isAttached();
+		bool infinite = false;
+		Vector3 minimum, maximum;
+		if (bounded)
+		{
+			const AxisAlignedBox& box = obj->getWorldBoundingBox();
+			infinite = box.isInfinite();
+			if (!infinite)
+			{
+				// Enclose the bounding sphere too, for sphere queries
+				Vector3 centre = obj->getParentNode()->_getDerivedPosition();
+				Real radius = obj->getBoundingRadius();
+				minimum = centre - Vector3(radius, radius, radius);
+				maximum = centre + Vector3(radius, radius, radius);
+				if (!box.isNull())
+				{
+					minimum.makeFloor(box.getMinimum());
+					maximum.makeCeil(box.getMaximum());
+				}
+			}
+		}
+
+		if (infinite != proxy.infinite)
+		{
+			if (infinite)
+				mInfiniteObjects.insert(obj);
+			else
+				mInfiniteObjects.erase(obj);
+			proxy.infinite = infinite;
+		}
+
+		if (!bounded || infinite)
+		{
+			if (proxy.leaf != NULL_NODE)
+			{
+				removeLeaf(proxy.leaf);
+				freeNode(proxy.leaf);
+				proxy.leaf = NULL_NODE;
+			}
+			return false;
+		}
+
+		if (proxy.leaf != NULL_NODE)
+		{
+			const TreeNode& leaf = mNodes[proxy.leaf];
+			if (leaf.minimum.x <= minimum.x && leaf.minimum.y <= minimum.y && 
+				leaf.minimum.z <= minimum.z && leaf.maximum.x >= maximum.x && 
+				leaf.maximum.y >= maximum.y && leaf.maximum.z >= maximum.z)
+			{
+				// Still within its leaf
+				return false;
+			}
+			removeLeaf(proxy.leaf);
+		}
+		else
+		{
+			proxy.leaf = allocateNode();
+			mNodes[proxy.leaf].object = obj;
+		}
+
+		Vector3 size = maximum - minimum;
+		Real margin = std::max(size.x, std::max(size.y, size.z)) * mMargin;
+		TreeNode& leaf = mNodes[proxy.leaf];
+		leaf.minimum = minimum - Vector3(margin, margin, margin);
+		leaf.maximum = maximum + Vector3(margin, margin, margin);
+		insertLeaf(proxy.leaf);
+		assert(getHeight() < MAX_TREE_HEIGHT);
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::addObject(MovableObject* obj)
+	{
+		if (mProxyIndices.find(obj) != mProxyIndices.end())
+			return;
+
+		Proxy proxy;
+		proxy.object = obj;
+		proxy.leaf = NULL_NODE;
+		proxy.infinite = false;
+		mProxyIndices[obj] = mProxies.size();
+		mProxies.push_back(proxy);
+		updateProxy(mProxies.back());
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::removeObject(MovableObject* obj)
+	{
+		ProxyIndexMap::iterator i = mProxyIndices.find(obj);
+		if (i == mProxyIndices.end())
+			return;
+
+		size_t index = i->second;
+		Proxy& proxy = mProxies[index];
+		if (proxy.leaf != NULL_NODE)
+		{
+			removeLeaf(proxy.leaf);
+			freeNode(proxy.leaf);
+		}
+		if (proxy.infinite)
+			mInfiniteObjects.erase(obj);
+		mProxyIndices.erase(i);
+
+		// Swap the last proxy into the gap
+		if (index != mProxies.size() - 1)
+		{
+			mProxies[index] = mProxies.back();
+			mProxyIndices[mProxies[index].object] = index;
+		}
+		mProxies.pop_back();
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::clear(void)
+	{
+		mNodes.clear();
+		mRoot = NULL_NODE;
+		mFreeList = NULL_NODE;
+		mProxies.clear();
+		mProxyIndices.clear();
+		mInfiniteObjects.clear();
+		mNumReinsertions = 0;
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::update(void)
+	{
+		mNumReinsertions = 0;
+		ProxyList::iterator i, iend = mProxies.end();
+		for (i = mProxies.begin(); i != iend; ++i)
+		{
+			if (updateProxy(*i))
+				++mNumReinsertions;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::rayQuery(const Ray& ray, uint32 queryMask, uint32 typeMask, 
+		RaySceneQueryListener* listener) const
+	{
+		MovableObjectSet::const_iterator oi, oiend = mInfiniteObjects.end();
+		for (oi = mInfiniteObjects.begin(); oi != oiend; ++oi)
+		{
+			MovableObject* obj = *oi;
+			if (passesMasks(obj, queryMask, typeMask))
+			{
+				std::pair<bool, Real> result = ray.intersects(obj->getWorldBoundingBox());
+				if (result.first && !listener->queryResult(obj, result.second))
+					return;
+			}
+		}
+		if (mRoot == NULL_NODE)
+			return;
+
+		const Vector3& origin = ray.getOrigin();
+		const Vector3& direction = ray.getDirection();
+		Vector3 invDirection;
+		for (int a = 0; a < 3; ++a)
+			invDirection[a] = direction[a] != 0 ? 1 / direction[a] : 0;
+
+		int stack[MAX_TREE_HEIGHT + 1];
+		int top = 0;
+		stack[top++] = mRoot;
+		while (top)
+		{
+			const TreeNode& node = mNodes[stack[--top]];
+			if (!rayHitsBox(origin, direction, invDirection, node.minimum, node.maximum))
+				continue;
+
+			if (node.isLeaf())
+			{
+				MovableObject* obj = node.object;
+				if (passesMasks(obj, queryMask, typeMask))
+				{
+					std::pair<bool, Real> result = ray.intersects(obj->getWorldBoundingBox());
+					if (result.first && !listener->queryResult(obj, result.second))
+						return;
+				}
+			}
+			else
+			{
+				stack[top++] = node.child1;
+				stack[top++] = node.child2;
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::boxQuery(const AxisAlignedBox& box, uint32 queryMask, 
+		uint32 typeMask, SceneQueryListener* listener) const
+	{
+		if (box.isNull())
+			return;
+
+		MovableObjectSet::const_iterator oi, oiend = mInfiniteObjects.end();
+		for (oi = mInfiniteObjects.begin(); oi != oiend; ++oi)
+		{
+			MovableObject* obj = *oi;
+			if (passesMasks(obj, queryMask, typeMask) &&
+				box.intersects(obj->getWorldBoundingBox()) && 
+				!listener->queryResult(obj))
+				return;
+		}
+		if (mRoot == NULL_NODE)
+			return;
+
+		bool infinite = box.isInfinite();
+		Vector3 minimum, maximum;
+		if (!infinite)
+		{
+			minimum = box.getMinimum();
+			maximum = box.getMaximum();
+		}
+
+		int stack[MAX_TREE_HEIGHT + 1];
+		int top = 0;
+		stack[top++] = mRoot;
+		while (top)
+		{
+			const TreeNode& node = mNodes[stack[--top]];
+			if (!infinite && 
+				(node.maximum.x < minimum.x || node.maximum.y < minimum.y ||
+				node.maximum.z < minimum.z || node.minimum.x > maximum.x || 
+				node.minimum.y > maximum.y || node.minimum.z > maximum.z))
+				continue;
+
+			if (node.isLeaf())
+			{
+				MovableObject* obj = node.object;
+				if (passesMasks(obj, queryMask, typeMask) &&
+					box.intersects(obj->getWorldBoundingBox()) && 
+					!listener->queryResult(obj))
+					return;
+			}
+			else
+			{
+				stack[top++] = node.child1;
+				stack[top++] = node.child2;
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SceneQueryBVH::sphereQuery(const Sphere& sphere, uint32 queryMask, 
+		uint32 typeMask, SceneQueryListener* listener, bool testBoundingSpheres) const
+	{
+		Sphere testSphere;
+
+		MovableObjectSet::const_iterator oi, oiend = mInfiniteObjects.end();
+		for (oi = mInfiniteObjects.begin(); oi != oiend; ++oi)
+		{
+			MovableObject* obj = *oi;
+			if (!passesMasks(obj, queryMask, typeMask))
+				continue;
+			bool hit;
+			if (testBoundingSpheres)
+			{
+				testSphere.setCenter(obj->getParentNode()->_getDerivedPosition());
+				testSphere.setRadius(obj->getBoundingRadius());
+				hit = sphere.intersects(testSphere);
+			}
+			else
+			{
+				hit = sphere.intersects(obj->getWorldBoundingBox());
+			}
+			if (hit && !listener->queryResult(obj))
+				return;
+		}
+		if (mRoot == NULL_NODE)
+			return;
+
+		const Vector3& centre = sphere.getCenter();
+		Real radius = sphere.getRadius();
+
+		int stack[MAX_TREE_HEIGHT + 1];
+		int top = 0;
+		stack[top++] = mRoot;
+		while (top)
+		{
+			const TreeNode& node = mNodes[stack[--top]];
+			if (!sphereHitsBox(centre, radius, node.minimum, node.maximum))
+				continue;
+
+			if (node.isLeaf())
+			{
+				MovableObject* obj = node.object;
+				if (!passesMasks(obj, queryMask, typeMask))
+					continue;
+				bool hit;
+				if (testBoundingSpheres)
+				{
+					testSphere.setCenter(obj->getParentNode()->_getDerivedPosition());
+					testSphere.setRadius(obj->getBoundingRadius());
+					hit = sphere.intersects(testSphere);
+				}
+				else
+				{
+					hit = sphere.intersects(obj->getWorldBoundingBox());
+				}
+				if (hit && !listener->queryResult(obj))
+					return;
+			}
+			else
+			{
+				stack[top++] = node.child1;
+				stack[top++] = node.child2;
+			}
+		}
+	}
+
+}
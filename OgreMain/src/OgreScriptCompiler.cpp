@@ -32,6 +32,8 @@ Torus Knot Software Ltd.
 #include "OgreScriptLexer.h"
 #include "OgreScriptParser.h"
 #include "OgreScriptTranslator.h"
+#include "OgreScriptSerializer.h"
+#include "OgreWorkerThreadPool.h"
 
 namespace Ogre
 {
@@ -352,6 +354,72 @@ namespace Ogre
 
 		// Convert our nodes to an AST
 		AbstractNodeListPtr ast = convertToAST(nodes);
+		return compileAST(ast);
+	}
+
+	bool ScriptCompiler::compile(DataStreamPtr &stream, const String &group, const String &cacheFile,
+		const ConcreteNodeListPtr &parsed)
+	{
+		// Set up the compilation context
+		mGroup = group;
+
+		// Clear the past errors
+		mErrors.clear();
+
+		// Clear the environment
+		mEnv.clear();
+
+		// The cache is keyed on the script's name and modification time
+		const String &source = stream->getName();
+		time_t modifiedTime = 0;
+		if(!mListener && ResourceGroupManager::getSingletonPtr())
+			modifiedTime = ResourceGroupManager::getSingleton().resourceModifiedTime(group, source);
+
+		ScriptSerializer serializer;
+		AbstractNodeListPtr ast;
+		if(modifiedTime != 0)
+		{
+			std::ifstream cacheStream(cacheFile.c_str(), std::ios::in | std::ios::binary);
+			if(!cacheStream.fail())
+			{
+				DataStreamPtr cache(new FileStreamDataStream(cacheFile, &cacheStream, false));
+				ast = serializer.importAST(cache, source, modifiedTime, mIds, mEnv);
+			}
+		}
+
+		if(ast.isNull())
+		{
+			ConcreteNodeListPtr nodes = parsed;
+			if(nodes.isNull())
+			{
+				ScriptLexer lexer;
+				ScriptParser parser;
+				nodes = parser.parse(lexer.tokenize(stream->getAsString(), source));
+			}
+			if(mListener)
+				mListener->preConversion(this, nodes);
+			ast = convertToAST(nodes);
+
+			// Only scripts which converted cleanly are worth keeping
+			if(modifiedTime != 0 && mErrors.empty())
+			{
+				try
+				{
+					serializer.exportAST(ast, mEnv, source, modifiedTime, cacheFile);
+				}
+				catch(Exception &e)
+				{
+					LogManager::getSingleton().logMessage("Unable to cache script " + source + 
+						": " + e.getDescription());
+				}
+			}
+		}
+
+		return compileAST(ast);
+	}
+
+	bool ScriptCompiler::compileAST(AbstractNodeListPtr &ast)
+	{
 		// Processes the imports for this script
 		processImports(ast);
 		// Process object inheritance
@@ -1472,6 +1540,29 @@ namespace Ogre
 		return mListener;
 	}
 	//-----------------------------------------------------------------------
+	void ScriptCompilerManager::setCacheDirectory(const String &dir)
+	{
+		OGRE_LOCK_AUTO_MUTEX
+		mCacheDirectory = dir;
+	}
+	//-----------------------------------------------------------------------
+	const String &ScriptCompilerManager::getCacheDirectory() const
+	{
+		return mCacheDirectory;
+	}
+	//-----------------------------------------------------------------------
+	String ScriptCompilerManager::getCacheFileName(const String &source, const String &group) const
+	{
+		// Flatten the group and script path into a single file name
+		String name = group + "_" + source;
+		for(String::iterator i = name.begin(); i != name.end(); ++i)
+		{
+			if(*i == '/' || *i == '\\' || *i == ':')
+				*i = '_';
+		}
+		return mCacheDirectory + "/" + name + ".ast";
+	}
+	//-----------------------------------------------------------------------
 	void ScriptCompilerManager::addTranslatorManager(Ogre::ScriptTranslatorManager *man)
 	{
 		OGRE_LOCK_AUTO_MUTEX
@@ -1537,11 +1628,148 @@ namespace Ogre
 		}
 #endif
 		// Set the listener on the compiler before we continue
+		String cacheFile;
+		ConcreteNodeListPtr nodes;
 		{
 			OGRE_LOCK_AUTO_MUTEX
 			mScriptCompiler->setListener(mListener);
+			if(!mCacheDirectory.empty())
+				cacheFile = getCacheFileName(stream->getName(), groupName);
+
+			// Pick up the nodes if the script was parsed in advance
+			PreparedScriptMap::iterator i = mPreparedScripts.find(stream.get());
+			if(i != mPreparedScripts.end())
+			{
+				nodes = i->second.nodes;
+				mPreparedScripts.erase(i);
+			}
 		}
-        mScriptCompiler->compile(stream->getAsString(), stream->getName(), groupName);
+		if(!cacheFile.empty())
+			mScriptCompiler->compile(stream, groupName, cacheFile, nodes);
+		else if(!nodes.isNull())
+			mScriptCompiler->compile(nodes, groupName);
+		else
+			mScriptCompiler->compile(stream->getAsString(), stream->getName(), groupName);
     }
+	//-----------------------------------------------------------------------
+	namespace
+	{
+		/// Task which lexes and parses one script
+		class ScriptParseTask : public WorkerThreadPool::Task
+		{
+		protected:
+			String mText;
+			String mSource;
+			String mCacheFile;
+			time_t mModifiedTime;
+		public:
+			/// The parsed script, null if it failed or need not be parsed
+			ConcreteNodeListPtr nodes;
+
+			ScriptParseTask(const String &text, const String &source, 
+				const String &cacheFile, time_t modifiedTime)
+				: mText(text), mSource(source), mCacheFile(cacheFile), 
+				mModifiedTime(modifiedTime) {}
+			void execute(void)
+			{
+				// A current cache makes parsing unnecessary
+				if(mModifiedTime != 0)
+				{
+					std::ifstream cacheStream(mCacheFile.c_str(), std::ios::in | std::ios::binary);
+					if(!cacheStream.fail())
+					{
+						DataStreamPtr cache(new FileStreamDataStream(mCacheFile, &cacheStream, false));
+						ScriptSerializer serializer;
+						if(serializer.isCurrent(cache, mSource, mModifiedTime))
+							return;
+					}
+				}
+
+				// Errors are left to parseScript, which parses the script again
+				// on the main thread and reports them there
+				try
+				{
+					ScriptLexer lexer;
+					ScriptParser parser;
+					nodes = parser.parse(lexer.tokenize(mText, mSource));
+				}
+				catch(Exception&)
+				{
+					nodes.setNull();
+				}
+				mText.clear();
+			}
+		};
+	}
+	//-----------------------------------------------------------------------
+	void ScriptCompilerManager::prepareScripts(DataStreamList& streams, const String& groupName)
+	{
+		WorkerThreadPool* pool = WorkerThreadPool::getSingletonPtr();
+		if(!pool || !pool->isParallel() || streams.size() < 2)
+			return;
+
+		String cacheDirectory;
+		bool useCache;
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			cacheDirectory = mCacheDirectory;
+			// The cache is only used without a listener, see ScriptCompiler::compile
+			useCache = !cacheDirectory.empty() && !mListener;
+		}
+
+		// Streams are read and the cache checked here, since neither archives
+		// nor the ResourceGroupManager can be used from the worker threads
+		std::vector<ScriptParseTask> tasks;
+		tasks.reserve(streams.size());
+		WorkerThreadPool::TaskList taskList;
+		taskList.reserve(streams.size());
+		for(DataStreamList::iterator i = streams.begin(); i != streams.end(); ++i)
+		{
+			DataStreamPtr &stream = *i;
+			if(stream.isNull())
+				continue;
+
+			String cacheFile;
+			time_t modifiedTime = 0;
+			if(useCache)
+			{
+				cacheFile = getCacheFileName(stream->getName(), groupName);
+				if(ResourceGroupManager::getSingletonPtr())
+					modifiedTime = ResourceGroupManager::getSingleton().resourceModifiedTime(
+						groupName, stream->getName());
+			}
+
+			tasks.push_back(ScriptParseTask(stream->getAsString(), stream->getName(), 
+				cacheFile, modifiedTime));
+			taskList.push_back(&tasks.back());
+			stream->seek(0);
+		}
+		pool->executeTasks(taskList);
+
+		OGRE_LOCK_AUTO_MUTEX
+		std::vector<ScriptParseTask>::iterator t = tasks.begin();
+		for(DataStreamList::iterator i = streams.begin(); i != streams.end(); ++i)
+		{
+			if(i->isNull())
+				continue;
+			if(!t->nodes.isNull())
+			{
+				PreparedScript &prepared = mPreparedScripts[i->get()];
+				prepared.stream = *i;
+				prepared.nodes = t->nodes;
+			}
+			++t;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void ScriptCompilerManager::unprepareScripts(DataStreamList& streams)
+	{
+		OGRE_LOCK_AUTO_MUTEX
+		for(DataStreamList::iterator i = streams.begin(); i != streams.end(); ++i)
+		{
+			if(!i->isNull())
+				mPreparedScripts.erase(i->get());
+		}
+	}
 }
 
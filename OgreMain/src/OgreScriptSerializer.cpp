@@ -0,0 +1,348 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreScriptSerializer.h"
+#include "OgreLogManager.h"
+#include "OgreException.h"
+
+namespace Ogre {
+
+    //---------------------------------------------------------------------
+    ScriptSerializer::ScriptSerializer()
+    {
+        // Version number
+        mVersion = "[ScriptSerializer_v1.00]";
+    }
+    //---------------------------------------------------------------------
+    ScriptSerializer::~ScriptSerializer()
+    {
+    }
+    //---------------------------------------------------------------------
+    void ScriptSerializer::exportAST(const AbstractNodeListPtr& nodes, 
+        const VariableMap& variables, const String& source, time_t modifiedTime, 
+        const String& filename)
+    {
+        determineEndianness(ENDIAN_NATIVE);
+
+        mpfFile = fopen(filename.c_str(), "wb");
+        if (!mpfFile)
+        {
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+                "Unable to open file " + filename + " for writing",
+                "ScriptSerializer::exportAST");
+        }
+
+        writeFileHeader();
+
+        // The key the cache is valid for
+        writeToken(source);
+        writeTime(modifiedTime);
+
+        writeVariables(variables);
+        writeNodes(*nodes);
+
+        fclose(mpfFile);
+    }
+    //---------------------------------------------------------------------
+    bool ScriptSerializer::isCurrent(DataStreamPtr& stream, const String& source, 
+        time_t modifiedTime)
+    {
+        // Anything unexpected just means the cache can't be used
+        try
+        {
+            determineEndianness(stream);
+            readFileHeader(stream);
+        }
+        catch (Exception&)
+        {
+            return false;
+        }
+
+        String cachedSource;
+        return readToken(stream, cachedSource) && cachedSource == source &&
+            readTime(stream) == modifiedTime;
+    }
+    //---------------------------------------------------------------------
+    AbstractNodeListPtr ScriptSerializer::importAST(DataStreamPtr& stream, 
+        const String& source, time_t modifiedTime, const ScriptCompiler::IdMap& ids, 
+        VariableMap& variables)
+    {
+        AbstractNodeListPtr nodes;
+        if (!isCurrent(stream, source, modifiedTime))
+            return nodes;
+
+        variables.clear();
+        AbstractNodeListPtr result(new AbstractNodeList());
+        if (readVariables(stream, variables) && readNodes(stream, 0, *result, ids))
+        {
+            nodes = result;
+        }
+        else
+        {
+            LogManager::getSingleton().logMessage(
+                "Ignoring invalid script cache for " + source);
+            variables.clear();
+        }
+        return nodes;
+    }
+    //---------------------------------------------------------------------
+    void ScriptSerializer::writeNodes(const AbstractNodeList& nodes)
+    {
+        uint32 count = static_cast<uint32>(nodes.size());
+        writeInts(&count, 1);
+        for (AbstractNodeList::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+            writeNode((*i).get());
+    }
+    //---------------------------------------------------------------------
+    void ScriptSerializer::writeNode(const AbstractNode* node)
+    {
+        uint16 type = static_cast<uint16>(node->type);
+        writeShorts(&type, 1);
+        writeToken(node->file);
+        uint32 line = node->line;
+        writeInts(&line, 1);
+
+        // Ids are not written; they are looked up again when reading
+        switch (node->type)
+        {
+        case ANT_ATOM:
+            writeToken(static_cast<const AtomAbstractNode*>(node)->value);
+            break;
+        case ANT_OBJECT:
+            {
+                const ObjectAbstractNode* obj = static_cast<const ObjectAbstractNode*>(node);
+                writeToken(obj->name);
+                writeToken(obj->cls);
+                writeToken(obj->base);
+                writeBools(&obj->abstract, 1);
+                writeVariables(obj->getVariables());
+                writeNodes(obj->children);
+                writeNodes(obj->values);
+            }
+            break;
+        case ANT_PROPERTY:
+            {
+                const PropertyAbstractNode* prop = static_cast<const PropertyAbstractNode*>(node);
+                writeToken(prop->name);
+                writeNodes(prop->values);
+            }
+            break;
+        case ANT_IMPORT:
+            {
+                const ImportAbstractNode* import = static_cast<const ImportAbstractNode*>(node);
+                writeToken(import->target);
+                writeToken(import->source);
+            }
+            break;
+        case ANT_VARIABLE_ACCESS:
+            writeToken(static_cast<const VariableAccessAbstractNode*>(node)->name);
+            break;
+        default:
+            // No other node types are produced by the conversion
+            break;
+        }
+    }
+    //---------------------------------------------------------------------
+    void ScriptSerializer::writeVariables(const VariableMap& variables)
+    {
+        uint32 count = static_cast<uint32>(variables.size());
+        writeInts(&count, 1);
+        for (VariableMap::const_iterator i = variables.begin(); i != variables.end(); ++i)
+        {
+            writeToken(i->first);
+            writeToken(i->second);
+        }
+    }
+    //---------------------------------------------------------------------
+    void ScriptSerializer::writeTime(time_t t)
+    {
+        // Always 64 bits, whatever the size of time_t
+        uint32 parts[2] = { static_cast<uint32>(t), 0 };
+        if (sizeof(time_t) > sizeof(uint32))
+            parts[1] = static_cast<uint32>((t >> 16) >> 16);
+        writeInts(parts, 2);
+    }
+    //---------------------------------------------------------------------
+    void ScriptSerializer::writeToken(const String& token)
+    {
+        // Tokens may hold any character, so they are length prefixed
+        uint32 len = static_cast<uint32>(token.size());
+        writeInts(&len, 1);
+        if (len)
+            writeData(token.data(), 1, len);
+    }
+    //---------------------------------------------------------------------
+    bool ScriptSerializer::readNodes(DataStreamPtr& stream, AbstractNode* parent,
+        AbstractNodeList& nodes, const ScriptCompiler::IdMap& ids)
+    {
+        uint32 count = 0;
+        readInts(stream, &count, 1);
+        // Each node takes at least its type, file and line
+        if (stream->eof() && count != 0)
+            return false;
+        if (stream->size() && count > stream->size() - stream->tell())
+            return false;
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            AbstractNode* node = readNode(stream, parent, ids);
+            if (!node)
+                return false;
+            nodes.push_back(AbstractNodePtr(node));
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------
+    AbstractNode* ScriptSerializer::readNode(DataStreamPtr& stream, AbstractNode* parent,
+        const ScriptCompiler::IdMap& ids)
+    {
+        uint16 type = ANT_UNKNOWN;
+        readShorts(stream, &type, 1);
+        String file;
+        if (!readToken(stream, file))
+            return 0;
+        uint32 line = 0;
+        readInts(stream, &line, 1);
+
+        AbstractNode* node = 0;
+        bool valid = true;
+        switch (type)
+        {
+        case ANT_ATOM:
+            {
+                AtomAbstractNode* atom = new AtomAbstractNode(parent);
+                node = atom;
+                valid = readToken(stream, atom->value);
+                atom->id = findId(ids, atom->value);
+            }
+            break;
+        case ANT_OBJECT:
+            {
+                ObjectAbstractNode* obj = new ObjectAbstractNode(parent);
+                node = obj;
+                VariableMap variables;
+                valid = readToken(stream, obj->name) && readToken(stream, obj->cls) &&
+                    readToken(stream, obj->base);
+                if (valid)
+                {
+                    readBools(stream, &obj->abstract, 1);
+                    obj->id = findId(ids, obj->cls);
+                    valid = readVariables(stream, variables);
+                }
+                for (VariableMap::iterator i = variables.begin(); i != variables.end(); ++i)
+                    obj->setVariable(i->first, i->second);
+                valid = valid && readNodes(stream, obj, obj->children, ids) &&
+                    readNodes(stream, obj, obj->values, ids);
+            }
+            break;
+        case ANT_PROPERTY:
+            {
+                PropertyAbstractNode* prop = new PropertyAbstractNode(parent);
+                node = prop;
+                valid = readToken(stream, prop->name);
+                prop->id = findId(ids, prop->name);
+                valid = valid && readNodes(stream, prop, prop->values, ids);
+            }
+            break;
+        case ANT_IMPORT:
+            {
+                ImportAbstractNode* import = new ImportAbstractNode();
+                node = import;
+                valid = readToken(stream, import->target) && readToken(stream, import->source);
+            }
+            break;
+        case ANT_VARIABLE_ACCESS:
+            {
+                VariableAccessAbstractNode* var = new VariableAccessAbstractNode(parent);
+                node = var;
+                valid = readToken(stream, var->name);
+            }
+            break;
+        default:
+            return 0;
+        }
+
+        if (!valid)
+        {
+            delete node;
+            return 0;
+        }
+        node->file = file;
+        node->line = line;
+        return node;
+    }
+    //---------------------------------------------------------------------
+    bool ScriptSerializer::readVariables(DataStreamPtr& stream, VariableMap& variables)
+    {
+        uint32 count = 0;
+        readInts(stream, &count, 1);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            String name, value;
+            if (!readToken(stream, name) || !readToken(stream, value))
+                return false;
+            variables[name] = value;
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------
+    time_t ScriptSerializer::readTime(DataStreamPtr& stream)
+    {
+        uint32 parts[2] = { 0, 0 };
+        readInts(stream, parts, 2);
+        time_t t = static_cast<time_t>(parts[0]);
+        if (sizeof(time_t) > sizeof(uint32))
+            t |= (static_cast<time_t>(parts[1]) << 16) << 16;
+        return t;
+    }
+    //---------------------------------------------------------------------
+    bool ScriptSerializer::readToken(DataStreamPtr& stream, String& token)
+    {
+        uint32 len = 0;
+        if (stream->read(&len, sizeof(uint32)) != sizeof(uint32))
+            return false;
+        flipFromLittleEndian(&len, sizeof(uint32));
+
+        if (stream->size() && len > stream->size() - stream->tell())
+            return false;
+
+        token.resize(len);
+        if (len && stream->read(&token[0], len) != len)
+            return false;
+        return true;
+    }
+    //---------------------------------------------------------------------
+    uint32 ScriptSerializer::findId(const ScriptCompiler::IdMap& ids, 
+        const String& word) const
+    {
+        ScriptCompiler::IdMap::const_iterator i = ids.find(word);
+        return i != ids.end() ? i->second : 0;
+    }
+
+}
@@ -36,6 +36,7 @@ Torus Knot Software Ltd.
 #include "OgreSkeletonManager.h"
 #include "OgreSkeletonSerializer.h"
 #include "OgreStringConverter.h"
+#include "OgreOptimisedUtil.h"
 // Just for logging
 #include "OgreAnimationTrack.h"
 #include "OgreKeyFrame.h"
@@ -108,6 +109,8 @@ namespace Ogre {
 		mRootBones.clear();
         mManualBones.clear();
         mManualBonesDirty = false;
+        mBoneUpdateOrder.clear();
+        mBoneParents.clear();
 
         // Destroy animations
         AnimationList::iterator ai;
@@ -155,6 +158,8 @@ namespace Ogre {
         }
         mBoneList[handle] = ret;
         mBoneListByName[ret->getName()] = ret;
+        // Lay the bones out again on the next update
+        mBoneParents.clear();
         return ret;
 
     }
@@ -189,6 +194,8 @@ namespace Ogre {
         }
         mBoneList[handle] = ret;
         mBoneListByName[name] = ret;
+        // Lay the bones out again on the next update
+        mBoneParents.clear();
         return ret;
     }
 
@@ -252,14 +259,17 @@ namespace Ogre {
             // tolerate state entries for animations we're not aware of
             if (anim)
             {
+              // Step on from the keyframes found by the last update
+              TimeIndex timeIndex = anim->_getTimeIndex(animState->getTimePosition(), 
+                animState->_getKeyFrameCursor(anim));
               if(animState->hasBlendMask())
               {
-                anim->apply(this, animState->getTimePosition(), animState->getWeight() * weightFactor,
+                anim->apply(this, timeIndex, animState->getWeight() * weightFactor,
                   animState->getBlendMask(), linked ? linked->scale : 1.0f);
               }
               else
               {
-                anim->apply(this, animState->getTimePosition(), 
+                anim->apply(this, timeIndex, 
                   animState->getWeight() * weightFactor, linked ? linked->scale : 1.0f);
               }
             }
@@ -459,29 +469,17 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void Skeleton::_getBoneMatrices(Matrix4* pMatrices)
     {
-        // Update derived transforms
-        _updateTransforms();
-
         /*
             Calculating the bone matrices
             -----------------------------
-            Now that we have the derived scaling factors, orientations & positions in the
-            Bone nodes, we have to compute the Matrix4 to apply to the vertices of a mesh.
+            Once we have the derived scaling factors, orientations & positions of the
+            bones, we have to compute the Matrix4 to apply to the vertices of a mesh.
             Because any modification of a vertex has to be relative to the bone, we must
             first reverse transform by the Bone's original derived position/orientation/scale,
             then transform by the new derived position/orientation/scale.
             Also note we combine scale as equivalent axes, no shearing.
         */
-
-        BoneList::const_iterator i, boneend;
-        boneend = mBoneList.end();
-        for (i = mBoneList.begin();i != boneend; ++i)
-        {
-            Bone* pBone = *i;
-            pBone->_getOffsetTransform(*pMatrices);
-            pMatrices++;
-        }
-
+        updateBoneTransforms(pMatrices);
     }
     //---------------------------------------------------------------------
     unsigned short Skeleton::getNumAnimations(void) const
@@ -644,13 +642,138 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void Skeleton::_updateTransforms(void)
     {
-        BoneList::iterator i, iend;
-        iend = mRootBones.end();
-        for (i = mRootBones.begin(); i != iend; ++i)
+        updateBoneTransforms(0);
+    }
+    //---------------------------------------------------------------------
+    bool Skeleton::isBoneUpdateOrderValid(void) const
+    {
+        // New bones clear mBoneParents, so only moved bones need looking for
+        const size_t numBones = mBoneList.size();
+        if (mBoneParents.size() != numBones)
+            return false;
+
+        for (size_t handle = 0; handle < numBones; ++handle)
+        {
+            const Bone* bone = mBoneList[handle];
+            if (!bone)
+                continue;
+            ushort parent = mBoneParents[handle];
+            Node* expected = (parent == handle) ? 0 : mBoneList[parent];
+            if (bone->getParent() != expected)
+                return false;
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void Skeleton::deriveBoneUpdateOrder(void)
+    {
+        const size_t numBones = mBoneList.size();
+        mBoneParents.resize(numBones);
+        mBoneUpdateOrder.clear();
+        mBoneUpdateOrder.reserve(numBones);
+
+        // Breadth first from every root, using the order itself as the queue
+        for (size_t handle = 0; handle < numBones; ++handle)
+        {
+            // Unused handles are left out of the order
+            mBoneParents[handle] = (ushort)handle;
+            if (mBoneList[handle] && !mBoneList[handle]->getParent())
+                mBoneUpdateOrder.push_back((ushort)handle);
+        }
+        for (size_t i = 0; i < mBoneUpdateOrder.size(); ++i)
+        {
+            ushort parent = mBoneUpdateOrder[i];
+            Node::ChildNodeIterator it = mBoneList[parent]->getChildIterator();
+            while (it.hasMoreElements())
+            {
+                // Skip TagPoints, which are updated by their bone
+                Bone* child = static_cast<Bone*>(it.getNext());
+                ushort handle = child->getHandle();
+                if (handle < numBones && mBoneList[handle] == child)
+                {
+                    mBoneParents[handle] = parent;
+                    mBoneUpdateOrder.push_back(handle);
+                }
+            }
+        }
+
+        mBoneDerivedOrientations.resize(numBones);
+        mBoneDerivedPositions.resize(numBones);
+        mBoneDerivedScales.resize(numBones);
+        mBoneBindInverseOrientations.resize(numBones);
+        mBoneBindInversePositions.resize(numBones);
+        mBoneBindInverseScales.resize(numBones);
+    }
+    //---------------------------------------------------------------------
+    void Skeleton::updateBoneTransforms(Matrix4* pMatrices)
+    {
+        if (!isBoneUpdateOrderValid())
+            deriveBoneUpdateOrder();
+
+        mManualBonesDirty = false;
+        const size_t numBones = mBoneUpdateOrder.size();
+        if (!numBones)
+            return;
+
+        const ushort* parents = &mBoneParents[0];
+        Quaternion* derivedOrientations = &mBoneDerivedOrientations[0];
+        Vector3* derivedPositions = &mBoneDerivedPositions[0];
+        Vector3* derivedScales = &mBoneDerivedScales[0];
+
+        // Every bone comes after its parent, so one forward pass sees the 
+        // final derived transform of each parent. The maths is the same as 
+        // Node::updateFromParentImpl.
+        BoneHandleList::const_iterator i, iend;
+        iend = mBoneUpdateOrder.end();
+        for (i = mBoneUpdateOrder.begin(); i != iend; ++i)
+        {
+            const ushort handle = *i;
+            const ushort parent = parents[handle];
+            Bone* bone = mBoneList[handle];
+            const Quaternion& orientation = bone->getOrientation();
+            const Vector3& position = bone->getPosition();
+            const Vector3& scale = bone->getScale();
+
+            if (parent == handle)
+            {
+                // Root bone, no parent
+                derivedOrientations[handle] = orientation;
+                derivedPositions[handle] = position;
+                derivedScales[handle] = scale;
+            }
+            else
+            {
+                const Quaternion& parentOrientation = derivedOrientations[parent];
+                const Vector3& parentScale = derivedScales[parent];
+
+                derivedOrientations[handle] = bone->getInheritOrientation() ?
+                    parentOrientation * orientation : orientation;
+                derivedScales[handle] = bone->getInheritScale() ?
+                    parentScale * scale : scale;
+                derivedPositions[handle] = 
+                    parentOrientation * (parentScale * position) + derivedPositions[parent];
+            }
+
+            bone->_updateFromSkeleton(derivedOrientations[handle],
+                derivedPositions[handle], derivedScales[handle]);
+
+            if (pMatrices)
+            {
+                mBoneBindInverseOrientations[handle] = bone->_getBindingPoseInverseOrientation();
+                mBoneBindInversePositions[handle] = bone->_getBindingPoseInversePosition();
+                mBoneBindInverseScales[handle] = bone->_getBindingPoseInverseScale();
+            }
+        }
+
+        if (pMatrices)
         {
-            (*i)->_update(true, false);
+            // The matrices are independent of each other, calculate them all
+            // at once in handle order
+            OptimisedUtil::getImplementation()->calculateBoneOffsetMatrices(
+                derivedOrientations, derivedPositions, derivedScales,
+                &mBoneBindInverseOrientations[0], &mBoneBindInversePositions[0],
+                &mBoneBindInverseScales[0], pMatrices, numBones);
         }
-		mManualBonesDirty = false;
     }
     //---------------------------------------------------------------------
 	void Skeleton::optimiseAllAnimations(bool preservingIdentityNodeTracks)
@@ -0,0 +1,382 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreSoftwareSkinningBatch.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreWorkerThreadPool.h"
+
+namespace Ogre {
+
+	namespace
+	{
+		/// A run of vertices of one blend, with the buffers already locked
+		struct SkinningChunk
+		{
+			const float* srcPos;
+			float* destPos;
+			const float* srcNorm;
+			float* destNorm;
+			const float* blendWeight;
+			const unsigned char* blendIdx;
+			const Matrix4* const* blendMatrices;
+			size_t srcPosStride, destPosStride, srcNormStride, destNormStride;
+			size_t blendWeightStride, blendIdxStride;
+			size_t numWeightsPerVertex;
+			size_t numVertices;
+
+			/// Get the chunk covering count vertices from the given vertex
+			SkinningChunk subChunk(size_t first, size_t count) const
+			{
+				SkinningChunk c = *this;
+				c.srcPos = offset(srcPos, first * srcPosStride);
+				c.destPos = offset(destPos, first * destPosStride);
+				if (srcNorm)
+				{
+					c.srcNorm = offset(srcNorm, first * srcNormStride);
+					c.destNorm = offset(destNorm, first * destNormStride);
+				}
+				c.blendWeight = offset(blendWeight, first * blendWeightStride);
+				c.blendIdx = blendIdx + first * blendIdxStride;
+				c.numVertices = count;
+				return c;
+			}
+
+			static const float* offset(const float* p, size_t bytes)
+			{
+				return reinterpret_cast<const float*>(
+					reinterpret_cast<const char*>(p) + bytes);
+			}
+			static float* offset(float* p, size_t bytes)
+			{
+				return reinterpret_cast<float*>(reinterpret_cast<char*>(p) + bytes);
+			}
+
+			void skin(void) const
+			{
+				OptimisedUtil::getImplementation()->softwareVertexSkinning(
+					srcPos, destPos, srcNorm, destNorm,
+					blendWeight, blendIdx, blendMatrices,
+					srcPosStride, destPosStride, srcNormStride, destNormStride,
+					blendWeightStride, blendIdxStride,
+					numWeightsPerVertex, numVertices);
+			}
+		};
+		typedef std::vector<SkinningChunk> SkinningChunkList;
+
+		/// Task which skins a range of chunks
+		class SkinningTask : public WorkerThreadPool::Task
+		{
+		protected:
+			const SkinningChunkList* mChunks;
+			size_t mBegin, mEnd;
+		public:
+			SkinningTask(const SkinningChunkList* chunks, size_t begin, size_t end)
+				: mChunks(chunks), mBegin(begin), mEnd(end) {}
+			void execute(void)
+			{
+				for (size_t i = mBegin; i != mEnd; ++i)
+					(*mChunks)[i].skin();
+			}
+		};
+	}
+	//-----------------------------------------------------------------------
+	SoftwareSkinningBatch::SoftwareSkinningBatch()
+		: mNumVertices(0)
+	{
+	}
+	//-----------------------------------------------------------------------
+	SoftwareSkinningBatch::~SoftwareSkinningBatch()
+	{
+		clear();
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareSkinningBatch::addBlend(const VertexData* sourceVertexData, 
+		const VertexData* targetVertexData,
+		const Matrix4* const* blendMatrices, size_t numMatrices,
+		bool blendNormals)
+	{
+		// Get elements for source
+		const VertexElement* srcElemPos =
+			sourceVertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+		const VertexElement* srcElemNorm =
+			sourceVertexData->vertexDeclaration->findElementBySemantic(VES_NORMAL);
+		const VertexElement* srcElemBlendIndices =
+			sourceVertexData->vertexDeclaration->findElementBySemantic(VES_BLEND_INDICES);
+		const VertexElement* srcElemBlendWeights =
+			sourceVertexData->vertexDeclaration->findElementBySemantic(VES_BLEND_WEIGHTS);
+		assert (srcElemPos && srcElemBlendIndices && srcElemBlendWeights &&
+			"You must supply at least positions, blend indices and blend weights");
+		// Get elements for target
+		const VertexElement* destElemPos =
+			targetVertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+		const VertexElement* destElemNorm =
+			targetVertexData->vertexDeclaration->findElementBySemantic(VES_NORMAL);
+		// Indices must be 4 bytes
+		assert(srcElemBlendIndices->getType() == VET_UBYTE4 &&
+			"Blend indices must be VET_UBYTE4");
+
+		Blend blend;
+		// Do we have normals and want to blend them?
+		blend.includeNormals = blendNormals && (srcElemNorm != NULL) && (destElemNorm != NULL);
+
+		// Get buffers and offsets for source
+		const VertexBufferBinding* srcBinding = sourceVertexData->vertexBufferBinding;
+		blend.srcPosBuf = srcBinding->getBuffer(srcElemPos->getSource());
+		blend.srcPosOffset = srcElemPos->getOffset();
+		blend.srcIdxBuf = srcBinding->getBuffer(srcElemBlendIndices->getSource());
+		blend.blendIdxOffset = srcElemBlendIndices->getOffset();
+		blend.srcWeightBuf = srcBinding->getBuffer(srcElemBlendWeights->getSource());
+		blend.blendWeightOffset = srcElemBlendWeights->getOffset();
+		blend.numWeightsPerVertex = 
+			VertexElement::getTypeCount(srcElemBlendWeights->getType());
+		blend.srcNormOffset = 0;
+		if (blend.includeNormals)
+		{
+			blend.srcNormBuf = srcBinding->getBuffer(srcElemNorm->getSource());
+			blend.srcNormOffset = srcElemNorm->getOffset();
+		}
+		// Get buffers and offsets for target
+		const VertexBufferBinding* destBinding = targetVertexData->vertexBufferBinding;
+		blend.destPosBuf = destBinding->getBuffer(destElemPos->getSource());
+		blend.destPosOffset = destElemPos->getOffset();
+		blend.destNormOffset = 0;
+		if (blend.includeNormals)
+		{
+			blend.destNormBuf = destBinding->getBuffer(destElemNorm->getSource());
+			blend.destNormOffset = destElemNorm->getOffset();
+		}
+		blend.numVertices = targetVertexData->vertexCount;
+
+		// Lock options as in Mesh::softwareVertexBlend; discard only if the
+		// blend writes every byte of the buffer
+		addBuffer(blend.srcPosBuf, HardwareBuffer::HBL_READ_ONLY);
+		addBuffer(blend.srcIdxBuf, HardwareBuffer::HBL_READ_ONLY);
+		addBuffer(blend.srcWeightBuf, HardwareBuffer::HBL_READ_ONLY);
+		if (blend.includeNormals)
+		{
+			addBuffer(blend.srcNormBuf, HardwareBuffer::HBL_READ_ONLY);
+			if (blend.destNormBuf != blend.destPosBuf)
+			{
+				addBuffer(blend.destPosBuf, 
+					blend.destPosBuf->getVertexSize() == destElemPos->getSize() ?
+					HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
+				addBuffer(blend.destNormBuf, 
+					blend.destNormBuf->getVertexSize() == destElemNorm->getSize() ?
+					HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
+			}
+			else
+			{
+				addBuffer(blend.destPosBuf, blend.destPosBuf->getVertexSize() == 
+					destElemPos->getSize() + destElemNorm->getSize() ?
+					HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
+			}
+		}
+		else
+		{
+			addBuffer(blend.destPosBuf, 
+				blend.destPosBuf->getVertexSize() == destElemPos->getSize() ?
+				HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
+		}
+
+		blend.firstBlendMatrix = mBlendMatrices.size();
+		mBlendMatrices.insert(mBlendMatrices.end(), blendMatrices, blendMatrices + numMatrices);
+
+		mBlends.push_back(blend);
+		mNumVertices += blend.numVertices;
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareSkinningBatch::addBuffer(const HardwareVertexBufferSharedPtr& buf, 
+		HardwareBuffer::LockOptions options)
+	{
+		LockedBufferMap::iterator i = mLockedBuffers.find(buf.get());
+		if (i == mLockedBuffers.end())
+		{
+			LockedBuffer& locked = mLockedBuffers[buf.get()];
+			locked.buffer = buf;
+			locked.options = options;
+			locked.data = 0;
+		}
+		else if (i->second.options != options)
+		{
+			// Used in more than one way, so keep the contents
+			i->second.options = HardwareBuffer::HBL_NORMAL;
+		}
+	}
+	//-----------------------------------------------------------------------
+	char* SoftwareSkinningBatch::getLockedData(const HardwareVertexBufferSharedPtr& buf) const
+	{
+		LockedBufferMap::const_iterator i = mLockedBuffers.find(buf.get());
+		assert(i != mLockedBuffers.end() && i->second.data);
+		return i->second.data;
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareSkinningBatch::unlockBuffers(void)
+	{
+		LockedBufferMap::iterator i, iend;
+		iend = mLockedBuffers.end();
+		for (i = mLockedBuffers.begin(); i != iend; ++i)
+		{
+			if (i->second.data)
+			{
+				i->second.buffer->unlock();
+				i->second.data = 0;
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareSkinningBatch::execute(void)
+	{
+		if (mBlends.empty())
+			return;
+
+		try
+		{
+			// Lock each buffer once, since several blends may share a source
+			LockedBufferMap::iterator li, liend;
+			liend = mLockedBuffers.end();
+			for (li = mLockedBuffers.begin(); li != liend; ++li)
+			{
+				li->second.data = static_cast<char*>(
+					li->second.buffer->lock(li->second.options));
+			}
+
+			// One chunk per blend to start with
+			SkinningChunkList blendChunks;
+			blendChunks.reserve(mBlends.size());
+			BlendList::const_iterator bi, biend;
+			biend = mBlends.end();
+			for (bi = mBlends.begin(); bi != biend; ++bi)
+			{
+				const Blend& b = *bi;
+				SkinningChunk c;
+				c.srcPos = reinterpret_cast<const float*>(
+					getLockedData(b.srcPosBuf) + b.srcPosOffset);
+				c.destPos = reinterpret_cast<float*>(
+					getLockedData(b.destPosBuf) + b.destPosOffset);
+				c.srcNorm = 0;
+				c.destNorm = 0;
+				c.srcNormStride = 0;
+				c.destNormStride = 0;
+				if (b.includeNormals)
+				{
+					c.srcNorm = reinterpret_cast<const float*>(
+						getLockedData(b.srcNormBuf) + b.srcNormOffset);
+					c.destNorm = reinterpret_cast<float*>(
+						getLockedData(b.destNormBuf) + b.destNormOffset);
+					c.srcNormStride = b.srcNormBuf->getVertexSize();
+					c.destNormStride = b.destNormBuf->getVertexSize();
+				}
+				c.blendWeight = reinterpret_cast<const float*>(
+					getLockedData(b.srcWeightBuf) + b.blendWeightOffset);
+				c.blendIdx = reinterpret_cast<const unsigned char*>(
+					getLockedData(b.srcIdxBuf) + b.blendIdxOffset);
+				c.blendMatrices = mBlendMatrices.empty() ? 0 : &mBlendMatrices[b.firstBlendMatrix];
+				c.srcPosStride = b.srcPosBuf->getVertexSize();
+				c.destPosStride = b.destPosBuf->getVertexSize();
+				c.blendWeightStride = b.srcWeightBuf->getVertexSize();
+				c.blendIdxStride = b.srcIdxBuf->getVertexSize();
+				c.numWeightsPerVertex = b.numWeightsPerVertex;
+				c.numVertices = b.numVertices;
+				blendChunks.push_back(c);
+			}
+
+			WorkerThreadPool* pool = WorkerThreadPool::getSingletonPtr();
+			if (!pool || !pool->isParallel() || mNumVertices < PARALLEL_SKINNING_MIN_VERTICES)
+			{
+				SkinningChunkList::const_iterator ci, ciend;
+				ciend = blendChunks.end();
+				for (ci = blendChunks.begin(); ci != ciend; ++ci)
+					ci->skin();
+			}
+			else
+			{
+				// Aim for a few tasks per thread so that uneven ones balance out.
+				// Large blends are split up, at multiples of 4 vertices to keep
+				// the alignment SIMD implementations look for; runs of small 
+				// blends are grouped into one task.
+				const size_t targetTasks = (pool->getNumWorkerThreads() + 1) * 4;
+				size_t taskVertices = (mNumVertices + targetTasks - 1) / targetTasks;
+				if (taskVertices < PARALLEL_SKINNING_MIN_VERTICES)
+					taskVertices = PARALLEL_SKINNING_MIN_VERTICES;
+				taskVertices = (taskVertices + 3) & ~size_t(3);
+
+				SkinningChunkList chunks;
+				std::vector<size_t> taskBegins;
+				size_t currentTaskVertices = taskVertices;
+				SkinningChunkList::const_iterator ci, ciend;
+				ciend = blendChunks.end();
+				for (ci = blendChunks.begin(); ci != ciend; ++ci)
+				{
+					for (size_t first = 0; first < ci->numVertices; first += taskVertices)
+					{
+						size_t count = std::min(taskVertices, ci->numVertices - first);
+						if (currentTaskVertices >= taskVertices)
+						{
+							taskBegins.push_back(chunks.size());
+							currentTaskVertices = 0;
+						}
+						chunks.push_back(ci->subChunk(first, count));
+						currentTaskVertices += count;
+					}
+				}
+				taskBegins.push_back(chunks.size());
+
+				const size_t numTasks = taskBegins.size() - 1;
+				std::vector<SkinningTask> tasks;
+				tasks.reserve(numTasks);
+				WorkerThreadPool::TaskList taskList;
+				taskList.reserve(numTasks);
+				for (size_t t = 0; t < numTasks; ++t)
+				{
+					tasks.push_back(SkinningTask(&chunks, taskBegins[t], taskBegins[t + 1]));
+					taskList.push_back(&tasks.back());
+				}
+				pool->executeTasks(taskList);
+			}
+		}
+		catch (...)
+		{
+			clear();
+			throw;
+		}
+
+		// Unlocking uploads the results where necessary
+		clear();
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareSkinningBatch::clear(void)
+	{
+		unlockBuffers();
+		mLockedBuffers.clear();
+		mBlends.clear();
+		mBlendMatrices.clear();
+		mNumVertices = 0;
+	}
+
+}
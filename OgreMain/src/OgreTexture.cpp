@@ -434,4 +434,81 @@ namespace Ogre {
 	}
 
 
+	//--------------------------------------------------------------------------
+	void Texture::prepareSourceImages(void)
+	{
+		String baseName, ext;
+		size_t pos = mName.find_last_of(".");
+		baseName = mName.substr(0, pos);
+		if (pos != String::npos)
+			ext = mName.substr(pos+1);
+
+		mPreparedImages.clear();
+		if (mTextureType == TEX_TYPE_CUBE_MAP && getSourceFileType() != "dds")
+		{
+			// Six separate faces
+			mPreparedImages.resize(6);
+			static const String suffixes[6] = {"_rt", "_lf", "_up", "_dn", "_fr", "_bk"};
+
+			for (size_t i = 0; i < 6; i++)
+			{
+				String fullName = baseName + suffixes[i];
+				if (!ext.empty())
+					fullName = fullName + "." + ext;
+				// find & load resource data intro stream to allow resource
+				// group changes if required
+				DataStreamPtr dstream =
+					ResourceGroupManager::getSingleton().openResource(
+						fullName, mGroup, true, this);
+
+				mPreparedImages[i].load(dstream, ext);
+			}
+		}
+		else
+		{
+			mPreparedImages.resize(1);
+			Image& img = mPreparedImages[0];
+			// find & load resource data intro stream to allow resource
+			// group changes if required
+			DataStreamPtr dstream =
+				ResourceGroupManager::getSingleton().openResource(
+					mName, mGroup, true, this);
+
+			img.load(dstream, ext);
+
+			if (mTextureType != TEX_TYPE_CUBE_MAP)
+			{
+				// If this is a cube map, set the texture type flag accordingly.
+				if (img.hasFlag(IF_CUBEMAP))
+					mTextureType = TEX_TYPE_CUBE_MAP;
+				// If this is a volumetric texture set the texture type flag accordingly.
+				if (img.getDepth() > 1)
+					mTextureType = TEX_TYPE_3D;
+			}
+		}
+	}
+	//--------------------------------------------------------------------------
+	void Texture::loadPreparedImages(void)
+	{
+		if (mPreparedImages.empty())
+			prepareSourceImages();
+
+		ConstImagePtrList imagePtrs;
+		for (std::vector<Image>::iterator i = mPreparedImages.begin();
+			i != mPreparedImages.end(); ++i)
+		{
+			imagePtrs.push_back(&(*i));
+		}
+		// Call internal _loadImages, not loadImage since that's external and 
+		// will determine load status etc again
+		_loadImages(imagePtrs);
+
+		mPreparedImages.clear();
+	}
+	//--------------------------------------------------------------------------
+	void Texture::unprepareImpl(void)
+	{
+		mPreparedImages.clear();
+	}
+
 }
@@ -0,0 +1,288 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreLogManager.h"
+#include "OgreException.h"
+#include "OgreStringConverter.h"
+#include <new>
+
+namespace Ogre {
+
+    //-----------------------------------------------------------------------
+    template<> WorkerThreadPool* Singleton<WorkerThreadPool>::ms_Singleton = 0;
+    WorkerThreadPool* WorkerThreadPool::getSingletonPtr(void)
+    {
+        return ms_Singleton;
+    }
+    WorkerThreadPool& WorkerThreadPool::getSingleton(void)
+    {
+        assert( ms_Singleton );  return ( *ms_Singleton );
+    }
+	//-----------------------------------------------------------------------
+	WorkerThreadPool::WorkerThreadPool()
+		: mNumWorkerThreads(0)
+		, mCurrentBatch(0)
+		, mNextTask(0)
+		, mTasksRemaining(0)
+		, mTaskException(0)
+		, mTaskOutOfMemory(false)
+		, mShuttingDown(false)
+		, mBatchInProgress(false)
+	{
+	}
+	//-----------------------------------------------------------------------
+	WorkerThreadPool::~WorkerThreadPool()
+	{
+		stopThreads();
+	}
+	//-----------------------------------------------------------------------
+	void WorkerThreadPool::setNumWorkerThreads(size_t numThreads)
+	{
+		if (mBatchInProgress)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+				"Cannot change the number of worker threads while a batch is "
+				"in progress", "WorkerThreadPool::setNumWorkerThreads");
+		}
+
+		if (numThreads == mNumWorkerThreads)
+			return;
+
+		stopThreads();
+		mNumWorkerThreads = numThreads;
+		startThreads();
+	}
+	//-----------------------------------------------------------------------
+	bool WorkerThreadPool::isParallel(void) const
+	{
+#if OGRE_THREAD_SUPPORT
+		return !mThreads.empty();
+#else
+		return false;
+#endif
+	}
+	//-----------------------------------------------------------------------
+	void WorkerThreadPool::startThreads(void)
+	{
+#if OGRE_THREAD_SUPPORT
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			mShuttingDown = false;
+		}
+		for (size_t i = 0; i < mNumWorkerThreads; ++i)
+		{
+			mThreads.push_back(new boost::thread(WorkerFunc(this)));
+		}
+		if (mNumWorkerThreads)
+		{
+			LogManager::getSingleton().logMessage(
+				"WorkerThreadPool - started " +
+				StringConverter::toString(mNumWorkerThreads) + " worker threads");
+		}
+#else
+		if (mNumWorkerThreads)
+		{
+			LogManager::getSingleton().logMessage(
+				"WorkerThreadPool - threading disabled, tasks will be executed serially");
+		}
+#endif
+	}
+	//-----------------------------------------------------------------------
+	void WorkerThreadPool::stopThreads(void)
+	{
+#if OGRE_THREAD_SUPPORT
+		if (mThreads.empty())
+			return;
+
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			mShuttingDown = true;
+			OGRE_THREAD_NOTIFY_ALL(mWorkCondition)
+		}
+		for (ThreadList::iterator i = mThreads.begin(); i != mThreads.end(); ++i)
+		{
+			(*i)->join();
+			delete *i;
+		}
+		mThreads.clear();
+#endif
+	}
+	//-----------------------------------------------------------------------
+	void WorkerThreadPool::executeTask(Task* task)
+	{
+		try
+		{
+			task->execute();
+		}
+		catch (Exception& e)
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			if (!mTaskException && !mTaskOutOfMemory)
+				mTaskException = new Exception(e);
+		}
+		catch (std::bad_alloc&)
+		{
+			// Don't try to allocate a copy, just remember what happened
+			OGRE_LOCK_AUTO_MUTEX
+			if (!mTaskException)
+				mTaskOutOfMemory = true;
+		}
+		catch (std::exception& e)
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			if (!mTaskException && !mTaskOutOfMemory)
+			{
+				mTaskException = new Exception(Exception::ERR_INTERNAL_ERROR,
+					String("Task threw an exception: ") + e.what(), 
+					"WorkerThreadPool::executeTask");
+			}
+		}
+		catch (...)
+		{
+			// Nothing may escape a worker thread, or the process terminates
+			OGRE_LOCK_AUTO_MUTEX
+			if (!mTaskException && !mTaskOutOfMemory)
+			{
+				mTaskException = new Exception(Exception::ERR_INTERNAL_ERROR,
+					"Task threw an unknown exception", 
+					"WorkerThreadPool::executeTask");
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void WorkerThreadPool::processTasks(void)
+	{
+		while (true)
+		{
+			Task* task;
+			{
+				OGRE_LOCK_AUTO_MUTEX
+				if (!mCurrentBatch || mNextTask == mCurrentBatch->size())
+					return;
+				task = (*mCurrentBatch)[mNextTask++];
+			}
+
+			executeTask(task);
+
+			{
+				OGRE_LOCK_AUTO_MUTEX
+				if (--mTasksRemaining == 0)
+				{
+					OGRE_THREAD_NOTIFY_ALL(mDoneCondition)
+				}
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void WorkerThreadPool::executeTasks(const TaskList& tasks)
+	{
+		if (tasks.empty())
+			return;
+
+		bool serial = true;
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			if (!mBatchInProgress && isParallel() && tasks.size() > 1)
+			{
+				mBatchInProgress = true;
+				mCurrentBatch = &tasks;
+				mNextTask = 0;
+				mTasksRemaining = tasks.size();
+				serial = false;
+				OGRE_THREAD_NOTIFY_ALL(mWorkCondition)
+			}
+		}
+
+		if (serial)
+		{
+			// Nothing to gain from handing over to workers, or we've been
+			// called from within a batch; just run everything here
+			for (TaskList::const_iterator i = tasks.begin(); i != tasks.end(); ++i)
+			{
+				(*i)->execute();
+			}
+			return;
+		}
+
+		// Help out with our own batch
+		processTasks();
+
+		Exception* taskException;
+		bool taskOutOfMemory;
+		{
+#if OGRE_THREAD_SUPPORT
+			boost::recursive_mutex::scoped_lock batchLock(OGRE_AUTO_MUTEX_NAME);
+			while (mTasksRemaining)
+			{
+				// frees lock and suspends the thread
+				mDoneCondition.wait(batchLock);
+			}
+#endif
+			mCurrentBatch = 0;
+			mBatchInProgress = false;
+			taskException = mTaskException;
+			mTaskException = 0;
+			taskOutOfMemory = mTaskOutOfMemory;
+			mTaskOutOfMemory = false;
+		}
+
+		if (taskOutOfMemory)
+			throw std::bad_alloc();
+		if (taskException)
+		{
+			Exception e(*taskException);
+			delete taskException;
+			throw e;
+		}
+	}
+#if OGRE_THREAD_SUPPORT
+	//-----------------------------------------------------------------------
+	void WorkerThreadPool::workerThreadMain(void)
+	{
+		while (true)
+		{
+			{
+				boost::recursive_mutex::scoped_lock workLock(OGRE_AUTO_MUTEX_NAME);
+				while (!mShuttingDown &&
+					(!mCurrentBatch || mNextTask == mCurrentBatch->size()))
+				{
+					// frees lock and suspends the thread
+					mWorkCondition.wait(workLock);
+				}
+				if (mShuttingDown)
+					return;
+			} // release lock so other workers can pick up tasks
+
+			processTasks();
+		}
+	}
+#endif
+
+}
@@ -37,6 +37,9 @@ Torus Knot Software Ltd.
 
 #include <zzip/zzip.h>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
 
 namespace Ogre {
 
@@ -230,6 +233,16 @@ namespace Ogre {
 
 	}
 	//-----------------------------------------------------------------------
+	time_t ZipArchive::getModifiedTime(const String& filename)
+	{
+		// Entries only change when the whole archive is rewritten
+		struct stat tagStat;
+		if (!exists(filename) || stat(mName.c_str(), &tagStat) != 0)
+			return 0;
+
+		return tagStat.st_mtime;
+	}
+	//-----------------------------------------------------------------------
     void ZipArchive::checkZzipError(int zzipError, const String& operation) const
     {
         if (zzipError != ZZIP_NO_ERROR)
@@ -243,6 +243,9 @@ namespace Ogre {
 
         /** See RaySceneQuery. */
         void execute(RaySceneQueryListener* listener);
+        /** See RaySceneQuery; executes the query for each ray in turn, since
+            the rays are traced through the level geometry. */
+        void executeBatch(const RayList& rays, RaySceneQueryResultList& results);
     protected:
         /// Set for eliminating duplicates since objects can be in > 1 node
         std::set<MovableObject*> mObjsThisQuery;
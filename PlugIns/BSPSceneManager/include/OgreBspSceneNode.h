@@ -52,12 +52,16 @@ namespace Ogre {
 	protected:
 		/// Overridden from SceneNode
 		void setInSceneGraph(bool inGraph);		
+		/// Tell the scene manager where the attached objects now are
+		void notifyObjectsMoved(void);
     public:
         BspSceneNode(SceneManager* creator) : SceneNode(creator) {}
         BspSceneNode(SceneManager* creator, const String& name) 
             : SceneNode(creator, name) {}
         /// Overridden from Node
         void _update(bool updateChildren, bool parentHasChanged);
+        /// Overridden from SceneNode
+        void _transformStoreUpdateComplete(bool moved);
         /** Detaches the indexed object from this scene node.
         @remarks
             Detaches by index, see the alternate version to detach by name. Object indexes
@@ -807,6 +807,12 @@ namespace Ogre {
 		}
     }
     //-----------------------------------------------------------------------
+    void BspRaySceneQuery::executeBatch(const RayList& rays, 
+        RaySceneQueryResultList& results)
+    {
+        RaySceneQuery::executeBatch(rays, results);
+    }
+    //-----------------------------------------------------------------------
     BspRaySceneQuery::~BspRaySceneQuery()
     {
         clearTemporaries();
@@ -47,19 +47,34 @@ namespace Ogre {
 
         if (checkMovables)
         {
-            // Check membership of attached objects
-            ObjectMap::const_iterator it, itend;
-            itend = mObjectsByName.end();
-            for (it = mObjectsByName.begin(); it != itend; ++it)
-            {
-                MovableObject* mov = it->second;
+            notifyObjectsMoved();
+        }
 
-                static_cast<BspSceneManager*>(mCreator)->_notifyObjectMoved(
-                    mov, this->_getDerivedPosition());
+    }
+    //-------------------------------------------------------------------------
+    void BspSceneNode::_transformStoreUpdateComplete(bool moved)
+    {
+        SceneNode::_transformStoreUpdateComplete(moved);
 
-            }
+        if (moved)
+        {
+            notifyObjectsMoved();
         }
+    }
+    //-------------------------------------------------------------------------
+    void BspSceneNode::notifyObjectsMoved(void)
+    {
+        // Check membership of attached objects
+        ObjectMap::const_iterator it, itend;
+        itend = mObjectsByName.end();
+        for (it = mObjectsByName.begin(); it != itend; ++it)
+        {
+            MovableObject* mov = it->second;
 
+            static_cast<BspSceneManager*>(mCreator)->_notifyObjectMoved(
+                mov, this->_getDerivedPosition());
+
+        }
     }
 	//-------------------------------------------------------------------------
 	MovableObject* BspSceneNode::detachObject(unsigned short index)
@@ -43,6 +43,7 @@ Enhancements 2003 - 2004 (C) The OGRE Team
 #include <OgreWireBoundingBox.h>
 
 #include <list>
+#include <vector>
 
 namespace Ogre
 {
@@ -50,6 +51,8 @@ namespace Ogre
 class OctreeNode;
 
 typedef std::list < OctreeNode * > NodeList;
+/// Nodes attached directly to an octant, kept contiguous for culling
+typedef std::vector < OctreeNode * > OctantNodeList;
 
 
 /** Octree datastructure for managing scene nodes.
@@ -58,6 +61,9 @@ This is a loose octree implementation, meaning that each
 octant child of the octree actually overlaps it's siblings by a factor
 of .5.  This guarantees that any thing that is half the size of the parent will
 fit completely into a child, with no splitting necessary.
+@par
+How far the culling bounds of an octant extend beyond mBox is given by
+mLooseness; see OctreeSceneManager::setLooseOctree.
 */
 
 class Octree
@@ -74,6 +80,9 @@ public:
     void _addNode( OctreeNode * );
 
     /** Removes an Octree scene node to this octree level.
+    @remarks
+    The last node of the level takes the place of the removed one, so the
+    order of the remaining nodes is not preserved.
     */
     void _removeNode( OctreeNode * );
 
@@ -99,6 +108,13 @@ public:
     */
     Vector3 mHalfSize;
 
+    /** Size of the culling bounds of this octree relative to mBox.
+    @remarks
+    Copied from the parent when an octree is created; 2 unless the
+    OctreeSceneManager has been told otherwise.
+    */
+    Real mLooseness;
+
     /** 3D array of children of this octree.
     @remarks
     Children are dynamically created as needed when nodes are inserted in the Octree.
@@ -127,10 +143,23 @@ public:
     */
     void _getCullBounds( AxisAlignedBox * ) const;
 
+    /** Determines if the given box lies entirely within the culling bounds of this octree.
+    */
+    bool _isInCullBounds( const AxisAlignedBox &box ) const;
+
+    /** Gets the bounds of the child at the given indexes.
+    */
+    void _getChildBox( int x, int y, int z, AxisAlignedBox *b ) const;
+
+    /** Determines if the given box lies entirely within the culling bounds
+    the child at the given indexes has, or would have once created.
+    */
+    bool _isInChildCullBounds( int x, int y, int z, const AxisAlignedBox &box ) const;
+
 
     /** Public list of SceneNodes attached to this particular octree
     */
-    NodeList mNodes;
+    OctantNodeList mNodes;
 
 protected:
 
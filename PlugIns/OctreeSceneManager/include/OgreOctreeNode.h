@@ -88,6 +88,35 @@ public:
         mOctant = o;
     };
 
+    /** Gets the position of this node in the node list of its octant */
+    size_t _getOctantIndex() const
+    {
+        return mOctantIndex;
+    };
+
+    /** Sets the position of this node in the node list of its octant */
+    void _setOctantIndex( size_t index )
+    {
+        mOctantIndex = index;
+    };
+
+    /** Gets the position of this node in the OctreeSceneManager's queue of
+    nodes waiting to be reinserted, or NOT_QUEUED if it is not in the queue.
+    */
+    size_t _getReinsertQueueIndex() const
+    {
+        return mReinsertQueueIndex;
+    };
+
+    /** Sets the position of this node in the reinsert queue */
+    void _setReinsertQueueIndex( size_t index )
+    {
+        mReinsertQueueIndex = index;
+    };
+
+    /// Value of _getReinsertQueueIndex for nodes which are not queued
+    static const size_t NOT_QUEUED = ~static_cast<size_t>(0);
+
     /** Determines if the center of this node is within the given box
     */
     bool _isIn( AxisAlignedBox &box );
@@ -132,6 +161,10 @@ protected:
 
     ///Octree this node is attached to.
     Octree *mOctant;
+    ///Position of this node in the node list of mOctant
+    size_t mOctantIndex;
+    ///Position of this node in the reinsert queue, or NOT_QUEUED
+    size_t mReinsertQueueIndex;
 
     ///preallocated corners for rendering
     Real mCorners[ 24 ];
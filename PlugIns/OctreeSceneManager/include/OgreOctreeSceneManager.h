@@ -107,7 +107,8 @@ public:
 
 
 
-    /** Does nothing more */
+    /** Updates the scene graph, then reinserts any nodes which were queued 
+    for it by a loose octree. */
     virtual void _updateSceneGraph( Camera * cam );
     /** Recurses through the octree determining which nodes are visible. */
     virtual void _findVisibleObjects ( Camera * cam, 
@@ -137,6 +138,12 @@ public:
     /** Adds the Octree Node, starting at the given octree, and recursing at max to the specified depth.
     */
     void _addOctreeNode( OctreeNode *, Octree *octree, int depth = 0 );
+    /** Moves all the nodes queued by _updateOctreeNode to their new octants.
+    @remarks
+    Only loose octrees queue nodes. This is done once per frame after the 
+    scene graph update, and before anything searches the octree.
+    */
+    void _reinsertQueuedNodes( void );
 
     /** Recurses the octree, adding any nodes intersecting with the box into the given list.
     It ignores the exclude scene node.
@@ -164,9 +171,50 @@ public:
         mShowBoxes = b;
     };
 
-    void setLooseOctree( bool b )
+    /** Sets whether nodes are kept in their octant until they leave its culling bounds.
+    @remarks
+    Normally a node is moved to another octant as soon as the centre of its
+    bounds leaves the box of its octant, which makes for a lot of removals 
+    and insertions in scenes with many moving objects. When this is enabled, 
+    a node instead stays in its octant for as long as its bounds lie within 
+    the culling bounds of the octant, whose size relative to the octant is 
+    set with setLooseness. Nodes which do have to move are queued and 
+    reinserted together once per frame, after the scene graph update.
+    @par
+    Nodes are only moved down to a smaller octant when they are reinserted,
+    so a node which shrinks may stay in a larger octant than necessary.
+    Changing this rebuilds the octree. Defaults to false.
+    */
+    void setLooseOctree( bool b );
+    /** Gets whether nodes are kept in their octant until they leave its culling bounds. */
+    bool getLooseOctree( void ) const
+    {
+        return mLoose;
+    };
+    /** Sets the size of the culling bounds of each octant relative to the octant itself.
+    @remarks
+    Larger values let nodes move further before they have to be reinserted,
+    and let larger nodes fit into smaller octants, at the cost of octants
+    being culled less effectively. Values below 1 are clamped to 1. Only
+    used if setLooseOctree is enabled, otherwise the culling bounds are
+    always twice the size of the octant. Changing this rebuilds the octree 
+    if a loose octree is in use. Defaults to 2.
+    */
+    void setLooseness( Real looseness );
+    /** Gets the size of the culling bounds of each octant relative to the octant itself. */
+    Real getLooseness( void ) const
     {
-        mLoose = b;
+        return mLooseness;
+    };
+    /** Gets the number of nodes moved from one octant to another during the
+    current frame.
+    @remarks
+    The count is reset at the start of each scene graph update, so after a 
+    frame has been rendered it covers that whole frame.
+    */
+    size_t getNumReinsertions( void ) const
+    {
+        return mNumReinsertions;
     };
 
 
@@ -179,6 +227,9 @@ public:
         "Size", AxisAlignedBox *;
         "Depth", int *;
         "ShowOctree", bool *;
+        "LooseOctree", bool *;
+        "Looseness", Real *;
+        and, for getOption only, "Reinsertions", size_t *.
     */
 
     virtual bool setOption( const String &, const void * );
@@ -211,6 +262,10 @@ protected:
     /// List of boxes to be rendered
     BoxList mBoxes;
 
+    /// Scratch space for culling the nodes of a partially visible octant at once
+    std::vector<AxisAlignedBox> mCullBounds;
+    std::vector<uint32> mCullVisibility;
+
     /// Number of rendered objs
     int mNumObjects;
 
@@ -223,7 +278,21 @@ protected:
     bool mShowBoxes;
 
 
+    /// Keep nodes in their octant until they leave its culling bounds?
     bool mLoose;
+    /// Size of the culling bounds of octants relative to the octants, if mLoose
+    Real mLooseness;
+
+    /// Nodes which have left their octant, to be reinserted by _reinsertQueuedNodes
+    std::vector<OctreeNode*> mReinsertQueue;
+    /// Number of nodes moved to another octant since the last scene graph update began
+    size_t mNumReinsertions;
+
+    /** Removes a node from the reinsert queue, if it is in it. */
+    void dequeueReinsert( OctreeNode * );
+    /** Moves a node with the given world bounds to another octant if needed,
+        or queues the move if the octree is loose. */
+    void placeOctreeNode( OctreeNode *, const AxisAlignedBox& box );
 
     Real mCorners[ 24 ];
     static unsigned long mColors[ 8 ];
@@ -231,6 +300,9 @@ protected:
 
     Matrix4 mScaleFactor;
 
+    /// Protects the octree while nodes are updated in parallel
+    OGRE_MUTEX(mOctreeUpdateMutex)
+
 };
 
 /// Factory for OctreeSceneManager
@@ -67,6 +67,9 @@ public:
 
     /** See RayScenQuery. */
     void execute(RaySceneQueryListener* listener);
+    /** See RaySceneQuery; executes the query for each ray in turn, since
+        the results include the terrain. */
+    void executeBatch(const RayList& rays, RaySceneQueryResultList& results);
 };
 
 
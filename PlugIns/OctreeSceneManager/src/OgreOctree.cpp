@@ -89,7 +89,8 @@ void Octree::_getChildIndexes( const AxisAlignedBox &box, int *x, int *y, int *z
 
 Octree::Octree( Octree * parent ) 
     : mWireBoundingBox(0),
-      mHalfSize( 0, 0, 0 )
+      mHalfSize( 0, 0, 0 ),
+      mLooseness( parent ? parent->mLooseness : 2 )
 {
     //initialize all children to null.
     for ( int i = 0; i < 2; i++ )
@@ -130,6 +131,7 @@ Octree::~Octree()
 
 void Octree::_addNode( OctreeNode * n )
 {
+    n -> _setOctantIndex( mNodes.size() );
     mNodes.push_back( n );
     n -> setOctant( this );
 
@@ -140,7 +142,13 @@ void Octree::_addNode( OctreeNode * n )
 
 void Octree::_removeNode( OctreeNode * n )
 {
-    mNodes.erase( std::find( mNodes.begin(), mNodes.end(), n ) );
+    // Move the last node into the gap
+    size_t index = n -> _getOctantIndex();
+    assert( index < mNodes.size() && mNodes[ index ] == n );
+    OctreeNode * last = mNodes.back();
+    mNodes[ index ] = last;
+    last -> _setOctantIndex( index );
+    mNodes.pop_back();
     n -> setOctant( 0 );
 
     //update total counts.
@@ -149,7 +157,55 @@ void Octree::_removeNode( OctreeNode * n )
 
 void Octree::_getCullBounds( AxisAlignedBox *b ) const
 {
-    b -> setExtents( mBox.getMinimum() - mHalfSize, mBox.getMaximum() + mHalfSize );
+    Vector3 border = mHalfSize * ( mLooseness - 1 );
+    b -> setExtents( mBox.getMinimum() - border, mBox.getMaximum() + border );
+}
+
+/** Returns true if the box lies entirely within the given bounds, expanded
+* on each side by border.
+*/
+static bool _isInExpandedBox( const AxisAlignedBox &bounds, const Vector3 &border,
+                              const AxisAlignedBox &box )
+{
+    if ( box.isNull() || box.isInfinite() )
+        return false;
+
+    Vector3 cmin = bounds.getMinimum() - border;
+    Vector3 cmax = bounds.getMaximum() + border;
+    const Vector3& bmin = box.getMinimum();
+    const Vector3& bmax = box.getMaximum();
+    return cmin.x <= bmin.x && cmin.y <= bmin.y && cmin.z <= bmin.z &&
+        bmax.x <= cmax.x && bmax.y <= cmax.y && bmax.z <= cmax.z;
+}
+
+bool Octree::_isInCullBounds( const AxisAlignedBox &box ) const
+{
+    return _isInExpandedBox( mBox, mHalfSize * ( mLooseness - 1 ), box );
+}
+
+bool Octree::_isInChildCullBounds( int x, int y, int z, const AxisAlignedBox &box ) const
+{
+    AxisAlignedBox childBox;
+    _getChildBox( x, y, z, &childBox );
+    // Children inherit the looseness
+    return _isInExpandedBox( childBox, childBox.getHalfSize() * ( mLooseness - 1 ), box );
+}
+
+void Octree::_getChildBox( int x, int y, int z, AxisAlignedBox *b ) const
+{
+    const Vector3& octantMin = mBox.getMinimum();
+    const Vector3& octantMax = mBox.getMaximum();
+    Vector3 center = ( octantMin + octantMax ) / 2;
+    Vector3 min, max;
+
+    min.x = x == 0 ? octantMin.x : center.x;
+    max.x = x == 0 ? center.x : octantMax.x;
+    min.y = y == 0 ? octantMin.y : center.y;
+    max.y = y == 0 ? center.y : octantMax.y;
+    min.z = z == 0 ? octantMin.z : center.z;
+    max.z = z == 0 ? center.z : octantMax.z;
+
+    b -> setExtents( min, max );
 }
 
 WireBoundingBox* Octree::getWireBoundingBox()
@@ -299,6 +299,9 @@ OctreeSceneManager::OctreeSceneManager(const String& name) : SceneManager(name)
     AxisAlignedBox b( -10000, -10000, -10000, 10000, 10000, 10000 );
     int depth = 8; 
     mOctree = 0;
+    mLoose = false;
+    mLooseness = 2;
+    mNumReinsertions = 0;
     init( b, depth );
 }
 
@@ -306,6 +309,9 @@ OctreeSceneManager::OctreeSceneManager(const String& name, AxisAlignedBox &box,
 : SceneManager(name)
 {
     mOctree = 0;
+    mLoose = false;
+    mLooseness = 2;
+    mNumReinsertions = 0;
     init( box, max_depth );
 }
 
@@ -321,6 +327,17 @@ void OctreeSceneManager::init( AxisAlignedBox &box, int depth )
         delete mOctree;
 
     mOctree = new Octree( 0 );
+    mOctree -> mLooseness = mLoose ? mLooseness : 2;
+    // Destroyed nodes have already left the queue, but nodes which survive 
+    // the scene, such as the root node, must not think they are still in it
+    std::vector<OctreeNode*>::iterator it, itend;
+    itend = mReinsertQueue.end();
+    for ( it = mReinsertQueue.begin(); it != itend; ++it )
+    {
+        ( *it ) -> _setReinsertQueueIndex( OctreeNode::NOT_QUEUED );
+        ( *it ) -> setOctant( 0 );
+    }
+    mReinsertQueue.clear();
 
     mMaxDepth = depth;
     mBox = box;
@@ -394,6 +411,8 @@ bool OctreeSceneManager::getOptionKeys( StringVector & refKeys )
     refKeys.push_back( "Size" );
     refKeys.push_back( "ShowOctree" );
     refKeys.push_back( "Depth" );
+    refKeys.push_back( "LooseOctree" );
+    refKeys.push_back( "Looseness" );
 
     return true;
 }
@@ -410,6 +429,38 @@ void OctreeSceneManager::_updateOctreeNode( OctreeNode * onode )
 	if (!mOctree)
 		return;
 
+    if ( _isUpdatingSceneGraphInParallel() )
+    {
+        // Nodes are being updated from several threads
+        OGRE_LOCK_MUTEX(mOctreeUpdateMutex)
+        placeOctreeNode( onode, box );
+    }
+    else
+    {
+        placeOctreeNode( onode, box );
+    }
+}
+
+void OctreeSceneManager::placeOctreeNode( OctreeNode * onode, const AxisAlignedBox& box )
+{
+    if ( mLoose )
+    {
+        // Stay in the octant while within its culling bounds, or while still
+        // outside the octree altogether
+        Octree * oct = onode -> getOctant();
+        if ( oct != 0 && ( oct -> _isInCullBounds( box ) ||
+            ( oct == mOctree && ! mOctree -> _isInCullBounds( box ) ) ) )
+            return ;
+
+        // Leave the move to _reinsertQueuedNodes
+        if ( onode -> _getReinsertQueueIndex() == OctreeNode::NOT_QUEUED )
+        {
+            onode -> _setReinsertQueueIndex( mReinsertQueue.size() );
+            mReinsertQueue.push_back( onode );
+        }
+        return ;
+    }
+
     if ( onode -> getOctant() == 0 )
     {
         //if outside the octree, force into the root node.
@@ -423,6 +474,7 @@ void OctreeSceneManager::_updateOctreeNode( OctreeNode * onode )
     if ( ! onode -> _isIn( onode -> getOctant() -> mBox ) )
     {
         _removeOctreeNode( onode );
+        ++mNumReinsertions;
 
         //if outside the octree, force into the root node.
         if ( ! onode -> _isIn( mOctree -> mBox ) )
@@ -448,6 +500,53 @@ void OctreeSceneManager::_removeOctreeNode( OctreeNode * n )
     }
 
     n->setOctant(0);
+    dequeueReinsert( n );
+}
+
+void OctreeSceneManager::dequeueReinsert( OctreeNode * n )
+{
+    size_t index = n -> _getReinsertQueueIndex();
+    if ( index == OctreeNode::NOT_QUEUED )
+        return ;
+
+    // Move the last node into the gap
+    OctreeNode * last = mReinsertQueue.back();
+    mReinsertQueue[ index ] = last;
+    last -> _setReinsertQueueIndex( index );
+    mReinsertQueue.pop_back();
+    n -> _setReinsertQueueIndex( OctreeNode::NOT_QUEUED );
+}
+
+void OctreeSceneManager::_reinsertQueuedNodes( void )
+{
+    if ( mReinsertQueue.empty() || !mOctree )
+        return ;
+
+    std::vector<OctreeNode*>::iterator it, itend;
+    itend = mReinsertQueue.end();
+    for ( it = mReinsertQueue.begin(); it != itend; ++it )
+    {
+        OctreeNode * on = *it;
+        on -> _setReinsertQueueIndex( OctreeNode::NOT_QUEUED );
+
+        // Nodes which lost their bounds since being queued stay where they are
+        const AxisAlignedBox& box = on -> _getWorldAABB();
+        if ( box.isNull() )
+            continue;
+
+        if ( on -> getOctant() )
+        {
+            on -> getOctant() -> _removeNode( on );
+            ++mNumReinsertions;
+        }
+
+        //if outside the octree, force into the root node.
+        if ( ! mOctree -> _isInCullBounds( box ) )
+            mOctree -> _addNode( on );
+        else
+            _addOctreeNode( on, mOctree );
+    }
+    mReinsertQueue.clear();
 }
 
 
@@ -463,56 +562,25 @@ void OctreeSceneManager::_addOctreeNode( OctreeNode * n, Octree *octant, int dep
 
     //if the octree is twice as big as the scene node,
     //we will add it to a child.
-    if ( ( depth < mMaxDepth ) && octant -> _isTwiceSize( bx ) )
+    if ( ( depth < mMaxDepth ) && ( mLoose || octant -> _isTwiceSize( bx ) ) )
     {
         int x, y, z;
         octant -> _getChildIndexes( bx, &x, &y, &z );
 
-        if ( octant -> mChildren[ x ][ y ][ z ] == 0 )
+        // A loose octree only goes down while the node fits within the
+        // culling bounds of the child
+        if ( mLoose && ! octant -> _isInChildCullBounds( x, y, z, bx ) )
         {
-            octant -> mChildren[ x ][ y ][ z ] = new Octree( octant );
-            const Vector3& octantMin = octant -> mBox.getMinimum();
-            const Vector3& octantMax = octant -> mBox.getMaximum();
-            Vector3 min, max;
-
-            if ( x == 0 )
-            {
-                min.x = octantMin.x;
-                max.x = ( octantMin.x + octantMax.x ) / 2;
-            }
-
-            else
-            {
-                min.x = ( octantMin.x + octantMax.x ) / 2;
-                max.x = octantMax.x;
-            }
-
-            if ( y == 0 )
-            {
-                min.y = octantMin.y;
-                max.y = ( octantMin.y + octantMax.y ) / 2;
-            }
-
-            else
-            {
-                min.y = ( octantMin.y + octantMax.y ) / 2;
-                max.y = octantMax.y;
-            }
-
-            if ( z == 0 )
-            {
-                min.z = octantMin.z;
-                max.z = ( octantMin.z + octantMax.z ) / 2;
-            }
-
-            else
-            {
-                min.z = ( octantMin.z + octantMax.z ) / 2;
-                max.z = octantMax.z;
-            }
+            octant -> _addNode( n );
+            return ;
+        }
 
-            octant -> mChildren[ x ][ y ][ z ] -> mBox.setExtents( min, max );
-            octant -> mChildren[ x ][ y ][ z ] -> mHalfSize = ( max - min ) / 2;
+        if ( octant -> mChildren[ x ][ y ][ z ] == 0 )
+        {
+            Octree * child = new Octree( octant );
+            octant -> _getChildBox( x, y, z, &child -> mBox );
+            child -> mHalfSize = ( child -> mBox.getMaximum() - child -> mBox.getMinimum() ) / 2;
+            octant -> mChildren[ x ][ y ][ z ] = child;
         }
 
         _addOctreeNode( n, octant -> mChildren[ x ][ y ][ z ], ++depth );
@@ -538,7 +606,9 @@ SceneNode * OctreeSceneManager::createSceneNodeImpl( const String &name )
 
 void OctreeSceneManager::_updateSceneGraph( Camera * cam )
 {
+    mNumReinsertions = 0;
     SceneManager::_updateSceneGraph( cam );
+    _reinsertQueuedNodes();
 }
 
 void OctreeSceneManager::_alertVisibleObjects( void )
@@ -561,6 +631,9 @@ void OctreeSceneManager::_findVisibleObjects(Camera * cam,
 	VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters )
 {
 
+    // Nodes may have been moved since the scene graph update
+    _reinsertQueuedNodes();
+
     getRenderQueue()->clear();
     mBoxes.clear();
     mVisible.clear();
@@ -615,24 +688,36 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
     {
 
         //Add stuff to be rendered;
-        NodeList::iterator it = octant -> mNodes.begin();
+        OctantNodeList::iterator it = octant -> mNodes.begin();
 
         if ( mShowBoxes )
         {
             mBoxes.push_back( octant->getWireBoundingBox() );
         }
 
+        // if this octree is partially visible, manually cull all
+        // scene nodes attached directly to this level, all at once.
+        // The results must be used before walking the children, which
+        // reuse the scratch space.
+        if ( v == OctreeCamera::PARTIAL && !octant -> mNodes.empty() )
+        {
+            mCullBounds.clear();
+            for ( ; it != octant -> mNodes.end(); ++it )
+                mCullBounds.push_back( ( *it ) -> _getWorldAABB() );
+            mCullVisibility.resize( ( mCullBounds.size() + 31 ) / 32 );
+            camera -> isVisible( &mCullBounds[ 0 ], mCullBounds.size(), &mCullVisibility[ 0 ] );
+            it = octant -> mNodes.begin();
+        }
+
         bool vis = true;
+        size_t index = 0;
 
         while ( it != octant -> mNodes.end() )
         {
             OctreeNode * sn = *it;
 
-            // if this octree is partially visible, manually cull all
-            // scene nodes attached directly to this level.
-
             if ( v == OctreeCamera::PARTIAL )
-                vis = camera -> isVisible( sn -> _getWorldAABB() );
+                vis = ( mCullVisibility[ index >> 5 ] & ( 1u << ( index & 31 ) ) ) != 0;
 
             if ( vis )
             {
@@ -651,6 +736,7 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
             }
 
             ++it;
+            ++index;
         }
 
         Octree* child;
@@ -701,7 +787,7 @@ void _findNodes( const AxisAlignedBox &t, std::list < SceneNode * > &list, Scene
 	}
 
 
-	NodeList::iterator it = octant -> mNodes.begin();
+	OctantNodeList::iterator it = octant -> mNodes.begin();
 
 	while ( it != octant -> mNodes.end() )
 	{
@@ -774,7 +860,7 @@ void _findNodes( const Sphere &t, std::list < SceneNode * > &list, SceneNode *ex
 	}
 
 
-	NodeList::iterator it = octant -> mNodes.begin();
+	OctantNodeList::iterator it = octant -> mNodes.begin();
 
 	while ( it != octant -> mNodes.end() )
 	{
@@ -848,7 +934,7 @@ void _findNodes( const PlaneBoundedVolume &t, std::list < SceneNode * > &list, S
 	}
 
 
-	NodeList::iterator it = octant -> mNodes.begin();
+	OctantNodeList::iterator it = octant -> mNodes.begin();
 
 	while ( it != octant -> mNodes.end() )
 	{
@@ -921,7 +1007,7 @@ void _findNodes( const Ray &t, std::list < SceneNode * > &list, SceneNode *exclu
 	}
 
 
-	NodeList::iterator it = octant -> mNodes.begin();
+	OctantNodeList::iterator it = octant -> mNodes.begin();
 
 	while ( it != octant -> mNodes.end() )
 	{
@@ -979,21 +1065,25 @@ void _findNodes( const Ray &t, std::list < SceneNode * > &list, SceneNode *exclu
 
 void OctreeSceneManager::findNodesIn( const AxisAlignedBox &box, std::list < SceneNode * > &list, SceneNode *exclude )
 {
+    _reinsertQueuedNodes();
     _findNodes( box, list, exclude, false, mOctree );
 }
 
 void OctreeSceneManager::findNodesIn( const Sphere &sphere, std::list < SceneNode * > &list, SceneNode *exclude )
 {
+    _reinsertQueuedNodes();
     _findNodes( sphere, list, exclude, false, mOctree );
 }
 
 void OctreeSceneManager::findNodesIn( const PlaneBoundedVolume &volume, std::list < SceneNode * > &list, SceneNode *exclude )
 {
+    _reinsertQueuedNodes();
     _findNodes( volume, list, exclude, false, mOctree );
 }
 
 void OctreeSceneManager::findNodesIn( const Ray &r, std::list < SceneNode * > &list, SceneNode *exclude )
 {
+    _reinsertQueuedNodes();
     _findNodes( r, list, exclude, false, mOctree );
 }
 
@@ -1008,6 +1098,7 @@ void OctreeSceneManager::resize( const AxisAlignedBox &box )
 
     mOctree = new Octree( 0 );
     mOctree->mBox = box;
+    mOctree->mLooseness = mLoose ? mLooseness : 2;
 
 	const Vector3 min = box.getMinimum();
 	const Vector3 max = box.getMaximum();
@@ -1023,6 +1114,28 @@ void OctreeSceneManager::resize( const AxisAlignedBox &box )
         ++it;
     }
 
+    _reinsertQueuedNodes();
+}
+
+void OctreeSceneManager::setLooseOctree( bool b )
+{
+    if ( b == mLoose )
+        return ;
+
+    mLoose = b;
+    // copy the box since resize will delete mOctree and reference won't work
+    AxisAlignedBox box = mOctree->mBox;
+    resize( box );
+}
+
+void OctreeSceneManager::setLooseness( Real looseness )
+{
+    mLooseness = std::max( looseness, Real( 1 ) );
+    if ( mLoose )
+    {
+        AxisAlignedBox box = mOctree->mBox;
+        resize( box );
+    }
 }
 
 bool OctreeSceneManager::setOption( const String & key, const void * val )
@@ -1048,6 +1161,18 @@ bool OctreeSceneManager::setOption( const String & key, const void * val )
         return true;
     }
 
+    else if ( key == "LooseOctree" )
+    {
+        setLooseOctree( * static_cast < const bool * > ( val ) );
+        return true;
+    }
+
+    else if ( key == "Looseness" )
+    {
+        setLooseness( * static_cast < const Real * > ( val ) );
+        return true;
+    }
+
 
     return SceneManager::setOption( key, val );
 
@@ -1076,6 +1201,24 @@ bool OctreeSceneManager::getOption( const String & key, void *val )
         return true;
     }
 
+    else if ( key == "LooseOctree" )
+    {
+        * static_cast < bool * > ( val ) = mLoose;
+        return true;
+    }
+
+    else if ( key == "Looseness" )
+    {
+        * static_cast < Real * > ( val ) = mLooseness;
+        return true;
+    }
+
+    else if ( key == "Reinsertions" )
+    {
+        * static_cast < size_t * > ( val ) = mNumReinsertions;
+        return true;
+    }
+
 
     return SceneManager::getOption( key, val );
 
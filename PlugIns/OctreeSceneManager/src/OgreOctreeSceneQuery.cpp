@@ -41,6 +41,7 @@ email                : janders@users.sf.net
 #include <OgreOctreeSceneManager.h>
 #include <OgreEntity.h>
 #include <OgreRoot.h>
+#include <OgreSceneQueryBVH.h>
 
 namespace Ogre
 {
@@ -134,6 +135,13 @@ OctreeAxisAlignedBoxSceneQuery::~OctreeAxisAlignedBoxSceneQuery()
 /** Finds any entities that intersect the AAB for the query. */
 void OctreeAxisAlignedBoxSceneQuery::execute(SceneQueryListener* listener)
 {
+    SceneQueryBVH* bvh = mParentSceneMgr->_getSceneQueryBVH();
+    if (bvh)
+    {
+        bvh->boxQuery(mAABB, mQueryMask, mQueryTypeMask, listener);
+        return;
+    }
+
     std::list < SceneNode * > list;
     //find the nodes that intersect the AAB
     static_cast<OctreeSceneManager*>( mParentSceneMgr ) -> findNodesIn( mAABB, list, 0 );
@@ -185,6 +193,13 @@ OctreeRaySceneQuery::~OctreeRaySceneQuery()
 //---------------------------------------------------------------------
 void OctreeRaySceneQuery::execute(RaySceneQueryListener* listener)
 {
+    SceneQueryBVH* bvh = mParentSceneMgr->_getSceneQueryBVH();
+    if (bvh)
+    {
+        bvh->rayQuery(mRay, mQueryMask, mQueryTypeMask, listener);
+        return;
+    }
+
     std::list < SceneNode * > list;
     //find the nodes that intersect the AAB
     static_cast<OctreeSceneManager*>( mParentSceneMgr ) -> findNodesIn( mRay, list, 0 );
@@ -244,6 +259,13 @@ OctreeSphereSceneQuery::~OctreeSphereSceneQuery()
 //---------------------------------------------------------------------
 void OctreeSphereSceneQuery::execute(SceneQueryListener* listener)
 {
+    SceneQueryBVH* bvh = mParentSceneMgr->_getSceneQueryBVH();
+    if (bvh)
+    {
+        bvh->sphereQuery(mSphere, mQueryMask, mQueryTypeMask, listener, false);
+        return;
+    }
+
     std::list < SceneNode * > list;
     //find the nodes that intersect the AAB
     static_cast<OctreeSceneManager*>( mParentSceneMgr ) -> findNodesIn( mSphere, list, 0 );
@@ -971,6 +971,12 @@ namespace Ogre
 
     }
     //-------------------------------------------------------------------------
+    void TerrainRaySceneQuery::executeBatch(const RayList& rays, 
+        RaySceneQueryResultList& results)
+    {
+        RaySceneQuery::executeBatch(rays, results);
+    }
+    //-------------------------------------------------------------------------
     MaterialPtr& TerrainSceneManager::getTerrainMaterial(void)
     {
         return mOptions.terrainMaterial;
@@ -78,6 +78,10 @@ namespace Ogre
 
 		/* Overridden isVisible function for aabb */
 		virtual bool isVisible( const AxisAlignedBox &bound, FrustumPlane *culledBy=0) const;
+		/* Overridden batch isVisible function for aabbs, which checks the extra culling planes too */
+		virtual void isVisible( const AxisAlignedBox *bounds, size_t count, uint32 *visibility) const;
+		/* Sphere versions are not overridden */
+		using Camera::isVisible;
 
         /* isVisible() function for portals */
         bool isVisible (Portal * portal, FrustumPlane *culledBy = 0);
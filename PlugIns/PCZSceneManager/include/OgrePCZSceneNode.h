@@ -81,6 +81,7 @@ namespace Ogre
                                        bool onlyShadowCasters, 
                                        VisibleObjectsBoundsInfo* visibleBounds );
 		virtual void _update(bool updateChildren, bool parentHasChanged);
+		virtual void _transformStoreUpdateComplete(bool moved);
 		void		savePrevPosition(void);
 		Vector3&	getPrevPosition(void) {return mPrevPosition;}
 		unsigned long		getLastVisibleFrame(void) {return mLastVisibleFrame;}
@@ -81,6 +81,10 @@ namespace Ogre
 
         /** See RayScenQuery. */
         void execute(RaySceneQueryListener* listener);
+        /** See RaySceneQuery; executes the query for each ray in turn, 
+            starting each one from the start zone and skipping the exclude
+            node which were set before the batch. */
+        void executeBatch(const RayList& rays, RaySceneQueryResultList& results);
 
 		/** set the zone to start the scene query */
         void setStartZone(PCZone * startZone) {mStartZone = startZone;}
@@ -89,6 +89,18 @@ namespace Ogre
 		return true;
    }
 
+	void PCZCamera::isVisible( const AxisAlignedBox *bounds, size_t count, uint32 *visibility) const
+	{
+		// the extra culling frustum is not a plain plane set, so test the
+		// boxes one by one
+		memset(visibility, 0, ((count + 31) / 32) * sizeof(uint32));
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (isVisible(bounds[i]))
+				visibility[i >> 5] |= 1u << (i & 31);
+		}
+	}
+
 	/* A 'more detailed' check for visibility of an AAB.  This function returns
 	  none, partial, or full for visibility of the box.  This is useful for 
 	  stuff like Octree leaf culling */
@@ -94,6 +94,13 @@ namespace Ogre
 		mPrevPosition = mNewPosition;
 		mNewPosition = _getDerivedPosition();   // do this way since _update is called through SceneManager::_updateSceneGraph which comes before PCZSceneManager::_updatePCZSceneNodes
 	}
+	void PCZSceneNode::_transformStoreUpdateComplete(bool moved)
+	{
+		SceneNode::_transformStoreUpdateComplete(moved);
+
+		mPrevPosition = mNewPosition;
+		mNewPosition = _getDerivedPosition();
+	}
 	PCZone* PCZSceneNode::getHomeZone(void)
 	{
 		return mHomeZone;
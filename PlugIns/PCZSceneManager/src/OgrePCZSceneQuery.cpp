@@ -235,6 +235,30 @@ namespace Ogre
         mStartZone = 0;
         mExcludeNode = 0;
     }
+    //---------------------------------------------------------------------
+    void PCZRaySceneQuery::executeBatch(const RayList& rays, 
+        RaySceneQueryResultList& results)
+    {
+        // execute resets the start zone and exclude node, so restore them
+        // for each ray
+        PCZone* startZone = mStartZone;
+        SceneNode* excludeNode = mExcludeNode;
+        results.resize(rays.size());
+        Ray savedRay = mRay;
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            setRay(rays[i]);
+            mStartZone = startZone;
+            mExcludeNode = excludeNode;
+            RaySceneQuery::execute();
+            // Hand over the results; execute clears what we get back
+            results[i].swap(mResult);
+        }
+        setRay(savedRay);
+        mResult.clear();
+        mStartZone = 0;
+        mExcludeNode = 0;
+    }
 
 
     //---------------------------------------------------------------------
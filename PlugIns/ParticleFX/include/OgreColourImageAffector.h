@@ -58,6 +58,9 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        void _affectParticleBatch(Particle* const* particles, size_t count, Real timeElapsed);
+
 		void setImageAdjust(String name);
 		String getImageAdjust(void) const;
         
@@ -74,6 +74,9 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        void _affectParticleBatch(Particle* const* particles, size_t count, Real timeElapsed);
+
 		void setColourAdjust(size_t index, ColourValue colour);
 		ColourValue getColourAdjust(size_t index) const;
         
@@ -77,6 +77,9 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        void _affectParticleBatch(Particle* const* particles, size_t count, Real timeElapsed);
+
         /** Sets the plane point of the deflector plane. */
         void setPlanePoint(const Vector3& pos);
 
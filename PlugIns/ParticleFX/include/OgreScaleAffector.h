@@ -59,6 +59,9 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        void _affectParticleBatch(Particle* const* particles, size_t count, Real timeElapsed);
+
         /** Sets the scale adjustment to be made per second to particles. 
         @param Rate
             Sets the adjustment to be made to the x and y scale components per second. These
@@ -70,8 +70,13 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ColourFaderAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        ParticleIterator pi = pSystem->_getIterator();
-        Particle *p;
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void ColourFaderAffector::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
+    {
         float dr, dg, db, da;
 
         // Scale adjustments by time
@@ -80,13 +85,13 @@ namespace Ogre {
         db = mBlueAdj * timeElapsed;
         da = mAlphaAdj * timeElapsed;
 
-        while (!pi.end())
+        for (size_t i = 0; i < count; ++i)
         {
-            p = pi.getNext();
-            applyAdjustWithClamp(&p->colour.r, dr);
-            applyAdjustWithClamp(&p->colour.g, dg);
-            applyAdjustWithClamp(&p->colour.b, db);
-            applyAdjustWithClamp(&p->colour.a, da);
+            ColourValue& colour = particles[i]->colour;
+            applyAdjustWithClamp(&colour.r, dr);
+            applyAdjustWithClamp(&colour.g, dg);
+            applyAdjustWithClamp(&colour.b, db);
+            applyAdjustWithClamp(&colour.a, da);
         }
 
     }
@@ -101,8 +101,13 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ColourFaderAffector2::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        ParticleIterator pi = pSystem->_getIterator();
-        Particle *p;
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void ColourFaderAffector2::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
+    {
         float dr1, dg1, db1, da1;
 		float dr2, dg2, db2, da2;
 
@@ -118,23 +123,24 @@ namespace Ogre {
 		db2 = mBlueAdj2  * timeElapsed;
 		da2 = mAlphaAdj2 * timeElapsed;
 
-        while (!pi.end())
+        for (size_t i = 0; i < count; ++i)
         {
-			p = pi.getNext();
+            Particle* p = particles[i];
+            ColourValue& colour = p->colour;
 
 			if( p->timeToLive > StateChangeVal )
 			{
-				applyAdjustWithClamp(&p->colour.r, dr1);
-				applyAdjustWithClamp(&p->colour.g, dg1);
-				applyAdjustWithClamp(&p->colour.b, db1);
-				applyAdjustWithClamp(&p->colour.a, da1);
+				applyAdjustWithClamp(&colour.r, dr1);
+				applyAdjustWithClamp(&colour.g, dg1);
+				applyAdjustWithClamp(&colour.b, db1);
+				applyAdjustWithClamp(&colour.a, da1);
 			}
 			else
 			{
-				applyAdjustWithClamp(&p->colour.r, dr2);
-				applyAdjustWithClamp(&p->colour.g, dg2);
-				applyAdjustWithClamp(&p->colour.b, db2);
-				applyAdjustWithClamp(&p->colour.a, da2);
+				applyAdjustWithClamp(&colour.r, dr2);
+				applyAdjustWithClamp(&colour.g, dg2);
+				applyAdjustWithClamp(&colour.b, db2);
+				applyAdjustWithClamp(&colour.a, da2);
 			}
         }
 
@@ -66,9 +66,13 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ColourImageAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        Particle*			p;
-		ParticleIterator	pi				= pSystem->_getIterator();
-
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void ColourImageAffector::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
+    {
         if (!mColourImageLoaded)
         {
             _loadImage();
@@ -76,9 +80,9 @@ namespace Ogre {
 
 		int				   width			= mColourImage.getWidth()  - 1;
         
-		while (!pi.end())
+		for (size_t i = 0; i < count; ++i)
 		{
-			p = pi.getNext();
+			Particle*		p				= particles[i];
 			const Real		life_time		= p->totalTimeToLive;
 			Real			particle_time	= 1.0f - (p->timeToLive / life_time); 
 
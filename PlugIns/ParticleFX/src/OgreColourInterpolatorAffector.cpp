@@ -77,13 +77,16 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ColourInterpolatorAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        Particle*			p;
-		ParticleIterator	pi				= pSystem->_getIterator();
-
-
-		while (!pi.end())
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void ColourInterpolatorAffector::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
+    {
+		for (size_t n = 0; n < count; ++n)
         {
-            p = pi.getNext();
+            Particle*		p				= particles[n];
 			const Real		life_time		= p->totalTimeToLive;
 			Real			particle_time	= 1.0f - (p->timeToLive / life_time); 
 
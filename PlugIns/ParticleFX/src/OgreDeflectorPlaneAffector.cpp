@@ -69,17 +69,21 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     void DeflectorPlaneAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
+    {
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void DeflectorPlaneAffector::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
     {
         // precalculate distance of plane from origin
         Real planeDistance = - mPlaneNormal.dotProduct(mPlanePoint) / Math::Sqrt(mPlaneNormal.dotProduct(mPlaneNormal));
 		Vector3 directionPart;
 
-        ParticleIterator pi = pSystem->_getIterator();
-        Particle *p;
-
-        while (!pi.end())
+        for (size_t i = 0; i < count; ++i)
         {
-            p = pi.getNext();
+            Particle* p = particles[i];
 
             Vector3 direction(p->direction * timeElapsed);
             if (mPlaneNormal.dotProduct(p->position + direction) + planeDistance <= 0.0)
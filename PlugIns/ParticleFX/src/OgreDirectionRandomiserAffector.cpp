@@ -70,13 +70,18 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void DirectionRandomiserAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        ParticleIterator pi = pSystem->_getIterator();
-        Particle *p;
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void DirectionRandomiserAffector::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
+    {
         Real length;
 
-        while (!pi.end())
+        for (size_t i = 0; i < count; ++i)
         {
-            p = pi.getNext();
+            Particle* p = particles[i];
             if (mScope > Math::UnitRandom())
             {
                 if (!p->direction.isZeroLength())
@@ -69,28 +69,31 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void LinearForceAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        ParticleIterator pi = pSystem->_getIterator();
-        Particle *p;
-
-        Vector3 scaledVector;
-
-        // Precalc scaled force for optimisation
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void LinearForceAffector::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
+    {
+        // Choose the application once, so each loop body is a plain 
+        // multiply-add over the array
         if (mForceApplication == FA_ADD)
         {
-            // Scale force by time
-            scaledVector = mForceVector * timeElapsed;
-        }
-
-        while (!pi.end())
-        {
-            p = pi.getNext();
-            if (mForceApplication == FA_ADD)
+            // Precalc force scaled by time for optimisation
+            const Vector3 scaledVector = mForceVector * timeElapsed;
+            for (size_t i = 0; i < count; ++i)
             {
-                p->direction += scaledVector;
+                particles[i]->direction += scaledVector;
             }
-            else // FA_AVERAGE
+        }
+        else // FA_AVERAGE
+        {
+            const Vector3 halfForce = mForceVector * 0.5f;
+            for (size_t i = 0; i < count; ++i)
             {
-                p->direction = (p->direction + mForceVector) / 2;
+                Vector3& dir = particles[i]->direction;
+                dir = dir * 0.5f + halfForce;
             }
         }
         
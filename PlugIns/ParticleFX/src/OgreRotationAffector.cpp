@@ -89,21 +89,20 @@ namespace Ogre {
 	//-----------------------------------------------------------------------
     void RotationAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        ParticleIterator pi = pSystem->_getIterator();
-        Particle *p;
-        Real ds;
-
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void RotationAffector::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
+    {
         // Rotation adjustments by time
-        ds = timeElapsed;
-
-		Radian NewRotation;
+        Real ds = timeElapsed;
 
-        while (!pi.end())
+        for (size_t i = 0; i < count; ++i)
         {
-            p = pi.getNext();
-
-			NewRotation = p->rotation + (ds * p->rotationSpeed);
-			p->setRotation( NewRotation );
+            Particle* p = particles[i];
+			p->setRotation( p->rotation + (ds * p->rotationSpeed) );
         }
 
     }
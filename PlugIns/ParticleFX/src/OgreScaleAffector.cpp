@@ -57,31 +57,32 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ScaleAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        ParticleIterator pi = pSystem->_getIterator();
-        Particle *p;
-        Real ds;
-
+        _affectParticleBatch(pSystem->_getActiveParticles(), 
+            pSystem->getNumParticles(), timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void ScaleAffector::_affectParticleBatch(Particle* const* particles, 
+        size_t count, Real timeElapsed)
+    {
         // Scale adjustments by time
-        ds = mScaleAdj * timeElapsed;
+        Real ds = mScaleAdj * timeElapsed;
 
-		Real NewWide, NewHigh;
+        // Particles without their own dimensions all get the same new size
+        Real defaultWide = mParent->getDefaultWidth() + ds;
+        Real defaultHigh = mParent->getDefaultHeight() + ds;
 
-        while (!pi.end())
+        for (size_t i = 0; i < count; ++i)
         {
-            p = pi.getNext();
+            Particle* p = particles[i];
 
 			if( p->hasOwnDimensions() == false )
 			{
-            	NewWide = pSystem->getDefaultWidth() + ds;
-	            NewHigh = pSystem->getDefaultHeight() + ds;
-
+				p->setDimensions( defaultWide, defaultHigh );
 			}
 			else
 			{
-            	NewWide = p->getOwnWidth()  + ds;
-            	NewHigh = p->getOwnHeight() + ds;
+				p->setDimensions( p->getOwnWidth() + ds, p->getOwnHeight() + ds );
 			}
-			p->setDimensions( NewWide, NewHigh ); 
         }
 
     }
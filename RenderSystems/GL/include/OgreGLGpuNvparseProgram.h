@@ -49,7 +49,7 @@ public:
     /// Execute the unbinding functions for this program
     void unbindProgram(void);
     /// Execute the param binding functions for this program
-    void bindProgramParameters(GpuProgramParametersSharedPtr params);
+    size_t bindProgramParameters(GpuProgramParametersSharedPtr params);
 
     /// Get the assigned GL program id
     const GLuint getProgramID(void) const
@@ -49,8 +49,10 @@ namespace Ogre {
         /// Execute the binding functions for this program
         virtual void unbindProgram(void) {}
 
-        /// Execute the param binding functions for this program
-        virtual void bindProgramParameters(GpuProgramParametersSharedPtr params) {}
+        /** Execute the param binding functions for this program
+        @returns The number of 4-component constants uploaded
+        */
+        virtual size_t bindProgramParameters(GpuProgramParametersSharedPtr params) { return 0; }
 		/// Bind just the pass iteration parameters
 		virtual void bindProgramPassIterationParameters(GpuProgramParametersSharedPtr params) {}
 
@@ -98,8 +100,13 @@ namespace Ogre {
         void bindProgram(void);
         /// Execute the unbinding functions for this program
         void unbindProgram(void);
-        /// Execute the param binding functions for this program
-        void bindProgramParameters(GpuProgramParametersSharedPtr params);
+        /** Execute the param binding functions for this program
+        @remarks
+            ARB program local parameters are kept by the program object, so
+            when the same parameters are bound again only the constants which
+            changed since the last bind are uploaded.
+        */
+        size_t bindProgramParameters(GpuProgramParametersSharedPtr params);
 		/// Bind just the pass iteration parameters
 		void bindProgramPassIterationParameters(GpuProgramParametersSharedPtr params);
 
@@ -112,6 +119,9 @@ namespace Ogre {
         /// @copydoc Resource::unloadImpl
         void unloadImpl(void);
 
+        /// The parameters last uploaded to the program's local parameters
+        const GpuProgramParameters* mLastBoundParams;
+
     };
 
 
@@ -63,6 +63,8 @@ namespace Ogre {
     protected:
 		/// @copydoc Texture::createInternalResourcesImpl
 		void createInternalResourcesImpl(void);
+        /// @copydoc Resource::prepareImpl
+        void prepareImpl(void);
         /// @copydoc Resource::loadImpl
         void loadImpl(void);
         /// @copydoc Resource::freeInternalResourcesImpl
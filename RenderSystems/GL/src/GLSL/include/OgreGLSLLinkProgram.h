@@ -71,6 +71,10 @@ namespace Ogre {
 		GLint		mLinked;
 		/// flag indicating skeletal animation is being performed
 		bool mSkeletalAnimation;
+		/// The vertex program parameters last uploaded to the uniforms
+		const GpuProgramParameters* mLastVertexParams;
+		/// The fragment program parameters last uploaded to the uniforms
+		const GpuProgramParameters* mLastFragmentParams;
 
 		/// build uniform references from active named uniforms
 		void buildGLUniformReferences(void);
@@ -106,8 +110,10 @@ namespace Ogre {
 		void activate(void);
 		/** updates program object uniforms using data from GpuProgramParamters.
 		normally called by GLSLGpuProgram::bindParameters() just before rendering occurs.
+		Only uniforms which changed since the same parameters were last passed in are set.
+		@returns The number of 4-component constants uploaded
 		*/
-		void updateUniforms(GpuProgramParametersSharedPtr params, GpuProgramType fromProgType);
+		size_t updateUniforms(GpuProgramParametersSharedPtr params, GpuProgramType fromProgType);
 		/** updates program object uniforms using data from pass iteration GpuProgramParamters.
 		normally called by GLSLGpuProgram::bindMultiPassParameters() just before multi pass rendering occurs.
 		*/
@@ -116,12 +116,12 @@ namespace Ogre {
 	}
 
 	//-----------------------------------------------------------------------------
-	void GLSLGpuProgram::bindProgramParameters(GpuProgramParametersSharedPtr params)
+	size_t GLSLGpuProgram::bindProgramParameters(GpuProgramParametersSharedPtr params)
 	{
 		// activate the link program object
 		GLSLLinkProgram* linkProgram = GLSLLinkProgramManager::getSingleton().getActiveLinkProgram();
 		// pass on parameters from params to program object uniforms
-		linkProgram->updateUniforms(params, mType);
+		return linkProgram->updateUniforms(params, mType);
 		
 	}
 
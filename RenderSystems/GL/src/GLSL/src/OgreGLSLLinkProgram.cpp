@@ -78,6 +78,8 @@ namespace Ogre {
 		, mFragmentProgram(fragmentProgram)
 		, mUniformRefsBuilt(false)
         , mLinked(false)
+		, mLastVertexParams(0)
+		, mLastFragmentParams(0)
 
 	{
 			checkForGLSLError( "GLSLLinkProgram::GLSLLinkProgram", "Error prior to Creating GLSL Program Object", 0 );
@@ -194,9 +196,27 @@ namespace Ogre {
 	}
 
 	//-----------------------------------------------------------------------
-	void GLSLLinkProgram::updateUniforms(GpuProgramParametersSharedPtr params, 
+	size_t GLSLLinkProgram::updateUniforms(GpuProgramParametersSharedPtr params, 
 		GpuProgramType fromProgType)
 	{
+		// The program object keeps its uniforms, so if these parameters were 
+		// the last ones set from this program type only the changes are needed
+		const GpuProgramParameters*& lastParams = (fromProgType == GPT_VERTEX_PROGRAM) ?
+			mLastVertexParams : mLastFragmentParams;
+		const void* binding = &lastParams;
+		if (lastParams != params.get())
+		{
+			params->_markAllDirty();
+			lastParams = params.get();
+		}
+
+		size_t floatStart, floatEnd, intStart, intEnd;
+		bool floatDirty = params->_getFloatDirtyRange(binding, floatStart, floatEnd);
+		bool intDirty = params->_getIntDirtyRange(binding, intStart, intEnd);
+		if (!floatDirty && !intDirty)
+			return 0;
+		size_t uploaded = 0;
+
 		// iterate through uniform reference list and update uniform values
 		GLUniformReferenceIterator currentUniform = mGLUniformReferences.begin();
 		GLUniformReferenceIterator endUniform = mGLUniformReferences.end();
@@ -209,6 +229,15 @@ namespace Ogre {
 			if (fromProgType == currentUniform->mSourceProgType)
 			{
 				const GpuConstantDefinition* def = currentUniform->mConstantDef;
+
+				// skip uniforms which have not changed
+				size_t defSize = def->elementSize * def->arraySize;
+				size_t dirtyStart = def->isFloat() ? floatStart : intStart;
+				size_t dirtyEnd = def->isFloat() ? floatEnd : intEnd;
+				if (def->physicalIndex >= dirtyEnd || def->physicalIndex + defSize <= dirtyStart)
+					continue;
+				uploaded += (defSize + 3) / 4;
+
 				GLsizei glArraySize = (GLsizei)def->arraySize;
 
 				// get the index in the parameter real list
@@ -319,6 +348,9 @@ namespace Ogre {
 			}
   
   		} // end for
+
+		params->_clearDirtyRanges(binding);
+		return uploaded;
 	}
 
 
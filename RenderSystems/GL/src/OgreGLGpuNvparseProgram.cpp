@@ -68,23 +68,25 @@ void GLGpuNvparseProgram::unbindProgram(void)
     glDisable(GL_PER_STAGE_CONSTANTS_NV);
 }
 
-void GLGpuNvparseProgram::bindProgramParameters(GpuProgramParametersSharedPtr params)
+size_t GLGpuNvparseProgram::bindProgramParameters(GpuProgramParametersSharedPtr params)
 {
     // NB, register combiners uses 2 constants per texture stage (0 and 1)
     // We have stored these as (stage * 2) + const_index in the physical buffer
 	// There are no other parameters in a register combiners shader
+	// The constants are colours, 4 floats each
 	const GpuProgramParameters::FloatConstantList& floatList = 
 		params->getFloatConstantList();
-	size_t index = 0;
-	for (GpuProgramParameters::FloatConstantList::const_iterator i = floatList.begin();
-		i != floatList.end(); ++i, ++index)
+	const size_t numConstants = floatList.size() / 4;
+	for (size_t index = 0; index < numConstants; ++index)
 	{
 		GLenum combinerStage = GL_COMBINER0_NV + (unsigned int)(index / 2);
 		GLenum pname = GL_CONSTANT_COLOR0_NV + (index % 2);
-		glCombinerStageParameterfvNV(combinerStage, pname, &(*i));
+		glCombinerStageParameterfvNV(combinerStage, pname, &floatList[index * 4]);
 		
 	}
 
+	// Per-stage constants are global state, so all of them are uploaded
+	return numConstants;
 }
 void GLGpuNvparseProgram::unloadImpl(void)
 {
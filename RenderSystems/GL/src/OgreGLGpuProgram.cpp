@@ -130,6 +130,7 @@ GLArbGpuProgram::GLArbGpuProgram(ResourceManager* creator, const String& name,
     ResourceHandle handle, const String& group, bool isManual, 
     ManualResourceLoader* loader) 
     : GLGpuProgram(creator, name, handle, group, isManual, loader)
+    , mLastBoundParams(0)
 {
     glGenProgramsARB(1, &mProgramID);
 }
@@ -159,27 +160,54 @@ void GLArbGpuProgram::unbindProgram(void)
     glDisable(mProgramType);
 }
 
-void GLArbGpuProgram::bindProgramParameters(GpuProgramParametersSharedPtr params)
+size_t GLArbGpuProgram::bindProgramParameters(GpuProgramParametersSharedPtr params)
 {
     GLenum type = (mType == GPT_VERTEX_PROGRAM) ? 
         GL_VERTEX_PROGRAM_ARB : GL_FRAGMENT_PROGRAM_ARB;
-    
+
+	// Another parameters object may have overwritten the locals since these 
+	// parameters were last bound, in which case everything must be uploaded
+	const void* binding = &mLastBoundParams;
+	if (mLastBoundParams != params.get())
+	{
+		params->_markAllDirty();
+		mLastBoundParams = params.get();
+	}
+
 	// only supports float constants
+	size_t dirtyStart, dirtyEnd;
+	if (!params->_getFloatDirtyRange(binding, dirtyStart, dirtyEnd))
+		return 0;
+
 	const GpuLogicalBufferStruct* floatStruct = params->getFloatLogicalBufferStruct();
+	size_t uploaded = 0;
 
 	for (GpuLogicalIndexUseMap::const_iterator i = floatStruct->map.begin();
 		i != floatStruct->map.end(); ++i)
 	{
 		size_t logicalIndex = i->first;
-		const float* pFloat = params->getFloatPointer(i->second.physicalIndex);
+		size_t physicalIndex = i->second.physicalIndex;
+		// Skip entries wholly outside the changed range
+		if (physicalIndex >= dirtyEnd || 
+			physicalIndex + i->second.currentSize <= dirtyStart)
+			continue;
+
+		const float* pFloat = params->getFloatPointer(physicalIndex);
 		// Iterate over the params, set in 4-float chunks (low-level)
 		for (size_t j = 0; j < i->second.currentSize; j+=4)
 		{
-			glProgramLocalParameter4fvARB(type, logicalIndex, pFloat);
+			if (physicalIndex + j < dirtyEnd && physicalIndex + j + 4 > dirtyStart)
+			{
+				glProgramLocalParameter4fvARB(type, logicalIndex, pFloat);
+				++uploaded;
+			}
 			pFloat += 4;
 			++logicalIndex;
 		}
 	}
+
+	params->_clearDirtyRanges(binding);
+	return uploaded;
 }
 
 void GLArbGpuProgram::bindProgramPassIterationParameters(GpuProgramParametersSharedPtr params)
@@ -200,10 +228,13 @@ void GLArbGpuProgram::bindProgramPassIterationParameters(GpuProgramParametersSha
 void GLArbGpuProgram::unloadImpl(void)
 {
     glDeleteProgramsARB(1, &mProgramID);
+    mLastBoundParams = 0;
 }
 
 void GLArbGpuProgram::loadFromSource(void)
 {
+    // New program string, so no locals are known to be current
+    mLastBoundParams = 0;
     glBindProgramARB(mProgramType, mProgramID);
     glProgramStringARB(mProgramType, GL_PROGRAM_FORMAT_ASCII_ARB, (GLsizei)mSource.length(), mSource.c_str());
 
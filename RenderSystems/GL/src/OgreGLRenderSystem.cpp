@@ -812,6 +812,9 @@ namespace Ogre {
 
 	void GLRenderSystem::setShadingType(ShadeOptions so)
 	{
+		if (!filterStateChange(mStateCache.shading, so))
+			return;
+
 		switch(so)
 		{
 		case SO_FLAT:
@@ -1219,6 +1222,9 @@ namespace Ogre {
 	//---------------------------------------------------------------------
 	void GLRenderSystem::_setPointSpritesEnabled(bool enabled)
 	{
+		if (!filterStateChange(mStateCache.pointSprites, enabled))
+			return;
+
 		if (enabled)
 		{
 			glEnable(GL_POINT_SPRITE);
@@ -1242,6 +1248,16 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	void GLRenderSystem::_setTexture(size_t stage, bool enabled, const TexturePtr &texPtr)
 	{
+		TextureState texState;
+		texState.enabled = enabled;
+		texState.texture = enabled ? texPtr.get() : 0;
+		texState.stateCount = texState.texture ? texState.texture->getStateCount() : 0;
+		// An unloaded texture must be touched to reload it
+		if (texState.texture && !texState.texture->isLoaded())
+			mStateCache.textures[stage].valid = false;
+		if (!filterStateChange(mStateCache.textures[stage], texState))
+			return;
+
 		GLTexturePtr tex = texPtr;
 
 		GLenum lastTextureType = mTextureTypes[stage];
@@ -1253,6 +1269,8 @@ namespace Ogre {
 			{
 				// note used
 				tex->touch();
+				// touching may have loaded it
+				mStateCache.textures[stage].value.stateCount = tex->getStateCount();
 				mTextureTypes[stage] = tex->getGLTextureTarget();
 			}
 			else
@@ -1545,6 +1563,11 @@ namespace Ogre {
 
 	void GLRenderSystem::_setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor)
 	{
+		// glBlendFunc sets the alpha factors too
+		SceneBlendState blendState = { sourceFactor, destFactor, sourceFactor, destFactor };
+		if (!filterStateChange(mStateCache.sceneBlending, blendState))
+			return;
+
 		GLint sourceBlend = getBlendMode(sourceFactor);
 		GLint destBlend = getBlendMode(destFactor);
 		if(sourceFactor == SBF_ONE && destFactor == SBF_ZERO)
@@ -1562,6 +1585,10 @@ namespace Ogre {
 		SceneBlendFactor sourceFactor, SceneBlendFactor destFactor, 
 		SceneBlendFactor sourceFactorAlpha, SceneBlendFactor destFactorAlpha)
 	{
+		SceneBlendState blendState = { sourceFactor, destFactor, sourceFactorAlpha, destFactorAlpha };
+		if (!filterStateChange(mStateCache.sceneBlending, blendState))
+			return;
+
 		GLint sourceBlend = getBlendMode(sourceFactor);
 		GLint destBlend = getBlendMode(destFactor);
 		GLint sourceBlendAlpha = getBlendMode(sourceFactorAlpha);
@@ -1581,6 +1608,10 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	void GLRenderSystem::_setAlphaRejectSettings(CompareFunction func, unsigned char value)
 	{
+		AlphaRejectState alphaState = { func, value };
+		if (!filterStateChange(mStateCache.alphaReject, alphaState))
+			return;
+
 		if(func == CMPF_ALWAYS_PASS)
 		{
 			glDisable(GL_ALPHA_TEST);
@@ -1645,6 +1676,10 @@ namespace Ogre {
 
 		// Activate the viewport clipping
 		glEnable(GL_SCISSOR_TEST);
+
+		// Textures may have been created or updated since the last frame,
+		// which binds them to the active unit
+		invalidateTextureStateCache();
 	}
 
 	//-----------------------------------------------------------------------------
@@ -1668,6 +1703,9 @@ namespace Ogre {
 		// face for consistently. On the assumption that, we can't change the front
 		// face by glFrontFace anywhere.
 
+		if (!filterStateChange(mStateCache.cullingMode, mode))
+			return;
+
 		GLenum cullMode;
 
 		switch( mode )
@@ -1715,6 +1753,9 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	void GLRenderSystem::_setDepthBufferCheckEnabled(bool enabled)
 	{
+		if (!filterStateChange(mStateCache.depthCheck, enabled))
+			return;
+
 		if (enabled)
 		{
 			glClearDepth(1.0f);
@@ -1728,6 +1769,9 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	void GLRenderSystem::_setDepthBufferWriteEnabled(bool enabled)
 	{
+		if (!filterStateChange(mStateCache.depthWrite, enabled))
+			return;
+
 		GLboolean flag = enabled ? GL_TRUE : GL_FALSE;
 		glDepthMask( flag );  
 		// Store for reference in _beginFrame
@@ -1736,11 +1780,18 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	void GLRenderSystem::_setDepthBufferFunction(CompareFunction func)
 	{
+		if (!filterStateChange(mStateCache.depthFunction, func))
+			return;
+
 		glDepthFunc(convertCompareFunction(func));
 	}
 	//-----------------------------------------------------------------------------
 	void GLRenderSystem::_setDepthBias(float constantBias, float slopeScaleBias)
 	{
+		DepthBiasState biasState = { constantBias, slopeScaleBias };
+		if (!filterStateChange(mStateCache.depthBias, biasState))
+			return;
+
 		if (constantBias != 0 || slopeScaleBias != 0)
 		{
 			glEnable(GL_POLYGON_OFFSET_FILL);
@@ -1758,6 +1809,10 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	void GLRenderSystem::_setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha)
 	{
+		uint8 writeMask = (red ? 1 : 0) | (green ? 2 : 0) | (blue ? 4 : 0) | (alpha ? 8 : 0);
+		if (!filterStateChange(mStateCache.colourWrite, writeMask))
+			return;
+
 		glColorMask(red, green, blue, alpha);
 		// record this
 		mColourWrite[0] = red;
@@ -1774,6 +1829,9 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void GLRenderSystem::setLightingEnabled(bool enabled)
     {
+        if (!filterStateChange(mStateCache.lighting, enabled))
+            return;
+
         if (enabled) 
         {      
             glEnable(GL_LIGHTING);
@@ -1786,6 +1844,9 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void GLRenderSystem::_setFog(FogMode mode, const ColourValue& colour, Real density, Real start, Real end)
     {
+        FogState fogState = { mode, colour, density, start, end };
+        if (!filterStateChange(mStateCache.fog, fogState))
+            return;
 
         GLint fogMode;
         switch (mode)
@@ -1898,6 +1959,9 @@ namespace Ogre {
 
 	void GLRenderSystem::_setPolygonMode(PolygonMode level)
 	{
+		if (!filterStateChange(mStateCache.polygonMode, level))
+			return;
+
 		GLenum glmode;
 		switch(level)
 		{
@@ -1917,6 +1981,9 @@ namespace Ogre {
 	//---------------------------------------------------------------------
 	void GLRenderSystem::setStencilCheckEnabled(bool enabled)
 	{
+		if (!filterStateChange(mStateCache.stencilCheck, enabled))
+			return;
+
 		if (enabled)
 		{
 			glEnable(GL_STENCIL_TEST);
@@ -2735,25 +2802,31 @@ GL_RGB_SCALE : GL_ALPHA_SCALE, 1);
 		if (gptype == GPT_VERTEX_PROGRAM)
 		{
 			mActiveVertexGpuProgramParameters = params;
-			mCurrentVertexProgram->bindProgramParameters(params);
+			mConstantUploadCount += mCurrentVertexProgram->bindProgramParameters(params);
 		}
 		else
 		{
 			mActiveFragmentGpuProgramParameters = params;
-			mCurrentFragmentProgram->bindProgramParameters(params);
+			mConstantUploadCount += mCurrentFragmentProgram->bindProgramParameters(params);
 		}
 	}
 	//---------------------------------------------------------------------
 	void GLRenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
 	{
+		GpuProgramParametersSharedPtr params;
 		if (gptype == GPT_VERTEX_PROGRAM)
 		{
-			mCurrentVertexProgram->bindProgramPassIterationParameters(mActiveVertexGpuProgramParameters);
+			params = mActiveVertexGpuProgramParameters;
+			mCurrentVertexProgram->bindProgramPassIterationParameters(params);
 		}
 		else
 		{
-			mCurrentFragmentProgram->bindProgramPassIterationParameters(mActiveFragmentGpuProgramParameters);
+			params = mActiveFragmentGpuProgramParameters;
+			mCurrentFragmentProgram->bindProgramPassIterationParameters(params);
 		}
+		// a single constant, when the program has one
+		if (params->hasPassIterationNumber())
+			++mConstantUploadCount;
 	}
 	//---------------------------------------------------------------------
 	void GLRenderSystem::setClipPlanesImpl(const PlaneList& clipPlanes)
@@ -3054,6 +3127,9 @@ GL_RGB_SCALE : GL_ALPHA_SCALE, 1);
 		glColorMask(mColourWrite[0], mColourWrite[1], mColourWrite[2], mColourWrite[3]);
 		glStencilMask(mStencilMask);
 
+		// Everything else the new context holds is unknown
+		_invalidateStateCache();
+
 	}
 	//---------------------------------------------------------------------
 	void GLRenderSystem::_setRenderTarget(RenderTarget *target)
@@ -3064,6 +3140,11 @@ GL_RGB_SCALE : GL_ALPHA_SCALE, 1);
 
 		mActiveRenderTarget = target;
 
+		// Culling depends on whether the target flips textures, and unbinding
+		// a copying render texture binds that texture to the active unit
+		mStateCache.cullingMode.valid = false;
+		invalidateTextureStateCache();
+
 		// Switch context if different from current one
 		GLContext *newContext = 0;
 		target->getCustomAttribute("GLCONTEXT", &newContext);
@@ -236,6 +236,16 @@ namespace Ogre {
         createInternalResources();
     }
 	
+    void GLTexture::prepareImpl()
+    {
+        if (!(mUsage & TU_RENDERTARGET))
+        {
+            // Read and decode the images now, only the upload is left for loadImpl
+            prepareSourceImages();
+        }
+    }
+	//*************************************************************************
+	
     void GLTexture::loadImpl()
     {
         if( mUsage & TU_RENDERTARGET )
@@ -244,83 +254,7 @@ namespace Ogre {
         }
         else
         {
-			String baseName, ext;
-			size_t pos = mName.find_last_of(".");
-			baseName = mName.substr(0, pos);
-			if( pos != String::npos )
-				ext = mName.substr(pos+1);
-
-			if(mTextureType == TEX_TYPE_1D || mTextureType == TEX_TYPE_2D || 
-                mTextureType == TEX_TYPE_3D)
-            {
-                Image img;
-	            // find & load resource data intro stream to allow resource
-				// group changes if required
-				DataStreamPtr dstream = 
-					ResourceGroupManager::getSingleton().openResource(
-						mName, mGroup, true, this);
-
-                img.load(dstream, ext);
-
-				// If this is a cube map, set the texture type flag accordingly.
-                if (img.hasFlag(IF_CUBEMAP))
-					mTextureType = TEX_TYPE_CUBE_MAP;
-				// If this is a volumetric texture set the texture type flag accordingly.
-				if(img.getDepth() > 1)
-					mTextureType = TEX_TYPE_3D;
-
-				// Call internal _loadImages, not loadImage since that's external and 
-				// will determine load status etc again
-				ConstImagePtrList imagePtrs;
-				imagePtrs.push_back(&img);
-				_loadImages( imagePtrs );
-            }
-            else if (mTextureType == TEX_TYPE_CUBE_MAP)
-            {
-				if(getSourceFileType() == "dds")
-				{
-					// XX HACK there should be a better way to specify whether 
-					// all faces are in the same file or not
-					Image img;
-	            	// find & load resource data intro stream to allow resource
-					// group changes if required
-					DataStreamPtr dstream = 
-						ResourceGroupManager::getSingleton().openResource(
-							mName, mGroup, true, this);
-
-	                img.load(dstream, ext);
-					// Call internal _loadImages, not loadImage since that's external and 
-					// will determine load status etc again
-					ConstImagePtrList imagePtrs;
-					imagePtrs.push_back(&img);
-					_loadImages( imagePtrs );
-				}
-				else
-				{
-					std::vector<Image> images(6);
-					ConstImagePtrList imagePtrs;
-					static const String suffixes[6] = {"_rt", "_lf", "_up", "_dn", "_fr", "_bk"};
-	
-					for(size_t i = 0; i < 6; i++)
-					{
-						String fullName = baseName + suffixes[i];
-						if (!ext.empty())
-							fullName = fullName + "." + ext;
-		            	// find & load resource data intro stream to allow resource
-						// group changes if required
-						DataStreamPtr dstream = 
-							ResourceGroupManager::getSingleton().openResource(
-								fullName, mGroup, true, this);
-	
-						images[i].load(dstream, ext);
-						imagePtrs.push_back(&images[i]);
-					}
-	
-					_loadImages( imagePtrs );
-				}
-            }
-            else
-                OGRE_EXCEPT( Exception::ERR_NOT_IMPLEMENTED, "**** Unknown texture type ****", "GLTexture::load" );
+            loadPreparedImages();
         }
     }
 	
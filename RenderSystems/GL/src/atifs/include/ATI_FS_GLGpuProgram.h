@@ -50,7 +50,7 @@ namespace Ogre {
 		/// Execute the unbinding functions for this program
 		void unbindProgram(void);
 		/// Execute the param binding functions for this program
-		void bindProgramParameters(GpuProgramParametersSharedPtr params);
+		size_t bindProgramParameters(GpuProgramParametersSharedPtr params);
 		/** Execute the pass iteration param binding functions for this program.
             Only binds those parameters used for multipass rendering
         */
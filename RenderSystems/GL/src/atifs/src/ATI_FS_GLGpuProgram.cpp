@@ -66,11 +66,12 @@ void ATI_FS_GLGpuProgram::unbindProgram(void)
 }
 
 
-void ATI_FS_GLGpuProgram::bindProgramParameters(GpuProgramParametersSharedPtr params)
+size_t ATI_FS_GLGpuProgram::bindProgramParameters(GpuProgramParametersSharedPtr params)
 {
 
-	// only supports float constants
+	// only supports float constants, which are all uploaded on every bind
 	const GpuLogicalBufferStruct* floatStruct = params->getFloatLogicalBufferStruct();
+	size_t uploaded = 0;
 
 	for (GpuLogicalIndexUseMap::const_iterator i = floatStruct->map.begin();
 		i != floatStruct->map.end(); ++i)
@@ -83,9 +84,11 @@ void ATI_FS_GLGpuProgram::bindProgramParameters(GpuProgramParametersSharedPtr pa
 			glSetFragmentShaderConstantATI(GL_CON_0_ATI + logicalIndex, pFloat);
 			pFloat += 4;
 			++logicalIndex;
+			++uploaded;
 		}
 	}
 
+	return uploaded;
 }
 
 void ATI_FS_GLGpuProgram::bindProgramPassIterationParameters(GpuProgramParametersSharedPtr params)
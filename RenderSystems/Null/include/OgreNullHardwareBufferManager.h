@@ -0,0 +1,102 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullHardwareBufferManager_H__
+#define __NullHardwareBufferManager_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreDefaultHardwareBufferManager.h"
+
+namespace Ogre {
+
+    /** System memory vertex buffer which reports every write to the
+        NullRenderSystem as a buffer upload.
+    */
+    class _OgrePrivate NullHardwareVertexBuffer : public DefaultHardwareVertexBuffer
+    {
+    protected:
+        NullRenderSystem* mRenderSystem;
+        bool mLockedForWrite;
+    public:
+        NullHardwareVertexBuffer(size_t vertexSize, size_t numVertices,
+            HardwareBuffer::Usage usage, NullRenderSystem* renderSystem);
+        /** See HardwareBuffer. */
+        void writeData(size_t offset, size_t length, const void* pSource,
+            bool discardWholeBuffer = false);
+        /** See HardwareBuffer. */
+        void* lock(size_t offset, size_t length, LockOptions options);
+        /** See HardwareBuffer. */
+        void unlock(void);
+    };
+
+    /** System memory index buffer which reports every write to the
+        NullRenderSystem as a buffer upload.
+    */
+    class _OgrePrivate NullHardwareIndexBuffer : public DefaultHardwareIndexBuffer
+    {
+    protected:
+        NullRenderSystem* mRenderSystem;
+        bool mLockedForWrite;
+    public:
+        NullHardwareIndexBuffer(IndexType idxType, size_t numIndexes,
+            HardwareBuffer::Usage usage, NullRenderSystem* renderSystem);
+        /** See HardwareBuffer. */
+        void writeData(size_t offset, size_t length, const void* pSource,
+            bool discardWholeBuffer = false);
+        /** See HardwareBuffer. */
+        void* lock(size_t offset, size_t length, LockOptions options);
+        /** See HardwareBuffer. */
+        void unlock(void);
+    };
+
+    /** Hardware buffer manager for the Null RenderSystem.
+    @remarks
+        Buffers live in system memory, exactly like DefaultHardwareBufferManager,
+        but writes are counted so that the per-frame upload cost of a scene
+        can be measured without a GPU.
+    */
+    class _OgrePrivate NullHardwareBufferManager : public HardwareBufferManager
+    {
+    protected:
+        NullRenderSystem* mRenderSystem;
+    public:
+        NullHardwareBufferManager(NullRenderSystem* renderSystem);
+        ~NullHardwareBufferManager();
+        /// Creates a vertex buffer
+        HardwareVertexBufferSharedPtr
+            createVertexBuffer(size_t vertexSize, size_t numVerts,
+                HardwareBuffer::Usage usage, bool useShadowBuffer = false);
+        /// Create a hardware index buffer
+        HardwareIndexBufferSharedPtr
+            createIndexBuffer(HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+                HardwareBuffer::Usage usage, bool useShadowBuffer = false);
+    };
+
+}
+
+#endif
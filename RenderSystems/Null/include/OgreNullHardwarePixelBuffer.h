@@ -0,0 +1,83 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullHardwarePixelBuffer_H__
+#define __NullHardwarePixelBuffer_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreHardwarePixelBuffer.h"
+
+namespace Ogre {
+
+    /** One surface (face and mipmap level) of a NullTexture.
+    @remarks
+        The pixels are kept in system memory so that loading, blitting and
+        reading back behave like on a real device. Every write is reported to
+        the NullRenderSystem as a buffer upload.
+    */
+    class _OgrePrivate NullHardwarePixelBuffer : public HardwarePixelBuffer
+    {
+    public:
+        /** Constructor.
+        @param baseName Name of the owning texture, used to name render targets
+        */
+        NullHardwarePixelBuffer(const String& baseName, size_t width, size_t height,
+            size_t depth, PixelFormat format, HardwareBuffer::Usage usage,
+            NullRenderSystem* renderSystem);
+        ~NullHardwarePixelBuffer();
+
+        /// @copydoc HardwarePixelBuffer::blitFromMemory
+        void blitFromMemory(const PixelBox &src, const Image::Box &dstBox);
+
+        /// @copydoc HardwarePixelBuffer::blitToMemory
+        void blitToMemory(const Image::Box &srcBox, const PixelBox &dst);
+
+        /// @copydoc HardwarePixelBuffer::getRenderTarget
+        RenderTexture* getRenderTarget(size_t slice = 0);
+
+    protected:
+        /// @copydoc HardwarePixelBuffer::lockImpl
+        PixelBox lockImpl(const Image::Box lockBox, LockOptions options);
+
+        /// @copydoc HardwareBuffer::unlockImpl
+        void unlockImpl(void);
+
+        /// Notify TextureBuffer of destruction of render target
+        void _clearSliceRTT(size_t zoffset);
+
+        NullRenderSystem* mRenderSystem;
+        /// The surface contents
+        PixelBox mBuffer;
+        LockOptions mCurrentLockOptions;
+
+        typedef std::vector<RenderTexture*> SliceTRT;
+        SliceTRT mSliceTRT;
+    };
+}
+
+#endif
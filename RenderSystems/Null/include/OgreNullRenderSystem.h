@@ -0,0 +1,241 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderSystem_H__
+#define __NullRenderSystem_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreRenderSystem.h"
+
+namespace Ogre {
+
+    /** Counters gathered by the NullRenderSystem over one frame. */
+    struct NullFrameStats
+    {
+        /// Draw calls issued through _render, one per pass iteration
+        size_t drawCalls;
+        /// Calls which would have changed device state
+        size_t stateChanges;
+        /// Redundant state changes dropped by the render state cache
+        size_t filteredStateChanges;
+        /// Writes to vertex, index and pixel buffers
+        size_t bufferUploads;
+        /// Total number of bytes written by bufferUploads
+        size_t bufferUploadBytes;
+        /// 4-component GPU program constants which would have been uploaded
+        size_t constantUploads;
+
+        NullFrameStats()
+            : drawCalls(0), stateChanges(0), filteredStateChanges(0), bufferUploads(0),
+            bufferUploadBytes(0), constantUploads(0) {}
+    };
+
+    /** RenderSystem which talks to no device at all.
+    @remarks
+        All buffers and textures live in system memory and every rendering
+        call returns immediately, so the whole SceneManager, RenderQueue and
+        _render path can run on a machine without a GPU. The render system
+        counts draw calls, state changes (and those dropped by the render state
+        cache), GPU program constant uploads and buffer uploads. A frame ends when Root swaps the render target
+        buffers; the totals for that frame are then available from
+        getLastFrameStats, and are also published to RenderSystem::Listener
+        instances as a "FrameStats" event whose parameters are the counter
+        names.
+    */
+    class _OgreNullExport NullRenderSystem : public RenderSystem
+    {
+    public:
+        NullRenderSystem();
+        ~NullRenderSystem();
+
+        // ----------------------------------
+        // Overridden RenderSystem functions
+        // ----------------------------------
+        const String& getName(void) const;
+        ConfigOptionMap& getConfigOptions(void);
+        void setConfigOption(const String &name, const String &value);
+        String validateConfigOptions(void);
+        RenderWindow* _initialise(bool autoCreateWindow, const String& windowTitle = "OGRE Render Window");
+        RenderSystemCapabilities* createRenderSystemCapabilities() const;
+        void initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps, RenderTarget* primary);
+        void reinitialise(void);
+        void shutdown(void);
+
+        void setAmbientLight(float r, float g, float b);
+        void setShadingType(ShadeOptions so);
+        void setLightingEnabled(bool enabled);
+
+        RenderWindow* _createRenderWindow(const String &name, unsigned int width, unsigned int height,
+            bool fullScreen, const NameValuePairList *miscParams = 0);
+        MultiRenderTarget* createMultiRenderTarget(const String & name);
+        HardwareOcclusionQuery* createHardwareOcclusionQuery(void);
+
+        String getErrorDescription(long errorNumber) const;
+        VertexElementType getColourVertexElementType(void) const;
+        void setNormaliseNormals(bool normalise);
+
+        // -----------------------------
+        // Low-level overridden members
+        // -----------------------------
+        void _useLights(const LightList& lights, unsigned short limit);
+        void _setWorldMatrix(const Matrix4 &m);
+        void _setViewMatrix(const Matrix4 &m);
+        void _setProjectionMatrix(const Matrix4 &m);
+        void _setSurfaceParams(const ColourValue &ambient,
+            const ColourValue &diffuse, const ColourValue &specular,
+            const ColourValue &emissive, Real shininess,
+            TrackVertexColourType tracking);
+        void _setPointSpritesEnabled(bool enabled);
+        void _setPointParameters(Real size, bool attenuationEnabled,
+            Real constant, Real linear, Real quadratic, Real minSize, Real maxSize);
+        void _setTexture(size_t unit, bool enabled, const TexturePtr &tex);
+        void _setTextureCoordSet(size_t unit, size_t index);
+        void _setTextureCoordCalculation(size_t unit, TexCoordCalcMethod m,
+            const Frustum* frustum = 0);
+        void _setTextureBlendMode(size_t unit, const LayerBlendModeEx& bm);
+        void _setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter);
+        void _setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy);
+        void _setTextureAddressingMode(size_t unit, const TextureUnitState::UVWAddressingMode& uvw);
+        void _setTextureBorderColour(size_t unit, const ColourValue& colour);
+        void _setTextureMipmapBias(size_t unit, float bias);
+        void _setTextureMatrix(size_t unit, const Matrix4& xform);
+        void _setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor);
+        void _setSeparateSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+            SceneBlendFactor sourceFactorAlpha, SceneBlendFactor destFactorAlpha);
+        void _setAlphaRejectSettings(CompareFunction func, unsigned char value);
+        void _setViewport(Viewport *vp);
+        void _beginFrame(void);
+        void _endFrame(void);
+        void _setCullingMode(CullingMode mode);
+        void _setDepthBufferParams(bool depthTest = true, bool depthWrite = true,
+            CompareFunction depthFunction = CMPF_LESS_EQUAL);
+        void _setDepthBufferCheckEnabled(bool enabled = true);
+        void _setDepthBufferWriteEnabled(bool enabled = true);
+        void _setDepthBufferFunction(CompareFunction func = CMPF_LESS_EQUAL);
+        void _setDepthBias(float constantBias, float slopeScaleBias);
+        void _setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha);
+        void _setFog(FogMode mode, const ColourValue& colour, Real density, Real start, Real end);
+        void _convertProjectionMatrix(const Matrix4& matrix,
+            Matrix4& dest, bool forGpuProgram = false);
+        void _makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+            Matrix4& dest, bool forGpuProgram = false);
+        void _makeProjectionMatrix(Real left, Real right, Real bottom, Real top,
+            Real nearPlane, Real farPlane, Matrix4& dest, bool forGpuProgram = false);
+        void _makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+            Matrix4& dest, bool forGpuProgram = false);
+        void _applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane,
+            bool forGpuProgram);
+        void _setPolygonMode(PolygonMode level);
+        void setStencilCheckEnabled(bool enabled);
+        void setStencilBufferParams(CompareFunction func = CMPF_ALWAYS_PASS,
+            uint32 refValue = 0, uint32 mask = 0xFFFFFFFF,
+            StencilOperation stencilFailOp = SOP_KEEP,
+            StencilOperation depthFailOp = SOP_KEEP,
+            StencilOperation passOp = SOP_KEEP,
+            bool twoSidedOperation = false);
+        void setVertexDeclaration(VertexDeclaration* decl);
+        void setVertexBufferBinding(VertexBufferBinding* binding);
+        void _render(const RenderOperation& op);
+        void bindGpuProgram(GpuProgram* prg);
+        void unbindGpuProgram(GpuProgramType gptype);
+        void bindGpuProgramParameters(GpuProgramType gptype, GpuProgramParametersSharedPtr params);
+        void bindGpuProgramPassIterationParameters(GpuProgramType gptype);
+        void setScissorTest(bool enabled, size_t left = 0, size_t top = 0,
+            size_t right = 800, size_t bottom = 600);
+        void clearFrameBuffer(unsigned int buffers,
+            const ColourValue& colour = ColourValue::Black,
+            Real depth = 1.0f, unsigned short stencil = 0);
+        Real getHorizontalTexelOffset(void);
+        Real getVerticalTexelOffset(void);
+        Real getMinimumDepthInputValue(void);
+        Real getMaximumDepthInputValue(void);
+        void registerThread();
+        void unregisterThread();
+        void preExtraThreadsStarted();
+        void postExtraThreadsStarted();
+
+        /** Ends the current frame after Root has updated all render targets.
+        @see NullRenderSystem::getLastFrameStats
+        */
+        void _swapAllRenderTargetBuffers(bool waitForVsync = true);
+
+        /// Counters for the frame in progress
+        const NullFrameStats& getCurrentFrameStats(void) const { return mCurrentFrameStats; }
+        /// Counters for the last frame completed by _swapAllRenderTargetBuffers
+        const NullFrameStats& getLastFrameStats(void) const { return mLastFrameStats; }
+        /// Number of frames completed since the render system was created
+        unsigned long getFrameCount(void) const { return mFrameCount; }
+
+        /** Records a write of the given size to a hardware buffer.
+        @note
+            Buffers may be written from background loading threads, so this
+            is the only counter which is updated under a lock.
+        */
+        void _notifyBufferUpload(size_t bytes);
+
+    protected:
+        /// Internal method used to set the underlying clip planes when needed
+        void setClipPlanesImpl(const PlaneList& clipPlanes);
+
+        /// Records a call which would have changed device state
+        void noteStateChange(void) { ++mCurrentFrameStats.stateChanges; }
+        /// Records a call setting cached state, unless the state cache drops it
+        template <typename T>
+        void noteStateChange(CachedState<T>& state, const T& value)
+        {
+            if (filterStateChange(state, value))
+                ++mCurrentFrameStats.stateChanges;
+            else
+                ++mCurrentFrameStats.filteredStateChanges;
+        }
+
+        void initConfigOptions(void);
+
+        ConfigOptionMap mOptions;
+
+        NullHardwareBufferManager* mHardwareBufferManager;
+        NullGpuProgramManager* mGpuProgramManager;
+        bool mInitialised;
+
+        /** The program parameters last bound for each program type.
+        @remarks
+            Constants are treated as device registers which keep their values
+            across program changes, so rebinding the same parameters counts
+            only the constants which changed since.
+        */
+        const GpuProgramParameters* mLastVertexParams;
+        const GpuProgramParameters* mLastFragmentParams;
+
+        NullFrameStats mCurrentFrameStats;
+        NullFrameStats mLastFrameStats;
+        unsigned long mFrameCount;
+        OGRE_MUTEX(mStatsMutex)
+    };
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderWindow_H__
+#define __NullRenderWindow_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreRenderWindow.h"
+
+namespace Ogre {
+
+    /** Offscreen window for the Null RenderSystem. It has a size and
+        viewports but no surface; reading it back yields black pixels.
+    */
+    class _OgrePrivate NullRenderWindow : public RenderWindow
+    {
+    public:
+        NullRenderWindow();
+        ~NullRenderWindow();
+
+        /// @copydoc RenderWindow::create
+        void create(const String& name, unsigned int width, unsigned int height,
+            bool fullScreen, const NameValuePairList *miscParams);
+        /// @copydoc RenderWindow::setFullscreen
+        void setFullscreen(bool fullScreen, unsigned int width, unsigned int height);
+        /// @copydoc RenderWindow::destroy
+        void destroy(void);
+        /// @copydoc RenderWindow::resize
+        void resize(unsigned int width, unsigned int height);
+        /// @copydoc RenderWindow::reposition
+        void reposition(int left, int top);
+        /// @copydoc RenderWindow::isClosed
+        bool isClosed(void) const { return mClosed; }
+
+        /// @copydoc RenderTarget::copyContentsToMemory
+        void copyContentsToMemory(const PixelBox &dst, FrameBuffer buffer);
+        bool requiresTextureFlipping() const { return false; }
+
+    protected:
+        bool mClosed;
+    };
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullHardwareBufferManager.h"
+#include "OgreNullRenderSystem.h"
+
+namespace Ogre {
+
+    //-----------------------------------------------------------------------
+    NullHardwareVertexBuffer::NullHardwareVertexBuffer(size_t vertexSize,
+        size_t numVertices, HardwareBuffer::Usage usage, NullRenderSystem* renderSystem)
+        : DefaultHardwareVertexBuffer(vertexSize, numVertices, usage),
+        mRenderSystem(renderSystem), mLockedForWrite(false)
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareVertexBuffer::writeData(size_t offset, size_t length,
+        const void* pSource, bool discardWholeBuffer)
+    {
+        DefaultHardwareVertexBuffer::writeData(offset, length, pSource, discardWholeBuffer);
+        mRenderSystem->_notifyBufferUpload(length);
+    }
+    //-----------------------------------------------------------------------
+    void* NullHardwareVertexBuffer::lock(size_t offset, size_t length, LockOptions options)
+    {
+        mLockStart = offset;
+        mLockSize = length;
+        mLockedForWrite = (options != HBL_READ_ONLY);
+        return DefaultHardwareVertexBuffer::lock(offset, length, options);
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareVertexBuffer::unlock(void)
+    {
+        DefaultHardwareVertexBuffer::unlock();
+        if (mLockedForWrite)
+        {
+            mRenderSystem->_notifyBufferUpload(mLockSize);
+            mLockedForWrite = false;
+        }
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    NullHardwareIndexBuffer::NullHardwareIndexBuffer(IndexType idxType,
+        size_t numIndexes, HardwareBuffer::Usage usage, NullRenderSystem* renderSystem)
+        : DefaultHardwareIndexBuffer(idxType, numIndexes, usage),
+        mRenderSystem(renderSystem), mLockedForWrite(false)
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareIndexBuffer::writeData(size_t offset, size_t length,
+        const void* pSource, bool discardWholeBuffer)
+    {
+        DefaultHardwareIndexBuffer::writeData(offset, length, pSource, discardWholeBuffer);
+        mRenderSystem->_notifyBufferUpload(length);
+    }
+    //-----------------------------------------------------------------------
+    void* NullHardwareIndexBuffer::lock(size_t offset, size_t length, LockOptions options)
+    {
+        mLockStart = offset;
+        mLockSize = length;
+        mLockedForWrite = (options != HBL_READ_ONLY);
+        return DefaultHardwareIndexBuffer::lock(offset, length, options);
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareIndexBuffer::unlock(void)
+    {
+        DefaultHardwareIndexBuffer::unlock();
+        if (mLockedForWrite)
+        {
+            mRenderSystem->_notifyBufferUpload(mLockSize);
+            mLockedForWrite = false;
+        }
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    NullHardwareBufferManager::NullHardwareBufferManager(NullRenderSystem* renderSystem)
+        : mRenderSystem(renderSystem)
+    {
+    }
+    //-----------------------------------------------------------------------
+    NullHardwareBufferManager::~NullHardwareBufferManager()
+    {
+        destroyAllDeclarations();
+        destroyAllBindings();
+    }
+    //-----------------------------------------------------------------------
+    HardwareVertexBufferSharedPtr
+        NullHardwareBufferManager::createVertexBuffer(size_t vertexSize,
+        size_t numVerts, HardwareBuffer::Usage usage, bool useShadowBuffer)
+    {
+        // Shadow buffers are pointless, the buffer already lives in system memory
+        NullHardwareVertexBuffer* vb =
+            new NullHardwareVertexBuffer(vertexSize, numVerts, usage, mRenderSystem);
+        {
+            OGRE_LOCK_MUTEX(mVertexBuffersMutex)
+            mVertexBuffers.insert(vb);
+        }
+        return HardwareVertexBufferSharedPtr(vb);
+    }
+    //-----------------------------------------------------------------------
+    HardwareIndexBufferSharedPtr
+        NullHardwareBufferManager::createIndexBuffer(HardwareIndexBuffer::IndexType itype,
+        size_t numIndexes, HardwareBuffer::Usage usage, bool useShadowBuffer)
+    {
+        NullHardwareIndexBuffer* ib =
+            new NullHardwareIndexBuffer(itype, numIndexes, usage, mRenderSystem);
+        {
+            OGRE_LOCK_MUTEX(mIndexBuffersMutex)
+            mIndexBuffers.insert(ib);
+        }
+        return HardwareIndexBufferSharedPtr(ib);
+    }
+}
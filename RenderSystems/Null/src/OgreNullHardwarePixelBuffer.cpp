@@ -0,0 +1,152 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullHardwarePixelBuffer.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreNullRenderTexture.h"
+#include "OgreException.h"
+#include "OgreStringConverter.h"
+#include "OgreTexture.h"
+
+namespace Ogre {
+
+    //-----------------------------------------------------------------------
+    NullHardwarePixelBuffer::NullHardwarePixelBuffer(const String& baseName,
+        size_t width, size_t height, size_t depth, PixelFormat format,
+        HardwareBuffer::Usage usage, NullRenderSystem* renderSystem)
+        : HardwarePixelBuffer(width, height, depth, format, usage, false, false),
+        mRenderSystem(renderSystem),
+        mBuffer(width, height, depth, format),
+        mCurrentLockOptions(HBL_NORMAL)
+    {
+        mRowPitch = mBuffer.rowPitch;
+        mSlicePitch = mBuffer.slicePitch;
+        mSizeInBytes = PixelUtil::getMemorySize(width, height, depth, format);
+        mBuffer.data = new uint8[mSizeInBytes];
+        memset(mBuffer.data, 0, mSizeInBytes);
+
+        // Is this a render target?
+        if (mUsage & TU_RENDERTARGET)
+        {
+            // Create render target for each slice
+            mSliceTRT.reserve(mDepth);
+            for (size_t zoffset = 0; zoffset < mDepth; ++zoffset)
+            {
+                String name = "rtt/" + StringConverter::toString((size_t)this) + "/" + baseName;
+                if (mDepth > 1)
+                    name += "/" + StringConverter::toString(zoffset);
+                RenderTexture* trt = new NullRenderTexture(name, this, zoffset);
+                mSliceTRT.push_back(trt);
+                mRenderSystem->attachRenderTarget(*trt);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    NullHardwarePixelBuffer::~NullHardwarePixelBuffer()
+    {
+        // Delete all render targets that are not yet deleted via _clearSliceRTT
+        // because the rendertarget was deleted by the user.
+        for (SliceTRT::const_iterator it = mSliceTRT.begin(); it != mSliceTRT.end(); ++it)
+        {
+            if (*it)
+                mRenderSystem->destroyRenderTarget((*it)->getName());
+        }
+        delete [] (uint8*)mBuffer.data;
+    }
+    //-----------------------------------------------------------------------
+    PixelBox NullHardwarePixelBuffer::lockImpl(const Image::Box lockBox, LockOptions options)
+    {
+        mCurrentLockOptions = options;
+        return mBuffer.getSubVolume(lockBox);
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwarePixelBuffer::unlockImpl(void)
+    {
+        if (mCurrentLockOptions != HBL_READ_ONLY)
+        {
+            mRenderSystem->_notifyBufferUpload(PixelUtil::getMemorySize(
+                mCurrentLock.getWidth(), mCurrentLock.getHeight(),
+                mCurrentLock.getDepth(), mFormat));
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwarePixelBuffer::blitFromMemory(const PixelBox &src, const Image::Box &dstBox)
+    {
+        if (!mBuffer.contains(dstBox))
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "destination box out of range",
+                "NullHardwarePixelBuffer::blitFromMemory");
+
+        PixelBox dst = mBuffer.getSubVolume(dstBox);
+        if (src.getWidth() != dst.getWidth() ||
+            src.getHeight() != dst.getHeight() ||
+            src.getDepth() != dst.getDepth())
+        {
+            // Scale to destination size, this also converts the format
+            Image::scale(src, dst, Image::FILTER_BILINEAR);
+        }
+        else
+        {
+            PixelUtil::bulkPixelConversion(src, dst);
+        }
+
+        mRenderSystem->_notifyBufferUpload(PixelUtil::getMemorySize(
+            dst.getWidth(), dst.getHeight(), dst.getDepth(), mFormat));
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwarePixelBuffer::blitToMemory(const Image::Box &srcBox, const PixelBox &dst)
+    {
+        if (!mBuffer.contains(srcBox))
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "source box out of range",
+                "NullHardwarePixelBuffer::blitToMemory");
+
+        PixelBox src = mBuffer.getSubVolume(srcBox);
+        if (src.getWidth() != dst.getWidth() ||
+            src.getHeight() != dst.getHeight() ||
+            src.getDepth() != dst.getDepth())
+        {
+            // We need scaling
+            Image::scale(src, dst, Image::FILTER_BILINEAR);
+        }
+        else
+        {
+            PixelUtil::bulkPixelConversion(src, dst);
+        }
+    }
+    //-----------------------------------------------------------------------
+    RenderTexture* NullHardwarePixelBuffer::getRenderTarget(size_t zoffset)
+    {
+        assert(mUsage & TU_RENDERTARGET);
+        assert(zoffset < mDepth);
+        return mSliceTRT[zoffset];
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwarePixelBuffer::_clearSliceRTT(size_t zoffset)
+    {
+        mSliceTRT[zoffset] = 0;
+    }
+}
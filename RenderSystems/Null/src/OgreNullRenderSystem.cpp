@@ -0,0 +1,818 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullRenderSystem.h"
+#include "OgreNullRenderWindow.h"
+#include "OgreNullRenderTexture.h"
+#include "OgreNullHardwareBufferManager.h"
+#include "OgreNullTextureManager.h"
+#include "OgreNullGpuProgramManager.h"
+#include "OgreNullHardwareOcclusionQuery.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+#include "OgreException.h"
+#include "OgreViewport.h"
+#include "OgreFrustum.h"
+
+namespace Ogre {
+
+    static const String sFrameStatsEvent = "FrameStats";
+
+    //-----------------------------------------------------------------------
+    NullRenderSystem::NullRenderSystem()
+        : mHardwareBufferManager(0), mGpuProgramManager(0), mInitialised(false),
+        mLastVertexParams(0), mLastFragmentParams(0), mFrameCount(0)
+    {
+        LogManager::getSingleton().logMessage(getName() + " created.");
+
+        initConfigOptions();
+
+        mActiveRenderTarget = 0;
+        mEventNames.push_back(sFrameStatsEvent);
+    }
+    //-----------------------------------------------------------------------
+    NullRenderSystem::~NullRenderSystem()
+    {
+        shutdown();
+    }
+    //-----------------------------------------------------------------------
+    const String& NullRenderSystem::getName(void) const
+    {
+        static String strName("Null Rendering Subsystem");
+        return strName;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::initConfigOptions(void)
+    {
+        ConfigOption optVideoMode;
+        optVideoMode.name = "Video Mode";
+        optVideoMode.possibleValues.push_back("640 x 480");
+        optVideoMode.possibleValues.push_back("800 x 600");
+        optVideoMode.possibleValues.push_back("1024 x 768");
+        optVideoMode.possibleValues.push_back("1280 x 1024");
+        optVideoMode.possibleValues.push_back("1920 x 1080");
+        optVideoMode.currentValue = "800 x 600";
+        optVideoMode.immutable = false;
+
+        ConfigOption optFullScreen;
+        optFullScreen.name = "Full Screen";
+        optFullScreen.possibleValues.push_back("Yes");
+        optFullScreen.possibleValues.push_back("No");
+        optFullScreen.currentValue = "No";
+        optFullScreen.immutable = false;
+
+        mOptions[optVideoMode.name] = optVideoMode;
+        mOptions[optFullScreen.name] = optFullScreen;
+    }
+    //-----------------------------------------------------------------------
+    ConfigOptionMap& NullRenderSystem::getConfigOptions(void)
+    {
+        return mOptions;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setConfigOption(const String &name, const String &value)
+    {
+        ConfigOptionMap::iterator it = mOptions.find(name);
+        if (it != mOptions.end())
+            it->second.currentValue = value;
+    }
+    //-----------------------------------------------------------------------
+    String NullRenderSystem::validateConfigOptions(void)
+    {
+        // Any mode is fine, nothing is ever displayed
+        return StringUtil::BLANK;
+    }
+    //-----------------------------------------------------------------------
+    RenderWindow* NullRenderSystem::_initialise(bool autoCreateWindow, const String& windowTitle)
+    {
+        RenderWindow* autoWindow = 0;
+
+        if (autoCreateWindow)
+        {
+            unsigned int width = 800, height = 600;
+            bool fullScreen = false;
+
+            ConfigOptionMap::iterator opt = mOptions.find("Video Mode");
+            if (opt != mOptions.end())
+            {
+                String val = opt->second.currentValue;
+                String::size_type pos = val.find('x');
+                if (pos != String::npos)
+                {
+                    width = StringConverter::parseUnsignedInt(val.substr(0, pos));
+                    height = StringConverter::parseUnsignedInt(val.substr(pos + 1));
+                }
+            }
+            opt = mOptions.find("Full Screen");
+            if (opt != mOptions.end())
+                fullScreen = (opt->second.currentValue == "Yes");
+
+            autoWindow = _createRenderWindow(windowTitle, width, height, fullScreen);
+        }
+
+        // call superclass method
+        RenderSystem::_initialise(autoCreateWindow);
+
+        return autoWindow;
+    }
+    //-----------------------------------------------------------------------
+    RenderSystemCapabilities* NullRenderSystem::createRenderSystemCapabilities() const
+    {
+        RenderSystemCapabilities* rsc = new RenderSystemCapabilities();
+
+        rsc->setCategoryRelevant(CAPS_CATEGORY_GL, false);
+        rsc->setCategoryRelevant(CAPS_CATEGORY_D3D9, false);
+        rsc->setRenderSystemName(getName());
+        rsc->setDeviceName("Null Device");
+        rsc->setVendor(GPU_UNKNOWN);
+
+        rsc->setCapability(RSC_FIXED_FUNCTION);
+        rsc->setCapability(RSC_AUTOMIPMAP);
+        rsc->setCapability(RSC_BLENDING);
+        rsc->setCapability(RSC_ANISOTROPY);
+        rsc->setCapability(RSC_DOT3);
+        rsc->setCapability(RSC_CUBEMAPPING);
+        rsc->setCapability(RSC_HWSTENCIL);
+        rsc->setCapability(RSC_VBO);
+        rsc->setCapability(RSC_VERTEX_PROGRAM);
+        rsc->setCapability(RSC_FRAGMENT_PROGRAM);
+        rsc->setCapability(RSC_SCISSOR_TEST);
+        rsc->setCapability(RSC_TWO_SIDED_STENCIL);
+        rsc->setCapability(RSC_STENCIL_WRAP);
+        rsc->setCapability(RSC_HWOCCLUSION);
+        rsc->setCapability(RSC_USER_CLIP_PLANES);
+        rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
+        rsc->setCapability(RSC_INFINITE_FAR_PLANE);
+        rsc->setCapability(RSC_HWRENDER_TO_TEXTURE);
+        rsc->setCapability(RSC_TEXTURE_FLOAT);
+        rsc->setCapability(RSC_NON_POWER_OF_2_TEXTURES);
+        rsc->setCapability(RSC_TEXTURE_3D);
+        rsc->setCapability(RSC_POINT_SPRITES);
+        rsc->setCapability(RSC_POINT_EXTENDED_PARAMETERS);
+        rsc->setCapability(RSC_MIPMAP_LOD_BIAS);
+        rsc->setCapability(RSC_MRT_DIFFERENT_BIT_DEPTHS);
+        // Compressed textures are decompressed by the codecs on load, so
+        // RSC_TEXTURE_COMPRESSION is deliberately not reported
+
+        rsc->setNumTextureUnits(OGRE_MAX_TEXTURE_LAYERS);
+        rsc->setNumWorldMatrices(0);
+        rsc->setNumVertexBlendMatrices(0);
+        rsc->setStencilBufferBitDepth(8);
+        rsc->setNumMultiRenderTargets(OGRE_MAX_MULTIPLE_RENDER_TARGETS);
+        rsc->setMaxPointSize(256);
+        rsc->setNonPOW2TexturesLimited(false);
+        rsc->setNumVertexTextureUnits(0);
+        rsc->setVertexTextureUnitsShared(false);
+
+        rsc->addShaderProfile("arbvp1");
+        rsc->addShaderProfile("vs_1_1");
+        rsc->addShaderProfile("vs_2_0");
+        rsc->addShaderProfile("vs_2_x");
+        rsc->addShaderProfile("vs_3_0");
+        rsc->setVertexProgramConstantFloatCount(256);
+        rsc->setVertexProgramConstantIntCount(16);
+        rsc->setVertexProgramConstantBoolCount(16);
+
+        rsc->addShaderProfile("arbfp1");
+        rsc->addShaderProfile("ps_1_1");
+        rsc->addShaderProfile("ps_1_4");
+        rsc->addShaderProfile("ps_2_0");
+        rsc->addShaderProfile("ps_2_x");
+        rsc->addShaderProfile("ps_3_0");
+        rsc->setFragmentProgramConstantFloatCount(224);
+        rsc->setFragmentProgramConstantIntCount(16);
+        rsc->setFragmentProgramConstantBoolCount(16);
+
+        return rsc;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::initialiseFromRenderSystemCapabilities(
+        RenderSystemCapabilities* caps, RenderTarget* primary)
+    {
+        if (caps->getRenderSystemName() != getName())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Trying to initialize NullRenderSystem from RenderSystemCapabilities that do not support it",
+                "NullRenderSystem::initialiseFromRenderSystemCapabilities");
+        }
+
+        mHardwareBufferManager = new NullHardwareBufferManager(this);
+        mGpuProgramManager = new NullGpuProgramManager();
+        mTextureManager = new NullTextureManager(this);
+
+        Log* defaultLog = LogManager::getSingleton().getDefaultLog();
+        if (defaultLog)
+        {
+            caps->log(defaultLog);
+        }
+
+        mInitialised = true;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::reinitialise(void)
+    {
+        this->shutdown();
+        this->_initialise(true);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::shutdown(void)
+    {
+        RenderSystem::shutdown();
+
+        delete mGpuProgramManager;
+        mGpuProgramManager = 0;
+
+        delete mHardwareBufferManager;
+        mHardwareBufferManager = 0;
+
+        delete mTextureManager;
+        mTextureManager = 0;
+
+        mInitialised = false;
+    }
+    //-----------------------------------------------------------------------
+    RenderWindow* NullRenderSystem::_createRenderWindow(const String &name,
+        unsigned int width, unsigned int height, bool fullScreen,
+        const NameValuePairList *miscParams)
+    {
+        if (mRenderTargets.find(name) != mRenderTargets.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Window with name '" + name + "' already exists",
+                "NullRenderSystem::_createRenderWindow");
+        }
+
+        NullRenderWindow* win = new NullRenderWindow();
+        win->create(name, width, height, fullScreen, miscParams);
+        attachRenderTarget(*win);
+
+        if (!mInitialised)
+        {
+            // set up capabilities
+            mRealCapabilities = createRenderSystemCapabilities();
+
+            // use real capabilities if custom capabilities are not available
+            if (!mUseCustomCapabilities)
+                mCurrentCapabilities = mRealCapabilities;
+
+            initialiseFromRenderSystemCapabilities(mCurrentCapabilities, win);
+        }
+
+        return win;
+    }
+    //-----------------------------------------------------------------------
+    MultiRenderTarget* NullRenderSystem::createMultiRenderTarget(const String & name)
+    {
+        MultiRenderTarget* retval = new NullMultiRenderTarget(name);
+        attachRenderTarget(*retval);
+        return retval;
+    }
+    //-----------------------------------------------------------------------
+    HardwareOcclusionQuery* NullRenderSystem::createHardwareOcclusionQuery(void)
+    {
+        NullHardwareOcclusionQuery* ret = new NullHardwareOcclusionQuery();
+        mHwOcclusionQueries.push_back(ret);
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    String NullRenderSystem::getErrorDescription(long errorNumber) const
+    {
+        return StringUtil::BLANK;
+    }
+    //-----------------------------------------------------------------------
+    VertexElementType NullRenderSystem::getColourVertexElementType(void) const
+    {
+        return VET_COLOUR_ABGR;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setAmbientLight(float r, float g, float b)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setShadingType(ShadeOptions so)
+    {
+        noteStateChange(mStateCache.shading, so);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setLightingEnabled(bool enabled)
+    {
+        noteStateChange(mStateCache.lighting, enabled);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setNormaliseNormals(bool normalise)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_useLights(const LightList& lights, unsigned short limit)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setWorldMatrix(const Matrix4 &m)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setViewMatrix(const Matrix4 &m)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setProjectionMatrix(const Matrix4 &m)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setSurfaceParams(const ColourValue &ambient,
+        const ColourValue &diffuse, const ColourValue &specular,
+        const ColourValue &emissive, Real shininess,
+        TrackVertexColourType tracking)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setPointSpritesEnabled(bool enabled)
+    {
+        noteStateChange(mStateCache.pointSprites, enabled);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setPointParameters(Real size, bool attenuationEnabled,
+        Real constant, Real linear, Real quadratic, Real minSize, Real maxSize)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTexture(size_t unit, bool enabled, const TexturePtr &tex)
+    {
+        TextureState texState;
+        texState.enabled = enabled;
+        texState.texture = enabled ? tex.get() : 0;
+        texState.stateCount = texState.texture ? texState.texture->getStateCount() : 0;
+        noteStateChange(mStateCache.textures[unit], texState);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureCoordSet(size_t unit, size_t index)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureCoordCalculation(size_t unit, TexCoordCalcMethod m,
+        const Frustum* frustum)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureBlendMode(size_t unit, const LayerBlendModeEx& bm)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureUnitFiltering(size_t unit, FilterType ftype,
+        FilterOptions filter)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureAddressingMode(size_t unit,
+        const TextureUnitState::UVWAddressingMode& uvw)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureBorderColour(size_t unit, const ColourValue& colour)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureMipmapBias(size_t unit, float bias)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setTextureMatrix(size_t unit, const Matrix4& xform)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setSceneBlending(SceneBlendFactor sourceFactor,
+        SceneBlendFactor destFactor)
+    {
+        SceneBlendState blendState = { sourceFactor, destFactor, sourceFactor, destFactor };
+        noteStateChange(mStateCache.sceneBlending, blendState);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setSeparateSceneBlending(SceneBlendFactor sourceFactor,
+        SceneBlendFactor destFactor, SceneBlendFactor sourceFactorAlpha,
+        SceneBlendFactor destFactorAlpha)
+    {
+        SceneBlendState blendState = { sourceFactor, destFactor, sourceFactorAlpha, destFactorAlpha };
+        noteStateChange(mStateCache.sceneBlending, blendState);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setAlphaRejectSettings(CompareFunction func, unsigned char value)
+    {
+        AlphaRejectState alphaState = { func, value };
+        noteStateChange(mStateCache.alphaReject, alphaState);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setViewport(Viewport *vp)
+    {
+        // Check if viewport is different
+        if (vp != mActiveViewport || vp->_isUpdated())
+        {
+            // Drop the cached state a device would lose on switching target,
+            // as the GL render system does
+            if (vp->getTarget() != mActiveRenderTarget)
+            {
+                mStateCache.cullingMode.valid = false;
+                invalidateTextureStateCache();
+            }
+            mActiveRenderTarget = vp->getTarget();
+            mActiveViewport = vp;
+            vp->_clearUpdatedFlag();
+            noteStateChange();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_beginFrame(void)
+    {
+        if (!mActiveViewport)
+            OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                "Cannot begin frame - no viewport selected.",
+                "NullRenderSystem::_beginFrame");
+
+        // Textures may have been created or updated since the last frame
+        invalidateTextureStateCache();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_endFrame(void)
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setCullingMode(CullingMode mode)
+    {
+        mCullingMode = mode;
+        noteStateChange(mStateCache.cullingMode, mode);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferParams(bool depthTest, bool depthWrite,
+        CompareFunction depthFunction)
+    {
+        _setDepthBufferCheckEnabled(depthTest);
+        _setDepthBufferWriteEnabled(depthWrite);
+        _setDepthBufferFunction(depthFunction);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferCheckEnabled(bool enabled)
+    {
+        noteStateChange(mStateCache.depthCheck, enabled);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferWriteEnabled(bool enabled)
+    {
+        noteStateChange(mStateCache.depthWrite, enabled);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferFunction(CompareFunction func)
+    {
+        noteStateChange(mStateCache.depthFunction, func);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBias(float constantBias, float slopeScaleBias)
+    {
+        DepthBiasState biasState = { constantBias, slopeScaleBias };
+        noteStateChange(mStateCache.depthBias, biasState);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setColourBufferWriteEnabled(bool red, bool green,
+        bool blue, bool alpha)
+    {
+        uint8 writeMask = (red ? 1 : 0) | (green ? 2 : 0) | (blue ? 4 : 0) | (alpha ? 8 : 0);
+        noteStateChange(mStateCache.colourWrite, writeMask);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setFog(FogMode mode, const ColourValue& colour,
+        Real density, Real start, Real end)
+    {
+        FogState fogState = { mode, colour, density, start, end };
+        noteStateChange(mStateCache.fog, fogState);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_convertProjectionMatrix(const Matrix4& matrix,
+        Matrix4& dest, bool forGpuProgram)
+    {
+        // Projection matrices use the GL convention, no conversion needed
+        dest = matrix;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_makeProjectionMatrix(const Radian& fovy, Real aspect,
+        Real nearPlane, Real farPlane, Matrix4& dest, bool forGpuProgram)
+    {
+        Radian thetaY (fovy / 2.0f);
+        Real tanThetaY = Math::Tan(thetaY);
+
+        // Calc matrix elements
+        Real w = (1.0f / tanThetaY) / aspect;
+        Real h = 1.0f / tanThetaY;
+        Real q, qn;
+        if (farPlane == 0)
+        {
+            // Infinite far plane
+            q = Frustum::INFINITE_FAR_PLANE_ADJUST - 1;
+            qn = nearPlane * (Frustum::INFINITE_FAR_PLANE_ADJUST - 2);
+        }
+        else
+        {
+            q = -(farPlane + nearPlane) / (farPlane - nearPlane);
+            qn = -2 * (farPlane * nearPlane) / (farPlane - nearPlane);
+        }
+
+        // NB This creates Z in range [-1,1]
+        dest = Matrix4::ZERO;
+        dest[0][0] = w;
+        dest[1][1] = h;
+        dest[2][2] = q;
+        dest[2][3] = qn;
+        dest[3][2] = -1;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_makeProjectionMatrix(Real left, Real right,
+        Real bottom, Real top, Real nearPlane, Real farPlane, Matrix4& dest,
+        bool forGpuProgram)
+    {
+        Real width = right - left;
+        Real height = top - bottom;
+        Real q, qn;
+        if (farPlane == 0)
+        {
+            // Infinite far plane
+            q = Frustum::INFINITE_FAR_PLANE_ADJUST - 1;
+            qn = nearPlane * (Frustum::INFINITE_FAR_PLANE_ADJUST - 2);
+        }
+        else
+        {
+            q = -(farPlane + nearPlane) / (farPlane - nearPlane);
+            qn = -2 * (farPlane * nearPlane) / (farPlane - nearPlane);
+        }
+        dest = Matrix4::ZERO;
+        dest[0][0] = 2 * nearPlane / width;
+        dest[0][2] = (right+left) / width;
+        dest[1][1] = 2 * nearPlane / height;
+        dest[1][2] = (top+bottom) / height;
+        dest[2][2] = q;
+        dest[2][3] = qn;
+        dest[3][2] = -1;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_makeOrthoMatrix(const Radian& fovy, Real aspect,
+        Real nearPlane, Real farPlane, Matrix4& dest, bool forGpuProgram)
+    {
+        Radian thetaY (fovy / 2.0f);
+        Real tanThetaY = Math::Tan(thetaY);
+
+        Real tanThetaX = tanThetaY * aspect;
+        Real half_w = tanThetaX * nearPlane;
+        Real half_h = tanThetaY * nearPlane;
+        Real iw = 1.0 / half_w;
+        Real ih = 1.0 / half_h;
+        Real q;
+        if (farPlane == 0)
+        {
+            q = 0;
+        }
+        else
+        {
+            q = 2.0 / (farPlane - nearPlane);
+        }
+        dest = Matrix4::ZERO;
+        dest[0][0] = iw;
+        dest[1][1] = ih;
+        dest[2][2] = -q;
+        dest[2][3] = - (farPlane + nearPlane)/(farPlane - nearPlane);
+        dest[3][3] = 1;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_applyObliqueDepthProjection(Matrix4& matrix,
+        const Plane& plane, bool forGpuProgram)
+    {
+        // Calculate the clip-space corner point opposite the clipping plane
+        // and transform it into camera space (same as the GL render system)
+        Vector4 q;
+        q.x = (Math::Sign(plane.normal.x) + matrix[0][2]) / matrix[0][0];
+        q.y = (Math::Sign(plane.normal.y) + matrix[1][2]) / matrix[1][1];
+        q.z = -1.0F;
+        q.w = (1.0F + matrix[2][2]) / matrix[2][3];
+
+        // Calculate the scaled plane vector
+        Vector4 clipPlane4d(plane.normal.x, plane.normal.y, plane.normal.z, plane.d);
+        Vector4 c = clipPlane4d * (2.0F / (clipPlane4d.dotProduct(q)));
+
+        // Replace the third row of the projection matrix
+        matrix[2][0] = c.x;
+        matrix[2][1] = c.y;
+        matrix[2][2] = c.z + 1.0F;
+        matrix[2][3] = c.w;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_setPolygonMode(PolygonMode level)
+    {
+        noteStateChange(mStateCache.polygonMode, level);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setStencilCheckEnabled(bool enabled)
+    {
+        noteStateChange(mStateCache.stencilCheck, enabled);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setStencilBufferParams(CompareFunction func,
+        uint32 refValue, uint32 mask, StencilOperation stencilFailOp,
+        StencilOperation depthFailOp, StencilOperation passOp,
+        bool twoSidedOperation)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setVertexDeclaration(VertexDeclaration* decl)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setVertexBufferBinding(VertexBufferBinding* binding)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_render(const RenderOperation& op)
+    {
+        // Call super class, which maintains the batch / face / vertex counts
+        RenderSystem::_render(op);
+
+        do
+        {
+            ++mCurrentFrameStats.drawCalls;
+        } while (updatePassIterationRenderState());
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgram(GpuProgram* prg)
+    {
+        noteStateChange();
+        RenderSystem::bindGpuProgram(prg);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::unbindGpuProgram(GpuProgramType gptype)
+    {
+        noteStateChange();
+        RenderSystem::unbindGpuProgram(gptype);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgramParameters(GpuProgramType gptype,
+        GpuProgramParametersSharedPtr params)
+    {
+        if (gptype == GPT_VERTEX_PROGRAM)
+            mActiveVertexGpuProgramParameters = params;
+        else
+            mActiveFragmentGpuProgramParameters = params;
+        noteStateChange();
+
+        const GpuProgramParameters*& lastParams = (gptype == GPT_VERTEX_PROGRAM) ?
+            mLastVertexParams : mLastFragmentParams;
+        if (lastParams != params.get())
+        {
+            params->_markAllDirty();
+            lastParams = params.get();
+        }
+
+        // Count the 4-component registers touched by the changed ranges
+        size_t start, end, uploaded = 0;
+        if (params->_getFloatDirtyRange(&lastParams, start, end))
+            uploaded += (end + 3) / 4 - start / 4;
+        if (params->_getIntDirtyRange(&lastParams, start, end))
+            uploaded += (end + 3) / 4 - start / 4;
+        params->_clearDirtyRanges(&lastParams);
+
+        mCurrentFrameStats.constantUploads += uploaded;
+        mConstantUploadCount += uploaded;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setClipPlanesImpl(const PlaneList& clipPlanes)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::setScissorTest(bool enabled, size_t left, size_t top,
+        size_t right, size_t bottom)
+    {
+        noteStateChange();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::clearFrameBuffer(unsigned int buffers,
+        const ColourValue& colour, Real depth, unsigned short stencil)
+    {
+    }
+    //-----------------------------------------------------------------------
+    Real NullRenderSystem::getHorizontalTexelOffset(void)
+    {
+        return 0.0f;
+    }
+    //-----------------------------------------------------------------------
+    Real NullRenderSystem::getVerticalTexelOffset(void)
+    {
+        return 0.0f;
+    }
+    //-----------------------------------------------------------------------
+    Real NullRenderSystem::getMinimumDepthInputValue(void)
+    {
+        return -1.0f;
+    }
+    //-----------------------------------------------------------------------
+    Real NullRenderSystem::getMaximumDepthInputValue(void)
+    {
+        return 1.0f;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::registerThread()
+    {
+        // No context to share
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::unregisterThread()
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::preExtraThreadsStarted()
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::postExtraThreadsStarted()
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_swapAllRenderTargetBuffers(bool waitForVsync)
+    {
+        RenderSystem::_swapAllRenderTargetBuffers(waitForVsync);
+
+        {
+            OGRE_LOCK_MUTEX(mStatsMutex)
+            mLastFrameStats = mCurrentFrameStats;
+            mCurrentFrameStats = NullFrameStats();
+        }
+        ++mFrameCount;
+
+        if (!mEventListeners.empty())
+        {
+            NameValuePairList params;
+            params["frame"] = StringConverter::toString(mFrameCount);
+            params["drawCalls"] = StringConverter::toString(mLastFrameStats.drawCalls);
+            params["stateChanges"] = StringConverter::toString(mLastFrameStats.stateChanges);
+            params["filteredStateChanges"] = StringConverter::toString(mLastFrameStats.filteredStateChanges);
+            params["bufferUploads"] = StringConverter::toString(mLastFrameStats.bufferUploads);
+            params["bufferUploadBytes"] = StringConverter::toString(mLastFrameStats.bufferUploadBytes);
+            params["constantUploads"] = StringConverter::toString(mLastFrameStats.constantUploads);
+            fireEvent(sFrameStatsEvent, &params);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderSystem::_notifyBufferUpload(size_t bytes)
+    {
+        OGRE_LOCK_MUTEX(mStatsMutex)
+        ++mCurrentFrameStats.bufferUploads;
+        mCurrentFrameStats.bufferUploadBytes += bytes;
+    }
+}
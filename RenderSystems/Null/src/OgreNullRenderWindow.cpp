@@ -0,0 +1,128 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullRenderWindow.h"
+#include "OgreViewport.h"
+#include "OgreException.h"
+#include "OgreStringConverter.h"
+
+namespace Ogre {
+
+    //-----------------------------------------------------------------------
+    NullRenderWindow::NullRenderWindow()
+        : mClosed(false)
+    {
+        mIsFullScreen = false;
+        mActive = false;
+    }
+    //-----------------------------------------------------------------------
+    NullRenderWindow::~NullRenderWindow()
+    {
+        destroy();
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderWindow::create(const String& name, unsigned int width, unsigned int height,
+        bool fullScreen, const NameValuePairList *miscParams)
+    {
+        mName = name;
+        mWidth = width;
+        mHeight = height;
+        mIsFullScreen = fullScreen;
+        mColourDepth = 32;
+        mLeft = mTop = 0;
+
+        if (miscParams)
+        {
+            NameValuePairList::const_iterator opt;
+            opt = miscParams->find("colourDepth");
+            if (opt != miscParams->end())
+                mColourDepth = StringConverter::parseUnsignedInt(opt->second);
+            opt = miscParams->find("left");
+            if (opt != miscParams->end())
+                mLeft = StringConverter::parseInt(opt->second);
+            opt = miscParams->find("top");
+            if (opt != miscParams->end())
+                mTop = StringConverter::parseInt(opt->second);
+        }
+
+        mActive = true;
+        mClosed = false;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderWindow::setFullscreen(bool fullScreen, unsigned int width, unsigned int height)
+    {
+        mIsFullScreen = fullScreen;
+        resize(width, height);
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderWindow::destroy(void)
+    {
+        mActive = false;
+        mClosed = true;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderWindow::resize(unsigned int width, unsigned int height)
+    {
+        mWidth = width;
+        mHeight = height;
+
+        for (ViewportList::iterator it = mViewportList.begin();
+             it != mViewportList.end(); ++it)
+        {
+            (*it).second->_updateDimensions();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderWindow::reposition(int left, int top)
+    {
+        mLeft = left;
+        mTop = top;
+    }
+    //-----------------------------------------------------------------------
+    void NullRenderWindow::copyContentsToMemory(const PixelBox &dst, FrameBuffer buffer)
+    {
+        if ((dst.right > mWidth) || (dst.bottom > mHeight) ||
+            (dst.front != 0) || (dst.back != 1))
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Invalid box.",
+                "NullRenderWindow::copyContentsToMemory" );
+        }
+
+        // Nothing was ever drawn, the window stays black
+        size_t rowSize = PixelUtil::getMemorySize(dst.getWidth(), 1, 1, dst.format);
+        size_t rowPitch = PixelUtil::getMemorySize(dst.rowPitch, 1, 1, dst.format);
+        uint8* row = static_cast<uint8*>(dst.data) +
+            PixelUtil::getMemorySize(dst.left, 1, 1, dst.format) + dst.top * rowPitch;
+        for (size_t y = 0; y < dst.getHeight(); ++y)
+        {
+            memset(row, 0, rowSize);
+            row += rowPitch;
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullTexture.h"
+#include "OgreNullHardwarePixelBuffer.h"
+#include "OgreNullRenderSystem.h"
+
+#include "OgreTextureManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreImage.h"
+#include "OgreException.h"
+
+namespace Ogre {
+
+    //-----------------------------------------------------------------------
+    NullTexture::NullTexture(ResourceManager* creator, const String& name,
+        ResourceHandle handle, const String& group, bool isManual,
+        ManualResourceLoader* loader, NullRenderSystem* renderSystem)
+        : Texture(creator, name, handle, group, isManual, loader),
+        mRenderSystem(renderSystem)
+    {
+    }
+    //-----------------------------------------------------------------------
+    NullTexture::~NullTexture()
+    {
+        // have to call this here reather than in Resource destructor
+        // since calling virtual methods in base destructors causes crash
+        if (isLoaded())
+        {
+            unload();
+        }
+        else
+        {
+            freeInternalResources();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NullTexture::prepareImpl(void)
+    {
+        if (!(mUsage & TU_RENDERTARGET))
+            prepareSourceImages();
+    }
+    //-----------------------------------------------------------------------
+    void NullTexture::loadImpl(void)
+    {
+        if (mUsage & TU_RENDERTARGET)
+            createInternalResources();
+        else
+            loadPreparedImages();
+    }
+    //-----------------------------------------------------------------------
+    void NullTexture::createInternalResourcesImpl(void)
+    {
+        // Adjust format if required
+        mFormat = TextureManager::getSingleton().getNativeFormat(mTextureType, mFormat, mUsage);
+
+        // Check requested number of mipmaps
+        size_t maxMips = 0;
+        size_t width = mWidth;
+        size_t height = mHeight;
+        size_t depth = mDepth;
+        while (width > 1 || height > 1 || depth > 1)
+        {
+            if (width > 1)  width = width / 2;
+            if (height > 1) height = height / 2;
+            if (depth > 1)  depth = depth / 2;
+            ++maxMips;
+        }
+        mNumMipmaps = std::min(mNumRequestedMipmaps, maxMips);
+
+        // Mipmaps are never generated, but claiming hardware generation
+        // avoids a software pass which a real device would not pay for
+        mMipmapsHardwareGenerated = true;
+
+        mSurfaceList.clear();
+        for (size_t face = 0; face < getNumFaces(); ++face)
+        {
+            width = mWidth;
+            height = mHeight;
+            depth = mDepth;
+            for (size_t mip = 0; mip <= mNumMipmaps; ++mip)
+            {
+                NullHardwarePixelBuffer* buf = new NullHardwarePixelBuffer(mName,
+                    width, height, depth, mFormat,
+                    static_cast<HardwareBuffer::Usage>(mUsage), mRenderSystem);
+                mSurfaceList.push_back(HardwarePixelBufferSharedPtr(buf));
+
+                if (width > 1)  width = width / 2;
+                if (height > 1) height = height / 2;
+                if (depth > 1)  depth = depth / 2;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NullTexture::freeInternalResourcesImpl(void)
+    {
+        mSurfaceList.clear();
+    }
+    //-----------------------------------------------------------------------
+    HardwarePixelBufferSharedPtr NullTexture::getBuffer(size_t face, size_t mipmap)
+    {
+        if (face >= getNumFaces())
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Face index out of range",
+                "NullTexture::getBuffer");
+        if (mipmap > mNumMipmaps)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Mipmap index out of range",
+                "NullTexture::getBuffer");
+        size_t idx = face*(mNumMipmaps+1) + mipmap;
+        assert(idx < mSurfaceList.size());
+        return mSurfaceList[idx];
+    }
+}
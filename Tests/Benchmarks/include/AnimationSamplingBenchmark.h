@@ -0,0 +1,67 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __AnimationSamplingBenchmark_H__
+#define __AnimationSamplingBenchmark_H__
+
+#include "Benchmark.h"
+#include "OgreSkeleton.h"
+#include "OgreAnimationState.h"
+
+/** Measures applying a skeletal animation to many instances, each with its
+	own AnimationState, for several bone and keyframe counts. Instances are
+	applied through Skeleton::setAnimationState, which steps on from the 
+	keyframe cursor of each state, and through Animation::apply with a time
+	position, which searches the keyframes every time.
+*/
+class AnimationSamplingBenchmark : public Benchmark
+{
+public:
+	AnimationSamplingBenchmark();
+	void tearDown(void);
+	void run(BenchmarkReport& report);
+
+protected:
+	/// Build a skeleton with an animation keying every bone numKeys times
+	void createSkeleton(unsigned short numBones, size_t numKeys);
+	/// Destroy the skeleton built by createSkeleton
+	void destroySkeleton(void);
+	/// Create an animation state set per instance at random times
+	void createInstances(size_t numInstances);
+	/// Destroy the instances built by createInstances
+	void destroyInstances(void);
+	/** Time a number of frames advancing and applying every instance, 
+		returning the average in microseconds */
+	double timeFrames(bool useCursor, size_t frames);
+
+	SkeletonPtr mSkeleton;
+	typedef std::vector<AnimationStateSet*> InstanceList;
+	InstanceList mInstances;
+};
+
+#endif
@@ -0,0 +1,162 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __Benchmark_H__
+#define __Benchmark_H__
+
+#include "OgrePrerequisites.h"
+#include <iostream>
+
+using namespace Ogre;
+
+/** A single measurement produced by a benchmark. */
+struct BenchmarkResult
+{
+	/// Name of the benchmark which produced the result
+	String benchmark;
+	/// Configuration which was measured, e.g. "nodes=10000 shape=wide"
+	String variant;
+	/// What was measured, e.g. "update"
+	String measure;
+	/// The measured value
+	double value;
+	/// The unit of the value, e.g. "us"
+	String unit;
+};
+
+/** Collects the results of a benchmark run and writes them out. */
+class BenchmarkReport
+{
+public:
+	typedef std::vector<BenchmarkResult> ResultList;
+
+	/** Records a result.
+	@param benchmark Name of the benchmark
+	@param variant Configuration which was measured
+	@param measure What was measured
+	@param value The measured value
+	@param unit The unit of the value
+	*/
+	void addResult(const String& benchmark, const String& variant, 
+		const String& measure, double value, const String& unit);
+
+	/** Gets the results recorded so far. */
+	const ResultList& getResults(void) const { return mResults; }
+
+	/** Writes the results as comma separated values, one per line, with
+		a header line naming the columns. */
+	void writeCSV(std::ostream& os) const;
+
+protected:
+	ResultList mResults;
+};
+
+/** Base class for a benchmark.
+@remarks
+	Subclasses are registered with OGRE_BENCHMARK_REGISTRATION and are run
+	by the OgreBenchmarks executable, which creates a Root before any 
+	benchmark is set up. If a render system plugin (normally the Null 
+	render system) could be loaded, Root is also initialised and a render
+	window is created for the benchmarks to share.
+*/
+class Benchmark
+{
+public:
+	Benchmark(const String& name) : mName(name) {}
+	virtual ~Benchmark() {}
+
+	/** Gets the name of the benchmark, used to select it on the command line. */
+	const String& getName(void) const { return mName; }
+
+	/** Called before run to create anything the benchmark needs. */
+	virtual void setUp(void) {}
+	/** Called after run to destroy anything created by setUp. */
+	virtual void tearDown(void) {}
+	/** Performs the measurements, adding results to the report. */
+	virtual void run(BenchmarkReport& report) = 0;
+	/** Returns true if the benchmark renders, and so must be skipped when
+		no render window is available. */
+	virtual bool requiresRenderWindow(void) const { return false; }
+
+	/** Gets the number of worker threads benchmarks should compare against
+		serial execution, as given on the command line. */
+	static size_t getNumWorkerThreads(void) { return msNumWorkerThreads; }
+	/** Sets the number of worker threads benchmarks should compare against
+		serial execution. */
+	static void setNumWorkerThreads(size_t num) { msNumWorkerThreads = num; }
+
+	/** Gets the number of frames rendering benchmarks should measure. */
+	static size_t getNumFrames(void) { return msNumFrames; }
+	/** Sets the number of frames rendering benchmarks should measure. */
+	static void setNumFrames(size_t num) { msNumFrames = num; }
+
+	/** Gets the window shared by rendering benchmarks, or null if no
+		render system is available. */
+	static RenderWindow* getRenderWindow(void) { return msRenderWindow; }
+	/** Sets the window shared by rendering benchmarks. */
+	static void setRenderWindow(RenderWindow* win) { msRenderWindow = win; }
+
+protected:
+	String mName;
+	static size_t msNumWorkerThreads;
+	static size_t msNumFrames;
+	static RenderWindow* msRenderWindow;
+};
+
+/** Holds all the registered benchmarks. */
+class BenchmarkRegistry
+{
+public:
+	typedef std::vector<Benchmark*> BenchmarkList;
+
+	/** Gets the registry instance. */
+	static BenchmarkRegistry& getSingleton(void);
+
+	/** Adds a benchmark; ownership passes to the registry. */
+	void addBenchmark(Benchmark* b) { mBenchmarks.push_back(b); }
+	/** Gets the registered benchmarks. */
+	const BenchmarkList& getBenchmarks(void) const { return mBenchmarks; }
+
+	~BenchmarkRegistry();
+
+protected:
+	BenchmarkList mBenchmarks;
+};
+
+/** Helper used by OGRE_BENCHMARK_REGISTRATION. */
+template <typename T>
+class BenchmarkRegistrar
+{
+public:
+	BenchmarkRegistrar() { BenchmarkRegistry::getSingleton().addBenchmark(new T()); }
+};
+
+/// Registers a benchmark class with the registry
+#define OGRE_BENCHMARK_REGISTRATION(cls) static BenchmarkRegistrar<cls> cls##Registrar;
+
+#endif
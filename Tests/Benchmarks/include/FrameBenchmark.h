@@ -0,0 +1,145 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __FrameBenchmark_H__
+#define __FrameBenchmark_H__
+
+#include "Benchmark.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "OgreRenderSystem.h"
+
+/** Scene manager which times the stages of _renderScene.
+@remarks
+	Shadow textures are rendered through nested calls to _renderScene; the
+	stages of those renders are counted as part of the shadow stage only.
+*/
+class TimedSceneManager : public DefaultSceneManager
+{
+public:
+	/// The stages which are timed
+	enum Stage
+	{
+		/// _applySceneAnimations
+		STAGE_SCENE_ANIMATION,
+		/// _updateSceneGraph
+		STAGE_SCENE_GRAPH,
+		/// prepareShadowTextures, including the shadow texture renders
+		STAGE_SHADOW_TEXTURES,
+		/// _findVisibleObjects, which includes Entity::updateAnimation for
+		/// entities which were not updated before the frame
+		STAGE_FIND_VISIBLE,
+		/// _renderVisibleObjects, which includes RenderQueue sorting
+		STAGE_RENDER,
+		STAGE_COUNT
+	};
+
+	TimedSceneManager(const String& name);
+
+	/** Gets the name used for a stage in benchmark reports. */
+	static const char* getStageName(Stage stage);
+	/** Gets the total time spent in a stage since the last reset, in microseconds. */
+	unsigned long getStageTime(Stage stage) const { return mStageTimes[stage]; }
+	/** Resets all stage times to zero. */
+	void resetStageTimes(void);
+
+	void _applySceneAnimations(void);
+	void _updateSceneGraph(Camera* cam);
+	void _findVisibleObjects(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds,
+		bool onlyShadowCasters);
+	void _renderVisibleObjects(void);
+
+protected:
+	void prepareShadowTextures(Camera* cam, Viewport* vp);
+	/// Adds the time since start to a stage, unless inside the shadow stage
+	void addStageTime(Stage stage, unsigned long start);
+
+	Timer* mTimer;
+	unsigned long mStageTimes[STAGE_COUNT];
+	bool mInShadowTextures;
+};
+
+/** Base class for benchmarks which render a representative scene for a
+	fixed number of frames.
+@remarks
+	Each scene is built in code at several sizes. For every size the
+	benchmark renders a few warm-up frames and then getNumFrames() measured
+	frames through Root::renderOneFrame, reporting the average time per frame
+	of the whole frame, of updateScene, and of each TimedSceneManager stage.
+	Controllers run at a fixed 60 frames per second so that animation and
+	particle emission do the same work however fast the frames are. If the
+	render system raises a "FrameStats" event (as the Null render system
+	does), the draw calls, state changes, constant uploads and buffer uploads
+	per frame are reported as well.
+*/
+class FrameBenchmark : public Benchmark, public RenderSystem::Listener
+{
+public:
+	typedef std::vector<size_t> SizeList;
+
+	/** Constructor.
+	@param name Name of the benchmark
+	@param sizeName Name of what the scene size counts, e.g. "nodes"
+	*/
+	FrameBenchmark(const String& name, const String& sizeName);
+
+	void setUp(void);
+	void tearDown(void);
+	void run(BenchmarkReport& report);
+	bool requiresRenderWindow(void) const { return true; }
+
+	/// @copydoc RenderSystem::Listener::eventOccurred
+	void eventOccurred(const String& eventName, const NameValuePairList* parameters = 0);
+
+	/// The simulated time between frames, in seconds
+	static const Real FRAME_TIME;
+
+protected:
+	/** Gets the sizes of scene to measure. */
+	virtual void getSceneSizes(SizeList& sizes) const = 0;
+	/** Builds the scene at the given size. */
+	virtual void createScene(size_t size) = 0;
+	/** Called before each frame to move things in the scene. */
+	virtual void updateScene(Real timeElapsed) {}
+	/** Destroys the scene built by createScene. The default clears the scene. */
+	virtual void destroyScene(void);
+
+	/// Render the frames for one scene size and report the averages
+	void measureFrames(BenchmarkReport& report, const String& variant);
+
+	String mSizeName;
+	TimedSceneManager* mSceneMgr;
+	Camera* mCamera;
+	Viewport* mViewport;
+
+	/// Totals of the "FrameStats" event parameters while measuring
+	typedef std::map<String, double> StatTotals;
+	StatTotals mStatTotals;
+	bool mMeasuring;
+};
+
+#endif
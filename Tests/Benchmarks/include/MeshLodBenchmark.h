@@ -0,0 +1,60 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __MeshLodBenchmark_H__
+#define __MeshLodBenchmark_H__
+
+#include "Benchmark.h"
+#include "OgreMesh.h"
+#include "OgreHardwareBufferManager.h"
+
+/** Measures Mesh::generateLodLevels on generated meshes of several sizes,
+	serially and with the submeshes reduced across the WorkerThreadPool.
+*/
+class MeshLodBenchmark : public Benchmark
+{
+public:
+	MeshLodBenchmark();
+	void setUp(void);
+	void tearDown(void);
+	void run(BenchmarkReport& report);
+
+protected:
+	/// Build a mesh of several bumpy grid submeshes with size x size vertices each
+	void createMesh(size_t size);
+	/// Destroy the mesh built by createMesh
+	void destroyMesh(void);
+	/// Time a number of LOD generations, returning the average in microseconds
+	double timeGeneration(bool parallel, size_t iterations);
+
+	MeshPtr mMesh;
+	/// Buffer manager created when no render system provided one
+	HardwareBufferManager* mBufferManager;
+};
+
+#endif
@@ -0,0 +1,63 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __PixelConversionBenchmark_H__
+#define __PixelConversionBenchmark_H__
+
+#include "Benchmark.h"
+#include "OgrePixelFormat.h"
+#include "OgreImage.h"
+
+/** Measures PixelUtil::bulkPixelConversion and Image::scale on large
+	images, serially and split across the WorkerThreadPool.
+@remarks
+	Conversions are also timed through a loop of PixelUtil::unpackColour and
+	packColour, the generic path used for format pairs which have no
+	specialised conversion.
+*/
+class PixelConversionBenchmark : public Benchmark
+{
+public:
+	PixelConversionBenchmark();
+	void run(BenchmarkReport& report);
+
+protected:
+	/// Allocate a box of the given size and format filled with a gradient
+	PixelBox createBox(size_t size, PixelFormat format);
+	/// Free a box allocated by createBox
+	void destroyBox(PixelBox& box);
+	/// Time a number of bulk conversions, returning the average in microseconds
+	double timeConversion(const PixelBox& src, const PixelBox& dst, size_t iterations);
+	/// Time a number of generic per-pixel conversions, returning the average in microseconds
+	double timeGenericConversion(const PixelBox& src, const PixelBox& dst, size_t iterations);
+	/// Time a number of scales, returning the average in microseconds
+	double timeScale(const PixelBox& src, const PixelBox& dst, 
+		Image::Filter filter, size_t iterations);
+};
+
+#endif
@@ -0,0 +1,114 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SceneGraphUpdateBenchmark_H__
+#define __SceneGraphUpdateBenchmark_H__
+
+#include "Benchmark.h"
+#include "OgreMovableObject.h"
+#include "OgreAxisAlignedBox.h"
+
+/** Measures SceneManager::_updateSceneGraph for several scene graph sizes and
+	shapes, serially, split across the WorkerThreadPool and through a 
+	NodeTransformStore.
+*/
+class SceneGraphUpdateBenchmark : public Benchmark
+{
+public:
+	SceneGraphUpdateBenchmark();
+	void setUp(void);
+	void tearDown(void);
+	void run(BenchmarkReport& report);
+
+	/** Minimal movable object with fixed bounds, so that the bounds update
+		has some work to do without needing any hardware buffers. */
+	class BoundsObject : public MovableObject
+	{
+	public:
+		BoundsObject(const String& name, const AxisAlignedBox& box);
+		const String& getMovableType(void) const;
+		const AxisAlignedBox& getBoundingBox(void) const { return mBox; }
+		Real getBoundingRadius(void) const { return mRadius; }
+		void _updateRenderQueue(RenderQueue* queue) {}
+		void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables = false) {}
+	protected:
+		AxisAlignedBox mBox;
+		Real mRadius;
+	};
+
+protected:
+	/// Shapes of scene graph to build
+	enum TreeShape
+	{
+		/// Every node is a child of the root
+		TS_FLAT,
+		/// Every node has 8 children
+		TS_BALANCED,
+		/// Every node has 2 children
+		TS_BINARY,
+		/// Every node has a random parent
+		TS_RANDOM
+	};
+
+	/// Ways of updating the scene graph to compare
+	enum UpdateMode
+	{
+		/// Recursive update in the calling thread
+		UM_SERIAL,
+		/// Recursive update split across the WorkerThreadPool
+		UM_PARALLEL,
+		/// Linear sweep through a NodeTransformStore
+		UM_TRANSFORM_STORE
+	};
+
+	/// Changes made to the scene graph before each timed update
+	enum ChangeKind
+	{
+		/// Every node is updated
+		CK_ALL,
+		/// 1% of the nodes are moved
+		CK_SPARSE,
+		/// 1% of the nodes are moved and 0.1% are attached to other parents
+		CK_REPARENT
+	};
+
+	/// Build a scene graph of the given size and shape
+	void buildScene(size_t numNodes, TreeShape shape);
+	/// Destroy the scene built by buildScene
+	void destroyScene(void);
+	/// Time a number of updates, returning the average in microseconds
+	double timeUpdates(UpdateMode mode, ChangeKind changes, size_t iterations);
+
+	SceneManager* mSceneMgr;
+	/// Nodes built by buildScene, the root first
+	std::vector<SceneNode*> mNodes;
+	typedef std::vector<BoundsObject*> ObjectList;
+	ObjectList mObjects;
+};
+
+#endif
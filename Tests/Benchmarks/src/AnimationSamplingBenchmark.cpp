@@ -0,0 +1,176 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "AnimationSamplingBenchmark.h"
+#include "OgreRoot.h"
+#include "OgreSkeletonManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreAnimation.h"
+#include "OgreKeyFrame.h"
+#include "OgreBone.h"
+#include "OgreStringConverter.h"
+#include "OgreMath.h"
+#include "OgreTimer.h"
+
+OGRE_BENCHMARK_REGISTRATION( AnimationSamplingBenchmark );
+
+namespace
+{
+	const String SKELETON_NAME = "AnimationSamplingBenchmark.skeleton";
+	const String ANIMATION_NAME = "Walk";
+	const Real ANIMATION_LENGTH = 4;
+}
+
+//--------------------------------------------------------------------------
+AnimationSamplingBenchmark::AnimationSamplingBenchmark()
+	: Benchmark("AnimationSampling")
+{
+}
+//--------------------------------------------------------------------------
+void AnimationSamplingBenchmark::tearDown(void)
+{
+	destroyInstances();
+	destroySkeleton();
+}
+//--------------------------------------------------------------------------
+void AnimationSamplingBenchmark::createSkeleton(unsigned short numBones, size_t numKeys)
+{
+	mSkeleton = SkeletonManager::getSingleton().create(SKELETON_NAME, 
+		ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+
+	// Limbs of 4 bones hanging off a root bone
+	Bone* root = mSkeleton->createBone(0);
+	for (unsigned short b = 1; b < numBones; ++b)
+	{
+		Bone* parent = (b - 1) % 4 == 0 ? root : mSkeleton->getBone(b - 1);
+		parent->createChild(b, Vector3(0, 1, 0));
+	}
+	mSkeleton->setBindingPose();
+
+	srand(1);
+	Animation* anim = mSkeleton->createAnimation(ANIMATION_NAME, ANIMATION_LENGTH);
+	Real keySpacing = ANIMATION_LENGTH / (numKeys - 1);
+	for (unsigned short b = 0; b < numBones; ++b)
+	{
+		NodeAnimationTrack* track = anim->createNodeTrack(b, mSkeleton->getBone(b));
+		for (size_t k = 0; k < numKeys; ++k)
+		{
+			TransformKeyFrame* kf = track->createNodeKeyFrame(k * keySpacing);
+			kf->setRotation(Quaternion(Degree(Math::SymmetricRandom() * 30), Vector3::UNIT_Z));
+			kf->setTranslate(Vector3(0, Math::SymmetricRandom() * 0.1f, 0));
+		}
+	}
+}
+//--------------------------------------------------------------------------
+void AnimationSamplingBenchmark::destroySkeleton(void)
+{
+	if (!mSkeleton.isNull())
+	{
+		mSkeleton.setNull();
+		SkeletonManager::getSingleton().remove(SKELETON_NAME);
+	}
+}
+//--------------------------------------------------------------------------
+void AnimationSamplingBenchmark::createInstances(size_t numInstances)
+{
+	for (size_t i = 0; i < numInstances; ++i)
+	{
+		AnimationStateSet* animSet = new AnimationStateSet();
+		mSkeleton->_initAnimationState(animSet);
+		AnimationState* state = animSet->getAnimationState(ANIMATION_NAME);
+		state->setEnabled(true);
+		state->setTimePosition(Math::UnitRandom() * ANIMATION_LENGTH);
+		mInstances.push_back(animSet);
+	}
+}
+//--------------------------------------------------------------------------
+void AnimationSamplingBenchmark::destroyInstances(void)
+{
+	for (InstanceList::iterator i = mInstances.begin(); i != mInstances.end(); ++i)
+	{
+		delete *i;
+	}
+	mInstances.clear();
+}
+//--------------------------------------------------------------------------
+double AnimationSamplingBenchmark::timeFrames(bool useCursor, size_t frames)
+{
+	Animation* anim = mSkeleton->getAnimation(ANIMATION_NAME);
+	Timer* timer = Root::getSingleton().getTimer();
+
+	unsigned long start = timer->getMicroseconds();
+	for (size_t f = 0; f < frames; ++f)
+	{
+		for (InstanceList::iterator i = mInstances.begin(); i != mInstances.end(); ++i)
+		{
+			AnimationState* state = (*i)->getAnimationState(ANIMATION_NAME);
+			state->addTime(1.0f / 60);
+			if (useCursor)
+			{
+				mSkeleton->setAnimationState(**i);
+			}
+			else
+			{
+				mSkeleton->reset();
+				anim->apply(mSkeleton.get(), state->getTimePosition(), state->getWeight());
+			}
+		}
+	}
+	return (double)(timer->getMicroseconds() - start) / frames;
+}
+//--------------------------------------------------------------------------
+void AnimationSamplingBenchmark::run(BenchmarkReport& report)
+{
+	const unsigned short boneCounts[] = { 20, 80 };
+	const size_t keyCounts[] = { 30, 300 };
+	const size_t instanceCounts[] = { 100, 1000 };
+	const size_t frames = 20;
+
+	for (size_t b = 0; b < sizeof(boneCounts) / sizeof(unsigned short); ++b)
+	{
+		for (size_t k = 0; k < sizeof(keyCounts) / sizeof(size_t); ++k)
+		{
+			createSkeleton(boneCounts[b], keyCounts[k]);
+			for (size_t n = 0; n < sizeof(instanceCounts) / sizeof(size_t); ++n)
+			{
+				createInstances(instanceCounts[n]);
+				String variant = "bones=" + StringConverter::toString(boneCounts[b]) +
+					" keys=" + StringConverter::toString(keyCounts[k]) +
+					" instances=" + StringConverter::toString(instanceCounts[n]);
+
+				report.addResult(mName, variant + " search", "frame", 
+					timeFrames(false, frames), "us");
+				report.addResult(mName, variant + " cursor", "frame", 
+					timeFrames(true, frames), "us");
+
+				destroyInstances();
+			}
+			destroySkeleton();
+		}
+	}
+}
@@ -0,0 +1,71 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+size_t Benchmark::msNumWorkerThreads = 3;
+size_t Benchmark::msNumFrames = 100;
+RenderWindow* Benchmark::msRenderWindow = 0;
+
+//--------------------------------------------------------------------------
+void BenchmarkReport::addResult(const String& benchmark, const String& variant, 
+	const String& measure, double value, const String& unit)
+{
+	BenchmarkResult r;
+	r.benchmark = benchmark;
+	r.variant = variant;
+	r.measure = measure;
+	r.value = value;
+	r.unit = unit;
+	mResults.push_back(r);
+}
+//--------------------------------------------------------------------------
+void BenchmarkReport::writeCSV(std::ostream& os) const
+{
+	os << "benchmark,variant,measure,value,unit" << std::endl;
+	for (ResultList::const_iterator i = mResults.begin(); i != mResults.end(); ++i)
+	{
+		os << i->benchmark << "," << i->variant << "," << i->measure << ","
+			<< i->value << "," << i->unit << std::endl;
+	}
+}
+//--------------------------------------------------------------------------
+BenchmarkRegistry& BenchmarkRegistry::getSingleton(void)
+{
+	// function-local so that it exists before any static registrar runs
+	static BenchmarkRegistry registry;
+	return registry;
+}
+//--------------------------------------------------------------------------
+BenchmarkRegistry::~BenchmarkRegistry()
+{
+	for (BenchmarkList::iterator i = mBenchmarks.begin(); i != mBenchmarks.end(); ++i)
+	{
+		delete *i;
+	}
+}
@@ -0,0 +1,216 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "FrameBenchmark.h"
+#include "OgreRoot.h"
+#include "OgreCamera.h"
+#include "OgreViewport.h"
+#include "OgreRenderWindow.h"
+#include "OgreControllerManager.h"
+#include "OgreStringConverter.h"
+#include "OgreTimer.h"
+
+//--------------------------------------------------------------------------
+TimedSceneManager::TimedSceneManager(const String& name)
+	: DefaultSceneManager(name), mInShadowTextures(false)
+{
+	mTimer = Root::getSingleton().getTimer();
+	resetStageTimes();
+}
+//--------------------------------------------------------------------------
+const char* TimedSceneManager::getStageName(Stage stage)
+{
+	static const char* names[STAGE_COUNT] =
+	{
+		"sceneAnimation", "sceneGraph", "shadowTextures", "findVisible", "render"
+	};
+	return names[stage];
+}
+//--------------------------------------------------------------------------
+void TimedSceneManager::resetStageTimes(void)
+{
+	for (int i = 0; i < STAGE_COUNT; ++i)
+		mStageTimes[i] = 0;
+}
+//--------------------------------------------------------------------------
+void TimedSceneManager::addStageTime(Stage stage, unsigned long start)
+{
+	if (!mInShadowTextures)
+		mStageTimes[stage] += mTimer->getMicroseconds() - start;
+}
+//--------------------------------------------------------------------------
+void TimedSceneManager::_applySceneAnimations(void)
+{
+	unsigned long start = mTimer->getMicroseconds();
+	DefaultSceneManager::_applySceneAnimations();
+	addStageTime(STAGE_SCENE_ANIMATION, start);
+}
+//--------------------------------------------------------------------------
+void TimedSceneManager::_updateSceneGraph(Camera* cam)
+{
+	unsigned long start = mTimer->getMicroseconds();
+	DefaultSceneManager::_updateSceneGraph(cam);
+	addStageTime(STAGE_SCENE_GRAPH, start);
+}
+//--------------------------------------------------------------------------
+void TimedSceneManager::_findVisibleObjects(Camera* cam,
+	VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+{
+	unsigned long start = mTimer->getMicroseconds();
+	DefaultSceneManager::_findVisibleObjects(cam, visibleBounds, onlyShadowCasters);
+	addStageTime(STAGE_FIND_VISIBLE, start);
+}
+//--------------------------------------------------------------------------
+void TimedSceneManager::_renderVisibleObjects(void)
+{
+	unsigned long start = mTimer->getMicroseconds();
+	DefaultSceneManager::_renderVisibleObjects();
+	addStageTime(STAGE_RENDER, start);
+}
+//--------------------------------------------------------------------------
+void TimedSceneManager::prepareShadowTextures(Camera* cam, Viewport* vp)
+{
+	unsigned long start = mTimer->getMicroseconds();
+	mInShadowTextures = true;
+	DefaultSceneManager::prepareShadowTextures(cam, vp);
+	mInShadowTextures = false;
+	addStageTime(STAGE_SHADOW_TEXTURES, start);
+}
+//--------------------------------------------------------------------------
+const Real FrameBenchmark::FRAME_TIME = 1.0f / 60.0f;
+//--------------------------------------------------------------------------
+FrameBenchmark::FrameBenchmark(const String& name, const String& sizeName)
+	: Benchmark(name), mSizeName(sizeName), mSceneMgr(0), mCamera(0),
+	mViewport(0), mMeasuring(false)
+{
+}
+//--------------------------------------------------------------------------
+void FrameBenchmark::setUp(void)
+{
+	Root& root = Root::getSingleton();
+	mSceneMgr = new TimedSceneManager(mName);
+	mSceneMgr->_setDestinationRenderSystem(root.getRenderSystem());
+
+	mCamera = mSceneMgr->createCamera("BenchmarkCamera");
+	mCamera->setPosition(0, 300, 600);
+	mCamera->lookAt(Vector3::ZERO);
+	mCamera->setNearClipDistance(1);
+	mCamera->setFarClipDistance(10000);
+	mViewport = getRenderWindow()->addViewport(mCamera);
+
+	root.getRenderSystem()->addListener(this);
+	ControllerManager::getSingleton().setFrameDelay(FRAME_TIME);
+}
+//--------------------------------------------------------------------------
+void FrameBenchmark::tearDown(void)
+{
+	ControllerManager::getSingleton().setFrameDelay(0);
+	Root::getSingleton().getRenderSystem()->removeListener(this);
+
+	getRenderWindow()->removeAllViewports();
+	mViewport = 0;
+	delete mSceneMgr;
+	mSceneMgr = 0;
+	mCamera = 0;
+}
+//--------------------------------------------------------------------------
+void FrameBenchmark::destroyScene(void)
+{
+	mSceneMgr->clearScene();
+}
+//--------------------------------------------------------------------------
+void FrameBenchmark::eventOccurred(const String& eventName,
+	const NameValuePairList* parameters)
+{
+	if (!mMeasuring || eventName != "FrameStats" || !parameters)
+		return;
+
+	for (NameValuePairList::const_iterator i = parameters->begin();
+		i != parameters->end(); ++i)
+	{
+		if (i->first != "frame")
+			mStatTotals[i->first] += StringConverter::parseReal(i->second);
+	}
+}
+//--------------------------------------------------------------------------
+void FrameBenchmark::measureFrames(BenchmarkReport& report, const String& variant)
+{
+	Root& root = Root::getSingleton();
+	Timer* timer = root.getTimer();
+	const size_t warmUpFrames = 5;
+	size_t frames = getNumFrames();
+
+	for (size_t i = 0; i < warmUpFrames; ++i)
+	{
+		updateScene(FRAME_TIME);
+		root.renderOneFrame();
+	}
+
+	mSceneMgr->resetStageTimes();
+	mStatTotals.clear();
+	mMeasuring = true;
+	unsigned long updateTime = 0;
+	unsigned long frameTime = 0;
+	for (size_t i = 0; i < frames; ++i)
+	{
+		unsigned long start = timer->getMicroseconds();
+		updateScene(FRAME_TIME);
+		unsigned long rendered = timer->getMicroseconds();
+		root.renderOneFrame();
+		unsigned long end = timer->getMicroseconds();
+
+		updateTime += rendered - start;
+		frameTime += end - start;
+	}
+	mMeasuring = false;
+
+	report.addResult(mName, variant, "frame", (double)frameTime / frames, "us");
+	report.addResult(mName, variant, "updateScene", (double)updateTime / frames, "us");
+	for (int s = 0; s < TimedSceneManager::STAGE_COUNT; ++s)
+	{
+		TimedSceneManager::Stage stage = static_cast<TimedSceneManager::Stage>(s);
+		report.addResult(mName, variant, TimedSceneManager::getStageName(stage),
+			(double)mSceneMgr->getStageTime(stage) / frames, "us");
+	}
+	for (StatTotals::iterator i = mStatTotals.begin(); i != mStatTotals.end(); ++i)
+	{
+		report.addResult(mName, variant, i->first, i->second / frames, "count");
+	}
+}
+//--------------------------------------------------------------------------
+void FrameBenchmark::run(BenchmarkReport& report)
+{
+	SizeList sizes;
+	getSceneSizes(sizes);
+	for (SizeList::iterator i = sizes.begin(); i != sizes.end(); ++i)
+	{
+		createScene(*i);
+		measureFrames(report, mSizeName + "=" + StringConverter::toString(*i));
+		destroyScene();
+	}
+}
@@ -0,0 +1,89 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ManyNodesBenchmark.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreStringConverter.h"
+#include "OgreMath.h"
+
+OGRE_BENCHMARK_REGISTRATION( ManyNodesBenchmark );
+
+//--------------------------------------------------------------------------
+ManyNodesBenchmark::ManyNodesBenchmark()
+	: FrameBenchmark("ManyNodes", "nodes")
+{
+}
+//--------------------------------------------------------------------------
+void ManyNodesBenchmark::getSceneSizes(SizeList& sizes) const
+{
+	sizes.push_back(1000);
+	sizes.push_back(10000);
+	sizes.push_back(50000);
+}
+//--------------------------------------------------------------------------
+void ManyNodesBenchmark::createScene(size_t size)
+{
+	const size_t nodesPerGroup = 100;
+	const Real spacing = 10;
+	size_t side = (size_t)Math::Sqrt((Real)size) + 1;
+	Real offset = side * spacing * 0.5f;
+
+	SceneNode* root = mSceneMgr->getRootSceneNode();
+	SceneNode* group = 0;
+	for (size_t i = 0; i < size; ++i)
+	{
+		Vector3 pos((i % side) * spacing - offset, 0, (i / side) * spacing - offset);
+		if (i % nodesPerGroup == 0)
+		{
+			group = root->createChildSceneNode(pos);
+			mGroupNodes.push_back(group);
+		}
+
+		SceneNode* node = group->createChildSceneNode(pos - group->getPosition());
+		node->setScale(0.05f, 0.05f, 0.05f);
+		Entity* ent = mSceneMgr->createEntity("Cube" + StringConverter::toString(i),
+			SceneManager::PT_CUBE);
+		node->attachObject(ent);
+	}
+}
+//--------------------------------------------------------------------------
+void ManyNodesBenchmark::updateScene(Real timeElapsed)
+{
+	Radian turn(timeElapsed * 0.5f);
+	for (NodeList::iterator i = mGroupNodes.begin(); i != mGroupNodes.end(); ++i)
+	{
+		(*i)->yaw(turn);
+	}
+}
+//--------------------------------------------------------------------------
+void ManyNodesBenchmark::destroyScene(void)
+{
+	mGroupNodes.clear();
+	FrameBenchmark::destroyScene();
+}
@@ -0,0 +1,191 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "MeshLodBenchmark.h"
+#include "OgreRoot.h"
+#include "OgreMeshManager.h"
+#include "OgreSubMesh.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreStringConverter.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreMath.h"
+#include "OgreTimer.h"
+
+OGRE_BENCHMARK_REGISTRATION( MeshLodBenchmark );
+
+//--------------------------------------------------------------------------
+MeshLodBenchmark::MeshLodBenchmark()
+	: Benchmark("MeshLod"), mBufferManager(0)
+{
+}
+//--------------------------------------------------------------------------
+void MeshLodBenchmark::setUp(void)
+{
+	if (!HardwareBufferManager::getSingletonPtr())
+		mBufferManager = new DefaultHardwareBufferManager();
+}
+//--------------------------------------------------------------------------
+void MeshLodBenchmark::tearDown(void)
+{
+	destroyMesh();
+	MeshManager::getSingleton().setParallelLodGeneration(false);
+	delete mBufferManager;
+	mBufferManager = 0;
+}
+//--------------------------------------------------------------------------
+void MeshLodBenchmark::createMesh(size_t size)
+{
+	const size_t numSubMeshes = 4;
+	const Real spacing = 10;
+	srand(1);
+
+	mMesh = MeshManager::getSingleton().createManual("MeshLodBenchmark",
+		ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+	size_t numVerts = size * size;
+	size_t numIndexes = (size - 1) * (size - 1) * 6;
+	bool use32BitIndexes = numVerts > 65535;
+
+	for (size_t s = 0; s < numSubMeshes; ++s)
+	{
+		SubMesh* sm = mMesh->createSubMesh();
+		sm->useSharedVertices = false;
+		sm->vertexData = new VertexData();
+		sm->vertexData->vertexCount = numVerts;
+		VertexDeclaration* decl = sm->vertexData->vertexDeclaration;
+		decl->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+		HardwareVertexBufferSharedPtr vbuf = 
+			HardwareBufferManager::getSingleton().createVertexBuffer(
+				decl->getVertexSize(0), numVerts, 
+				HardwareBuffer::HBU_STATIC_WRITE_ONLY, true);
+		sm->vertexData->vertexBufferBinding->setBinding(0, vbuf);
+
+		float* pos = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+		for (size_t z = 0; z < size; ++z)
+		{
+			for (size_t x = 0; x < size; ++x)
+			{
+				*pos++ = x * spacing;
+				*pos++ = Math::UnitRandom() * spacing;
+				*pos++ = (z + s * size) * spacing;
+			}
+		}
+		vbuf->unlock();
+
+		sm->indexData->indexCount = numIndexes;
+		sm->indexData->indexBuffer = 
+			HardwareBufferManager::getSingleton().createIndexBuffer(
+				use32BitIndexes ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
+				numIndexes, HardwareBuffer::HBU_STATIC_WRITE_ONLY, true);
+		std::vector<uint32> indexes;
+		indexes.reserve(numIndexes);
+		for (size_t z = 0; z < size - 1; ++z)
+		{
+			for (size_t x = 0; x < size - 1; ++x)
+			{
+				uint32 i = static_cast<uint32>(z * size + x);
+				indexes.push_back(i);
+				indexes.push_back(i + size);
+				indexes.push_back(i + 1);
+				indexes.push_back(i + 1);
+				indexes.push_back(i + size);
+				indexes.push_back(i + size + 1);
+			}
+		}
+		if (use32BitIndexes)
+		{
+			sm->indexData->indexBuffer->writeData(0, 
+				numIndexes * sizeof(uint32), &indexes[0], true);
+		}
+		else
+		{
+			uint16* pIdx = static_cast<uint16*>(
+				sm->indexData->indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+			for (size_t i = 0; i < numIndexes; ++i)
+				*pIdx++ = static_cast<uint16>(indexes[i]);
+			sm->indexData->indexBuffer->unlock();
+		}
+	}
+
+	mMesh->_setBounds(AxisAlignedBox(0, 0, 0, 
+		size * spacing, spacing, size * numSubMeshes * spacing));
+	mMesh->_setBoundingSphereRadius(size * numSubMeshes * spacing);
+}
+//--------------------------------------------------------------------------
+void MeshLodBenchmark::destroyMesh(void)
+{
+	if (!mMesh.isNull())
+	{
+		MeshManager::getSingleton().remove(mMesh->getHandle());
+		mMesh.setNull();
+	}
+}
+//--------------------------------------------------------------------------
+double MeshLodBenchmark::timeGeneration(bool parallel, size_t iterations)
+{
+	MeshManager::getSingleton().setParallelLodGeneration(parallel);
+	Mesh::LodDistanceList distances;
+	distances.push_back(100);
+	distances.push_back(200);
+	distances.push_back(400);
+	Timer* timer = Root::getSingleton().getTimer();
+
+	unsigned long total = 0;
+	for (size_t i = 0; i < iterations; ++i)
+	{
+		unsigned long start = timer->getMicroseconds();
+		mMesh->generateLodLevels(distances, ProgressiveMesh::VRQ_PROPORTIONAL, 0.5f);
+		total += timer->getMicroseconds() - start;
+	}
+	return (double)total / iterations;
+}
+//--------------------------------------------------------------------------
+void MeshLodBenchmark::run(BenchmarkReport& report)
+{
+	const size_t sizes[] = { 50, 100, 200 };
+	const size_t iterations = 3;
+	WorkerThreadPool& pool = WorkerThreadPool::getSingleton();
+	String threadsVariant = " threads=" + StringConverter::toString(getNumWorkerThreads());
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(size_t); ++s)
+	{
+		createMesh(sizes[s]);
+		String variant = "vertices=" + StringConverter::toString(sizes[s] * sizes[s]) +
+			" submeshes=" + StringConverter::toString(mMesh->getNumSubMeshes());
+
+		pool.setNumWorkerThreads(0);
+		report.addResult(mName, variant + " serial", "generateLodLevels",
+			timeGeneration(false, iterations), "us");
+
+		pool.setNumWorkerThreads(getNumWorkerThreads());
+		report.addResult(mName, variant + threadsVariant, "generateLodLevels",
+			timeGeneration(true, iterations), "us");
+
+		destroyMesh();
+	}
+}
@@ -0,0 +1,96 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ParticleStormBenchmark.h"
+#include "OgreSceneNode.h"
+#include "OgreParticleSystem.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreParticleEmitter.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+
+OGRE_BENCHMARK_REGISTRATION( ParticleStormBenchmark );
+
+//--------------------------------------------------------------------------
+ParticleStormBenchmark::ParticleStormBenchmark()
+	: FrameBenchmark("ParticleStorm", "particles")
+{
+}
+//--------------------------------------------------------------------------
+void ParticleStormBenchmark::run(BenchmarkReport& report)
+{
+	ParticleSystemManager::ParticleEmitterFactoryIterator it =
+		ParticleSystemManager::getSingleton().getEmitterFactoryIterator();
+	while (it.hasMoreElements())
+	{
+		if (it.peekNextKey() == "Point")
+		{
+			FrameBenchmark::run(report);
+			return;
+		}
+		it.moveNext();
+	}
+	LogManager::getSingleton().logMessage(
+		"Skipping benchmark " + mName + ", the Point particle emitter is not available");
+}
+//--------------------------------------------------------------------------
+void ParticleStormBenchmark::getSceneSizes(SizeList& sizes) const
+{
+	sizes.push_back(1000);
+	sizes.push_back(10000);
+	sizes.push_back(50000);
+}
+//--------------------------------------------------------------------------
+void ParticleStormBenchmark::createScene(size_t size)
+{
+	const size_t numSystems = 10;
+	const Real timeToLive = 2;
+	size_t quota = size / numSystems;
+
+	for (size_t i = 0; i < numSystems; ++i)
+	{
+		ParticleSystem* psys = mSceneMgr->createParticleSystem(
+			"Storm" + StringConverter::toString(i), quota);
+		psys->setMaterialName("BaseWhite");
+		psys->setDefaultDimensions(2, 2);
+
+		ParticleEmitter* emitter = psys->addEmitter("Point");
+		emitter->setDirection(Vector3::UNIT_Y);
+		emitter->setAngle(Degree(30));
+		emitter->setParticleVelocity(50, 100);
+		emitter->setTimeToLive(timeToLive);
+		emitter->setEmissionRate(quota / timeToLive);
+
+		Real angle = Math::TWO_PI * i / numSystems;
+		mSceneMgr->getRootSceneNode()->createChildSceneNode(
+			Vector3(Math::Cos(angle), 0, Math::Sin(angle)) * 200)->attachObject(psys);
+
+		// Start from a full storm rather than an empty one
+		psys->fastForward(timeToLive);
+	}
+}
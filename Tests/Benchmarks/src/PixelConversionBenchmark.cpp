@@ -0,0 +1,171 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "PixelConversionBenchmark.h"
+#include "OgreRoot.h"
+#include "OgreStringConverter.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreColourValue.h"
+#include "OgreTimer.h"
+
+OGRE_BENCHMARK_REGISTRATION( PixelConversionBenchmark );
+
+//--------------------------------------------------------------------------
+PixelConversionBenchmark::PixelConversionBenchmark()
+	: Benchmark("PixelConversion")
+{
+}
+//--------------------------------------------------------------------------
+PixelBox PixelConversionBenchmark::createBox(size_t size, PixelFormat format)
+{
+	PixelBox box(size, size, 1, format);
+	box.data = new uchar[box.getConsecutiveSize()];
+	uchar* p = static_cast<uchar*>(box.data);
+	size_t elemSize = PixelUtil::getNumElemBytes(format);
+	for (size_t y = 0; y < size; ++y)
+	{
+		for (size_t x = 0; x < size; ++x)
+		{
+			ColourValue c((Real)x / size, (Real)y / size, 0.5f, 1.0f);
+			PixelUtil::packColour(c, format, p);
+			p += elemSize;
+		}
+	}
+	return box;
+}
+//--------------------------------------------------------------------------
+void PixelConversionBenchmark::destroyBox(PixelBox& box)
+{
+	delete [] static_cast<uchar*>(box.data);
+	box.data = 0;
+}
+//--------------------------------------------------------------------------
+double PixelConversionBenchmark::timeConversion(const PixelBox& src, 
+	const PixelBox& dst, size_t iterations)
+{
+	Timer* timer = Root::getSingleton().getTimer();
+	unsigned long start = timer->getMicroseconds();
+	for (size_t i = 0; i < iterations; ++i)
+		PixelUtil::bulkPixelConversion(src, dst);
+	return (double)(timer->getMicroseconds() - start) / iterations;
+}
+//--------------------------------------------------------------------------
+double PixelConversionBenchmark::timeGenericConversion(const PixelBox& src, 
+	const PixelBox& dst, size_t iterations)
+{
+	Timer* timer = Root::getSingleton().getTimer();
+	size_t numPixels = src.getWidth() * src.getHeight() * src.getDepth();
+	size_t srcElemSize = PixelUtil::getNumElemBytes(src.format);
+	size_t dstElemSize = PixelUtil::getNumElemBytes(dst.format);
+	unsigned long start = timer->getMicroseconds();
+	for (size_t i = 0; i < iterations; ++i)
+	{
+		uchar* srcptr = static_cast<uchar*>(src.data);
+		uchar* dstptr = static_cast<uchar*>(dst.data);
+		float r, g, b, a;
+		for (size_t p = 0; p < numPixels; ++p)
+		{
+			PixelUtil::unpackColour(&r, &g, &b, &a, src.format, srcptr);
+			PixelUtil::packColour(r, g, b, a, dst.format, dstptr);
+			srcptr += srcElemSize;
+			dstptr += dstElemSize;
+		}
+	}
+	return (double)(timer->getMicroseconds() - start) / iterations;
+}
+//--------------------------------------------------------------------------
+double PixelConversionBenchmark::timeScale(const PixelBox& src, 
+	const PixelBox& dst, Image::Filter filter, size_t iterations)
+{
+	Timer* timer = Root::getSingleton().getTimer();
+	unsigned long start = timer->getMicroseconds();
+	for (size_t i = 0; i < iterations; ++i)
+		Image::scale(src, dst, filter);
+	return (double)(timer->getMicroseconds() - start) / iterations;
+}
+//--------------------------------------------------------------------------
+void PixelConversionBenchmark::run(BenchmarkReport& report)
+{
+	const size_t size = 2048;
+	const size_t iterations = 5;
+	WorkerThreadPool& pool = WorkerThreadPool::getSingleton();
+	String threadsVariant = " threads=" + StringConverter::toString(getNumWorkerThreads());
+
+	const PixelFormat conversions[][2] =
+	{
+		{ PF_R8G8B8, PF_B8G8R8A8 },
+		{ PF_A8R8G8B8, PF_A8B8G8R8 },
+		{ PF_FLOAT32_RGBA, PF_FLOAT16_RGBA },
+		{ PF_FLOAT32_RGB, PF_FLOAT16_RGB },
+		{ PF_FLOAT16_RGBA, PF_FLOAT32_RGBA },
+	};
+	for (size_t c = 0; c < sizeof(conversions) / sizeof(conversions[0]); ++c)
+	{
+		PixelBox src = createBox(size, conversions[c][0]);
+		PixelBox dst = createBox(size, conversions[c][1]);
+		String variant = "pixels=" + StringConverter::toString(size * size) + " " +
+			PixelUtil::getFormatName(src.format) + "->" + PixelUtil::getFormatName(dst.format);
+
+		pool.setNumWorkerThreads(0);
+		report.addResult(mName, variant + " generic", "convert",
+			timeGenericConversion(src, dst, iterations), "us");
+		report.addResult(mName, variant + " serial", "convert",
+			timeConversion(src, dst, iterations), "us");
+		pool.setNumWorkerThreads(getNumWorkerThreads());
+		report.addResult(mName, variant + threadsVariant, "convert",
+			timeConversion(src, dst, iterations), "us");
+
+		destroyBox(src);
+		destroyBox(dst);
+	}
+
+	const PixelFormat scaleFormats[] = { PF_A8R8G8B8, PF_FLOAT32_RGBA };
+	for (size_t f = 0; f < sizeof(scaleFormats) / sizeof(PixelFormat); ++f)
+	{
+		PixelBox src = createBox(size, scaleFormats[f]);
+		// Mipmap-like halving, and enlarging to a non power of two
+		const size_t dstSizes[] = { size / 2, size + size / 3 };
+		for (size_t d = 0; d < sizeof(dstSizes) / sizeof(size_t); ++d)
+		{
+			PixelBox dst = createBox(dstSizes[d], scaleFormats[f]);
+			String variant = "from=" + StringConverter::toString(size) + " to=" + 
+				StringConverter::toString(dstSizes[d]) + " " + PixelUtil::getFormatName(src.format);
+
+			pool.setNumWorkerThreads(0);
+			report.addResult(mName, variant + " serial", "scaleBilinear",
+				timeScale(src, dst, Image::FILTER_BILINEAR, iterations), "us");
+			pool.setNumWorkerThreads(getNumWorkerThreads());
+			report.addResult(mName, variant + threadsVariant, "scaleBilinear",
+				timeScale(src, dst, Image::FILTER_BILINEAR, iterations), "us");
+
+			destroyBox(dst);
+		}
+		destroyBox(src);
+	}
+	pool.setNumWorkerThreads(0);
+}
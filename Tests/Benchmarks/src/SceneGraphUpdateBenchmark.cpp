@@ -0,0 +1,212 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "SceneGraphUpdateBenchmark.h"
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreStringConverter.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreMath.h"
+#include "OgreTimer.h"
+
+OGRE_BENCHMARK_REGISTRATION( SceneGraphUpdateBenchmark );
+
+//--------------------------------------------------------------------------
+SceneGraphUpdateBenchmark::BoundsObject::BoundsObject(const String& name, 
+	const AxisAlignedBox& box)
+	: MovableObject(name), mBox(box)
+{
+	mRadius = box.getHalfSize().length();
+}
+//--------------------------------------------------------------------------
+const String& SceneGraphUpdateBenchmark::BoundsObject::getMovableType(void) const
+{
+	static String type = "BenchmarkBounds";
+	return type;
+}
+//--------------------------------------------------------------------------
+SceneGraphUpdateBenchmark::SceneGraphUpdateBenchmark()
+	: Benchmark("SceneGraphUpdate"), mSceneMgr(0)
+{
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateBenchmark::setUp(void)
+{
+	mSceneMgr = Root::getSingleton().createSceneManager(ST_GENERIC);
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateBenchmark::tearDown(void)
+{
+	destroyScene();
+	Root::getSingleton().destroySceneManager(mSceneMgr);
+	mSceneMgr = 0;
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateBenchmark::buildScene(size_t numNodes, TreeShape shape)
+{
+	srand(1);
+	std::vector<SceneNode*>& nodes = mNodes;
+	nodes.reserve(numNodes);
+	nodes.push_back(mSceneMgr->getRootSceneNode());
+	for (size_t i = 1; i < numNodes; ++i)
+	{
+		SceneNode* parent;
+		switch (shape)
+		{
+		case TS_FLAT:
+			parent = nodes[0];
+			break;
+		case TS_BALANCED:
+			parent = nodes[(i - 1) / 8];
+			break;
+		case TS_BINARY:
+			parent = nodes[(i - 1) / 2];
+			break;
+		case TS_RANDOM:
+		default:
+			parent = nodes[rand() % nodes.size()];
+			break;
+		};
+
+		SceneNode* node = parent->createChildSceneNode(
+			Vector3(Math::SymmetricRandom(), Math::SymmetricRandom(), Math::SymmetricRandom()) * 10,
+			Quaternion(Radian(Math::UnitRandom() * Math::TWO_PI), Vector3::UNIT_Y));
+		BoundsObject* obj = new BoundsObject("Bounds" + StringConverter::toString(i), 
+			AxisAlignedBox(-1, -1, -1, 1, 1, 1));
+		node->attachObject(obj);
+		mObjects.push_back(obj);
+		nodes.push_back(node);
+	}
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateBenchmark::destroyScene(void)
+{
+	mSceneMgr->clearScene();
+	mNodes.clear();
+	for (ObjectList::iterator i = mObjects.begin(); i != mObjects.end(); ++i)
+	{
+		delete *i;
+	}
+	mObjects.clear();
+}
+//--------------------------------------------------------------------------
+double SceneGraphUpdateBenchmark::timeUpdates(UpdateMode mode, ChangeKind changes, 
+	size_t iterations)
+{
+	mSceneMgr->setParallelSceneGraphUpdate(mode == UM_PARALLEL);
+	mSceneMgr->setUseNodeTransformStore(mode == UM_TRANSFORM_STORE);
+	// Lay the scene graph out in the store outside of the timings
+	mSceneMgr->_updateSceneGraph(0);
+	Timer* timer = Root::getSingleton().getTimer();
+
+	// The same changes for every mode
+	srand(2);
+	const size_t numNodes = mNodes.size();
+	unsigned long total = 0;
+	for (size_t i = 0; i < iterations; ++i)
+	{
+		if (changes == CK_ALL)
+		{
+			// Force every node to be updated
+			mSceneMgr->getRootSceneNode()->needUpdate();
+		}
+		else
+		{
+			for (size_t n = 0; n < numNodes / 100; ++n)
+			{
+				mNodes[1 + rand() % (numNodes - 1)]->translate(Vector3::UNIT_X);
+			}
+		}
+		if (changes == CK_REPARENT)
+		{
+			// Parents always come before their children in mNodes, so 
+			// picking a new parent earlier in it can't make a cycle
+			for (size_t n = 0; n < numNodes / 1000; ++n)
+			{
+				size_t child = 2 + rand() % (numNodes - 2);
+				SceneNode* node = mNodes[child];
+				SceneNode* oldParent = node->getParentSceneNode();
+				oldParent->removeChild(node);
+				oldParent->needUpdate();
+				mNodes[rand() % child]->addChild(node);
+			}
+		}
+		unsigned long start = timer->getMicroseconds();
+		mSceneMgr->_updateSceneGraph(0);
+		total += timer->getMicroseconds() - start;
+	}
+	return (double)total / iterations;
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateBenchmark::run(BenchmarkReport& report)
+{
+	const size_t nodeCounts[] = { 1000, 10000, 50000 };
+	const TreeShape shapes[] = { TS_FLAT, TS_BALANCED, TS_BINARY, TS_RANDOM };
+	const char* shapeNames[] = { "flat", "balanced", "binary", "random" };
+	const size_t iterations = 20;
+	WorkerThreadPool& pool = WorkerThreadPool::getSingleton();
+	String threadsVariant = " threads=" + StringConverter::toString(getNumWorkerThreads());
+
+	for (size_t c = 0; c < sizeof(nodeCounts) / sizeof(size_t); ++c)
+	{
+		for (size_t s = 0; s < sizeof(shapes) / sizeof(TreeShape); ++s)
+		{
+			buildScene(nodeCounts[c], shapes[s]);
+			String variant = "nodes=" + StringConverter::toString(nodeCounts[c]) +
+				" shape=" + shapeNames[s];
+
+			pool.setNumWorkerThreads(0);
+			report.addResult(mName, variant + " serial", "update", 
+				timeUpdates(UM_SERIAL, CK_ALL, iterations), "us");
+
+			report.addResult(mName, variant + " store", "update", 
+				timeUpdates(UM_TRANSFORM_STORE, CK_ALL, iterations), "us");
+
+			pool.setNumWorkerThreads(getNumWorkerThreads());
+			report.addResult(mName, variant + threadsVariant, "update", 
+				timeUpdates(UM_PARALLEL, CK_ALL, iterations), "us");
+
+			// Partial updates, where the store only sweeps the changed 
+			// subtrees and lays out again only those attached elsewhere
+			pool.setNumWorkerThreads(0);
+			report.addResult(mName, variant + " serial", "update sparse", 
+				timeUpdates(UM_SERIAL, CK_SPARSE, iterations), "us");
+			report.addResult(mName, variant + " store", "update sparse", 
+				timeUpdates(UM_TRANSFORM_STORE, CK_SPARSE, iterations), "us");
+			report.addResult(mName, variant + " serial", "update reparent", 
+				timeUpdates(UM_SERIAL, CK_REPARENT, iterations), "us");
+			report.addResult(mName, variant + " store", "update reparent", 
+				timeUpdates(UM_TRANSFORM_STORE, CK_REPARENT, iterations), "us");
+
+			destroyScene();
+		}
+	}
+	mSceneMgr->setParallelSceneGraphUpdate(false);
+	mSceneMgr->setUseNodeTransformStore(false);
+}
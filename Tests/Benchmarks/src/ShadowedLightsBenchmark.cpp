@@ -0,0 +1,122 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ShadowedLightsBenchmark.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreLight.h"
+#include "OgreMeshManager.h"
+#include "OgreStringConverter.h"
+#include "OgreMath.h"
+
+OGRE_BENCHMARK_REGISTRATION( ShadowedLightsBenchmark );
+
+namespace
+{
+	const String GROUND_MESH = "ShadowedLightsBenchmark/Ground";
+}
+
+//--------------------------------------------------------------------------
+ShadowedLightsBenchmark::ShadowedLightsBenchmark()
+	: FrameBenchmark("ShadowedLights", "lights")
+{
+}
+//--------------------------------------------------------------------------
+void ShadowedLightsBenchmark::tearDown(void)
+{
+	FrameBenchmark::tearDown();
+	MeshManager::getSingleton().remove(GROUND_MESH);
+}
+//--------------------------------------------------------------------------
+void ShadowedLightsBenchmark::getSceneSizes(SizeList& sizes) const
+{
+	sizes.push_back(1);
+	sizes.push_back(2);
+	sizes.push_back(4);
+}
+//--------------------------------------------------------------------------
+void ShadowedLightsBenchmark::createScene(size_t size)
+{
+	mSceneMgr->setShadowTechnique(SHADOWTYPE_TEXTURE_MODULATIVE);
+	mSceneMgr->setShadowTextureSize(512);
+	mSceneMgr->setShadowTextureCount(size);
+	mSceneMgr->setAmbientLight(ColourValue(0.3f, 0.3f, 0.3f));
+
+	if (MeshManager::getSingleton().getByName(GROUND_MESH).isNull())
+	{
+		MeshManager::getSingleton().createPlane(GROUND_MESH,
+			ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+			Plane(Vector3::UNIT_Y, 0), 1000, 1000, 10, 10, true, 1, 1, 1, Vector3::UNIT_Z);
+	}
+	Entity* ground = mSceneMgr->createEntity("Ground", GROUND_MESH);
+	ground->setCastShadows(false);
+	mSceneMgr->getRootSceneNode()->attachObject(ground);
+
+	// 20 x 20 shadow casters
+	const size_t side = 20;
+	const Real spacing = 40;
+	for (size_t i = 0; i < side * side; ++i)
+	{
+		SceneNode* node = mSceneMgr->getRootSceneNode()->createChildSceneNode(
+			Vector3((i % side) * spacing - side * spacing * 0.5f, 10,
+			(i / side) * spacing - side * spacing * 0.5f));
+		node->setScale(0.2f, 0.2f, 0.2f);
+		node->attachObject(mSceneMgr->createEntity(
+			"Caster" + StringConverter::toString(i), SceneManager::PT_CUBE));
+	}
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		Light* light = mSceneMgr->createLight("Spot" + StringConverter::toString(i));
+		light->setType(Light::LT_SPOTLIGHT);
+		light->setSpotlightRange(Degree(40), Degree(60));
+		light->setDiffuseColour(ColourValue::White);
+		mLights.push_back(light);
+	}
+	mLightAngle = 0;
+	updateScene(0);
+}
+//--------------------------------------------------------------------------
+void ShadowedLightsBenchmark::updateScene(Real timeElapsed)
+{
+	mLightAngle += Radian(timeElapsed);
+	for (size_t i = 0; i < mLights.size(); ++i)
+	{
+		Radian angle = mLightAngle + Radian(Math::TWO_PI * i / mLights.size());
+		Vector3 pos(Math::Cos(angle) * 300, 300, Math::Sin(angle) * 300);
+		mLights[i]->setPosition(pos);
+		mLights[i]->setDirection(-pos.normalisedCopy());
+	}
+}
+//--------------------------------------------------------------------------
+void ShadowedLightsBenchmark::destroyScene(void)
+{
+	mLights.clear();
+	FrameBenchmark::destroyScene();
+	mSceneMgr->setShadowTechnique(SHADOWTYPE_NONE);
+}
@@ -0,0 +1,177 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "SkinnedCrowdBenchmark.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreMeshManager.h"
+#include "OgreSkeletonManager.h"
+#include "OgreSkeleton.h"
+#include "OgreBone.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationState.h"
+#include "OgreKeyFrame.h"
+#include "OgreStringConverter.h"
+#include "OgreMath.h"
+
+OGRE_BENCHMARK_REGISTRATION( SkinnedCrowdBenchmark );
+
+namespace
+{
+	const String FIGURE_MESH = "SkinnedCrowdBenchmark/Figure";
+	const String FIGURE_SKELETON = "SkinnedCrowdBenchmark/Figure.skeleton";
+	const unsigned short NUM_BONES = 8;
+	const int FIGURE_COLUMNS = 4;
+	const int FIGURE_ROWS = 32;
+	const Real FIGURE_HEIGHT = 80;
+}
+
+//--------------------------------------------------------------------------
+SkinnedCrowdBenchmark::SkinnedCrowdBenchmark()
+	: FrameBenchmark("SkinnedCrowd", "entities")
+{
+}
+//--------------------------------------------------------------------------
+void SkinnedCrowdBenchmark::setUp(void)
+{
+	FrameBenchmark::setUp();
+	createFigure();
+}
+//--------------------------------------------------------------------------
+void SkinnedCrowdBenchmark::tearDown(void)
+{
+	FrameBenchmark::tearDown();
+	MeshManager::getSingleton().remove(FIGURE_MESH);
+	SkeletonManager::getSingleton().remove(FIGURE_SKELETON);
+}
+//--------------------------------------------------------------------------
+void SkinnedCrowdBenchmark::createFigure(void)
+{
+	const String& group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+	SkeletonPtr skel = SkeletonManager::getSingleton().create(FIGURE_SKELETON, group, true);
+
+	// A chain of bones from the feet to the head
+	Real boneLength = FIGURE_HEIGHT / NUM_BONES;
+	Bone* bone = skel->createBone(0);
+	bone->setPosition(0, -FIGURE_HEIGHT * 0.5f, 0);
+	for (unsigned short b = 1; b < NUM_BONES; ++b)
+	{
+		bone = bone->createChild(b, Vector3(0, boneLength, 0));
+	}
+	skel->setBindingPose();
+
+	Animation* anim = skel->createAnimation("Sway", 2);
+	for (unsigned short b = 0; b < NUM_BONES; ++b)
+	{
+		NodeAnimationTrack* track = anim->createNodeTrack(b, skel->getBone(b));
+		track->createNodeKeyFrame(0);
+		TransformKeyFrame* kf = track->createNodeKeyFrame(1);
+		kf->setRotation(Quaternion(Degree(10), Vector3::UNIT_Z));
+		track->createNodeKeyFrame(2);
+	}
+
+	MeshPtr mesh = MeshManager::getSingleton().createPlane(FIGURE_MESH, group,
+		Plane(Vector3::UNIT_Z, 0), FIGURE_HEIGHT * 0.25f, FIGURE_HEIGHT,
+		FIGURE_COLUMNS, FIGURE_ROWS);
+	mesh->setSkeletonName(FIGURE_SKELETON);
+
+	// Plane vertices are laid out row by row from the bottom, blend each
+	// row between the two nearest bones
+	for (int y = 0; y <= FIGURE_ROWS; ++y)
+	{
+		Real bonePos = (Real)y / FIGURE_ROWS * (NUM_BONES - 1);
+		unsigned short lower = (unsigned short)bonePos;
+		unsigned short upper = std::min((unsigned short)(lower + 1), (unsigned short)(NUM_BONES - 1));
+		Real upperWeight = bonePos - lower;
+		for (int x = 0; x <= FIGURE_COLUMNS; ++x)
+		{
+			VertexBoneAssignment vba;
+			vba.vertexIndex = y * (FIGURE_COLUMNS + 1) + x;
+			vba.boneIndex = lower;
+			vba.weight = 1 - upperWeight;
+			mesh->addBoneAssignment(vba);
+			if (upper != lower && upperWeight > 0)
+			{
+				vba.boneIndex = upper;
+				vba.weight = upperWeight;
+				mesh->addBoneAssignment(vba);
+			}
+		}
+	}
+}
+//--------------------------------------------------------------------------
+void SkinnedCrowdBenchmark::getSceneSizes(SizeList& sizes) const
+{
+	sizes.push_back(10);
+	sizes.push_back(100);
+	sizes.push_back(500);
+}
+//--------------------------------------------------------------------------
+void SkinnedCrowdBenchmark::createScene(size_t size)
+{
+	const Real spacing = 30;
+	size_t side = (size_t)Math::Sqrt((Real)size) + 1;
+	Real offset = side * spacing * 0.5f;
+
+	srand(1);
+	for (size_t i = 0; i < size; ++i)
+	{
+		Entity* ent = mSceneMgr->createEntity("Figure" + StringConverter::toString(i),
+			FIGURE_MESH);
+		AnimationState* state = ent->getAnimationState("Sway");
+		state->setEnabled(true);
+		// Spread the crowd over the animation
+		state->setTimePosition(Math::UnitRandom() * state->getLength());
+
+		mSceneMgr->getRootSceneNode()->createChildSceneNode(
+			Vector3((i % side) * spacing - offset, 0, (i / side) * spacing - offset))
+			->attachObject(ent);
+		mEntities.push_back(ent);
+		mAnimationStates.push_back(state);
+	}
+}
+//--------------------------------------------------------------------------
+void SkinnedCrowdBenchmark::updateScene(Real timeElapsed)
+{
+	for (AnimationStateList::iterator i = mAnimationStates.begin();
+		i != mAnimationStates.end(); ++i)
+	{
+		(*i)->addTime(timeElapsed);
+	}
+	for (EntityList::iterator i = mEntities.begin(); i != mEntities.end(); ++i)
+	{
+		(*i)->_updateAnimation();
+	}
+}
+//--------------------------------------------------------------------------
+void SkinnedCrowdBenchmark::destroyScene(void)
+{
+	mEntities.clear();
+	mAnimationStates.clear();
+	FrameBenchmark::destroyScene();
+}
@@ -0,0 +1,87 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "StaticCityBenchmark.h"
+#include "OgreCamera.h"
+#include "OgreEntity.h"
+#include "OgreStaticGeometry.h"
+#include "OgreMath.h"
+
+OGRE_BENCHMARK_REGISTRATION( StaticCityBenchmark );
+
+//--------------------------------------------------------------------------
+StaticCityBenchmark::StaticCityBenchmark()
+	: FrameBenchmark("StaticCity", "buildings")
+{
+}
+//--------------------------------------------------------------------------
+void StaticCityBenchmark::getSceneSizes(SizeList& sizes) const
+{
+	sizes.push_back(1000);
+	sizes.push_back(10000);
+	sizes.push_back(40000);
+}
+//--------------------------------------------------------------------------
+void StaticCityBenchmark::createScene(size_t size)
+{
+	const Real blockSize = 40;
+	size_t side = (size_t)Math::Sqrt((Real)size) + 1;
+	Real offset = side * blockSize * 0.5f;
+
+	srand(1);
+	Entity* building = mSceneMgr->createEntity("Building", SceneManager::PT_CUBE);
+	StaticGeometry* city = mSceneMgr->createStaticGeometry("City");
+	city->setRegionDimensions(Vector3(500, 1000, 500));
+	for (size_t i = 0; i < size; ++i)
+	{
+		// Prefab cube is 100 units across and centred on the origin
+		Real height = Math::RangeRandom(20, 200);
+		Vector3 scale(0.25f, height / 100, 0.25f);
+		Vector3 pos((i % side) * blockSize - offset, height * 0.5f,
+			(i / side) * blockSize - offset);
+		city->addEntity(building, pos, Quaternion::IDENTITY, scale);
+	}
+	city->build();
+	mSceneMgr->destroyEntity(building);
+
+	mCameraAngle = 0;
+}
+//--------------------------------------------------------------------------
+void StaticCityBenchmark::updateScene(Real timeElapsed)
+{
+	mCameraAngle += Radian(timeElapsed * 0.2f);
+	mCamera->setPosition(Math::Cos(mCameraAngle) * 800, 400, Math::Sin(mCameraAngle) * 800);
+	mCamera->lookAt(Vector3::ZERO);
+}
+//--------------------------------------------------------------------------
+void StaticCityBenchmark::destroyScene(void)
+{
+	FrameBenchmark::destroyScene();
+	mCamera->setPosition(0, 300, 600);
+	mCamera->lookAt(Vector3::ZERO);
+}
@@ -0,0 +1,201 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "OgreRoot.h"
+#include "OgreLogManager.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreRenderSystem.h"
+#include "OgreException.h"
+#include "OgreProfiler.h"
+#include <fstream>
+#include <cstdlib>
+
+#ifndef OGRE_BENCHMARK_PLUGINDIR
+#	define OGRE_BENCHMARK_PLUGINDIR "."
+#endif
+
+void printUsage(void)
+{
+	std::cout << "Usage: OgreBenchmarks [-t threads] [-f frames] [-d plugindir] [-p plugin ...] "
+		"[-c trace.json] [-o output.csv] [benchmark ...]" << std::endl
+		<< "  -t  number of worker threads to compare against serial execution (default 3)" << std::endl
+		<< "  -f  number of frames rendering benchmarks measure (default 100)" << std::endl
+		<< "  -d  folder to load plugins from (default " OGRE_BENCHMARK_PLUGINDIR ")" << std::endl
+		<< "  -p  plugin to load, may be repeated (default RenderSystem_Null and Plugin_ParticleFX)" << std::endl
+		<< "  -c  capture profile events to a Chrome trace file (needs OGRE_PROFILING)" << std::endl
+		<< "  -o  write results to a file instead of stdout" << std::endl
+		<< "  benchmark names restrict the run to those benchmarks; available:" << std::endl;
+	const BenchmarkRegistry::BenchmarkList& benchmarks = 
+		BenchmarkRegistry::getSingleton().getBenchmarks();
+	for (BenchmarkRegistry::BenchmarkList::const_iterator i = benchmarks.begin(); 
+		i != benchmarks.end(); ++i)
+	{
+		std::cout << "    " << (*i)->getName() << std::endl;
+	}
+}
+
+/** Loads the given plugins and, if one of them provides a render system,
+	initialises Root and creates the window shared by rendering benchmarks.
+*/
+void initialiseRendering(Root* root, const String& pluginFolder, const StringVector& plugins)
+{
+	for (StringVector::const_iterator i = plugins.begin(); i != plugins.end(); ++i)
+	{
+		try
+		{
+			root->loadPlugin(pluginFolder.empty() ? *i : pluginFolder + "/" + *i);
+		}
+		catch (Exception& e)
+		{
+			// Benchmarks which need the plugin will be skipped
+			LogManager::getSingleton().logMessage("Unable to load plugin " + *i + 
+				": " + e.getFullDescription());
+		}
+	}
+
+	RenderSystemList* renderers = root->getAvailableRenderers();
+	if (renderers->empty())
+		return;
+
+	root->setRenderSystem(renderers->front());
+	root->initialise(false);
+	Benchmark::setRenderWindow(
+		root->createRenderWindow("OgreBenchmarks", 800, 600, false));
+}
+
+int main(int argc, char** argv)
+{
+	String outputFile;
+	String captureFile;
+	String pluginFolder = OGRE_BENCHMARK_PLUGINDIR;
+	StringVector plugins;
+	std::set<String> selected;
+	for (int i = 1; i < argc; ++i)
+	{
+		String arg = argv[i];
+		if (arg == "-t" && i + 1 < argc)
+		{
+			Benchmark::setNumWorkerThreads(atoi(argv[++i]));
+		}
+		else if (arg == "-f" && i + 1 < argc)
+		{
+			Benchmark::setNumFrames(atoi(argv[++i]));
+		}
+		else if (arg == "-d" && i + 1 < argc)
+		{
+			pluginFolder = argv[++i];
+		}
+		else if (arg == "-p" && i + 1 < argc)
+		{
+			plugins.push_back(argv[++i]);
+		}
+		else if (arg == "-c" && i + 1 < argc)
+		{
+			captureFile = argv[++i];
+		}
+		else if (arg == "-o" && i + 1 < argc)
+		{
+			outputFile = argv[++i];
+		}
+		else if (arg == "-h" || arg == "--help")
+		{
+			printUsage();
+			return 0;
+		}
+		else
+		{
+			selected.insert(arg);
+		}
+	}
+
+	// Keep the log off the console so that results can be piped
+	LogManager* logMgr = new LogManager();
+	logMgr->createLog("OgreBenchmarks.log", true, false);
+	Root* root = new Root("", "", "OgreBenchmarks.log");
+	if (plugins.empty())
+	{
+		plugins.push_back("RenderSystem_Null");
+		plugins.push_back("Plugin_ParticleFX");
+	}
+	initialiseRendering(root, pluginFolder, plugins);
+
+	Profiler* profiler = Profiler::getSingletonPtr();
+	if (!captureFile.empty())
+	{
+		if (profiler)
+			profiler->beginCapture();
+		else
+			LogManager::getSingleton().logMessage(
+				"Profile capture requested but OGRE was built without OGRE_PROFILING");
+	}
+
+	BenchmarkReport report;
+	const BenchmarkRegistry::BenchmarkList& benchmarks = 
+		BenchmarkRegistry::getSingleton().getBenchmarks();
+	for (BenchmarkRegistry::BenchmarkList::const_iterator i = benchmarks.begin(); 
+		i != benchmarks.end(); ++i)
+	{
+		Benchmark* b = *i;
+		if (!selected.empty() && selected.find(b->getName()) == selected.end())
+			continue;
+		if (b->requiresRenderWindow() && !Benchmark::getRenderWindow())
+		{
+			LogManager::getSingleton().logMessage("Skipping benchmark " + b->getName() + 
+				", no render system is available");
+			continue;
+		}
+
+		LogManager::getSingleton().logMessage("Running benchmark " + b->getName());
+		b->setUp();
+		b->run(report);
+		b->tearDown();
+		// Leave the pool as we found it for the next benchmark
+		WorkerThreadPool::getSingleton().setNumWorkerThreads(0);
+	}
+
+	if (!captureFile.empty() && profiler)
+	{
+		profiler->endCapture();
+		profiler->saveCapture(captureFile);
+	}
+
+	if (outputFile.empty())
+	{
+		report.writeCSV(std::cout);
+	}
+	else
+	{
+		std::ofstream ofs(outputFile.c_str());
+		report.writeCSV(ofs);
+	}
+
+	delete root;
+	delete logMgr;
+	return 0;
+}
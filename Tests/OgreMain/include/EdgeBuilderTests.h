@@ -40,6 +40,7 @@ class EdgeBuilderTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testSingleIndexBufSingleVertexBuf);
     CPPUNIT_TEST(testMultiIndexBufSingleVertexBuf);
     CPPUNIT_TEST(testMultiIndexBufMultiVertexBuf);
+    CPPUNIT_TEST(testWeldedNonManifoldEdges);
     CPPUNIT_TEST_SUITE_END();
 protected:
     HardwareBufferManager* mBufMgr;
@@ -50,5 +51,6 @@ public:
     void testSingleIndexBufSingleVertexBuf();
     void testMultiIndexBufSingleVertexBuf();
     void testMultiIndexBufMultiVertexBuf();
+    void testWeldedNonManifoldEdges();
 
 };
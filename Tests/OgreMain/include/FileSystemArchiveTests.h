@@ -46,6 +46,7 @@ class FileSystemArchiveTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testFindFileInfoRecursive);
     CPPUNIT_TEST(testFileRead);
     CPPUNIT_TEST(testReadInterleave);
+    CPPUNIT_TEST(testMappedFileRead);
     CPPUNIT_TEST_SUITE_END();
 protected:
     String testPath;
@@ -63,5 +64,6 @@ public:
     void testFindFileInfoRecursive();
     void testFileRead();
     void testReadInterleave();
+    void testMappedFileRead();
 
 };
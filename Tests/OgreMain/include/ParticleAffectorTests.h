@@ -0,0 +1,80 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreParticleSystem.h"
+
+using namespace Ogre;
+
+class ParticleAffectorTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( ParticleAffectorTests );
+    CPPUNIT_TEST(testLinearForce);
+    CPPUNIT_TEST(testColourFader);
+    CPPUNIT_TEST(testColourFader2);
+    CPPUNIT_TEST(testColourInterpolator);
+    CPPUNIT_TEST(testDeflectorPlane);
+    CPPUNIT_TEST(testDirectionRandomiser);
+    CPPUNIT_TEST(testRotation);
+    CPPUNIT_TEST(testScale);
+    CPPUNIT_TEST(testExpiryKeepsOrder);
+    CPPUNIT_TEST(testMotion);
+    CPPUNIT_TEST(testListRendererCallbacks);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    Root* mRoot;
+    NullRenderSystem* mRenderSystem;
+    ControllerManager* mControllerManager;
+    SceneManager* mSceneMgr;
+    /// System the affectors under test run on
+    ParticleSystem* mSystem;
+    /// System the per-particle reference code runs on
+    ParticleSystem* mReference;
+
+    ParticleSystem* createSystem(const String& name);
+    void fillSystem(ParticleSystem* system);
+    void checkSystemsEqual(void);
+public:
+    void setUp();
+    void tearDown();
+    void testLinearForce();
+    void testColourFader();
+    void testColourFader2();
+    void testColourInterpolator();
+    void testDeflectorPlane();
+    void testDirectionRandomiser();
+    void testRotation();
+    void testScale();
+    void testExpiryKeepsOrder();
+    void testMotion();
+    void testListRendererCallbacks();
+};
@@ -29,6 +29,7 @@ Torus Knot Software Ltd.
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "OgrePixelFormat.h"
+#include "OgreImage.h"
 
 using namespace Ogre;
 
@@ -39,6 +40,9 @@ class PixelFormatTests : public CppUnit::TestFixture
     CPPUNIT_TEST( testIntegerPackUnpack );
     CPPUNIT_TEST( testFloatPackUnpack );
     CPPUNIT_TEST( testBulkConversion );
+    CPPUNIT_TEST( testFloat16BulkConversion );
+    CPPUNIT_TEST( testParallelBulkConversion );
+    CPPUNIT_TEST( testParallelScale );
     CPPUNIT_TEST_SUITE_END();
 public:
     void setUp();
@@ -47,10 +51,17 @@ public:
     void testIntegerPackUnpack();
     void testFloatPackUnpack();
     void testBulkConversion();
+    void testFloat16BulkConversion();
+    void testParallelBulkConversion();
+    void testParallelScale();
 
     // Utils
     void setupBoxes(PixelFormat srcFormat, PixelFormat dstFormat);
     void testCase(PixelFormat srcFormat, PixelFormat dstFormat);
+    void testParallelConversionCase(PixelFormat srcFormat, PixelFormat dstFormat,
+        size_t width, size_t height, size_t depth, const Box& srcBox, const Box& dstBox);
+    void testParallelScaleCase(PixelFormat srcFormat, PixelFormat dstFormat,
+        Image::Filter filter);
 private:
     int size;
     uint8 *randomData;
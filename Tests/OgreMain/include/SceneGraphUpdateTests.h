@@ -0,0 +1,78 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreMovableObject.h"
+
+using namespace Ogre;
+
+class SceneGraphUpdateTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( SceneGraphUpdateTests );
+    CPPUNIT_TEST(testParallelUpdateMatchesSerial);
+    CPPUNIT_TEST(testParallelUpdateShallowSplit);
+    CPPUNIT_TEST(testTransformStoreMatchesSerial);
+    CPPUNIT_TEST(testTransformStoreHierarchyChanges);
+    CPPUNIT_TEST(testTransformStoreSubtreeChanges);
+    CPPUNIT_TEST(testTransformStoreSparseUpdate);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    Root* mRoot;
+    SceneManager* mSerialSceneMgr;
+    SceneManager* mParallelSceneMgr;
+    std::vector<MovableObject*> mObjects;
+
+    /// How compareUpdates changes the shape of the scene every frame
+    enum ReshapeMode
+    {
+        /// Not at all
+        RM_NONE,
+        /// Moves a few branches directly under the root
+        RM_TO_ROOT,
+        /// Moves branches between branches, destroys nodes in the middle of
+        /// the hierarchy and attaches the orphaned children again
+        RM_ANYWHERE
+    };
+
+    void buildScene(SceneManager* sm, std::vector<SceneNode*>& nodes);
+    void reshapeScene(SceneManager* sm, std::vector<SceneNode*>& nodes, 
+        std::vector<size_t>& orphans, int frame);
+    void compareUpdates(bool exact, ReshapeMode reshape);
+public:
+    void setUp();
+    void tearDown();
+    void testParallelUpdateMatchesSerial();
+    void testParallelUpdateShallowSplit();
+    void testTransformStoreMatchesSerial();
+    void testTransformStoreHierarchyChanges();
+    void testTransformStoreSubtreeChanges();
+    void testTransformStoreSparseUpdate();
+};
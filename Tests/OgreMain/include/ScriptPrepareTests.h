@@ -0,0 +1,72 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreScriptCompiler.h"
+
+using namespace Ogre;
+
+class ScriptPrepareTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( ScriptPrepareTests );
+    CPPUNIT_TEST(testMatchesSerialParse);
+    CPPUNIT_TEST(testPreparedTreesUsed);
+    CPPUNIT_TEST(testUnprepareReleasesStreams);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    /// Records the concrete nodes of each script as it is compiled
+    class DumpingListener : public ScriptCompilerListener
+    {
+    public:
+        StringVector* dumps;
+
+        DumpingListener() : dumps(0) {}
+        void preConversion(ScriptCompiler* compiler, ConcreteNodeListPtr nodes);
+    };
+
+    Root* mRoot;
+    DumpingListener mListener;
+    /// Text of the scripts, which the streams read from
+    std::vector<String> mScripts;
+    DataStreamList mStreams;
+
+    void createScripts(size_t count);
+    /// Opens streams on the scripts, parsing them in parallel if prepare is set
+    void openScripts(bool prepare);
+    /// Compiles the streams in order, returning a dump of the concrete nodes of each
+    void compileScripts(StringVector& dumps);
+public:
+    void setUp();
+    void tearDown();
+    void testMatchesSerialParse();
+    void testPreparedTreesUsed();
+    void testUnprepareReleasesStreams();
+};
@@ -0,0 +1,78 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __TestBoxObject_H__
+#define __TestBoxObject_H__
+
+#include "OgreMovableObject.h"
+
+using namespace Ogre;
+
+/// Object with fixed bounds, which needs no resources
+class BoxObject : public MovableObject
+{
+protected:
+    AxisAlignedBox mBox;
+    Real mRadius;
+public:
+    static const String& getTypeName(void)
+    { static String type = "TestBox"; return type; }
+
+    BoxObject(const String& name) : MovableObject(name), mRadius(0) {}
+    BoxObject(const String& name, const AxisAlignedBox& box) 
+        : MovableObject(name) 
+    { setBox(box); }
+    void setBox(const AxisAlignedBox& box)
+    {
+        mBox = box;
+        mRadius = box.getHalfSize().length();
+    }
+    /// Cube of the given half size centred on the origin
+    void setSize(Real size) 
+    { setBox(AxisAlignedBox(-size, -size, -size, size, size, size)); }
+    void setInfinite(void) { mBox.setInfinite(); }
+
+    const String& getMovableType(void) const { return getTypeName(); }
+    const AxisAlignedBox& getBoundingBox(void) const { return mBox; }
+    Real getBoundingRadius(void) const { return mRadius; }
+    void _updateRenderQueue(RenderQueue* queue) {}
+    void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables) {}
+};
+
+/// Lets scene managers create BoxObject instances
+class BoxObjectFactory : public MovableObjectFactory
+{
+protected:
+    MovableObject* createInstanceImpl(const String& name, const NameValuePairList* params)
+    { return new BoxObject(name); }
+public:
+    const String& getType(void) const { return BoxObject::getTypeName(); }
+    void destroyInstance(MovableObject* obj) { delete obj; }
+};
+
+#endif
@@ -0,0 +1,68 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#ifndef __TestNullRenderSetup_H__
+#define __TestNullRenderSetup_H__
+
+#include "OgreRoot.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreNullRenderSystem.h"
+
+using namespace Ogre;
+
+/** Root, render system and buffer manager for scene tests without a window.
+@remarks
+    Cameras need a render system to convert their projection matrix, and 
+    vertex buffers, which the render system would only supply with a window,
+    so the Null render system is set but not initialised and buffers come 
+    from a DefaultHardwareBufferManager. Create scene managers after this 
+    and destroy them before it.
+*/
+class NullRenderSetup
+{
+public:
+    Root* root;
+    RenderSystem* renderSystem;
+    HardwareBufferManager* bufMgr;
+
+    NullRenderSetup()
+    {
+        root = new Root("", "", "");
+        renderSystem = new NullRenderSystem();
+        root->setRenderSystem(renderSystem);
+        bufMgr = new DefaultHardwareBufferManager();
+    }
+    ~NullRenderSetup()
+    {
+        delete bufMgr;
+        delete root;
+        delete renderSystem;
+    }
+};
+
+#endif
@@ -0,0 +1,172 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "AnimationSamplingTests.h"
+#include "OgreKeyFrame.h"
+#include "OgreAnimationState.h"
+#include "OgreMath.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( AnimationSamplingTests );
+
+void AnimationSamplingTests::setUp()
+{
+    // Two tracks whose keyframes are at different times
+    mAnim = new Animation("Test", 10);
+    mTrack1 = mAnim->createNodeTrack(0);
+    mTrack2 = mAnim->createNodeTrack(1);
+    for (int k = 0; k <= 10; ++k)
+    {
+        TransformKeyFrame* kf = mTrack1->createNodeKeyFrame((Real)k);
+        kf->setTranslate(Vector3((Real)k, (Real)(k * k), 0));
+        kf->setRotation(Quaternion(Degree((Real)(k * 30)), Vector3::UNIT_Y));
+    }
+    // Create these out of order, to check the times are kept in order
+    for (int k = 7; k >= 0; --k)
+    {
+        TransformKeyFrame* kf = mTrack2->createNodeKeyFrame(k * 1.3f);
+        kf->setTranslate(Vector3(0, 0, (Real)k));
+    }
+}
+void AnimationSamplingTests::tearDown()
+{
+    delete mAnim;
+}
+
+void AnimationSamplingTests::sampleKeyFrames(NodeAnimationTrack* track, 
+    const TimeIndex& timeIndex, Vector3& translate, Quaternion& rotate)
+{
+    KeyFrame *kf1, *kf2;
+    Real t = track->getKeyFramesAtTime(timeIndex, &kf1, &kf2);
+    TransformKeyFrame* k1 = static_cast<TransformKeyFrame*>(kf1);
+    TransformKeyFrame* k2 = static_cast<TransformKeyFrame*>(kf2);
+    translate = k1->getTranslate() + (k2->getTranslate() - k1->getTranslate()) * t;
+    rotate = Quaternion::nlerp(t, k1->getRotation(), k2->getRotation(), true);
+}
+
+void AnimationSamplingTests::testCursorMatchesSearch()
+{
+    uint cursor = 0;
+    srand(5);
+    Real timePos = 0;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        // Mostly small steps forward, sometimes a jump anywhere
+        if (i % 97 == 0)
+            timePos = Math::RangeRandom(0, 30);
+        else
+            timePos += Math::RangeRandom(0, 0.5f);
+
+        TimeIndex searched = mAnim->_getTimeIndex(timePos);
+        TimeIndex stepped = mAnim->_getTimeIndex(timePos, cursor);
+        CPPUNIT_ASSERT_EQUAL(searched.getTimePos(), stepped.getTimePos());
+        CPPUNIT_ASSERT_EQUAL(searched.getKeyIndex(), stepped.getKeyIndex());
+        CPPUNIT_ASSERT_EQUAL(searched.getKeyIndex(), cursor);
+    }
+
+    // Out of range cursors are searched over
+    cursor = 1000;
+    CPPUNIT_ASSERT_EQUAL(mAnim->_getTimeIndex(3.5f).getKeyIndex(), 
+        mAnim->_getTimeIndex(3.5f, cursor).getKeyIndex());
+
+    // Whole loops wrap to the end of the animation
+    CPPUNIT_ASSERT_EQUAL((Real)10, mAnim->_getTimeIndex(20).getTimePos());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, mAnim->_getTimeIndex(22.5f).getTimePos(), 1e-4);
+}
+
+void AnimationSamplingTests::testStateCursorPerAnimation()
+{
+    // A second animation played by the same state, with keyframes at other times
+    Animation other("Other", 10);
+    NodeAnimationTrack* track = other.createNodeTrack(0);
+    for (int k = 0; k <= 40; ++k)
+        track->createNodeKeyFrame(k * 0.25f);
+
+    AnimationStateSet stateSet;
+    const AnimationState* state = stateSet.createAnimationState("Test", 0, 10);
+    CPPUNIT_ASSERT(&state->_getKeyFrameCursor(mAnim) != 
+        &state->_getKeyFrameCursor(&other));
+    CPPUNIT_ASSERT(&state->_getKeyFrameCursor(mAnim) == 
+        &state->_getKeyFrameCursor(mAnim));
+
+    // Each animation steps on from its own keyframe
+    for (Real timePos = 0; timePos < 10; timePos += 0.1f)
+    {
+        uint& cursor = state->_getKeyFrameCursor(mAnim);
+        uint& otherCursor = state->_getKeyFrameCursor(&other);
+        mAnim->_getTimeIndex(timePos, cursor);
+        other._getTimeIndex(timePos, otherCursor);
+        CPPUNIT_ASSERT_EQUAL(mAnim->_getTimeIndex(timePos).getKeyIndex(), cursor);
+        CPPUNIT_ASSERT_EQUAL(other._getTimeIndex(timePos).getKeyIndex(), otherCursor);
+    }
+}
+
+void AnimationSamplingTests::testSamplesMatchKeyFrames()
+{
+    TransformKeyFrame kf(0, 0);
+    for (Real timePos = 0; timePos < 25; timePos += 0.37f)
+    {
+        // With and without the global keyframe index
+        TimeIndex indices[2] = { mAnim->_getTimeIndex(timePos), TimeIndex(timePos) };
+        for (size_t i = 0; i < 2; ++i)
+        {
+            Vector3 translate;
+            Quaternion rotate;
+            sampleKeyFrames(mTrack1, indices[i], translate, rotate);
+            mTrack1->getInterpolatedKeyFrame(indices[i], &kf);
+            CPPUNIT_ASSERT(translate.positionEquals(kf.getTranslate(), 1e-4));
+            CPPUNIT_ASSERT(rotate.equals(kf.getRotation(), Radian(1e-3)));
+
+            sampleKeyFrames(mTrack2, indices[i], translate, rotate);
+            mTrack2->getInterpolatedKeyFrame(indices[i], &kf);
+            CPPUNIT_ASSERT(translate.positionEquals(kf.getTranslate(), 1e-4));
+        }
+    }
+}
+
+void AnimationSamplingTests::testKeyFrameChanges()
+{
+    TransformKeyFrame kf(0, 0);
+    mTrack1->getInterpolatedKeyFrame(mAnim->_getTimeIndex(2), &kf);
+    CPPUNIT_ASSERT(kf.getTranslate().positionEquals(Vector3(2, 4, 0)));
+
+    // Editing a keyframe must show in the next sample
+    mTrack1->getNodeKeyFrame(2)->setTranslate(Vector3(-1, -1, -1));
+    mTrack1->getInterpolatedKeyFrame(mAnim->_getTimeIndex(2), &kf);
+    CPPUNIT_ASSERT(kf.getTranslate().positionEquals(Vector3(-1, -1, -1)));
+
+    // As must removing and adding keyframes
+    mTrack1->removeKeyFrame(2);
+    mTrack1->getInterpolatedKeyFrame(mAnim->_getTimeIndex(2), &kf);
+    CPPUNIT_ASSERT(kf.getTranslate().positionEquals(Vector3(2, 5, 0)));
+    mTrack1->createNodeKeyFrame(2)->setTranslate(Vector3(7, 7, 7));
+    mTrack1->getInterpolatedKeyFrame(mAnim->_getTimeIndex(2), &kf);
+    CPPUNIT_ASSERT(kf.getTranslate().positionEquals(Vector3(7, 7, 7)));
+    mTrack1->getInterpolatedKeyFrame(mAnim->_getTimeIndex(1.5f), &kf);
+    CPPUNIT_ASSERT(kf.getTranslate().positionEquals(Vector3(4, 4, 3.5f)));
+}
@@ -0,0 +1,296 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "CompositorPoolingTests.h"
+#include "OgreCompositorManager.h"
+#include "OgreCompositorChain.h"
+#include "OgreCompositor.h"
+#include "OgreCompositionTechnique.h"
+#include "OgreCompositionTargetPass.h"
+#include "OgreCompositionPass.h"
+#include "OgreMaterialManager.h"
+#include "OgreTextureManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreRenderWindow.h"
+#include "OgreSceneManager.h"
+#include "OgreNullRenderSystem.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( CompositorPoolingTests );
+
+namespace
+{
+    const String COMPOSITOR_NAME = "PoolingTest/Chain";
+    const String POOL_PREFIX = "CompositorPool/";
+
+    CompositionTargetPass* addQuadTarget(CompositionTechnique* tech, 
+        const String& output, const String& input)
+    {
+        CompositionTargetPass* target = tech->createTargetPass();
+        target->setOutputName(output);
+        target->setInputMode(CompositionTargetPass::IM_NONE);
+        CompositionPass* pass = target->createPass();
+        pass->setType(CompositionPass::PT_RENDERQUAD);
+        pass->setMaterialName("PoolingTest/Quad");
+        pass->setInput(0, input);
+        return target;
+    }
+}
+
+void CompositorPoolingTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    mRenderSystem = new NullRenderSystem();
+    mRoot->setRenderSystem(mRenderSystem);
+    mRenderSystem->_initialise(false);
+    mWindow = mRenderSystem->_createRenderWindow("CompositorPooling", 256, 256, false);
+    // Provides the default settings of new materials
+    MaterialManager::getSingleton().initialise();
+    mSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+    mCamera = mSceneMgr->createCamera("Camera");
+    mViewport = mWindow->addViewport(mCamera, 0);
+    mOtherViewport = mWindow->addViewport(mCamera, 1);
+    createCompositor();
+}
+void CompositorPoolingTests::tearDown()
+{
+    // Free the textures while the render system's texture manager is there
+    CompositorManager::getSingleton().removeAll();
+    mRoot->destroySceneManager(mSceneMgr);
+    mRenderSystem->shutdown();
+    delete mRoot;
+    delete mRenderSystem;
+}
+
+void CompositorPoolingTests::createCompositor(void)
+{
+    MaterialPtr mat = MaterialManager::getSingleton().create("PoolingTest/Quad",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    mat->getTechnique(0)->getPass(0)->createTextureUnitState();
+
+    CompositorPtr comp = CompositorManager::getSingleton().create(COMPOSITOR_NAME, 
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    CompositionTechnique* tech = comp->createTechnique();
+    const char* names[] = { "scene", "a", "b", "c", "feedback" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+    {
+        CompositionTechnique::TextureDefinition* def = 
+            tech->createTextureDefinition(names[i]);
+        def->formatList.push_back(PF_A8R8G8B8);
+    }
+
+    // scene is used by steps 0 and 1, a by 1 and 2, b by 2 and 3, and c 
+    // by 3 and the output
+    CompositionTargetPass* target = tech->createTargetPass();
+    target->setOutputName("scene");
+    target->setInputMode(CompositionTargetPass::IM_NONE);
+    target->createPass()->setType(CompositionPass::PT_CLEAR);
+    target->createPass()->setType(CompositionPass::PT_RENDERSCENE);
+    addQuadTarget(tech, "a", "scene");
+    addQuadTarget(tech, "b", "a");
+    addQuadTarget(tech, "c", "b");
+    // Read before it is written, so it keeps its contents between frames
+    addQuadTarget(tech, "feedback", "feedback");
+
+    CompositionPass* output = tech->getOutputTargetPass()->createPass();
+    output->setType(CompositionPass::PT_RENDERQUAD);
+    output->setMaterialName("PoolingTest/Quad");
+    output->setInput(0, "c");
+}
+
+CompositorInstance* CompositorPoolingTests::addCompositor(Viewport* vp)
+{
+    CompositorInstance* inst = 
+        CompositorManager::getSingleton().addCompositor(vp, COMPOSITOR_NAME);
+    CPPUNIT_ASSERT(inst);
+    inst->setEnabled(true);
+    CompositorManager::getSingleton().getCompositorChain(vp)->_compile();
+    return inst;
+}
+
+bool CompositorPoolingTests::isPooled(CompositorInstance* inst, const String& name)
+{
+    return StringUtil::startsWith(inst->getTextureInstanceName(name, 0), POOL_PREFIX, false);
+}
+
+void CompositorPoolingTests::testDisjointLifetimesShare()
+{
+    CompositorManager::getSingleton().setRenderTargetPoolingEnabled(true);
+    CompositorInstance* inst = addCompositor(mViewport);
+
+    CPPUNIT_ASSERT(isPooled(inst, "scene"));
+    CPPUNIT_ASSERT(isPooled(inst, "a"));
+    CPPUNIT_ASSERT(isPooled(inst, "b"));
+    // Read by the output, and read before written
+    CPPUNIT_ASSERT(!isPooled(inst, "c"));
+    CPPUNIT_ASSERT(!isPooled(inst, "feedback"));
+
+    // Textures in use at the same time never share
+    String scene = inst->getTextureInstanceName("scene", 0);
+    String a = inst->getTextureInstanceName("a", 0);
+    String b = inst->getTextureInstanceName("b", 0);
+    CPPUNIT_ASSERT(scene != a);
+    CPPUNIT_ASSERT(a != b);
+    // scene is finished with before b is first rendered
+    CPPUNIT_ASSERT_EQUAL(scene, b);
+}
+
+void CompositorPoolingTests::testBlendedQuadReads()
+{
+    MaterialPtr mat = MaterialManager::getSingleton().create("PoolingTest/Add",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    mat->getTechnique(0)->getPass(0)->createTextureUnitState();
+    mat->getTechnique(0)->getPass(0)->setSceneBlending(SBT_ADD);
+
+    CompositorPtr comp = CompositorManager::getSingleton().create("PoolingTest/Blended", 
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    CompositionTechnique* tech = comp->createTechnique();
+    const char* names[] = { "scene", "blended", "result" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+    {
+        CompositionTechnique::TextureDefinition* def = 
+            tech->createTextureDefinition(names[i]);
+        def->formatList.push_back(PF_A8R8G8B8);
+    }
+    CompositionTargetPass* target = tech->createTargetPass();
+    target->setOutputName("scene");
+    target->setInputMode(CompositionTargetPass::IM_NONE);
+    target->createPass()->setType(CompositionPass::PT_CLEAR);
+    // Adds to whatever the texture held before
+    addQuadTarget(tech, "blended", "scene")->getPass(0)->setMaterialName("PoolingTest/Add");
+    addQuadTarget(tech, "result", "blended");
+    CompositionPass* output = tech->getOutputTargetPass()->createPass();
+    output->setType(CompositionPass::PT_RENDERQUAD);
+    output->setMaterialName("PoolingTest/Quad");
+    output->setInput(0, "result");
+
+    CompositorManager::getSingleton().setRenderTargetPoolingEnabled(true);
+    CompositorInstance* inst = 
+        CompositorManager::getSingleton().addCompositor(mViewport, "PoolingTest/Blended");
+    CPPUNIT_ASSERT(inst);
+    inst->setEnabled(true);
+    CompositorManager::getSingleton().getCompositorChain(mViewport)->_compile();
+
+    CPPUNIT_ASSERT(isPooled(inst, "scene"));
+    CPPUNIT_ASSERT(!isPooled(inst, "blended"));
+}
+
+void CompositorPoolingTests::testPoolingDisabled()
+{
+    CompositorInstance* inst = addCompositor(mViewport);
+
+    std::set<String> names;
+    const char* locals[] = { "scene", "a", "b", "c", "feedback" };
+    for (size_t i = 0; i < sizeof(locals) / sizeof(locals[0]); ++i)
+    {
+        CPPUNIT_ASSERT(!isPooled(inst, locals[i]));
+        names.insert(inst->getTextureInstanceName(locals[i], 0));
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)5, names.size());
+
+    // Turning pooling on recreates the textures
+    CompositorManager::getSingleton().setRenderTargetPoolingEnabled(true);
+    CompositorManager::getSingleton().getCompositorChain(mViewport)->_compile();
+    CPPUNIT_ASSERT(isPooled(inst, "a"));
+}
+
+void CompositorPoolingTests::testChainsShare()
+{
+    CompositorManager::getSingleton().setRenderTargetPoolingEnabled(true);
+    CompositorInstance* inst = addCompositor(mViewport);
+    CompositorInstance* other = addCompositor(mOtherViewport);
+
+    CPPUNIT_ASSERT_EQUAL(inst->getTextureInstanceName("scene", 0), 
+        other->getTextureInstanceName("scene", 0));
+    CPPUNIT_ASSERT_EQUAL(inst->getTextureInstanceName("a", 0), 
+        other->getTextureInstanceName("a", 0));
+    // Textures which aren't pooled still belong to one instance
+    CPPUNIT_ASSERT(inst->getTextureInstanceName("c", 0) != 
+        other->getTextureInstanceName("c", 0));
+}
+
+void CompositorPoolingTests::testFreeChainReturnsTextures()
+{
+    CompositorManager& compMgr = CompositorManager::getSingleton();
+    TextureManager& texMgr = TextureManager::getSingleton();
+    compMgr.setRenderTargetPoolingEnabled(true);
+    CompositorInstance* inst = addCompositor(mViewport);
+    addCompositor(mOtherViewport);
+    String scene = inst->getTextureInstanceName("scene", 0);
+    String a = inst->getTextureInstanceName("a", 0);
+    String c = inst->getTextureInstanceName("c", 0);
+
+    // The other chain still uses the pooled textures
+    compMgr.removeCompositorChain(mViewport);
+    CPPUNIT_ASSERT(texMgr.getByName(c).isNull());
+    compMgr.freePooledTextures(true);
+    CPPUNIT_ASSERT(!texMgr.getByName(scene).isNull());
+    CPPUNIT_ASSERT(!texMgr.getByName(a).isNull());
+
+    // A new chain gets the same textures back from the pool
+    inst = addCompositor(mViewport);
+    CPPUNIT_ASSERT_EQUAL(scene, inst->getTextureInstanceName("scene", 0));
+    CPPUNIT_ASSERT_EQUAL(a, inst->getTextureInstanceName("a", 0));
+
+    // Once no chain uses them they can be freed
+    compMgr.removeCompositorChain(mViewport);
+    compMgr.removeCompositorChain(mOtherViewport);
+    CPPUNIT_ASSERT(!texMgr.getByName(scene).isNull());
+    compMgr.freePooledTextures(true);
+    CPPUNIT_ASSERT(texMgr.getByName(scene).isNull());
+    CPPUNIT_ASSERT(texMgr.getByName(a).isNull());
+}
+
+void CompositorPoolingTests::testGetPooledTexture()
+{
+    CompositorManager& compMgr = CompositorManager::getSingleton();
+    TexturePtr first = compMgr._getPooledTexture(64, 32, PF_A8R8G8B8, 0, false, 0);
+    CPPUNIT_ASSERT(!first.isNull());
+    CPPUNIT_ASSERT_EQUAL((size_t)64, first->getWidth());
+    CPPUNIT_ASSERT_EQUAL((size_t)32, first->getHeight());
+
+    // The same kind and number always gives the same texture
+    CPPUNIT_ASSERT(first == compMgr._getPooledTexture(64, 32, PF_A8R8G8B8, 0, false, 0));
+    TexturePtr second = compMgr._getPooledTexture(64, 32, PF_A8R8G8B8, 0, false, 1);
+    CPPUNIT_ASSERT(first != second);
+    CPPUNIT_ASSERT(first != compMgr._getPooledTexture(64, 32, PF_FLOAT16_RGBA, 0, false, 0));
+    CPPUNIT_ASSERT(first != compMgr._getPooledTexture(32, 32, PF_A8R8G8B8, 0, false, 0));
+
+    // Only textures nobody holds on to are freed, unless forced
+    String firstName = first->getName();
+    String secondName = second->getName();
+    second.setNull();
+    compMgr.freePooledTextures(true);
+    TextureManager& texMgr = TextureManager::getSingleton();
+    CPPUNIT_ASSERT(!texMgr.getByName(firstName).isNull());
+    CPPUNIT_ASSERT(texMgr.getByName(secondName).isNull());
+    compMgr.freePooledTextures(false);
+    CPPUNIT_ASSERT(texMgr.getByName(firstName).isNull());
+    CPPUNIT_ASSERT(first != compMgr._getPooledTexture(64, 32, PF_A8R8G8B8, 0, false, 0));
+}
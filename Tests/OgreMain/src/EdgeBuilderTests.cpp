@@ -288,3 +288,62 @@ void EdgeBuilderTests::testMultiIndexBufMultiVertexBuf()
 
 
 }
+
+void EdgeBuilderTests::testWeldedNonManifoldEdges()
+{
+    /* This tests that vertices at the same position are welded, and that 
+    when more than 2 triangles share an edge, the edges are connected in pairs 
+    in the order the triangles come in
+    */
+    VertexData vd;
+    IndexData id;
+    // 4 fins around the edge from 0 to 1, vertex 6 duplicating vertex 0
+    vd.vertexCount = 7;
+    vd.vertexStart = 0;
+    vd.vertexDeclaration = HardwareBufferManager::getSingleton().createVertexDeclaration();
+    vd.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(sizeof(float)*3, 7, HardwareBuffer::HBU_STATIC,true);
+    vd.vertexBufferBinding->setBinding(0, vbuf);
+    float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    *pFloat++ = 0  ; *pFloat++ = 0  ; *pFloat++ = 0  ;
+    *pFloat++ = 0  ; *pFloat++ = 0  ; *pFloat++ = 10 ;
+    *pFloat++ = 10 ; *pFloat++ = 0  ; *pFloat++ = 0  ;
+    *pFloat++ = 0  ; *pFloat++ = 10 ; *pFloat++ = 0  ;
+    *pFloat++ = -10; *pFloat++ = 0  ; *pFloat++ = 0  ;
+    *pFloat++ = 0  ; *pFloat++ = -10; *pFloat++ = 0  ;
+    *pFloat++ = 0  ; *pFloat++ = 0  ; *pFloat++ = -0.0f;
+    vbuf->unlock();
+
+    id.indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_16BIT, 12, HardwareBuffer::HBU_STATIC, true);
+    id.indexCount = 12;
+    id.indexStart = 0;
+    unsigned short* pIdx = static_cast<unsigned short*>(id.indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    *pIdx++ = 0; *pIdx++ = 1; *pIdx++ = 2;
+    *pIdx++ = 1; *pIdx++ = 6; *pIdx++ = 3;
+    *pIdx++ = 0; *pIdx++ = 1; *pIdx++ = 4;
+    *pIdx++ = 1; *pIdx++ = 0; *pIdx++ = 5;
+    id.indexBuffer->unlock();
+
+    EdgeListBuilder edgeBuilder;
+    edgeBuilder.addVertexData(&vd);
+    edgeBuilder.addIndexData(&id);
+    EdgeData* edgeData = edgeBuilder.build();
+
+    // 4 tris
+    CPPUNIT_ASSERT(edgeData->triangles.size() == 4);
+    // Vertex 6 welded to vertex 0
+    CPPUNIT_ASSERT(edgeData->triangles[1].vertIndex[1] == 6);
+    CPPUNIT_ASSERT(edgeData->triangles[1].sharedVertIndex[1] == 0);
+    // 10 edges, the shared edge created twice and connected as (0,1) and (2,3)
+    EdgeData::EdgeGroup& eg = edgeData->edgeGroups[0];
+    CPPUNIT_ASSERT(eg.edges.size() == 10);
+    CPPUNIT_ASSERT(!eg.edges[0].degenerate);
+    CPPUNIT_ASSERT(eg.edges[0].triIndex[0] == 0 && eg.edges[0].triIndex[1] == 1);
+    CPPUNIT_ASSERT(!eg.edges[5].degenerate);
+    CPPUNIT_ASSERT(eg.edges[5].triIndex[0] == 2 && eg.edges[5].triIndex[1] == 3);
+    CPPUNIT_ASSERT(eg.edges[1].degenerate);
+    CPPUNIT_ASSERT(!edgeData->isClosed);
+
+    delete edgeData;
+}
@@ -277,3 +277,34 @@ void FileSystemArchiveTests::testReadInterleave()
     CPPUNIT_ASSERT(stream2->eof());
 
 }
+void FileSystemArchiveTests::testMappedFileRead()
+{
+    FileSystemArchive arch(testPath, "FileSystem");
+    arch.load();
+
+    // Map everything, then restore the default
+    size_t threshold = FileSystemArchive::getMemoryMapThreshold();
+    FileSystemArchive::setMemoryMapThreshold(1);
+    DataStreamPtr stream = arch.open("rootfile.txt");
+    FileSystemArchive::setMemoryMapThreshold(threshold);
+
+    CPPUNIT_ASSERT(stream->size() > 0);
+    const uchar* pData = stream->getReadPtr(stream->size());
+    CPPUNIT_ASSERT(pData != 0);
+    CPPUNIT_ASSERT(stream->getReadPtr(stream->size() + 1) == 0);
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1"), String((const char*)pData, 14));
+
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 1"), stream->getLine());
+    // The read pointer follows the stream position
+    CPPUNIT_ASSERT(stream->getReadPtr(1) == pData + stream->tell());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 3 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 4 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 5 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(StringUtil::BLANK, stream->getLine()); // blank at end of file
+    CPPUNIT_ASSERT(stream->eof());
+
+    // File streams do not expose their data
+    DataStreamPtr fileStream = arch.open("rootfile.txt");
+    CPPUNIT_ASSERT(fileStream->getReadPtr(1) == 0);
+}
@@ -0,0 +1,199 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "FindVisibleObjectsTests.h"
+#include "OgreMaterialManager.h"
+#include "OgreMovableObject.h"
+#include "OgreRenderable.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "OgreSceneNode.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreStringConverter.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( FindVisibleObjectsTests );
+
+namespace
+{
+    /// Movable object which queues itself as a single renderable
+    class QueuedBox : public MovableObject, public Renderable
+    {
+    protected:
+        AxisAlignedBox mBox;
+        MaterialPtr mMaterial;
+        LightList mLights;
+    public:
+        QueuedBox(const String& name, Real size) : MovableObject(name)
+        {
+            mBox.setExtents(-size, -size, -size, size, size, size);
+        }
+        const String& getMovableType(void) const 
+        { static String type = "QueuedBox"; return type; }
+        const AxisAlignedBox& getBoundingBox(void) const { return mBox; }
+        Real getBoundingRadius(void) const { return mBox.getHalfSize().length(); }
+        void _updateRenderQueue(RenderQueue* queue) 
+        { queue->addRenderable(this, getRenderQueueGroup()); }
+        void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables) 
+        { visitor->visit(this, 0, false); }
+
+        const MaterialPtr& getMaterial(void) const { return mMaterial; }
+        void getRenderOperation(RenderOperation& op) {}
+        void getWorldTransforms(Matrix4* xform) const 
+        { *xform = _getParentNodeFullTransform(); }
+        Real getSquaredViewDepth(const Camera* cam) const { return 0; }
+        const LightList& getLights(void) const { return mLights; }
+    };
+
+    Real randomReal(Real low, Real high)
+    {
+        return low + (high - low) * (rand() / (Real)RAND_MAX);
+    }
+}
+
+bool FindVisibleObjectsTests::QueueRecorder::renderableQueued(Renderable* rend, 
+    uint8 groupID, ushort priority, Technique** ppTech, RenderQueue* pQueue)
+{
+    Entry entry;
+    entry.rend = rend;
+    entry.groupID = groupID;
+    entry.priority = priority;
+    entries.push_back(entry);
+    // Only the order matters, so keep the queue itself empty
+    return false;
+}
+
+void FindVisibleObjectsTests::setUp()
+{
+    mRenderSetup = new NullRenderSetup();
+    // Provides the material used for renderables without one
+    MaterialManager::getSingleton().initialise();
+    mSceneMgr = new DefaultSceneManager("FindVisibleObjects");
+    mCamera = mSceneMgr->createCamera("Camera");
+    mCamera->setPosition(0, 50, 300);
+    mCamera->lookAt(Vector3::ZERO);
+    mCamera->setNearClipDistance(1);
+    mCamera->setFarClipDistance(500);
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(3);
+}
+void FindVisibleObjectsTests::tearDown()
+{
+    delete mSceneMgr;
+    for (std::vector<MovableObject*>::iterator i = mObjects.begin(); i != mObjects.end(); ++i)
+        delete *i;
+    mObjects.clear();
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(0);
+    delete mRenderSetup;
+}
+
+void FindVisibleObjectsTests::buildScene(size_t numNodes)
+{
+    // Mixture of wide and deep branches, spread well beyond the frustum
+    srand(7);
+    std::vector<SceneNode*> nodes;
+    nodes.push_back(mSceneMgr->getRootSceneNode());
+    for (size_t i = 1; i < numNodes; ++i)
+    {
+        SceneNode* parent = (i % 3) ? nodes[rand() % nodes.size()] : nodes.back();
+        SceneNode* node = parent->createChildSceneNode(Vector3(
+            randomReal(-100, 100), randomReal(-100, 100), randomReal(-100, 100)));
+        nodes.push_back(node);
+        // Some nodes have several objects, some none
+        for (size_t j = 0; j < (i % 4); ++j)
+        {
+            QueuedBox* obj = new QueuedBox(
+                "Box" + StringConverter::toString(mObjects.size()), randomReal(1, 20));
+            obj->setCastShadows((rand() % 3) != 0);
+            obj->setRenderQueueGroup(RENDER_QUEUE_MAIN + (rand() % 3));
+            obj->setVisible((rand() % 10) != 0);
+            node->attachObject(obj);
+            mObjects.push_back(obj);
+        }
+    }
+    mSceneMgr->_updateSceneGraph(mCamera);
+}
+
+void FindVisibleObjectsTests::findVisibleObjects(bool parallel, 
+    bool onlyShadowCasters, QueueRecorder& recorder, VisibleObjectsBoundsInfo& bounds)
+{
+    RenderQueue* queue = mSceneMgr->getRenderQueue();
+    queue->clear();
+    queue->setRenderableListener(&recorder);
+    mSceneMgr->setParallelFindVisibleObjects(parallel);
+    bounds.reset();
+    mSceneMgr->_findVisibleObjects(mCamera, &bounds, onlyShadowCasters);
+    queue->setRenderableListener(0);
+}
+
+void FindVisibleObjectsTests::compareSearches(bool onlyShadowCasters)
+{
+    QueueRecorder serial, parallel;
+    VisibleObjectsBoundsInfo serialBounds, parallelBounds;
+    findVisibleObjects(false, onlyShadowCasters, serial, serialBounds);
+    findVisibleObjects(true, onlyShadowCasters, parallel, parallelBounds);
+
+    // Some of the objects must be culled for the test to mean anything
+    CPPUNIT_ASSERT(!serial.entries.empty());
+    CPPUNIT_ASSERT(serial.entries.size() < mObjects.size());
+
+    CPPUNIT_ASSERT_EQUAL(serial.entries.size(), parallel.entries.size());
+    for (size_t i = 0; i < serial.entries.size(); ++i)
+    {
+        CPPUNIT_ASSERT(serial.entries[i] == parallel.entries[i]);
+    }
+    CPPUNIT_ASSERT(serialBounds.aabb == parallelBounds.aabb);
+    CPPUNIT_ASSERT(serialBounds.receiverAabb == parallelBounds.receiverAabb);
+    CPPUNIT_ASSERT_EQUAL(serialBounds.minDistance, parallelBounds.minDistance);
+    CPPUNIT_ASSERT_EQUAL(serialBounds.maxDistance, parallelBounds.maxDistance);
+}
+
+void FindVisibleObjectsTests::testParallelMatchesSerial()
+{
+    buildScene(3000);
+    compareSearches(false);
+}
+
+void FindVisibleObjectsTests::testParallelMatchesSerialShadowCasters()
+{
+    buildScene(3000);
+    compareSearches(true);
+}
+
+void FindVisibleObjectsTests::testParallelSmallScene()
+{
+    // Fewer nodes than the search would like to split the work into
+    buildScene(6);
+    QueueRecorder serial, parallel;
+    VisibleObjectsBoundsInfo serialBounds, parallelBounds;
+    findVisibleObjects(false, false, serial, serialBounds);
+    findVisibleObjects(true, false, parallel, parallelBounds);
+    CPPUNIT_ASSERT_EQUAL(serial.entries.size(), parallel.entries.size());
+    for (size_t i = 0; i < serial.entries.size(); ++i)
+    {
+        CPPUNIT_ASSERT(serial.entries[i] == parallel.entries[i]);
+    }
+}
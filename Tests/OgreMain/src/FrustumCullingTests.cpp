@@ -0,0 +1,164 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "FrustumCullingTests.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "OgreSphere.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( FrustumCullingTests );
+
+namespace
+{
+    Real randomReal(Real low, Real high)
+    {
+        return low + (high - low) * (rand() / (Real)RAND_MAX);
+    }
+
+    bool isBitSet(const std::vector<uint32>& visibility, size_t i)
+    {
+        return (visibility[i >> 5] & (1u << (i & 31))) != 0;
+    }
+}
+
+void FrustumCullingTests::setUp()
+{
+    mRenderSetup = new NullRenderSetup();
+    mSceneMgr = new DefaultSceneManager("FrustumCulling");
+    mCamera = mSceneMgr->createCamera("Camera");
+    mCamera->setPosition(0, 50, 200);
+    mCamera->lookAt(Vector3::ZERO);
+    mCamera->setNearClipDistance(1);
+    mCamera->setFarClipDistance(500);
+}
+void FrustumCullingTests::tearDown()
+{
+    delete mSceneMgr;
+    delete mRenderSetup;
+}
+
+void FrustumCullingTests::checkBoxes(size_t count)
+{
+    srand(11);
+    std::vector<AxisAlignedBox> boxes(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i % 37 == 5)
+        {
+            boxes[i].setNull();
+        }
+        else if (i % 41 == 7)
+        {
+            boxes[i].setInfinite();
+        }
+        else
+        {
+            Vector3 centre(randomReal(-600, 600), randomReal(-600, 600), randomReal(-600, 600));
+            Vector3 halfSize(randomReal(0, 50), randomReal(0, 50), randomReal(0, 50));
+            boxes[i].setExtents(centre - halfSize, centre + halfSize);
+        }
+    }
+
+    std::vector<uint32> visibility((count + 31) / 32);
+    mCamera->isVisible(&boxes[0], count, &visibility[0]);
+
+    size_t numVisible = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        CPPUNIT_ASSERT_EQUAL(mCamera->isVisible(boxes[i]), isBitSet(visibility, i));
+        if (isBitSet(visibility, i))
+            ++numVisible;
+    }
+    // Make sure both outcomes were tested
+    CPPUNIT_ASSERT(numVisible > 0 && numVisible < count);
+}
+
+void FrustumCullingTests::checkSpheres(size_t count)
+{
+    srand(13);
+    std::vector<Sphere> spheres(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        spheres[i].setCenter(Vector3(randomReal(-600, 600), randomReal(-600, 600), randomReal(-600, 600)));
+        spheres[i].setRadius(randomReal(0, 100));
+    }
+
+    std::vector<uint32> visibility((count + 31) / 32);
+    mCamera->isVisible(&spheres[0], count, &visibility[0]);
+
+    size_t numVisible = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        CPPUNIT_ASSERT_EQUAL(mCamera->isVisible(spheres[i]), isBitSet(visibility, i));
+        if (isBitSet(visibility, i))
+            ++numVisible;
+    }
+    CPPUNIT_ASSERT(numVisible > 0 && numVisible < count);
+}
+
+void FrustumCullingTests::testBoxesMatchSingle()
+{
+    // Not a multiple of the four-wide SIMD path, nor of the conversion batch
+    checkBoxes(1001);
+}
+
+void FrustumCullingTests::testSpheresMatchSingle()
+{
+    checkSpheres(1003);
+}
+
+void FrustumCullingTests::testInfiniteFarPlane()
+{
+    mCamera->setFarClipDistance(0);
+    checkBoxes(250);
+    checkSpheres(250);
+}
+
+void FrustumCullingTests::testUnusedBitsCleared()
+{
+    // Everything visible, so only the used bits of the last word are set
+    AxisAlignedBox boxes[35];
+    Sphere spheres[35];
+    for (size_t i = 0; i < 35; ++i)
+    {
+        boxes[i].setInfinite();
+        spheres[i].setCenter(Vector3::ZERO);
+        spheres[i].setRadius(1);
+    }
+
+    uint32 visibility[2] = { 0, 0xFFFFFFFF };
+    mCamera->isVisible(boxes, 35, visibility);
+    CPPUNIT_ASSERT_EQUAL((uint32)0xFFFFFFFF, visibility[0]);
+    CPPUNIT_ASSERT_EQUAL((uint32)0x7, visibility[1]);
+
+    visibility[0] = 0;
+    visibility[1] = 0xFFFFFFFF;
+    mCamera->isVisible(spheres, 35, visibility);
+    CPPUNIT_ASSERT_EQUAL((uint32)0xFFFFFFFF, visibility[0]);
+    CPPUNIT_ASSERT_EQUAL((uint32)0x7, visibility[1]);
+}
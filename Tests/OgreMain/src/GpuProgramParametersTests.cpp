@@ -0,0 +1,146 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "GpuProgramParametersTests.h"
+#include "OgreVector4.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( GpuProgramParametersTests );
+
+void GpuProgramParametersTests::setUp()
+{
+    mFloatLogical.map.clear();
+    mFloatLogical.bufferSize = 0;
+    mIntLogical.map.clear();
+    mIntLogical.bufferSize = 0;
+    mParams = new GpuProgramParameters();
+    mParams->_setLogicalIndexes(&mFloatLogical, &mIntLogical);
+
+    // Three float4 constants at physical indexes 0, 4 and 8
+    mParams->setConstant(0, Vector4(1, 2, 3, 4));
+    mParams->setConstant(1, Vector4(5, 6, 7, 8));
+    mParams->setConstant(2, Vector4(9, 10, 11, 12));
+}
+void GpuProgramParametersTests::tearDown()
+{
+    delete mParams;
+}
+
+void GpuProgramParametersTests::testNewParametersFullyDirty()
+{
+    size_t start, end;
+    CPPUNIT_ASSERT(mParams->_getFloatDirtyRange(&mBindingA, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)12, end);
+
+    // A copy has never been uploaded either
+    mParams->_clearDirtyRanges(&mBindingA);
+    GpuProgramParameters copy(*mParams);
+    CPPUNIT_ASSERT(copy._getFloatDirtyRange(&mBindingA, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)12, end);
+
+    // Nor have constants copied into parameters which were uploaded before
+    copy._clearDirtyRanges(&mBindingA);
+    mParams->setConstant(0, Vector4::ZERO);
+    mParams->_clearDirtyRanges(&mBindingA);
+    copy.copyConstantsFrom(*mParams);
+    CPPUNIT_ASSERT(copy._getFloatDirtyRange(&mBindingA, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)12, end);
+}
+
+void GpuProgramParametersTests::testUnchangedWriteNotDirty()
+{
+    size_t start, end;
+    mParams->_clearDirtyRanges(&mBindingA);
+    CPPUNIT_ASSERT(!mParams->_getFloatDirtyRange(&mBindingA, start, end));
+
+    // Writing the values already held changes nothing
+    mParams->setConstant(1, Vector4(5, 6, 7, 8));
+    mParams->_writeRawConstant(8, Vector4(9, 10, 11, 12));
+    CPPUNIT_ASSERT(!mParams->_getFloatDirtyRange(&mBindingA, start, end));
+}
+
+void GpuProgramParametersTests::testDirtyRangeCoversChanges()
+{
+    size_t start, end;
+    mParams->_clearDirtyRanges(&mBindingA);
+
+    mParams->setConstant(1, Vector4(5, 6, 7, 0));
+    CPPUNIT_ASSERT(mParams->_getFloatDirtyRange(&mBindingA, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)4, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)8, end);
+
+    // The range widens to cover every change since the last clear
+    mParams->_writeRawConstant(9, (Real)0);
+    CPPUNIT_ASSERT(mParams->_getFloatDirtyRange(&mBindingA, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)4, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)10, end);
+
+    // New constants at the end of the buffer are dirty too
+    mParams->_clearDirtyRanges(&mBindingA);
+    mParams->setConstant(3, Vector4::ZERO);
+    CPPUNIT_ASSERT(mParams->_getFloatDirtyRange(&mBindingA, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)12, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)16, end);
+}
+
+void GpuProgramParametersTests::testOtherBindingGetsFullRange()
+{
+    size_t start, end;
+    mParams->_clearDirtyRanges(&mBindingA);
+    mParams->setConstant(2, Vector4::ZERO);
+
+    CPPUNIT_ASSERT(mParams->_getFloatDirtyRange(&mBindingB, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)12, end);
+
+    // Once marked all dirty, the original binding needs everything as well
+    mParams->_markAllDirty();
+    CPPUNIT_ASSERT(mParams->_getFloatDirtyRange(&mBindingA, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)12, end);
+}
+
+void GpuProgramParametersTests::testIntDirtyRange()
+{
+    size_t start, end;
+    int vals[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    mParams->setConstant(0, vals, 2);
+    mParams->_clearDirtyRanges(&mBindingA);
+    CPPUNIT_ASSERT(!mParams->_getIntDirtyRange(&mBindingA, start, end));
+
+    vals[5] = 0;
+    mParams->setConstant(0, vals, 2);
+    CPPUNIT_ASSERT(mParams->_getIntDirtyRange(&mBindingA, start, end));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, start);
+    CPPUNIT_ASSERT_EQUAL((size_t)8, end);
+    // Float constants are tracked separately
+    CPPUNIT_ASSERT(!mParams->_getFloatDirtyRange(&mBindingA, start, end));
+}
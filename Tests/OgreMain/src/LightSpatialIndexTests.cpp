@@ -0,0 +1,167 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "LightSpatialIndexTests.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "OgreLightSpatialIndex.h"
+#include "OgreStringConverter.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( LightSpatialIndexTests );
+
+namespace
+{
+    /// Scene manager whose lights affecting the frustum are set directly
+    class FixedLightsSceneManager : public DefaultSceneManager
+    {
+    public:
+        LightList lights;
+        FixedLightsSceneManager() : DefaultSceneManager("FixedLights") {}
+        const LightList& _getLightsAffectingFrustum(void) const { return lights; }
+    };
+
+    struct TempSquareDistLess
+    {
+        bool operator()(const Light* a, const Light* b) const
+        { return a->tempSquareDist < b->tempSquareDist; }
+    };
+}
+
+void LightSpatialIndexTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    mSceneMgr = new FixedLightsSceneManager();
+}
+void LightSpatialIndexTests::tearDown()
+{
+    delete mSceneMgr;
+    mLights.clear();
+    delete mRoot;
+}
+
+void LightSpatialIndexTests::createLights(size_t count)
+{
+    srand(7);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Light* l = mSceneMgr->createLight("Light" + StringConverter::toString(i));
+        if (i % 50 == 0)
+        {
+            l->setType(Light::LT_DIRECTIONAL);
+        }
+        else
+        {
+            l->setPosition(rand() % 1000, rand() % 100, rand() % 1000);
+            // Mostly small lights, with the odd one covering the whole scene
+            l->setAttenuation((i % 37 == 0) ? 5000 : 10 + rand() % 40, 1, 0, 0);
+        }
+        mLights.push_back(l);
+    }
+    static_cast<FixedLightsSceneManager*>(mSceneMgr)->lights = mLights;
+    mSceneMgr->_notifyLightsDirty();
+}
+
+void LightSpatialIndexTests::populateReference(const Vector3& position, 
+    Real radius, LightList& destList)
+{
+    // The straightforward version of SceneManager::_populateLightList
+    destList.clear();
+    for (LightList::iterator i = mLights.begin(); i != mLights.end(); ++i)
+    {
+        Light* lt = *i;
+        lt->_calcTempSquareDist(position);
+        if (lt->getType() == Light::LT_DIRECTIONAL ||
+            lt->tempSquareDist <= Math::Sqr(lt->getAttenuationRange() + radius))
+        {
+            destList.push_back(lt);
+        }
+    }
+    std::stable_sort(destList.begin(), destList.end(), TempSquareDistLess());
+}
+
+void LightSpatialIndexTests::testFindLightsInRange()
+{
+    createLights(500);
+    LightSpatialIndex index;
+    index.build(mLights);
+    CPPUNIT_ASSERT(index.hasGrid());
+    CPPUNIT_ASSERT_EQUAL(mLights.size(), index.getNumLights());
+
+    for (int q = 0; q < 500; ++q)
+    {
+        Vector3 pos(rand() % 1200 - 100, rand() % 100, rand() % 1200 - 100);
+        Real radius = (q % 10 == 0) ? 400 : rand() % 20;
+        LightSpatialIndex::IndexList found;
+        index.findLights(pos, radius, found);
+
+        for (size_t i = 1; i < found.size(); ++i)
+        {
+            CPPUNIT_ASSERT(found[i - 1] < found[i]);
+        }
+        for (size_t l = 0; l < mLights.size(); ++l)
+        {
+            Light* lt = mLights[l];
+            if (lt->getType() == Light::LT_DIRECTIONAL ||
+                (lt->getDerivedPosition() - pos).length() <= lt->getAttenuationRange() + radius)
+            {
+                CPPUNIT_ASSERT(std::binary_search(found.begin(), found.end(), l));
+            }
+        }
+    }
+}
+
+void LightSpatialIndexTests::testPopulateLightListMatchesSort()
+{
+    createLights(300);
+    for (int q = 0; q < 200; ++q)
+    {
+        Vector3 pos(rand() % 1000, rand() % 100, rand() % 1000);
+        Real radius = rand() % 30;
+        LightList expected, actual;
+        populateReference(pos, radius, expected);
+        mSceneMgr->_populateLightList(pos, radius, actual);
+        CPPUNIT_ASSERT(expected == actual);
+    }
+}
+
+void LightSpatialIndexTests::testPopulateLightListLimit()
+{
+    createLights(300);
+    mSceneMgr->setMaxLightsPerObject(4);
+    for (int q = 0; q < 200; ++q)
+    {
+        Vector3 pos(rand() % 1000, rand() % 100, rand() % 1000);
+        Real radius = rand() % 30;
+        LightList expected, actual;
+        populateReference(pos, radius, expected);
+        if (expected.size() > 4)
+            expected.resize(4);
+        mSceneMgr->_populateLightList(pos, radius, actual);
+        CPPUNIT_ASSERT(expected == actual);
+    }
+}
@@ -0,0 +1,201 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "MeshTriangleBVHTests.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMeshTriangleBVH.h"
+#include "OgreSubMesh.h"
+#include "OgreMath.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( MeshTriangleBVHTests );
+
+namespace
+{
+    const size_t GRID_SIZE = 9;
+    const Real TOP_GRID_HEIGHT = 50;
+}
+
+void MeshTriangleBVHTests::setUp()
+{
+    mBufMgr = new DefaultHardwareBufferManager();
+    LogManager::getSingleton().createLog("MeshTriangleBVHTests.log", true);
+
+    // A grid using shared vertices with a second one above it using its own
+    mMesh = new Mesh(0, "MeshTriangleBVHTests", 0, "General");
+    mMesh->sharedVertexData = new VertexData();
+    SubMesh* sub = mMesh->createSubMesh();
+    sub->useSharedVertices = true;
+    createGrid(mMesh->sharedVertexData, sub->indexData, GRID_SIZE, Vector3::ZERO);
+    sub = mMesh->createSubMesh();
+    sub->useSharedVertices = false;
+    sub->vertexData = new VertexData();
+    createGrid(sub->vertexData, sub->indexData, GRID_SIZE, Vector3(0, TOP_GRID_HEIGHT, 0));
+}
+void MeshTriangleBVHTests::tearDown()
+{
+    delete mMesh->getSubMesh(0);
+    delete mMesh->getSubMesh(1);
+    delete mMesh->sharedVertexData;
+    mMesh->sharedVertexData = 0;
+    delete mMesh;
+    delete mBufMgr;
+}
+
+void MeshTriangleBVHTests::createGrid(VertexData* vd, IndexData* id, 
+    size_t size, const Vector3& origin)
+{
+    vd->vertexCount = size * size;
+    vd->vertexStart = 0;
+    vd->vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        sizeof(float)*3, vd->vertexCount, HardwareBuffer::HBU_STATIC, true);
+    vd->vertexBufferBinding->setBinding(0, vbuf);
+    float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t z = 0; z < size; ++z)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            *pFloat++ = origin.x + (float)x * 10;
+            *pFloat++ = origin.y + 2 * Math::Sin(Radian((float)(x * 7 + z * 3)));
+            *pFloat++ = origin.z + (float)z * 10;
+        }
+    }
+    vbuf->unlock();
+
+    id->indexCount = (size - 1) * (size - 1) * 6;
+    id->indexStart = 0;
+    id->indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_16BIT, id->indexCount, HardwareBuffer::HBU_STATIC, true);
+    unsigned short* pIdx = static_cast<unsigned short*>(
+        id->indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t z = 0; z < size - 1; ++z)
+    {
+        for (size_t x = 0; x < size - 1; ++x)
+        {
+            unsigned short v = static_cast<unsigned short>(z * size + x);
+            *pIdx++ = v; *pIdx++ = v + size; *pIdx++ = v + 1;
+            *pIdx++ = v + 1; *pIdx++ = v + size; *pIdx++ = v + size + 1;
+        }
+    }
+    id->indexBuffer->unlock();
+}
+
+void MeshTriangleBVHTests::testIntersectMatchesScan()
+{
+    MeshTriangleBVH bvh(mMesh);
+    CPPUNIT_ASSERT_EQUAL((size_t)(GRID_SIZE * GRID_SIZE * 2), bvh.getPositions().size());
+    CPPUNIT_ASSERT_EQUAL((size_t)((GRID_SIZE - 1) * (GRID_SIZE - 1) * 4), bvh.getNumTriangles());
+    CPPUNIT_ASSERT_EQUAL((size_t)(GRID_SIZE * GRID_SIZE), bvh.getSubMeshFirstVertex(1));
+
+    srand(7);
+    size_t numHits = 0;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        Vector3 origin(Math::RangeRandom(-20, 100), Math::RangeRandom(-20, 80), 
+            Math::RangeRandom(-20, 100));
+        Vector3 target(Math::RangeRandom(0, 80), Math::RangeRandom(-5, 55), 
+            Math::RangeRandom(0, 80));
+        Ray ray(origin, target - origin);
+
+        MeshTriangleHit hit, scanHit;
+        bool isHit = bvh.intersect(ray, hit);
+        CPPUNIT_ASSERT_EQUAL(bvh.intersect(ray, bvh.getPositions(), scanHit), isHit);
+        if (isHit)
+        {
+            ++numHits;
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(scanHit.distance, hit.distance, 1e-4);
+            CPPUNIT_ASSERT_EQUAL(scanHit.subMeshIndex, hit.subMeshIndex);
+            CPPUNIT_ASSERT_EQUAL(scanHit.triangleIndex, hit.triangleIndex);
+        }
+    }
+    // Make sure both outcomes were tested
+    CPPUNIT_ASSERT(numHits > 100 && numHits < 1000);
+}
+
+void MeshTriangleBVHTests::testHitDetails()
+{
+    MeshTriangleBVH bvh(mMesh);
+    MeshTriangleHit hit;
+
+    // Straight down onto the top grid, which hides the bottom one
+    Ray ray(Vector3(33, 100, 44), Vector3::NEGATIVE_UNIT_Y);
+    CPPUNIT_ASSERT(bvh.intersect(ray, hit));
+    CPPUNIT_ASSERT_EQUAL((ushort)1, hit.subMeshIndex);
+    MeshTriangleHit downHit = hit;
+    CPPUNIT_ASSERT(hit.distance > 100 - TOP_GRID_HEIGHT - 2.01 && 
+        hit.distance < 100 - TOP_GRID_HEIGHT + 2.01);
+
+    // The hit point must be the barycentric combination of the triangle
+    const IndexData* id = mMesh->getSubMesh(1)->indexData;
+    const unsigned short* pIdx = static_cast<const unsigned short*>(
+        id->indexBuffer->lock(HardwareBuffer::HBL_READ_ONLY)) + hit.triangleIndex * 3;
+    size_t first = bvh.getSubMeshFirstVertex(1);
+    const std::vector<Vector3>& pos = bvh.getPositions();
+    Vector3 point = pos[first + pIdx[0]] * hit.barycentric.x + 
+        pos[first + pIdx[1]] * hit.barycentric.y + pos[first + pIdx[2]] * hit.barycentric.z;
+    id->indexBuffer->unlock();
+    CPPUNIT_ASSERT(point.positionEquals(ray.getPoint(hit.distance), 1e-3));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, 
+        hit.barycentric.x + hit.barycentric.y + hit.barycentric.z, 1e-5);
+
+    // From below the bottom grid is hit first
+    ray = Ray(Vector3(33, -10, 44), Vector3::UNIT_Y);
+    CPPUNIT_ASSERT(bvh.intersect(ray, hit));
+    CPPUNIT_ASSERT_EQUAL((ushort)0, hit.subMeshIndex);
+
+    // Nothing behind the origin, nor outside the grids
+    ray = Ray(Vector3(33, -10, 44), Vector3::NEGATIVE_UNIT_Y);
+    CPPUNIT_ASSERT(!bvh.intersect(ray, hit));
+    ray = Ray(Vector3(85, 100, 47), Vector3::NEGATIVE_UNIT_Y);
+    CPPUNIT_ASSERT(!bvh.intersect(ray, hit));
+
+    // Distances are in units of the direction's length
+    ray = Ray(Vector3(33, 100, 44), Vector3(0, -2, 0));
+    MeshTriangleHit scaledHit;
+    CPPUNIT_ASSERT(bvh.intersect(ray, scaledHit));
+    CPPUNIT_ASSERT_EQUAL(downHit.triangleIndex, scaledHit.triangleIndex);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(downHit.distance / 2, scaledHit.distance, 1e-4);
+}
+
+void MeshTriangleBVHTests::testMovedPositions()
+{
+    MeshTriangleBVH bvh(mMesh);
+    MeshTriangleHit hit, movedHit;
+    Ray ray(Vector3(33, 100, 44), Vector3::NEGATIVE_UNIT_Y);
+    CPPUNIT_ASSERT(bvh.intersect(ray, hit));
+
+    // Raise the top grid, as animation might
+    std::vector<Vector3> moved(bvh.getPositions());
+    for (size_t i = bvh.getSubMeshFirstVertex(1); i < moved.size(); ++i)
+        moved[i].y += 10;
+    CPPUNIT_ASSERT(bvh.intersect(ray, moved, movedHit));
+    CPPUNIT_ASSERT_EQUAL((ushort)1, movedHit.subMeshIndex);
+    CPPUNIT_ASSERT_EQUAL(hit.triangleIndex, movedHit.triangleIndex);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(hit.distance - 10, movedHit.distance, 1e-4);
+}
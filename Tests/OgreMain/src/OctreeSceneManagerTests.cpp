@@ -0,0 +1,242 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "OctreeSceneManagerTests.h"
+#include "TestBoxObject.h"
+#include "OgreOctreeNode.h"
+#include "OgreStringConverter.h"
+#include "OgreWorkerThreadPool.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( OctreeSceneManagerTests );
+
+namespace
+{
+    Real randomReal(Real range)
+    {
+        return range * rand() / RAND_MAX;
+    }
+
+    bool intersects(const AxisAlignedBox& box, SceneNode* node)
+    {
+        return box.intersects(node->_getWorldAABB());
+    }
+
+    bool intersects(const Sphere& sphere, SceneNode* node)
+    {
+        return Math::intersects(sphere, node->_getWorldAABB());
+    }
+
+    size_t queueIndex(SceneNode* node)
+    {
+        return static_cast<OctreeNode*>(node)->_getReinsertQueueIndex();
+    }
+}
+
+void OctreeSceneManagerTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    mFactory = new BoxObjectFactory();
+    mRoot->addMovableObjectFactory(mFactory);
+    mTightSceneMgr = new OctreeSceneManager("Tight");
+    mLooseSceneMgr = new OctreeSceneManager("Loose");
+    mLooseSceneMgr->setLooseOctree(true);
+}
+void OctreeSceneManagerTests::tearDown()
+{
+    delete mTightSceneMgr;
+    delete mLooseSceneMgr;
+    mTightNodes.clear();
+    mLooseNodes.clear();
+    mRoot->removeMovableObjectFactory(mFactory);
+    delete mFactory;
+    delete mRoot;
+}
+
+SceneNode* OctreeSceneManagerTests::createNode(OctreeSceneManager* sceneMgr, 
+    const String& name, Real size)
+{
+    BoxObject* obj = static_cast<BoxObject*>(
+        sceneMgr->createMovableObject(name, BoxObject::getTypeName()));
+    obj->setSize(size);
+    SceneNode* node = sceneMgr->getRootSceneNode()->createChildSceneNode(name);
+    node->attachObject(obj);
+    return node;
+}
+
+void OctreeSceneManagerTests::moveNodes(Real distance)
+{
+    for (size_t i = 0; i < mTightNodes.size(); ++i)
+    {
+        Vector3 move(randomReal(2 * distance) - distance, 
+            randomReal(2 * distance) - distance, randomReal(2 * distance) - distance);
+        mTightNodes[i]->translate(move);
+        mLooseNodes[i]->translate(move);
+    }
+    mTightSceneMgr->_updateSceneGraph(0);
+    mLooseSceneMgr->_updateSceneGraph(0);
+}
+
+template <class T>
+void OctreeSceneManagerTests::findNodeNames(OctreeSceneManager* sceneMgr, 
+    const T& volume, StringVector& names)
+{
+    std::list<SceneNode*> nodes;
+    sceneMgr->findNodesIn(volume, nodes);
+    // findNodesIn may also return nodes which only lie close to the volume,
+    // and which ones depends on the shape of the tree, so leave those out
+    names.clear();
+    for (std::list<SceneNode*>::iterator i = nodes.begin(); i != nodes.end(); ++i)
+    {
+        if (intersects(volume, *i))
+            names.push_back((*i)->getName());
+    }
+    std::sort(names.begin(), names.end());
+}
+
+void OctreeSceneManagerTests::compareLooseAndTight(void)
+{
+    srand(5);
+    for (size_t i = 0; i < 300; ++i)
+    {
+        String name = StringConverter::toString(i);
+        Real size = 1 + randomReal(i % 10 == 0 ? 200 : 20);
+        Vector3 pos(randomReal(4000) - 2000, randomReal(4000) - 2000, randomReal(4000) - 2000);
+        mTightNodes.push_back(createNode(mTightSceneMgr, name, size));
+        mTightNodes.back()->setPosition(pos);
+        mLooseNodes.push_back(createNode(mLooseSceneMgr, name, size));
+        mLooseNodes.back()->setPosition(pos);
+    }
+    mTightSceneMgr->_updateSceneGraph(0);
+    mLooseSceneMgr->_updateSceneGraph(0);
+
+    StringVector tightNames, looseNames;
+    size_t found = 0;
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        // Small moves mostly keep nodes in their loose octant, large ones don't
+        moveNodes(frame % 5 == 4 ? 1000 : 20);
+
+        for (int q = 0; q < 10; ++q)
+        {
+            Vector3 centre(randomReal(4000) - 2000, randomReal(4000) - 2000, randomReal(4000) - 2000);
+            Real extent = 50 + randomReal(1000);
+            AxisAlignedBox box(centre - extent, centre + extent);
+            findNodeNames(mTightSceneMgr, box, tightNames);
+            findNodeNames(mLooseSceneMgr, box, looseNames);
+            CPPUNIT_ASSERT(tightNames == looseNames);
+            // Neither may miss a node
+            size_t expected = 0;
+            for (size_t i = 0; i < mTightNodes.size(); ++i)
+            {
+                if (intersects(box, mTightNodes[i]))
+                    ++expected;
+            }
+            CPPUNIT_ASSERT_EQUAL(expected, tightNames.size());
+            found += tightNames.size();
+
+            Sphere sphere(centre, extent);
+            findNodeNames(mTightSceneMgr, sphere, tightNames);
+            findNodeNames(mLooseSceneMgr, sphere, looseNames);
+            CPPUNIT_ASSERT(tightNames == looseNames);
+        }
+    }
+    // Make sure the queries weren't all empty
+    CPPUNIT_ASSERT(found > 0);
+    CPPUNIT_ASSERT(mLooseSceneMgr->getNumReinsertions() > 0);
+}
+
+void OctreeSceneManagerTests::testLooseMatchesTight()
+{
+    compareLooseAndTight();
+}
+
+void OctreeSceneManagerTests::testDestroyQueuedNode()
+{
+    for (size_t i = 0; i < 3; ++i)
+        mLooseNodes.push_back(createNode(mLooseSceneMgr, StringConverter::toString(i), 1));
+    mLooseSceneMgr->_updateSceneGraph(0);
+
+    // Updating the nodes outside of the scene graph update queues them until 
+    // the next search of the octree
+    for (size_t i = 0; i < 3; ++i)
+    {
+        mLooseNodes[i]->setPosition(5000, 0, 0);
+        mLooseNodes[i]->_update(true, false);
+        CPPUNIT_ASSERT_EQUAL(i, queueIndex(mLooseNodes[i]));
+    }
+
+    // The last node fills the gap left in the queue
+    mLooseSceneMgr->destroySceneNode(mLooseNodes[0]->getName());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, queueIndex(mLooseNodes[1]));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, queueIndex(mLooseNodes[2]));
+
+    mLooseSceneMgr->_updateSceneGraph(0);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, mLooseSceneMgr->getNumReinsertions());
+    CPPUNIT_ASSERT_EQUAL(OctreeNode::NOT_QUEUED, queueIndex(mLooseNodes[1]));
+    CPPUNIT_ASSERT_EQUAL(OctreeNode::NOT_QUEUED, queueIndex(mLooseNodes[2]));
+
+    std::list<SceneNode*> nodes;
+    mLooseSceneMgr->findNodesIn(AxisAlignedBox(4990, -10, -10, 5010, 10, 10), nodes);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, nodes.size());
+}
+
+void OctreeSceneManagerTests::testClearSceneDequeues()
+{
+    // The root node survives clearing the scene
+    SceneNode* root = mLooseSceneMgr->getRootSceneNode();
+    MovableObject* obj = mLooseSceneMgr->createMovableObject("Root", BoxObject::getTypeName());
+    static_cast<BoxObject*>(obj)->setSize(1);
+    root->attachObject(obj);
+    root->_update(true, false);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, queueIndex(root));
+
+    mLooseSceneMgr->clearScene();
+    CPPUNIT_ASSERT_EQUAL(OctreeNode::NOT_QUEUED, queueIndex(root));
+    CPPUNIT_ASSERT(static_cast<OctreeNode*>(root)->getOctant() == 0);
+
+    // The root can be queued and reinserted again
+    obj = mLooseSceneMgr->createMovableObject("Root", BoxObject::getTypeName());
+    static_cast<BoxObject*>(obj)->setSize(1);
+    root->attachObject(obj);
+    mLooseSceneMgr->_updateSceneGraph(0);
+    CPPUNIT_ASSERT_EQUAL(OctreeNode::NOT_QUEUED, queueIndex(root));
+    CPPUNIT_ASSERT(static_cast<OctreeNode*>(root)->getOctant() != 0);
+}
+
+void OctreeSceneManagerTests::testParallelUpdate()
+{
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(3);
+    mTightSceneMgr->setParallelSceneGraphUpdate(true);
+    mLooseSceneMgr->setParallelSceneGraphUpdate(true);
+    compareLooseAndTight();
+    // The octree is only locked during the update itself
+    CPPUNIT_ASSERT(!mTightSceneMgr->_isUpdatingSceneGraphInParallel());
+    CPPUNIT_ASSERT(!mLooseSceneMgr->_isUpdatingSceneGraphInParallel());
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(0);
+}
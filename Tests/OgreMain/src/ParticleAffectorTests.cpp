@@ -0,0 +1,510 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ParticleAffectorTests.h"
+#include "OgreParticle.h"
+#include "OgreParticleIterator.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreParticleSystemRenderer.h"
+#include "OgreMaterialManager.h"
+#include "OgreControllerManager.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreLinearForceAffector.h"
+#include "OgreColourFaderAffector.h"
+#include "OgreColourFaderAffector2.h"
+#include "OgreColourInterpolatorAffector.h"
+#include "OgreDeflectorPlaneAffector.h"
+#include "OgreDirectionRandomiserAffector.h"
+#include "OgreRotationAffector.h"
+#include "OgreScaleAffector.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ParticleAffectorTests );
+
+namespace
+{
+    const size_t NUM_PARTICLES = 50;
+    const Real TIME_ELAPSED = 0.1f;
+
+    /// Renderer written against the std::list interface only
+    class ListRenderer : public ParticleSystemRenderer
+    {
+    public:
+        size_t numQueued, numMoved, numCleared;
+        ListRenderer() : numQueued(0), numMoved(0), numCleared(0) {}
+        const String& getType(void) const { static String type = "TestList"; return type; }
+        void _updateRenderQueue(RenderQueue* queue, 
+            std::list<Particle*>& currentParticles, bool cullIndividually)
+        { numQueued = currentParticles.size(); }
+        void _notifyParticleMoved(std::list<Particle*>& currentParticles)
+        { numMoved = currentParticles.size(); }
+        void _notifyParticleCleared(std::list<Particle*>& currentParticles)
+        { numCleared = currentParticles.size(); }
+        void _setMaterial(MaterialPtr& mat) {}
+        void _notifyCurrentCamera(Camera* cam) {}
+        void _notifyAttached(Node* parent, bool isTagPoint) {}
+        void _notifyParticleQuota(size_t quota) {}
+        void _notifyDefaultDimensions(Real width, Real height) {}
+        void setRenderQueueGroup(uint8 queueID) {}
+        void setKeepParticlesInLocalSpace(bool keepLocal) {}
+        SortMode _getSortMode(void) const { return SM_DIRECTION; }
+        void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables) {}
+    };
+
+    // The per-particle loops the affectors ran before they were batched,
+    // which the batched versions must match exactly.
+
+    void clampAdjust(float* pComponent, float adjust)
+    {
+        *pComponent += adjust;
+        if (*pComponent < 0.0)
+            *pComponent = 0.0f;
+        else if (*pComponent > 1.0)
+            *pComponent = 1.0f;
+    }
+
+    void referenceLinearForce(ParticleSystem* pSystem, Real timeElapsed,
+        const Vector3& force, LinearForceAffector::ForceApplication fa)
+    {
+        ParticleIterator pi = pSystem->_getIterator();
+        Vector3 scaledVector = force * timeElapsed;
+        while (!pi.end())
+        {
+            Particle* p = pi.getNext();
+            if (fa == LinearForceAffector::FA_ADD)
+                p->direction += scaledVector;
+            else
+                p->direction = (p->direction + force) / 2;
+        }
+    }
+
+    void referenceColourFader(ParticleSystem* pSystem, Real timeElapsed,
+        const ColourValue& adj)
+    {
+        ParticleIterator pi = pSystem->_getIterator();
+        float dr = adj.r * timeElapsed;
+        float dg = adj.g * timeElapsed;
+        float db = adj.b * timeElapsed;
+        float da = adj.a * timeElapsed;
+        while (!pi.end())
+        {
+            Particle* p = pi.getNext();
+            clampAdjust(&p->colour.r, dr);
+            clampAdjust(&p->colour.g, dg);
+            clampAdjust(&p->colour.b, db);
+            clampAdjust(&p->colour.a, da);
+        }
+    }
+
+    void referenceColourFader2(ParticleSystem* pSystem, Real timeElapsed,
+        const ColourValue& adj1, const ColourValue& adj2, Real stateChange)
+    {
+        ParticleIterator pi = pSystem->_getIterator();
+        while (!pi.end())
+        {
+            Particle* p = pi.getNext();
+            const ColourValue& adj = p->timeToLive > stateChange ? adj1 : adj2;
+            clampAdjust(&p->colour.r, adj.r * timeElapsed);
+            clampAdjust(&p->colour.g, adj.g * timeElapsed);
+            clampAdjust(&p->colour.b, adj.b * timeElapsed);
+            clampAdjust(&p->colour.a, adj.a * timeElapsed);
+        }
+    }
+
+    void referenceColourInterpolator(ParticleSystem* pSystem, 
+        const ColourValue* colours, const Real* times, int numStages)
+    {
+        ParticleIterator pi = pSystem->_getIterator();
+        while (!pi.end())
+        {
+            Particle* p = pi.getNext();
+            Real particle_time = 1.0f - (p->timeToLive / p->totalTimeToLive);
+            if (particle_time <= times[0])
+            {
+                p->colour = colours[0];
+            }
+            else if (particle_time >= times[numStages - 1])
+            {
+                p->colour = colours[numStages - 1];
+            }
+            else
+            {
+                for (int i = 0; i < numStages - 1; ++i)
+                {
+                    if (particle_time >= times[i] && particle_time < times[i + 1])
+                    {
+                        particle_time -= times[i];
+                        particle_time /= (times[i + 1] - times[i]);
+                        p->colour.r = ((colours[i+1].r * particle_time) + (colours[i].r * (1.0f - particle_time)));
+                        p->colour.g = ((colours[i+1].g * particle_time) + (colours[i].g * (1.0f - particle_time)));
+                        p->colour.b = ((colours[i+1].b * particle_time) + (colours[i].b * (1.0f - particle_time)));
+                        p->colour.a = ((colours[i+1].a * particle_time) + (colours[i].a * (1.0f - particle_time)));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    void referenceDeflectorPlane(ParticleSystem* pSystem, Real timeElapsed,
+        const Vector3& point, const Vector3& normal, Real bounce)
+    {
+        Real planeDistance = - normal.dotProduct(point) / Math::Sqrt(normal.dotProduct(normal));
+        ParticleIterator pi = pSystem->_getIterator();
+        while (!pi.end())
+        {
+            Particle* p = pi.getNext();
+            Vector3 direction(p->direction * timeElapsed);
+            if (normal.dotProduct(p->position + direction) + planeDistance <= 0.0)
+            {
+                Real a = normal.dotProduct(p->position) + planeDistance;
+                if (a > 0.0)
+                {
+                    Vector3 directionPart = direction * (- a / direction.dotProduct(normal));
+                    p->position = (p->position + (directionPart)) + (((directionPart) - direction) * bounce);
+                    p->direction = (p->direction - (2.0 * p->direction.dotProduct(normal) * normal)) * bounce;
+                }
+            }
+        }
+    }
+
+    void referenceDirectionRandomiser(ParticleSystem* pSystem, Real timeElapsed,
+        Real randomness, Real scope, bool keepVelocity)
+    {
+        ParticleIterator pi = pSystem->_getIterator();
+        Real length = 0;
+        while (!pi.end())
+        {
+            Particle* p = pi.getNext();
+            if (scope > Math::UnitRandom())
+            {
+                if (!p->direction.isZeroLength())
+                {
+                    if (keepVelocity)
+                        length = p->direction.length();
+
+                    p->direction += Vector3(Math::RangeRandom(-randomness, randomness) * timeElapsed,
+                        Math::RangeRandom(-randomness, randomness) * timeElapsed,
+                        Math::RangeRandom(-randomness, randomness) * timeElapsed);
+
+                    if (keepVelocity)
+                        p->direction *= length / p->direction.length();
+                }
+            }
+        }
+    }
+
+    void referenceRotation(ParticleSystem* pSystem, Real timeElapsed)
+    {
+        ParticleIterator pi = pSystem->_getIterator();
+        while (!pi.end())
+        {
+            Particle* p = pi.getNext();
+            p->setRotation(p->rotation + (timeElapsed * p->rotationSpeed));
+        }
+    }
+
+    void referenceScale(ParticleSystem* pSystem, Real timeElapsed, Real rate)
+    {
+        ParticleIterator pi = pSystem->_getIterator();
+        Real ds = rate * timeElapsed;
+        while (!pi.end())
+        {
+            Particle* p = pi.getNext();
+            if (!p->hasOwnDimensions())
+                p->setDimensions(pSystem->getDefaultWidth() + ds, pSystem->getDefaultHeight() + ds);
+            else
+                p->setDimensions(p->getOwnWidth() + ds, p->getOwnHeight() + ds);
+        }
+    }
+}
+
+void ParticleAffectorTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    mRenderSystem = new NullRenderSystem();
+    mRoot->setRenderSystem(mRenderSystem);
+    mRenderSystem->_initialise(false);
+    mRenderSystem->_createRenderWindow("ParticleAffectorWindow", 64, 64, false);
+    MaterialManager::getSingleton().initialise();
+    ParticleSystemManager::getSingleton()._initialise();
+    // Created by Root::initialise, which needs a real render window
+    mControllerManager = new ControllerManager();
+
+    mSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+    mSystem = createSystem("ParticleAffectorTests/Batched");
+    mReference = createSystem("ParticleAffectorTests/Reference");
+    fillSystem(mSystem);
+    fillSystem(mReference);
+}
+void ParticleAffectorTests::tearDown()
+{
+    mRoot->destroySceneManager(mSceneMgr);
+    delete mControllerManager;
+    mRenderSystem->shutdown();
+    delete mRoot;
+    delete mRenderSystem;
+}
+
+ParticleSystem* ParticleAffectorTests::createSystem(const String& name)
+{
+    ParticleSystem* system = mSceneMgr->createParticleSystem(name, NUM_PARTICLES);
+    system->setDefaultDimensions(10, 20);
+    mSceneMgr->getRootSceneNode()->attachObject(system);
+    // Sets up the particle pool, without moving anything as there are no 
+    // particles yet
+    system->_update(0);
+    return system;
+}
+
+void ParticleAffectorTests::fillSystem(ParticleSystem* system)
+{
+    // Same random particles in both systems
+    srand(5);
+    for (size_t i = 0; i < NUM_PARTICLES; ++i)
+    {
+        Particle* p = system->createParticle();
+        CPPUNIT_ASSERT(p);
+        p->position = Vector3(Math::SymmetricRandom(), Math::SymmetricRandom(), 
+            Math::SymmetricRandom()) * 100;
+        p->direction = Vector3(Math::SymmetricRandom(), Math::SymmetricRandom(), 
+            Math::SymmetricRandom()) * 10;
+        // Some particles standing still
+        if (i % 7 == 0)
+            p->direction = Vector3::ZERO;
+        p->colour = ColourValue(Math::UnitRandom(), Math::UnitRandom(), 
+            Math::UnitRandom(), Math::UnitRandom());
+        p->totalTimeToLive = Math::RangeRandom(1, 5);
+        p->timeToLive = p->totalTimeToLive * Math::UnitRandom();
+        p->setRotation(Radian(Math::SymmetricRandom() * Math::PI));
+        p->rotationSpeed = Radian(Math::SymmetricRandom());
+        if (i % 3 == 0)
+            p->setDimensions(Math::RangeRandom(1, 10), Math::RangeRandom(1, 10));
+    }
+}
+
+void ParticleAffectorTests::checkSystemsEqual(void)
+{
+    CPPUNIT_ASSERT_EQUAL(mReference->getNumParticles(), mSystem->getNumParticles());
+    Particle* const* particles = mSystem->_getActiveParticles();
+    Particle* const* reference = mReference->_getActiveParticles();
+    for (size_t i = 0; i < mSystem->getNumParticles(); ++i)
+    {
+        const Particle* p = particles[i];
+        const Particle* r = reference[i];
+        CPPUNIT_ASSERT(p->position == r->position);
+        CPPUNIT_ASSERT(p->direction == r->direction);
+        CPPUNIT_ASSERT(p->colour == r->colour);
+        CPPUNIT_ASSERT(p->rotation == r->rotation);
+        CPPUNIT_ASSERT_EQUAL(r->timeToLive, p->timeToLive);
+        CPPUNIT_ASSERT_EQUAL(r->hasOwnDimensions(), p->hasOwnDimensions());
+        if (r->hasOwnDimensions())
+        {
+            CPPUNIT_ASSERT_EQUAL(r->getOwnWidth(), p->getOwnWidth());
+            CPPUNIT_ASSERT_EQUAL(r->getOwnHeight(), p->getOwnHeight());
+        }
+    }
+}
+
+void ParticleAffectorTests::testLinearForce()
+{
+    LinearForceAffector affector(mSystem);
+    Vector3 force(1, -9.8f, 0.5f);
+    affector.setForceVector(force);
+
+    affector.setForceApplication(LinearForceAffector::FA_ADD);
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    referenceLinearForce(mReference, TIME_ELAPSED, force, LinearForceAffector::FA_ADD);
+    checkSystemsEqual();
+
+    affector.setForceApplication(LinearForceAffector::FA_AVERAGE);
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    referenceLinearForce(mReference, TIME_ELAPSED, force, LinearForceAffector::FA_AVERAGE);
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testColourFader()
+{
+    ColourFaderAffector affector(mSystem);
+    // Large enough to clamp some components both ways
+    ColourValue adj(-2.5f, 3, 0.5f, -1);
+    affector.setAdjust(adj.r, adj.g, adj.b, adj.a);
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    referenceColourFader(mReference, TIME_ELAPSED, adj);
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testColourFader2()
+{
+    ColourFaderAffector2 affector(mSystem);
+    ColourValue adj1(-2.5f, 3, 0.5f, -1);
+    ColourValue adj2(4, -0.5f, -3, 2);
+    affector.setAdjust1(adj1.r, adj1.g, adj1.b, adj1.a);
+    affector.setAdjust2(adj2.r, adj2.g, adj2.b, adj2.a);
+    affector.setStateChange(1.5f);
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    referenceColourFader2(mReference, TIME_ELAPSED, adj1, adj2, 1.5f);
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testColourInterpolator()
+{
+    const int numStages = 6;
+    ColourValue colours[numStages] = { ColourValue::Black, ColourValue::Red,
+        ColourValue::Green, ColourValue::Blue, ColourValue::White, ColourValue(0.5f, 0.5f, 0.5f, 0) };
+    // Outer stages not at 0 and 1 so some particles take the clamped paths
+    Real times[numStages] = { 0.1f, 0.25f, 0.4f, 0.6f, 0.75f, 0.9f };
+
+    ColourInterpolatorAffector affector(mSystem);
+    for (int i = 0; i < numStages; ++i)
+    {
+        affector.setColourAdjust(i, colours[i]);
+        affector.setTimeAdjust(i, times[i]);
+    }
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    referenceColourInterpolator(mReference, colours, times, numStages);
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testDeflectorPlane()
+{
+    // Close to the particles so some of them cross it
+    Vector3 point(0, 0.5f, 0);
+    Vector3 normal(0, 1, 0);
+    DeflectorPlaneAffector affector(mSystem);
+    affector.setPlanePoint(point);
+    affector.setPlaneNormal(normal);
+    affector.setBounce(0.8f);
+    // A long step, so particles travel far enough to hit the plane
+    affector._affectParticles(mSystem, 5);
+    referenceDeflectorPlane(mReference, 5, point, normal, 0.8f);
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testDirectionRandomiser()
+{
+    DirectionRandomiserAffector affector(mSystem);
+    affector.setRandomness(50);
+    affector.setScope(0.7f);
+
+    // Both draw the same random numbers in the same order
+    affector.setKeepVelocity(false);
+    srand(11);
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    srand(11);
+    referenceDirectionRandomiser(mReference, TIME_ELAPSED, 50, 0.7f, false);
+    checkSystemsEqual();
+
+    affector.setKeepVelocity(true);
+    srand(12);
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    srand(12);
+    referenceDirectionRandomiser(mReference, TIME_ELAPSED, 50, 0.7f, true);
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testRotation()
+{
+    RotationAffector affector(mSystem);
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    referenceRotation(mReference, TIME_ELAPSED);
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testScale()
+{
+    ScaleAffector affector(mSystem);
+    affector.setAdjust(3.5f);
+    affector._affectParticles(mSystem, TIME_ELAPSED);
+    referenceScale(mReference, TIME_ELAPSED, 3.5f);
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testExpiryKeepsOrder()
+{
+    std::vector<Particle*> before(mSystem->_getActiveParticles(), 
+        mSystem->_getActiveParticles() + mSystem->getNumParticles());
+
+    // Expire roughly half of the particles, with no emitters to add any
+    mSystem->_update(1.0f);
+
+    size_t numExpired = 0;
+    size_t next = 0;
+    Particle* const* after = mSystem->_getActiveParticles();
+    for (size_t i = 0; i < before.size(); ++i)
+    {
+        if (next < mSystem->getNumParticles() && after[next] == before[i])
+            ++next;
+        else
+            ++numExpired;
+    }
+    // The survivors are all there, in the order they were created in
+    CPPUNIT_ASSERT_EQUAL(mSystem->getNumParticles(), next);
+    CPPUNIT_ASSERT(numExpired > 0);
+    CPPUNIT_ASSERT(next > 0);
+}
+
+void ParticleAffectorTests::testMotion()
+{
+    // Particles live long enough not to expire
+    Particle* const* particles = mSystem->_getActiveParticles();
+    Particle* const* reference = mReference->_getActiveParticles();
+    for (size_t i = 0; i < mSystem->getNumParticles(); ++i)
+    {
+        particles[i]->timeToLive = 10;
+        reference[i]->timeToLive = 10;
+    }
+
+    // Motion on the whole system goes through OptimisedUtil, which picks 
+    // the SIMD implementation where available
+    mSystem->_update(TIME_ELAPSED);
+    for (size_t i = 0; i < mReference->getNumParticles(); ++i)
+    {
+        Particle* p = reference[i];
+        p->position += p->direction * TIME_ELAPSED;
+        p->timeToLive -= TIME_ELAPSED;
+    }
+    checkSystemsEqual();
+}
+
+void ParticleAffectorTests::testListRendererCallbacks()
+{
+    // ParticleSystem hands renderers a vector, which still reaches 
+    // renderers that only override the std::list versions
+    std::vector<Particle*> particles(mSystem->_getActiveParticles(), 
+        mSystem->_getActiveParticles() + mSystem->getNumParticles());
+    ListRenderer renderer;
+    ParticleSystemRenderer* base = &renderer;
+    base->_updateRenderQueue(0, particles, false);
+    base->_notifyParticleMoved(particles);
+    base->_notifyParticleCleared(particles);
+    CPPUNIT_ASSERT_EQUAL(NUM_PARTICLES, renderer.numQueued);
+    CPPUNIT_ASSERT_EQUAL(NUM_PARTICLES, renderer.numMoved);
+    CPPUNIT_ASSERT_EQUAL(NUM_PARTICLES, renderer.numCleared);
+}
@@ -27,6 +27,8 @@ Torus Knot Software Ltd.
 -----------------------------------------------------------------------------
 */
 #include "PixelFormatTests.h"
+#include "OgreStringConverter.h"
+#include "OgreWorkerThreadPool.h"
 #include <cstdlib>
 
 // Register the suite
@@ -225,3 +227,171 @@ void PixelFormatTests::testBulkConversion()
     //CPPUNIT_ASSERT_MESSAGE("Conversion mismatch", false);
 }
 
+void PixelFormatTests::testFloat16BulkConversion()
+{
+    // Values covering normal, denormal, underflowing and overflowing halves,
+    // no NaNs since these may not survive the naive path through floats
+    const size_t count = size / sizeof(float);
+    float* floats = reinterpret_cast<float*>(randomData);
+    for (size_t i = 0; i < count; ++i)
+    {
+        float mantissa = (rand() / (float)RAND_MAX) * ((i & 1) ? 1.0f : -1.0f);
+        floats[i] = ldexp(mantissa, (int)(i % 48) - 30);
+    }
+    floats[0] = 0.0f;
+    floats[1] = -0.0f;
+
+    const PixelFormat formats[][2] = 
+    {
+        { PF_FLOAT32_R, PF_FLOAT16_R },
+        { PF_FLOAT32_GR, PF_FLOAT16_GR },
+        { PF_FLOAT32_RGB, PF_FLOAT16_RGB },
+        { PF_FLOAT32_RGBA, PF_FLOAT16_RGBA },
+    };
+    for (size_t f = 0; f < 4; ++f)
+    {
+        // Float32 to float16 must match Bitwise::floatToHalf exactly
+        testCase(formats[f][0], formats[f][1]);
+        // And back, from the halves just made
+        memcpy(randomData, temp, size);
+        testCase(formats[f][1], formats[f][0]);
+        for (size_t i = 0; i < count; ++i)
+            floats[i] = ldexp((rand() / (float)RAND_MAX) - 0.5f, (int)(i % 48) - 30);
+    }
+}
+
+
+namespace
+{
+    /// Buffer of random bytes
+    std::vector<uint8> randomBuffer(size_t bytes)
+    {
+        std::vector<uint8> buffer(bytes);
+        for (size_t i = 0; i < bytes; ++i)
+            buffer[i] = (uint8)rand();
+        return buffer;
+    }
+
+    /// Worker threads for the duration of a test, if there are none yet
+    class ScopedWorkerThreads
+    {
+    protected:
+        WorkerThreadPool* mPool;
+    public:
+        ScopedWorkerThreads()
+            : mPool(WorkerThreadPool::getSingletonPtr() ? 0 : new WorkerThreadPool()) {}
+        ~ScopedWorkerThreads()
+        {
+            WorkerThreadPool::getSingleton().setNumWorkerThreads(0);
+            delete mPool;
+        }
+        void setNumWorkerThreads(size_t num)
+        {
+            WorkerThreadPool::getSingleton().setNumWorkerThreads(num);
+            CPPUNIT_ASSERT_EQUAL(num > 0, WorkerThreadPool::getSingleton().isParallel());
+        }
+    };
+}
+
+void PixelFormatTests::testParallelConversionCase(PixelFormat srcFormat, 
+    PixelFormat dstFormat, size_t width, size_t height, size_t depth, 
+    const Box& srcBox, const Box& dstBox)
+{
+    std::vector<uint8> srcData = randomBuffer(
+        width * height * depth * PixelUtil::getNumElemBytes(srcFormat));
+    // Anything outside the destination box must be left alone
+    const size_t dstBytes = width * height * depth * PixelUtil::getNumElemBytes(dstFormat);
+    std::vector<uint8> serialData(dstBytes, 0xcd), parallelData(dstBytes, 0xcd);
+
+    PixelBox srcPixels(width, height, depth, srcFormat, &srcData[0]);
+    PixelBox serialPixels(width, height, depth, dstFormat, &serialData[0]);
+    PixelBox parallelPixels(width, height, depth, dstFormat, &parallelData[0]);
+
+    ScopedWorkerThreads threads;
+    threads.setNumWorkerThreads(0);
+    PixelUtil::bulkPixelConversion(
+        srcPixels.getSubVolume(srcBox), serialPixels.getSubVolume(dstBox));
+    threads.setNumWorkerThreads(3);
+    PixelUtil::bulkPixelConversion(
+        srcPixels.getSubVolume(srcBox), parallelPixels.getSubVolume(dstBox));
+
+    CPPUNIT_ASSERT_MESSAGE("Parallel conversion mismatch [" + 
+        PixelUtil::getFormatName(srcFormat) + "->" + PixelUtil::getFormatName(dstFormat) + "]",
+        serialData == parallelData);
+}
+
+void PixelFormatTests::testParallelBulkConversion()
+{
+    // Each box is large enough to be split up; the band boundaries don't 
+    // fall on any particular multiple
+    Box rows(0, 0, 0, 301, 253, 1);
+    testParallelConversionCase(PF_R8G8B8, PF_A8R8G8B8, 301, 253, 1, rows, rows);
+    testParallelConversionCase(PF_A8R8G8B8, PF_A8B8G8R8, 301, 253, 1, rows, rows);
+    testParallelConversionCase(PF_A8R8G8B8, PF_R5G6B5, 301, 253, 1, rows, rows);
+    testParallelConversionCase(PF_A8R8G8B8, PF_A8R8G8B8, 301, 253, 1, rows, rows);
+
+    Box columns(0, 0, 0, 70001, 1, 1);
+    testParallelConversionCase(PF_B8G8R8A8, PF_L8, 70001, 1, 1, columns, columns);
+
+    Box slices(0, 0, 0, 61, 67, 19);
+    testParallelConversionCase(PF_FLOAT32_RGB, PF_FLOAT16_RGB, 61, 67, 19, slices, slices);
+    testParallelConversionCase(PF_FLOAT16_RGBA, PF_A8B8G8R8, 61, 67, 19, slices, slices);
+
+    // Sub-boxes at different places in the source and destination, so the
+    // bands have to carry the offsets and pitches of both
+    Box srcPart(5, 3, 0, 325, 263, 1);
+    Box dstPart(11, 0, 0, 331, 260, 1);
+    testParallelConversionCase(PF_R8G8B8, PF_B8G8R8A8, 340, 270, 1, srcPart, dstPart);
+    testParallelConversionCase(PF_L16, PF_FLOAT32_R, 340, 270, 1, srcPart, dstPart);
+    Box srcSlab(2, 4, 1, 62, 64, 21);
+    Box dstSlab(0, 1, 3, 60, 61, 23);
+    testParallelConversionCase(PF_A8R8G8B8, PF_R8G8B8, 64, 66, 24, srcSlab, dstSlab);
+}
+
+void PixelFormatTests::testParallelScaleCase(PixelFormat srcFormat, 
+    PixelFormat dstFormat, Image::Filter filter)
+{
+    const size_t srcWidth = 203, srcHeight = 149;
+    const size_t dstWidth = 417, dstHeight = 311;
+    std::vector<uint8> srcData = randomBuffer(
+        srcWidth * srcHeight * PixelUtil::getNumElemBytes(srcFormat));
+    if (PixelUtil::isFloatingPoint(srcFormat))
+    {
+        // Random bits make NaNs, which need not come out the same
+        PixelBox unit(srcWidth, srcHeight, 1, PF_A8R8G8B8, &srcData[0]);
+        PixelUtil::bulkPixelConversion(unit, 
+            PixelBox(srcWidth, srcHeight, 1, srcFormat, &srcData[0]));
+    }
+    const size_t dstBytes = dstWidth * dstHeight * PixelUtil::getNumElemBytes(dstFormat);
+    std::vector<uint8> serialData(dstBytes, 0xcd), parallelData(dstBytes, 0xcd);
+
+    PixelBox srcPixels(srcWidth, srcHeight, 1, srcFormat, &srcData[0]);
+    ScopedWorkerThreads threads;
+    threads.setNumWorkerThreads(0);
+    Image::scale(srcPixels, 
+        PixelBox(dstWidth, dstHeight, 1, dstFormat, &serialData[0]), filter);
+    threads.setNumWorkerThreads(3);
+    Image::scale(srcPixels, 
+        PixelBox(dstWidth, dstHeight, 1, dstFormat, &parallelData[0]), filter);
+
+    CPPUNIT_ASSERT_MESSAGE("Parallel scale mismatch [" + 
+        PixelUtil::getFormatName(srcFormat) + "->" + PixelUtil::getFormatName(dstFormat) + 
+        ", filter " + StringConverter::toString(filter) + "]",
+        serialData == parallelData);
+}
+
+void PixelFormatTests::testParallelScale()
+{
+    // One case for each of the resamplers Image::scale picks from
+    testParallelScaleCase(PF_R8G8B8, PF_R8G8B8, Image::FILTER_NEAREST);
+    testParallelScaleCase(PF_A8R8G8B8, PF_A8R8G8B8, Image::FILTER_NEAREST);
+    testParallelScaleCase(PF_FLOAT32_RGBA, PF_FLOAT32_RGBA, Image::FILTER_NEAREST);
+    testParallelScaleCase(PF_L8, PF_L8, Image::FILTER_BILINEAR);
+    testParallelScaleCase(PF_A8R8G8B8, PF_A8R8G8B8, Image::FILTER_BILINEAR);
+    testParallelScaleCase(PF_FLOAT32_RGB, PF_FLOAT32_RGB, Image::FILTER_BILINEAR);
+    testParallelScaleCase(PF_R5G6B5, PF_R5G6B5, Image::FILTER_BILINEAR);
+    testParallelScaleCase(PF_FLOAT16_RGBA, PF_FLOAT16_RGBA, Image::FILTER_BILINEAR);
+    // Scaling to another format converts through a temporary box
+    testParallelScaleCase(PF_A8R8G8B8, PF_R8G8B8, Image::FILTER_NEAREST);
+    testParallelScaleCase(PF_A8R8G8B8, PF_FLOAT32_RGBA, Image::FILTER_BILINEAR);
+}
@@ -0,0 +1,125 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ProfilerCaptureTests.h"
+#include <sstream>
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ProfilerCaptureTests );
+
+void ProfilerCaptureTests::setUp()
+{
+    mTimer = new Timer();
+    // Root only creates a profiler when OGRE_PROFILING is set
+    mProfiler = Profiler::getSingletonPtr() ? 0 : new Profiler();
+    Profiler::getSingleton().setTimer(mTimer);
+}
+void ProfilerCaptureTests::tearDown()
+{
+    Profiler::getSingleton().endCapture();
+    delete mProfiler;
+    delete mTimer;
+}
+
+String ProfilerCaptureTests::writeCapture()
+{
+    std::ostringstream os;
+    Profiler::getSingleton().writeCapture(os);
+    return os.str();
+}
+
+void ProfilerCaptureTests::testRegisterCaptureProfile()
+{
+    Profiler& profiler = Profiler::getSingleton();
+    ProfileId a = profiler.registerCaptureProfile("CaptureA");
+    ProfileId b = profiler.registerCaptureProfile("CaptureB");
+
+    CPPUNIT_ASSERT(a != b);
+    CPPUNIT_ASSERT_EQUAL(a, profiler.registerCaptureProfile("CaptureA"));
+    CPPUNIT_ASSERT_EQUAL(String("CaptureA"), profiler.getCaptureProfileName(a));
+    CPPUNIT_ASSERT_EQUAL(String("CaptureB"), profiler.getCaptureProfileName(b));
+}
+
+void ProfilerCaptureTests::testCaptureRecordsScopes()
+{
+    Profiler& profiler = Profiler::getSingleton();
+    ProfileId outer = profiler.registerCaptureProfile("Outer");
+    ProfileId inner = profiler.registerCaptureProfile("Inner \"quoted\"");
+
+    profiler.beginCapture(16);
+    CPPUNIT_ASSERT(Profiler::isCapturing());
+    {
+        ProfileCaptureScope outerScope(outer);
+        ProfileCaptureScope innerScope(inner);
+    }
+    profiler.endCapture();
+    CPPUNIT_ASSERT(!Profiler::isCapturing());
+
+    String trace = writeCapture();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, trace.find("{\"traceEvents\":["));
+    // Scopes are recorded as they end, so the inner one comes first
+    size_t innerPos = trace.find("\"name\":\"Inner \\\"quoted\\\"\",\"ph\":\"X\"");
+    size_t outerPos = trace.find("\"name\":\"Outer\",\"ph\":\"X\"");
+    CPPUNIT_ASSERT(innerPos != String::npos);
+    CPPUNIT_ASSERT(outerPos != String::npos);
+    CPPUNIT_ASSERT(innerPos < outerPos);
+}
+
+void ProfilerCaptureTests::testCaptureRingBufferKeepsNewest()
+{
+    Profiler& profiler = Profiler::getSingleton();
+    ProfileId first = profiler.registerCaptureProfile("First");
+    ProfileId second = profiler.registerCaptureProfile("Second");
+    ProfileId third = profiler.registerCaptureProfile("Third");
+
+    profiler.beginCapture(2);
+    { ProfileCaptureScope scope(first); }
+    { ProfileCaptureScope scope(second); }
+    { ProfileCaptureScope scope(third); }
+    profiler.endCapture();
+
+    String trace = writeCapture();
+    size_t secondPos = trace.find("\"Second\"");
+    size_t thirdPos = trace.find("\"Third\"");
+    CPPUNIT_ASSERT_EQUAL(String::npos, trace.find("\"First\""));
+    CPPUNIT_ASSERT(secondPos != String::npos);
+    CPPUNIT_ASSERT(thirdPos != String::npos);
+    CPPUNIT_ASSERT(secondPos < thirdPos);
+}
+
+void ProfilerCaptureTests::testNoEventsOutsideCapture()
+{
+    Profiler& profiler = Profiler::getSingleton();
+    ProfileId id = profiler.registerCaptureProfile("Outside");
+
+    profiler.beginCapture(16);
+    profiler.endCapture();
+    { ProfileCaptureScope scope(id); }
+
+    CPPUNIT_ASSERT_EQUAL(String::npos, writeCapture().find("\"Outside\""));
+}
@@ -0,0 +1,193 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ProgressiveMeshTests.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreProgressiveMesh.h"
+#include "OgreMath.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ProgressiveMeshTests );
+
+namespace
+{
+    /** ProgressiveMesh which checks its collapse order against the linear
+        scan over all costs which the collapse heap replaced. */
+    class ScanCheckingProgressiveMesh : public ProgressiveMesh
+    {
+    public:
+        ScanCheckingProgressiveMesh(const VertexData* vd, const IndexData* id)
+            : ProgressiveMesh(vd, id) {}
+
+        size_t scanNextCollapser(void)
+        {
+            Real bestVal = 99999.9f;
+            size_t bestIndex = 0;
+            for (size_t i = 0; i < mNumCommonVertices; ++i)
+            {
+                if (mWorstCosts[i] < bestVal)
+                {
+                    bestVal = mWorstCosts[i];
+                    bestIndex = i;
+                }
+            }
+            return bestIndex;
+        }
+
+        /// Collapse as far as possible, returning the number of collapses
+        size_t collapseAllChecked(void)
+        {
+            mCurrNumIndexes = mpIndexData->indexCount;
+            computeAllCosts();
+            initialiseCollapseHeap();
+
+            size_t numCollapses = 0;
+            while (numCollapses + 3 < mNumCommonVertices)
+            {
+                size_t nextIndex = getNextCollapser();
+                CPPUNIT_ASSERT_EQUAL(scanNextCollapser(), nextIndex);
+
+                bool abandon = false;
+                for (WorkingDataList::iterator idata = mWorkingData.begin(); 
+                    idata != mWorkingData.end(); ++idata)
+                {
+                    PMVertex* collapser = &(idata->mVertList.at(nextIndex));
+                    if (collapser->collapseTo == NULL)
+                    {
+                        abandon = true;
+                        break;
+                    }
+                    collapse(collapser);
+                }
+                if (abandon)
+                    break;
+                ++numCollapses;
+            }
+            return numCollapses;
+        }
+    };
+}
+
+void ProgressiveMeshTests::setUp()
+{
+    mBufMgr = new DefaultHardwareBufferManager();
+    LogManager::getSingleton().createLog("ProgressiveMeshTests.log", true);
+}
+void ProgressiveMeshTests::tearDown()
+{
+    delete mBufMgr;
+}
+
+void ProgressiveMeshTests::createGrid(VertexData& vd, IndexData& id, 
+    size_t size, Real heightScale)
+{
+    vd.vertexCount = size * size;
+    vd.vertexStart = 0;
+    vd.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        sizeof(float)*3, vd.vertexCount, HardwareBuffer::HBU_STATIC, true);
+    vd.vertexBufferBinding->setBinding(0, vbuf);
+    float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t z = 0; z < size; ++z)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            *pFloat++ = (float)x * 10;
+            // Repeating heights give plenty of equal costs
+            *pFloat++ = heightScale * Math::Sin(Radian((float)((x * 7 + z * 3) % 5)));
+            *pFloat++ = (float)z * 10;
+        }
+    }
+    vbuf->unlock();
+
+    id.indexCount = (size - 1) * (size - 1) * 6;
+    id.indexStart = 0;
+    id.indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_16BIT, id.indexCount, HardwareBuffer::HBU_STATIC, true);
+    unsigned short* pIdx = static_cast<unsigned short*>(
+        id.indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t z = 0; z < size - 1; ++z)
+    {
+        for (size_t x = 0; x < size - 1; ++x)
+        {
+            unsigned short v = static_cast<unsigned short>(z * size + x);
+            *pIdx++ = v; *pIdx++ = v + size; *pIdx++ = v + 1;
+            *pIdx++ = v + 1; *pIdx++ = v + size; *pIdx++ = v + size + 1;
+        }
+    }
+    id.indexBuffer->unlock();
+}
+
+void ProgressiveMeshTests::testCollapseOrderMatchesScan()
+{
+    VertexData vd;
+    IndexData id;
+    createGrid(vd, id, 12, 5);
+
+    ScanCheckingProgressiveMesh pm(&vd, &id);
+    CPPUNIT_ASSERT(pm.collapseAllChecked() > 0);
+}
+
+void ProgressiveMeshTests::testCollapseOrderMatchesScanMultiBuffer()
+{
+    VertexData vd, extra;
+    IndexData id, extraId;
+    createGrid(vd, id, 10, 5);
+    // Same topology, another animation frame
+    createGrid(extra, extraId, 10, -20);
+
+    ScanCheckingProgressiveMesh pm(&vd, &id);
+    pm.addExtraVertexPositionBuffer(&extra);
+    CPPUNIT_ASSERT(pm.collapseAllChecked() > 0);
+}
+
+void ProgressiveMeshTests::testBuildLevels()
+{
+    VertexData vd;
+    IndexData id;
+    createGrid(vd, id, 12, 5);
+
+    ProgressiveMesh pm(&vd, &id);
+    ProgressiveMesh::LODFaceList lods;
+    pm.build(3, &lods, ProgressiveMesh::VRQ_PROPORTIONAL, 0.5f);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)3, lods.size());
+    size_t prevCount = id.indexCount;
+    for (size_t i = 0; i < lods.size(); ++i)
+    {
+        // Every level has the same or fewer triangles than the one before
+        if (i == 0)
+            CPPUNIT_ASSERT(lods[i]->indexCount < prevCount);
+        else
+            CPPUNIT_ASSERT(lods[i]->indexCount <= prevCount);
+        CPPUNIT_ASSERT_EQUAL(lods[i]->indexCount, lods[i]->indexBuffer->getNumIndexes());
+        CPPUNIT_ASSERT_EQUAL(HardwareIndexBuffer::IT_16BIT, lods[i]->indexBuffer->getType());
+        prevCount = lods[i]->indexCount;
+        delete lods[i];
+    }
+}
@@ -0,0 +1,133 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "RenderStateCacheTests.h"
+#include "OgreRenderWindow.h"
+#include "OgreViewport.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( RenderStateCacheTests );
+
+void RenderStateCacheTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    mRenderSystem = new NullRenderSystem();
+    mRoot->setRenderSystem(mRenderSystem);
+    mRenderSystem->_initialise(false);
+    mWindow = mRenderSystem->_createRenderWindow("StateCacheWindow", 64, 64, false);
+    mViewport = mWindow->addViewport(0);
+    mRenderSystem->_setViewport(mViewport);
+    mRenderSystem->_beginGeometryCount();
+}
+void RenderStateCacheTests::tearDown()
+{
+    mRenderSystem->shutdown();
+    delete mRoot;
+    delete mRenderSystem;
+}
+
+void RenderStateCacheTests::setSomeState(void)
+{
+    mRenderSystem->_setCullingMode(CULL_ANTICLOCKWISE);
+    mRenderSystem->_setDepthBufferCheckEnabled(true);
+    mRenderSystem->_setDepthBufferFunction(CMPF_LESS);
+    mRenderSystem->setLightingEnabled(false);
+    mRenderSystem->_setSceneBlending(SBF_SOURCE_ALPHA, SBF_ONE_MINUS_SOURCE_ALPHA);
+    mRenderSystem->_setTexture(0, false, TexturePtr());
+}
+
+void RenderStateCacheTests::testRedundantChangesFiltered()
+{
+    setSomeState();
+    CPPUNIT_ASSERT_EQUAL(6u, mRenderSystem->_getStateChangeCount());
+    CPPUNIT_ASSERT_EQUAL(0u, mRenderSystem->_getFilteredStateChangeCount());
+
+    setSomeState();
+    CPPUNIT_ASSERT_EQUAL(6u, mRenderSystem->_getStateChangeCount());
+    CPPUNIT_ASSERT_EQUAL(6u, mRenderSystem->_getFilteredStateChangeCount());
+
+    // A different value always goes through, and is cached in turn
+    mRenderSystem->_setCullingMode(CULL_NONE);
+    mRenderSystem->_setCullingMode(CULL_NONE);
+    CPPUNIT_ASSERT_EQUAL(7u, mRenderSystem->_getStateChangeCount());
+    CPPUNIT_ASSERT_EQUAL(7u, mRenderSystem->_getFilteredStateChangeCount());
+}
+
+void RenderStateCacheTests::testCacheDisabled()
+{
+    mRenderSystem->setStateCacheEnabled(false);
+    setSomeState();
+    setSomeState();
+    CPPUNIT_ASSERT_EQUAL(12u, mRenderSystem->_getStateChangeCount());
+    CPPUNIT_ASSERT_EQUAL(0u, mRenderSystem->_getFilteredStateChangeCount());
+}
+
+void RenderStateCacheTests::testInvalidateStateCache()
+{
+    setSomeState();
+    // What a render system does on losing the device state, e.g. the GL 
+    // render system on a context switch
+    mRenderSystem->_invalidateStateCache();
+    setSomeState();
+    CPPUNIT_ASSERT_EQUAL(12u, mRenderSystem->_getStateChangeCount());
+    CPPUNIT_ASSERT_EQUAL(0u, mRenderSystem->_getFilteredStateChangeCount());
+}
+
+void RenderStateCacheTests::testRenderTargetChangeInvalidates()
+{
+    RenderWindow* other = mRenderSystem->_createRenderWindow(
+        "StateCacheOther", 32, 32, false);
+    Viewport* otherViewport = other->addViewport(0);
+
+    setSomeState();
+    mRenderSystem->_setViewport(otherViewport);
+    mRenderSystem->_beginGeometryCount();
+    setSomeState();
+    // Culling and textures are forgotten on switching target
+    CPPUNIT_ASSERT_EQUAL(2u, mRenderSystem->_getStateChangeCount());
+    CPPUNIT_ASSERT_EQUAL(4u, mRenderSystem->_getFilteredStateChangeCount());
+
+    // Another viewport on the same target keeps everything
+    Viewport* sameTarget = other->addViewport(0, 1, 0.5, 0.5, 0.5, 0.5);
+    mRenderSystem->_setViewport(sameTarget);
+    mRenderSystem->_beginGeometryCount();
+    setSomeState();
+    CPPUNIT_ASSERT_EQUAL(0u, mRenderSystem->_getStateChangeCount());
+    CPPUNIT_ASSERT_EQUAL(6u, mRenderSystem->_getFilteredStateChangeCount());
+}
+
+void RenderStateCacheTests::testBeginFrameInvalidatesTextures()
+{
+    setSomeState();
+    mRenderSystem->_beginFrame();
+    mRenderSystem->_beginGeometryCount();
+    setSomeState();
+    CPPUNIT_ASSERT_EQUAL(1u, mRenderSystem->_getStateChangeCount());
+    CPPUNIT_ASSERT_EQUAL(5u, mRenderSystem->_getFilteredStateChangeCount());
+    mRenderSystem->_endFrame();
+}
@@ -0,0 +1,230 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ResourceBackgroundQueueTests.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreResourceManager.h"
+#include "OgreException.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ResourceBackgroundQueueTests );
+
+namespace
+{
+    /// Names of the resources prepared, in order
+    StringVector gPrepared;
+
+    /// Resource which needs no data, and fails to load if asked to
+    class QueuedResource : public Resource
+    {
+    public:
+        QueuedResource(ResourceManager* creator, const String& name, 
+            ResourceHandle handle, const String& group)
+            : Resource(creator, name, handle, group) {}
+    protected:
+        void prepareImpl(void) { gPrepared.push_back(mName); }
+        void loadImpl(void)
+        {
+            if (StringUtil::startsWith(mName, "fail", false))
+            {
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
+                    "Failed to load " + mName, "QueuedResource::loadImpl");
+            }
+        }
+        void unloadImpl(void) {}
+        size_t calculateSize(void) const { return 0; }
+    };
+
+    class QueuedResourceManager : public ResourceManager
+    {
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle, 
+            const String& group, bool isManual, ManualResourceLoader* loader, 
+            const NameValuePairList* createParams)
+        {
+            return new QueuedResource(this, name, handle, group);
+        }
+    public:
+        QueuedResourceManager()
+        {
+            mResourceType = "Queued";
+            mLoadOrder = 0;
+            ResourceGroupManager::getSingleton()._registerResourceManager(
+                mResourceType, this);
+        }
+        ~QueuedResourceManager()
+        {
+            ResourceGroupManager::getSingleton()._unregisterResourceManager(
+                mResourceType);
+        }
+    };
+
+    /// Records the tickets it is told about
+    class RecordingListener : public ResourceBackgroundQueue::Listener
+    {
+    public:
+        std::vector<BackgroundProcessTicket> completedInThread;
+        std::vector<BackgroundProcessTicket> completed;
+
+        void operationCompletedInThread(BackgroundProcessTicket ticket)
+        {
+            completedInThread.push_back(ticket);
+        }
+        void operationCompleted(BackgroundProcessTicket ticket)
+        {
+            completed.push_back(ticket);
+        }
+    };
+}
+
+void ResourceBackgroundQueueTests::setUp()
+{
+    gPrepared.clear();
+    mRoot = new Root("", "", "");
+    mManager = new QueuedResourceManager();
+    mQueue = ResourceBackgroundQueue::getSingletonPtr();
+    // Requests are processed by the test itself
+    mQueue->setStartBackgroundThread(false);
+    mQueue->initialise();
+}
+void ResourceBackgroundQueueTests::tearDown()
+{
+    mQueue->shutdown();
+    delete mManager;
+    delete mRoot;
+}
+
+void ResourceBackgroundQueueTests::processQueued(void)
+{
+    while (mQueue->_doNextQueuedBackgroundProcess())
+    {
+    }
+}
+
+void ResourceBackgroundQueueTests::testPriorityOrder()
+{
+#if OGRE_THREAD_SUPPORT
+    mQueue->load("Queued", "a", "General", false, 0, 0, 0, 0);
+    mQueue->load("Queued", "b", "General", false, 0, 0, 0, 2);
+    mQueue->load("Queued", "c", "General", false, 0, 0, 0, 1);
+    mQueue->load("Queued", "d", "General", false, 0, 0, 0, 2);
+    processQueued();
+
+    // Highest priority first, in the order queued within a priority
+    CPPUNIT_ASSERT_EQUAL((size_t)4, gPrepared.size());
+    CPPUNIT_ASSERT_EQUAL(String("b"), gPrepared[0]);
+    CPPUNIT_ASSERT_EQUAL(String("d"), gPrepared[1]);
+    CPPUNIT_ASSERT_EQUAL(String("c"), gPrepared[2]);
+    CPPUNIT_ASSERT_EQUAL(String("a"), gPrepared[3]);
+    mQueue->_fireBackgroundLoadingComplete();
+#endif
+}
+
+void ResourceBackgroundQueueTests::testCancel()
+{
+#if OGRE_THREAD_SUPPORT
+    RecordingListener listener;
+    BackgroundProcessTicket a = 
+        mQueue->load("Queued", "a", "General", false, 0, 0, &listener);
+    BackgroundProcessTicket b = 
+        mQueue->load("Queued", "b", "General", false, 0, 0, &listener);
+
+    // Cancelled before it started, so never prepared
+    CPPUNIT_ASSERT(mQueue->cancel(a));
+    CPPUNIT_ASSERT(mQueue->isProcessComplete(a));
+    CPPUNIT_ASSERT(!mQueue->cancel(a));
+    processQueued();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, gPrepared.size());
+    CPPUNIT_ASSERT_EQUAL(String("b"), gPrepared[0]);
+
+    // Cancelled once prepared, so never loaded
+    CPPUNIT_ASSERT(!mQueue->isProcessComplete(b));
+    CPPUNIT_ASSERT(mQueue->cancel(b));
+    CPPUNIT_ASSERT(mQueue->isProcessComplete(b));
+    mQueue->_fireBackgroundLoadingComplete();
+    CPPUNIT_ASSERT(!mManager->getByName("b")->isLoaded());
+
+    // Cancelled requests are not reported
+    CPPUNIT_ASSERT(listener.completedInThread.empty());
+    CPPUNIT_ASSERT(listener.completed.empty());
+#endif
+}
+
+void ResourceBackgroundQueueTests::testTicketCompletion()
+{
+    RecordingListener listener;
+    BackgroundProcessTicket a = 
+        mQueue->load("Queued", "a", "General", false, 0, 0, &listener);
+#if OGRE_THREAD_SUPPORT
+    CPPUNIT_ASSERT(!mQueue->isProcessComplete(a));
+
+    // Prepared, but not complete until the main thread has loaded it
+    processQueued();
+    CPPUNIT_ASSERT(!mQueue->isProcessComplete(a));
+    CPPUNIT_ASSERT(listener.completedInThread.empty());
+
+    mQueue->_fireBackgroundLoadingComplete();
+    CPPUNIT_ASSERT(mQueue->isProcessComplete(a));
+    CPPUNIT_ASSERT(mManager->getByName("a")->isLoaded());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, listener.completedInThread.size());
+    CPPUNIT_ASSERT_EQUAL(a, listener.completedInThread[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, listener.completed.size());
+    CPPUNIT_ASSERT_EQUAL(a, listener.completed[0]);
+#else
+    // Loaded synchronously
+    CPPUNIT_ASSERT(mQueue->isProcessComplete(a));
+    CPPUNIT_ASSERT(mManager->getByName("a")->isLoaded());
+#endif
+}
+
+void ResourceBackgroundQueueTests::testFailedLoadCompletes()
+{
+#if OGRE_THREAD_SUPPORT
+    RecordingListener listener;
+    BackgroundProcessTicket fail = 
+        mQueue->load("Queued", "fail", "General", false, 0, 0, &listener);
+    BackgroundProcessTicket a = 
+        mQueue->load("Queued", "a", "General", false, 0, 0, &listener);
+    processQueued();
+
+    // The error reaches the main thread, with the ticket answered
+    CPPUNIT_ASSERT_THROW(mQueue->_fireBackgroundLoadingComplete(), Exception);
+    CPPUNIT_ASSERT(mQueue->isProcessComplete(fail));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, listener.completedInThread.size());
+    CPPUNIT_ASSERT_EQUAL(fail, listener.completedInThread[0]);
+
+    // and the requests behind it carry on
+    CPPUNIT_ASSERT(!mQueue->isProcessComplete(a));
+    mQueue->_fireBackgroundLoadingComplete();
+    CPPUNIT_ASSERT(mQueue->isProcessComplete(a));
+    CPPUNIT_ASSERT(mManager->getByName("a")->isLoaded());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, listener.completed.size());
+    CPPUNIT_ASSERT_EQUAL(fail, listener.completed[0]);
+    CPPUNIT_ASSERT_EQUAL(a, listener.completed[1]);
+#endif
+}
@@ -0,0 +1,201 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ResourcePrepareTests.h"
+#include "OgreRoot.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMeshManager.h"
+#include "OgreMeshSerializer.h"
+#include "OgreSubMesh.h"
+#include <cstdio>
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ResourcePrepareTests );
+
+namespace
+{
+    /// Resource which records which of its stages ran
+    class CountingResource : public Resource
+    {
+    public:
+        size_t prepareCount;
+        size_t unprepareCount;
+        size_t loadCount;
+        bool loadedFromPrepared;
+
+        CountingResource()
+            : Resource(0, "CountingResource", 1, "General"),
+            prepareCount(0), unprepareCount(0), loadCount(0), 
+            loadedFromPrepared(false)
+        {
+        }
+    protected:
+        void prepareImpl(void) { ++prepareCount; }
+        void unprepareImpl(void) { ++unprepareCount; }
+        void loadImpl(void) { ++loadCount; loadedFromPrepared = isPrepared(); }
+        void unloadImpl(void) {}
+        size_t calculateSize(void) const { return 0; }
+    };
+
+    /// Buffer manager which counts the buffers created through it
+    class CountingBufferManager : public DefaultHardwareBufferManager
+    {
+    public:
+        size_t bufferCount;
+
+        CountingBufferManager() : bufferCount(0) {}
+
+        HardwareVertexBufferSharedPtr createVertexBuffer(size_t vertexSize,
+            size_t numVerts, HardwareBuffer::Usage usage, bool useShadowBuffer)
+        {
+            ++bufferCount;
+            return DefaultHardwareBufferManager::createVertexBuffer(
+                vertexSize, numVerts, usage, useShadowBuffer);
+        }
+        HardwareIndexBufferSharedPtr createIndexBuffer(
+            HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+            HardwareBuffer::Usage usage, bool useShadowBuffer)
+        {
+            ++bufferCount;
+            return DefaultHardwareBufferManager::createIndexBuffer(
+                itype, numIndexes, usage, useShadowBuffer);
+        }
+    };
+}
+
+void ResourcePrepareTests::testLoadUsesPreparedData()
+{
+    CountingResource res;
+    res.prepare();
+    CPPUNIT_ASSERT(res.isPrepared());
+    CPPUNIT_ASSERT(!res.isLoaded());
+
+    res.load();
+    CPPUNIT_ASSERT(res.isLoaded());
+    CPPUNIT_ASSERT(res.loadedFromPrepared);
+    // Prepared data is released once it has been used
+    CPPUNIT_ASSERT(!res.isPrepared());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, res.unprepareCount);
+}
+
+void ResourcePrepareTests::testLoadWithoutPrepare()
+{
+    CountingResource res;
+    res.load();
+    CPPUNIT_ASSERT(res.isLoaded());
+    CPPUNIT_ASSERT(!res.loadedFromPrepared);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, res.prepareCount);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, res.unprepareCount);
+}
+
+void ResourcePrepareTests::testPrepareOnlyOnce()
+{
+    CountingResource res;
+    res.prepare();
+    res.prepare();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, res.prepareCount);
+
+    // Nothing to prepare once loaded
+    res.load();
+    res.prepare();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, res.prepareCount);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, res.loadCount);
+}
+
+void ResourcePrepareTests::testUnloadDiscardsPreparedData()
+{
+    CountingResource res;
+    res.prepare();
+    res.unload();
+    CPPUNIT_ASSERT(!res.isPrepared());
+    CPPUNIT_ASSERT(!res.isLoaded());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, res.unprepareCount);
+
+    // Can be prepared again afterwards
+    res.prepare();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, res.prepareCount);
+}
+
+void ResourcePrepareTests::testMeshPrepareParsesFile()
+{
+    Root* root = new Root("", "", "");
+    CountingBufferManager* bufMgr = new CountingBufferManager();
+    {
+        // Write a mesh file to load back
+        MeshPtr plane = MeshManager::getSingleton().createPlane(
+            "ResourcePrepareTestsPlane", "General",
+            Plane(Vector3::UNIT_Z, 0), 100, 100, 4, 4);
+        MeshSerializer().exportMesh(plane.get(), "ResourcePrepareTests.mesh");
+        ResourceGroupManager::getSingleton().addResourceLocation(
+            ".", "FileSystem", "General");
+
+        MeshPtr mesh = MeshManager::getSingleton().create(
+            "ResourcePrepareTests.mesh", "General");
+        bufMgr->bufferCount = 0;
+        mesh->prepare();
+        // Parsed, but no buffers created through the render system
+        CPPUNIT_ASSERT(mesh->isPrepared());
+        CPPUNIT_ASSERT_EQUAL((unsigned short)1, mesh->getNumSubMeshes());
+        CPPUNIT_ASSERT_EQUAL((size_t)0, bufMgr->bufferCount);
+
+        mesh->load();
+        CPPUNIT_ASSERT(mesh->isLoaded());
+        // One vertex buffer and one index buffer
+        CPPUNIT_ASSERT_EQUAL((size_t)2, bufMgr->bufferCount);
+
+        // Same data as the original
+        VertexData* vdSrc = plane->sharedVertexData;
+        VertexData* vdDst = mesh->sharedVertexData;
+        CPPUNIT_ASSERT_EQUAL(vdSrc->vertexCount, vdDst->vertexCount);
+        HardwareVertexBufferSharedPtr vbSrc = vdSrc->vertexBufferBinding->getBuffer(0);
+        HardwareVertexBufferSharedPtr vbDst = vdDst->vertexBufferBinding->getBuffer(0);
+        CPPUNIT_ASSERT_EQUAL(vbSrc->getSizeInBytes(), vbDst->getSizeInBytes());
+        std::vector<unsigned char> src(vbSrc->getSizeInBytes());
+        std::vector<unsigned char> dst(vbDst->getSizeInBytes());
+        vbSrc->readData(0, src.size(), &src[0]);
+        vbDst->readData(0, dst.size(), &dst[0]);
+        CPPUNIT_ASSERT(src == dst);
+        IndexData* idDst = mesh->getSubMesh(0)->indexData;
+        CPPUNIT_ASSERT_EQUAL(plane->getSubMesh(0)->indexData->indexCount,
+            idDst->indexCount);
+
+        // Data parsed for a load that never happens is discarded
+        mesh->unload();
+        mesh->prepare();
+        CPPUNIT_ASSERT_EQUAL((unsigned short)1, mesh->getNumSubMeshes());
+        mesh->unload();
+        CPPUNIT_ASSERT(!mesh->isPrepared());
+        CPPUNIT_ASSERT_EQUAL((unsigned short)0, mesh->getNumSubMeshes());
+        CPPUNIT_ASSERT(mesh->sharedVertexData == 0);
+
+        MeshManager::getSingleton().removeAll();
+    }
+    std::remove("ResourcePrepareTests.mesh");
+    delete bufMgr;
+    delete root;
+}
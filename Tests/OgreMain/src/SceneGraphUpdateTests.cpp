@@ -0,0 +1,332 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "SceneGraphUpdateTests.h"
+#include "TestBoxObject.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreNodeTransformStore.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreStringConverter.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( SceneGraphUpdateTests );
+
+namespace
+{
+    /// Counts the nodes given new derived transforms
+    class UpdateCounter : public Node::Listener
+    {
+    public:
+        size_t count;
+        UpdateCounter() : count(0) {}
+        void nodeUpdated(const Node*) { ++count; }
+    };
+}
+
+void SceneGraphUpdateTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    mSerialSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+    mParallelSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+    mParallelSceneMgr->setParallelSceneGraphUpdate(true);
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(3);
+}
+void SceneGraphUpdateTests::tearDown()
+{
+    mRoot->destroySceneManager(mSerialSceneMgr);
+    mRoot->destroySceneManager(mParallelSceneMgr);
+    for (std::vector<MovableObject*>::iterator i = mObjects.begin(); i != mObjects.end(); ++i)
+        delete *i;
+    mObjects.clear();
+    delete mRoot;
+}
+
+void SceneGraphUpdateTests::buildScene(SceneManager* sm, std::vector<SceneNode*>& nodes)
+{
+    // Mixture of wide and deep branches, identical for both scene managers
+    srand(42);
+    nodes.push_back(sm->getRootSceneNode());
+    for (size_t i = 1; i < 2000; ++i)
+    {
+        SceneNode* parent = (i % 3) ? nodes[rand() % nodes.size()] : nodes.back();
+        SceneNode* node = parent->createChildSceneNode(
+            Vector3(rand() % 100, rand() % 100, rand() % 100),
+            Quaternion(Degree(rand() % 360), Vector3::UNIT_Y));
+        node->setScale(1 + (rand() % 3) * 0.5f, 1, 1);
+        node->setInheritScale((i % 7) != 0);
+        if (i % 2)
+        {
+            MovableObject* obj = new BoxObject(
+                sm->getName() + StringConverter::toString(i), 
+                AxisAlignedBox(-1, -2, -3, 1, 2, 3));
+            node->attachObject(obj);
+            mObjects.push_back(obj);
+        }
+        nodes.push_back(node);
+    }
+}
+
+void SceneGraphUpdateTests::reshapeScene(SceneManager* sm, 
+    std::vector<SceneNode*>& nodes, std::vector<size_t>& orphans, int frame)
+{
+    // Every decision depends on indices and the shape of the scene only, so 
+    // both scene managers are changed in the same way
+    SceneNode* root = sm->getRootSceneNode();
+    for (std::vector<size_t>::iterator o = orphans.begin(); o != orphans.end(); ++o)
+        root->addChild(nodes[*o]);
+    orphans.clear();
+
+    // Move branches under nodes which aren't in them
+    for (size_t i = 0; i < 5; ++i)
+    {
+        SceneNode* node = nodes[1 + (i * 401 + frame * 7) % (nodes.size() - 1)];
+        SceneNode* newParent = nodes[1 + (i * 613 + frame * 5) % (nodes.size() - 1)];
+        if (!node || !newParent || !node->getParent())
+            continue;
+        Node* n = newParent;
+        while (n && n != node)
+            n = n->getParent();
+        if (n)
+            continue;
+        SceneNode* oldParent = node->getParentSceneNode();
+        oldParent->removeChild(node);
+        oldParent->needUpdate();
+        newParent->addChild(node);
+    }
+
+    // Destroy nodes in the middle of the hierarchy, orphaning their children
+    for (size_t i = 0; i < 2; ++i)
+    {
+        size_t k = 1 + (i * 997 + frame * 13) % (nodes.size() - 1);
+        SceneNode* node = nodes[k];
+        if (!node || !node->getParent())
+            continue;
+        Node::ChildNodeIterator it = node->getChildIterator();
+        while (it.hasMoreElements())
+        {
+            Node* child = it.getNext();
+            orphans.push_back(
+                std::find(nodes.begin(), nodes.end(), child) - nodes.begin());
+        }
+        SceneNode* parent = node->getParentSceneNode();
+        sm->destroySceneNode(node->getName());
+        parent->needUpdate();
+        nodes[k] = 0;
+    }
+}
+
+void SceneGraphUpdateTests::compareUpdates(bool exact, ReshapeMode reshape)
+{
+    std::vector<SceneNode*> serialNodes, parallelNodes;
+    std::vector<size_t> serialOrphans, parallelOrphans;
+    buildScene(mSerialSceneMgr, serialNodes);
+    buildScene(mParallelSceneMgr, parallelNodes);
+
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        // Move a few nodes so that only parts of the graph are out of date
+        for (size_t i = 0; i < 50; ++i)
+        {
+            size_t n = 1 + (i * 37 + frame * 11) % (serialNodes.size() - 1);
+            if (!serialNodes[n])
+                continue;
+            serialNodes[n]->translate(Vector3(1, frame, 0));
+            parallelNodes[n]->translate(Vector3(1, frame, 0));
+        }
+        if (reshape == RM_TO_ROOT)
+        {
+            // Move a few branches directly under the root; the old parents
+            // aren't updated by removeChild, so their bounds must be forced
+            for (size_t i = 0; i < 5; ++i)
+            {
+                size_t n = 1 + (i * 401 + frame * 7) % (serialNodes.size() - 1);
+                SceneNode* oldParent = serialNodes[n]->getParentSceneNode();
+                oldParent->removeChild(serialNodes[n]);
+                oldParent->needUpdate();
+                mSerialSceneMgr->getRootSceneNode()->addChild(serialNodes[n]);
+                oldParent = parallelNodes[n]->getParentSceneNode();
+                oldParent->removeChild(parallelNodes[n]);
+                oldParent->needUpdate();
+                mParallelSceneMgr->getRootSceneNode()->addChild(parallelNodes[n]);
+            }
+        }
+        else if (reshape == RM_ANYWHERE)
+        {
+            reshapeScene(mSerialSceneMgr, serialNodes, serialOrphans, frame);
+            reshapeScene(mParallelSceneMgr, parallelNodes, parallelOrphans, frame);
+        }
+        mSerialSceneMgr->_updateSceneGraph(0);
+        mParallelSceneMgr->_updateSceneGraph(0);
+
+        for (size_t n = 0; n < serialNodes.size(); ++n)
+        {
+            const SceneNode* s = serialNodes[n];
+            const SceneNode* p = parallelNodes[n];
+            CPPUNIT_ASSERT((s == 0) == (p == 0));
+            if (!s)
+                continue;
+            if (exact)
+            {
+                CPPUNIT_ASSERT(s->_getDerivedPosition() == p->_getDerivedPosition());
+                CPPUNIT_ASSERT(s->_getDerivedOrientation() == p->_getDerivedOrientation());
+                CPPUNIT_ASSERT(s->_getDerivedScale() == p->_getDerivedScale());
+                CPPUNIT_ASSERT(s->_getWorldAABB() == p->_getWorldAABB());
+            }
+            else
+            {
+                CPPUNIT_ASSERT(s->_getDerivedPosition().positionEquals(p->_getDerivedPosition()));
+                // Quaternion::equals rejects orientations whose length has
+                // drifted down a deep chain, even if they are identical
+                const Quaternion& so = s->_getDerivedOrientation();
+                const Quaternion& po = p->_getDerivedOrientation();
+                CPPUNIT_ASSERT(Math::RealEqual(so.w, po.w, 1e-4f) && 
+                    Math::RealEqual(so.x, po.x, 1e-4f) && 
+                    Math::RealEqual(so.y, po.y, 1e-4f) && 
+                    Math::RealEqual(so.z, po.z, 1e-4f));
+                CPPUNIT_ASSERT(s->_getDerivedScale().positionEquals(p->_getDerivedScale()));
+                CPPUNIT_ASSERT(s->_getWorldAABB().isNull() == p->_getWorldAABB().isNull());
+                if (!s->_getWorldAABB().isNull())
+                {
+                    CPPUNIT_ASSERT(s->_getWorldAABB().getMinimum().positionEquals(
+                        p->_getWorldAABB().getMinimum()));
+                    CPPUNIT_ASSERT(s->_getWorldAABB().getMaximum().positionEquals(
+                        p->_getWorldAABB().getMaximum()));
+                }
+            }
+        }
+    }
+}
+
+void SceneGraphUpdateTests::testParallelUpdateMatchesSerial()
+{
+    mParallelSceneMgr->setParallelSceneGraphUpdateMaxSplitDepth(8);
+    compareUpdates(true, RM_NONE);
+}
+
+void SceneGraphUpdateTests::testParallelUpdateShallowSplit()
+{
+    mParallelSceneMgr->setParallelSceneGraphUpdateMaxSplitDepth(1);
+    compareUpdates(true, RM_NONE);
+}
+
+void SceneGraphUpdateTests::testTransformStoreMatchesSerial()
+{
+    mParallelSceneMgr->setParallelSceneGraphUpdate(false);
+    mParallelSceneMgr->setUseNodeTransformStore(true);
+    compareUpdates(false, RM_NONE);
+}
+
+void SceneGraphUpdateTests::testTransformStoreHierarchyChanges()
+{
+    mParallelSceneMgr->setParallelSceneGraphUpdate(false);
+    mParallelSceneMgr->setUseNodeTransformStore(true);
+    compareUpdates(false, RM_TO_ROOT);
+}
+
+void SceneGraphUpdateTests::testTransformStoreSubtreeChanges()
+{
+    mParallelSceneMgr->setParallelSceneGraphUpdate(false);
+    mParallelSceneMgr->setUseNodeTransformStore(true);
+    compareUpdates(false, RM_ANYWHERE);
+}
+
+void SceneGraphUpdateTests::testTransformStoreSparseUpdate()
+{
+    // Hierarchy of ten branches of ten nodes each, in chains, translated 
+    // only so the derived positions are easy to check
+    UpdateCounter counter;
+    SceneNode* root = mSerialSceneMgr->createSceneNode();
+    root->setListener(&counter);
+    std::vector<SceneNode*> nodes;
+    for (size_t b = 0; b < 10; ++b)
+    {
+        SceneNode* parent = root;
+        for (size_t n = 0; n < 10; ++n)
+        {
+            parent = parent->createChildSceneNode(Vector3(1, b, 0));
+            parent->setListener(&counter);
+            nodes.push_back(parent);
+        }
+    }
+    NodeTransformStore* store = new NodeTransformStore(root);
+    store->update();
+    CPPUNIT_ASSERT_EQUAL((size_t)101, store->getNumNodes());
+    CPPUNIT_ASSERT_EQUAL((size_t)101, counter.count);
+    CPPUNIT_ASSERT(nodes[99]->_getDerivedPosition() == Vector3(10, 90, 0));
+
+    // Only the subtree of a changed node is updated
+    counter.count = 0;
+    nodes[36]->translate(Vector3(0, 0, 1));
+    store->update();
+    CPPUNIT_ASSERT_EQUAL((size_t)4, counter.count);
+    CPPUNIT_ASSERT(nodes[39]->_getDerivedPosition() == Vector3(10, 30, 1));
+    counter.count = 0;
+    store->update();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, counter.count);
+
+    // Detaching a subtree takes it out of the store
+    nodes[54]->removeChild(nodes[55]);
+    store->update();
+    CPPUNIT_ASSERT_EQUAL((size_t)96, store->getNumNodes());
+    CPPUNIT_ASSERT(nodes[57]->_getTransformStore() == 0);
+
+    // Attaching it to another branch lays out and updates only that subtree
+    counter.count = 0;
+    nodes[12]->addChild(nodes[55]);
+    store->update();
+    CPPUNIT_ASSERT_EQUAL((size_t)101, store->getNumNodes());
+    CPPUNIT_ASSERT_EQUAL((size_t)5, counter.count);
+    CPPUNIT_ASSERT(nodes[59]->_getTransformStore() == store);
+    CPPUNIT_ASSERT(nodes[59]->_getDerivedPosition() == Vector3(8, 28, 0));
+
+    // Destroying a node in the middle of a branch drops it and its children
+    mSerialSceneMgr->destroySceneNode(nodes[73]->getName());
+    store->update();
+    CPPUNIT_ASSERT_EQUAL((size_t)94, store->getNumNodes());
+    CPPUNIT_ASSERT(nodes[74]->_getTransformStore() == 0);
+
+    // The layout stays consistent for later changes
+    counter.count = 0;
+    nodes[0]->translate(Vector3(0, 0, 2));
+    store->update();
+    CPPUNIT_ASSERT_EQUAL((size_t)10, counter.count);
+    CPPUNIT_ASSERT(nodes[9]->_getDerivedPosition() == Vector3(10, 0, 2));
+
+    delete store;
+    CPPUNIT_ASSERT(root->_getTransformStore() == 0);
+    CPPUNIT_ASSERT(nodes[9]->_getTransformStore() == 0);
+
+    // The nodes left outlive the listener
+    root->setListener(0);
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (i != 73)
+            nodes[i]->setListener(0);
+    }
+}
@@ -0,0 +1,334 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "SceneQueryBVHTests.h"
+#include "TestBoxObject.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "OgreSceneQueryBVH.h"
+#include "OgreStringConverter.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( SceneQueryBVHTests );
+
+namespace
+{
+    /// Passes on every result but those for one object
+    class ExcludingListener : public RaySceneQueryListener
+    {
+    public:
+        MovableObject* exclude;
+        RaySceneQueryListener* listener;
+
+        bool queryResult(MovableObject* obj, Real distance)
+        {
+            return obj == exclude || listener->queryResult(obj, distance);
+        }
+        bool queryResult(SceneQuery::WorldFragment* fragment, Real distance)
+        {
+            return listener->queryResult(fragment, distance);
+        }
+    };
+
+    /** Ray query which leaves out one object, the way the plugin queries
+        filter what the default query finds */
+    class ExcludingRaySceneQuery : public DefaultRaySceneQuery
+    {
+    protected:
+        ExcludingListener mFilter;
+    public:
+        ExcludingRaySceneQuery(SceneManager* creator, MovableObject* exclude)
+            : DefaultRaySceneQuery(creator)
+        {
+            mFilter.exclude = exclude;
+        }
+
+        void execute(RaySceneQueryListener* listener)
+        {
+            mFilter.listener = listener;
+            DefaultRaySceneQuery::execute(&mFilter);
+        }
+        void executeBatch(const RayList& rays, RaySceneQueryResultList& results)
+        {
+            RaySceneQuery::executeBatch(rays, results);
+        }
+    };
+
+    Real randomReal(Real range)
+    {
+        return range * rand() / RAND_MAX;
+    }
+}
+
+void SceneQueryBVHTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    mFactory = new BoxObjectFactory();
+    mRoot->addMovableObjectFactory(mFactory);
+    mSceneMgr = new DefaultSceneManager("SceneQueryBVH");
+}
+void SceneQueryBVHTests::tearDown()
+{
+    delete mSceneMgr;
+    mNodes.clear();
+    mRoot->removeMovableObjectFactory(mFactory);
+    delete mFactory;
+    delete mRoot;
+}
+
+void SceneQueryBVHTests::createObjects(size_t count)
+{
+    srand(11);
+    for (size_t i = 0; i < count; ++i)
+    {
+        String name = StringConverter::toString(i);
+        BoxObject* obj = static_cast<BoxObject*>(
+            mSceneMgr->createMovableObject(name, BoxObject::getTypeName()));
+        obj->setSize(1 + randomReal(10));
+        if (i % 4 == 0)
+            obj->setQueryFlags(2);
+        if (i % 97 == 0)
+            obj->setInfinite();
+
+        SceneNode* node = mSceneMgr->getRootSceneNode()->createChildSceneNode(name);
+        node->setPosition(randomReal(1000), randomReal(100), randomReal(1000));
+        if (i % 10 == 0)
+            node->setScale(3, 0.5, 1);
+        // Leave some objects out of the scene
+        if (i % 13 != 0)
+            node->attachObject(obj);
+        mNodes.push_back(node);
+    }
+    mSceneMgr->_updateSceneGraph(0);
+}
+
+void SceneQueryBVHTests::getResults(RaySceneQuery* query, ObjectList& results)
+{
+    results.clear();
+    RaySceneQueryResult& r = query->execute();
+    for (RaySceneQueryResult::iterator i = r.begin(); i != r.end(); ++i)
+        results.push_back(i->movable);
+    std::sort(results.begin(), results.end());
+}
+
+void SceneQueryBVHTests::getResults(RegionSceneQuery* query, ObjectList& results)
+{
+    results.clear();
+    SceneQueryResult& r = query->execute();
+    results.assign(r.movables.begin(), r.movables.end());
+    std::sort(results.begin(), results.end());
+}
+
+void SceneQueryBVHTests::checkQueries(size_t count)
+{
+    RaySceneQuery* rayQuery = mSceneMgr->createRayQuery(Ray());
+    SphereSceneQuery* sphereQuery = mSceneMgr->createSphereQuery(Sphere());
+    AxisAlignedBoxSceneQuery* boxQuery = mSceneMgr->createAABBQuery(AxisAlignedBox());
+
+    for (size_t q = 0; q < count; ++q)
+    {
+        uint32 mask = (q % 3 == 0) ? 1 : 0xFFFFFFFF;
+        Vector3 direction = (q % 7 == 0) ? Vector3::UNIT_X :
+            Vector3(randomReal(2) - 1, randomReal(2) - 1, randomReal(2) - 1);
+        Ray ray(Vector3(randomReal(1200) - 100, randomReal(200) - 50, randomReal(1200) - 100),
+            direction.normalisedCopy());
+        Sphere sphere(Vector3(randomReal(1000), randomReal(100), randomReal(1000)), 
+            randomReal(80));
+        Vector3 corner(randomReal(1000), randomReal(100), randomReal(1000));
+        AxisAlignedBox box(corner, 
+            corner + Vector3(randomReal(100), randomReal(100), randomReal(100)));
+
+        // Test every object the way the default queries do
+        ObjectList expectedRay, expectedSphere, expectedBox;
+        SceneManager::MovableObjectIterator it = 
+            mSceneMgr->getMovableObjectIterator(BoxObject::getTypeName());
+        while (it.hasMoreElements())
+        {
+            MovableObject* obj = it.getNext();
+            if (!(obj->getQueryFlags() & mask) || !obj->isInScene())
+                continue;
+            if (ray.intersects(obj->getWorldBoundingBox()).first)
+                expectedRay.push_back(obj);
+            if (sphere.intersects(Sphere(obj->getParentNode()->_getDerivedPosition(), 
+                obj->getBoundingRadius())))
+                expectedSphere.push_back(obj);
+            if (box.intersects(obj->getWorldBoundingBox()))
+                expectedBox.push_back(obj);
+        }
+        std::sort(expectedRay.begin(), expectedRay.end());
+        std::sort(expectedSphere.begin(), expectedSphere.end());
+        std::sort(expectedBox.begin(), expectedBox.end());
+
+        ObjectList actual;
+        rayQuery->setQueryMask(mask);
+        rayQuery->setRay(ray);
+        getResults(rayQuery, actual);
+        CPPUNIT_ASSERT(expectedRay == actual);
+
+        sphereQuery->setQueryMask(mask);
+        sphereQuery->setSphere(sphere);
+        getResults(sphereQuery, actual);
+        CPPUNIT_ASSERT(expectedSphere == actual);
+
+        boxQuery->setQueryMask(mask);
+        boxQuery->setBox(box);
+        getResults(boxQuery, actual);
+        CPPUNIT_ASSERT(expectedBox == actual);
+    }
+
+    mSceneMgr->destroyQuery(rayQuery);
+    mSceneMgr->destroyQuery(sphereQuery);
+    mSceneMgr->destroyQuery(boxQuery);
+}
+
+void SceneQueryBVHTests::testQueriesMatchScan()
+{
+    createObjects(1000);
+    checkQueries(100);
+    mSceneMgr->setUseSceneQueryBVH(true);
+    checkQueries(100);
+}
+
+void SceneQueryBVHTests::testFollowsSceneChanges()
+{
+    createObjects(1000);
+    mSceneMgr->setUseSceneQueryBVH(true);
+    SceneQueryBVH* bvh = mSceneMgr->_getSceneQueryBVH();
+    CPPUNIT_ASSERT_EQUAL((size_t)1000, bvh->getNumObjects());
+
+    // Objects moving a little stay within their leaves
+    for (size_t i = 0; i < mNodes.size(); ++i)
+        mNodes[i]->translate(0.01, 0, 0);
+    mSceneMgr->_updateSceneGraph(0);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, bvh->getNumReinsertions());
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        for (size_t i = 0; i < mNodes.size(); i += 3)
+            mNodes[i]->translate(randomReal(40) - 20, randomReal(4) - 2, randomReal(40) - 20);
+        mSceneMgr->_updateSceneGraph(0);
+    }
+    CPPUNIT_ASSERT(bvh->getNumReinsertions() > 0);
+    CPPUNIT_ASSERT(bvh->getHeight() < 32);
+    checkQueries(100);
+
+    // Attach, detach and destroy objects
+    for (size_t i = 0; i < mNodes.size(); i += 5)
+    {
+        String name = StringConverter::toString(i);
+        if (mNodes[i]->numAttachedObjects())
+            mNodes[i]->detachAllObjects();
+        else
+            mNodes[i]->attachObject(mSceneMgr->getMovableObject(name, BoxObject::getTypeName()));
+    }
+    for (size_t i = 1; i < mNodes.size(); i += 11)
+    {
+        mSceneMgr->destroyMovableObject(StringConverter::toString(i), BoxObject::getTypeName());
+    }
+    mSceneMgr->_updateSceneGraph(0);
+    CPPUNIT_ASSERT_EQUAL((size_t)909, bvh->getNumObjects());
+    checkQueries(100);
+
+    mSceneMgr->destroyAllMovableObjects();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, bvh->getNumObjects());
+}
+
+void SceneQueryBVHTests::testExecuteBatch()
+{
+    createObjects(1000);
+    RayList rays;
+    for (size_t r = 0; r < 300; ++r)
+    {
+        Vector3 direction(randomReal(2) - 1, randomReal(2) - 1, randomReal(2) - 1);
+        rays.push_back(Ray(
+            Vector3(randomReal(1200) - 100, randomReal(200) - 50, randomReal(1200) - 100),
+            direction.normalisedCopy()));
+    }
+
+    RaySceneQuery* query = mSceneMgr->createRayQuery(Ray());
+    query->setSortByDistance(true, 5);
+    query->setQueryMask(1);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        mSceneMgr->setUseSceneQueryBVH(pass == 1);
+
+        RaySceneQueryResultList results;
+        query->executeBatch(rays, results);
+        CPPUNIT_ASSERT_EQUAL(rays.size(), results.size());
+        CPPUNIT_ASSERT(query->getLastResults().empty());
+
+        for (size_t r = 0; r < rays.size(); ++r)
+        {
+            query->setRay(rays[r]);
+            RaySceneQueryResult& expected = query->execute();
+            CPPUNIT_ASSERT_EQUAL(expected.size(), results[r].size());
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                CPPUNIT_ASSERT_EQUAL(expected[i].distance, results[r][i].distance);
+            }
+        }
+    }
+
+    mSceneMgr->destroyQuery(query);
+}
+
+void SceneQueryBVHTests::testExecuteBatchDerived()
+{
+    createObjects(1000);
+    mSceneMgr->setUseSceneQueryBVH(true);
+
+    // Aim every ray at the excluded object, through the others
+    MovableObject* exclude = mNodes[1]->getAttachedObject(0);
+    const Vector3& target = mNodes[1]->_getDerivedPosition();
+    RayList rays;
+    for (size_t r = 0; r < 300; ++r)
+    {
+        Vector3 origin(randomReal(1200) - 100, randomReal(200) - 50, randomReal(1200) - 100);
+        rays.push_back(Ray(origin, (target - origin).normalisedCopy()));
+    }
+
+    ExcludingRaySceneQuery excluding(mSceneMgr, exclude);
+    RaySceneQuery& query = excluding;
+    query.setSortByDistance(true);
+
+    RaySceneQueryResultList results;
+    query.executeBatch(rays, results);
+    CPPUNIT_ASSERT_EQUAL(rays.size(), results.size());
+
+    for (size_t r = 0; r < rays.size(); ++r)
+    {
+        query.setRay(rays[r]);
+        RaySceneQueryResult& expected = query.execute();
+        CPPUNIT_ASSERT_EQUAL(expected.size(), results[r].size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            CPPUNIT_ASSERT(results[r][i].movable != exclude);
+            CPPUNIT_ASSERT_EQUAL(expected[i].movable, results[r][i].movable);
+        }
+    }
+}
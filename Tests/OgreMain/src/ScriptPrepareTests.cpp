@@ -0,0 +1,180 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ScriptPrepareTests.h"
+#include "OgreMaterialManager.h"
+#include "OgreStringConverter.h"
+#include "OgreWorkerThreadPool.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ScriptPrepareTests );
+
+namespace
+{
+    void dumpNodes(const ConcreteNodeList& nodes, StringUtil::StrStreamType& str)
+    {
+        for (ConcreteNodeList::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+        {
+            str << (*i)->file << ":" << (*i)->line << " " << (*i)->type << " " << (*i)->token;
+            if (!(*i)->children.empty())
+            {
+                str << " {";
+                dumpNodes((*i)->children, str);
+                str << "}";
+            }
+            str << "\n";
+        }
+    }
+}
+
+void ScriptPrepareTests::DumpingListener::preConversion(ScriptCompiler* compiler, 
+    ConcreteNodeListPtr nodes)
+{
+    StringUtil::StrStreamType str;
+    dumpNodes(*nodes, str);
+    dumps->push_back(str.str());
+}
+
+void ScriptPrepareTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(3);
+    ScriptCompilerManager::getSingleton().setListener(&mListener);
+}
+void ScriptPrepareTests::tearDown()
+{
+    mStreams.clear();
+    mScripts.clear();
+    ScriptCompilerManager::getSingleton().setListener(0);
+    delete mRoot;
+}
+
+void ScriptPrepareTests::createScripts(size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        StringUtil::StrStreamType str;
+        String name = "Prepared" + StringConverter::toString(i);
+        str << "set $colour \"0." << i % 10 << " 0.5 0.5\"\n"
+            << "material " << name << "\n{\n";
+        // Scripts of very different sizes finish parsing out of order
+        for (size_t t = 0; t < 1 + (i * 7) % 5; ++t)
+        {
+            str << "    technique\n    {\n"
+                << "        pass\n        {\n"
+                << "            ambient $colour\n"
+                << "            diffuse 0." << t << " 1 1\n"
+                << "            texture_unit { texture \"" << name << ".png\" }\n"
+                << "        }\n    }\n";
+        }
+        str << "}\n";
+        mScripts.push_back(str.str());
+    }
+}
+
+void ScriptPrepareTests::openScripts(bool prepare)
+{
+    mStreams.clear();
+    for (size_t i = 0; i < mScripts.size(); ++i)
+    {
+        mStreams.push_back(DataStreamPtr(new MemoryDataStream(
+            "Prepared" + StringConverter::toString(i) + ".material",
+            &mScripts[i][0], mScripts[i].size())));
+    }
+    if (prepare)
+        ScriptCompilerManager::getSingleton().prepareScripts(mStreams, 
+            ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+}
+
+void ScriptPrepareTests::compileScripts(StringVector& dumps)
+{
+    dumps.clear();
+    mListener.dumps = &dumps;
+    for (DataStreamList::iterator i = mStreams.begin(); i != mStreams.end(); ++i)
+    {
+        ScriptCompilerManager::getSingleton().parseScript(*i, 
+            ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    }
+    // Let the next parse create the same materials
+    MaterialManager::getSingleton().removeAll();
+}
+
+void ScriptPrepareTests::testMatchesSerialParse()
+{
+    createScripts(40);
+
+    StringVector serialDumps, parallelDumps;
+    openScripts(false);
+    compileScripts(serialDumps);
+    openScripts(true);
+    compileScripts(parallelDumps);
+
+    CPPUNIT_ASSERT_EQUAL(mScripts.size(), serialDumps.size());
+    CPPUNIT_ASSERT(serialDumps == parallelDumps);
+}
+
+void ScriptPrepareTests::testPreparedTreesUsed()
+{
+    createScripts(8);
+
+    StringVector serialDumps, preparedDumps;
+    openScripts(false);
+    compileScripts(serialDumps);
+
+    // Change the text after preparing; the trees parsed up front are used
+    openScripts(true);
+    for (size_t i = 0; i < mScripts.size(); ++i)
+        std::fill(mScripts[i].begin(), mScripts[i].end(), ' ');
+    compileScripts(preparedDumps);
+
+    CPPUNIT_ASSERT(serialDumps == preparedDumps);
+}
+
+void ScriptPrepareTests::testUnprepareReleasesStreams()
+{
+    createScripts(8);
+    openScripts(true);
+    // The prepared scripts hold on to their streams until parsed
+    for (DataStreamList::iterator i = mStreams.begin(); i != mStreams.end(); ++i)
+        CPPUNIT_ASSERT_EQUAL(2u, i->useCount());
+
+    // As if parsing failed after the first three scripts
+    StringVector dumps;
+    mListener.dumps = &dumps;
+    DataStreamList::iterator i = mStreams.begin();
+    for (size_t n = 0; n < 3; ++n, ++i)
+    {
+        ScriptCompilerManager::getSingleton().parseScript(*i, 
+            ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        i->setNull();
+    }
+    ScriptCompilerManager::getSingleton().unprepareScripts(mStreams);
+    for (; i != mStreams.end(); ++i)
+        CPPUNIT_ASSERT_EQUAL(1u, i->useCount());
+    MaterialManager::getSingleton().removeAll();
+}
@@ -0,0 +1,204 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "ScriptSerializerTests.h"
+#include <cstdio>
+#include <fstream>
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ScriptSerializerTests );
+
+void ScriptSerializerTests::setUp()
+{
+    mCacheFile = "ScriptSerializerTests.ast";
+
+    mIds["material"] = ID_MATERIAL;
+    mIds["lighting"] = ID_LIGHTING;
+    mIds["off"] = ScriptCompiler::ID_OFF;
+
+    // import * from "base.material"
+    // set $colour "1 0 0"
+    // abstract material Base { set $shininess 10 lighting off }
+    // material Test : Base { ambient $colour }
+    mNodes.bind(new AbstractNodeList());
+
+    ImportAbstractNode* import = new ImportAbstractNode();
+    import->file = "test.material";
+    import->line = 1;
+    import->target = "*";
+    import->source = "base.material";
+    mNodes->push_back(AbstractNodePtr(import));
+
+    mVariables["$colour"] = "1 0 0";
+
+    ObjectAbstractNode* base = new ObjectAbstractNode(0);
+    base->file = "test.material";
+    base->line = 3;
+    base->cls = "material";
+    base->name = "Base";
+    base->abstract = true;
+    base->setVariable("$shininess", "10");
+    PropertyAbstractNode* lighting = new PropertyAbstractNode(base);
+    lighting->file = "test.material";
+    lighting->line = 4;
+    lighting->name = "lighting";
+    AtomAbstractNode* off = new AtomAbstractNode(lighting);
+    off->file = "test.material";
+    off->line = 4;
+    off->value = "off";
+    lighting->values.push_back(AbstractNodePtr(off));
+    base->children.push_back(AbstractNodePtr(lighting));
+    mNodes->push_back(AbstractNodePtr(base));
+
+    ObjectAbstractNode* test = new ObjectAbstractNode(0);
+    test->file = "test.material";
+    test->line = 6;
+    test->cls = "material";
+    test->name = "Test";
+    test->base = "Base";
+    PropertyAbstractNode* ambient = new PropertyAbstractNode(test);
+    ambient->file = "test.material";
+    ambient->line = 7;
+    ambient->name = "ambient";
+    VariableAccessAbstractNode* colour = new VariableAccessAbstractNode(ambient);
+    colour->file = "test.material";
+    colour->line = 7;
+    colour->name = "$colour";
+    ambient->values.push_back(AbstractNodePtr(colour));
+    test->children.push_back(AbstractNodePtr(ambient));
+    mNodes->push_back(AbstractNodePtr(test));
+
+    ScriptSerializer serializer;
+    serializer.exportAST(mNodes, mVariables, "test.material", 1234567, mCacheFile);
+}
+
+void ScriptSerializerTests::tearDown()
+{
+    mNodes.setNull();
+    mIds.clear();
+    mVariables.clear();
+    remove(mCacheFile.c_str());
+}
+
+DataStreamPtr ScriptSerializerTests::openCache(void)
+{
+    std::ifstream* s = new std::ifstream(mCacheFile.c_str(), std::ios::in | std::ios::binary);
+    return DataStreamPtr(new FileStreamDataStream(mCacheFile, s, true));
+}
+
+void ScriptSerializerTests::testRoundTrip()
+{
+    ScriptSerializer serializer;
+    ScriptSerializer::VariableMap variables;
+    DataStreamPtr stream = openCache();
+    AbstractNodeListPtr nodes = serializer.importAST(stream, "test.material", 1234567,
+        mIds, variables);
+
+    CPPUNIT_ASSERT(!nodes.isNull());
+    CPPUNIT_ASSERT(variables == mVariables);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, nodes->size());
+
+    AbstractNodeList::iterator i = nodes->begin();
+    CPPUNIT_ASSERT_EQUAL(ANT_IMPORT, (*i)->type);
+    ImportAbstractNode* import = static_cast<ImportAbstractNode*>((*i).get());
+    CPPUNIT_ASSERT_EQUAL(String("*"), import->target);
+    CPPUNIT_ASSERT_EQUAL(String("base.material"), import->source);
+    CPPUNIT_ASSERT_EQUAL(String("test.material"), import->file);
+    CPPUNIT_ASSERT_EQUAL(1u, import->line);
+
+    ++i;
+    CPPUNIT_ASSERT_EQUAL(ANT_OBJECT, (*i)->type);
+    ObjectAbstractNode* base = static_cast<ObjectAbstractNode*>((*i).get());
+    CPPUNIT_ASSERT(base->parent == 0);
+    CPPUNIT_ASSERT_EQUAL(String("Base"), base->name);
+    CPPUNIT_ASSERT(base->abstract);
+    CPPUNIT_ASSERT_EQUAL((uint32)ID_MATERIAL, base->id);
+    CPPUNIT_ASSERT_EQUAL(String("10"), base->getVariable("$shininess").second);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, base->children.size());
+    PropertyAbstractNode* lighting = 
+        static_cast<PropertyAbstractNode*>(base->children.front().get());
+    CPPUNIT_ASSERT_EQUAL(ANT_PROPERTY, lighting->type);
+    CPPUNIT_ASSERT(lighting->parent == base);
+    CPPUNIT_ASSERT_EQUAL((uint32)ID_LIGHTING, lighting->id);
+    CPPUNIT_ASSERT_EQUAL(4u, lighting->line);
+    AtomAbstractNode* off = static_cast<AtomAbstractNode*>(lighting->values.front().get());
+    CPPUNIT_ASSERT_EQUAL(ANT_ATOM, off->type);
+    CPPUNIT_ASSERT(off->parent == lighting);
+    CPPUNIT_ASSERT_EQUAL(String("off"), off->value);
+    CPPUNIT_ASSERT_EQUAL((uint32)ScriptCompiler::ID_OFF, off->id);
+
+    ++i;
+    ObjectAbstractNode* test = static_cast<ObjectAbstractNode*>((*i).get());
+    CPPUNIT_ASSERT_EQUAL(String("Test"), test->name);
+    CPPUNIT_ASSERT_EQUAL(String("Base"), test->base);
+    CPPUNIT_ASSERT(!test->abstract);
+    PropertyAbstractNode* ambient = 
+        static_cast<PropertyAbstractNode*>(test->children.front().get());
+    // Words which are not keywords get no id
+    CPPUNIT_ASSERT_EQUAL((uint32)0, ambient->id);
+    CPPUNIT_ASSERT_EQUAL(ANT_VARIABLE_ACCESS, ambient->values.front()->type);
+    CPPUNIT_ASSERT_EQUAL(String("$colour"), ambient->values.front()->getValue());
+}
+
+void ScriptSerializerTests::testStaleCacheIgnored()
+{
+    ScriptSerializer serializer;
+    ScriptSerializer::VariableMap variables;
+
+    // Script modified since the cache was written
+    DataStreamPtr stream = openCache();
+    CPPUNIT_ASSERT(serializer.importAST(stream, "test.material", 1234568,
+        mIds, variables).isNull());
+
+    // Cache written for another script
+    stream = openCache();
+    CPPUNIT_ASSERT(serializer.importAST(stream, "other.material", 1234567,
+        mIds, variables).isNull());
+    CPPUNIT_ASSERT(variables.empty());
+
+    // The header check alone agrees
+    stream = openCache();
+    CPPUNIT_ASSERT(serializer.isCurrent(stream, "test.material", 1234567));
+    stream = openCache();
+    CPPUNIT_ASSERT(!serializer.isCurrent(stream, "test.material", 1234568));
+}
+
+void ScriptSerializerTests::testTruncatedCacheIgnored()
+{
+    // Keep only the first half of the cache
+    DataStreamPtr stream = openCache();
+    MemoryDataStream contents(stream);
+    MemoryDataStream* truncated = new MemoryDataStream(contents.getPtr(), contents.size() / 2);
+    DataStreamPtr truncatedStream(truncated);
+
+    ScriptSerializer serializer;
+    ScriptSerializer::VariableMap variables;
+    CPPUNIT_ASSERT(serializer.importAST(truncatedStream, "test.material", 1234567,
+        mIds, variables).isNull());
+    CPPUNIT_ASSERT(variables.empty());
+}
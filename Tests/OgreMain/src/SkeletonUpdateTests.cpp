@@ -0,0 +1,268 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "SkeletonUpdateTests.h"
+#include "OgreBone.h"
+#include "OgreMatrix4.h"
+#include "OgreOptimisedUtil.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( SkeletonUpdateTests );
+
+namespace
+{
+    /// Skeleton which can be used without a SkeletonManager
+    class TestSkeleton : public Skeleton
+    {
+    public:
+        TestSkeleton(const String& name) : Skeleton(0, name, 0, "General") {}
+        ~TestSkeleton() { unloadImpl(); }
+    };
+
+    Quaternion randomOrientation(void)
+    {
+        Vector3 axis(Math::SymmetricRandom(), Math::SymmetricRandom(), Math::SymmetricRandom());
+        axis.normalise();
+        return Quaternion(Radian(Math::RangeRandom(0, Math::TWO_PI)), axis);
+    }
+
+    Vector3 randomVector(Real low, Real high)
+    {
+        return Vector3(Math::RangeRandom(low, high), Math::RangeRandom(low, high),
+            Math::RangeRandom(low, high));
+    }
+
+    bool orientationsEqual(const Quaternion& a, const Quaternion& b, Real tolerance)
+    {
+        // Not Quaternion::equals, whose acos is too steep for this near zero
+        return Math::RealEqual(a.w, b.w, tolerance) && Math::RealEqual(a.x, b.x, tolerance) &&
+            Math::RealEqual(a.y, b.y, tolerance) && Math::RealEqual(a.z, b.z, tolerance);
+    }
+
+    bool matricesEqual(const Matrix4& a, const Matrix4& b, Real tolerance)
+    {
+        for (size_t r = 0; r < 4; ++r)
+        {
+            for (size_t c = 0; c < 4; ++c)
+            {
+                if (!Math::RealEqual(a[r][c], b[r][c], tolerance))
+                    return false;
+            }
+        }
+        return true;
+    }
+}
+
+void SkeletonUpdateTests::setUp()
+{
+    srand(11);
+    mSkeleton = new TestSkeleton("Test");
+    mReference = new TestSkeleton("Reference");
+}
+void SkeletonUpdateTests::tearDown()
+{
+    delete mSkeleton;
+    delete mReference;
+}
+
+void SkeletonUpdateTests::createBones(size_t numBones)
+{
+    Skeleton* skeletons[2] = { mSkeleton, mReference };
+    for (size_t s = 0; s < 2; ++s)
+    {
+        for (ushort handle = 0; handle < numBones; ++handle)
+        {
+            Bone* bone = skeletons[s]->createBone(handle);
+            bone->setInheritOrientation(handle % 7 != 3);
+            bone->setInheritScale(handle % 11 != 5);
+        }
+    }
+
+    // Link the bones in a random order, so parents do not always have the
+    // lower handle, and leave a few roots
+    std::vector<ushort> order;
+    for (ushort handle = 0; handle < numBones; ++handle)
+        order.push_back(handle);
+    std::random_shuffle(order.begin(), order.end());
+    for (size_t i = 1; i < numBones; ++i)
+    {
+        if (i % 13 == 0)
+            continue;
+        ushort parent = order[rand() % i];
+        for (size_t s = 0; s < 2; ++s)
+            skeletons[s]->getBone(parent)->addChild(skeletons[s]->getBone(order[i]));
+    }
+
+    animateBones();
+    mSkeleton->setBindingPose();
+    mReference->setBindingPose();
+}
+
+void SkeletonUpdateTests::animateBones(void)
+{
+    for (ushort handle = 0; handle < mSkeleton->getNumBones(); ++handle)
+    {
+        Quaternion orientation = randomOrientation();
+        Vector3 position = randomVector(-5, 5);
+        Vector3 scale = randomVector(0.5f, 1.5f);
+        Bone* bones[2] = { mSkeleton->getBone(handle), mReference->getBone(handle) };
+        for (size_t s = 0; s < 2; ++s)
+        {
+            bones[s]->setOrientation(orientation);
+            bones[s]->setPosition(position);
+            bones[s]->setScale(scale);
+        }
+    }
+}
+
+void SkeletonUpdateTests::checkMatchesReference(void)
+{
+    const ushort numBones = mSkeleton->getNumBones();
+    std::vector<Matrix4> matrices(numBones);
+    mSkeleton->_getBoneMatrices(&matrices[0]);
+
+    // Update the reference the way Node does, from the roots down
+    for (ushort handle = 0; handle < numBones; ++handle)
+    {
+        Bone* bone = mReference->getBone(handle);
+        if (!bone->getParent())
+            bone->_update(true, false);
+    }
+
+    for (ushort handle = 0; handle < numBones; ++handle)
+    {
+        Bone* bone = mSkeleton->getBone(handle);
+        Bone* reference = mReference->getBone(handle);
+        CPPUNIT_ASSERT(bone->_getDerivedPosition().positionEquals(
+            reference->_getDerivedPosition(), 1e-3));
+        CPPUNIT_ASSERT(orientationsEqual(bone->_getDerivedOrientation(),
+            reference->_getDerivedOrientation(), 1e-4));
+        CPPUNIT_ASSERT(bone->_getDerivedScale().positionEquals(
+            reference->_getDerivedScale(), 1e-4));
+
+        Matrix4 expected;
+        reference->_getOffsetTransform(expected);
+        CPPUNIT_ASSERT(matricesEqual(matrices[handle], expected, 1e-2));
+    }
+}
+
+void SkeletonUpdateTests::testMatchesNodeUpdate()
+{
+    createBones(60);
+    for (size_t frame = 0; frame < 5; ++frame)
+    {
+        animateBones();
+        checkMatchesReference();
+    }
+
+    // Moving only a few bones must still move their descendants
+    mSkeleton->getBone(0)->translate(Vector3(1, 2, 3));
+    mReference->getBone(0)->translate(Vector3(1, 2, 3));
+    mSkeleton->getBone(17)->roll(Degree(40));
+    mReference->getBone(17)->roll(Degree(40));
+    checkMatchesReference();
+}
+
+void SkeletonUpdateTests::testHierarchyChanges()
+{
+    createBones(30);
+    checkMatchesReference();
+
+    Skeleton* skeletons[2] = { mSkeleton, mReference };
+    Bone* extras[2];
+    for (size_t s = 0; s < 2; ++s)
+    {
+        // Move a bone under a root, which cannot be one of its descendants
+        Bone* root = skeletons[s]->getRootBone();
+        Bone* moved = skeletons[s]->getBone(1);
+        if (!moved->getParent())
+            moved = skeletons[s]->getBone(2);
+        moved->getParent()->removeChild(moved);
+        root->addChild(moved);
+
+        // Add a bone
+        skeletons[s]->getBone(4)->createChild(30, Vector3(1, 0, 0));
+
+        // And a child which is not one of the skeleton's bones, as a 
+        // TagPoint would be
+        extras[s] = new Bone(0, skeletons[s]);
+        extras[s]->setPosition(Vector3(0, 3, 0));
+        skeletons[s]->getBone(5)->addChild(extras[s]);
+    }
+    animateBones();
+    mSkeleton->setBindingPose();
+    mReference->setBindingPose();
+    animateBones();
+    checkMatchesReference();
+
+    CPPUNIT_ASSERT(extras[0]->_getDerivedPosition().positionEquals(
+        extras[1]->_getDerivedPosition(), 1e-3));
+    CPPUNIT_ASSERT(extras[0]->_getDerivedPosition().positionEquals(
+        mSkeleton->getBone(5)->_getFullTransform() * Vector3(0, 3, 0), 1e-3));
+
+    delete extras[0];
+    delete extras[1];
+}
+
+void SkeletonUpdateTests::testOffsetMatrices()
+{
+    // Cover every number of bones left over by the SIMD version
+    for (size_t numBones = 0; numBones < 10; ++numBones)
+    {
+        std::vector<Quaternion> orientations(10), bindOrientations(10);
+        std::vector<Vector3> positions(10), scales(10), bindPositions(10), bindScales(10);
+        for (size_t i = 0; i < 10; ++i)
+        {
+            orientations[i] = randomOrientation();
+            bindOrientations[i] = randomOrientation();
+            positions[i] = randomVector(-10, 10);
+            bindPositions[i] = randomVector(-10, 10);
+            scales[i] = randomVector(0.5f, 2);
+            bindScales[i] = randomVector(0.5f, 2);
+        }
+
+        // One more than asked for, which must be left alone
+        std::vector<Matrix4> matrices(10, Matrix4::ZERO);
+        OptimisedUtil::getImplementation()->calculateBoneOffsetMatrices(
+            &orientations[0], &positions[0], &scales[0],
+            &bindOrientations[0], &bindPositions[0], &bindScales[0],
+            &matrices[0], numBones);
+
+        for (size_t i = 0; i < numBones; ++i)
+        {
+            // As Bone::_getOffsetTransform
+            Vector3 scale = scales[i] * bindScales[i];
+            Quaternion rotate = orientations[i] * bindOrientations[i];
+            Vector3 translate = positions[i] + rotate * (scale * bindPositions[i]);
+            Matrix4 expected;
+            expected.makeTransform(translate, scale, rotate);
+            CPPUNIT_ASSERT(matricesEqual(matrices[i], expected, 1e-3));
+        }
+        CPPUNIT_ASSERT(matrices[numBones] == Matrix4::ZERO);
+    }
+}
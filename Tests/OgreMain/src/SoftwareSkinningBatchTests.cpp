@@ -0,0 +1,202 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "SoftwareSkinningBatchTests.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreSoftwareSkinningBatch.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreAlignedAllocator.h"
+#include "OgreMath.h"
+#include "OgreMatrix4.h"
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( SoftwareSkinningBatchTests );
+
+namespace
+{
+    /// Enough vertices to be split across several tasks
+    const size_t NUM_VERTICES = SoftwareSkinningBatch::PARALLEL_SKINNING_MIN_VERTICES * 3 + 7;
+}
+
+void SoftwareSkinningBatchTests::setUp()
+{
+    mBufMgr = new DefaultHardwareBufferManager();
+    mPool = WorkerThreadPool::getSingletonPtr() ? 0 : new WorkerThreadPool();
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(3);
+
+    mMatrices = static_cast<Matrix4*>(AlignedMemory::allocate(sizeof(Matrix4) * 3));
+    mMatrices[0] = Matrix4::IDENTITY;
+    mMatrices[1].makeTransform(Vector3(10, 0, -5), Vector3::UNIT_SCALE, 
+        Quaternion(Degree(30), Vector3::UNIT_Y));
+    mMatrices[2].makeTransform(Vector3(0, 3, 0), Vector3(1, 2, 1), 
+        Quaternion(Degree(-45), Vector3::UNIT_X));
+    for (size_t i = 0; i < 3; ++i)
+        mBlendMatrices[i] = &mMatrices[i];
+
+    // Positions and normals in one buffer, blend data in another
+    mSource = new VertexData();
+    mSource->vertexCount = NUM_VERTICES;
+    VertexDeclaration* decl = mSource->vertexDeclaration;
+    decl->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    decl->addElement(0, 12, VET_FLOAT3, VES_NORMAL);
+    decl->addElement(1, 0, VET_UBYTE4, VES_BLEND_INDICES);
+    decl->addElement(1, 4, VET_FLOAT2, VES_BLEND_WEIGHTS);
+    HardwareVertexBufferSharedPtr posBuf = mBufMgr->createVertexBuffer(
+        24, NUM_VERTICES, HardwareBuffer::HBU_STATIC_WRITE_ONLY, true);
+    HardwareVertexBufferSharedPtr blendBuf = mBufMgr->createVertexBuffer(
+        12, NUM_VERTICES, HardwareBuffer::HBU_STATIC_WRITE_ONLY, true);
+    mSource->vertexBufferBinding->setBinding(0, posBuf);
+    mSource->vertexBufferBinding->setBinding(1, blendBuf);
+
+    float* pPos = static_cast<float*>(posBuf->lock(HardwareBuffer::HBL_DISCARD));
+    unsigned char* pBlend = static_cast<unsigned char*>(blendBuf->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t v = 0; v < NUM_VERTICES; ++v)
+    {
+        for (size_t c = 0; c < 6; ++c)
+            *pPos++ = Math::RangeRandom(-10, 10);
+        pBlend[0] = static_cast<unsigned char>(v % 3);
+        pBlend[1] = static_cast<unsigned char>((v + 1) % 3);
+        pBlend[2] = pBlend[3] = 0;
+        float* pWeight = reinterpret_cast<float*>(pBlend + 4);
+        pWeight[0] = Math::UnitRandom();
+        pWeight[1] = 1.0f - pWeight[0];
+        pBlend += 12;
+    }
+    posBuf->unlock();
+    blendBuf->unlock();
+}
+void SoftwareSkinningBatchTests::tearDown()
+{
+    delete mSource;
+    AlignedMemory::deallocate(mMatrices);
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(0);
+    delete mPool;
+    delete mBufMgr;
+}
+
+VertexData* SoftwareSkinningBatchTests::createTarget(void)
+{
+    VertexData* target = new VertexData();
+    target->vertexCount = NUM_VERTICES;
+    target->vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    target->vertexDeclaration->addElement(0, 12, VET_FLOAT3, VES_NORMAL);
+    target->vertexBufferBinding->setBinding(0, mBufMgr->createVertexBuffer(
+        24, NUM_VERTICES, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE, true));
+    return target;
+}
+
+void SoftwareSkinningBatchTests::referenceSkinning(std::vector<float>& result)
+{
+    result.resize(NUM_VERTICES * 6);
+    HardwareVertexBufferSharedPtr posBuf = mSource->vertexBufferBinding->getBuffer(0);
+    HardwareVertexBufferSharedPtr blendBuf = mSource->vertexBufferBinding->getBuffer(1);
+    const float* pPos = static_cast<const float*>(posBuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    const unsigned char* pBlend = 
+        static_cast<const unsigned char*>(blendBuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    OptimisedUtil::getImplementation()->softwareVertexSkinning(
+        pPos, &result[0], pPos + 3, &result[3],
+        reinterpret_cast<const float*>(pBlend + 4), pBlend, mBlendMatrices,
+        24, 24, 24, 24, 12, 12, 2, NUM_VERTICES);
+    posBuf->unlock();
+    blendBuf->unlock();
+}
+
+void SoftwareSkinningBatchTests::checkTarget(VertexData* target, 
+    const std::vector<float>& reference)
+{
+    HardwareVertexBufferSharedPtr buf = target->vertexBufferBinding->getBuffer(0);
+    CPPUNIT_ASSERT(!buf->isLocked());
+    const float* pData = static_cast<const float*>(buf->lock(HardwareBuffer::HBL_READ_ONLY));
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        CPPUNIT_ASSERT_EQUAL(reference[i], pData[i]);
+    }
+    buf->unlock();
+}
+
+void SoftwareSkinningBatchTests::testMatchesSerialSkinning()
+{
+    std::vector<float> reference;
+    referenceSkinning(reference);
+
+    VertexData* target = createTarget();
+    SoftwareSkinningBatch batch;
+    batch.addBlend(mSource, target, mBlendMatrices, 3, true);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, batch.getNumBlends());
+    CPPUNIT_ASSERT_EQUAL(NUM_VERTICES, batch.getNumVertices());
+    batch.execute();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, batch.getNumBlends());
+    CPPUNIT_ASSERT(!mSource->vertexBufferBinding->getBuffer(0)->isLocked());
+    CPPUNIT_ASSERT(!mSource->vertexBufferBinding->getBuffer(1)->isLocked());
+
+    checkTarget(target, reference);
+    delete target;
+}
+
+void SoftwareSkinningBatchTests::testSharedSourceBuffers()
+{
+    // Several entities sharing a mesh blend from the same source buffers
+    std::vector<float> reference;
+    referenceSkinning(reference);
+
+    std::vector<VertexData*> targets;
+    SoftwareSkinningBatch batch;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        targets.push_back(createTarget());
+        batch.addBlend(mSource, targets.back(), mBlendMatrices, 3, true);
+    }
+    batch.execute();
+
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        checkTarget(targets[i], reference);
+        delete targets[i];
+    }
+}
+
+void SoftwareSkinningBatchTests::testClear()
+{
+    VertexData* target = createTarget();
+    HardwareVertexBufferSharedPtr buf = target->vertexBufferBinding->getBuffer(0);
+    float* pData = static_cast<float*>(buf->lock(HardwareBuffer::HBL_DISCARD));
+    std::fill(pData, pData + NUM_VERTICES * 6, 0.0f);
+    buf->unlock();
+
+    SoftwareSkinningBatch batch;
+    batch.addBlend(mSource, target, mBlendMatrices, 3, true);
+    batch.clear();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, batch.getNumBlends());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, batch.getNumVertices());
+    // Nothing left to execute
+    batch.execute();
+
+    std::vector<float> zeros(NUM_VERTICES * 6, 0.0f);
+    checkTarget(target, zeros);
+    delete target;
+}
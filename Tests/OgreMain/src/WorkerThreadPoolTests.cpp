@@ -0,0 +1,143 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2006 Torus Knot Software Ltd
+Also see acknowledgements in Readme.html
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with
+this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+http://www.gnu.org/copyleft/lesser.txt.
+
+You may alternatively use this source under the terms of a specific version of
+the OGRE Unrestricted License provided you have obtained such a license from
+Torus Knot Software Ltd.
+-----------------------------------------------------------------------------
+*/
+#include "WorkerThreadPoolTests.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreException.h"
+#include <stdexcept>
+
+// Regsiter the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( WorkerThreadPoolTests );
+
+namespace
+{
+    /// Task which throws something chosen by kind, or counts its execution
+    class ThrowingTask : public WorkerThreadPool::Task
+    {
+    public:
+        int kind;
+        bool executed;
+        ThrowingTask(int k) : kind(k), executed(false) {}
+        void execute(void)
+        {
+            executed = true;
+            switch (kind)
+            {
+            case 1:
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Test", "ThrowingTask::execute");
+            case 2:
+                throw std::runtime_error("Test");
+            case 3:
+                throw std::bad_alloc();
+            case 4:
+                throw 42;
+            default:
+                break;
+            }
+        }
+    };
+}
+
+void WorkerThreadPoolTests::setUp()
+{
+    mRoot = new Root("", "", "");
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(3);
+}
+void WorkerThreadPoolTests::tearDown()
+{
+    WorkerThreadPool::getSingleton().setNumWorkerThreads(0);
+    delete mRoot;
+}
+
+void WorkerThreadPoolTests::runThrowingBatch(int kind)
+{
+    // Enough tasks that the throwing one is likely to run on a worker
+    std::vector<ThrowingTask> tasks(64, ThrowingTask(0));
+    tasks[37].kind = kind;
+    WorkerThreadPool::TaskList taskList;
+    for (size_t i = 0; i < tasks.size(); ++i)
+        taskList.push_back(&tasks[i]);
+
+    try
+    {
+        WorkerThreadPool::getSingleton().executeTasks(taskList);
+    }
+    catch (...)
+    {
+        // The other tasks still run before the exception reaches us
+        for (size_t i = 0; i < tasks.size(); ++i)
+            CPPUNIT_ASSERT(tasks[i].executed);
+        throw;
+    }
+}
+
+void WorkerThreadPoolTests::testOgreExceptionRethrown()
+{
+    try
+    {
+        runThrowingBatch(1);
+        CPPUNIT_FAIL("No exception");
+    }
+    catch (Exception& e)
+    {
+        CPPUNIT_ASSERT_EQUAL((int)Exception::ERR_INVALIDPARAMS, e.getNumber());
+    }
+}
+
+void WorkerThreadPoolTests::testStdExceptionRethrown()
+{
+    try
+    {
+        runThrowingBatch(2);
+        CPPUNIT_FAIL("No exception");
+    }
+    catch (Exception& e)
+    {
+        CPPUNIT_ASSERT_EQUAL((int)Exception::ERR_INTERNAL_ERROR, e.getNumber());
+    }
+}
+
+void WorkerThreadPoolTests::testBadAllocRethrown()
+{
+    CPPUNIT_ASSERT_THROW(runThrowingBatch(3), std::bad_alloc);
+}
+
+void WorkerThreadPoolTests::testUnknownExceptionRethrown()
+{
+    try
+    {
+        runThrowingBatch(4);
+        CPPUNIT_FAIL("No exception");
+    }
+    catch (Exception& e)
+    {
+        CPPUNIT_ASSERT_EQUAL((int)Exception::ERR_INTERNAL_ERROR, e.getNumber());
+    }
+    // The pool is usable again afterwards
+    runThrowingBatch(0);
+}